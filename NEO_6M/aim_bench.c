@@ -0,0 +1,332 @@
+// 지리 목표 지향 (gps_aim + pan_tilt_aim) 벤치마크
+//
+// 합성 궤적 4 가지 (직진 10 m/s, 반경 50 m 선회, 지그재그, 요철 노면 roll/pitch ±10°)
+// 에서 300 m 안팎, 20 m 높은 목표를 PWM 주기 (20 ms) 마다 지향한다.
+// GPS 는 1 / 5 / 10 Hz (Gauss-Markov σ 1.5 m + 백색 0.3 m, 고도 σ 2.5 m) 로 gps_kf 를 거쳐
+// 들어오고, 자세는 참값 (+ -A 잡음) 이다.
+//
+// 비교: 마지막 fix 위치 고정 (hold) vs fix 사이 속도 외삽 (extrap)
+// 보고: 참 시선 대비 각도 오차 RMS / p95 / max (pan/tilt 범위 밖 구간 포함),
+//       pan/tilt 범위를 벗어난 비율 (pan 정면 120°, ±50°), 갱신 1회 비용
+//   참 시선은 매 갱신 차량 참위치를 기준점으로 다시 잡아 정확한 ENU (geo_ltp_enu) 로 구한다.
+//
+// 실행: ./aim_bench [-s seed] [-A att_sigma_deg] [-N]
+//         -N  GPS 잡음 없음 (외삽 / 지연 오차만)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_aim.h"
+#include "gps_fix.h"
+#include "gps_kf.h"
+#include "pan_tilt.h"
+#include "gps_synth.h"
+
+#define LAT0            37.5665
+#define LON0            126.9780
+#define GROUND_ALT      50.0
+#define TARGET_UP       20.0        // 목표 높이 (지면 기준 m)
+#define PWM_HZ          50
+#define WARMUP_S        5.0         // 필터 수렴 구간 (오차 집계 제외)
+#define NOISE_SIGMA     1.5
+#define NOISE_WHITE     0.3
+#define NOISE_V_SIGMA   2.5
+#define NOISE_TAU       60.0
+#define FWD_PAN         120.0       // pan 70~170° 의 가운데를 정면으로
+#define COST_REPEAT     2000000
+
+enum { TR_STRAIGHT = 0, TR_CIRCLE, TR_SLALOM, TR_BUMPY, TR_COUNT };
+static const char *tr_name[TR_COUNT] = {
+    "straight 10m/s", "circle r50 8m/s", "slalom 12m/s", "bumpy 5m/s",
+};
+static const double tr_len[TR_COUNT] = { 120.0, 120.0, 90.0, 200.0 };
+
+typedef struct {
+    double e, n, u;                 // 목표 기준 ENU (m)
+    double ve, vn;
+    double roll, pitch, yaw;        // 도
+} Truth;
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+// ─────────────────────────────────────────────
+//  합성 궤적 (목표가 원점, 지그재그만 수치 적분)
+// ─────────────────────────────────────────────
+typedef struct {
+    double t, e, n;                 // 지그재그 적분 상태
+} Slalom;
+
+static void truth_at(int tr, double t, Slalom *sl, Truth *s)
+{
+    double hdg, speed;
+
+    memset(s, 0, sizeof(*s));
+    s->u = 0.0;
+    switch (tr) {
+        case TR_STRAIGHT:                           // 동쪽으로, 목표는 오른쪽 앞 (11° → 45°)
+            speed = 10.0; hdg = 90.0;
+            s->e  = -1500.0 + speed * t;
+            s->n  = 300.0;
+            break;
+        case TR_CIRCLE: {                           // 목표에서 300 m 떨어진 점을 시계 방향으로
+                                                    // (시선이 차체 기준으로 한 바퀴 돎)
+            double w  = 8.0 / 50.0, a = w * t;
+            speed = 8.0; hdg = fmod(a * GEO_RAD2DEG + 90.0, 360.0);
+            s->e  = 300.0 + 50.0 * sin(a);
+            s->n  = 50.0 * cos(a);
+            break;
+        }
+        case TR_SLALOM: {                           // 북쪽으로 ±30° 지그재그 (주기 10 s)
+            double w = 2.0 * M_PI / 10.0, amp = 30.0 * GEO_DEG2RAD;
+            speed = 12.0;
+            hdg   = amp * sin(w * t) * GEO_RAD2DEG;
+            // 방위 ψ(t) = amp·sin(wt) 의 위치는 닫힌 꼴이 없어 1 ms 중점 적분
+            for (; sl->t + 0.0005 < t; sl->t += 0.001) {
+                double p = amp * sin(w * (sl->t + 0.0005));
+                sl->e += speed * sin(p) * 0.001;
+                sl->n += speed * cos(p) * 0.001;
+            }
+            s->e = -300.0 + sl->e;
+            s->n = -1500.0 + sl->n;
+            break;
+        }
+        default: {                                  // 요철: 동쪽으로, 차체가 흔들림
+            speed    = 5.0; hdg = 90.0;
+            s->e     = -1500.0 + speed * t;
+            s->n     = 300.0;
+            s->u     = 0.15 * sin(2.0 * M_PI * 1.3 * t);
+            s->roll  = 10.0 * sin(2.0 * M_PI * 1.0 * t);
+            s->pitch = 8.0 * sin(2.0 * M_PI * 0.7 * t + 1.0);
+            s->yaw   = 3.0 * sin(2.0 * M_PI * 0.5 * t);
+            break;
+        }
+    }
+    s->ve   = speed * sin(hdg * GEO_DEG2RAD);
+    s->vn   = speed * cos(hdg * GEO_DEG2RAD);
+    s->yaw += hdg;
+}
+
+/**
+ * @brief 참 시선: 차량 참위치를 기준점으로 잡은 gps_aim (외삽 없음, 정확한 ENU 만)
+ */
+static void truth_los(const GeoLtp *ref, const Truth *s, GpsAimOut *out)
+{
+    GpsAim a;
+    double lat, lon;
+
+    geo_ltp_inv(ref, s->e, s->n, &lat, &lon);
+    gps_aim_init(&a);
+    gps_aim_set_position(&a, lat, lon, GROUND_ALT + s->u, 0.0, 0.0, 0.0, 0);
+    gps_aim_set_target(&a, LAT0, LON0, GROUND_ALT + TARGET_UP);
+    gps_aim_set_attitude(&a, s->roll, s->pitch, s->yaw);
+    gps_aim_update(&a, 0, out);
+}
+
+/**
+ * @brief 두 방향 (방위 / 앙각) 사이 각도 (도)
+ */
+static double ang_err(const GpsAimOut *a, const GpsAimOut *b)
+{
+    double ca = cos(a->el * GEO_DEG2RAD), cb = cos(b->el * GEO_DEG2RAD);
+    double ux = ca * cos(a->az * GEO_DEG2RAD), uy = ca * sin(a->az * GEO_DEG2RAD), uz = sin(a->el * GEO_DEG2RAD);
+    double vx = cb * cos(b->az * GEO_DEG2RAD), vy = cb * sin(b->az * GEO_DEG2RAD), vz = sin(b->el * GEO_DEG2RAD);
+    double cx = uy * vz - uz * vy, cy = uz * vx - ux * vz, cz = ux * vy - uy * vx;
+    return atan2(sqrt(cx * cx + cy * cy + cz * cz), ux * vx + uy * vy + uz * vz) * GEO_RAD2DEG;
+}
+
+// ─────────────────────────────────────────────
+//  궤적 1개 × GPS 주기 1개 × 방식 1개
+// ─────────────────────────────────────────────
+typedef struct {
+    double rms, p95, max;
+    double clamp_pct;
+} Result;
+
+static void run(int tr, int gps_hz, int extrap, int noise, double att_sigma, uint64_t seed, Result *res)
+{
+    GeoLtp    ref;
+    GpsKf     kf;
+    GpsAim    aim;
+    PanTilt   pt;
+    int       steps = (int)(tr_len[tr] * PWM_HZ);
+    int       per_fix = PWM_HZ / gps_hz, count = 0;
+    uint64_t  clamped = 0;
+    double   *err = malloc(steps * sizeof(double));
+    double    gm_e, gm_n, gm_u, alpha = exp(-1.0 / (gps_hz * NOISE_TAU));
+    double    sum2 = 0.0;
+    Slalom    sl = {0};
+
+    synth_seed(seed);
+    gm_e = NOISE_SIGMA * synth_grand();             // 정상 상태에서 시작
+    gm_n = NOISE_SIGMA * synth_grand();
+    gm_u = NOISE_V_SIGMA * synth_grand();
+    geo_ltp_init(&ref, LAT0, LON0, GROUND_ALT);
+    gps_kf_init(&kf, 2.0);
+    gps_aim_init(&aim);
+    gps_aim_set_target(&aim, LAT0, LON0, GROUND_ALT + TARGET_UP);
+    if (!extrap) gps_aim_set_max_extrap(&aim, 0.0);
+    pan_tilt_init(&pt);
+    pan_tilt_set_mount(&pt, FWD_PAN, 1);
+    pan_tilt_set_rate(&pt, 0.0, 0);
+
+    for (int i = 0; i < steps; i++) {
+        double  t    = (double)i / PWM_HZ;
+        int64_t t_ns = (int64_t)i * (1000000000LL / PWM_HZ);
+        Truth   s;
+
+        truth_at(tr, t, &sl, &s);
+
+        if (i % per_fix == 0) {                     // GPS epoch (측정 시각 = 수신 시각)
+            double k = sqrt(1.0 - alpha * alpha);
+            gm_e = alpha * gm_e + k * NOISE_SIGMA * synth_grand();
+            gm_n = alpha * gm_n + k * NOISE_SIGMA * synth_grand();
+            gm_u = alpha * gm_u + k * NOISE_V_SIGMA * synth_grand();
+            double me = s.e, mn = s.n, mu = s.u;
+            if (noise) {
+                me += gm_e + NOISE_WHITE * synth_grand();
+                mn += gm_n + NOISE_WHITE * synth_grand();
+                mu += gm_u + NOISE_WHITE * synth_grand();
+            }
+
+            GpsFix f;
+            double lat, lon;
+            memset(&f, 0, sizeof(f));
+            geo_ltp_inv(&ref, me, mn, &lat, &lon);
+            f.valid    = GPS_V_TIME | GPS_V_POS | GPS_V_ALT | GPS_V_QUALITY | GPS_V_SATS | GPS_V_HDOP |
+                         GPS_V_SPEED | GPS_V_COURSE;
+            f.time_ms  = (int32_t)llround(t * 1000.0);
+            f.lat      = (int32_t)llround(lat * 1e7);
+            f.lon      = (int32_t)llround(lon * 1e7);
+            f.alt_mm   = (int32_t)llround((GROUND_ALT + mu) * 1000.0);
+            f.quality  = 1;
+            f.num_sats = 8;
+            f.hdop     = 100;
+            double sp  = hypot(s.ve, s.vn) + (noise ? 0.1 * synth_grand() : 0.0);
+            double c   = atan2(s.ve, s.vn) * GEO_RAD2DEG + (noise ? 0.5 * synth_grand() : 0.0);
+            f.speed_mmps  = (int32_t)lround(fmax(sp, 0.0) * 1000.0);
+            f.course_cdeg = (int32_t)lround(fmod(c + 360.0, 360.0) * 100.0);
+
+            gps_kf_update_fix(&kf, &f);
+            gps_kf_position(&kf, &lat, &lon);
+            gps_aim_set_position(&aim, lat, lon, f.alt_mm / 1000.0, kf.x[2], kf.x[3], 0.0, t_ns);
+        }
+
+        double an = att_sigma;
+        gps_aim_set_attitude(&aim, s.roll + an * synth_grand(), s.pitch + an * synth_grand(), s.yaw + an * synth_grand());
+
+        GpsAimOut o, ot;
+        gps_aim_update(&aim, t_ns, &o);
+        uint64_t c0 = pt.stats.clamped;
+        pan_tilt_aim(&pt, o.az, o.el, t_ns);
+        if (t < WARMUP_S) continue;
+
+        truth_los(&ref, &s, &ot);
+        err[count] = ang_err(&o, &ot);
+        sum2      += err[count] * err[count];
+        count++;
+        clamped   += pt.stats.clamped - c0;
+    }
+
+    qsort(err, count, sizeof(double), synth_cmp_double);
+    res->rms       = sqrt(sum2 / count);
+    res->p95       = err[(size_t)(0.95 * (count - 1))];
+    res->max       = err[count - 1];
+    res->clamp_pct = 100.0 * clamped / count;
+    free(err);
+}
+
+// ─────────────────────────────────────────────
+//  갱신 비용
+// ─────────────────────────────────────────────
+static void cost(void)
+{
+    GpsAim    aim;
+    PanTilt   pt;
+    GpsAimOut o;
+    double    sink = 0.0;
+
+    gps_aim_init(&aim);
+    gps_aim_set_target(&aim, LAT0, LON0, GROUND_ALT + TARGET_UP);
+    gps_aim_set_position(&aim, LAT0 + 0.003, LON0 - 0.002, GROUND_ALT, 3.0, -4.0, 0.0, 0);
+    pan_tilt_init(&pt);
+    pan_tilt_set_rate(&pt, 0.0, 0);
+
+    double t0 = now_sec();
+    for (int i = 0; i < COST_REPEAT; i++) {
+        gps_aim_update(&aim, (int64_t)i * 20000, &o);
+        sink += o.az + o.el;
+    }
+    double t_upd = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int i = 0; i < COST_REPEAT; i++) {
+        gps_aim_set_attitude(&aim, (i & 15) * 0.5, -(i & 7) * 0.7, (i & 255) * 1.4);
+        sink += aim.C[0][1];
+    }
+    double t_att = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int i = 0; i < COST_REPEAT; i++) {
+        pan_tilt_aim(&pt, (i & 127) - 64.0, (i & 31) * 0.5, (int64_t)i * 20000000);
+        sink += pt.pan_mdeg;
+    }
+    double t_pt = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int i = 0; i < COST_REPEAT / 20; i++) {
+        double e, n, u;
+        geo_ltp_enu(&aim.ltp, LAT0 + i * 1e-9, LON0, GROUND_ALT, &e, &n, &u);
+        sink += e;
+    }
+    double t_enu = (now_sec() - t0) * 20;
+
+    printf("\ncost per call: gps_aim_update %.1f ns, gps_aim_set_attitude %.1f ns, "
+           "pan_tilt_aim (dry) %.1f ns\n"
+           "               (exact geo_ltp_enu per update would add %.1f ns)\n",
+           t_upd * 1e9 / COST_REPEAT, t_att * 1e9 / COST_REPEAT, t_pt * 1e9 / COST_REPEAT,
+           t_enu * 1e9 / COST_REPEAT);
+    if (sink == 12345.0) printf("\n");              // 최적화 방지
+}
+
+int main(int argc, char **argv)
+{
+    static const int rates[] = { 1, 5, 10 };
+    uint64_t seed = 88172645463325252ULL;
+    double   att_sigma = 0.0;
+    int      noise = 1, opt;
+
+    while ((opt = getopt(argc, argv, "s:A:N")) != -1) {
+        switch (opt) {
+            case 's': seed      = strtoull(optarg, NULL, 0) | 1; break;
+            case 'A': att_sigma = atof(optarg);                  break;
+            case 'N': noise     = 0;                             break;
+            default:
+                fprintf(stderr, "usage: %s [-s seed] [-A att_sigma_deg] [-N]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    printf("target %.0f m up, update %d Hz, GPS noise %s, attitude noise %.2f deg\n",
+           TARGET_UP, PWM_HZ, noise ? "on" : "off", att_sigma);
+    printf("%-16s  %4s  %-6s  %8s  %8s  %8s  %7s\n",
+           "trajectory", "GPS", "mode", "rms deg", "p95 deg", "max deg", "clamp%");
+    for (int tr = 0; tr < TR_COUNT; tr++) {
+        for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+            for (int x = 0; x < 2; x++) {
+                Result res;
+                run(tr, rates[r], x, noise, att_sigma, seed, &res);
+                printf("%-16s  %2dHz  %-6s  %8.3f  %8.3f  %8.3f  %6.1f%%\n",
+                       tr_name[tr], rates[r], x ? "extrap" : "hold",
+                       res.rms, res.p95, res.max, res.clamp_pct);
+            }
+        }
+    }
+    cost();
+    return 0;
+}
@@ -0,0 +1,352 @@
+// 차분 보정 (gps_dgps) loopback 벤치마크
+//
+// 기준국 (스레드) 과 이동국 (main) 합성 fix 스트림을 실제 UDP (127.0.0.1) 로 연결한다.
+// 두 수신기 오차 = 공통 (Gauss-Markov, 수 분 상관: 위성 궤도 / 전리층 / 대류층)
+//                + 수신기별 (다중 경로 Gauss-Markov + 백색 잡음)
+// epoch 마다 두 fix 는 주기 안에서 임의로 늦게 도착한다 (시리얼 / 조립 지연 차이).
+//
+// 보고: 보정 지연 (기준국 epoch → 이동국 수신), 이동국 fix 대기 시간, 같은 epoch 일치율,
+//       이동국 위치 오차 RMS (원시 / 시작 때 맞춘 고정 오프셋 / 차분 보정)
+//
+// 기준국 survey-in 구간은 보정을 보내지 않으므로 실시간으로 돌리지 않고 먼저 한 번에 넣는다.
+// 그 뒤 n epoch 를 배속 실시간으로 보내며 이동국을 집계한다.
+//
+// 실행: ./dgps_bench [-n epochs] [-r Hz] [-x speed] [-s survey_s] [-F] [-H hold_ms] [-p port]
+//         -n  측량 뒤 집계 epoch 수 (기본 3000)
+//         -x  배속 (기본 20: 10Hz 를 5 ms 간격으로)
+//         -s  기준국 survey-in 최소 시간 (기본 GPS_DGPS_SURVEY_MIN_S, 고정 오프셋도 같은 구간으로 맞춤)
+//         -F  기준 위치를 참값으로 지정 (측량한 기준점)
+//         -H  이동국 hold (기본 주기 1개, 0: 기다리지 않음)
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_dgps.h"
+#include "gps_synth.h"
+
+#define BASE_LAT        37.5665
+#define BASE_LON        126.9780
+#define ROVER_RADIUS    300.0       // 이동국 원 궤적 반경 (m), 중심은 기준국 동쪽 1 km
+#define ROVER_SPEED     5.0         // m/s
+#define COMMON_SIGMA    3.0         // 공통 오차 축당 σ (m)
+#define COMMON_TAU      120.0       // 공통 오차 상관 시간 (s)
+#define LOCAL_SIGMA     0.5         // 수신기별 다중 경로 σ (m)
+#define LOCAL_TAU       20.0
+#define WHITE_SIGMA     0.4         // 수신기별 백색 잡음 σ (m)
+#define OFFSET_S        60          // -F 일 때 고정 오프셋을 맞추는 구간 (s)
+
+typedef struct {
+    double  e, n;                   // 참 위치 (기준국 ENU, m)
+    double  fe, fn;                 // 측정 위치
+    int64_t arrive_ns;              // 도착 시각 (주기 시작 기준 오프셋)
+} Epoch;
+
+typedef struct {
+    int      count;
+    double   sum2;
+    double   se, sn;                // Σ 오차 (상수 편향을 나중에 빼기 위해)
+} Rms;
+
+static Epoch   *base_ep, *rover_ep;
+static int      epochs, rate_hz = 10;    // epochs: 측량 최대 (최소 시간의 2배) + 집계
+static int      first;                   // 실시간으로 보내는 첫 epoch (측량 완료 다음)
+static int64_t  period_ns, t_start;
+static GeoLtp   ltp;
+
+/**
+ * @brief 1차 Gauss-Markov 한 걸음 (정상 σ 유지)
+ */
+static double gm_step(double x, double sigma, double tau, double dt)
+{
+    double a = exp(-dt / tau);
+    return a * x + sigma * sqrt(1.0 - a * a) * synth_grand();
+}
+
+static void make_epochs(void)
+{
+    double dt = 1.0 / rate_hz;
+    double ce = COMMON_SIGMA * synth_grand(), cn = COMMON_SIGMA * synth_grand();
+    double be = LOCAL_SIGMA * synth_grand(), bn = LOCAL_SIGMA * synth_grand();
+    double re = LOCAL_SIGMA * synth_grand(), rn = LOCAL_SIGMA * synth_grand();
+
+    for (int k = 0; k < epochs; k++) {
+        double a = ROVER_SPEED * k * dt / ROVER_RADIUS;
+
+        ce = gm_step(ce, COMMON_SIGMA, COMMON_TAU, dt);
+        cn = gm_step(cn, COMMON_SIGMA, COMMON_TAU, dt);
+        be = gm_step(be, LOCAL_SIGMA, LOCAL_TAU, dt);
+        bn = gm_step(bn, LOCAL_SIGMA, LOCAL_TAU, dt);
+        re = gm_step(re, LOCAL_SIGMA, LOCAL_TAU, dt);
+        rn = gm_step(rn, LOCAL_SIGMA, LOCAL_TAU, dt);
+
+        base_ep[k].e  = base_ep[k].n = 0.0;
+        base_ep[k].fe = ce + be + WHITE_SIGMA * synth_grand();
+        base_ep[k].fn = cn + bn + WHITE_SIGMA * synth_grand();
+        rover_ep[k].e  = 1000.0 + ROVER_RADIUS * cos(a);
+        rover_ep[k].n  = ROVER_RADIUS * sin(a);
+        rover_ep[k].fe = rover_ep[k].e + ce + re + WHITE_SIGMA * synth_grand();
+        rover_ep[k].fn = rover_ep[k].n + cn + rn + WHITE_SIGMA * synth_grand();
+
+        // 주기 안에서 도착 (UART 전송 / epoch 조립 시간 차이)
+        base_ep[k].arrive_ns  = (int64_t)(k * period_ns + synth_urand() * 0.5 * period_ns);
+        rover_ep[k].arrive_ns = (int64_t)(k * period_ns + synth_urand() * 0.5 * period_ns);
+    }
+}
+
+static void fix_make(GpsFix *f, const Epoch *ep, int k, int64_t end_ns)
+{
+    double lat, lon;
+
+    memset(f, 0, sizeof(GpsFix));
+    geo_ltp_inv(&ltp, ep->fe, ep->fn, &lat, &lon);
+    f->valid    = GPS_V_POS | GPS_V_TIME | GPS_V_HDOP | GPS_V_SATS | GPS_V_QUALITY;
+    f->seq      = (uint32_t)k;
+    f->time_ms  = (int32_t)((int64_t)k * 1000 / rate_hz);
+    f->lat      = (int32_t)lround(lat * 1e7);
+    f->lon      = (int32_t)lround(lon * 1e7);
+    f->quality  = 1;
+    f->num_sats = 8;
+    f->hdop     = 110;
+    f->rx_ns    = f->end_ns = f->pub_ns = end_ns;
+}
+
+static void sleep_until(int64_t t_ns)
+{
+    struct timespec ts = { .tv_sec = t_ns / 1000000000LL, .tv_nsec = t_ns % 1000000000LL };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+        ;
+}
+
+// ─────────────────────────────────────────────
+//  기준국 스레드
+// ─────────────────────────────────────────────
+static void *base_thread(void *arg)
+{
+    GpsDgpsBase *b = arg;
+    GpsFix       f;
+
+    for (int k = first; k < epochs; k++) {
+        int64_t t = t_start + base_ep[k].arrive_ns;
+        sleep_until(t);
+        fix_make(&f, &base_ep[k], k, t);
+        if (gps_dgps_base_fix(b, &f, NULL) < 0) perror("sendto");
+    }
+    return NULL;
+}
+
+// ─────────────────────────────────────────────
+//  이동국 (main)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsDgpsRover rover;
+    double       off_e, off_n;      // 고정 오프셋 (LAT_OFFSET / LON_OFFSET 방식)
+    int          from;              // 이 epoch 부터 집계 (기준국 측량 이후)
+    Rms          raw, fixed_off, dgps;
+    int64_t     *latency, *hold;
+    int          nlat;
+    int          corrected;
+} RoverCtx;
+
+static void add(Rms *r, double de, double dn)
+{
+    r->count++;
+    r->sum2 += de * de + dn * dn;
+    r->se   += de;
+    r->sn   += dn;
+}
+
+/**
+ * @brief RMS (bias_e / bias_n 을 뺀 오차)
+ */
+static double rms(const Rms *r, double bias_e, double bias_n)
+{
+    if (!r->count) return 0.0;
+    double s2 = r->sum2 - 2.0 * (bias_e * r->se + bias_n * r->sn)
+              + r->count * (bias_e * bias_e + bias_n * bias_n);
+    return sqrt(s2 / r->count);
+}
+
+static void on_rover_fix(const GpsFix *f, void *user)
+{
+    RoverCtx            *rc = user;
+    const Epoch         *ep = &rover_ep[f->seq];
+    const GpsDgpsApplied *a = &rc->rover.last;
+    double               e, n;
+
+    if ((int)f->seq < rc->from) return;
+    if (a->match != GPS_DGPS_NONE) {
+        rc->latency[rc->nlat] = a->latency_ns;
+        rc->hold[rc->nlat]    = a->hold_ns;
+        rc->nlat++;
+    }
+    if (a->match != GPS_DGPS_MATCHED && a->match != GPS_DGPS_OLDER) return;
+
+    geo_ltp_fwd(&ltp, f->lat * 1e-7, f->lon * 1e-7, &e, &n);
+    add(&rc->raw, ep->fe - ep->e, ep->fn - ep->n);
+    add(&rc->fixed_off, ep->fe + rc->off_e - ep->e, ep->fn + rc->off_n - ep->n);
+    add(&rc->dgps, e - ep->e, n - ep->n);
+    rc->corrected++;
+}
+
+static void report(const char *name, int64_t *v, int n)
+{
+    if (n == 0) { printf("%-22s (no samples)\n", name); return; }
+
+    int64_t sum = 0;
+    qsort(v, (size_t)n, sizeof(int64_t), synth_cmp_i64);
+    for (int i = 0; i < n; i++) sum += v[i];
+
+    printf("%-22s mean %8.1f  p50 %8.1f  p99 %8.1f  max %8.1f us\n", name,
+           sum / 1e3 / n, v[n / 2] / 1e3, v[(n * 99) / 100] / 1e3, v[n - 1] / 1e3);
+}
+
+int main(int argc, char **argv)
+{
+    double speed = 20.0;
+    int    count = 3000, survey = GPS_DGPS_SURVEY_MIN_S, fixed_ref = 0, hold_ms = -1;
+    int    port = GPS_DGPS_PORT + 100, opt;
+
+    while ((opt = getopt(argc, argv, "n:r:x:s:FH:p:")) != -1) {
+        switch (opt) {
+            case 'n': count     = atoi(optarg); break;
+            case 'r': rate_hz   = atoi(optarg); break;
+            case 'x': speed     = atof(optarg); break;
+            case 's': survey    = atoi(optarg); break;
+            case 'F': fixed_ref = 1;            break;
+            case 'H': hold_ms   = atoi(optarg); break;
+            case 'p': port      = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n epochs] [-r Hz] [-x speed] [-s survey_s] [-F]\n"
+                                "       [-H hold_ms] [-p port]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (count < 2 || rate_hz < 1 || speed <= 0 || survey < 2) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+    epochs = (fixed_ref ? 0 : 2 * survey * rate_hz) + count;
+    period_ns = (int64_t)(1e9 / rate_hz / speed);
+    if (hold_ms < 0) hold_ms = (int)((period_ns + 999999) / 1000000);
+
+    geo_ltp_init(&ltp, BASE_LAT, BASE_LON, 0.0);
+    base_ep  = calloc((size_t)epochs, sizeof(Epoch));
+    rover_ep = calloc((size_t)epochs, sizeof(Epoch));
+    RoverCtx rc = {0};
+    rc.latency = calloc((size_t)epochs, sizeof(int64_t));
+    rc.hold    = calloc((size_t)epochs, sizeof(int64_t));
+    if (!base_ep || !rover_ep || !rc.latency || !rc.hold) { perror("calloc"); return 1; }
+    make_epochs();
+
+    GpsDgpsBase base;
+    // 측량 목표 정확도 없음 (추정 불가도 통과): 최소 시간으로 끝냄 (고정 오프셋과 같은 구간)
+    if (gps_dgps_base_init(&base, "127.0.0.1", port, survey, INFINITY) < 0) {
+        perror("gps_dgps_base_init");
+        return 1;
+    }
+    if (fixed_ref) gps_dgps_base_set_ref(&base, BASE_LAT, BASE_LON);
+
+    // survey-in: 이동국 소켓을 열기 전에 한 번에 (완료 epoch 의 보정 1개는 받는 쪽 없이 버려짐)
+    for (first = 0; !base.fixed && first < epochs - count; first++) {
+        GpsFix f;
+        fix_make(&f, &base_ep[first], first, 0);
+        if (gps_dgps_base_fix(&base, &f, NULL) < 0) perror("sendto");
+    }
+    if (!base.fixed) {
+        fprintf(stderr, "survey-in did not finish in %d s\n", 2 * survey);
+        return 1;
+    }
+    epochs = first + count;
+
+    // 고정 오프셋: 기준국 측량 구간의 평균 오차로 한 번 맞추고 그대로 사용
+    // (-F 면 측량이 없으므로 집계 구간 앞쪽 OFFSET_S 초)
+    int off_n = first ? first : (OFFSET_S * rate_hz < count ? OFFSET_S * rate_hz : count);
+    for (int k = 0; k < off_n; k++) {
+        rc.off_e -= base_ep[k].fe / off_n;
+        rc.off_n -= base_ep[k].fn / off_n;
+    }
+
+    if (gps_dgps_rover_init(&rc.rover, port, on_rover_fix, &rc) < 0) {
+        perror("gps_dgps_rover_init");
+        return 1;
+    }
+    gps_dgps_rover_set_policy(&rc.rover, hold_ms, GPS_DGPS_MAX_AGE_MS);
+    rc.from = first;
+
+    if (fixed_ref)
+        printf("%d epochs at %d Hz, x%.0f (period %.2f ms), hold %d ms, survey skipped "
+               "(reference given), loopback port %d\n", count, rate_hz, speed, period_ns / 1e6,
+               hold_ms, port);
+    else
+        printf("%d epochs at %d Hz, x%.0f (period %.2f ms), hold %d ms, survey-in %d s "
+               "(%d epochs, not real time), loopback port %d\n", count, rate_hz, speed,
+               period_ns / 1e6, hold_ms, survey, first, port);
+
+    pthread_t th;
+    t_start = gps_now_ns() + 20000000LL - first * period_ns;
+    if (pthread_create(&th, NULL, base_thread, &base) != 0) { perror("pthread_create"); return 1; }
+
+    int k = first;
+    for (;;) {
+        int64_t now = gps_now_ns();
+        while (k < epochs && now >= t_start + rover_ep[k].arrive_ns) {
+            GpsFix f;
+            fix_make(&f, &rover_ep[k], k, now);
+            gps_dgps_rover_fix(&rc.rover, &f, now);
+            k++;
+        }
+        if (k == epochs && rc.rover.npend == 0) break;
+
+        // 다음 이동국 fix 도착 또는 hold 만료까지 보정 수신 대기
+        int     timeout = gps_dgps_rover_timeout(&rc.rover, now);
+        int64_t next    = (k < epochs) ? t_start + rover_ep[k].arrive_ns - now : -1;
+        if (next >= 0) {
+            int ms = (int)((next + 999999) / 1000000);
+            if (timeout < 0 || ms < timeout) timeout = ms;
+        }
+        struct pollfd p = { .fd = rc.rover.fd, .events = POLLIN };
+        if (poll(&p, 1, timeout) < 0 && errno != EINTR) { perror("poll"); break; }
+        if (gps_dgps_rover_poll(&rc.rover, gps_now_ns()) < 0) { perror("recv"); break; }
+    }
+    pthread_join(th, NULL);
+    gps_dgps_rover_flush(&rc.rover);
+
+    // 기준국 측량 위치 오차 (참값 0,0 기준): 보정을 통해 이동국 위치에 그대로 실림
+    double ref_e = 0.0, ref_n = 0.0;
+    if (!fixed_ref) geo_ltp_fwd(&ltp, base.ref.lat0, base.ref.lon0, &ref_e, &ref_n);
+
+    const GpsDgpsRoverStats *rs = &rc.rover.stats;
+    printf("base: sent %llu corrections (from epoch %d), survey error %.2f m "
+           "(estimated %.2f m)\n", (unsigned long long)base.stats.sent, first,
+           hypot(ref_e, ref_n), base.ref_acc);
+    printf("rover: received %llu (bad %llu, out of order %llu), fixes %llu: matched %llu, "
+           "older %llu, uncorrected %llu, overflows %llu\n",
+           (unsigned long long)rs->received, (unsigned long long)rs->bad,
+           (unsigned long long)rs->out_of_order, (unsigned long long)rs->fixes,
+           (unsigned long long)rs->matched, (unsigned long long)rs->older,
+           (unsigned long long)rs->uncorrected, (unsigned long long)rs->overflows);
+    report("correction latency", rc.latency, rc.nlat);
+    report("rover hold", rc.hold, rc.nlat);
+
+    printf("\nrover horizontal error vs truth (%d corrected epochs after survey)\n", rc.corrected);
+    printf("  raw                        %6.2f m RMS\n", rms(&rc.raw, 0, 0));
+    printf("  fixed offset (survey mean) %6.2f m RMS\n", rms(&rc.fixed_off, 0, 0));
+    printf("  differential               %6.2f m RMS\n", rms(&rc.dgps, 0, 0));
+    printf("  differential, relative     %6.2f m RMS  (survey error removed)\n",
+           rms(&rc.dgps, ref_e, ref_n));
+
+    gps_dgps_rover_free(&rc.rover);
+    gps_dgps_base_free(&base);
+    free(base_ep);
+    free(rover_ep);
+    free(rc.latency);
+    free(rc.hold);
+    return 0;
+}
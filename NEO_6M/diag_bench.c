@@ -0,0 +1,308 @@
+// 링크 진단 (gps_diag) 벤치마크
+//
+// 1. 비용: 합성 1 Hz NMEA 스트림을 GpsStream → 디스패치 → epoch 으로 넣을 때
+//    진단 tap 유무에 따른 바이트당 / 문장당 CPU 시간 차 (5회 중 최소)
+// 2. 시나리오: 수신기 출력을 가상 시계 위 UART 로 재현 (8N1 바이트 단위 시각,
+//    수신기 TX 버퍼가 차면 메시지 버림, 선택적으로 비트 오류) 하고
+//    10 초마다 gps_diag_report 한 결과 (사용률 / 점유 / 빠진 epoch / 오류 / 지터 / 지연)
+//
+// 실행: ./diag_bench [-t seconds] [-c chunk] [-s seed]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gps_diag.h"
+#include "gps_epoch.h"
+#include "gps_stream.h"
+#include "gps_synth.h"
+#include "nmea_msg.h"
+
+#define TXBUF           1024        // 수신기 포트 TX 버퍼 (넘치면 메시지 버림)
+#define POLL_NS         1000000LL   // 유휴 구간 poll 간격
+#define REPORT_S        10
+#define COST_EPOCHS     3600
+#define COST_RUNS       5
+
+// ─────────────────────────────────────────────
+//  가상 시계
+// ─────────────────────────────────────────────
+static int64_t vnow;
+
+static int64_t vclock(void)
+{
+    return vnow;
+}
+
+// ─────────────────────────────────────────────
+//  1. tap 비용
+// ─────────────────────────────────────────────
+
+static void count_fix(const GpsFix *f, void *user)
+{
+    (void)f;
+    (*(long *)user)++;
+}
+
+static void diag_fix(const GpsFix *f, void *user)
+{
+    gps_diag_on_fix(user, f);
+}
+
+/**
+ * @return 입력 전체 CPU 시간 (ns)
+ */
+static int64_t run_cost(const char *data, size_t len, int with_diag, uint64_t *sentences)
+{
+    GpsStream    st;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    GpsDiag      diag;
+    long         fixes = 0;
+
+    gps_epoch_init(&ep, with_diag ? diag_fix : count_fix, with_diag ? (void *)&diag : &fixes);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    if (with_diag) {
+        gps_diag_init(&diag, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+        gps_stream_init(&st, gps_diag_sentence, &diag, gps_diag_ubx, &diag);
+    } else {
+        gps_stream_init(&st, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+    }
+
+    int64_t t0 = gps_now_ns();
+    for (size_t off = 0; off < len; off += 64) {
+        size_t k = (len - off < 64) ? len - off : 64;
+        gps_stream_feed(&st, data + off, k, (int64_t)off * 1000);
+    }
+    gps_epoch_flush(&ep);
+    if (with_diag) {
+        GpsDiagReport r;
+        gps_diag_report(&diag, &st, NULL, 0, 0, &r);
+        gps_diag_report(&diag, &st, NULL, 0, 1, &r);
+    }
+    int64_t dt = gps_now_ns() - t0;
+
+    *sentences = st.nmea.stats.sentences;
+    return dt;
+}
+
+static void bench_cost(void)
+{
+    char   *data = malloc((size_t)COST_EPOCHS * NMEA_SYNTH_EPOCH_MAX);
+    size_t  len  = 0;
+    int64_t best[2] = { INT64_MAX, INT64_MAX };
+    uint64_t sentences = 0;
+
+    if (!data) { perror("malloc"); exit(1); }
+    for (int i = 0; i < COST_EPOCHS; i++) len += nmea_synth_epoch(data + len, i, 1);
+
+    for (int k = 0; k < COST_RUNS; k++) {
+        for (int d = 0; d < 2; d++) {
+            int64_t t = run_cost(data, len, d, &sentences);
+            if (t < best[d]) best[d] = t;
+        }
+    }
+    printf("cost: %d epochs, %zu bytes, %llu sentences (64 B feed, best of %d)\n",
+           COST_EPOCHS, len, (unsigned long long)sentences, COST_RUNS);
+    printf("  without diag  %7.2f ns/byte  %7.1f ns/sentence\n",
+           (double)best[0] / len, (double)best[0] / sentences);
+    printf("  with diag     %7.2f ns/byte  %7.1f ns/sentence  (+%.1f ns/sentence, %+.1f%%)\n",
+           (double)best[1] / len, (double)best[1] / sentences,
+           (double)(best[1] - best[0]) / sentences, (best[1] - best[0]) * 100.0 / best[0]);
+    free(data);
+}
+
+// ─────────────────────────────────────────────
+//  2. 가상 UART 시나리오
+// ─────────────────────────────────────────────
+
+typedef struct {
+    const char *name;
+    int         rate_hz;
+    int         baud;
+    unsigned    nmea_mask;          // 1 << NmeaType (0: NMEA 없음)
+    int         ubx;                // NAV-POSLLH / SOL / VELNED 추가
+    double      ber;                // 비트 오류율
+} Scenario;
+
+typedef struct {
+    GpsStream    st;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    GpsDiag      diag;
+    char         chunk[4096];
+    size_t       nchunk;
+    int64_t      last_rx;
+    size_t       chunk_max;
+} Host;
+
+static void host_fix(const GpsFix *f, void *user)
+{
+    gps_diag_on_fix(&((Host *)user)->diag, f);
+}
+
+/**
+ * @brief 모은 바이트를 read() 1회로 전달
+ */
+static void host_flush(Host *h)
+{
+    if (!h->nchunk) return;
+    gps_stream_feed(&h->st, h->chunk, h->nchunk, vnow);
+    h->last_rx = vnow;
+    h->nchunk  = 0;
+}
+
+/**
+ * @brief t 까지 유휴: poll 만
+ */
+static void host_idle(Host *h, int64_t t)
+{
+    while (vnow + POLL_NS < t) {
+        vnow += POLL_NS;
+        gps_epoch_poll(&h->ep, h->last_rx, vnow);
+    }
+}
+
+typedef struct {
+    int    intervals, saturated;
+    double util_max, busy_max;
+    uint64_t gaps, checksum, framing, truncated, tag_errors, epochs;
+    int64_t  jit_p99_max, lat_p99_max;
+    uint64_t dropped;
+} Summary;
+
+static void run_scenario(const Scenario *sc, int seconds, size_t chunk)
+{
+    Host     h;
+    Summary  s;
+    int64_t  byte_ns = 10 * 1000000000LL / sc->baud;
+    int64_t  line_free = 0, next_report;
+    int      epochs = seconds * sc->rate_hz;
+    char     msg[NMEA_SYNTH_EPOCH_MAX];
+    uint8_t  ubx[UBX_SYNTH_EPOCH_MAX];
+    GpsDiagReport r;
+    static const uint8_t ubx_ids[] = { UBX_NAV_POSLLH, UBX_NAV_SOL, UBX_NAV_VELNED };
+
+    memset(&s, 0, sizeof(s));
+    memset(&h, 0, sizeof(h));
+    h.chunk_max = chunk;
+    gps_epoch_init(&h.ep, host_fix, &h);
+    gps_epoch_set_clock(&h.ep, vclock);
+    nmea_dispatch_init(&h.disp);
+    gps_epoch_attach(&h.ep, &h.disp);
+    gps_diag_init(&h.diag, nmea_dispatch_sentence, &h.disp, gps_epoch_on_ubx, &h.ep);
+    gps_stream_init(&h.st, gps_diag_sentence, &h.diag, gps_diag_ubx, &h.diag);
+
+    vnow = 0;
+    gps_diag_report(&h.diag, &h.st, NULL, sc->baud, vnow, &r);
+    next_report = REPORT_S * 1000000000LL;
+
+    for (int i = 0; i <= epochs; i++) {
+        int64_t t0 = (int64_t)i * 1000000000LL / sc->rate_hz + 1000000;   // 시각 펄스 후 1ms
+
+        // 이번 epoch 출력 전까지: 줄에 남은 바이트 전달 후 유휴
+        host_idle(&h, t0);
+        while (vnow >= next_report) {
+            gps_diag_report(&h.diag, &h.st, NULL, sc->baud, vnow, &r);
+            next_report += REPORT_S * 1000000000LL;
+            s.intervals++;
+            s.saturated += r.saturated;
+            if (r.util > s.util_max) s.util_max = r.util;
+            if (r.busy > s.busy_max) s.busy_max = r.busy;
+            if (r.jitter_p99_us > s.jit_p99_max) s.jit_p99_max = r.jitter_p99_us;
+            if (r.latency_p99_us > s.lat_p99_max) s.lat_p99_max = r.latency_p99_us;
+            s.gaps      += r.d.gaps;
+            s.checksum  += r.d.checksum_errors;
+            s.framing   += r.d.framing_errors;
+            s.truncated += r.d.truncated;
+            s.tag_errors += r.d.tag_errors;
+            s.epochs    += r.d.epochs;
+        }
+        if (i == epochs) break;
+
+        // 메시지 단위로 TX 버퍼에 넣기 (자리가 없으면 버림)
+        for (int m = 0; m < NMEA_TYPE_COUNT + 3; m++) {
+            size_t n;
+            const char *p = msg;
+
+            if (m < NMEA_TYPE_COUNT) {
+                if (!(sc->nmea_mask & (1u << m))) continue;
+                n = nmea_synth_type(msg, i, sc->rate_hz, (NmeaType)m);
+            } else {
+                if (!sc->ubx) continue;
+                n = ubx_synth_nav(ubx, i, sc->rate_hz, ubx_ids[m - NMEA_TYPE_COUNT]);
+                p = (const char *)ubx;
+            }
+            if (line_free < t0) line_free = t0;
+            if ((line_free - t0) / byte_ns + (int64_t)n > TXBUF) { s.dropped++; continue; }
+
+            // 바이트마다 도착 시각, 유휴 간격이 생기거나 chunk 가 차면 read()
+            for (size_t k = 0; k < n; k++) {
+                int64_t t = line_free + byte_ns;
+                char    c = p[k];
+
+                if (sc->ber > 0 && synth_urand() < sc->ber * 10) c ^= (char)(1 << (int)(synth_urand() * 8));
+                if (h.nchunk && t > vnow + 2 * byte_ns) host_flush(&h);
+                host_idle(&h, t);
+                vnow = t;
+                h.chunk[h.nchunk++] = c;
+                if (h.nchunk >= h.chunk_max) host_flush(&h);
+                line_free = t;
+            }
+            host_flush(&h);
+        }
+    }
+    gps_epoch_flush(&h.ep);
+
+    printf("%-34s %5.0f%% %4.0f%% %6.2f %5llu %5llu %4llu/%-4llu %4llu %4llu %6.1f %6.1f  %d/%d\n",
+           sc->name, s.util_max * 100.0, s.busy_max * 100.0,
+           s.intervals ? (double)s.epochs / (s.intervals * REPORT_S) : 0.0,
+           (unsigned long long)s.gaps, (unsigned long long)s.dropped,
+           (unsigned long long)s.checksum, (unsigned long long)s.framing,
+           (unsigned long long)s.truncated, (unsigned long long)s.tag_errors,
+           s.jit_p99_max / 1e3, s.lat_p99_max / 1e3, s.saturated, s.intervals);
+}
+
+int main(int argc, char **argv)
+{
+    int    seconds = 600, opt;
+    size_t chunk   = 16;
+    const unsigned all = (1u << NMEA_TYPE_COUNT) - 1;
+    const unsigned min = (1u << NMEA_RMC) | (1u << NMEA_GGA);
+    const Scenario sc[] = {
+        { "1 Hz default NMEA, 9600",          1, 9600,   all, 0, 0 },
+        { "1 Hz default NMEA + UBX NAV, 9600", 1, 9600,   all, 1, 0 },
+        { "2 Hz default NMEA, 9600",          2, 9600,   all, 0, 0 },
+        { "5 Hz RMC + GGA, 9600",             5, 9600,   min, 0, 0 },
+        { "5 Hz default NMEA, 9600",          5, 9600,   all, 0, 0 },
+        { "5 Hz default NMEA, 115200",        5, 115200, all, 0, 0 },
+        { "5 Hz UBX NAV only, 9600",          5, 9600,   0,   1, 0 },
+        { "1 Hz default NMEA, 9600, BER 1e-4", 1, 9600,   all, 0, 1e-4 },
+    };
+
+    while ((opt = getopt(argc, argv, "t:c:s:")) != -1) {
+        switch (opt) {
+            case 't': seconds = atoi(optarg);           break;
+            case 'c': chunk   = (size_t)atoi(optarg);   break;
+            case 's': synth_seed(strtoull(optarg, NULL, 0) | 1); break;
+            default:
+                fprintf(stderr, "usage: %s [-t seconds] [-c chunk] [-s seed]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (seconds < REPORT_S || chunk == 0 || chunk > 4096) {
+        fprintf(stderr, "seconds >= %d, chunk 1..4096\n", REPORT_S);
+        return 1;
+    }
+
+    bench_cost();
+
+    printf("\nscenarios: %d s, %zu byte read(), TX buffer %d B, report every %d s "
+           "(util / busy / p99 = worst interval)\n", seconds, chunk, TXBUF, REPORT_S);
+    printf("%-34s %6s %5s %6s %5s %5s %9s %4s %4s %6s %6s  %s\n", "scenario", "util", "busy",
+           "fix/s", "gaps", "drop", "ck/frm", "trnc", "tag", "jit99", "lat99", "saturated");
+    for (size_t i = 0; i < sizeof(sc) / sizeof(sc[0]); i++) run_scenario(&sc[i], seconds, chunk);
+    return 0;
+}
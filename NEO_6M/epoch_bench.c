@@ -0,0 +1,115 @@
+// epoch 조립기 지연 측정 (마지막 문장 수신 → fix 발행)
+//
+// 9600 baud NEO-6M 1Hz 출력을 가상 시계로 재현해 종료 판정 정책별로 비교
+//
+// 빌드: make epoch_bench
+// 실행: ./epoch_bench [epochs] [chunk]   (기본 3600 epoch, read() 당 16 바이트)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "nmea.h"
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_synth.h"
+
+#define BAUD_BYTE_NS    (1000000000LL / 960)    // 9600 8N1 = 960 byte/s
+#define EPOCH_NS        1000000000LL
+#define POLL_NS         1000000LL               // 유휴 구간 poll 간격
+
+// ─────────────────────────────────────────────
+//  가상 시계
+// ─────────────────────────────────────────────
+static int64_t vnow;     // run() 마다 0 부터
+
+static int64_t vclock(void)
+{
+    return vnow;
+}
+
+typedef struct {
+    long fixes;
+    long with_pos;
+} Count;
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Count *c = user;
+    c->fixes++;
+    if ((f->valid & (GPS_V_POS | GPS_V_SPEED | GPS_V_PDOP)) ==
+        (GPS_V_POS | GPS_V_SPEED | GPS_V_PDOP))
+        c->with_pos++;
+}
+
+static void run(const char *name, int timeout_ms, int learn, int epochs, size_t chunk)
+{
+    NmeaParser   parser;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    Count        cnt = {0};
+    char         buf[NMEA_SYNTH_EPOCH_MAX];
+    int64_t      last_rx = 0;
+
+    gps_epoch_init(&ep, on_fix, &cnt);
+    gps_epoch_set_policy(&ep, timeout_ms, learn);
+    gps_epoch_set_clock(&ep, vclock);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    nmea_parser_init(&parser, nmea_dispatch_sentence, &disp);
+
+    vnow = 0;
+    int64_t t0 = gps_now_ns();
+
+    for (int i = 0; i <= epochs; i++) {
+        int64_t start = (int64_t)i * EPOCH_NS + 1000000;    // 시각 펄스 후 1ms
+
+        // 유휴 구간: poll 만 호출
+        while (vnow + POLL_NS < start) {
+            vnow += POLL_NS;
+            gps_epoch_poll(&ep, last_rx, vnow);
+        }
+        if (i == epochs) break;
+
+        // 바이트 도착 시각 = start + k * 1 byte 시간, chunk 단위로 read()
+        size_t n = nmea_synth_epoch(buf, i, 1);
+        for (size_t off = 0; off < n; off += chunk) {
+            size_t k = (n - off < chunk) ? n - off : chunk;
+            vnow = start + (int64_t)(off + k) * BAUD_BYTE_NS;
+            nmea_parser_feed_at(&parser, buf + off, k, vnow);
+            last_rx = vnow;
+        }
+    }
+    gps_epoch_flush(&ep);
+
+    int64_t cpu = gps_now_ns() - t0;
+    const GpsEpochStats *s = &ep.stats;
+
+    printf("%-16s fixes=%ld complete=%ld  latency mean %8.3f ms  max %8.3f ms  "
+           "[order %llu timeout %llu time %llu late %llu]  cpu %.0f ns/epoch\n",
+           name, cnt.fixes, cnt.with_pos,
+           s->published ? s->latency_sum_ns / 1e6 / s->published : 0.0,
+           s->latency_max_ns / 1e6,
+           (unsigned long long)s->by[GPS_EPOCH_BY_ORDER],
+           (unsigned long long)s->by[GPS_EPOCH_BY_TIMEOUT],
+           (unsigned long long)s->by[GPS_EPOCH_BY_TIME],
+           (unsigned long long)s->late,
+           (double)cpu / epochs);
+}
+
+int main(int argc, char **argv)
+{
+    int    epochs = (argc > 1) ? atoi(argv[1]) : 3600;
+    size_t chunk  = (argc > 2) ? (size_t)atoi(argv[2]) : 16;
+
+    if (epochs <= 0 || chunk == 0 || chunk > 1024) {
+        fprintf(stderr, "usage: %s [epochs] [chunk 1..1024]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d epochs @1Hz, 9600 baud, %zu byte read()\n", epochs, chunk);
+    run("time tag only",  0,                    0,               epochs, chunk);
+    run("timeout 50ms",   GPS_EPOCH_TIMEOUT_MS, 0,               epochs, chunk);
+    run("learned order",  GPS_EPOCH_TIMEOUT_MS, GPS_EPOCH_LEARN, epochs, chunk);
+    return 0;
+}
@@ -0,0 +1,288 @@
+// 지오펜스 (geo_fence) 벤치마크
+//
+// 5 km × 5 km 안에 임의 별 모양 다각형 (꼭짓점 6~24개, 반경 5~50 m, 10% 금지 구역)
+// 과 넓은 허용 구역 몇 개를 만들고, 영역 전체에 고르게 뿌린 점을 질의한다.
+//
+// 보고: 색인 생성 시간 / 메모리, 질의 µs (p50 / p99) 와 초당 질의 수,
+//       전수 검사 (모든 다각형 포함 판정 + 모든 변 거리) 대비 결과 일치와 비용,
+//       임의 보행 궤적의 진입 / 이탈 이벤트 수
+//
+// 실행: ./fence_bench [-p polygons] [-q queries] [-c cell_m] [-v verify]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "geo.h"
+#include "geo_fence.h"
+#include "gps_fix.h"
+#include "gps_synth.h"
+
+#define ORIGIN_LAT      37.5665
+#define ORIGIN_LON      126.9780
+#define AREA            5000.0      // 한 변 (m), 원점 중심
+#define MIN_R           5.0
+#define MAX_R           50.0
+#define MIN_VERT        6
+#define MAX_VERT        24
+#define KEEPOUT_RATIO   0.1
+#define ALLOW_ZONES     4           // 넓은 허용 구역 (반경 600~1200 m)
+#define WALK_STEPS      200000      // 궤적 epoch 수 (1 m 걸음)
+
+typedef struct {
+    double *e, *n;
+    int     count;
+    int     keepout;
+} Poly;
+
+static Poly   *polys;
+static int     npoly;
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+/**
+ * @brief 중심 (ce, cn) 별 모양 다각형 (각도 순서라 자기 교차 없음)
+ */
+static void make_poly(Poly *p, double ce, double cn, double r, int count)
+{
+    p->count = count;
+    p->e     = malloc(count * sizeof(double));
+    p->n     = malloc(count * sizeof(double));
+    for (int i = 0; i < count; i++) {
+        double a  = 2.0 * M_PI * (i + 0.2 + 0.6 * synth_urand()) / count;
+        double ri = r * (0.4 + 0.6 * synth_urand());
+        p->e[i] = ce + ri * cos(a);
+        p->n[i] = cn + ri * sin(a);
+    }
+}
+
+static int add_poly(GeoFence *f, const GeoLtp *ltp, const Poly *p, int id)
+{
+    double lat[64], lon[64];    // 허용 구역 64, 작은 다각형 MAX_VERT
+    char   name[GEO_FENCE_NAME];
+
+    for (int i = 0; i < p->count; i++) geo_ltp_inv(ltp, p->e[i], p->n[i], &lat[i], &lon[i]);
+    snprintf(name, sizeof(name), "%s%d", p->keepout ? "ko" : "zone", id);
+    return geo_fence_add(f, p->keepout ? GEO_FENCE_KEEPOUT : GEO_FENCE_ALLOW, name,
+                         lat, lon, (size_t)p->count);
+}
+
+// ─────────────────────────────────────────────
+//  전수 검사 (기준)
+// ─────────────────────────────────────────────
+static int brute_inside(const Poly *p, double e, double n)
+{
+    int in = 0;
+
+    for (int i = 0, j = p->count - 1; i < p->count; j = i++)
+        if ((p->n[i] > n) != (p->n[j] > n) &&
+            e < p->e[j] + (n - p->n[j]) * (p->e[i] - p->e[j]) / (p->n[i] - p->n[j]))
+            in = !in;
+    return in;
+}
+
+static double brute_dist(const Poly *p, double e, double n)
+{
+    double best = INFINITY;
+
+    for (int i = 0, j = p->count - 1; i < p->count; j = i++) {
+        double de = p->e[i] - p->e[j], dn = p->n[i] - p->n[j];
+        double t  = ((e - p->e[j]) * de + (n - p->n[j]) * dn) / (de * de + dn * dn);
+        if (t < 0.0) t = 0.0;
+        else if (t > 1.0) t = 1.0;
+        double x = p->e[j] + t * de - e, y = p->n[j] + t * dn - n;
+        double d = sqrt(x * x + y * y);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+static void on_event(GeoFenceEvent ev, uint32_t poly, const GeoFenceResult *r, void *user)
+{
+    (void)ev;
+    (void)poly;
+    (void)r;
+    (void)user;
+}
+
+int main(int argc, char **argv)
+{
+    int    nsmall = 10000, nquery = 1000000, nverify = 2000, opt;
+    double cell_m = 0.0;
+
+    while ((opt = getopt(argc, argv, "p:q:c:v:")) != -1) {
+        switch (opt) {
+            case 'p': nsmall  = atoi(optarg); break;
+            case 'q': nquery  = atoi(optarg); break;
+            case 'c': cell_m  = atof(optarg); break;
+            case 'v': nverify = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-p polygons] [-q queries] [-c cell_m] [-v verify]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if (nsmall < 1 || nquery < 1 || nverify < 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+    if (nverify > nquery) nverify = nquery;
+
+    GeoLtp ltp;
+    geo_ltp_init(&ltp, ORIGIN_LAT, ORIGIN_LON, 0.0);
+
+    // 넓은 허용 구역 + 작은 다각형
+    npoly = ALLOW_ZONES + nsmall;
+    polys = calloc((size_t)npoly, sizeof(Poly));
+    if (!polys) { perror("calloc"); return 1; }
+    for (int i = 0; i < ALLOW_ZONES; i++)
+        make_poly(&polys[i], (synth_urand() - 0.5) * AREA * 0.6, (synth_urand() - 0.5) * AREA * 0.6,
+                  600.0 + 600.0 * synth_urand(), 64);
+    size_t nvert = 0;
+    for (int i = ALLOW_ZONES; i < npoly; i++) {
+        make_poly(&polys[i], (synth_urand() - 0.5) * AREA, (synth_urand() - 0.5) * AREA,
+                  MIN_R + (MAX_R - MIN_R) * synth_urand(),
+                  MIN_VERT + (int)(synth_urand() * (MAX_VERT - MIN_VERT + 1)));
+        polys[i].keepout = synth_urand() < KEEPOUT_RATIO;
+    }
+    for (int i = 0; i < npoly; i++) nvert += (size_t)polys[i].count;
+
+    GeoFence f;
+    geo_fence_init(&f);
+    geo_fence_set_origin(&f, ORIGIN_LAT, ORIGIN_LON);
+    double t0 = now_sec();
+    for (int i = 0; i < npoly; i++)
+        if (add_poly(&f, &ltp, &polys[i], i) < 0) { perror("geo_fence_add"); return 1; }
+    double t1 = now_sec();
+    if (geo_fence_build(&f, cell_m) < 0) { perror("geo_fence_build"); return 1; }
+    double t2 = now_sec();
+
+    printf("%d polygons (%d allow zones), %zu edges, %.0f m x %.0f m\n",
+           npoly, ALLOW_ZONES, nvert, AREA, AREA);
+    printf("add+project %.1f ms, build %.1f ms, grid %dx%d cell %.2f m, "
+           "%zu cell entries, %zu cell edges, %zu R-tree nodes, index %.1f MB\n",
+           (t1 - t0) * 1e3, (t2 - t1) * 1e3, f.nx, f.ny, f.cell, f.nentry, f.nseg, f.nnode,
+           geo_fence_index_memory(&f) / 1048576.0);
+
+    // 질의 점 (영역보다 5% 넓게, 바깥 점 포함)
+    double *qe = malloc((size_t)nquery * sizeof(double));
+    double *qn = malloc((size_t)nquery * sizeof(double));
+    double *qt = malloc((size_t)nquery * sizeof(double));
+    if (!qe || !qn || !qt) { perror("malloc"); return 1; }
+    for (int i = 0; i < nquery; i++) {
+        qe[i] = (synth_urand() - 0.5) * AREA * 1.05;
+        qn[i] = (synth_urand() - 0.5) * AREA * 1.05;
+    }
+
+    // 처리량 (ENU / 위도경도 입력)
+    GeoFenceResult r;
+    long           hits = 0, ok = 0;
+    double         sum_d = 0.0;
+    t0 = now_sec();
+    for (int i = 0; i < nquery; i++) {
+        geo_fence_query_enu(&f, qe[i], qn[i], &r);
+        hits  += (long)r.nhit;
+        ok    += r.ok;
+        sum_d += r.dist;
+    }
+    t1 = now_sec();
+    printf("\nquery (ENU)      %8.3f us/query  %10.0f queries/s  "
+           "(mean %.2f hits, %.1f%% ok, mean boundary dist %.1f m)\n",
+           (t1 - t0) * 1e6 / nquery, nquery / (t1 - t0),
+           (double)hits / nquery, 100.0 * ok / nquery, sum_d / nquery);
+
+    double *qlat = malloc((size_t)nquery * sizeof(double));
+    double *qlon = malloc((size_t)nquery * sizeof(double));
+    if (!qlat || !qlon) { perror("malloc"); return 1; }
+    for (int i = 0; i < nquery; i++) geo_ltp_inv(&ltp, qe[i], qn[i], &qlat[i], &qlon[i]);
+    t0 = now_sec();
+    for (int i = 0; i < nquery; i++) {
+        geo_fence_query(&f, qlat[i], qlon[i], &r);
+        hits += (long)r.nhit;
+    }
+    t1 = now_sec();
+    printf("query (lat/lon)  %8.3f us/query  %10.0f queries/s\n",
+           (t1 - t0) * 1e6 / nquery, nquery / (t1 - t0));
+
+    // 질의별 지연 분포
+    for (int i = 0; i < nquery; i++) {
+        int64_t a = gps_now_ns();
+        geo_fence_query_enu(&f, qe[i], qn[i], &r);
+        qt[i] = (gps_now_ns() - a) / 1e3;
+    }
+    qsort(qt, (size_t)nquery, sizeof(double), synth_cmp_double);
+    printf("latency (incl. clock)  p50 %.3f  p99 %.3f  p99.9 %.3f  max %.1f us\n",
+           qt[nquery / 2], qt[(size_t)nquery * 99 / 100], qt[(size_t)nquery * 999 / 1000],
+           qt[nquery - 1]);
+
+    // 전수 검사와 비교
+    if (nverify > 0) {
+        int    contain_bad = 0, dist_bad = 0, boundary = 0;
+        double max_diff = 0.0;
+        t0 = now_sec();
+        for (int i = 0; i < nverify; i++) {
+            double best = INFINITY;
+            int    in[GEO_FENCE_MAX_HITS], nin = 0;
+            for (int p = 0; p < npoly; p++) {
+                double d = brute_dist(&polys[p], qe[i], qn[i]);
+                if (d < best) best = d;
+                if (brute_inside(&polys[p], qe[i], qn[i]) && nin < GEO_FENCE_MAX_HITS) in[nin++] = p;
+            }
+            qt[i] = best;
+            geo_fence_query_enu(&f, qe[i], qn[i], &r);
+
+            // 위도경도 왕복 (sub-mm) 때문에 경계 1 mm 안은 어느 쪽이든 허용
+            double diff = fabs(r.dist - best);
+            if (diff > max_diff) max_diff = diff;
+            if (diff > 1e-3) dist_bad++;
+            if (best < 1e-3) { boundary++; continue; }
+            if ((size_t)nin != r.nhit) { contain_bad++; continue; }
+            for (int k = 0; k < nin; k++)
+                if ((uint32_t)in[k] != r.hit[k]) { contain_bad++; break; }
+        }
+        t1 = now_sec();
+        printf("\nverify %d queries vs brute force (all polygons, all edges): "
+               "containment mismatches %d, distance mismatches %d (max diff %.2g m), "
+               "on boundary %d\n", nverify, contain_bad, dist_bad, max_diff, boundary);
+        printf("brute force      %8.1f us/query\n", (t1 - t0) * 1e6 / nverify);
+        if (contain_bad || dist_bad) printf("MISMATCH\n");
+    }
+
+    // 임의 보행 궤적 (1 m 걸음, 방향 천천히 변화)
+    GeoFenceTrack tr;
+    geo_fence_track_init(&tr, on_event, NULL);
+    double e = 0.0, n = 0.0, hdg = 0.0;
+    long   in_keepout = 0;
+    t0 = now_sec();
+    for (int k = 0; k < WALK_STEPS; k++) {
+        hdg += (synth_urand() - 0.5) * 0.3;
+        e   += cos(hdg);
+        n   += sin(hdg);
+        if (fabs(e) > AREA / 2 || fabs(n) > AREA / 2) hdg += M_PI;
+        geo_fence_query_enu(&f, e, n, &r);
+        geo_fence_track_update(&tr, &r);
+        in_keepout += r.in_keepout;
+    }
+    t1 = now_sec();
+    printf("\nwalk %d steps: %llu enters, %llu exits, %ld epochs in keep-out, "
+           "%.3f us/epoch (query + events)\n", WALK_STEPS, (unsigned long long)tr.enters,
+           (unsigned long long)tr.exits, in_keepout, (t1 - t0) * 1e6 / WALK_STEPS);
+    if (tr.enters - tr.exits != tr.nin) printf("EVENT MISMATCH\n");
+
+    geo_fence_free(&f);
+    for (int i = 0; i < npoly; i++) {
+        free(polys[i].e);
+        free(polys[i].n);
+    }
+    free(polys);
+    free(qe);
+    free(qn);
+    free(qt);
+    free(qlat);
+    free(qlon);
+    return 0;
+}
@@ -0,0 +1,390 @@
+#include "geo.h"
+
+#include <math.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define GEO_SSE2    1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>   // float64x2_t 는 AArch64 만 (32비트 라즈비안은 스칼라)
+#define GEO_NEON    1
+#endif
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static double wrap360(double deg)
+{
+    deg = fmod(deg, 360.0);
+    return (deg < 0.0) ? deg + 360.0 : deg;
+}
+
+/**
+ * @brief 빠른 변환 계수 (sin_lat / cos_lat 설정 후 호출)
+ */
+static void ltp_scale(GeoLtp *p, double h)
+{
+    double s  = p->sin_lat, c = p->cos_lat;
+    double w  = 1.0 - GEO_WGS84_E2 * s * s;
+    double rn = GEO_WGS84_A / sqrt(w);              // 묘유선
+    double rm = rn * (1.0 - GEO_WGS84_E2) / w;      // 자오선
+
+    p->m_lat = (rm + h) * GEO_DEG2RAD;
+    p->m_lon = (rn + h) * c * GEO_DEG2RAD;
+    // d(ln(rn·cos φ))/dφ = e²·sinφ·cosφ / w - tan φ, 도 단위로
+    p->k_lon = (s / c - GEO_WGS84_E2 * s * c / w) * GEO_DEG2RAD;
+    // 위선 (소원) 은 접평면에서 북쪽으로 휨: n ≈ rn·sinφ·cosφ·Δλ² / 2
+    p->c_n   = 0.5 * (rn + h) * s * c * GEO_DEG2RAD * GEO_DEG2RAD;
+}
+
+// ─────────────────────────────────────────────
+//  ECEF / 단일 변환
+// ─────────────────────────────────────────────
+
+void geo_to_ecef(double lat, double lon, double h, double xyz[3])
+{
+    double sl = sin(lat * GEO_DEG2RAD), cl = cos(lat * GEO_DEG2RAD);
+    double so = sin(lon * GEO_DEG2RAD), co = cos(lon * GEO_DEG2RAD);
+    double rn = GEO_WGS84_A / sqrt(1.0 - GEO_WGS84_E2 * sl * sl);  // 묘유선 곡률 반경
+
+    xyz[0] = (rn + h) * cl * co;
+    xyz[1] = (rn + h) * cl * so;
+    xyz[2] = (rn * (1.0 - GEO_WGS84_E2) + h) * sl;
+}
+
+void geo_from_ecef(const double xyz[3], double *lat, double *lon, double *h)
+{
+    double p   = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1]);
+    double phi = atan2(xyz[2], p * (1.0 - GEO_WGS84_E2));  // h = 0 가정 초기값
+    double sl, cl, rn = GEO_WGS84_A;
+
+    // 고정점 반복: 오차가 매번 e² 배 이하로 줄어듦
+    for (int i = 0; i < 3; i++) {
+        sl  = sin(phi);
+        rn  = GEO_WGS84_A / sqrt(1.0 - GEO_WGS84_E2 * sl * sl);
+        phi = atan2(xyz[2] + GEO_WGS84_E2 * rn * sl, p);
+    }
+    sl = sin(phi);
+    cl = cos(phi);
+    rn = GEO_WGS84_A / sqrt(1.0 - GEO_WGS84_E2 * sl * sl);
+
+    *lat = phi * GEO_RAD2DEG;
+    *lon = atan2(xyz[1], xyz[0]) * GEO_RAD2DEG;
+    // 극 부근에서도 안정한 형태 (p / cos φ 대신)
+    *h   = p * cl + xyz[2] * sl - GEO_WGS84_A * GEO_WGS84_A / rn;
+}
+
+void geo_offset(double lat, double lon, double lat_ref, double lon_ref,
+                double *north_m, double *east_m)
+{
+    GeoLtp p;
+
+    // 빠른 변환에 필요한 계수만 (ECEF / 경도 삼각함수 생략)
+    p.lat0    = lat_ref;
+    p.lon0    = lon_ref;
+    p.sin_lat = sin(lat_ref * GEO_DEG2RAD);
+    p.cos_lat = cos(lat_ref * GEO_DEG2RAD);
+    ltp_scale(&p, 0.0);
+    geo_ltp_fwd(&p, lat, lon, east_m, north_m);
+}
+
+// ─────────────────────────────────────────────
+//  국소 접평면
+// ─────────────────────────────────────────────
+
+void geo_ltp_init(GeoLtp *p, double lat, double lon, double h)
+{
+    double phi = lat * GEO_DEG2RAD;
+
+    p->lat0    = lat;
+    p->lon0    = lon;
+    p->h0      = h;
+    p->lat0_e7 = (int32_t)lround(lat * 1e7);
+    p->lon0_e7 = (int32_t)lround(lon * 1e7);
+    p->sin_lat = sin(phi);
+    p->cos_lat = cos(phi);
+    p->sin_lon = sin(lon * GEO_DEG2RAD);
+    p->cos_lon = cos(lon * GEO_DEG2RAD);
+    geo_to_ecef(lat, lon, h, p->ecef0);
+    ltp_scale(p, h);
+}
+
+void geo_ltp_enu(const GeoLtp *p, double lat, double lon, double h,
+                 double *e, double *n, double *u)
+{
+    double xyz[3];
+
+    geo_to_ecef(lat, lon, h, xyz);
+    double dx = xyz[0] - p->ecef0[0];
+    double dy = xyz[1] - p->ecef0[1];
+    double dz = xyz[2] - p->ecef0[2];
+    double t  = p->cos_lon * dx + p->sin_lon * dy;
+
+    *e = -p->sin_lon * dx + p->cos_lon * dy;
+    *n = -p->sin_lat * t + p->cos_lat * dz;
+    *u =  p->cos_lat * t + p->sin_lat * dz;
+}
+
+void geo_ltp_geodetic(const GeoLtp *p, double e, double n, double u,
+                      double *lat, double *lon, double *h)
+{
+    double xyz[3];
+    double t = -p->sin_lat * n + p->cos_lat * u;    // ENU → ECEF 회전 (전치)
+
+    xyz[0] = p->ecef0[0] - p->sin_lon * e + p->cos_lon * t;
+    xyz[1] = p->ecef0[1] + p->cos_lon * e + p->sin_lon * t;
+    xyz[2] = p->ecef0[2] + p->cos_lat * n + p->sin_lat * u;
+    geo_from_ecef(xyz, lat, lon, h);
+}
+
+// ─────────────────────────────────────────────
+//  거리 / 방위
+// ─────────────────────────────────────────────
+
+double geo_haversine(double lat1, double lon1, double lat2, double lon2)
+{
+    double sdlat = sin((lat2 - lat1) * GEO_DEG2RAD * 0.5);
+    double sdlon = sin((lon2 - lon1) * GEO_DEG2RAD * 0.5);
+    double a = sdlat * sdlat + cos(lat1 * GEO_DEG2RAD) * cos(lat2 * GEO_DEG2RAD) * sdlon * sdlon;
+
+    if (a > 1.0) a = 1.0;
+    return 2.0 * GEO_R_MEAN * asin(sqrt(a));
+}
+
+double geo_bearing(double lat1, double lon1, double lat2, double lon2)
+{
+    double p1 = lat1 * GEO_DEG2RAD, p2 = lat2 * GEO_DEG2RAD;
+    double dl = (lon2 - lon1) * GEO_DEG2RAD;
+    double y  = sin(dl) * cos(p2);
+    double x  = cos(p1) * sin(p2) - sin(p1) * cos(p2) * cos(dl);
+
+    return wrap360(atan2(y, x) * GEO_RAD2DEG);
+}
+
+int geo_vincenty(double lat1, double lon1, double lat2, double lon2,
+                 double *dist, double *az1, double *az2)
+{
+    const double a = GEO_WGS84_A, f = GEO_WGS84_F, b = a * (1.0 - f);
+    double L  = (lon2 - lon1) * GEO_DEG2RAD;
+    double U1 = atan((1.0 - f) * tan(lat1 * GEO_DEG2RAD));  // 축약 위도
+    double U2 = atan((1.0 - f) * tan(lat2 * GEO_DEG2RAD));
+    double sU1 = sin(U1), cU1 = cos(U1), sU2 = sin(U2), cU2 = cos(U2);
+    double lam = L, lam_prev;
+    double s_sig = 0, c_sig = 1, sig = 0, c2_alpha = 1, c2_sm = 0, s_lam = 0, c_lam = 1;
+    int    iter = 0;
+
+    do {
+        s_lam = sin(lam);
+        c_lam = cos(lam);
+        double t1 = cU2 * s_lam, t2 = cU1 * sU2 - sU1 * cU2 * c_lam;
+        s_sig = sqrt(t1 * t1 + t2 * t2);
+        if (s_sig == 0.0) {                         // 같은 점
+            *dist = 0.0;
+            if (az1) *az1 = 0.0;
+            if (az2) *az2 = 0.0;
+            return 0;
+        }
+        c_sig = sU1 * sU2 + cU1 * cU2 * c_lam;
+        sig   = atan2(s_sig, c_sig);
+        double s_alpha = cU1 * cU2 * s_lam / s_sig;
+        c2_alpha = 1.0 - s_alpha * s_alpha;
+        c2_sm    = (c2_alpha != 0.0) ? c_sig - 2.0 * sU1 * sU2 / c2_alpha : 0.0;  // 적도선
+        double C = f / 16.0 * c2_alpha * (4.0 + f * (4.0 - 3.0 * c2_alpha));
+        lam_prev = lam;
+        lam = L + (1.0 - C) * f * s_alpha *
+              (sig + C * s_sig * (c2_sm + C * c_sig * (-1.0 + 2.0 * c2_sm * c2_sm)));
+    } while (fabs(lam - lam_prev) > 1e-12 && ++iter < GEO_VINCENTY_ITER);
+
+    if (iter >= GEO_VINCENTY_ITER) return -1;
+
+    double u2 = c2_alpha * (a * a - b * b) / (b * b);
+    double A  = 1.0 + u2 / 16384.0 * (4096.0 + u2 * (-768.0 + u2 * (320.0 - 175.0 * u2)));
+    double B  = u2 / 1024.0 * (256.0 + u2 * (-128.0 + u2 * (74.0 - 47.0 * u2)));
+    double d_sig = B * s_sig * (c2_sm + B / 4.0 * (c_sig * (-1.0 + 2.0 * c2_sm * c2_sm) -
+                   B / 6.0 * c2_sm * (-3.0 + 4.0 * s_sig * s_sig) * (-3.0 + 4.0 * c2_sm * c2_sm)));
+
+    *dist = b * A * (sig - d_sig);
+    if (az1) *az1 = wrap360(atan2(cU2 * s_lam, cU1 * sU2 - sU1 * cU2 * c_lam) * GEO_RAD2DEG);
+    if (az2) *az2 = wrap360(atan2(cU1 * s_lam, -sU1 * cU2 + cU1 * sU2 * c_lam) * GEO_RAD2DEG);
+    return 0;
+}
+
+// ─────────────────────────────────────────────
+//  배치 (2개씩 SIMD, 나머지는 스칼라)
+// ─────────────────────────────────────────────
+
+void geo_ltp_fwd_batch(const GeoLtp *p, const double *lat, const double *lon,
+                       double *e, double *n, size_t count)
+{
+    size_t i = 0;
+
+#if defined(GEO_SSE2)
+    const __m128d lat0 = _mm_set1_pd(p->lat0), lon0 = _mm_set1_pd(p->lon0);
+    const __m128d mlat = _mm_set1_pd(p->m_lat), mlon = _mm_set1_pd(p->m_lon);
+    const __m128d klon = _mm_set1_pd(p->k_lon), cn = _mm_set1_pd(p->c_n);
+    const __m128d one  = _mm_set1_pd(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d dlat = _mm_sub_pd(_mm_loadu_pd(lat + i), lat0);
+        __m128d dlon = _mm_sub_pd(_mm_loadu_pd(lon + i), lon0);
+        __m128d sc   = _mm_mul_pd(mlon, _mm_sub_pd(one, _mm_mul_pd(klon, dlat)));
+        __m128d bend = _mm_mul_pd(_mm_mul_pd(dlon, dlon), cn);
+        _mm_storeu_pd(n + i, _mm_add_pd(_mm_mul_pd(dlat, mlat), bend));
+        _mm_storeu_pd(e + i, _mm_mul_pd(dlon, sc));
+    }
+#elif defined(GEO_NEON)
+    const float64x2_t lat0 = vdupq_n_f64(p->lat0), lon0 = vdupq_n_f64(p->lon0);
+    const float64x2_t mlat = vdupq_n_f64(p->m_lat), mlon = vdupq_n_f64(p->m_lon);
+    const float64x2_t klon = vdupq_n_f64(p->k_lon), cn = vdupq_n_f64(p->c_n);
+    const float64x2_t one  = vdupq_n_f64(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t dlat = vsubq_f64(vld1q_f64(lat + i), lat0);
+        float64x2_t dlon = vsubq_f64(vld1q_f64(lon + i), lon0);
+        float64x2_t sc   = vmulq_f64(mlon, vsubq_f64(one, vmulq_f64(klon, dlat)));
+        float64x2_t bend = vmulq_f64(vmulq_f64(dlon, dlon), cn);
+        vst1q_f64(n + i, vaddq_f64(vmulq_f64(dlat, mlat), bend));
+        vst1q_f64(e + i, vmulq_f64(dlon, sc));
+    }
+#endif
+    for (; i < count; i++)
+        geo_ltp_fwd(p, lat[i], lon[i], &e[i], &n[i]);
+}
+
+void geo_ltp_fwd_e7_batch(const GeoLtp *p, const int32_t *lat_e7, const int32_t *lon_e7,
+                          double *e, double *n, size_t count)
+{
+    // 1e-7 도 단위 계수 (정수 차분 → double 변환 후 곱셈만)
+    const double mlat = p->m_lat * 1e-7, mlon = p->m_lon * 1e-7, klon = p->k_lon * 1e-7;
+    const double cn   = p->c_n * 1e-14;
+    const double lat0 = p->lat0_e7, lon0 = p->lon0_e7;
+    size_t i = 0;
+
+#if defined(GEO_SSE2)
+    const __m128d vlat0 = _mm_set1_pd(lat0), vlon0 = _mm_set1_pd(lon0);
+    const __m128d vmlat = _mm_set1_pd(mlat), vmlon = _mm_set1_pd(mlon);
+    const __m128d vklon = _mm_set1_pd(klon), vcn = _mm_set1_pd(cn);
+    const __m128d one   = _mm_set1_pd(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d la   = _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i *)(lat_e7 + i)));
+        __m128d lo   = _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i *)(lon_e7 + i)));
+        __m128d dlat = _mm_sub_pd(la, vlat0);
+        __m128d dlon = _mm_sub_pd(lo, vlon0);
+        __m128d sc   = _mm_mul_pd(vmlon, _mm_sub_pd(one, _mm_mul_pd(vklon, dlat)));
+        __m128d bend = _mm_mul_pd(_mm_mul_pd(dlon, dlon), vcn);
+        _mm_storeu_pd(n + i, _mm_add_pd(_mm_mul_pd(dlat, vmlat), bend));
+        _mm_storeu_pd(e + i, _mm_mul_pd(dlon, sc));
+    }
+#elif defined(GEO_NEON)
+    const float64x2_t vlat0 = vdupq_n_f64(lat0), vlon0 = vdupq_n_f64(lon0);
+    const float64x2_t vmlat = vdupq_n_f64(mlat), vmlon = vdupq_n_f64(mlon);
+    const float64x2_t vklon = vdupq_n_f64(klon), vcn = vdupq_n_f64(cn);
+    const float64x2_t one   = vdupq_n_f64(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t la   = vcvtq_f64_s64(vmovl_s32(vld1_s32(lat_e7 + i)));
+        float64x2_t lo   = vcvtq_f64_s64(vmovl_s32(vld1_s32(lon_e7 + i)));
+        float64x2_t dlat = vsubq_f64(la, vlat0);
+        float64x2_t dlon = vsubq_f64(lo, vlon0);
+        float64x2_t sc   = vmulq_f64(vmlon, vsubq_f64(one, vmulq_f64(vklon, dlat)));
+        float64x2_t bend = vmulq_f64(vmulq_f64(dlon, dlon), vcn);
+        vst1q_f64(n + i, vaddq_f64(vmulq_f64(dlat, vmlat), bend));
+        vst1q_f64(e + i, vmulq_f64(dlon, sc));
+    }
+#endif
+    for (; i < count; i++) {
+        double dlat = lat_e7[i] - lat0, dlon = lon_e7[i] - lon0;
+        n[i] = dlat * mlat + dlon * dlon * cn;
+        e[i] = dlon * mlon * (1.0 - klon * dlat);
+    }
+}
+
+void geo_ltp_inv_batch(const GeoLtp *p, const double *e, const double *n,
+                       double *lat, double *lon, size_t count)
+{
+    size_t i = 0;
+
+#if defined(GEO_SSE2)
+    const __m128d lat0 = _mm_set1_pd(p->lat0), lon0 = _mm_set1_pd(p->lon0);
+    const __m128d mlat = _mm_set1_pd(p->m_lat), mlon = _mm_set1_pd(p->m_lon);
+    const __m128d klon = _mm_set1_pd(p->k_lon), cn = _mm_set1_pd(p->c_n);
+    const __m128d one  = _mm_set1_pd(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d ve   = _mm_loadu_pd(e + i), vn = _mm_loadu_pd(n + i);
+        __m128d dlat = _mm_div_pd(vn, mlat);
+        __m128d dlon = _mm_div_pd(ve, _mm_mul_pd(mlon, _mm_sub_pd(one, _mm_mul_pd(klon, dlat))));
+        dlat = _mm_div_pd(_mm_sub_pd(vn, _mm_mul_pd(_mm_mul_pd(dlon, dlon), cn)), mlat);
+        dlon = _mm_div_pd(ve, _mm_mul_pd(mlon, _mm_sub_pd(one, _mm_mul_pd(klon, dlat))));
+        _mm_storeu_pd(lat + i, _mm_add_pd(lat0, dlat));
+        _mm_storeu_pd(lon + i, _mm_add_pd(lon0, dlon));
+    }
+#elif defined(GEO_NEON)
+    const float64x2_t lat0 = vdupq_n_f64(p->lat0), lon0 = vdupq_n_f64(p->lon0);
+    const float64x2_t mlat = vdupq_n_f64(p->m_lat), mlon = vdupq_n_f64(p->m_lon);
+    const float64x2_t klon = vdupq_n_f64(p->k_lon), cn = vdupq_n_f64(p->c_n);
+    const float64x2_t one  = vdupq_n_f64(1.0);
+
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t ve   = vld1q_f64(e + i), vn = vld1q_f64(n + i);
+        float64x2_t dlat = vdivq_f64(vn, mlat);
+        float64x2_t dlon = vdivq_f64(ve, vmulq_f64(mlon, vsubq_f64(one, vmulq_f64(klon, dlat))));
+        dlat = vdivq_f64(vsubq_f64(vn, vmulq_f64(vmulq_f64(dlon, dlon), cn)), mlat);
+        dlon = vdivq_f64(ve, vmulq_f64(mlon, vsubq_f64(one, vmulq_f64(klon, dlat))));
+        vst1q_f64(lat + i, vaddq_f64(lat0, dlat));
+        vst1q_f64(lon + i, vaddq_f64(lon0, dlon));
+    }
+#endif
+    for (; i < count; i++)
+        geo_ltp_inv(p, e[i], n[i], &lat[i], &lon[i]);
+}
+
+double geo_path_length(const double *e, const double *n, double *seg, size_t count)
+{
+    double total = 0.0;
+    size_t i = 0;
+
+    if (count < 2) return 0.0;
+
+#if defined(GEO_SSE2)
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 3 <= count; i += 2) {
+        __m128d de = _mm_sub_pd(_mm_loadu_pd(e + i + 1), _mm_loadu_pd(e + i));
+        __m128d dn = _mm_sub_pd(_mm_loadu_pd(n + i + 1), _mm_loadu_pd(n + i));
+        __m128d d  = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(de, de), _mm_mul_pd(dn, dn)));
+        if (seg) _mm_storeu_pd(seg + i, d);
+        acc = _mm_add_pd(acc, d);
+    }
+    double lane[2];
+    _mm_storeu_pd(lane, acc);
+    total = lane[0] + lane[1];
+#elif defined(GEO_NEON)
+    float64x2_t acc = vdupq_n_f64(0.0);
+    for (; i + 3 <= count; i += 2) {
+        float64x2_t de = vsubq_f64(vld1q_f64(e + i + 1), vld1q_f64(e + i));
+        float64x2_t dn = vsubq_f64(vld1q_f64(n + i + 1), vld1q_f64(n + i));
+        float64x2_t d  = vsqrtq_f64(vaddq_f64(vmulq_f64(de, de), vmulq_f64(dn, dn)));
+        if (seg) vst1q_f64(seg + i, d);
+        acc = vaddq_f64(acc, d);
+    }
+    total = vaddvq_f64(acc);
+#endif
+    for (; i + 1 < count; i++) {
+        double de = e[i + 1] - e[i], dn = n[i + 1] - n[i];
+        double d  = sqrt(de * de + dn * dn);
+        if (seg) seg[i] = d;
+        total += d;
+    }
+    return total;
+}
+
+void geo_haversine_batch(const double *lat1, const double *lon1,
+                         const double *lat2, const double *lon2,
+                         double *dist, size_t count)
+{
+    // sin/cos/asin 는 SIMD 명령이 없으므로 점마다 호출 (궤적은 GeoLtp 배치 권장)
+    for (size_t i = 0; i < count; i++)
+        dist[i] = geo_haversine(lat1[i], lon1[i], lat2[i], lon2[i]);
+}
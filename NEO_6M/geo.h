@@ -0,0 +1,177 @@
+#ifndef GEO_H
+#define GEO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────────────────────────────────────────
+//  WGS-84 측지 계산
+//
+//  - 위도/경도/고도 ↔ ECEF ↔ ENU 정확 변환
+//  - 기준점 고정 국소 접평면 (GeoLtp): 기준점의 삼각함수 / 곡률 반경을
+//    미리 계산해 두고 점마다 곱셈·덧셈만 사용 (삼각함수 호출 없음)
+//  - 거리 / 방위: haversine (구, 빠름), Vincenty (타원체, mm 정확도)
+//  - 궤적 전체용 SoA 배치 함수 (SSE2 / AArch64 NEON, 그 외는 스칼라)
+//
+//  각도는 모두 도, 거리는 m, 방위는 진북 기준 시계 방향 도 (0~360)
+// ─────────────────────────────────────────────
+
+#define GEO_WGS84_A     6378137.0               // 장반경 (m)
+#define GEO_WGS84_F     (1.0 / 298.257223563)   // 편평률
+#define GEO_WGS84_E2    6.69437999014e-3        // 제1 이심률²
+#define GEO_R_MEAN      6371008.8               // 평균 반경 (haversine)
+
+#define GEO_DEG2RAD     0.017453292519943295
+#define GEO_RAD2DEG     57.29577951308232
+
+#define GEO_VINCENTY_ITER   200     // 대척점 부근에서 수렴하지 않으면 실패
+
+// ─────────────────────────────────────────────
+//  기준점 고정 국소 접평면 (내부 필드는 직접 접근하지 말 것)
+//
+//  빠른 변환: 기준 위도의 자오선/묘유선 곡률 반경으로 도 → m,
+//  경도 계수는 위도 차에 대한 1차 보정 (cos 의 기울기),
+//  북쪽은 위선이 접평면에서 휘는 양 (경도 차²) 을 보정
+//  → 기준점에서 10 km 이내 cm 수준 (geo_bench 참고)
+// ─────────────────────────────────────────────
+typedef struct {
+    double  lat0, lon0, h0;         // 기준점 (도, m)
+    int32_t lat0_e7, lon0_e7;       // 기준점 (1e-7 도, 정수 차분용)
+    double  sin_lat, cos_lat;
+    double  sin_lon, cos_lon;
+    double  ecef0[3];               // 기준점 ECEF
+    double  m_lat;                  // 위도 1도의 길이 (m)
+    double  m_lon;                  // 기준 위도에서 경도 1도의 길이 (m)
+    double  k_lon;                  // 경도 계수의 위도 기울기 (1/도)
+    double  c_n;                    // 위선 곡률에 의한 북쪽 보정 (m/도²)
+} GeoLtp;
+
+// ─────────────────────────────────────────────
+//  ECEF / 단일 변환
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 위도/경도/타원체고 → ECEF (m)
+ */
+void geo_to_ecef(double lat, double lon, double h, double xyz[3]);
+
+/**
+ * @brief ECEF → 위도/경도/타원체고 (반복 3회, 지표 부근 0.1 mm 이하)
+ */
+void geo_from_ecef(const double xyz[3], double *lat, double *lon, double *h);
+
+/**
+ * @brief ref 기준 점의 북/동 거리 (m), 기존 calc_offset() 대체
+ *
+ * 기준점마다 곡률 반경을 새로 계산하므로 같은 기준점을 반복해 쓰면
+ * GeoLtp 가 빠르다.
+ */
+void geo_offset(double lat, double lon, double lat_ref, double lon_ref,
+                double *north_m, double *east_m);
+
+// ─────────────────────────────────────────────
+//  국소 접평면
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 기준점 설정 (삼각함수 / 곡률 반경 미리 계산)
+ */
+void geo_ltp_init(GeoLtp *p, double lat, double lon, double h);
+
+/**
+ * @brief 위도/경도 → 동/북 (m), 빠른 평면 근사
+ */
+static inline void geo_ltp_fwd(const GeoLtp *p, double lat, double lon, double *e, double *n)
+{
+    double dlat = lat - p->lat0, dlon = lon - p->lon0;
+
+    *n = dlat * p->m_lat + dlon * dlon * p->c_n;
+    *e = dlon * p->m_lon * (1.0 - p->k_lon * dlat);
+}
+
+/**
+ * @brief 동/북 (m) → 위도/경도, geo_ltp_fwd 의 역변환 (고정점 2회, 왕복 오차 50 km 에서 1 cm 이하)
+ */
+static inline void geo_ltp_inv(const GeoLtp *p, double e, double n, double *lat, double *lon)
+{
+    double dlat = n / p->m_lat;
+    double dlon = e / (p->m_lon * (1.0 - p->k_lon * dlat));
+
+    dlat = (n - dlon * dlon * p->c_n) / p->m_lat;
+    dlon = e / (p->m_lon * (1.0 - p->k_lon * dlat));
+    *lat = p->lat0 + dlat;
+    *lon = p->lon0 + dlon;
+}
+
+/**
+ * @brief 위도/경도/타원체고 → 동/북/상 (m), ECEF 경유 정확 변환
+ */
+void geo_ltp_enu(const GeoLtp *p, double lat, double lon, double h,
+                 double *e, double *n, double *u);
+
+/**
+ * @brief 동/북/상 (m) → 위도/경도/타원체고, ECEF 경유 정확 변환
+ */
+void geo_ltp_geodetic(const GeoLtp *p, double e, double n, double u,
+                      double *lat, double *lon, double *h);
+
+// ─────────────────────────────────────────────
+//  거리 / 방위
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 대원 거리 (m, 구 근사 오차 최대 0.5%)
+ */
+double geo_haversine(double lat1, double lon1, double lat2, double lon2);
+
+/**
+ * @brief 1 → 2 초기 방위 (구, 도)
+ */
+double geo_bearing(double lat1, double lon1, double lat2, double lon2);
+
+/**
+ * @brief 타원체 측지선 거리 / 방위 (Vincenty 역문제)
+ * @param az1 1 에서의 방위 (NULL 가능)
+ * @param az2 2 에서의 진행 방위 (NULL 가능)
+ * @return 0: 성공, -1: 수렴 실패 (거의 대척점)
+ */
+int geo_vincenty(double lat1, double lon1, double lat2, double lon2,
+                 double *dist, double *az1, double *az2);
+
+// ─────────────────────────────────────────────
+//  배치 (SoA, 입력과 출력 배열은 겹치면 안 됨)
+// ─────────────────────────────────────────────
+
+/**
+ * @brief geo_ltp_fwd 배치
+ */
+void geo_ltp_fwd_batch(const GeoLtp *p, const double *lat, const double *lon,
+                       double *e, double *n, size_t count);
+
+/**
+ * @brief GpsFix 좌표 (1e-7 도) 배치, 정수로 기준점과 차분해 자리수 손실 없음
+ */
+void geo_ltp_fwd_e7_batch(const GeoLtp *p, const int32_t *lat_e7, const int32_t *lon_e7,
+                          double *e, double *n, size_t count);
+
+/**
+ * @brief geo_ltp_inv 배치
+ */
+void geo_ltp_inv_batch(const GeoLtp *p, const double *e, const double *n,
+                       double *lat, double *lon, size_t count);
+
+/**
+ * @brief 연속한 점 사이 거리 (접평면), seg[i] = |p[i+1] - p[i]|
+ * @param count 점 개수 (seg 는 count - 1 개)
+ * @return 전체 길이 (m)
+ */
+double geo_path_length(const double *e, const double *n, double *seg, size_t count);
+
+/**
+ * @brief 점 쌍마다 haversine 거리 (삼각함수라 스칼라)
+ */
+void geo_haversine_batch(const double *lat1, const double *lon1,
+                         const double *lat2, const double *lon2,
+                         double *dist, size_t count);
+
+#endif /* GEO_H */
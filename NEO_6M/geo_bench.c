@@ -0,0 +1,220 @@
+// 측지 계산 벤치마크: 기존 calc_offset() (111320 m/도 평면 근사) vs geo
+//
+// 기준점 주변 반경 100m ~ 50km 에 무작위 점을 뿌리고 ECEF 경유 정확한
+// ENU (geo_ltp_enu) 를 정답으로 북/동 오차를, Vincenty 를 정답으로 거리
+// 오차를 잰다. 이어서 함수별 점 1개당 비용 (ns) 을 측정한다.
+//
+// 빌드: make geo_bench
+// 실행: ./geo_bench [points]   (기본 200000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include "geo.h"
+#include "gps_fix.h"
+#include "gps_synth.h"
+
+#define LAT0        37.5665
+#define LON0        126.9780
+#define COST_REPEAT 20
+
+static const double radius_m[] = { 100.0, 1000.0, 10000.0, 50000.0 };
+#define RADIUS_COUNT (int)(sizeof(radius_m) / sizeof(radius_m[0]))
+
+// ─────────────────────────────────────────────
+//  기존 방식 (gps_neo.c / kalman_neo.c 와 동일)
+// ─────────────────────────────────────────────
+static void calc_offset(double lat1, double lon1, double lat2, double lon2,
+                        double *north_m, double *east_m)
+{
+    *north_m = (lat1 - lat2) * 111320.0;
+    *east_m  = (lon1 - lon2) * 111320.0 * cos(lat1 * M_PI / 180.0);
+}
+
+// ─────────────────────────────────────────────
+//  데이터 (SoA)
+// ─────────────────────────────────────────────
+typedef struct {
+    double  *lat, *lon;
+    int32_t *lat_e7, *lon_e7;
+    double  *e, *n;             // 출력
+    double  *lat2, *lon2;       // 역변환 출력 / 거리 짝
+} Track;
+
+static int track_alloc(Track *t, size_t count)
+{
+    t->lat    = malloc(count * sizeof(double));
+    t->lon    = malloc(count * sizeof(double));
+    t->lat_e7 = malloc(count * sizeof(int32_t));
+    t->lon_e7 = malloc(count * sizeof(int32_t));
+    t->e      = malloc(count * sizeof(double));
+    t->n      = malloc(count * sizeof(double));
+    t->lat2   = malloc(count * sizeof(double));
+    t->lon2   = malloc(count * sizeof(double));
+    return (t->lat && t->lon && t->lat_e7 && t->lon_e7 && t->e && t->n && t->lat2 && t->lon2) ? 0 : -1;
+}
+
+/**
+ * @brief 기준점 주변 반경 r 원판에 균일 분포 (정확 역변환으로 위도/경도)
+ */
+static void scatter(Track *t, const GeoLtp *p, size_t count, double r)
+{
+    for (size_t i = 0; i < count; i++) {
+        double d = r * sqrt(synth_urand()), a = 2.0 * M_PI * synth_urand(), h;
+        geo_ltp_geodetic(p, d * sin(a), d * cos(a), 0.0, &t->lat[i], &t->lon[i], &h);
+        t->lat_e7[i] = (int32_t)lround(t->lat[i] * 1e7);
+        t->lon_e7[i] = (int32_t)lround(t->lon[i] * 1e7);
+    }
+}
+
+typedef struct {
+    double sum2, max;
+    long   cnt;
+} Err;
+
+static void add_err(Err *er, double d)
+{
+    d = fabs(d);
+    er->sum2 += d * d;
+    if (d > er->max) er->max = d;
+    er->cnt++;
+}
+
+static double rms(const Err *er)
+{
+    return er->cnt ? sqrt(er->sum2 / er->cnt) : 0.0;
+}
+
+// ─────────────────────────────────────────────
+//  정확도
+// ─────────────────────────────────────────────
+static void accuracy(Track *t, const GeoLtp *p, size_t count)
+{
+    printf("offset error vs exact ENU (m)          legacy calc_offset     GeoLtp fast\n");
+    printf("%-10s %12s %12s %12s %12s\n", "radius", "RMS", "max", "RMS", "max");
+
+    for (int r = 0; r < RADIUS_COUNT; r++) {
+        Err old = {0}, ltp = {0};
+
+        scatter(t, p, count, radius_m[r]);
+        for (size_t i = 0; i < count; i++) {
+            double te, tn, tu, e, n;
+            geo_ltp_enu(p, t->lat[i], t->lon[i], 0.0, &te, &tn, &tu);
+
+            calc_offset(t->lat[i], t->lon[i], LAT0, LON0, &n, &e);
+            add_err(&old, hypot(e - te, n - tn));
+            geo_ltp_fwd(p, t->lat[i], t->lon[i], &e, &n);
+            add_err(&ltp, hypot(e - te, n - tn));
+        }
+        printf("%8.0fm %12.4f %12.4f %12.4f %12.4f\n", radius_m[r],
+               rms(&old), old.max, rms(&ltp), ltp.max);
+    }
+
+    printf("\ndistance error vs Vincenty (m)         legacy hypot   haversine      GeoLtp hypot\n");
+    printf("%-10s %12s %12s %12s\n", "radius", "max", "max", "max");
+
+    for (int r = 0; r < RADIUS_COUNT; r++) {
+        Err old = {0}, hav = {0}, ltp = {0};
+
+        scatter(t, p, count, radius_m[r]);
+        for (size_t i = 0; i < count; i++) {
+            double d, e, n;
+            if (geo_vincenty(LAT0, LON0, t->lat[i], t->lon[i], &d, NULL, NULL) < 0) continue;
+
+            calc_offset(t->lat[i], t->lon[i], LAT0, LON0, &n, &e);
+            add_err(&old, hypot(e, n) - d);
+            add_err(&hav, geo_haversine(LAT0, LON0, t->lat[i], t->lon[i]) - d);
+            geo_ltp_fwd(p, t->lat[i], t->lon[i], &e, &n);
+            add_err(&ltp, hypot(e, n) - d);
+        }
+        printf("%8.0fm %12.4f %12.4f %12.4f\n", radius_m[r], old.max, hav.max, ltp.max);
+    }
+
+    // 정확 변환 왕복 (고도 -100m ~ 10km)
+    Err rt = {0};
+    for (size_t i = 0; i < count; i++) {
+        double e = 1e5 * (synth_urand() - 0.5), n = 1e5 * (synth_urand() - 0.5), u = -100.0 + 10100.0 * synth_urand();
+        double lat, lon, h, e2, n2, u2;
+        geo_ltp_geodetic(p, e, n, u, &lat, &lon, &h);
+        geo_ltp_enu(p, lat, lon, h, &e2, &n2, &u2);
+        add_err(&rt, sqrt((e2 - e) * (e2 - e) + (n2 - n) * (n2 - n) + (u2 - u) * (u2 - u)));
+    }
+    printf("\nENU -> geodetic -> ENU round trip: max %.2e m\n\n", rt.max);
+}
+
+// ─────────────────────────────────────────────
+//  비용
+// ─────────────────────────────────────────────
+static double now_ns(void)
+{
+    return (double)gps_now_ns();
+}
+
+#define TIME(label, body)                                                   \
+    do {                                                                    \
+        double t0 = now_ns();                                               \
+        for (int rep = 0; rep < COST_REPEAT; rep++) { body; }               \
+        printf("%-28s %8.2f ns/point\n", label,                             \
+               (now_ns() - t0) / ((double)count * COST_REPEAT));            \
+    } while (0)
+
+static void cost(Track *t, const GeoLtp *p, size_t count)
+{
+    volatile double sink = 0;
+    double          s;
+
+    scatter(t, p, count, 10000.0);
+    for (size_t i = 0; i < count; i++) {
+        t->lat2[i] = t->lat[(i + 1) % count];
+        t->lon2[i] = t->lon[(i + 1) % count];
+    }
+
+    TIME("legacy calc_offset",
+         for (size_t i = 0; i < count; i++)
+             calc_offset(t->lat[i], t->lon[i], LAT0, LON0, &t->n[i], &t->e[i]));
+    TIME("geo_offset (per-call anchor)",
+         for (size_t i = 0; i < count; i++)
+             geo_offset(t->lat[i], t->lon[i], LAT0, LON0, &t->n[i], &t->e[i]));
+    TIME("geo_ltp_fwd",
+         for (size_t i = 0; i < count; i++)
+             geo_ltp_fwd(p, t->lat[i], t->lon[i], &t->e[i], &t->n[i]));
+    TIME("geo_ltp_fwd_batch",
+         geo_ltp_fwd_batch(p, t->lat, t->lon, t->e, t->n, count));
+    TIME("geo_ltp_fwd_e7_batch",
+         geo_ltp_fwd_e7_batch(p, t->lat_e7, t->lon_e7, t->e, t->n, count));
+    TIME("geo_ltp_inv_batch",
+         geo_ltp_inv_batch(p, t->e, t->n, t->lat2, t->lon2, count));
+    TIME("geo_path_length",
+         sink += geo_path_length(t->e, t->n, t->lat2, count));
+    TIME("geo_ltp_enu (exact)",
+         for (size_t i = 0; i < count; i++) {
+             geo_ltp_enu(p, t->lat[i], t->lon[i], 0.0, &t->e[i], &t->n[i], &s);
+         });
+    TIME("geo_haversine_batch",
+         geo_haversine_batch(t->lat, t->lon, t->lat2, t->lon2, t->e, count));
+    TIME("geo_vincenty",
+         for (size_t i = 0; i < count; i++) {
+             geo_vincenty(t->lat[i], t->lon[i], t->lat2[i], t->lon2[i], &s, NULL, NULL);
+             sink += s;
+         });
+    (void)sink;
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = (argc > 1) ? (size_t)atol(argv[1]) : 200000;
+    Track  t;
+    GeoLtp p;
+
+    if (count < 2 || track_alloc(&t, count) < 0) {
+        fprintf(stderr, "invalid point count\n");
+        return 1;
+    }
+    geo_ltp_init(&p, LAT0, LON0, 0.0);
+
+    printf("anchor %.4f, %.4f, %zu points\n\n", LAT0, LON0, count);
+    accuracy(&t, &p, count);
+    cost(&t, &p, count);
+    return 0;
+}
@@ -0,0 +1,699 @@
+#include "geo_fence.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RT_FAN      8           // R-tree 노드당 자식 수
+#define RT_STACK    256         // 탐색 스택 (깊이 × RT_FAN 보다 충분히 큼)
+
+// 격자를 만들 때 모으는 칸 목록 (칸 번호로 정렬하기 전)
+typedef struct {
+    uint32_t      cell;
+    GeoFenceEntry e;
+} TmpEntry;
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static int grow(void **p, size_t *cap, size_t need, size_t elem)
+{
+    if (need <= *cap) return 0;
+
+    size_t n = *cap ? *cap : 16;
+    while (n < need) n *= 2;
+    void *q = realloc(*p, n * elem);
+    if (!q) {
+        errno = ENOMEM;
+        return -1;
+    }
+    *p   = q;
+    *cap = n;
+    return 0;
+}
+
+static inline uint32_t next_vert(const GeoFence *f, uint32_t i)
+{
+    const GeoFencePoly *p = &f->poly[f->vpoly[i]];
+    return (i + 1 == p->first + p->count) ? p->first : i + 1;
+}
+
+static inline GeoFenceSeg edge_seg(const GeoFence *f, uint32_t i)
+{
+    uint32_t    j = next_vert(f, i);
+    GeoFenceSeg s = { f->ve[i], f->vn[i], f->ve[j], f->vn[j] };
+    return s;
+}
+
+/**
+ * @brief p 가 a → b 의 왼쪽 또는 직선 위 (0 을 한쪽으로 몰아 판정을 일관되게)
+ */
+static inline int side(double ae, double an, double be, double bn, double pe, double pn)
+{
+    return (be - ae) * (pn - an) - (bn - an) * (pe - ae) >= 0.0;
+}
+
+/**
+ * @brief 선분 c → p 가 변 s 를 자르는지
+ */
+static inline int crosses(const GeoFenceSeg *s, double ce, double cn, double pe, double pn)
+{
+    return side(s->ae, s->an, s->be, s->bn, ce, cn) != side(s->ae, s->an, s->be, s->bn, pe, pn) &&
+           side(ce, cn, pe, pn, s->ae, s->an) != side(ce, cn, pe, pn, s->be, s->bn);
+}
+
+static inline double seg_dist2(const GeoFenceSeg *s, double e, double n)
+{
+    double de = s->be - s->ae, dn = s->bn - s->an;
+    double len2 = de * de + dn * dn;
+    double t = (len2 > 0.0) ? ((e - s->ae) * de + (n - s->an) * dn) / len2 : 0.0;
+
+    if (t < 0.0) t = 0.0;
+    else if (t > 1.0) t = 1.0;
+    de = s->ae + t * de - e;
+    dn = s->an + t * dn - n;
+    return de * de + dn * dn;
+}
+
+static inline double box_dist2(const GeoFenceNode *b, double e, double n)
+{
+    double de = (e < b->min_e) ? b->min_e - e : (e > b->max_e) ? e - b->max_e : 0.0;
+    double dn = (n < b->min_n) ? b->min_n - n : (n > b->max_n) ? n - b->max_n : 0.0;
+    return de * de + dn * dn;
+}
+
+/**
+ * @brief 선분이 상자와 겹치는지 (두 상자가 겹친다는 전제에서 직선이 상자를 가르는지만 봄)
+ */
+static int seg_box(const GeoFenceSeg *s, double x0, double y0, double x1, double y1)
+{
+    int a = side(s->ae, s->an, s->be, s->bn, x0, y0);
+    int b = side(s->ae, s->an, s->be, s->bn, x1, y0);
+    int c = side(s->ae, s->an, s->be, s->bn, x0, y1);
+    int d = side(s->ae, s->an, s->be, s->bn, x1, y1);
+    return !(a == b && b == c && c == d);
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_node_e(const void *a, const void *b)
+{
+    const GeoFenceNode *x = a, *y = b;
+    double cx = x->min_e + x->max_e, cy = y->min_e + y->max_e;
+    return (cx > cy) - (cx < cy);
+}
+
+static int cmp_node_n(const void *a, const void *b)
+{
+    const GeoFenceNode *x = a, *y = b;
+    double cx = x->min_n + x->max_n, cy = y->min_n + y->max_n;
+    return (cx > cy) - (cx < cy);
+}
+
+static void free_index(GeoFence *f)
+{
+    free(f->cell_start);
+    free(f->entry);
+    free(f->seg);
+    free(f->node);
+    free(f->rt_seg);
+    free(f->rt_poly);
+    f->cell_start = NULL;
+    f->entry      = NULL;
+    f->seg        = NULL;
+    f->node       = NULL;
+    f->rt_seg     = NULL;
+    f->rt_poly    = NULL;
+    f->nx = f->ny = 0;
+    f->nentry = f->nseg = f->nnode = 0;
+}
+
+// ─────────────────────────────────────────────
+//  다각형
+// ─────────────────────────────────────────────
+
+void geo_fence_init(GeoFence *f)
+{
+    memset(f, 0, sizeof(GeoFence));
+}
+
+void geo_fence_set_origin(GeoFence *f, double lat, double lon)
+{
+    if (f->npoly) return;
+    geo_ltp_init(&f->ltp, lat, lon, 0.0);
+    f->have_origin = 1;
+}
+
+int geo_fence_add(GeoFence *f, GeoFenceKind kind, const char *name,
+                  const double *lat, const double *lon, size_t count)
+{
+    if (count < 3 || count > UINT16_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (grow((void **)&f->poly, &f->cap_poly, f->npoly + 1, sizeof(GeoFencePoly)) < 0)
+        return -1;
+
+    // 꼭짓점 배열 3개는 같은 용량으로
+    size_t need = f->nvert + count;
+    if (need > f->cap_vert) {
+        size_t cap = f->cap_vert, c2 = f->cap_vert, c3 = f->cap_vert;
+        if (grow((void **)&f->ve, &cap, need, sizeof(double)) < 0 ||
+            grow((void **)&f->vn, &c2, need, sizeof(double)) < 0 ||
+            grow((void **)&f->vpoly, &c3, need, sizeof(uint32_t)) < 0)
+            return -1;
+        f->cap_vert = cap;
+    }
+    if (!f->have_origin) geo_fence_set_origin(f, lat[0], lon[0]);
+
+    GeoFencePoly *p = &f->poly[f->npoly];
+    memset(p, 0, sizeof(*p));
+    p->kind  = kind;
+    p->first = (uint32_t)f->nvert;
+    p->count = (uint32_t)count;
+    if (name) snprintf(p->name, sizeof(p->name), "%s", name);
+    p->min_e = p->min_n = INFINITY;
+    p->max_e = p->max_n = -INFINITY;
+
+    for (size_t i = 0; i < count; i++) {
+        double e, n;
+        geo_ltp_fwd(&f->ltp, lat[i], lon[i], &e, &n);
+        f->ve[f->nvert]    = e;
+        f->vn[f->nvert]    = n;
+        f->vpoly[f->nvert] = (uint32_t)f->npoly;
+        f->nvert++;
+        if (e < p->min_e) p->min_e = e;
+        if (e > p->max_e) p->max_e = e;
+        if (n < p->min_n) p->min_n = n;
+        if (n > p->max_n) p->max_n = n;
+    }
+    if (kind == GEO_FENCE_ALLOW) f->nallow++;
+    return (int)f->npoly++;
+}
+
+int geo_fence_load(GeoFence *f, const char *path, int *bad_line)
+{
+    FILE        *fp = fopen(path, "r");
+    char         line[256], name[GEO_FENCE_NAME] = "";
+    double      *lat = NULL, *lon = NULL;
+    size_t       n = 0, cap = 0, cap2 = 0;
+    GeoFenceKind kind = GEO_FENCE_ALLOW;
+    int          have = 0, loaded = 0, lineno = 0, err = 0;
+
+    if (bad_line) *bad_line = 0;
+    if (!fp) return -1;
+
+    for (;;) {
+        int eof = !fgets(line, sizeof(line), fp);
+        char *s = line;
+
+        if (!eof) {
+            lineno++;
+            while (isspace((unsigned char)*s)) s++;
+            if (*s == '\0' || *s == '#') continue;
+        }
+        int header = !eof && isalpha((unsigned char)*s);
+
+        // 새 다각형 시작 또는 파일 끝: 모은 다각형 추가
+        if ((eof || header) && have) {
+            if (geo_fence_add(f, kind, name, lat, lon, n) < 0) {
+                err = errno;
+                break;
+            }
+            loaded++;
+            have = 0;
+        }
+        if (eof) break;
+
+        if (header) {
+            char word[16];
+            name[0] = '\0';
+            if (sscanf(s, "%15s %31s", word, name) < 1) { err = EINVAL; break; }
+            if (strcmp(word, "allow") == 0)        kind = GEO_FENCE_ALLOW;
+            else if (strcmp(word, "keepout") == 0) kind = GEO_FENCE_KEEPOUT;
+            else { err = EINVAL; break; }
+            have = 1;
+            n    = 0;
+            continue;
+        }
+
+        double a, b;
+        if (!have || sscanf(s, "%lf ,%lf", &a, &b) != 2) { err = EINVAL; break; }
+        if (grow((void **)&lat, &cap, n + 1, sizeof(double)) < 0 ||
+            grow((void **)&lon, &cap2, n + 1, sizeof(double)) < 0) { err = ENOMEM; break; }
+        lat[n] = a;
+        lon[n] = b;
+        n++;
+    }
+
+    if (err == EINVAL && bad_line) *bad_line = lineno;
+    free(lat);
+    free(lon);
+    fclose(fp);
+    if (err) {
+        errno = err;
+        return -1;
+    }
+    return loaded;
+}
+
+// ─────────────────────────────────────────────
+//  격자
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 다각형 하나를 bbox 칸에 등록 (칸 중심 안 / 밖은 행마다 scanline, 변은 지나는 칸에)
+ */
+static int grid_poly(GeoFence *f, uint32_t pi, TmpEntry **tmp, size_t *ntmp, size_t *cap_tmp,
+                     GeoFenceSeg **tseg, size_t *ntseg, size_t *cap_tseg)
+{
+    const GeoFencePoly *p = &f->poly[pi];
+    int32_t i0 = (int32_t)((p->min_e - f->x0) / f->cell), i1 = (int32_t)((p->max_e - f->x0) / f->cell);
+    int32_t j0 = (int32_t)((p->min_n - f->y0) / f->cell), j1 = (int32_t)((p->max_n - f->y0) / f->cell);
+    size_t  bw = (size_t)(i1 - i0 + 1), bh = (size_t)(j1 - j0 + 1), cells = bw * bh;
+    int     rc = -1;
+
+    uint8_t  *in    = calloc(cells, 1);
+    uint32_t *cnt   = calloc(cells + 1, sizeof(uint32_t));
+    double   *xs    = malloc(p->count * sizeof(double));
+    uint32_t *pairs = NULL;                             // (칸, 변) → 칸별 변
+    uint32_t *pcell = NULL;
+    size_t    npair = 0, cap_pair = 0, cap_pcell = 0;
+    if (!in || !cnt || !xs) goto out;
+
+    // 칸 중심 안 / 밖: 행 중심선과 변의 교차 (반열린 규칙)
+    for (size_t j = 0; j < bh; j++) {
+        double y = f->y0 + (j0 + (double)j + 0.5) * f->cell;
+        size_t nx = 0;
+        for (uint32_t k = p->first; k < p->first + p->count; k++) {
+            GeoFenceSeg s = edge_seg(f, k);
+            if ((s.an > y) != (s.bn > y))
+                xs[nx++] = s.ae + (y - s.an) * (s.be - s.ae) / (s.bn - s.an);
+        }
+        qsort(xs, nx, sizeof(double), cmp_double);
+        size_t c = 0;
+        for (size_t i = 0; i < bw; i++) {
+            double x = f->x0 + (i0 + (double)i + 0.5) * f->cell;
+            while (c < nx && xs[c] < x) c++;
+            in[j * bw + i] = (uint8_t)(c & 1);
+        }
+    }
+
+    // 변이 지나는 칸
+    for (uint32_t k = p->first; k < p->first + p->count; k++) {
+        GeoFenceSeg s = edge_seg(f, k);
+        int32_t a0 = (int32_t)((fmin(s.ae, s.be) - f->x0) / f->cell);
+        int32_t a1 = (int32_t)((fmax(s.ae, s.be) - f->x0) / f->cell);
+        int32_t b0 = (int32_t)((fmin(s.an, s.bn) - f->y0) / f->cell);
+        int32_t b1 = (int32_t)((fmax(s.an, s.bn) - f->y0) / f->cell);
+        for (int32_t j = b0; j <= b1; j++)
+            for (int32_t i = a0; i <= a1; i++) {
+                if (a0 != a1 && b0 != b1) {
+                    double x = f->x0 + i * f->cell, y = f->y0 + j * f->cell;
+                    if (!seg_box(&s, x, y, x + f->cell, y + f->cell)) continue;
+                }
+                if (grow((void **)&pairs, &cap_pair, npair + 1, sizeof(uint32_t)) < 0 ||
+                    grow((void **)&pcell, &cap_pcell, npair + 1, sizeof(uint32_t)) < 0)
+                    goto out;
+                pcell[npair] = (uint32_t)((size_t)(j - j0) * bw + (size_t)(i - i0));
+                pairs[npair] = k;
+                npair++;
+                cnt[pcell[npair - 1] + 1]++;
+            }
+    }
+    for (size_t c = 0; c < cells; c++) cnt[c + 1] += cnt[c];
+
+    // 칸별로 모아 칸 목록 / 변 목록에 추가
+    uint32_t *order = malloc((npair ? npair : 1) * sizeof(uint32_t));
+    if (!order) goto out;
+    for (size_t q = 0; q < npair; q++) order[cnt[pcell[q]]++] = pairs[q];
+    // cnt[c] 는 이제 칸 c 의 끝 = 칸 c + 1 의 시작
+    for (size_t c = 0, start = 0; c < cells; c++) {
+        size_t end = cnt[c], ne = end - start;
+        if (ne || in[c]) {
+            if (grow((void **)tmp, cap_tmp, *ntmp + 1, sizeof(TmpEntry)) < 0 ||
+                grow((void **)tseg, cap_tseg, *ntseg + ne, sizeof(GeoFenceSeg)) < 0) {
+                free(order);
+                goto out;
+            }
+            TmpEntry *t = &(*tmp)[(*ntmp)++];
+            t->cell        = (uint32_t)((size_t)(j0 + c / bw) * (size_t)f->nx + (size_t)i0 + c % bw);
+            t->e.poly      = pi;
+            t->e.edge      = (uint32_t)*ntseg;
+            t->e.nedge     = (uint16_t)ne;
+            t->e.center_in = in[c];
+            t->e.pad       = 0;
+            for (size_t q = start; q < end; q++)
+                (*tseg)[(*ntseg)++] = edge_seg(f, order[q]);
+        }
+        start = end;
+    }
+    free(order);
+    rc = 0;
+
+out:
+    free(in);
+    free(cnt);
+    free(xs);
+    free(pairs);
+    free(pcell);
+    return rc;
+}
+
+static int build_grid(GeoFence *f, double cell_m)
+{
+    double min_e = INFINITY, min_n = INFINITY, max_e = -INFINITY, max_n = -INFINITY;
+
+    for (size_t i = 0; i < f->npoly; i++) {
+        const GeoFencePoly *p = &f->poly[i];
+        min_e = fmin(min_e, p->min_e);
+        min_n = fmin(min_n, p->min_n);
+        max_e = fmax(max_e, p->max_e);
+        max_n = fmax(max_n, p->max_n);
+    }
+    double w = max_e - min_e, h = max_n - min_n;
+
+    // 자동: 칸 수 ≈ 변 수 (칸당 변 몇 개)
+    if (cell_m <= 0.0) cell_m = sqrt(fmax(w * h, 1.0) / (double)f->nvert);
+    if (cell_m < 0.01) cell_m = 0.01;
+    while ((w / cell_m + 2) * (h / cell_m + 2) > GEO_FENCE_MAX_CELLS) cell_m *= 1.25;
+
+    f->cell = cell_m;
+    f->x0   = min_e - 0.5 * cell_m;
+    f->y0   = min_n - 0.5 * cell_m;
+    f->nx   = (int32_t)((max_e - f->x0) / cell_m) + 1;
+    f->ny   = (int32_t)((max_n - f->y0) / cell_m) + 1;
+
+    size_t       cells = (size_t)f->nx * (size_t)f->ny;
+    TmpEntry    *tmp = NULL;
+    GeoFenceSeg *tseg = NULL;
+    size_t       ntmp = 0, cap_tmp = 0, ntseg = 0, cap_tseg = 0;
+    int          rc = -1;
+
+    for (uint32_t i = 0; i < f->npoly; i++)
+        if (grid_poly(f, i, &tmp, &ntmp, &cap_tmp, &tseg, &ntseg, &cap_tseg) < 0) goto out;
+
+    // 칸 번호로 계수 정렬 (안정: 칸 안에서 다각형 번호 순), 변도 칸 순서로 다시 모음
+    f->cell_start = calloc(cells + 1, sizeof(uint32_t));
+    f->entry      = malloc((ntmp ? ntmp : 1) * sizeof(GeoFenceEntry));
+    f->seg        = malloc((ntseg ? ntseg : 1) * sizeof(GeoFenceSeg));
+    if (!f->cell_start || !f->entry || !f->seg) goto out;
+
+    for (size_t k = 0; k < ntmp; k++) f->cell_start[tmp[k].cell + 1]++;
+    for (size_t c = 0; c < cells; c++) f->cell_start[c + 1] += f->cell_start[c];
+
+    uint32_t *pos = malloc((cells ? cells : 1) * sizeof(uint32_t));
+    if (!pos) goto out;
+    memcpy(pos, f->cell_start, cells * sizeof(uint32_t));
+    for (size_t k = 0; k < ntmp; k++) f->entry[pos[tmp[k].cell]++] = tmp[k].e;
+    free(pos);
+
+    size_t s = 0;
+    for (size_t k = 0; k < ntmp; k++) {
+        GeoFenceEntry *e = &f->entry[k];
+        memcpy(&f->seg[s], &tseg[e->edge], e->nedge * sizeof(GeoFenceSeg));
+        e->edge = (uint32_t)s;
+        s += e->nedge;
+    }
+    f->nentry = ntmp;
+    f->nseg   = s;
+    rc = 0;
+
+out:
+    free(tmp);
+    free(tseg);
+    return rc;
+}
+
+// ─────────────────────────────────────────────
+//  R-tree (Sort-Tile-Recursive 일괄 적재)
+// ─────────────────────────────────────────────
+
+/**
+ * @brief STR 순서로 정렬: 중심 동쪽 좌표로 정렬해 √(노드 수) 개 세로 띠로 나누고 띠마다 북쪽으로
+ */
+static void str_sort(GeoFenceNode *v, size_t n)
+{
+    size_t leaves = (n + RT_FAN - 1) / RT_FAN;
+    size_t slices = (size_t)ceil(sqrt((double)leaves));
+    size_t slice  = slices * RT_FAN;
+
+    qsort(v, n, sizeof(GeoFenceNode), cmp_node_e);
+    for (size_t i = 0; i < n; i += slice)
+        qsort(v + i, (n - i < slice) ? n - i : slice, sizeof(GeoFenceNode), cmp_node_n);
+}
+
+/**
+ * @brief 연속한 자식 RT_FAN 개씩 묶어 부모 노드 (first = 자식 시작 + base)
+ */
+static size_t pack_level(const GeoFenceNode *child, size_t n, uint32_t base, int leaf,
+                         GeoFenceNode *out)
+{
+    size_t m = 0;
+
+    for (size_t i = 0; i < n; i += RT_FAN, m++) {
+        size_t        k = (n - i < RT_FAN) ? n - i : RT_FAN;
+        GeoFenceNode *p = &out[m];
+        p->min_e = p->min_n = INFINITY;
+        p->max_e = p->max_n = -INFINITY;
+        for (size_t c = i; c < i + k; c++) {
+            p->min_e = fmin(p->min_e, child[c].min_e);
+            p->min_n = fmin(p->min_n, child[c].min_n);
+            p->max_e = fmax(p->max_e, child[c].max_e);
+            p->max_n = fmax(p->max_n, child[c].max_n);
+        }
+        p->first = base + (uint32_t)i;
+        p->count = (uint16_t)k;
+        p->leaf  = (uint8_t)leaf;
+        p->pad   = 0;
+    }
+    return m;
+}
+
+static int build_rtree(GeoFence *f)
+{
+    size_t        n = f->nvert;
+    GeoFenceNode *level = malloc(n * sizeof(GeoFenceNode));
+    GeoFenceNode *up    = malloc(((n + RT_FAN - 1) / RT_FAN) * sizeof(GeoFenceNode));
+    size_t        cap_node = 0;
+    int           rc = -1;
+
+    f->rt_seg  = malloc(n * sizeof(GeoFenceSeg));
+    f->rt_poly = malloc(n * sizeof(uint32_t));
+    if (!level || !up || !f->rt_seg || !f->rt_poly) goto out;
+
+    // 변 하나 = 항목 하나 (first = 꼭짓점 번호)
+    for (uint32_t i = 0; i < n; i++) {
+        GeoFenceSeg s = edge_seg(f, i);
+        level[i].min_e = fmin(s.ae, s.be);
+        level[i].max_e = fmax(s.ae, s.be);
+        level[i].min_n = fmin(s.an, s.bn);
+        level[i].max_n = fmax(s.an, s.bn);
+        level[i].first = i;
+        level[i].count = 1;
+        level[i].leaf  = 0;
+    }
+    str_sort(level, n);
+    for (size_t i = 0; i < n; i++) {
+        f->rt_seg[i]  = edge_seg(f, level[i].first);
+        f->rt_poly[i] = f->vpoly[level[i].first];
+    }
+    size_t m = pack_level(level, n, 0, 1, up);
+
+    // 위 단계: 노드를 STR 순서로 정렬해 저장하고 그 위 부모를 묶음
+    while (m > 1) {
+        GeoFenceNode *t = level;
+        level = up;
+        up    = t;
+        str_sort(level, m);
+        if (grow((void **)&f->node, &cap_node, f->nnode + m, sizeof(GeoFenceNode)) < 0) goto out;
+        memcpy(&f->node[f->nnode], level, m * sizeof(GeoFenceNode));
+        uint32_t base = (uint32_t)f->nnode;
+        f->nnode += m;
+        m = pack_level(level, m, base, 0, up);
+    }
+    if (grow((void **)&f->node, &cap_node, f->nnode + 1, sizeof(GeoFenceNode)) < 0) goto out;
+    f->node[f->nnode] = up[0];
+    f->root = (uint32_t)f->nnode++;
+    rc = 0;
+
+out:
+    free(level);
+    free(up);
+    return rc;
+}
+
+int geo_fence_build(GeoFence *f, double cell_m)
+{
+    free_index(f);
+    if (f->npoly == 0) return 0;
+    if (build_grid(f, cell_m) < 0 || build_rtree(f) < 0) {
+        int err = errno;
+        free_index(f);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+// ─────────────────────────────────────────────
+//  질의
+// ─────────────────────────────────────────────
+
+static void nearest(const GeoFence *f, double e, double n, GeoFenceResult *r)
+{
+    struct { uint32_t node; double d2; } stack[RT_STACK];
+    int    sp = 0;
+    double best = INFINITY;
+
+    stack[sp].node = f->root;
+    stack[sp].d2   = 0.0;
+    sp++;
+    while (sp > 0) {
+        sp--;
+        if (stack[sp].d2 >= best) continue;
+        const GeoFenceNode *nd = &f->node[stack[sp].node];
+
+        if (nd->leaf) {
+            for (uint32_t i = nd->first; i < nd->first + nd->count; i++) {
+                double d2 = seg_dist2(&f->rt_seg[i], e, n);
+                if (d2 < best) {
+                    best       = d2;
+                    r->nearest = (int32_t)f->rt_poly[i];
+                }
+            }
+            continue;
+        }
+
+        // 자식을 먼 것부터 쌓아 가까운 것이 먼저 나오게
+        uint32_t id[RT_FAN];
+        double   d[RT_FAN];
+        int      k = 0;
+        for (uint32_t c = nd->first; c < nd->first + nd->count; c++) {
+            double d2 = box_dist2(&f->node[c], e, n);
+            if (d2 >= best) continue;
+            int j = k++;
+            while (j > 0 && d[j - 1] < d2) {
+                d[j]  = d[j - 1];
+                id[j] = id[j - 1];
+                j--;
+            }
+            d[j]  = d2;
+            id[j] = c;
+        }
+        for (int j = 0; j < k && sp < RT_STACK; j++) {
+            stack[sp].node = id[j];
+            stack[sp].d2   = d[j];
+            sp++;
+        }
+    }
+    r->dist = sqrt(best);
+}
+
+void geo_fence_query_enu(const GeoFence *f, double e, double n, GeoFenceResult *r)
+{
+    r->e          = e;
+    r->n          = n;
+    r->nhit       = 0;
+    r->in_allow   = 0;
+    r->in_keepout = 0;
+    r->dist       = INFINITY;
+    r->nearest    = -1;
+
+    if (f->nx > 0) {
+        double gx = (e - f->x0) / f->cell, gy = (n - f->y0) / f->cell;
+
+        if (gx >= 0.0 && gy >= 0.0 && gx < f->nx && gy < f->ny) {
+            int32_t i = (int32_t)gx, j = (int32_t)gy;
+            size_t  c = (size_t)j * (size_t)f->nx + (size_t)i;
+            double  ce = f->x0 + (i + 0.5) * f->cell, cn = f->y0 + (j + 0.5) * f->cell;
+
+            for (uint32_t k = f->cell_start[c]; k < f->cell_start[c + 1]; k++) {
+                const GeoFenceEntry *en = &f->entry[k];
+                const GeoFenceSeg   *s  = &f->seg[en->edge];
+                int                  in = en->center_in;
+
+                for (uint32_t q = 0; q < en->nedge; q++)
+                    in ^= crosses(&s[q], ce, cn, e, n);
+                if (!in) continue;
+
+                if (f->poly[en->poly].kind == GEO_FENCE_KEEPOUT) r->in_keepout = 1;
+                else                                              r->in_allow   = 1;
+                if (r->nhit < GEO_FENCE_MAX_HITS) r->hit[r->nhit++] = en->poly;
+            }
+        }
+        nearest(f, e, n, r);
+    }
+    r->ok = (f->nallow == 0 || r->in_allow) && !r->in_keepout;
+}
+
+void geo_fence_query(const GeoFence *f, double lat, double lon, GeoFenceResult *r)
+{
+    double e = 0.0, n = 0.0;
+
+    if (f->have_origin) geo_ltp_fwd(&f->ltp, lat, lon, &e, &n);
+    geo_fence_query_enu(f, e, n, r);
+}
+
+size_t geo_fence_index_memory(const GeoFence *f)
+{
+    size_t cells = (size_t)f->nx * (size_t)f->ny;
+    return (f->nx ? (cells + 1) * sizeof(uint32_t) : 0) + f->nentry * sizeof(GeoFenceEntry) +
+           f->nseg * sizeof(GeoFenceSeg) + f->nnode * sizeof(GeoFenceNode) +
+           (f->rt_seg ? f->nvert * (sizeof(GeoFenceSeg) + sizeof(uint32_t)) : 0);
+}
+
+void geo_fence_free(GeoFence *f)
+{
+    free_index(f);
+    free(f->poly);
+    free(f->ve);
+    free(f->vn);
+    free(f->vpoly);
+    memset(f, 0, sizeof(GeoFence));
+}
+
+// ─────────────────────────────────────────────
+//  진입 / 이탈 추적
+// ─────────────────────────────────────────────
+
+void geo_fence_track_init(GeoFenceTrack *t, GeoFenceEventCb cb, void *user)
+{
+    memset(t, 0, sizeof(GeoFenceTrack));
+    t->cb   = cb;
+    t->user = user;
+}
+
+int geo_fence_track_update(GeoFenceTrack *t, const GeoFenceResult *r)
+{
+    size_t a, b;
+    int    events = 0;
+
+    // 두 목록 모두 오름차순: 이전에만 있으면 이탈
+    for (a = 0, b = 0; a < t->nin; a++) {
+        while (b < r->nhit && r->hit[b] < t->in[a]) b++;
+        if (b < r->nhit && r->hit[b] == t->in[a]) continue;
+        t->exits++;
+        events++;
+        if (t->cb) t->cb(GEO_FENCE_EXIT, t->in[a], r, t->user);
+    }
+    // 지금만 있으면 진입
+    for (a = 0, b = 0; b < r->nhit; b++) {
+        while (a < t->nin && t->in[a] < r->hit[b]) a++;
+        if (a < t->nin && t->in[a] == r->hit[b]) continue;
+        t->enters++;
+        events++;
+        if (t->cb) t->cb(GEO_FENCE_ENTER, r->hit[b], r, t->user);
+    }
+    memcpy(t->in, r->hit, r->nhit * sizeof(uint32_t));
+    t->nin = r->nhit;
+    return events;
+}
@@ -0,0 +1,183 @@
+#ifndef GEO_FENCE_H
+#define GEO_FENCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "geo.h"
+
+// ─────────────────────────────────────────────
+//  지오펜스 (다각형 수천 개, 균일 격자 + R-tree 색인)
+//
+//  다각형은 추가할 때 한 번 접평면 (첫 꼭짓점 기준 GeoLtp) 으로 투영하고,
+//  geo_fence_build 가 색인 두 개를 만든다.
+//  - 포함: 균일 격자. 칸마다 칸과 겹치는 다각형 목록을
+//      (다각형, 칸 중심이 안인지, 칸을 지나는 변 목록)
+//    으로 저장하므로 점 포함 판정은 그 칸의 변만 본다:
+//      안 = 중심 안 XOR (중심 → 점 선분이 자르는 변 수가 홀수)
+//  - 가장 가까운 경계: 모든 변의 packed R-tree (STR, 노드당 8개). 가까운 자식부터
+//    내려가며 찾은 거리보다 먼 상자는 건너뛴다 (넓은 구역 한가운데서도 O(log n))
+//
+//  - 다각형은 단순 다각형 (자기 교차 없음), 꼭짓점 순서 무관, 마지막 → 처음 변 자동
+//  - 경계 위의 점은 안 / 밖 어느 쪽으로든 판정될 수 있다 (거리 0 으로 구분)
+//  - 접평면 근사라 기준점에서 10 km 이내 cm 수준 (geo.h)
+// ─────────────────────────────────────────────
+
+#define GEO_FENCE_NAME      32
+#define GEO_FENCE_MAX_HITS  64          // 한 점을 포함하는 다각형 최대 보고 수
+#define GEO_FENCE_MAX_CELLS (1u << 22)  // 격자 칸 수 상한 (자동 칸 크기)
+
+typedef enum {
+    GEO_FENCE_ALLOW = 0,                // 허용 구역 (하나 이상의 안에 있어야 함)
+    GEO_FENCE_KEEPOUT,                  // 금지 구역 (어느 것의 안에도 없어야 함)
+} GeoFenceKind;
+
+typedef struct {
+    GeoFenceKind kind;
+    char         name[GEO_FENCE_NAME];
+    uint32_t     first, count;          // 꼭짓점 범위
+    double       min_e, min_n, max_e, max_n;
+} GeoFencePoly;
+
+// 변 (접평면 m)
+typedef struct {
+    double ae, an, be, bn;
+} GeoFenceSeg;
+
+// 격자 칸 안의 다각형 하나
+typedef struct {
+    uint32_t poly;
+    uint32_t edge;                      // 변 목록 시작 (GeoFence.seg)
+    uint16_t nedge;
+    uint8_t  center_in;                 // 칸 중심이 다각형 안
+    uint8_t  pad;
+} GeoFenceEntry;
+
+// R-tree 노드 (leaf 이면 자식은 GeoFence.rt_seg, 아니면 GeoFence.node)
+typedef struct {
+    double   min_e, min_n, max_e, max_n;
+    uint32_t first;
+    uint16_t count;
+    uint8_t  leaf;
+    uint8_t  pad;
+} GeoFenceNode;
+
+typedef struct {
+    uint32_t hit[GEO_FENCE_MAX_HITS];   // 점을 포함하는 다각형 (번호 오름차순)
+    size_t   nhit;                      // GEO_FENCE_MAX_HITS 보다 많으면 잘림
+    int      in_allow, in_keepout;
+    int      ok;                        // 허용 구역 안 (허용 구역이 없으면 생략) + 금지 구역 밖
+    double   dist;                      // 가장 가까운 경계까지 (m, 다각형 없으면 INFINITY)
+    int32_t  nearest;                   // 그 경계의 다각형 (-1: 없음)
+    double   e, n;                      // 질의 점 (접평면)
+} GeoFenceResult;
+
+// ─────────────────────────────────────────────
+//  펜스 집합 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GeoLtp         ltp;
+    int            have_origin;
+    GeoFencePoly  *poly;
+    size_t         npoly, cap_poly;
+    double        *ve, *vn;             // 꼭짓점 (접평면 m), 변 i 는 i → 다음 꼭짓점
+    uint32_t      *vpoly;               // 꼭짓점 (변) 의 다각형
+    size_t         nvert, cap_vert;
+    size_t         nallow;
+
+    // 격자
+    double         x0, y0, cell;
+    int32_t        nx, ny;
+    uint32_t      *cell_start;          // nx·ny + 1
+    GeoFenceEntry *entry;
+    GeoFenceSeg   *seg;                 // 칸 / 다각형 순서로 모은 변 (칸마다 복사)
+    size_t         nentry, nseg;
+
+    // R-tree
+    GeoFenceNode  *node;
+    size_t         nnode;
+    uint32_t       root;
+    GeoFenceSeg   *rt_seg;              // 변 (STR 순서)
+    uint32_t      *rt_poly;
+} GeoFence;
+
+/**
+ * @brief 빈 펜스 집합
+ */
+void geo_fence_init(GeoFence *f);
+
+/**
+ * @brief 접평면 기준점 지정 (다각형을 추가하기 전에만, 없으면 첫 꼭짓점)
+ */
+void geo_fence_set_origin(GeoFence *f, double lat, double lon);
+
+/**
+ * @brief 다각형 추가 (꼭짓점 3개 이상, 위도/경도 도)
+ * @return 다각형 번호, -1: 실패 (errno: EINVAL 꼭짓점 부족 / 변 65535 초과, ENOMEM)
+ */
+int geo_fence_add(GeoFence *f, GeoFenceKind kind, const char *name,
+                  const double *lat, const double *lon, size_t count);
+
+/**
+ * @brief 텍스트 파일에서 다각형 읽기
+ *
+ *   # 주석
+ *   allow yard            ← 다각형 시작 (allow / keepout + 이름)
+ *   37.5665,126.9780      ← 꼭짓점 (위도,경도), 한 줄에 하나
+ *   ...
+ *
+ * @return 읽은 다각형 수, -1: 실패 (errno 설정, 형식 오류는 EINVAL 과 *bad_line)
+ */
+int geo_fence_load(GeoFence *f, const char *path, int *bad_line);
+
+/**
+ * @brief 색인 만들기 (다각형을 추가한 뒤, 다시 부르면 새로 만듦)
+ * @param cell_m 격자 칸 크기 (m), 0 이하이면 변 수에 맞춰 자동
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int geo_fence_build(GeoFence *f, double cell_m);
+
+/**
+ * @brief 점 질의 (위도/경도 도)
+ */
+void geo_fence_query(const GeoFence *f, double lat, double lon, GeoFenceResult *r);
+
+/**
+ * @brief 점 질의 (접평면 m)
+ */
+void geo_fence_query_enu(const GeoFence *f, double e, double n, GeoFenceResult *r);
+
+/**
+ * @brief 색인 메모리 바이트 (격자 + 칸 목록 + 변 목록 + R-tree)
+ */
+size_t geo_fence_index_memory(const GeoFence *f);
+
+void geo_fence_free(GeoFence *f);
+
+// ─────────────────────────────────────────────
+//  진입 / 이탈 추적
+// ─────────────────────────────────────────────
+typedef enum {
+    GEO_FENCE_ENTER = 0,
+    GEO_FENCE_EXIT,
+} GeoFenceEvent;
+
+typedef void (*GeoFenceEventCb)(GeoFenceEvent ev, uint32_t poly, const GeoFenceResult *r,
+                                void *user);
+
+typedef struct {
+    uint32_t        in[GEO_FENCE_MAX_HITS];     // 직전 질의에서 안에 있던 다각형
+    size_t          nin;
+    uint64_t        enters, exits;
+    GeoFenceEventCb cb;
+    void           *user;
+} GeoFenceTrack;
+
+void geo_fence_track_init(GeoFenceTrack *t, GeoFenceEventCb cb, void *user);
+
+/**
+ * @brief 질의 결과를 직전과 비교해 이탈 → 진입 순으로 콜백
+ * @return 발생한 이벤트 수
+ */
+int geo_fence_track_update(GeoFenceTrack *t, const GeoFenceResult *r);
+
+#endif /* GEO_FENCE_H */
@@ -0,0 +1,100 @@
+#include "gps_aim.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief 기준점이 생기면 목표를 기준 ENU 로 (정확한 변환 1회)
+ */
+static void target_enu(GpsAim *a)
+{
+    if (!a->have_ltp || !a->have_target) return;
+    geo_ltp_enu(&a->ltp, a->t_lat, a->t_lon, a->t_alt, &a->te, &a->tn, &a->tu);
+}
+
+void gps_aim_init(GpsAim *a)
+{
+    memset(a, 0, sizeof(GpsAim));
+    a->max_extrap_s = GPS_AIM_MAX_EXTRAP_S;
+    gps_aim_set_attitude(a, 0.0, 0.0, 0.0);
+}
+
+void gps_aim_set_target(GpsAim *a, double lat, double lon, double alt)
+{
+    a->t_lat       = lat;
+    a->t_lon       = lon;
+    a->t_alt       = alt;
+    a->have_target = 1;
+    target_enu(a);
+}
+
+void gps_aim_set_position(GpsAim *a, double lat, double lon, double alt,
+                          double ve, double vn, double vu, int64_t t_ns)
+{
+    if (!a->have_ltp) {
+        geo_ltp_init(&a->ltp, lat, lon, alt);
+        a->h0       = alt;
+        a->have_ltp = 1;
+        target_enu(a);
+    }
+    geo_ltp_fwd(&a->ltp, lat, lon, &a->e, &a->n);
+    a->u        = (alt - a->h0) - (a->e * a->e + a->n * a->n) / (2.0 * GEO_R_MEAN);
+    a->ve       = ve;
+    a->vn       = vn;
+    a->vu       = vu;
+    a->fix_ns   = t_ns;
+    a->have_fix = 1;
+}
+
+void gps_aim_set_max_extrap(GpsAim *a, double max_s)
+{
+    a->max_extrap_s = (max_s > 0.0) ? max_s : 0.0;
+}
+
+void gps_aim_set_attitude(GpsAim *a, double roll, double pitch, double yaw)
+{
+    double sr = sin(roll * GEO_DEG2RAD), cr = cos(roll * GEO_DEG2RAD);
+    double sp = sin(pitch * GEO_DEG2RAD), cp = cos(pitch * GEO_DEG2RAD);
+    double sy = sin(yaw * GEO_DEG2RAD), cy = cos(yaw * GEO_DEG2RAD);
+
+    // C = Rz(yaw) · Ry(pitch) · Rx(roll)
+    a->C[0][0] = cp * cy;
+    a->C[0][1] = sr * sp * cy - cr * sy;
+    a->C[0][2] = cr * sp * cy + sr * sy;
+    a->C[1][0] = cp * sy;
+    a->C[1][1] = sr * sp * sy + cr * cy;
+    a->C[1][2] = cr * sp * sy - sr * cy;
+    a->C[2][0] = -sp;
+    a->C[2][1] = sr * cp;
+    a->C[2][2] = cr * cp;
+}
+
+int gps_aim_update(GpsAim *a, int64_t now_ns, GpsAimOut *out)
+{
+    if (!a->have_fix || !a->have_target) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    double dt = (now_ns - a->fix_ns) / 1e9;
+    if (dt < 0.0) dt = 0.0;
+    else if (dt > a->max_extrap_s) dt = a->max_extrap_s;
+
+    // 시선 (NED)
+    double ln = a->tn - (a->n + a->vn * dt);
+    double le = a->te - (a->e + a->ve * dt);
+    double ld = -(a->tu - (a->u + a->vu * dt));
+
+    // 차체 = Cᵀ · NED
+    double x = a->C[0][0] * ln + a->C[1][0] * le + a->C[2][0] * ld;
+    double y = a->C[0][1] * ln + a->C[1][1] * le + a->C[2][1] * ld;
+    double z = a->C[0][2] * ln + a->C[1][2] * le + a->C[2][2] * ld;
+    double h = sqrt(x * x + y * y);
+
+    out->az       = atan2(y, x) * GEO_RAD2DEG;
+    out->el       = atan2(-z, h) * GEO_RAD2DEG;
+    out->range    = sqrt(h * h + z * z);
+    out->extrap_s = dt;
+    return 0;
+}
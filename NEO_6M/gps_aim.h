@@ -0,0 +1,86 @@
+#ifndef GPS_AIM_H
+#define GPS_AIM_H
+
+#include <stdint.h>
+#include "geo.h"
+
+// ─────────────────────────────────────────────
+//  지리 목표 지향 (차량 위치 + 자세 → 차체 기준 시선 방향)
+//
+//  목표 (위도/경도/고도) 는 첫 차량 위치를 기준점으로 한 접평면에 정확한 ENU
+//  (geo_ltp_enu, 지구 곡률 포함) 로 한 번 변환한다. 차량 위치는 GPS epoch 마다
+//  위치 + 속도로 받아, 갱신 때마다 경과 시간만큼 외삽한다.
+//  자세 (roll / pitch / yaw) 를 받을 때 차체 → NED 회전 행렬을 만들어 두므로
+//  갱신 1회는 외삽 + 행렬·벡터 곱 + atan2 2회 + sqrt 1회다.
+//
+//  - 차체 축: x 앞, y 오른쪽, z 아래. yaw 는 북 기준 시계 방향, pitch 는 기수 들림 +,
+//    roll 은 오른쪽 내림 +
+//  - 차량 위치는 빠른 평면 근사 (geo_ltp_fwd) + 곡률 낙차 d²/2R. 기준점에서 d 만큼
+//    떨어지면 연직 방향이 d / R 만큼 기울어진다 (2 km 에서 0.02°)
+//  - 카메라와 GPS 안테나 사이 거리 (수십 cm) 는 무시 (목표 거리 50 m 에서 0.3° 미만)
+// ─────────────────────────────────────────────
+
+#define GPS_AIM_MAX_EXTRAP_S    2.0     // 이보다 오래된 위치는 외삽하지 않고 고정
+
+typedef struct {
+    double az;                          // 차체 기준 방위 (도, 앞 0, 오른쪽 +, [-180, 180))
+    double el;                          // 차체 기준 앙각 (도, 위 +)
+    double range;                       // 목표까지 직선 거리 (m)
+    double extrap_s;                    // 위치 외삽 시간 (최대 GPS_AIM_MAX_EXTRAP_S)
+} GpsAimOut;
+
+// ─────────────────────────────────────────────
+//  지향 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GeoLtp  ltp;                        // 첫 차량 위치 기준
+    double  h0;
+    int     have_ltp;
+
+    double  t_lat, t_lon, t_alt;        // 목표
+    double  te, tn, tu;                 // 목표 (기준 ENU)
+    int     have_target;
+
+    double  e, n, u;                    // 마지막 차량 위치 (기준 ENU)
+    double  ve, vn, vu;                 // 속도 (m/s)
+    int64_t fix_ns;                     // 위치 시각
+    int     have_fix;
+    double  max_extrap_s;
+
+    double  C[3][3];                    // 차체 → NED
+} GpsAim;
+
+/**
+ * @brief 초기화 (자세 0, 목표 / 위치 없음)
+ */
+void gps_aim_init(GpsAim *a);
+
+/**
+ * @brief 목표 위치 (도, 타원체고 m)
+ */
+void gps_aim_set_target(GpsAim *a, double lat, double lon, double alt);
+
+/**
+ * @brief 차량 위치 / 속도 (GPS epoch 또는 필터 출력)
+ * @param t_ns 위치가 유효한 시각 (CLOCK_MONOTONIC, fix 의 rx_ns 등)
+ */
+void gps_aim_set_position(GpsAim *a, double lat, double lon, double alt,
+                          double ve, double vn, double vu, int64_t t_ns);
+
+/**
+ * @brief 외삽 상한 (초, 0 이면 마지막 위치 그대로), 기본 GPS_AIM_MAX_EXTRAP_S
+ */
+void gps_aim_set_max_extrap(GpsAim *a, double max_s);
+
+/**
+ * @brief 차량 자세 (도), 회전 행렬 갱신 (삼각함수 6회)
+ */
+void gps_aim_set_attitude(GpsAim *a, double roll, double pitch, double yaw);
+
+/**
+ * @brief now_ns 시점의 시선 방향
+ * @return 0: 성공, -1: 목표 또는 위치 없음 (EAGAIN)
+ */
+int gps_aim_update(GpsAim *a, int64_t now_ns, GpsAimOut *out);
+
+#endif /* GPS_AIM_H */
@@ -0,0 +1,154 @@
+// 차분 보정 기준국
+//
+// 움직이지 않는 NEO-6M 으로 위치를 측량 (survey-in) 한 뒤 epoch 마다 (기준 - 측정) 오차를
+// UDP 로 보낸다. 이동국 (gps_rover) 이 같은 epoch 오차를 빼서 공통 오차를 없앤다.
+//
+// 실행: ./gps_base [-b baud] [-d host] [-p port] [-s seconds] [-a acc_m] [-F lat,lon] [-v] [dev]
+//         -d  대상 주소 (기본 127.0.0.1, 같은 망 여러 이동국은 브로드캐스트 주소)
+//         -s  survey-in 최소 시간 (s, 기본 1800), -a 목표 정확도 (m)
+//         -F  측량해 둔 기준점 위치 (survey-in 생략)
+//         -v  보정마다 한 줄 출력
+//
+// 기록으로 시험: ./gps_replay -p base.rec 가 알려 주는 pty 를 dev 로
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_dgps.h"
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+
+#define PROGRESS_EVERY  30      // survey-in 진행 상황 출력 간격 (s)
+
+typedef struct {
+    GpsDgpsBase base;
+    int         verbose;
+    int         announced;      // 측량 완료 출력함
+} Base;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Base      *b = user;
+    GpsDgpsMsg m;
+    double     prev;
+    int        rc;
+
+    gps_dgps_base_survey(&b->base, &prev, NULL);
+    rc = gps_dgps_base_fix(&b->base, f, &m);
+
+    if (rc < 0) {
+        perror("sendto");
+        return;
+    }
+    if (rc == 0) {
+        double secs, acc;
+        gps_dgps_base_survey(&b->base, &secs, &acc);
+        if (secs > prev && (long)secs % PROGRESS_EVERY == 0)
+            printf("survey-in: %.0f / %d s, accuracy %.2f m (target %.2f m)\n",
+                   secs, b->base.survey_min_s, acc, b->base.survey_acc);
+        return;
+    }
+    if (!b->announced) {
+        printf("reference %.7f, %.7f (%s, accuracy %.2f m), sending corrections\n",
+               nmea_e7_to_deg(m.ref_lat), nmea_e7_to_deg(m.ref_lon),
+               (m.flags & GPS_DGPS_F_FIXED) ? "given" : "surveyed", b->base.ref_acc);
+        b->announced = 1;
+    }
+    if (b->verbose)
+        printf("#%u %02d:%02d:%02d.%03d  dE %+.2f dN %+.2f m  sats %d  hdop %.2f\n",
+               m.seq, f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60,
+               f->time_ms % 1000, m.de_mm / 1000.0, m.dn_mm / 1000.0, m.num_sats, m.hdop / 100.0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = NULL;
+    int         baud = GPS_SERIAL_BAUD, port = 0, opt;
+    int         survey = 0;
+    double      acc = 0.0, ref_lat = 0.0, ref_lon = 0.0;
+    int         have_ref = 0;
+    Base        b = {0};
+
+    while ((opt = getopt(argc, argv, "b:d:p:s:a:F:v")) != -1) {
+        switch (opt) {
+            case 'b': baud      = atoi(optarg); break;
+            case 'd': host      = optarg;       break;
+            case 'p': port      = atoi(optarg); break;
+            case 's': survey    = atoi(optarg); break;
+            case 'a': acc       = atof(optarg); break;
+            case 'v': b.verbose = 1;            break;
+            case 'F':
+                if (sscanf(optarg, "%lf,%lf", &ref_lat, &ref_lon) == 2) { have_ref = 1; break; }
+                /* fall through */
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-d host] [-p port] [-s seconds] [-a acc_m]\n"
+                                "       [-F lat,lon] [-v] [dev]\n", argv[0]);
+                return 1;
+        }
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    if (survey < 0 || gps_dgps_base_init(&b.base, host, port, survey, acc) < 0) {
+        perror("gps_dgps_base_init");
+        return 1;
+    }
+    if (have_ref) gps_dgps_base_set_ref(&b.base, ref_lat, ref_lon);
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        gps_dgps_base_free(&b.base);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &b);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    printf("%s -> udp %s:%d (%s)\n", dev, host ? host : "127.0.0.1",
+           port ? port : GPS_DGPS_PORT, have_ref ? "reference given" : "survey-in");
+    fflush(stdout);
+
+    while (!stop) {
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (n < 0) {
+            perror("GPS read");
+            break;
+        }
+        if (n > 0)
+            gps_stream_feed(&stream, buf, n, rx_ns);
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
+        fflush(stdout);
+    }
+
+    gps_epoch_flush(&epoch);
+    printf("epochs %llu, sent %llu corrections (errors %llu), survey restarts %llu\n",
+           (unsigned long long)b.base.stats.epochs, (unsigned long long)b.base.stats.sent,
+           (unsigned long long)b.base.stats.send_errors,
+           (unsigned long long)b.base.stats.survey_resets);
+    gps_serial_close(&ser);
+    gps_dgps_base_free(&b.base);
+    return 0;
+}
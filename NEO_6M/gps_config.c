@@ -0,0 +1,225 @@
+// NEO-6M UBX 설정 도구
+//
+// CFG-MSG 로 필요 없는 NMEA 문장을 끄고, CFG-PRT 로 보레이트를 올린 뒤
+// 포트를 다시 맞추고, CFG-RATE 로 측위 주기를 올린다. 필요하면 CFG-CFG 로
+// BBR/flash 에 저장하고, 마지막에 초당 epoch 수를 재서 결과를 확인한다.
+//
+// 빌드: make gps_config
+// 실행: ./gps_config [-b baud] [-B baud] [-r Hz] [-n GGA,RMC,...] [-u]
+//                    [-s bbr|flash|bbr,flash] [-t sec] [device]
+//         -b  현재 보레이트 (생략하면 자동 탐지)
+//         -B  새 보레이트 (예: 115200)
+//         -r  측위 주기 Hz (NEO-6M 최대 5)
+//         -n  켤 NMEA 문장, 나머지는 끔 ("none" 이면 모두 끔)
+//         -u  UBX NAV-POSLLH/SOL/VELNED 출력
+//         -s  설정 저장
+//         -t  검증 시간 (초, 기본 3, 0 이면 생략)
+// 예:   ./gps_config -B 115200 -r 5 -n GGA,RMC -s bbr
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "nmea_msg.h"
+#include "ubx_cfg.h"
+
+typedef struct {
+    long fixes;
+} Count;
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    (void)f;
+    ((Count *)user)->fixes++;
+}
+
+/**
+ * @brief "GGA,RMC" → NmeaType 비트 마스크 (-1: 모르는 문장)
+ */
+static int parse_nmea_list(const char *list)
+{
+    char buf[64];
+    int  mask = 0;
+
+    if (strcasecmp(list, "none") == 0) return 0;
+    snprintf(buf, sizeof(buf), "%s", list);
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        int t;
+        for (t = 0; t < NMEA_TYPE_COUNT; t++)
+            if (strcasecmp(tok, nmea_type_name((NmeaType)t)) == 0) break;
+        if (t == NMEA_TYPE_COUNT) return -1;
+        mask |= 1 << t;
+    }
+    return mask;
+}
+
+static int parse_devices(const char *list)
+{
+    int dev = 0;
+    if (strstr(list, "bbr"))   dev |= UBX_DEV_BBR;
+    if (strstr(list, "flash")) dev |= UBX_DEV_FLASH;
+    return dev;
+}
+
+static int check(const char *what, UbxCfgError err)
+{
+    printf("%-28s %s\n", what, ubx_cfg_strerror(err));
+    return err == UBX_CFG_OK ? 0 : -1;
+}
+
+/**
+ * @brief sec 초 동안 초당 epoch 수 측정
+ * @return 평균 epoch/s
+ */
+static double measure(GpsSerial *ser, int baud, int sec)
+{
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    Count        cnt = {0};
+    char         buf[512];
+    long         total = 0;
+
+    gps_epoch_init(&ep, on_fix, &cnt);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+
+    // 설정 직후 남은 출력 버림, 첫 epoch 경계부터 셈
+    tcflush(ser->fd, TCIFLUSH);
+    uint64_t bytes0 = ser->bytes;
+    int64_t  t0     = gps_now_ns();
+    int64_t  tick   = t0 + 1000000000LL;
+
+    for (int s = 0; s < sec; ) {
+        int64_t rx_ns;
+        int     n = gps_serial_read(ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+
+        if (n < 0) { perror("GPS read"); break; }
+        if (n > 0) gps_stream_feed(&stream, buf, (size_t)n, rx_ns);
+        else       gps_epoch_poll(&ep, ser->last_rx_ns, gps_now_ns());
+
+        if (gps_now_ns() >= tick) {
+            uint64_t b = ser->bytes - bytes0;
+            // 첫 1초는 부분 epoch 가 섞이므로 버림
+            if (s > 0) total += cnt.fixes;
+            printf("  %2d s: %3ld epoch/s  %6llu B/s  (UART %3.0f%%)\n", s + 1, cnt.fixes,
+                   (unsigned long long)b, b * 10 * 100.0 / baud);
+            cnt.fixes = 0;
+            bytes0    = ser->bytes;
+            tick     += 1000000000LL;
+            s++;
+        }
+    }
+    return (sec > 1) ? (double)total / (sec - 1) : (double)cnt.fixes;
+}
+
+int main(int argc, char **argv)
+{
+    int baud = 0, new_baud = 0, rate_hz = 0, nmea_mask = -1, ubx_nav = 0;
+    int save = 0, verify_sec = 3, opt, fail = 0;
+
+    while ((opt = getopt(argc, argv, "b:B:r:n:us:t:")) != -1) {
+        switch (opt) {
+            case 'b': baud       = atoi(optarg); break;
+            case 'B': new_baud   = atoi(optarg); break;
+            case 'r': rate_hz    = atoi(optarg); break;
+            case 'n': nmea_mask  = parse_nmea_list(optarg);
+                      if (nmea_mask < 0) { fprintf(stderr, "unknown sentence in %s\n", optarg); return 1; }
+                      break;
+            case 'u': ubx_nav    = 1; break;
+            case 's': save       = parse_devices(optarg); break;
+            case 't': verify_sec = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-B baud] [-r Hz] [-n GGA,RMC,...] [-u] "
+                                "[-s bbr|flash] [-t sec] [device]\n", argv[0]);
+                return 1;
+        }
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    if ((baud && !gps_serial_speed(baud)) || (new_baud && !gps_serial_speed(new_baud)) ||
+        rate_hz < 0 || rate_hz > 10) {
+        fprintf(stderr, "invalid baud/rate\n");
+        return 1;
+    }
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud ? baud : GPS_SERIAL_BAUD, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror(dev);
+        return 1;
+    }
+
+    UbxCfg cfg;
+    ubx_cfg_init(&cfg, &ser);
+
+    if (!baud) {
+        baud = ubx_cfg_detect(&cfg);
+        if (baud < 0) {
+            fprintf(stderr, "%s: receiver not found (%s)\n", dev, ubx_cfg_strerror((UbxCfgError)baud));
+            gps_serial_close(&ser);
+            return 1;
+        }
+    }
+    printf("%s: %d baud\n", dev, baud);
+
+    // 출력을 먼저 줄여야 낮은 보레이트에서도 ACK 가 밀리지 않음
+    if (nmea_mask >= 0) {
+        for (int t = 0; t < NMEA_TYPE_COUNT; t++) {
+            char what[32];
+            int  on = (nmea_mask >> t) & 1;
+            snprintf(what, sizeof(what), "CFG-MSG %s %s", nmea_type_name((NmeaType)t), on ? "on" : "off");
+            fail |= check(what, ubx_cfg_nmea(&cfg, (NmeaType)t, (uint8_t)on));
+        }
+    }
+    if (ubx_nav) {
+        fail |= check("CFG-MSG NAV-POSLLH on", ubx_cfg_msg(&cfg, UBX_NAV, UBX_NAV_POSLLH, 1));
+        fail |= check("CFG-MSG NAV-SOL on",    ubx_cfg_msg(&cfg, UBX_NAV, UBX_NAV_SOL, 1));
+        fail |= check("CFG-MSG NAV-VELNED on", ubx_cfg_msg(&cfg, UBX_NAV, UBX_NAV_VELNED, 1));
+    }
+    if (new_baud && new_baud != baud) {
+        char what[32];
+        snprintf(what, sizeof(what), "CFG-PRT %d baud", new_baud);
+        if (check(what, ubx_cfg_port(&cfg, new_baud, UBX_PROTO_UBX | UBX_PROTO_NMEA,
+                                     UBX_PROTO_UBX | UBX_PROTO_NMEA)) == 0) {
+            baud = new_baud;
+        } else {
+            // 수신기 상태를 모르므로 이전 보레이트로 되돌려 둠
+            gps_serial_set_baud(&ser, baud);
+            fail = 1;
+        }
+    }
+    if (rate_hz) {
+        char what[32];
+        snprintf(what, sizeof(what), "CFG-RATE %d ms", 1000 / rate_hz);
+        fail |= check(what, ubx_cfg_rate(&cfg, 1000 / rate_hz));
+    }
+    if (save) {
+        char what[32];
+        snprintf(what, sizeof(what), "CFG-CFG save%s%s",
+                 (save & UBX_DEV_BBR) ? " BBR" : "", (save & UBX_DEV_FLASH) ? " flash" : "");
+        fail |= check(what, ubx_cfg_save(&cfg, (uint8_t)save));
+    }
+
+    printf("commands %llu sent, %llu ACK, %llu NAK, %llu timeout\n",
+           (unsigned long long)cfg.stats.sent, (unsigned long long)cfg.stats.acks,
+           (unsigned long long)cfg.stats.naks, (unsigned long long)cfg.stats.timeouts);
+
+    if (verify_sec > 0) {
+        printf("verify at %d baud:\n", baud);
+        double hz = measure(&ser, baud, verify_sec);
+        printf("%.1f epoch/s", hz);
+        if (rate_hz) {
+            printf(" (expected %d)", rate_hz);
+            if (hz < rate_hz * 0.9) fail = 1;
+        }
+        printf("\n");
+    }
+
+    gps_serial_close(&ser);
+    return fail ? 1 : 0;
+}
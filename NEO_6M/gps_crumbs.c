@@ -0,0 +1,195 @@
+// 이동 궤적 기록 + 재방문 감지 + 귀환 경로
+//
+// fix 마다 Kalman 위치를 궤적 (gps_trail) 에 쌓고, -A 초보다 오래된 점이 -R m 안에
+// 있으면 재방문 (REVISIT) 을 알린다 (반경의 1.5 배 밖으로 나가면 해제).
+// SIGUSR1 을 받거나 끝날 때 현재 위치에서 출발점까지 귀환 경로를 -o 파일로 쓴다
+// (gps_route_load 형식, gps_nav -w 로 그대로 따라감).
+//
+// 실행: ./gps_crumbs [-b baud] [-d min_dist_m] [-m max_points] [-R revisit_m]
+//                    [-A revisit_age_s] [-t tol_m] [-s shortcut_m] [-o home.txt] [dev]
+//         -d  저장 간격 (기본 1 m), -m  점 수 상한 (기본 1M, 닿으면 간격을 두 배로)
+//         -t  귀환 경로 Douglas-Peucker 허용 오차 (기본 2 m)
+//         -s  이 거리 안의 더 오래된 점으로 건너뛰어 고리 생략 (기본 10 m, 0: 그대로)
+//
+//   kill -USR1 $(pidof gps_crumbs)      # 지금 위치에서 귀환 경로 쓰기
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "gps_trail.h"
+
+typedef struct {
+    GpsTrail    trail;
+    GpsKf       kf;
+    double      revisit_m, tol, shortcut;
+    int64_t     revisit_age_ns;
+    int         revisiting;
+    uint64_t    revisits;
+    double      lat, lon;               // 마지막 위치
+    int         have_pos;
+    const char *home_path;
+} Crumbs;
+
+static volatile sig_atomic_t stop, want_home;
+
+static void on_signal(int sig)
+{
+    if (sig == SIGUSR1) want_home = 1;
+    else                stop = 1;
+}
+
+static int write_wp(double lat, double lon, void *user)
+{
+    return fprintf(user, "%.7f,%.7f\n", lat, lon) < 0;
+}
+
+static void write_home(Crumbs *c)
+{
+    if (!c->have_pos) {
+        fprintf(stderr, "no position yet, home route not written\n");
+        return;
+    }
+
+    FILE *fp = fopen(c->home_path, "w");
+    if (!fp) {
+        perror(c->home_path);
+        return;
+    }
+    fprintf(fp, "# gps_crumbs home route: %zu trail points, tol %.1f m, shortcut %.1f m\n",
+            gps_trail_count(&c->trail), c->tol, c->shortcut);
+
+    int64_t t0 = gps_now_ns();
+    int     n  = gps_trail_home(&c->trail, c->lat, c->lon, c->tol, c->shortcut, write_wp, fp);
+    int64_t dt = gps_now_ns() - t0;
+    if (fclose(fp) != 0 || n < 0) {
+        perror(c->home_path);
+        return;
+    }
+    printf("  HOME route: %d waypoints -> %s (%.1f ms)\n", n, c->home_path, dt / 1e6);
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Crumbs     *c = user;
+    GpsTrailHit hit;
+
+    if (!(f->valid & GPS_V_POS)) return;
+    gps_kf_update_fix(&c->kf, f);                   // 기각되면 예측 위치
+    gps_kf_position(&c->kf, &c->lat, &c->lon);
+    c->have_pos = 1;
+
+    int stored = gps_trail_add(&c->trail, c->lat, c->lon, f->rx_ns);
+    int near   = (gps_trail_nearest(&c->trail, c->lat, c->lon, f->rx_ns - c->revisit_age_ns, &hit) == 0);
+
+    printf("%02d:%02d:%02d.%03d  %.7f, %.7f  points %zu%s",
+           f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60, f->time_ms % 1000,
+           c->lat, c->lon, gps_trail_count(&c->trail), stored ? "+" : " ");
+    if (near) printf("  old track %.1f m (#%u, %.0f s ago)", hit.dist, hit.index, (f->rx_ns - hit.t_ns) / 1e9);
+    printf("\n");
+
+    if (near && !c->revisiting && hit.dist <= c->revisit_m) {
+        c->revisiting = 1;
+        c->revisits++;
+        printf("  REVISIT point #%u (%.1f m, %.0f s ago)\n", hit.index, hit.dist, (f->rx_ns - hit.t_ns) / 1e9);
+    } else if (c->revisiting && (!near || hit.dist > 1.5 * c->revisit_m)) {
+        c->revisiting = 0;
+        printf("  LEAVE revisited area\n");
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-b baud] [-d min_dist_m] [-m max_points] [-R revisit_m]\n"
+                    "       [-A revisit_age_s] [-t tol_m] [-s shortcut_m] [-o home.txt] [dev]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int    baud = GPS_SERIAL_BAUD, opt;
+    long   max_points = 0;
+    double min_dist = 0.0, age = 60.0;
+    Crumbs c = { .revisit_m = 5.0, .tol = 2.0, .shortcut = 10.0, .home_path = "home.txt" };
+
+    while ((opt = getopt(argc, argv, "b:d:m:R:A:t:s:o:")) != -1) {
+        switch (opt) {
+            case 'b': baud        = atoi(optarg); break;
+            case 'd': min_dist    = atof(optarg); break;
+            case 'm': max_points  = atol(optarg); break;
+            case 'R': c.revisit_m = atof(optarg); break;
+            case 'A': age         = atof(optarg); break;
+            case 't': c.tol       = atof(optarg); break;
+            case 's': c.shortcut  = atof(optarg); break;
+            case 'o': c.home_path = optarg;       break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (max_points < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+    c.revisit_age_ns = (int64_t)(age * 1e9);
+
+    if (gps_trail_init(&c.trail, (size_t)max_points, min_dist) < 0) {
+        perror("gps_trail_init");
+        return 1;
+    }
+    gps_kf_init(&c.kf, 0.0);
+    printf("trail: %zu points max, %.1f MB\n", c.trail.max_points, gps_trail_memory(&c.trail) / 1e6);
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        gps_trail_free(&c.trail);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGUSR1, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &c);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    while (!stop) {
+        int64_t rx_ns;
+        int r = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (r < 0) {
+            if (!stop) perror("GPS read");
+            break;
+        }
+        if (r > 0) gps_stream_feed(&stream, buf, r, rx_ns);
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
+        if (want_home) {
+            want_home = 0;
+            write_home(&c);
+        }
+        fflush(stdout);
+    }
+
+    write_home(&c);
+    printf("fixes %llu, stored %llu, points %zu, thinned %llu, rebuilds %llu (step max %.3f ms), "
+           "revisits %llu\n",
+           (unsigned long long)c.trail.stats.fixes, (unsigned long long)c.trail.stats.stored,
+           gps_trail_count(&c.trail), (unsigned long long)c.trail.stats.thins,
+           (unsigned long long)c.trail.stats.rebuilds, c.trail.stats.step_max_ns / 1e6,
+           (unsigned long long)c.revisits);
+    gps_serial_close(&ser);
+    gps_trail_free(&c.trail);
+    return 0;
+}
@@ -0,0 +1,198 @@
+// GPS 발행 데몬
+//
+// 시리얼 포트를 혼자 열고 epoch 마다 GpsFix 를 공유 메모리 (gps_shm) 에 발행한다.
+// 다른 도구 (gps_watch, 서보 / 기록 도구 등) 는 포트 대신 gps_shm_open() 으로 읽는다.
+//
+// 실행: ./gps_daemon [-b baud] [-s name] [-v] [-d] [-w state] [-n] [-T tacc_ms] [dev]
+//         -s  세그먼트 이름 (기본 /neo6m_gps)
+//         -v  fix 마다 한 줄 출력
+//         -d  링크 진단 요약을 10초마다 출력 (포화 시작 / 해소 경고는 항상)
+//         -w  warm start 상태 파일 (기본 /var/tmp/neo6m.warm): 시작 시 수신기 aiding,
+//             마지막 위치 / AID-DATA 를 종료 시와 60초마다 저장 (-n: 끔)
+//         -T  시각 aiding 정확도 (ms), 기본은 시스템 시계가 NTP 동기일 때만
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_diag.h"
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_shm.h"
+#include "gps_stream.h"
+#include "gps_warm.h"
+
+typedef struct {
+    GpsShm   shm;
+    int      verbose;
+    int      diag_verbose;
+    int      saturated;
+    GpsDiag  diag;
+    GpsEpoch epoch;
+    GpsWarm  warm;
+    int      use_warm;
+    int64_t  first_fix_ns;
+} Daemon;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Daemon *d = user;
+
+    gps_shm_publish(&d->shm, f);
+    gps_diag_on_fix(&d->diag, f);
+    if (d->use_warm && (f->valid & GPS_V_POS)) {
+        gps_warm_set_fix(&d->warm, f, gps_warm_real_ns());
+        if (!d->first_fix_ns) d->first_fix_ns = f->pub_ns;
+    }
+    if (d->verbose)
+        printf("#%u %s %.7f, %.7f  sats %d  hdop %.2f\n",
+               gps_shm_count(&d->shm), (f->valid & GPS_V_POS) ? "fix" : "no fix",
+               nmea_e7_to_deg(f->lat), nmea_e7_to_deg(f->lon),
+               f->num_sats, f->hdop / 100.0);
+}
+
+// 수신기 AID 프레임 (AID-DATA poll 응답) 보관 후 NAV 는 epoch 으로
+static void on_ubx(const UbxFrame *f, void *user)
+{
+    Daemon *d = user;
+
+    if (d->use_warm && gps_warm_on_ubx(&d->warm, f, gps_warm_real_ns())) return;
+    gps_epoch_on_ubx(f, &d->epoch);
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = NULL, *warm_path = GPS_WARM_PATH;
+    int         baud = GPS_SERIAL_BAUD, tacc_ms = -2, opt;
+    Daemon      d = { .use_warm = 1 };
+
+    while ((opt = getopt(argc, argv, "b:s:vdw:nT:")) != -1) {
+        switch (opt) {
+            case 'b': baud       = atoi(optarg); break;
+            case 's': name       = optarg;       break;
+            case 'v': d.verbose  = 1;            break;
+            case 'd': d.diag_verbose = 1;        break;
+            case 'w': warm_path  = optarg;       break;
+            case 'n': d.use_warm = 0;            break;
+            case 'T': tacc_ms    = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-s name] [-v] [-d] [-w state] [-n] [-T tacc_ms] [dev]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if (tacc_ms == -2) tacc_ms = gps_warm_clock_acc_ms();
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    if (gps_shm_create(&d.shm, name) < 0) {
+        if (errno == EBUSY) fprintf(stderr, "gps_daemon already running\n");
+        else                perror("shm");
+        return 1;
+    }
+
+    // UART0 (GPIO14=TX, GPIO15=RX / 물리핀 8/10), raw 모드 + epoll 대기
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        gps_shm_close(&d.shm);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    gps_epoch_init(&d.epoch, on_fix, &d);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&d.epoch, &disp);
+    // 진단은 항상 켬 (문장당 비교 몇 번, 보고는 GPS_DIAG_REPORT_S 마다)
+    gps_diag_init(&d.diag, nmea_dispatch_sentence, &disp, on_ubx, &d);
+    gps_stream_init(&stream, gps_diag_sentence, &d.diag, gps_diag_ubx, &d.diag);
+
+    // 마지막 위치 / 궤도 정보로 수신기 aiding (필터 상태는 그대로 두고 다시 저장)
+    gps_warm_init(&d.warm);
+    if (d.use_warm && gps_warm_load(&d.warm, warm_path) == 0) {
+        int n = gps_warm_send(&d.warm, &ser, gps_warm_real_ns(), tacc_ms);
+        if (n < 0) perror("AID write");
+        else printf("aiding %d bytes (time %s, ephemeris %d)\n", n, tacc_ms >= 0 ? "yes" : "no",
+                    gps_warm_eph_count(&d.warm));
+    } else if (d.use_warm && errno != ENOENT) {
+        perror(warm_path);
+    }
+
+    printf("%s -> /dev/shm%s (%d baud, fix #%u, restarts %u)\n",
+           dev, name ? name : GPS_SHM_NAME, baud,
+           gps_shm_count(&d.shm), d.shm.seg->restarts);
+    fflush(stdout);
+
+    int64_t save_ns = 0, poll_ns = 0, diag_ns = gps_now_ns() + GPS_DIAG_REPORT_S * 1000000000LL;
+    GpsDiagReport rep;
+    gps_diag_report(&d.diag, &stream, &ser, baud, gps_now_ns(), &rep);
+    while (!stop) {
+        // epoch 사이 무수신 구간에서 timeout 판정, 종료 시그널 확인
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (n < 0) {
+            perror("GPS read");
+            break;
+        }
+        if (n > 0)
+            gps_stream_feed(&stream, buf, n, rx_ns);
+        int64_t now = gps_now_ns();
+        gps_epoch_poll(&d.epoch, ser.last_rx_ns, now);
+        if (d.verbose) fflush(stdout);
+
+        if (now >= diag_ns) {
+            gps_diag_report(&d.diag, &stream, &ser, baud, now, &rep);
+            diag_ns = now + GPS_DIAG_REPORT_S * 1000000000LL;
+            if (rep.saturated != d.saturated)
+                fprintf(stderr, "link %s: %.0f B/s (%.0f%% of %d baud), busy %.0f%%, gaps %llu\n",
+                        rep.saturated ? "saturated" : "ok", rep.bytes_per_s, rep.util * 100.0,
+                        baud, rep.busy * 100.0, (unsigned long long)rep.d.gaps);
+            d.saturated = rep.saturated;
+            if (d.diag_verbose) {
+                printf("diag %.2f fix/s, %.0f B/s (%.0f%%), busy %.0f%%, jitter p99 %.1f ms, "
+                       "latency p99 %.1f ms, checksum %llu, framing %llu, truncated %llu\n",
+                       rep.epoch_hz, rep.bytes_per_s, rep.util * 100.0, rep.busy * 100.0,
+                       rep.jitter_p99_us / 1e3, rep.latency_p99_us / 1e3,
+                       (unsigned long long)rep.d.checksum_errors,
+                       (unsigned long long)rep.d.framing_errors,
+                       (unsigned long long)rep.d.truncated);
+                fflush(stdout);
+            }
+        }
+
+        // 첫 fix 후 GPS_WARM_SAVE_S 마다 저장, AID-DATA poll 은 그 뒤 GPS_WARM_POLL_S 마다
+        if (!d.use_warm || !d.first_fix_ns) continue;
+        if (!save_ns) save_ns = poll_ns = d.first_fix_ns + GPS_WARM_SAVE_S * 1000000000LL;
+        if (now >= poll_ns) {
+            if (gps_warm_poll(&ser) < 0) perror("AID-DATA poll");
+            poll_ns = now + GPS_WARM_POLL_S * 1000000000LL;
+        }
+        if (now >= save_ns) {
+            if (gps_warm_save(&d.warm, warm_path) < 0) perror(warm_path);
+            save_ns = now + GPS_WARM_SAVE_S * 1000000000LL;
+        }
+    }
+
+    gps_epoch_flush(&d.epoch);
+    if (d.use_warm && d.warm.real_ns && gps_warm_save(&d.warm, warm_path) < 0) perror(warm_path);
+    printf("published %llu fixes\n", (unsigned long long)d.epoch.stats.published);
+    gps_serial_close(&ser);
+    gps_shm_close(&d.shm);
+    return 0;
+}
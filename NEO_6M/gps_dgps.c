@@ -0,0 +1,372 @@
+#include "gps_dgps.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+_Static_assert(sizeof(GpsDgpsMsg) == 56, "GpsDgpsMsg layout");
+
+#define DAY_MS  86400000
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+/**
+ * @brief UTC 시각 차 a - b (ms, 자정 넘김 보정)
+ */
+static int32_t utc_diff(int32_t a, int32_t b)
+{
+    int32_t d = a - b;
+
+    if (d > DAY_MS / 2)       d -= DAY_MS;
+    else if (d <= -DAY_MS / 2) d += DAY_MS;
+    return d;
+}
+
+static int32_t m_to_mm(double m)
+{
+    return (int32_t)lround(m * 1000.0);
+}
+
+// ─────────────────────────────────────────────
+//  기준국
+// ─────────────────────────────────────────────
+
+int gps_dgps_base_init(GpsDgpsBase *b, const char *host, int port,
+                       int survey_min_s, double survey_acc)
+{
+    int on = 1;
+
+    memset(b, 0, sizeof(GpsDgpsBase));
+    b->fd             = -1;
+    b->survey_min_s   = (survey_min_s > 0) ? survey_min_s : GPS_DGPS_SURVEY_MIN_S;
+    b->survey_acc     = (survey_acc > 0.0) ? survey_acc : GPS_DGPS_SURVEY_ACC;
+    b->survey_last_ms = -1;
+
+    b->dst.sin_family = AF_INET;
+    b->dst.sin_port   = htons((uint16_t)(port ? port : GPS_DGPS_PORT));
+    if (inet_pton(AF_INET, host ? host : "127.0.0.1", &b->dst.sin_addr) != 1) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // 측량 창: 최소 시간의 2배까지 (목표 정확도에 못 미치면 최근 값으로 계속)
+    if (win_pos_init(&b->survey, (size_t)b->survey_min_s * 2 * 1000 / GPS_DGPS_SURVEY_STEP_MS) < 0)
+        return -1;
+
+    b->fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (b->fd < 0 || setsockopt(b->fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on)) < 0) {
+        int err = errno;
+        gps_dgps_base_free(b);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+static void set_ref(GpsDgpsBase *b, double lat, double lon, double acc)
+{
+    geo_ltp_init(&b->ref, lat, lon, 0.0);
+    b->ref_lat = b->ref.lat0_e7;
+    b->ref_lon = b->ref.lon0_e7;
+    b->ref_acc = acc;
+    b->fixed   = 1;
+}
+
+void gps_dgps_base_set_ref(GpsDgpsBase *b, double lat, double lon)
+{
+    set_ref(b, lat, lon, 0.0);
+    b->flags |= GPS_DGPS_F_FIXED;
+}
+
+void gps_dgps_base_survey(const GpsDgpsBase *b, double *secs, double *acc)
+{
+    size_t n = win_stat_count(&b->survey.e);
+    double t = n * (GPS_DGPS_SURVEY_STEP_MS / 1000.0);     // 빠진 fix 가 있으면 짧게 잡힘
+
+    if (secs) *secs = t;
+    if (acc) {
+        // 상관된 표본의 평균: 분산이 σ² / n 이 아니라 σ² / n_eff (n_eff = T / 2τ, T ≫ τ).
+        // 창 안 분산도 그만큼 σ² 보다 작게 나오므로 (1 - 1 / n_eff) 배 보정 → 나눌 값 n_eff - 1
+        double n_eff = t / (2.0 * GPS_DGPS_SURVEY_TAU_S);
+        if (n_eff > n) n_eff = n;
+
+        if (b->fixed)          *acc = b->ref_acc;
+        else if (n_eff <= 1.0) *acc = INFINITY;     // 상관 시간보다 짧음: 추정 불가
+        else *acc = sqrt((win_stat_var(&b->survey.e) + win_stat_var(&b->survey.n)) / (n_eff - 1.0));
+    }
+}
+
+int gps_dgps_base_fix(GpsDgpsBase *b, const GpsFix *f, GpsDgpsMsg *out)
+{
+    double lat, lon, e, n;
+
+    if ((f->valid & (GPS_V_POS | GPS_V_TIME)) != (GPS_V_POS | GPS_V_TIME)) return 0;
+    b->stats.epochs++;
+    lat = f->lat * 1e-7;
+    lon = f->lon * 1e-7;
+
+    if (!b->fixed) {
+        // survey-in: 1초에 한 fix 씩 MAD 기각한 평균, 최소 시간을 넘고 정확도가 목표 이하이면 확정
+        uint64_t resets = b->survey.stats.resets;
+        double   secs, acc;
+
+        int32_t step = utc_diff(f->time_ms, b->survey_last_ms);
+        if (b->survey_last_ms >= 0 && step >= 0 && step < GPS_DGPS_SURVEY_STEP_MS) return 0;
+        b->survey_last_ms = f->time_ms;
+        win_pos_push(&b->survey, lat, lon);
+        if (b->survey.stats.resets != resets) b->stats.survey_resets++;
+        gps_dgps_base_survey(b, &secs, &acc);
+        if (secs < b->survey_min_s || acc > b->survey_acc) return 0;
+
+        double ref_lat, ref_lon;
+        win_pos_mean(&b->survey, &ref_lat, &ref_lon);
+        set_ref(b, ref_lat, ref_lon, acc);
+    }
+
+    GpsDgpsMsg m;
+    memset(&m, 0, sizeof(m));
+    geo_ltp_fwd(&b->ref, lat, lon, &e, &n);
+    m.magic      = GPS_DGPS_MAGIC;
+    m.version    = GPS_DGPS_VERSION;
+    m.flags      = b->flags;
+    m.seq        = b->seq++;
+    m.time_ms    = f->time_ms;
+    m.fix_ns     = f->end_ns;
+    m.ref_lat    = b->ref_lat;
+    m.ref_lon    = b->ref_lon;
+    m.de_mm      = m_to_mm(-e);
+    m.dn_mm      = m_to_mm(-n);
+    m.ref_acc_mm = (b->ref_acc < INT32_MAX / 1000.0) ? m_to_mm(b->ref_acc) : INT32_MAX;
+    m.hdop       = (f->valid & GPS_V_HDOP) ? (uint16_t)f->hdop : 0;
+    m.num_sats   = (f->valid & GPS_V_SATS) ? (uint8_t)f->num_sats : 0;
+    m.quality    = (f->valid & GPS_V_QUALITY) ? (uint8_t)f->quality : 0;
+    m.tx_ns      = gps_now_ns();
+    if (out) *out = m;
+
+    if (sendto(b->fd, &m, sizeof(m), 0, (const struct sockaddr *)&b->dst, sizeof(b->dst)) < 0) {
+        b->stats.send_errors++;
+        return -1;
+    }
+    b->stats.sent++;
+    return 1;
+}
+
+void gps_dgps_base_free(GpsDgpsBase *b)
+{
+    if (b->fd >= 0) close(b->fd);
+    b->fd = -1;
+    win_pos_free(&b->survey);
+}
+
+// ─────────────────────────────────────────────
+//  이동국
+// ─────────────────────────────────────────────
+
+int gps_dgps_rover_init(GpsDgpsRover *r, int port, GpsFixCb cb, void *user)
+{
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_port        = htons((uint16_t)(port ? port : GPS_DGPS_PORT)),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    int on = 1;
+
+    memset(r, 0, sizeof(GpsDgpsRover));
+    r->hold_ms    = GPS_DGPS_HOLD_MS;
+    r->max_age_ms = GPS_DGPS_MAX_AGE_MS;
+    r->cb         = cb;
+    r->user       = user;
+
+    r->fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (r->fd < 0) return -1;
+    if (setsockopt(r->fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0 ||
+        bind(r->fd, (const struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        int err = errno;
+        close(r->fd);
+        r->fd = -1;
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+void gps_dgps_rover_set_policy(GpsDgpsRover *r, int hold_ms, int max_age_ms)
+{
+    r->hold_ms    = (hold_ms > 0) ? hold_ms : 0;
+    r->max_age_ms = (max_age_ms > 0) ? max_age_ms : 0;
+}
+
+/**
+ * @brief time_ms 에 쓸 보정 찾기
+ * @param exact 같은 epoch 보정 (없으면 NULL)
+ * @param older 가장 최근의 이전 보정 (없으면 NULL)
+ * @return 1: time_ms 보다 나중 보정을 이미 받음 (같은 epoch 는 더 오지 않음)
+ */
+static int find_corr(const GpsDgpsRover *r, int32_t time_ms,
+                     const GpsDgpsCorr **exact, const GpsDgpsCorr **older)
+{
+    int newer = 0;
+
+    *exact = *older = NULL;
+    for (size_t i = 0; i < r->ncorr; i++) {
+        const GpsDgpsCorr *c = &r->corr[(r->head + GPS_DGPS_RING - i) % GPS_DGPS_RING];
+        int32_t            d = utc_diff(time_ms, c->msg.time_ms);
+
+        if (d < 0) {
+            newer = 1;
+        } else if (d == 0) {
+            *exact = c;
+        } else {
+            *older = c;                                 // 최근부터 보므로 첫 번째가 가장 가까움
+            break;
+        }
+    }
+    return newer;
+}
+
+static void emit(GpsDgpsRover *r, const GpsDgpsPend *p, const GpsDgpsCorr *c,
+                 GpsDgpsMatch match, int64_t now_ns)
+{
+    GpsFix          f = p->fix;
+    GpsDgpsApplied *a = &r->last;
+
+    memset(a, 0, sizeof(*a));
+    a->hold_ns = now_ns - p->t_ns;
+    if (c && match == GPS_DGPS_OLDER && utc_diff(f.time_ms, c->msg.time_ms) > r->max_age_ms)
+        c = NULL;
+
+    if (c) {
+        GeoLtp here;
+        double lat, lon;
+
+        geo_ltp_init(&here, f.lat * 1e-7, f.lon * 1e-7, 0.0);
+        a->match      = match;
+        a->age_ms     = utc_diff(f.time_ms, c->msg.time_ms);
+        a->de         = c->msg.de_mm / 1000.0;
+        a->dn         = c->msg.dn_mm / 1000.0;
+        a->latency_ns = c->rx_ns - c->msg.fix_ns;
+        a->baseline_m = geo_haversine(c->msg.ref_lat * 1e-7, c->msg.ref_lon * 1e-7,
+                                      here.lat0, here.lon0);
+        geo_ltp_inv(&here, a->de, a->dn, &lat, &lon);
+        f.lat      = (int32_t)lround(lat * 1e7);
+        f.lon      = (int32_t)lround(lon * 1e7);
+        f.quality  = 2;                                 // DGPS (gps_kf 는 측정 σ 절반)
+        f.valid   |= GPS_V_QUALITY;
+        if (match == GPS_DGPS_MATCHED) r->stats.matched++;
+        else                           r->stats.older++;
+    } else {
+        a->match = GPS_DGPS_NONE;
+        r->stats.uncorrected++;
+    }
+    r->stats.fixes++;
+    if (r->cb) r->cb(&f, r->user);
+}
+
+/**
+ * @brief fix 를 지금 내보낼 수 있으면 내보냄
+ * @param expired hold 만료 (같은 epoch 를 더 기다리지 않음)
+ * @return 1: 내보냄, 0: 더 기다림
+ */
+static int try_emit(GpsDgpsRover *r, const GpsDgpsPend *p, int expired, int64_t now_ns)
+{
+    const GpsDgpsCorr *exact, *older;
+    int                newer = find_corr(r, p->fix.time_ms, &exact, &older);
+
+    if (exact) {
+        emit(r, p, exact, GPS_DGPS_MATCHED, now_ns);
+        return 1;
+    }
+    if (!expired && !newer) return 0;
+    emit(r, p, older, GPS_DGPS_OLDER, now_ns);
+    return 1;
+}
+
+static void release(GpsDgpsRover *r, int64_t now_ns, int all)
+{
+    while (r->npend) {
+        const GpsDgpsPend *p = &r->pend[r->first];
+        int expired = all || now_ns - p->t_ns >= (int64_t)r->hold_ms * 1000000LL;
+
+        if (!try_emit(r, p, expired, now_ns)) break;
+        r->first = (r->first + 1) % GPS_DGPS_PEND;
+        r->npend--;
+    }
+}
+
+void gps_dgps_rover_fix(GpsDgpsRover *r, const GpsFix *f, int64_t now_ns)
+{
+    GpsDgpsPend p = { .fix = *f, .t_ns = now_ns };
+
+    if ((f->valid & (GPS_V_POS | GPS_V_TIME)) != (GPS_V_POS | GPS_V_TIME)) {
+        // 보정할 수 없음: 순서를 지키려고 대기 중인 fix 를 먼저 내보냄
+        release(r, now_ns, 1);
+        if (r->cb) r->cb(f, r->user);
+        return;
+    }
+    if (r->npend == 0 && try_emit(r, &p, r->hold_ms == 0, now_ns)) return;
+
+    if (r->npend == GPS_DGPS_PEND) {
+        r->stats.overflows++;
+        const GpsDgpsPend *old = &r->pend[r->first];
+        emit(r, old, NULL, GPS_DGPS_NONE, now_ns);
+        r->first = (r->first + 1) % GPS_DGPS_PEND;
+        r->npend--;
+    }
+    r->pend[(r->first + r->npend) % GPS_DGPS_PEND] = p;
+    r->npend++;
+}
+
+int gps_dgps_rover_poll(GpsDgpsRover *r, int64_t now_ns)
+{
+    GpsDgpsMsg m;
+    ssize_t    n;
+    int        got = 0;
+
+    while ((n = recv(r->fd, &m, sizeof(m), MSG_DONTWAIT | MSG_TRUNC)) >= 0) {
+        int64_t rx_ns = gps_now_ns();
+
+        r->stats.received++;
+        if (n != (ssize_t)sizeof(m) || m.magic != GPS_DGPS_MAGIC || m.version != GPS_DGPS_VERSION) {
+            r->stats.bad++;
+            continue;
+        }
+        if (r->ncorr && utc_diff(m.time_ms, r->corr[r->head].msg.time_ms) <= 0) {
+            r->stats.out_of_order++;
+            continue;
+        }
+        r->head = (r->head + 1) % GPS_DGPS_RING;
+        r->corr[r->head].msg   = m;
+        r->corr[r->head].rx_ns = rx_ns;
+        if (r->ncorr < GPS_DGPS_RING) r->ncorr++;
+        got++;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return -1;
+
+    release(r, now_ns, 0);
+    return got;
+}
+
+int gps_dgps_rover_timeout(const GpsDgpsRover *r, int64_t now_ns)
+{
+    if (r->npend == 0) return -1;
+
+    int64_t left = r->pend[r->first].t_ns + (int64_t)r->hold_ms * 1000000LL - now_ns;
+    return (left <= 0) ? 0 : (int)((left + 999999) / 1000000);
+}
+
+void gps_dgps_rover_flush(GpsDgpsRover *r)
+{
+    release(r, gps_now_ns(), 1);
+}
+
+void gps_dgps_rover_free(GpsDgpsRover *r)
+{
+    if (r->fd >= 0) close(r->fd);
+    r->fd    = -1;
+    r->npend = 0;
+}
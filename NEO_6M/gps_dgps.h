@@ -0,0 +1,214 @@
+#ifndef GPS_DGPS_H
+#define GPS_DGPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <netinet/in.h>
+#include "gps_fix.h"
+#include "geo.h"
+#include "win_stat.h"
+
+// ─────────────────────────────────────────────
+//  위치 영역 차분 보정 (기준국 → 이동국, UDP)
+//
+//  기준국: 움직이지 않는 수신기가 위치를 측량 (survey-in) 하거나 주어진 기준 위치를
+//          쓰고, epoch 마다 (기준 - 측정) ENU 오차를 UDP 로 보낸다.
+//  이동국: fix 를 같은 UTC epoch 의 기준국 보정이 올 때까지 잠시 잡아 두었다가
+//          보정해 내보낸다. hold 안에 오지 않으면 가장 최근 보정 (max_age 이내) 을 쓴다.
+//
+//  두 수신기가 같은 위성 조합을 쓸 때 공통 오차 (궤도 / 시계 / 전리층 / 대류층) 가
+//  상쇄된다. 기준선이 길어지거나 위성 조합이 다르면 효과가 줄어든다.
+//  고정 LAT_OFFSET / LON_OFFSET 과 달리 epoch 마다 갱신되므로 시간이 지나도 유지된다.
+//
+//  survey-in 은 MAD 기각한 평균이다. 공통 오차는 수 분 단위로 상관되어 있어 epoch 들이
+//  독립이 아니므로 정확도 추정은 σ / √n 이 아니라 유효 표본 수 n_eff = T / 2τ (1차
+//  Gauss-Markov, τ = GPS_DGPS_SURVEY_TAU_S) 로 구한다: 10 Hz 로 1분 모아도 독립 표본은
+//  1개가 안 되고, 그때는 추정 불가 (INFINITY) 로 목표 정확도를 넘지 못한다.
+//  최소 측량 시간은 epoch 수가 아니라 시간 (기본 30분) 이고, 측량 창에는 1초에 한 fix 만
+//  넣는다 (더 촘촘한 fix 는 정보가 거의 없음).
+//  측량 위치의 오차는 보정을 통해 이동국 위치에 그대로 실린다 (상대 위치는 영향 없음).
+// ─────────────────────────────────────────────
+
+#define GPS_DGPS_MAGIC      0x53504744u     // "DGPS"
+#define GPS_DGPS_VERSION    1
+#define GPS_DGPS_PORT       5017
+#define GPS_DGPS_RING       32              // 이동국이 보관하는 최근 보정 수
+#define GPS_DGPS_PEND       16              // 보정을 기다리는 이동국 fix 최대 수
+#define GPS_DGPS_HOLD_MS    300             // 같은 epoch 보정을 기다리는 최대 시간
+#define GPS_DGPS_MAX_AGE_MS 10000           // 이보다 오래된 보정은 쓰지 않음
+#define GPS_DGPS_SURVEY_MIN_S   1800        // survey-in 최소 시간 (s)
+#define GPS_DGPS_SURVEY_ACC     2.0         // survey-in 목표 정확도 (m)
+#define GPS_DGPS_SURVEY_STEP_MS 1000        // 측량 창에 넣는 fix 간격 (UTC)
+#define GPS_DGPS_SURVEY_TAU_S   300.0       // 공통 오차 상관 시간 가정 (s, 짧게 잡으면 낙관적)
+
+// GpsDgpsMsg.flags
+#define GPS_DGPS_F_FIXED    0x1             // 기준 위치를 직접 지정 (측량하지 않음)
+
+// UDP 페이로드 (호스트 바이트 순서, x86 / ARM 모두 little-endian)
+typedef struct {
+    uint32_t magic;                 // GPS_DGPS_MAGIC
+    uint16_t version;
+    uint16_t flags;                 // GPS_DGPS_F_*
+    uint32_t seq;
+    int32_t  time_ms;               // 기준국 epoch UTC (자정 이후 ms)
+    int64_t  fix_ns;                // 기준국 epoch 마지막 문장 수신 (기준국 CLOCK_MONOTONIC)
+    int64_t  tx_ns;                 // 송신 시각
+    int32_t  ref_lat, ref_lon;      // 기준 위치 (1e-7 도)
+    int32_t  de_mm, dn_mm;          // 보정 = 기준 - 측정 (동 / 북, mm)
+    int32_t  ref_acc_mm;            // 기준 위치 정확도 추정 (지정이면 0, 추정 불가면 INT32_MAX)
+    uint16_t hdop;                  // ×100
+    uint8_t  num_sats;
+    uint8_t  quality;
+} GpsDgpsMsg;
+
+// ─────────────────────────────────────────────
+//  기준국
+// ─────────────────────────────────────────────
+typedef struct {
+    uint64_t epochs;                // 위치가 있는 fix
+    uint64_t survey_resets;         // 측량 중 연속 기각 (이동) 으로 다시 시작
+    uint64_t sent;
+    uint64_t send_errors;
+} GpsDgpsBaseStats;
+
+typedef struct {
+    int                fd;
+    struct sockaddr_in dst;
+    WinPos             survey;          // GPS_DGPS_SURVEY_STEP_MS 마다 fix 하나
+    int                survey_min_s;
+    double             survey_acc;
+    int32_t            survey_last_ms;  // 마지막으로 측량 창에 넣은 fix UTC (-1: 없음)
+    int                fixed;           // 기준 위치 확정 (측량 완료 또는 지정)
+    GeoLtp             ref;
+    int32_t            ref_lat, ref_lon;
+    double             ref_acc;         // m
+    uint16_t           flags;
+    uint32_t           seq;
+    GpsDgpsBaseStats   stats;
+} GpsDgpsBase;
+
+/**
+ * @brief 기준국 초기화 (UDP 송신 소켓, 브로드캐스트 주소 허용)
+ * @param host       대상 IPv4 주소 (NULL: 127.0.0.1)
+ * @param port       0 이면 GPS_DGPS_PORT
+ * @param survey_min_s survey-in 최소 시간 s (0: GPS_DGPS_SURVEY_MIN_S)
+ * @param survey_acc   survey-in 목표 정확도 m (0 이하: GPS_DGPS_SURVEY_ACC)
+ * @return 0: 성공, -1: 실패 (errno 설정, 주소 형식 오류는 EINVAL)
+ */
+int gps_dgps_base_init(GpsDgpsBase *b, const char *host, int port,
+                       int survey_min_s, double survey_acc);
+
+/**
+ * @brief 기준 위치 직접 지정 (측량한 기준점, 이후 survey-in 생략)
+ */
+void gps_dgps_base_set_ref(GpsDgpsBase *b, double lat, double lon);
+
+/**
+ * @brief 기준국 fix 1개 처리 (측량 중이면 누적, 확정 후면 보정 송신)
+ * @param out 보낸 메시지 (NULL 가능)
+ * @return 1: 보정 송신, 0: 측량 중 / 위치 없음, -1: 송신 실패 (errno 설정)
+ */
+int gps_dgps_base_fix(GpsDgpsBase *b, const GpsFix *f, GpsDgpsMsg *out);
+
+/**
+ * @brief 측량 진행 상황 (측량 창이 덮는 시간 s, 현재 정확도 추정 m)
+ *        정확도 = √((σe² + σn²) / (n_eff - 1)), n_eff = 시간 / 2τ (1 이하면 INFINITY)
+ */
+void gps_dgps_base_survey(const GpsDgpsBase *b, double *secs, double *acc);
+
+void gps_dgps_base_free(GpsDgpsBase *b);
+
+// ─────────────────────────────────────────────
+//  이동국
+// ─────────────────────────────────────────────
+typedef enum {
+    GPS_DGPS_NONE = 0,              // 보정 없음 (수신 전 / max_age 초과 / 위치 없음)
+    GPS_DGPS_MATCHED,               // 같은 UTC epoch 의 보정
+    GPS_DGPS_OLDER,                 // hold 안에 같은 epoch 가 오지 않아 최근 보정
+} GpsDgpsMatch;
+
+// 마지막으로 내보낸 fix 에 적용한 보정
+typedef struct {
+    GpsDgpsMatch match;
+    int32_t      age_ms;            // 이동국 fix UTC - 보정 UTC
+    double       de, dn;            // 적용한 보정 (m)
+    double       baseline_m;        // 기준 위치까지 거리
+    int64_t      hold_ns;           // fix 를 잡아 둔 시간
+    int64_t      latency_ns;        // 보정의 기준국 epoch → 이동국 수신 (같은 호스트에서만 의미)
+} GpsDgpsApplied;
+
+typedef struct {
+    uint64_t received;
+    uint64_t bad;                   // 크기 / magic / version 불일치
+    uint64_t out_of_order;          // 이미 받은 epoch 보다 이전 (버림)
+    uint64_t fixes;                 // 내보낸 fix (위치 있음)
+    uint64_t matched, older, uncorrected;
+    uint64_t overflows;             // 대기열이 차서 먼저 내보냄
+} GpsDgpsRoverStats;
+
+typedef struct {
+    GpsDgpsMsg msg;
+    int64_t    rx_ns;
+} GpsDgpsCorr;
+
+typedef struct {
+    GpsFix  fix;
+    int64_t t_ns;                   // 대기 시작
+} GpsDgpsPend;
+
+// ─────────────────────────────────────────────
+//  이동국 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    int               fd;           // poll 대상 (수신 가능하면 gps_dgps_rover_poll)
+    GpsDgpsCorr       corr[GPS_DGPS_RING];
+    size_t            ncorr, head;  // head: 가장 최근 보정
+    GpsDgpsPend       pend[GPS_DGPS_PEND];
+    size_t            npend, first;
+    int               hold_ms;
+    int               max_age_ms;
+    GpsFixCb          cb;
+    void             *user;
+    GpsDgpsApplied    last;
+    GpsDgpsRoverStats stats;
+} GpsDgpsRover;
+
+/**
+ * @brief 이동국 초기화 (UDP 수신 소켓, non-blocking)
+ * @param port 0 이면 GPS_DGPS_PORT
+ * @param cb   보정한 fix (quality = 2) 또는 보정하지 못한 fix 를 순서대로 받음
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_dgps_rover_init(GpsDgpsRover *r, int port, GpsFixCb cb, void *user);
+
+/**
+ * @brief 대기 / 보정 나이 정책
+ * @param hold_ms    같은 epoch 보정을 기다리는 시간 (0: 기다리지 않고 최근 보정)
+ * @param max_age_ms 최근 보정을 쓸 수 있는 최대 나이
+ */
+void gps_dgps_rover_set_policy(GpsDgpsRover *r, int hold_ms, int max_age_ms);
+
+/**
+ * @brief 이동국 fix 입력 (맞는 보정이 있으면 바로, 없으면 대기열에)
+ */
+void gps_dgps_rover_fix(GpsDgpsRover *r, const GpsFix *f, int64_t now_ns);
+
+/**
+ * @brief 도착한 보정을 모두 받고 대기 중 fix 를 내보냄
+ * @return 받은 보정 수, -1: 수신 오류 (errno 설정)
+ */
+int gps_dgps_rover_poll(GpsDgpsRover *r, int64_t now_ns);
+
+/**
+ * @brief 가장 이른 대기 만료까지 남은 ms (대기 fix 없으면 -1, poll timeout 용)
+ */
+int gps_dgps_rover_timeout(const GpsDgpsRover *r, int64_t now_ns);
+
+/**
+ * @brief 대기 중 fix 를 모두 내보냄 (종료 시)
+ */
+void gps_dgps_rover_flush(GpsDgpsRover *r);
+
+void gps_dgps_rover_free(GpsDgpsRover *r);
+
+#endif /* GPS_DGPS_H */
@@ -0,0 +1,292 @@
+#include "gps_diag.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NMEA_FRAME_BYTES    6           // '$' + "*hh" + "\r\n"
+#define KEY_UBX             (1ULL << 63)
+
+// 히스토그램 구간 상한 (µs), 마지막 구간은 그 이상 전부
+static const int64_t bin_us[GPS_DIAG_BINS - 1] = {
+    100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000,
+    100000, 200000, 500000, 1000000,
+};
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static int bin_of(int64_t ns)
+{
+    int64_t us = ns / 1000;
+    int     i  = 0;
+
+    while (i < GPS_DIAG_BINS - 1 && us >= bin_us[i]) i++;
+    return i;
+}
+
+/**
+ * @brief 구간 히스토그램의 q 분위 (구간 상한, max 로 제한)
+ */
+static int64_t hist_quantile(const uint64_t *h, double q, int64_t max_us)
+{
+    uint64_t total = 0, acc = 0;
+
+    for (int i = 0; i < GPS_DIAG_BINS; i++) total += h[i];
+    if (!total) return 0;
+    for (int i = 0; i < GPS_DIAG_BINS; i++) {
+        acc += h[i];
+        if ((double)acc >= q * (double)total) {
+            int64_t up = gps_diag_bin_us(i);
+            return up < max_us ? up : max_us;
+        }
+    }
+    return max_us;
+}
+
+/**
+ * @brief 종류 칸 찾기 / 추가 (표가 차면 마지막 칸 "other")
+ */
+static GpsDiagType *type_slot(GpsDiag *d, uint64_t key)
+{
+    GpsDiagType *t = &d->type[d->last_type];
+    int          i;
+
+    if (d->ntypes && t->key == key) return t;
+    for (i = 0; i < d->ntypes; i++)
+        if (d->type[i].key == key) break;
+    if (i == d->ntypes) {
+        if (d->ntypes == GPS_DIAG_TYPES - 1) {
+            i = GPS_DIAG_TYPES - 1;
+            if (d->type[i].key != ~0ULL) {
+                d->type[i].key = ~0ULL;
+                strcpy(d->type[i].name, "other");
+            }
+            d->last_type = i;
+            return &d->type[i];
+        }
+        d->type[i].key = key;
+        d->ntypes++;
+        if (key & KEY_UBX)
+            snprintf(d->type[i].name, sizeof(d->type[i].name), "UBX %02X-%02X",
+                     (unsigned)(key >> 8) & 0xFF, (unsigned)key & 0xFF);
+        else
+            memcpy(d->type[i].name, &key, 7);
+    }
+    d->last_type = i;
+    return &d->type[i];
+}
+
+/**
+ * @brief 메시지 사이 유휴 시간 중 최대 (epoch 사이 유휴 = 점유 계산용)
+ */
+static inline void note_msg(GpsDiag *d, int64_t rx_ns, int64_t end_ns)
+{
+    if (d->msg_end_ns && rx_ns - d->msg_end_ns > d->idle_max_ns)
+        d->idle_max_ns = rx_ns - d->msg_end_ns;
+    d->msg_end_ns = end_ns;
+}
+
+/**
+ * @brief 수신기 시각 태그 (ms) 와 종류 (1 UTC, 2 iTOW, 0 없음)
+ */
+static int fix_tag(const GpsFix *f, uint32_t *tag)
+{
+    if (f->valid & GPS_V_ITOW) { *tag = f->itow_ms; return 2; }
+    if (f->valid & GPS_V_TIME) { *tag = (uint32_t)f->time_ms; return 1; }
+    return 0;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+void gps_diag_init(GpsDiag *d, NmeaSentenceCb ncb, void *nuser, UbxFrameCb ucb, void *uuser)
+{
+    memset(d, 0, sizeof(GpsDiag));
+    d->ncb   = ncb;
+    d->nuser = nuser;
+    d->ucb   = ucb;
+    d->uuser = uuser;
+}
+
+void gps_diag_sentence(const NmeaSentence *s, void *diag)
+{
+    GpsDiag     *d   = diag;
+    uint64_t     key = 0;
+    size_t       n   = s->field[0].len < 7 ? s->field[0].len : 7;
+    GpsDiagType *t;
+
+    memcpy(&key, s->field[0].ptr, n);
+    t = type_slot(d, key);
+    t->count++;
+    t->bytes += s->len + NMEA_FRAME_BYTES;
+    note_msg(d, s->rx_ns, s->end_ns);
+    if (d->ncb) d->ncb(s, d->nuser);
+}
+
+void gps_diag_ubx(const UbxFrame *f, void *diag)
+{
+    GpsDiag     *d = diag;
+    GpsDiagType *t = type_slot(d, KEY_UBX | ((uint64_t)f->cls << 8) | f->id);
+
+    t->count++;
+    t->bytes += f->len + UBX_FRAME_OVERHEAD;
+    note_msg(d, f->rx_ns, f->end_ns);
+    if (d->ucb) d->ucb(f, d->uuser);
+}
+
+void gps_diag_on_fix(GpsDiag *d, const GpsFix *f)
+{
+    uint32_t tag  = 0;
+    int      kind = fix_tag(f, &tag);
+    int64_t  lat  = f->pub_ns - f->end_ns;
+
+    d->cur.epochs++;
+    if (f->end_ns && lat >= 0) {
+        d->cur.latency[bin_of(lat)]++;
+        if (lat > d->latency_max_ns) d->latency_max_ns = lat;
+    }
+
+    // 같은 시각 태그 (또는 태그 없는 조각) 는 나뉘어 발행된 직전 epoch
+    if (d->have_last && ((kind && kind == d->last_tag_kind && tag == d->last_tag) ||
+                         (!kind && d->last_tag_kind)))
+        return;
+
+    if (d->have_last && f->rx_ns && d->last_rx_ns) {
+        int64_t host_dt = f->rx_ns - d->last_rx_ns;
+        int64_t dt      = 0;
+
+        // 수신기 시각 차 (UTC 는 자정, iTOW 는 주 경계에서 되돌아감)
+        if (kind && kind == d->last_tag_kind) {
+            int64_t wrap = (kind == 2) ? 604800000LL : 86400000LL;
+            int64_t gap  = (int64_t)(d->period_ns * GPS_DIAG_GAP);
+            dt = ((int64_t)tag - d->last_tag + wrap) % wrap * 1000000LL;
+
+            // 역행, 또는 호스트 간격은 1 주기인데 시각만 건너뜀: 태그 손상
+            // (XOR 체크섬은 같은 비트 2개 뒤집힘을 못 잡음) → 추정 주기로 대신
+            if (dt > wrap / 2 * 1000000LL || (d->period_ns && dt >= gap && host_dt < gap)) {
+                d->cur.tag_errors++;
+                tag = (uint32_t)((d->last_tag + d->period_ns / 1000000) % wrap);
+                dt  = 0;
+            }
+        }
+        if (dt > 0) {
+            if (d->period_ns && dt >= d->period_ns * GPS_DIAG_GAP && dt != d->last_dt_ns)
+                d->cur.gaps += (uint64_t)((dt + d->period_ns / 2) / d->period_ns) - 1;
+            else
+                d->period_ns = dt;          // 첫 주기, 빨라짐, 같은 간격 두 번 (느려짐)
+            d->last_dt_ns = dt;
+        } else {
+            dt = d->period_ns;              // 시각 태그 없음: 추정 주기 기준
+        }
+
+        if (dt > 0) {
+            int64_t jit = host_dt - dt;
+            if (jit < 0) jit = -jit;
+            d->cur.jitter[bin_of(jit)]++;
+            if (jit > d->jitter_max_ns) d->jitter_max_ns = jit;
+        }
+
+        // 점유: 직전 epoch 이후 가장 긴 메시지 사이 유휴 (= epoch 사이 유휴) 가 주기에서 빠진 비율
+        if (d->period_ns && dt < d->period_ns * GPS_DIAG_GAP) {
+            double busy = 1.0 - (double)d->idle_max_ns / d->period_ns;
+            if (busy < 0.0) busy = 0.0;
+            if (busy > d->busy_max) d->busy_max = busy;
+        }
+    }
+
+    d->have_last     = 1;
+    d->idle_max_ns   = 0;
+    d->last_rx_ns    = f->rx_ns;
+    d->last_tag      = tag;
+    d->last_tag_kind = (uint8_t)kind;
+}
+
+int gps_diag_report(GpsDiag *d, const GpsStream *s, const GpsSerial *ser, int baud,
+                    int64_t now_ns, GpsDiagReport *r)
+{
+    GpsSerialErrors e;
+    GpsDiagCounts  *c = &d->cur, *p = &d->prev, *o = &r->d;
+    int             uart_ok = (ser && gps_serial_errors(ser, &e) == 0);
+    int             first   = !d->started;
+
+    // 스트림 / 파서 / 드라이버 누적 카운터
+    c->bytes           = s->stats.nmea_bytes + s->stats.ubx_bytes + s->stats.garbage;
+    c->garbage         = s->stats.garbage;
+    c->sentences       = s->nmea.stats.sentences;
+    c->frames          = s->ubx.stats.frames;
+    c->checksum_errors = s->nmea.stats.checksum_errors + s->ubx.stats.checksum_errors;
+    c->framing_errors  = s->nmea.stats.framing_errors;
+    c->overflows       = s->nmea.stats.overflows + s->ubx.stats.overflows;
+    c->truncated       = s->nmea.stats.truncated;
+    if (uart_ok) {
+        c->uart_frame   = e.frame;
+        c->uart_overrun = e.overrun + e.buf_overrun;
+    }
+
+    memset(r, 0, sizeof(GpsDiagReport));
+    if (!first) {
+        r->dt_s = (now_ns - d->prev_ns) / 1e9;
+        o->bytes           = c->bytes - p->bytes;
+        o->garbage         = c->garbage - p->garbage;
+        o->sentences       = c->sentences - p->sentences;
+        o->frames          = c->frames - p->frames;
+        o->checksum_errors = c->checksum_errors - p->checksum_errors;
+        o->framing_errors  = c->framing_errors - p->framing_errors;
+        o->overflows       = c->overflows - p->overflows;
+        o->truncated       = c->truncated - p->truncated;
+        o->uart_frame      = c->uart_frame - p->uart_frame;
+        o->uart_overrun    = c->uart_overrun - p->uart_overrun;
+        o->epochs          = c->epochs - p->epochs;
+        o->gaps            = c->gaps - p->gaps;
+        o->tag_errors      = c->tag_errors - p->tag_errors;
+        for (int i = 0; i < GPS_DIAG_BINS; i++) {
+            o->jitter[i]  = c->jitter[i] - p->jitter[i];
+            o->latency[i] = c->latency[i] - p->latency[i];
+        }
+
+        r->uart_ok        = uart_ok;
+        r->capacity       = baud / 10.0;                    // 8N1: 바이트당 10 bit
+        r->bytes_per_s    = r->dt_s > 0 ? o->bytes / r->dt_s : 0.0;
+        r->util           = r->capacity > 0 ? r->bytes_per_s / r->capacity : 0.0;
+        r->busy           = d->busy_max;
+        r->period_s       = d->period_ns / 1e9;
+        r->epoch_hz       = r->dt_s > 0 ? o->epochs / r->dt_s : 0.0;
+        r->jitter_max_us  = d->jitter_max_ns / 1000;
+        r->latency_max_us = d->latency_max_ns / 1000;
+        r->jitter_p50_us  = hist_quantile(o->jitter, 0.50, r->jitter_max_us);
+        r->jitter_p99_us  = hist_quantile(o->jitter, 0.99, r->jitter_max_us);
+        r->latency_p50_us = hist_quantile(o->latency, 0.50, r->latency_max_us);
+        r->latency_p99_us = hist_quantile(o->latency, 0.99, r->latency_max_us);
+        r->saturated      = (r->capacity > 0 && r->util >= GPS_DIAG_SAT_UTIL) ||
+                            r->busy >= GPS_DIAG_SAT_BUSY;
+
+    }
+
+    for (int i = 0; i < GPS_DIAG_TYPES; i++) {
+        GpsDiagType *t = &d->type[i];
+        t->icount     = first ? 0 : t->count - t->prev_count;
+        t->ibytes     = first ? 0 : t->bytes - t->prev_bytes;
+        t->prev_count = t->count;
+        t->prev_bytes = t->bytes;
+    }
+    *p                = *c;
+    d->prev_ns        = now_ns;
+    d->started        = 1;
+    d->jitter_max_ns  = 0;
+    d->latency_max_ns = 0;
+    d->busy_max       = 0.0;
+    return !first;
+}
+
+int gps_diag_types(const GpsDiag *d, const GpsDiagType **types)
+{
+    *types = d->type;
+    return (d->type[GPS_DIAG_TYPES - 1].key == ~0ULL) ? GPS_DIAG_TYPES : d->ntypes;
+}
+
+int64_t gps_diag_bin_us(int i)
+{
+    return (i < GPS_DIAG_BINS - 1) ? bin_us[i] : INT64_MAX;
+}
@@ -0,0 +1,146 @@
+#ifndef GPS_DIAG_H
+#define GPS_DIAG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "nmea.h"
+#include "ubx.h"
+
+// ─────────────────────────────────────────────
+//  GPS 링크 진단
+//
+//  GpsStream 과 문장 / 프레임 콜백 사이에 끼워 (tap) 종류별 개수 / 바이트를 세고,
+//  fix 마다 epoch 간격 지터, epoch 종료 지연, 회선 점유를 히스토그램에 누적한다.
+//  바이트 수 / 체크섬 / framing / 잘림은 스트림 / 파서 / UART 드라이버 카운터를
+//  보고 시점에 읽어 구간 증가분만 계산 → 입력 경로 추가 비용은 문장당 비교 몇 번.
+//
+//  - 지터: 호스트 수신 간격 (fix rx_ns 차) - 수신기 시각 차 (UTC / iTOW)
+//  - epoch 종료 지연: 마지막 문장 수신 → fix 발행 (gps_epoch 종료 판정)
+//  - 점유: epoch 사이 유휴 (메시지 사이 가장 긴 공백) 가 주기에서 차지하지 않는 비율.
+//    9600 baud 에서 출력이 회선 용량 (960 B/s) 을 넘으면 수신기가 문장을 버리거나
+//    다음 epoch 를 늦추므로 (u-blox 는 TX 버퍼 넘침 시 버림) 평균 사용률보다 먼저 드러남
+// ─────────────────────────────────────────────
+
+#define GPS_DIAG_TYPES      24          // 문장 / 메시지 종류 표 크기 (마지막 칸 = 기타)
+#define GPS_DIAG_BINS       14          // 히스토그램 구간 수
+#define GPS_DIAG_REPORT_S   10          // 데몬 보고 간격 (s)
+#define GPS_DIAG_SAT_UTIL   0.90        // 회선 사용률이 이 이상이면 포화
+#define GPS_DIAG_SAT_BUSY   0.95        // epoch 점유가 이 이상이면 포화
+#define GPS_DIAG_GAP        1.5         // 수신기 시각 차가 주기의 이 배 이상이면 빠진 epoch
+
+typedef struct {
+    uint64_t key;                       // NMEA: 주소 필드 (최대 7자), UBX: class / id
+    char     name[12];                  // "GPGSV", "UBX 01-07", "other"
+    uint64_t count, bytes;              // 누적 (문장 / 프레임 전체 바이트)
+    uint64_t icount, ibytes;            // 직전 보고 구간
+    uint64_t prev_count, prev_bytes;
+} GpsDiagType;
+
+// 누적 카운터 (보고는 직전 보고와의 차)
+typedef struct {
+    uint64_t bytes;                     // 스트림 입력 바이트 전체
+    uint64_t garbage;                   // 어느 프로토콜에도 속하지 않은 바이트
+    uint64_t sentences, frames;
+    uint64_t checksum_errors;           // NMEA + UBX
+    uint64_t framing_errors;            // NMEA '*hh' 누락 / 잘못된 hex / 문장 중간 '$'
+    uint64_t overflows;                 // 길이 초과 (NMEA 줄, UBX payload)
+    uint64_t truncated;                 // UBX / 비 ASCII 바이트로 끊긴 문장
+    uint64_t uart_frame;                // UART stop 비트 오류
+    uint64_t uart_overrun;              // UART FIFO / tty 버퍼 넘침
+    uint64_t epochs;
+    uint64_t gaps;                      // 빠진 epoch (수신기 시각 기준)
+    uint64_t tag_errors;                // 수신기 시각 역행 (체크섬을 통과한 손상 등)
+    uint64_t jitter[GPS_DIAG_BINS];     // |지터|
+    uint64_t latency[GPS_DIAG_BINS];    // 마지막 문장 → 발행
+} GpsDiagCounts;
+
+typedef struct {
+    double   dt_s;                      // 구간 길이
+    double   bytes_per_s;
+    double   capacity;                  // 회선 용량 (B/s, 8N1 = baud / 10, 0: 모름)
+    double   util;                      // bytes_per_s / capacity
+    double   busy;                      // 구간 최대 점유 (0 ~ 1)
+    double   period_s;                  // 수신기 출력 주기 (0: 모름)
+    double   epoch_hz;                  // 구간 평균 fix 발행률
+    int64_t  jitter_p50_us, jitter_p99_us, jitter_max_us;
+    int64_t  latency_p50_us, latency_p99_us, latency_max_us;
+    int      uart_ok;                   // UART 카운터 읽음
+    int      saturated;                 // util / busy 한도 초과 (빠진 epoch 는 손상으로도 생겨 제외)
+    GpsDiagCounts d;                    // 구간 증가분 (히스토그램 포함)
+} GpsDiagReport;
+
+// ─────────────────────────────────────────────
+//  진단 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsDiagType     type[GPS_DIAG_TYPES];
+    int             ntypes;
+    int             last_type;          // 직전 조회 (같은 문장 반복 시 바로)
+    GpsDiagCounts   cur, prev;
+    int64_t         prev_ns;            // 직전 보고 시각
+    uint8_t         started;            // 기준점 잡음
+    int64_t         jitter_max_ns, latency_max_ns;
+    double          busy_max;
+    int64_t         period_ns;          // 수신기 출력 주기 추정
+    int64_t         last_dt_ns;         // 직전 수신기 시각 차 (주기 변경 확인용)
+    int64_t         last_rx_ns;         // 직전 fix 첫 메시지 수신 시각
+    int64_t         msg_end_ns;         // 직전 메시지 끝 수신 시각
+    int64_t         idle_max_ns;        // 직전 fix 이후 메시지 사이 최대 유휴
+    uint32_t        last_tag;           // 직전 fix 수신기 시각 (ms)
+    uint8_t         last_tag_kind;      // 0 없음, 1 UTC, 2 iTOW
+    uint8_t         have_last;
+    NmeaSentenceCb  ncb;
+    void           *nuser;
+    UbxFrameCb      ucb;
+    void           *uuser;
+} GpsDiag;
+
+/**
+ * @brief 진단 초기화
+ * @param ncb/nuser 문장을 넘길 원래 콜백 (예: nmea_dispatch_sentence, &disp, NULL 가능)
+ * @param ucb/uuser 프레임을 넘길 원래 콜백 (예: gps_epoch_on_ubx, &epoch, NULL 가능)
+ *
+ * 스트림에는 원래 콜백 대신 gps_diag_sentence / gps_diag_ubx 와 이 GpsDiag 를 등록한다.
+ */
+void gps_diag_init(GpsDiag *d, NmeaSentenceCb ncb, void *nuser, UbxFrameCb ucb, void *uuser);
+
+/**
+ * @brief NmeaSentenceCb 호환 tap (종류별로 세고 원래 콜백으로)
+ */
+void gps_diag_sentence(const NmeaSentence *s, void *diag);
+
+/**
+ * @brief UbxFrameCb 호환 tap
+ */
+void gps_diag_ubx(const UbxFrame *f, void *diag);
+
+/**
+ * @brief 발행된 fix 반영 (GpsFixCb 안에서 호출)
+ */
+void gps_diag_on_fix(GpsDiag *d, const GpsFix *f);
+
+/**
+ * @brief 직전 보고 이후 구간 보고 (첫 호출은 기준점만 잡고 0)
+ * @param s    카운터를 읽을 스트림
+ * @param ser  UART 드라이버 카운터 (NULL: 파일 재생 / 시뮬레이션)
+ * @param baud 회선 보레이트 (0: 모름, 용량 / 사용률 없음)
+ * @return 1: 보고 채움, 0: 첫 호출
+ */
+int gps_diag_report(GpsDiag *d, const GpsStream *s, const GpsSerial *ser, int baud,
+                    int64_t now_ns, GpsDiagReport *r);
+
+/**
+ * @brief 종류 표 (icount / ibytes 는 직전 gps_diag_report 구간)
+ * @return 종류 수
+ */
+int gps_diag_types(const GpsDiag *d, const GpsDiagType **types);
+
+/**
+ * @brief 히스토그램 구간 i 의 상한 (µs, 마지막 구간은 INT64_MAX)
+ */
+int64_t gps_diag_bin_us(int i);
+
+#endif /* GPS_DIAG_H */
@@ -0,0 +1,453 @@
+#include "gps_epoch.h"
+
+#include <string.h>
+#include <time.h>
+
+enum {
+    TAG_UTC = 0,    // NMEA UTC ms (GGA/RMC/GLL)
+    TAG_ITOW,       // UBX NAV iTOW
+};
+
+#define GPS_LEAP_SECONDS    18              // GPS - UTC (2017-01-01 이후)
+#define GPS_UNIX_OFFSET_MS  315964800000LL  // 1980-01-06 00:00:00 UTC
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 메시지 식별값 (0 은 "없음", UBX 는 0x200 | NAV id)
+ *        GSV 는 묶음의 마지막 문장만 구분 (위성 수에 따라 개수가 변함)
+ */
+static uint16_t msg_sig(const NmeaMsg *m)
+{
+    uint16_t sig = (uint16_t)(m->type + 1);
+    if (m->type == NMEA_GSV && m->gsv.msg_num == m->gsv.total_msgs)
+        sig |= 0x100;
+    return sig;
+}
+
+/**
+ * @brief 시각 태그가 있는 문장이면 1
+ */
+static int msg_time(const NmeaMsg *m, int32_t *time_ms)
+{
+    switch (m->type) {
+        case NMEA_GGA:
+            *time_ms = m->gga.time_ms;
+            return (m->gga.valid & NMEA_V_TIME) != 0;
+        case NMEA_RMC:
+            *time_ms = m->rmc.time_ms;
+            return (m->rmc.valid & NMEA_V_TIME) != 0;
+        case NMEA_GLL:
+            *time_ms = m->gll.time_ms;
+            return (m->gll.valid & NMEA_V_TIME) != 0;
+        default:
+            return 0;
+    }
+}
+
+static void begin_epoch(GpsEpoch *e, int64_t rx_ns)
+{
+    memset(&e->fix, 0, sizeof(e->fix));
+    memset(e->has_tag, 0, sizeof(e->has_tag));
+    e->fix.rx_ns = rx_ns;
+    e->open      = 1;
+    e->ubx_fix   = 0;
+    e->ubx_bits  = 0;
+    e->last_sig  = 0;
+}
+
+static void learn_last(GpsEpoch *e)
+{
+    if (!e->learn || !e->last_sig) return;
+
+    if (e->last_sig == e->cand_sig) {
+        e->cand_hits++;
+    } else {
+        e->cand_sig  = e->last_sig;
+        e->cand_hits = 1;
+    }
+
+    if (e->cand_hits >= e->learn) {
+        e->learned_sig = e->cand_sig;
+    } else if (e->learned_sig && e->learned_sig != e->last_sig) {
+        // 확정된 순서와 다르게 끝남 → 다시 학습
+        e->learned_sig = 0;
+        e->stats.relearn++;
+    }
+}
+
+static void forget_order(GpsEpoch *e)
+{
+    if (e->learned_sig) e->stats.relearn++;
+    e->learned_sig = 0;
+    e->cand_sig    = 0;
+    e->cand_hits   = 0;
+}
+
+/**
+ * @brief 조립 중인 epoch 발행 + 종료 문장 학습
+ */
+static void publish(GpsEpoch *e, GpsEpochReason why)
+{
+    GpsFix *f = &e->fix;
+
+    // UBX 가 fix 무효라고 한 epoch 는 UBX 유래 위치/속도 버림
+    if (e->ubx_fix < 0)
+        f->valid &= ~(e->ubx_bits & (GPS_V_POS | GPS_V_ALT | GPS_V_GEOID | GPS_V_ACC |
+                                     GPS_V_SPEED | GPS_V_COURSE | GPS_V_VEL | GPS_V_SACC));
+
+    f->seq    = e->seq++;
+    f->pub_ns = e->clock();
+
+    if (f->end_ns) {
+        int64_t lat = f->pub_ns - f->end_ns;
+        e->stats.latency_sum_ns += lat;
+        if (lat > e->stats.latency_max_ns) e->stats.latency_max_ns = lat;
+    }
+    e->stats.published++;
+    e->stats.by[why]++;
+
+    memcpy(e->prev_has, e->has_tag, sizeof(e->prev_has));
+    memcpy(e->prev_tag, e->tag, sizeof(e->prev_tag));
+    e->open = 0;
+    if (why != GPS_EPOCH_BY_ORDER) learn_last(e);
+
+    if (e->cb) e->cb(f, e->user);
+}
+
+/**
+ * @brief 메시지 1개 수용 준비: timeout/태그 변경 시 이전 epoch 발행
+ * @param key 시각 태그 종류 (-1: 태그 없음)
+ * @return 0 이면 이미 발행한 epoch 의 늦은 메시지 (버림)
+ */
+static int ingest_begin(GpsEpoch *e, int key, uint32_t tag, int64_t rx_ns)
+{
+    // poll 이 호출되지 않았어도 직전 메시지 끝 → 이번 시작 간격으로 timeout 판정
+    if (e->open && e->timeout_ns && rx_ns && e->fix.end_ns &&
+        rx_ns - e->fix.end_ns >= e->timeout_ns)
+        publish(e, GPS_EPOCH_BY_TIMEOUT);
+
+    if (key >= 0 && e->open && e->has_tag[key] && tag != e->tag[key])
+        publish(e, GPS_EPOCH_BY_TIME);
+
+    // 이미 발행한 epoch 의 메시지 → 학습된 순서가 틀림
+    if (key >= 0 && e->prev_has[key] && tag == e->prev_tag[key] &&
+        !(e->open && e->has_tag[key])) {
+        e->stats.late++;
+        forget_order(e);
+        e->open = 0;        // 태그 없이 모은 메시지도 같은 epoch 잔여분
+        return 0;
+    }
+
+    if (!e->open) begin_epoch(e, rx_ns);
+
+    if (key >= 0 && !e->has_tag[key]) {
+        e->has_tag[key] = 1;
+        e->tag[key]     = tag;
+    }
+    return 1;
+}
+
+static void ingest_end(GpsEpoch *e, uint16_t sig, int64_t end_ns)
+{
+    e->fix.end_ns = end_ns;
+    e->last_sig   = sig;
+
+    if (e->learned_sig && sig == e->learned_sig)
+        publish(e, GPS_EPOCH_BY_ORDER);
+}
+
+// ─────────────────────────────────────────────
+//  문장별 병합
+//  위치: GGA > RMC > GLL, 속도/방위: RMC > VTG, HDOP: GGA > GSA
+// ─────────────────────────────────────────────
+static void merge(GpsFix *f, const NmeaMsg *m)
+{
+    switch (m->type) {
+        case NMEA_GGA: {
+            const NmeaGga *g = &m->gga;
+            if (g->valid & NMEA_V_QUALITY) { f->quality  = g->quality;  f->valid |= GPS_V_QUALITY; }
+            if (g->valid & NMEA_V_SATS)    { f->num_sats = g->num_sats; f->valid |= GPS_V_SATS; }
+            if (g->valid & NMEA_V_HDOP)    { f->hdop     = g->hdop;     f->valid |= GPS_V_HDOP; }
+            if (g->valid & NMEA_V_ALT)     { f->alt_mm   = g->alt_mm;   f->valid |= GPS_V_ALT; }
+            if (g->valid & NMEA_V_GEOID)   { f->geoid_mm = g->geoid_mm; f->valid |= GPS_V_GEOID; }
+            if (g->valid & NMEA_V_POS) {
+                f->lat = g->lat;
+                f->lon = g->lon;
+                f->valid |= GPS_V_POS;
+            }
+            break;
+        }
+        case NMEA_RMC: {
+            const NmeaRmc *r = &m->rmc;
+            if ((r->valid & NMEA_V_POS) && !(f->valid & GPS_V_POS)) {
+                f->lat = r->lat;
+                f->lon = r->lon;
+                f->valid |= GPS_V_POS;
+            }
+            if (r->valid & NMEA_V_SPEED)  { f->speed_mmps  = r->speed_mmps;  f->valid |= GPS_V_SPEED; }
+            if (r->valid & NMEA_V_COURSE) { f->course_cdeg = r->course_cdeg; f->valid |= GPS_V_COURSE; }
+            if (r->valid & NMEA_V_DATE) {
+                f->year  = r->year;
+                f->month = r->month;
+                f->day   = r->day;
+                f->valid |= GPS_V_DATE;
+            }
+            break;
+        }
+        case NMEA_VTG: {
+            const NmeaVtg *t = &m->vtg;
+            if ((t->valid & NMEA_V_SPEED) && !(f->valid & GPS_V_SPEED)) {
+                f->speed_mmps = t->speed_mmps;
+                f->valid |= GPS_V_SPEED;
+            }
+            if ((t->valid & NMEA_V_COURSE) && !(f->valid & GPS_V_COURSE)) {
+                f->course_cdeg = t->course_cdeg;
+                f->valid |= GPS_V_COURSE;
+            }
+            break;
+        }
+        case NMEA_GSA: {
+            const NmeaGsa *a = &m->gsa;
+            if (a->valid & NMEA_V_FIXTYPE) { f->fix_type = a->fix_type; f->valid |= GPS_V_FIXTYPE; }
+            if (a->valid & NMEA_V_PDOP)    { f->pdop     = a->pdop;     f->valid |= GPS_V_PDOP; }
+            if (a->valid & NMEA_V_VDOP)    { f->vdop     = a->vdop;     f->valid |= GPS_V_VDOP; }
+            if ((a->valid & NMEA_V_HDOP) && !(f->valid & GPS_V_HDOP)) {
+                f->hdop = a->hdop;
+                f->valid |= GPS_V_HDOP;
+            }
+            break;
+        }
+        case NMEA_GSV:
+            f->in_view = m->gsv.in_view;
+            f->valid |= GPS_V_INVIEW;
+            break;
+        case NMEA_GLL: {
+            const NmeaGll *l = &m->gll;
+            if ((l->valid & NMEA_V_POS) && !(f->valid & GPS_V_POS)) {
+                f->lat = l->lat;
+                f->lon = l->lon;
+                f->valid |= GPS_V_POS;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// ─────────────────────────────────────────────
+//  UBX NAV 병합
+//  NAV-PVT 는 단독으로 완결, u-blox 6 은 POSLLH + SOL + VELNED 조합
+// ─────────────────────────────────────────────
+
+/**
+ * @brief fix 종류 → GGA quality / GSA fix type 과 같은 의미로 변환
+ */
+static void set_fix_kind(GpsEpoch *e, uint8_t gps_fix, int fix_ok, int diff, int num_sv)
+{
+    GpsFix *f = &e->fix;
+    int     usable = fix_ok && gps_fix >= 1 && gps_fix <= 4;
+
+    f->quality  = !usable ? 0 : (gps_fix == 1) ? 6 : diff ? 2 : 1;
+    f->fix_type = (gps_fix == 2) ? 2 : (gps_fix == 3 || gps_fix == 4) ? 3 : 1;
+    f->num_sats = num_sv;
+    f->valid   |= GPS_V_QUALITY | GPS_V_FIXTYPE | GPS_V_SATS;
+    e->ubx_fix  = usable ? 1 : -1;
+}
+
+/**
+ * @brief GPS 주/iTOW → UTC 날짜·시각
+ */
+static void set_utc_from_gps(GpsFix *f, int week, uint32_t itow, int32_t ftow_ns)
+{
+    int64_t unix_ms = (int64_t)week * 604800000LL + itow + (ftow_ns + 500000) / 1000000
+                    + GPS_UNIX_OFFSET_MS - GPS_LEAP_SECONDS * 1000LL;
+    time_t    sec = (time_t)(unix_ms / 1000);
+    struct tm tm;
+
+    if (!gmtime_r(&sec, &tm)) return;
+    f->time_ms = (int32_t)(unix_ms % 86400000LL);
+    f->year    = (uint16_t)(tm.tm_year + 1900);
+    f->month   = (uint8_t)(tm.tm_mon + 1);
+    f->day     = (uint8_t)tm.tm_mday;
+    f->valid  |= GPS_V_TIME | GPS_V_DATE;
+}
+
+static int merge_ubx(GpsEpoch *e, const UbxFrame *fr)
+{
+    GpsFix *f = &e->fix;
+
+    switch (fr->id) {
+        case UBX_NAV_POSLLH: {
+            UbxNavPosllh p;
+            if (ubx_decode_nav_posllh(fr, &p) != 0) return -1;
+            f->lat      = p.lat;
+            f->lon      = p.lon;
+            f->alt_mm   = p.hmsl;
+            f->geoid_mm = p.height - p.hmsl;
+            f->h_acc_mm = (int32_t)p.hacc;
+            f->v_acc_mm = (int32_t)p.vacc;
+            f->valid   |= GPS_V_POS | GPS_V_ALT | GPS_V_GEOID | GPS_V_ACC;
+            return 0;
+        }
+        case UBX_NAV_SOL: {
+            UbxNavSol s;
+            if (ubx_decode_nav_sol(fr, &s) != 0) return -1;
+            set_fix_kind(e, s.gps_fix, s.flags & UBX_SOL_FIX_OK, s.flags & UBX_SOL_DIFF, s.num_sv);
+            f->pdop       = s.pdop;
+            f->s_acc_mmps = (int32_t)s.sacc * 10;
+            f->valid     |= GPS_V_PDOP | GPS_V_SACC;
+            if ((s.flags & (UBX_SOL_WKN_SET | UBX_SOL_TOW_SET)) ==
+                (UBX_SOL_WKN_SET | UBX_SOL_TOW_SET) && !(f->valid & GPS_V_TIME))
+                set_utc_from_gps(f, s.week, s.itow, s.ftow);
+            return 0;
+        }
+        case UBX_NAV_VELNED: {
+            UbxNavVelned v;
+            if (ubx_decode_nav_velned(fr, &v) != 0) return -1;
+            f->vel_n_mmps  = v.vel_n * 10;
+            f->vel_e_mmps  = v.vel_e * 10;
+            f->vel_d_mmps  = v.vel_d * 10;
+            f->speed_mmps  = (int32_t)v.gspeed * 10;
+            f->course_cdeg = v.heading / 1000;
+            f->s_acc_mmps  = (int32_t)v.sacc * 10;
+            f->valid      |= GPS_V_VEL | GPS_V_SPEED | GPS_V_COURSE | GPS_V_SACC;
+            return 0;
+        }
+        case UBX_NAV_PVT: {
+            UbxNavPvt p;
+            if (ubx_decode_nav_pvt(fr, &p) != 0) return -1;
+            set_fix_kind(e, p.fix_type, p.flags & UBX_PVT_FIX_OK, p.flags & UBX_PVT_DIFF, p.num_sv);
+            if (p.valid & UBX_PVT_VALID_TIME) {
+                int64_t ms = (int64_t)p.hour * 3600000 + p.min * 60000 + p.sec * 1000;
+                ms += (p.nano >= 0) ? p.nano / 1000000 : -((999999 - p.nano) / 1000000);
+                f->time_ms = (int32_t)((ms + 86400000) % 86400000);
+                f->valid  |= GPS_V_TIME;
+            }
+            if (p.valid & UBX_PVT_VALID_DATE) {
+                f->year   = p.year;
+                f->month  = p.month;
+                f->day    = p.day;
+                f->valid |= GPS_V_DATE;
+            }
+            f->lat         = p.lat;
+            f->lon         = p.lon;
+            f->alt_mm      = p.hmsl;
+            f->geoid_mm    = p.height - p.hmsl;
+            f->h_acc_mm    = (int32_t)p.hacc;
+            f->v_acc_mm    = (int32_t)p.vacc;
+            f->vel_n_mmps  = p.vel_n;
+            f->vel_e_mmps  = p.vel_e;
+            f->vel_d_mmps  = p.vel_d;
+            f->speed_mmps  = p.gspeed;
+            f->course_cdeg = p.head_mot / 1000;
+            f->s_acc_mmps  = (int32_t)p.sacc;
+            f->pdop        = p.pdop;
+            f->valid |= GPS_V_POS | GPS_V_ALT | GPS_V_GEOID | GPS_V_ACC | GPS_V_VEL |
+                        GPS_V_SPEED | GPS_V_COURSE | GPS_V_SACC | GPS_V_PDOP;
+            return 0;
+        }
+        default:
+            return -1;
+    }
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+void gps_epoch_init(GpsEpoch *e, GpsFixCb cb, void *user)
+{
+    memset(e, 0, sizeof(GpsEpoch));
+    e->learn      = GPS_EPOCH_LEARN;
+    e->timeout_ns = (int64_t)GPS_EPOCH_TIMEOUT_MS * 1000000;
+    e->clock      = gps_now_ns;
+    e->cb         = cb;
+    e->user       = user;
+}
+
+void gps_epoch_set_policy(GpsEpoch *e, int timeout_ms, int learn)
+{
+    e->timeout_ns = (int64_t)timeout_ms * 1000000;
+    e->learn      = learn;
+    forget_order(e);
+    e->stats.relearn = 0;
+}
+
+void gps_epoch_set_clock(GpsEpoch *e, int64_t (*clock)(void))
+{
+    e->clock = clock ? clock : gps_now_ns;
+}
+
+void gps_epoch_attach(GpsEpoch *e, NmeaDispatch *d)
+{
+    for (int t = 0; t < NMEA_TYPE_COUNT; t++)
+        nmea_dispatch_on(d, (NmeaType)t, gps_epoch_on_msg, e);
+}
+
+void gps_epoch_on_msg(const NmeaMsg *m, void *epoch)
+{
+    GpsEpoch *e = epoch;
+    int32_t   t = 0;
+    int       tagged = msg_time(m, &t);
+
+    if (!ingest_begin(e, tagged ? TAG_UTC : -1, (uint32_t)t, m->rx_ns)) return;
+
+    if (tagged && !(e->fix.valid & GPS_V_TIME)) {
+        e->fix.time_ms = t;
+        e->fix.valid  |= GPS_V_TIME;
+    }
+    merge(&e->fix, m);
+    ingest_end(e, msg_sig(m), m->end_ns);
+}
+
+void gps_epoch_on_ubx(const UbxFrame *f, void *epoch)
+{
+    GpsEpoch *e = epoch;
+    uint32_t  itow;
+
+    if (f->cls != UBX_NAV || f->len < 4) return;
+    switch (f->id) {
+        case UBX_NAV_PVT: case UBX_NAV_POSLLH: case UBX_NAV_SOL: case UBX_NAV_VELNED:
+            break;
+        default:
+            return;
+    }
+
+    itow = ubx_u4(f->payload);      // 모든 NAV 메시지의 첫 필드
+    if (!ingest_begin(e, TAG_ITOW, itow, f->rx_ns)) return;
+
+    uint32_t before = e->fix.valid;
+    if (merge_ubx(e, f) == 0) {
+        e->fix.itow_ms = itow;
+        e->fix.valid  |= GPS_V_ITOW;
+    }
+    e->ubx_bits |= e->fix.valid & ~before;
+    ingest_end(e, (uint16_t)(0x200 | f->id), f->end_ns);
+}
+
+int gps_epoch_poll(GpsEpoch *e, int64_t last_rx_ns, int64_t now_ns)
+{
+    if (!e->open || !e->timeout_ns || !e->fix.end_ns) return 0;
+    if (last_rx_ns < e->fix.end_ns) last_rx_ns = e->fix.end_ns;
+    if (now_ns - last_rx_ns < e->timeout_ns) return 0;
+
+    publish(e, GPS_EPOCH_BY_TIMEOUT);
+    return 1;
+}
+
+void gps_epoch_flush(GpsEpoch *e)
+{
+    if (e->open) publish(e, GPS_EPOCH_BY_TIMEOUT);
+}
+
+const char *gps_epoch_reason_name(GpsEpochReason r)
+{
+    static const char *names[GPS_EPOCH_REASON_COUNT] = {
+        "order", "timeout", "time",
+    };
+    return (r < GPS_EPOCH_REASON_COUNT) ? names[r] : "?";
+}
@@ -0,0 +1,125 @@
+#ifndef GPS_EPOCH_H
+#define GPS_EPOCH_H
+
+#include <stdint.h>
+#include "gps_fix.h"
+#include "nmea_msg.h"
+#include "ubx.h"
+
+// ─────────────────────────────────────────────
+//  NMEA / UBX epoch 조립기
+//
+//  같은 시각 태그 (NMEA: GGA/RMC/GLL 의 UTC, UBX: NAV iTOW) 의 메시지와
+//  그 사이의 태그 없는 VTG/GSA/GSV 를 모아 epoch 마다 GpsFix 1개를 발행한다.
+//
+//  epoch 종료 판정 (먼저 성립하는 것)
+//    1. 학습된 마지막 메시지 도착 → 즉시 발행 (지연 ≈ 디코딩 시간)
+//    2. 마지막 메시지 이후 timeout 동안 무수신 (gps_epoch_poll)
+//    3. 다음 epoch 의 시각 태그 도착 (최악: 1 주기)
+//
+//  마지막 메시지는 2·3 으로 닫힌 epoch 의 끝 메시지가 learn 회 연속
+//  같으면 확정, 확정 후 같은 epoch 메시지가 늦게 오면 학습을 버린다.
+// ─────────────────────────────────────────────
+
+#define GPS_EPOCH_TIMEOUT_MS    50      // 9600 baud 에서 문장 간 간격은 수 ms 이하
+#define GPS_EPOCH_LEARN         2       // 순서 확정에 필요한 연속 epoch 수
+#define GPS_EPOCH_TAGS          2       // 시각 태그 종류 (UTC, iTOW)
+
+typedef enum {
+    GPS_EPOCH_BY_ORDER = 0,     // 학습된 마지막 메시지
+    GPS_EPOCH_BY_TIMEOUT,       // 무수신 timeout
+    GPS_EPOCH_BY_TIME,          // 다음 epoch 시각 태그
+    GPS_EPOCH_REASON_COUNT
+} GpsEpochReason;
+
+typedef struct {
+    uint64_t published;                         // 발행한 fix 수
+    uint64_t by[GPS_EPOCH_REASON_COUNT];        // 종료 판정별 발행 수
+    uint64_t late;                              // 발행 후 도착한 같은 epoch 메시지
+    uint64_t relearn;                           // 학습 무효화 횟수
+    int64_t  latency_sum_ns;                    // 마지막 메시지 수신 → 발행
+    int64_t  latency_max_ns;
+} GpsEpochStats;
+
+// ─────────────────────────────────────────────
+//  조립기 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsFix          fix;                        // 조립 중인 epoch
+    uint8_t         open;                       // 조립 중인 epoch 있음
+    uint8_t         has_tag[GPS_EPOCH_TAGS];    // 시각 태그 받음
+    uint8_t         prev_has[GPS_EPOCH_TAGS];
+    int8_t          ubx_fix;                    // UBX fix 상태 (0 모름, 1 유효, -1 무효)
+    uint32_t        tag[GPS_EPOCH_TAGS];
+    uint32_t        prev_tag[GPS_EPOCH_TAGS];   // 직전 발행 epoch 태그
+    uint32_t        ubx_bits;                   // UBX 가 채운 GPS_V_* 비트
+    uint16_t        last_sig;                   // 이번 epoch 마지막 메시지
+    uint16_t        learned_sig;                // 확정된 마지막 메시지 (0: 미확정)
+    uint16_t        cand_sig;                   // 학습 중인 후보
+    int             cand_hits;
+    int             learn;                      // 0 이면 순서 학습 끔
+    int64_t         timeout_ns;                 // 0 이면 timeout 판정 끔
+    int64_t       (*clock)(void);               // 발행 시각용 시계
+    uint32_t        seq;
+    GpsEpochStats   stats;
+    GpsFixCb        cb;
+    void           *user;
+} GpsEpoch;
+
+/**
+ * @brief 조립기 초기화 (timeout GPS_EPOCH_TIMEOUT_MS, 학습 GPS_EPOCH_LEARN)
+ * @param cb   epoch 마다 호출될 콜백
+ * @param user 콜백에 그대로 전달될 포인터
+ */
+void gps_epoch_init(GpsEpoch *e, GpsFixCb cb, void *user);
+
+/**
+ * @brief 종료 판정 정책 변경
+ * @param timeout_ms 무수신 timeout (0: 끔)
+ * @param learn      순서 확정에 필요한 연속 epoch 수 (0: 학습 끔)
+ */
+void gps_epoch_set_policy(GpsEpoch *e, int timeout_ms, int learn);
+
+/**
+ * @brief 발행 시각용 시계 교체 (기본 gps_now_ns, 재생/시뮬레이션용)
+ */
+void gps_epoch_set_clock(GpsEpoch *e, int64_t (*clock)(void));
+
+/**
+ * @brief GGA/RMC/VTG/GSA/GSV/GLL 콜백을 디스패치 테이블에 등록
+ */
+void gps_epoch_attach(GpsEpoch *e, NmeaDispatch *d);
+
+/**
+ * @brief NmeaMsgCb 호환 입력 (직접 등록할 때)
+ */
+void gps_epoch_on_msg(const NmeaMsg *m, void *epoch);
+
+/**
+ * @brief UbxFrameCb 호환 입력 (NAV-PVT/POSLLH/SOL/VELNED, 그 외 무시)
+ */
+void gps_epoch_on_ubx(const UbxFrame *f, void *epoch);
+
+/**
+ * @brief timeout 판정 (read() 대기 후 등 주기적으로 호출)
+ *
+ * 메시지 단위가 아니라 바이트 단위 무수신으로 판정한다.
+ * (9600 baud 에서 문장 1개 수신에 70ms 이상 걸림)
+ *
+ * @param last_rx_ns 마지막 바이트 수신 시각 (메시지 rx_ns 와 같은 시계)
+ * @param now_ns     현재 시각
+ * @return fix 를 발행했으면 1
+ */
+int gps_epoch_poll(GpsEpoch *e, int64_t last_rx_ns, int64_t now_ns);
+
+/**
+ * @brief 조립 중인 epoch 를 즉시 발행 (입력 종료 시)
+ */
+void gps_epoch_flush(GpsEpoch *e);
+
+/**
+ * @brief 종료 판정 이름 ("order" 등)
+ */
+const char *gps_epoch_reason_name(GpsEpochReason r);
+
+#endif /* GPS_EPOCH_H */
@@ -0,0 +1,164 @@
+// 지오펜스 감시
+//
+// 다각형 파일 (geo_fence_load 형식) 을 읽어 색인을 만들고, fix 마다 현재 위치가 들어 있는
+// 구역, 허용 / 금지 판정, 가장 가까운 경계까지 거리와 진입 / 이탈 이벤트를 출력한다.
+//
+// 실행: ./gps_fence [-b baud] [-c cell_m] [-q] -f fences.txt [dev]
+//         -c  격자 칸 크기 (기본: 변 수에 맞춰 자동)
+//         -q  이벤트와 허용 / 금지 상태가 바뀐 fix 만 출력
+//
+//   fences.txt:
+//     allow yard
+//     37.56650,126.97800
+//     37.56650,126.97900
+//     37.56730,126.97900
+//     keepout pond
+//     ...
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "geo_fence.h"
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+
+typedef struct {
+    GeoFence      fence;
+    GeoFenceTrack track;
+    int           quiet;
+    int           last_ok;          // -1: 아직 없음
+    uint64_t      fixes, violations;
+} Fence;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static void on_event(GeoFenceEvent ev, uint32_t poly, const GeoFenceResult *r, void *user)
+{
+    Fence              *fc = user;
+    const GeoFencePoly *p  = &fc->fence.poly[poly];
+
+    printf("  %s %s %s\n", ev == GEO_FENCE_ENTER ? "ENTER" : "EXIT ",
+           p->kind == GEO_FENCE_KEEPOUT ? "keepout" : "allow", p->name);
+    (void)r;
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Fence          *fc = user;
+    GeoFenceResult  r;
+    double          lat, lon;
+
+    if (!(f->valid & GPS_V_POS)) return;
+    lat = nmea_e7_to_deg(f->lat);
+    lon = nmea_e7_to_deg(f->lon);
+    geo_fence_query(&fc->fence, lat, lon, &r);
+    fc->fixes++;
+    if (!r.ok) fc->violations++;
+
+    int changed = (r.ok != fc->last_ok);
+    fc->last_ok = r.ok;
+    if (!fc->quiet || changed || r.nhit != fc->track.nin ||
+        memcmp(r.hit, fc->track.in, r.nhit * sizeof(uint32_t)) != 0) {
+        printf("%02d:%02d:%02d.%03d  %.7f, %.7f  %s  in %zu",
+               f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60,
+               f->time_ms % 1000, lat, lon, r.ok ? "OK       " : "VIOLATION", r.nhit);
+        if (r.nearest >= 0)
+            printf("  nearest %s %.1f m", fc->fence.poly[r.nearest].name, r.dist);
+        printf("\n");
+    }
+    geo_fence_track_update(&fc->track, &r);
+}
+
+int main(int argc, char **argv)
+{
+    int         baud = GPS_SERIAL_BAUD, bad_line, opt;
+    double      cell = 0.0;
+    const char *path = NULL;
+    Fence       fc = { .last_ok = -1 };
+
+    while ((opt = getopt(argc, argv, "b:c:qf:")) != -1) {
+        switch (opt) {
+            case 'b': baud     = atoi(optarg); break;
+            case 'c': cell     = atof(optarg); break;
+            case 'q': fc.quiet = 1;            break;
+            case 'f': path     = optarg;       break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-c cell_m] [-q] -f fences.txt [dev]\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [-b baud] [-c cell_m] [-q] -f fences.txt [dev]\n", argv[0]);
+        return 1;
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    geo_fence_init(&fc.fence);
+    int n = geo_fence_load(&fc.fence, path, &bad_line);
+    if (n < 0) {
+        if (bad_line) fprintf(stderr, "%s:%d: bad line\n", path, bad_line);
+        else          perror(path);
+        return 1;
+    }
+    int64_t t0 = gps_now_ns();
+    if (geo_fence_build(&fc.fence, cell) < 0) {
+        perror("geo_fence_build");
+        return 1;
+    }
+    printf("%s: %d polygons, %zu edges, index %.1f KB built in %.1f ms\n", path, n,
+           fc.fence.nvert, geo_fence_index_memory(&fc.fence) / 1024.0,
+           (gps_now_ns() - t0) / 1e6);
+    geo_fence_track_init(&fc.track, on_event, &fc);
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        geo_fence_free(&fc.fence);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &fc);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    while (!stop) {
+        int64_t rx_ns;
+        int r = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (r < 0) {
+            if (stop) break;
+            perror("GPS read");
+            break;
+        }
+        if (r > 0) gps_stream_feed(&stream, buf, r, rx_ns);
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
+        fflush(stdout);
+    }
+    gps_epoch_flush(&epoch);
+
+    printf("fixes %llu, violations %llu, enters %llu, exits %llu\n",
+           (unsigned long long)fc.fixes, (unsigned long long)fc.violations,
+           (unsigned long long)fc.track.enters, (unsigned long long)fc.track.exits);
+    gps_serial_close(&ser);
+    geo_fence_free(&fc.fence);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#ifndef GPS_FIX_H
+#define GPS_FIX_H
+
+#include <stdint.h>
+#include <time.h>
+
+// ─────────────────────────────────────────────
+//  epoch 단위 GPS fix 레코드
+//
+//  NMEA 와 UBX 입력 (gps_epoch) 이 공통으로 발행하는 형식
+//  단위는 nmea_msg.h 와 동일한 정수 고정소수점
+//    좌표 1e-7 도, DOP ×100, 속도 mm/s, 방위 ×100 도, 고도 mm
+// ─────────────────────────────────────────────
+
+// ─────────────────────────────────────────────
+//  필드 유효 비트 (해당 epoch 에서 값을 받지 못했으면 0)
+// ─────────────────────────────────────────────
+enum {
+    GPS_V_TIME      = 1u << 0,
+    GPS_V_DATE      = 1u << 1,
+    GPS_V_POS       = 1u << 2,      // 위도/경도
+    GPS_V_ALT       = 1u << 3,      // 해발 고도
+    GPS_V_GEOID     = 1u << 4,
+    GPS_V_QUALITY   = 1u << 5,      // GGA fix quality
+    GPS_V_FIXTYPE   = 1u << 6,      // 2D/3D
+    GPS_V_SATS      = 1u << 7,      // 사용 위성 수
+    GPS_V_INVIEW    = 1u << 8,      // 가시 위성 수
+    GPS_V_HDOP      = 1u << 9,
+    GPS_V_PDOP      = 1u << 10,
+    GPS_V_VDOP      = 1u << 11,
+    GPS_V_SPEED     = 1u << 12,
+    GPS_V_COURSE    = 1u << 13,
+    GPS_V_ITOW      = 1u << 14,     // GPS time of week (UBX)
+    GPS_V_ACC       = 1u << 15,     // 수평/수직 정확도 추정 (UBX)
+    GPS_V_VEL       = 1u << 16,     // NED 속도 (UBX)
+    GPS_V_SACC      = 1u << 17,     // 속도 정확도 추정 (UBX)
+};
+
+typedef struct {
+    uint32_t valid;             // GPS_V_* 비트
+    uint32_t seq;               // 발행 순번
+
+    int64_t  rx_ns;             // epoch 첫 문장 수신 시각 (CLOCK_MONOTONIC)
+    int64_t  end_ns;            // epoch 마지막 문장 수신 시각
+    int64_t  pub_ns;            // fix 발행 시각
+
+    int32_t  time_ms;           // UTC 자정 이후 ms
+    uint16_t year;
+    uint8_t  month, day;
+
+    int32_t  lat, lon;          // 1e-7 도
+    int32_t  alt_mm;            // 해발 고도
+    int32_t  geoid_mm;
+
+    int32_t  quality;           // 0=no fix, 1=GPS, 2=DGPS, 6=추정
+    int32_t  fix_type;          // 1=없음, 2=2D, 3=3D
+    int32_t  num_sats;
+    int32_t  in_view;
+    int32_t  hdop, pdop, vdop;  // ×100
+
+    int32_t  speed_mmps;
+    int32_t  course_cdeg;
+
+    uint32_t itow_ms;           // GPS 주 시작 이후 ms
+    int32_t  h_acc_mm, v_acc_mm;
+    int32_t  vel_n_mmps, vel_e_mmps, vel_d_mmps;
+    int32_t  s_acc_mmps;
+} GpsFix;
+
+typedef void (*GpsFixCb)(const GpsFix *fix, void *user);
+
+/**
+ * @brief CLOCK_MONOTONIC 현재 시각 (ns)
+ */
+static inline int64_t gps_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif /* GPS_FIX_H */
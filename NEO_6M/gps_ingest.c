@@ -0,0 +1,349 @@
+#include "gps_ingest.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gps_epoch.h"
+#include "nmea_msg.h"
+
+#define START_STEP      4096        // epoch 경계 탐색 단위 (바이트)
+#define MAX_THREADS     64
+
+_Static_assert(sizeof(GpsColsHeader) == 24, "column file header layout");
+_Static_assert(sizeof(GpsColsEntry) == 24, "column directory layout");
+
+static const char *const col_names[GPS_COL_COUNT] = {
+    [GPS_COL_VALID]   = "valid",
+    [GPS_COL_DATE]    = "date",
+    [GPS_COL_TIME]    = "time_ms",
+    [GPS_COL_LAT]     = "lat",
+    [GPS_COL_LON]     = "lon",
+    [GPS_COL_ALT]     = "alt_mm",
+    [GPS_COL_HDOP]    = "hdop",
+    [GPS_COL_SATS]    = "sats",
+    [GPS_COL_QUALITY] = "quality",
+    [GPS_COL_SPEED]   = "speed",
+    [GPS_COL_COURSE]  = "course",
+};
+
+// ─────────────────────────────────────────────
+//  열 표
+// ─────────────────────────────────────────────
+
+static int cols_reserve(GpsCols *t, size_t cap)
+{
+    if (cap <= t->cap) return 0;
+    for (int c = 0; c < GPS_COL_COUNT; c++) {
+        int32_t *p = realloc(t->col[c], cap * sizeof(int32_t));
+        if (!p) return -1;          // 이미 늘린 열은 그대로 (cap 은 갱신 안 함)
+        t->col[c] = p;
+    }
+    t->cap = cap;
+    return 0;
+}
+
+int gps_cols_init(GpsCols *t, size_t cap)
+{
+    memset(t, 0, sizeof(GpsCols));
+    if (cols_reserve(t, cap) < 0) {
+        gps_cols_free(t);
+        return -1;
+    }
+    return 0;
+}
+
+int gps_cols_push(GpsCols *t, const GpsFix *f)
+{
+    size_t r = t->rows;
+
+    if (r == t->cap && cols_reserve(t, t->cap ? t->cap * 2 : 1024) < 0) return -1;
+
+    t->col[GPS_COL_VALID][r]   = (int32_t)f->valid;
+    t->col[GPS_COL_DATE][r]    = (f->valid & GPS_V_DATE)
+                                 ? f->year * 10000 + f->month * 100 + f->day : 0;
+    t->col[GPS_COL_TIME][r]    = f->time_ms;
+    t->col[GPS_COL_LAT][r]     = f->lat;
+    t->col[GPS_COL_LON][r]     = f->lon;
+    t->col[GPS_COL_ALT][r]     = f->alt_mm;
+    t->col[GPS_COL_HDOP][r]    = f->hdop;
+    t->col[GPS_COL_SATS][r]    = f->num_sats;
+    t->col[GPS_COL_QUALITY][r] = f->quality;
+    t->col[GPS_COL_SPEED][r]   = f->speed_mmps;
+    t->col[GPS_COL_COURSE][r]  = f->course_cdeg;
+    t->rows = r + 1;
+    return 0;
+}
+
+const char *gps_cols_name(int col)
+{
+    return (col >= 0 && col < GPS_COL_COUNT) ? col_names[col] : "?";
+}
+
+int gps_cols_write(const GpsCols *t, const char *path)
+{
+    GpsColsHeader h = { .magic = GPS_COLS_MAGIC, .version = GPS_COLS_VERSION,
+                        .cols = GPS_COL_COUNT, .rows = t->rows };
+    GpsColsEntry  dir[GPS_COL_COUNT];
+    uint64_t      off = sizeof(h) + sizeof(dir);
+    size_t        bytes = t->rows * sizeof(int32_t);
+    static const uint8_t pad[8];
+    FILE         *fp = fopen(path, "wb");
+
+    if (!fp) return -1;
+
+    memset(dir, 0, sizeof(dir));
+    for (int c = 0; c < GPS_COL_COUNT; c++) {
+        strncpy(dir[c].name, col_names[c], sizeof(dir[c].name));
+        dir[c].elem_size = sizeof(int32_t);
+        dir[c].offset    = off;
+        off += (bytes + 7) & ~(uint64_t)7;
+    }
+
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1 && fwrite(dir, sizeof(dir), 1, fp) == 1;
+    for (int c = 0; ok && c < GPS_COL_COUNT; c++) {
+        ok = (bytes == 0 || fwrite(t->col[c], bytes, 1, fp) == 1) &&
+             fwrite(pad, 1, (8 - bytes % 8) % 8, fp) == (8 - bytes % 8) % 8;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+void gps_cols_free(GpsCols *t)
+{
+    for (int c = 0; c < GPS_COL_COUNT; c++)
+        free(t->col[c]);
+    memset(t, 0, sizeof(GpsCols));
+}
+
+// ─────────────────────────────────────────────
+//  epoch 경계 탐색
+// ─────────────────────────────────────────────
+typedef struct {
+    const char *data;
+    int         have;           // 첫 태그 받음
+    int32_t     first;
+    size_t      start;          // 두 번째 태그 문장의 '$' (SIZE_MAX: 아직 없음)
+} StartScan;
+
+/**
+ * @brief 시각 태그 (GGA/RMC/GLL 의 UTC) 추출, gps_epoch 과 같은 규칙
+ */
+static int sentence_time(const NmeaSentence *s, int32_t *time_ms)
+{
+    NmeaMsg m;
+
+    switch (nmea_sentence_type(s, NULL)) {
+        case NMEA_GGA: case NMEA_RMC: case NMEA_GLL: break;
+        default: return 0;
+    }
+    nmea_decode(s, &m);
+    switch (m.type) {
+        case NMEA_GGA: *time_ms = m.gga.time_ms; return (m.gga.valid & NMEA_V_TIME) != 0;
+        case NMEA_RMC: *time_ms = m.rmc.time_ms; return (m.rmc.valid & NMEA_V_TIME) != 0;
+        default:       *time_ms = m.gll.time_ms; return (m.gll.valid & NMEA_V_TIME) != 0;
+    }
+}
+
+static void start_on_sentence(const NmeaSentence *s, void *user)
+{
+    StartScan *ss = user;
+    int32_t    t;
+
+    if (ss->start != SIZE_MAX || !sentence_time(s, &t)) return;
+    if (!ss->have) {
+        ss->have  = 1;
+        ss->first = t;
+    } else if (t != ss->first) {
+        ss->start = (size_t)(s->body - 1 - ss->data);
+    }
+}
+
+/**
+ * @brief from 이후 처음으로 새 epoch 가 시작되는 문장 위치 (없으면 n)
+ *
+ * from 직후의 첫 태그는 앞 epoch 에 속할 수 있으므로 태그가 한 번 바뀌는 곳을 찾는다.
+ */
+static size_t epoch_start(const char *data, size_t n, size_t from)
+{
+    StartScan  ss = { .data = data, .start = SIZE_MAX };
+    NmeaParser p;
+
+    nmea_parser_init(&p, start_on_sentence, &ss);
+    while (ss.start == SIZE_MAX && from < n) {
+        size_t step = (n - from < START_STEP) ? n - from : START_STEP;
+        nmea_parser_scan(&p, data + from, n - from, step);
+        from += step;
+    }
+    return (ss.start == SIZE_MAX) ? n : ss.start;
+}
+
+// ─────────────────────────────────────────────
+//  스레드별 처리
+// ─────────────────────────────────────────────
+typedef struct {
+    const char   *data;
+    size_t        n;
+    size_t        from;         // 균등 분할 위치
+    size_t        lo, hi;       // 담당 구간 (epoch 경계)
+    NmeaParser    parser;
+    NmeaDispatch  disp;
+    GpsEpoch      ep;
+    GpsCols       cols;
+    int           failed;
+} Worker;
+
+static int64_t zero_clock(void)
+{
+    return 0;
+}
+
+static void worker_on_fix(const GpsFix *f, void *user)
+{
+    Worker *w = user;
+
+    if (gps_cols_push(&w->cols, f) < 0) w->failed = 1;
+}
+
+static void *worker_find_start(void *arg)
+{
+    Worker *w = arg;
+
+    w->lo = w->from ? epoch_start(w->data, w->n, w->from) : 0;
+    return NULL;
+}
+
+static void *worker_run(void *arg)
+{
+    Worker *w = arg;
+
+    gps_epoch_init(&w->ep, worker_on_fix, w);
+    gps_epoch_set_policy(&w->ep, 0, 0);
+    gps_epoch_set_clock(&w->ep, zero_clock);
+    nmea_dispatch_init(&w->disp);
+    gps_epoch_attach(&w->ep, &w->disp);
+    nmea_parser_init(&w->parser, nmea_dispatch_sentence, &w->disp);
+
+    // 대략 fix 1개 / 500 바이트
+    if (gps_cols_init(&w->cols, (w->hi - w->lo) / 500 + 16) < 0) {
+        w->failed = 1;
+        return NULL;
+    }
+    if (w->hi > w->lo)
+        nmea_parser_scan(&w->parser, w->data + w->lo, w->n - w->lo, w->hi - w->lo);
+    gps_epoch_flush(&w->ep);
+    return NULL;
+}
+
+/**
+ * @brief 스레드마다 fn 실행 (생성 실패한 몫은 호출 스레드가 처리)
+ */
+static void run_all(Worker *w, int count, void *(*fn)(void *))
+{
+    pthread_t tid[MAX_THREADS];
+    int       started[MAX_THREADS];
+
+    for (int i = 1; i < count; i++)
+        started[i] = pthread_create(&tid[i], NULL, fn, &w[i]) == 0;
+    fn(&w[0]);
+    for (int i = 1; i < count; i++) {
+        if (started[i]) pthread_join(tid[i], NULL);
+        else            fn(&w[i]);
+    }
+}
+
+static void add_stats(NmeaStats *d, const NmeaStats *s)
+{
+    d->bytes           += s->bytes;
+    d->sentences       += s->sentences;
+    d->checksum_errors += s->checksum_errors;
+    d->framing_errors  += s->framing_errors;
+    d->overflows       += s->overflows;
+}
+
+/**
+ * @brief 빈 날짜를 앞 행으로 채우고 시각 역행 검사
+ */
+static void fill_dates(GpsCols *t, size_t from, GpsIngestStats *st)
+{
+    int32_t *valid = t->col[GPS_COL_VALID], *date = t->col[GPS_COL_DATE];
+    int32_t *time  = t->col[GPS_COL_TIME];
+    int32_t  last_date = from ? date[from - 1] : 0;
+    int64_t  last_key  = INT64_MIN;
+
+    for (size_t r = from; r < t->rows; r++) {
+        if (date[r]) last_date = date[r];
+        else if (last_date) date[r] = last_date;
+        else st->undated++;
+
+        if (!(valid[r] & GPS_V_TIME)) continue;
+        int64_t key = (int64_t)date[r] * 100000000LL + time[r];    // yyyymmdd|ms
+        if (key < last_key) st->backwards++;
+        last_key = key;
+    }
+}
+
+int gps_ingest(const char *data, size_t n, int threads, GpsCols *out, GpsIngestStats *st)
+{
+    Worker *w;
+    size_t  rows = 0;
+    int     rc = 0;
+
+    memset(st, 0, sizeof(GpsIngestStats));
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    // 스레드당 최소 1 MB (작은 파일은 나누는 비용이 더 큼)
+    if ((size_t)threads > n / (1 << 20) + 1) threads = (int)(n / (1 << 20) + 1);
+
+    w = calloc((size_t)threads, sizeof(Worker));
+    if (!w) return -1;
+    for (int i = 0; i < threads; i++) {
+        w[i].data = data;
+        w[i].n    = n;
+        w[i].from = n / (size_t)threads * (size_t)i;
+    }
+
+    // 1. 나눈 위치마다 epoch 경계 찾기
+    run_all(w, threads, worker_find_start);
+    for (int i = 1; i < threads; i++)
+        if (w[i].lo < w[i - 1].lo) w[i].lo = w[i - 1].lo;
+    for (int i = 0; i < threads; i++)
+        w[i].hi = (i + 1 < threads) ? w[i + 1].lo : n;
+
+    // 2. 구간별 파싱 + 조립
+    run_all(w, threads, worker_run);
+
+    // 3. 파일 순서대로 이어 붙이기
+    for (int i = 0; i < threads; i++) {
+        if (w[i].failed) rc = -1;
+        rows += w[i].cols.rows;
+    }
+    if (rc == 0 && cols_reserve(out, out->rows + rows) < 0) rc = -1;
+    if (rc == 0) {
+        size_t first = out->rows;
+        for (int i = 0; i < threads; i++) {
+            for (int c = 0; c < GPS_COL_COUNT; c++)
+                memcpy(out->col[c] + out->rows, w[i].cols.col[c],
+                       w[i].cols.rows * sizeof(int32_t));
+            out->rows += w[i].cols.rows;
+
+            add_stats(&st->parse, &w[i].parser.stats);
+            st->unknown += w[i].disp.unknown;
+        }
+        fill_dates(out, first, st);
+        for (size_t r = first; r < out->rows; r++)
+            if (out->col[GPS_COL_VALID][r] & GPS_V_POS) st->with_pos++;
+        st->fixes   = rows;
+        st->threads = threads;
+    }
+
+    for (int i = 0; i < threads; i++)
+        gps_cols_free(&w[i].cols);
+    free(w);
+    if (rc < 0) errno = ENOMEM;
+    return rc;
+}
@@ -0,0 +1,106 @@
+#ifndef GPS_INGEST_H
+#define GPS_INGEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+#include "nmea.h"
+
+// ─────────────────────────────────────────────
+//  대용량 NMEA 기록 일괄 처리 (오프라인)
+//
+//  mmap 한 캡처 전체를 스레드 수만큼 나눠 검증 / 디코딩 / epoch 조립하고
+//  결과를 파일 순서 (= 수신 순서) 대로 이어 붙인 열 (columnar) fix 표로 만든다.
+//
+//  - 나누는 위치는 epoch 경계: 나눈 지점 이후 두 번째 UTC 태그가 바뀌는 문장
+//    (그 앞의 태그 없는 VTG/GSA/GSV 는 이전 epoch 잔여분이므로 앞 스레드 몫)
+//  - 조립기는 학습 / timeout 없이 UTC 태그 변경으로만 닫는다 (수신 시각 없음)
+//    → 스레드 수와 관계없이 한 번에 처리한 것과 같은 fix 가 나온다
+//  - UBX 바이너리는 처리하지 않는다 (NMEA 캡처 전용)
+// ─────────────────────────────────────────────
+
+// 열 (모두 int32, 단위는 GpsFix 와 같음)
+enum {
+    GPS_COL_VALID = 0,      // GPS_V_* 비트
+    GPS_COL_DATE,           // yyyymmdd (0: 모름, 병합 시 앞 행 날짜로 채움)
+    GPS_COL_TIME,           // UTC 자정 이후 ms
+    GPS_COL_LAT,            // 1e-7 도
+    GPS_COL_LON,
+    GPS_COL_ALT,            // mm
+    GPS_COL_HDOP,           // ×100
+    GPS_COL_SATS,
+    GPS_COL_QUALITY,
+    GPS_COL_SPEED,          // mm/s
+    GPS_COL_COURSE,         // ×100 도
+    GPS_COL_COUNT
+};
+
+typedef struct {
+    int32_t *col[GPS_COL_COUNT];
+    size_t   rows, cap;
+} GpsCols;
+
+#define GPS_COLS_MAGIC      "NEO6COL"           // 파일 magic (8B, NUL 포함)
+#define GPS_COLS_VERSION    1
+
+// 열 파일 = 헤더 + 열 목록 + 열 배열 (8B 정렬, 기록한 기계의 바이트 순서)
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t cols;
+    uint64_t rows;
+} GpsColsHeader;
+
+typedef struct {
+    char     name[8];
+    uint32_t elem_size;     // 4 (int32)
+    uint32_t reserved;
+    uint64_t offset;        // 배열 파일 위치
+} GpsColsEntry;
+
+/**
+ * @brief 빈 표 (cap 행 미리 할당, 0 가능)
+ * @return 0: 성공, -1: 메모리 부족
+ */
+int gps_cols_init(GpsCols *t, size_t cap);
+
+/**
+ * @brief fix 1개를 행으로 추가
+ * @return 0: 성공, -1: 메모리 부족
+ */
+int gps_cols_push(GpsCols *t, const GpsFix *f);
+
+/**
+ * @brief 열 이름 ("lat" 등)
+ */
+const char *gps_cols_name(int col);
+
+/**
+ * @brief 열 파일 기록
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_cols_write(const GpsCols *t, const char *path);
+
+void gps_cols_free(GpsCols *t);
+
+// ─────────────────────────────────────────────
+//  병렬 처리
+// ─────────────────────────────────────────────
+typedef struct {
+    NmeaStats parse;        // 모든 스레드 합
+    uint64_t  unknown;      // 미지원 문장
+    uint64_t  fixes;
+    uint64_t  with_pos;
+    uint64_t  undated;      // 첫 RMC 이전이라 날짜를 채우지 못한 행
+    uint64_t  backwards;    // 앞 행보다 이른 날짜 / 시각
+    int       threads;      // 실제 사용한 스레드 수
+} GpsIngestStats;
+
+/**
+ * @brief data[0, n) 의 NMEA 를 threads 개 스레드로 처리해 out 에 추가
+ * @param threads 0 이면 온라인 CPU 수
+ * @return 0: 성공, -1: 메모리 부족 (out 은 그대로)
+ */
+int gps_ingest(const char *data, size_t n, int threads, GpsCols *out, GpsIngestStats *st);
+
+#endif /* GPS_INGEST_H */
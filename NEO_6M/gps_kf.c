@@ -0,0 +1,290 @@
+#include "gps_kf.h"
+
+#include <math.h>
+#include <string.h>
+
+#define INIT_VEL_SIGMA  10.0    // 첫 fix 의 속도 σ (m/s, 모름)
+#define STILL_SPEED     0.1     // 방위 없는 속력이 이보다 작으면 정지로 관측
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static void reset(GpsKf *k, double lat, double lon, double sigma)
+{
+    geo_ltp_init(&k->ltp, lat, lon, 0.0);
+    memset(k->x, 0, sizeof(k->x));
+    memset(k->P, 0, sizeof(k->P));
+    k->P[0][0] = k->P[1][1] = sigma * sigma;
+    k->P[2][2] = k->P[3][3] = INIT_VEL_SIGMA * INIT_VEL_SIGMA;
+    k->init       = 1;
+    k->reject_run = 0;
+    k->restored   = 0;
+    k->stats.resets++;
+}
+
+/**
+ * @brief 상태 i0, i0+1 을 직접 관측하는 2차원 갱신 (H = 선택 행렬)
+ * @param R    측정 공분산 (R[0][1] = R[1][0])
+ * @param gate χ² 한계 (초과 시 반영 안 함)
+ * @return 1: 반영, 0: 기각
+ */
+static int update2(GpsKf *k, int i0, double z0, double z1, const double R[2][2], double gate)
+{
+    const int a = i0, b = i0 + 1;
+    double    y0 = z0 - k->x[a], y1 = z1 - k->x[b];
+
+    // S = H P Hᵀ + R, S⁻¹ (2×2)
+    double s00 = k->P[a][a] + R[0][0];
+    double s01 = k->P[a][b] + R[0][1];
+    double s11 = k->P[b][b] + R[1][1];
+    double det = s00 * s11 - s01 * s01;
+    if (det <= 0.0) return 0;
+    double i00 = s11 / det, i01 = -s01 / det, i11 = s00 / det;
+
+    // 정규화 innovation (Mahalanobis²)
+    double d2 = y0 * (i00 * y0 + i01 * y1) + y1 * (i01 * y0 + i11 * y1);
+    if (d2 > gate) return 0;
+
+    // K = P Hᵀ S⁻¹ (4×2)
+    double K[4][2];
+    for (int i = 0; i < 4; i++) {
+        K[i][0] = k->P[i][a] * i00 + k->P[i][b] * i01;
+        K[i][1] = k->P[i][a] * i01 + k->P[i][b] * i11;
+    }
+
+    for (int i = 0; i < 4; i++)
+        k->x[i] += K[i][0] * y0 + K[i][1] * y1;
+
+    // P = (I - K H) P, H P 는 P 의 a, b 행
+    double ha[4], hb[4];
+    memcpy(ha, k->P[a], sizeof(ha));
+    memcpy(hb, k->P[b], sizeof(hb));
+    for (int i = 0; i < 4; i++)
+        for (int j = i; j < 4; j++) {
+            double v = k->P[i][j] - K[i][0] * ha[j] - K[i][1] * hb[j];
+            k->P[i][j] = k->P[j][i] = v;            // 대칭 유지
+        }
+    return 1;
+}
+
+/**
+ * @brief epoch 의 시각 (ms): UTC → iTOW → 수신 시각 순
+ */
+static int64_t fix_time_ms(const GpsFix *f)
+{
+    if (f->valid & GPS_V_TIME) return f->time_ms;
+    if (f->valid & GPS_V_ITOW) return f->itow_ms;
+    return f->rx_ns / 1000000;
+}
+
+/**
+ * @brief 축당 위치 σ (m)
+ */
+static double pos_sigma(const GpsKf *k, const GpsFix *f)
+{
+    double sigma;
+
+    if (f->valid & GPS_V_ACC) {
+        // hAcc 는 수평 전체 → 축당
+        sigma = f->h_acc_mm / 1000.0 / M_SQRT2;
+    } else {
+        double hdop = (f->valid & GPS_V_HDOP) && f->hdop > 0 ? f->hdop / 100.0 : 2.0;
+        sigma = k->uere * hdop;
+    }
+
+    // DOP 는 기하만 반영하므로 위성 수가 적을 때 (다중경로 / 위성 1개 유실에 민감) 여유를 줌
+    if ((f->valid & GPS_V_SATS) && f->num_sats > 0 && f->num_sats < GPS_KF_SATS_REF)
+        sigma *= (double)GPS_KF_SATS_REF / f->num_sats;
+    if ((f->valid & GPS_V_QUALITY) && f->quality == 2)
+        sigma *= 0.5;                               // DGPS
+    return sigma;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+void gps_kf_init(GpsKf *k, double q_accel)
+{
+    memset(k, 0, sizeof(GpsKf));
+    k->q    = (q_accel > 0.0) ? q_accel : GPS_KF_Q_ACCEL;
+    k->uere = GPS_KF_UERE_M;
+}
+
+void gps_kf_set_uere(GpsKf *k, double uere)
+{
+    if (uere > 0.0) k->uere = uere;
+}
+
+void gps_kf_predict(GpsKf *k, double dt)
+{
+    double (*P)[4] = k->P;
+    double dt2 = dt * dt, dt3 = dt2 * dt;
+
+    if (dt <= 0.0) return;
+
+    k->x[0] += dt * k->x[2];
+    k->x[1] += dt * k->x[3];
+
+    // P = F P Fᵀ, F = [I dt·I; 0 I] (E/N 블록 구조를 풀어 씀)
+    double p02 = P[0][2] + dt * P[2][2], p03 = P[0][3] + dt * P[2][3];
+    double p12 = P[1][2] + dt * P[3][2], p13 = P[1][3] + dt * P[3][3];
+    double p00 = P[0][0] + dt * (P[0][2] + P[2][0]) + dt2 * P[2][2];
+    double p01 = P[0][1] + dt * (P[0][3] + P[2][1]) + dt2 * P[2][3];
+    double p11 = P[1][1] + dt * (P[1][3] + P[3][1]) + dt2 * P[3][3];
+
+    // Q: 축마다 q·[dt³/3 dt²/2; dt²/2 dt]
+    P[0][0] = p00 + k->q * dt3 / 3.0;
+    P[1][1] = p11 + k->q * dt3 / 3.0;
+    P[0][1] = P[1][0] = p01;
+    P[0][2] = P[2][0] = p02 + k->q * dt2 / 2.0;
+    P[1][3] = P[3][1] = p13 + k->q * dt2 / 2.0;
+    P[0][3] = P[3][0] = p03;
+    P[1][2] = P[2][1] = p12;
+    P[2][2] += k->q * dt;
+    P[3][3] += k->q * dt;
+}
+
+int gps_kf_update_pos(GpsKf *k, double e, double n, double sigma)
+{
+    const double R[2][2] = { { sigma * sigma, 0.0 }, { 0.0, sigma * sigma } };
+
+    if (!update2(k, 0, e, n, R, GPS_KF_GATE)) {
+        k->stats.rejected++;
+        k->reject_run++;
+        return 0;
+    }
+    k->reject_run = 0;
+    k->stats.updates++;
+    return 1;
+}
+
+void gps_kf_update_speed(GpsKf *k, double speed, double course, double s_sigma, double c_sigma)
+{
+    double se = sin(course), cn = cos(course);
+    double along = s_sigma * s_sigma;
+    double cross = speed * c_sigma;
+    double R[2][2];
+
+    cross = cross * cross + along;                  // 저속에서 방위 잡음이 속력 잡음보다 작지 않게
+
+    // R = along·u uᵀ + cross·w wᵀ,  u = (sin c, cos c), w = (cos c, -sin c)
+    R[0][0] = along * se * se + cross * cn * cn;
+    R[1][1] = along * cn * cn + cross * se * se;
+    R[0][1] = R[1][0] = (along - cross) * se * cn;
+
+    if (update2(k, 2, speed * se, speed * cn, R, INFINITY))
+        k->stats.vel_updates++;
+}
+
+void gps_kf_update_vel(GpsKf *k, double ve, double vn, double sigma)
+{
+    const double R[2][2] = { { sigma * sigma, 0.0 }, { 0.0, sigma * sigma } };
+
+    if (update2(k, 2, ve, vn, R, INFINITY))
+        k->stats.vel_updates++;
+}
+
+int gps_kf_update_fix(GpsKf *k, const GpsFix *f)
+{
+    double  lat, lon, e, n, sigma;
+    int64_t t;
+    double  dt;
+
+    if (!(f->valid & GPS_V_POS)) return 0;
+    if ((f->valid & GPS_V_QUALITY) && f->quality == 0) return 0;
+
+    lat   = f->lat * 1e-7;
+    lon   = f->lon * 1e-7;
+    sigma = pos_sigma(k, f);
+    t     = fix_time_ms(f);
+    dt    = (t - k->t_ms) / 1000.0;
+    if (dt < -43200.0) dt += 86400.0;               // UTC 자정 넘김
+
+    if (k->restored) {
+        // 복원 직후: fix 시각 기준이 없어 예측 없이, 이동하지 않았다는 가설 (저장 당시 P)
+        // 로 gate 검사한다. 통과하면 더했던 σ 를 뺀 채로 이어가고, 벗어나면 재초기화
+        k->restored = 0;
+        k->t_ms     = t;
+        k->P[0][0] -= GPS_KF_RESTORE_SIGMA * GPS_KF_RESTORE_SIGMA;
+        k->P[1][1] -= GPS_KF_RESTORE_SIGMA * GPS_KF_RESTORE_SIGMA;
+        gps_kf_to_enu(k, lat, lon, &e, &n);
+        if (!gps_kf_update_pos(k, e, n, sigma)) {
+            reset(k, lat, lon, sigma);
+            k->stats.updates++;
+        }
+    } else if (!k->init || dt < 0.0 || dt > GPS_KF_MAX_DT || k->reject_run >= GPS_KF_MAX_REJECT) {
+        reset(k, lat, lon, sigma);
+        k->t_ms = t;
+        k->stats.updates++;
+    } else {
+        gps_kf_predict(k, dt);
+        k->t_ms = t;
+        gps_kf_to_enu(k, lat, lon, &e, &n);
+        if (!gps_kf_update_pos(k, e, n, sigma)) return 0;
+    }
+
+    if (f->valid & GPS_V_VEL) {
+        double s = (f->valid & GPS_V_SACC) && f->s_acc_mmps > 0 ? f->s_acc_mmps / 1000.0
+                                                               : GPS_KF_SPEED_SIGMA;
+        gps_kf_update_vel(k, f->vel_e_mmps / 1000.0, f->vel_n_mmps / 1000.0, s);
+    } else if (f->valid & GPS_V_SPEED) {
+        double s = f->speed_mmps / 1000.0;
+        if (f->valid & GPS_V_COURSE)
+            gps_kf_update_speed(k, s, f->course_cdeg / 100.0 * GEO_DEG2RAD,
+                                GPS_KF_SPEED_SIGMA, GPS_KF_COURSE_SIGMA);
+        else if (s < STILL_SPEED)
+            gps_kf_update_vel(k, 0.0, 0.0, GPS_KF_SPEED_SIGMA);
+    }
+    return 1;
+}
+
+int gps_kf_get_state(const GpsKf *k, GpsKfState *s)
+{
+    if (!k->init) return -1;
+    s->lat0 = k->ltp.lat0;
+    s->lon0 = k->ltp.lon0;
+    memcpy(s->x, k->x, sizeof(s->x));
+    memcpy(s->P, k->P, sizeof(s->P));
+    s->t_ms = k->t_ms;
+    return 0;
+}
+
+void gps_kf_set_state(GpsKf *k, const GpsKfState *s, double age_s)
+{
+    geo_ltp_init(&k->ltp, s->lat0, s->lon0, 0.0);
+    memcpy(k->x, s->x, sizeof(k->x));
+    memcpy(k->P, s->P, sizeof(k->P));
+    k->t_ms       = s->t_ms;
+    k->init       = 1;
+    k->reject_run = 0;
+    k->restored   = 0;
+
+    if (age_s < 0.0 || age_s > GPS_KF_MAX_DT) {
+        // 오래 꺼져 있었음: 정지로 보고 속도 / 상관을 버림
+        k->x[2] = k->x[3] = 0.0;
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                if (i != j && (i >= 2 || j >= 2)) k->P[i][j] = 0.0;
+        k->P[2][2] = k->P[3][3] = INIT_VEL_SIGMA * INIT_VEL_SIGMA;
+        k->P[0][0] += GPS_KF_RESTORE_SIGMA * GPS_KF_RESTORE_SIGMA;
+        k->P[1][1] += GPS_KF_RESTORE_SIGMA * GPS_KF_RESTORE_SIGMA;
+        k->restored = 1;
+    }
+}
+
+void gps_kf_to_enu(const GpsKf *k, double lat, double lon, double *e, double *n)
+{
+    geo_ltp_fwd(&k->ltp, lat, lon, e, n);
+}
+
+void gps_kf_position(const GpsKf *k, double *lat, double *lon)
+{
+    geo_ltp_inv(&k->ltp, k->x[0], k->x[1], lat, lon);
+}
+
+double gps_kf_sigma(const GpsKf *k)
+{
+    return sqrt(k->P[0][0] + k->P[1][1]);
+}
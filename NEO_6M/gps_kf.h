@@ -0,0 +1,129 @@
+#ifndef GPS_KF_H
+#define GPS_KF_H
+
+#include <stdint.h>
+#include "geo.h"
+#include "gps_fix.h"
+
+// ─────────────────────────────────────────────
+//  등속 (constant-velocity) Kalman 필터, 국소 ENU 평면
+//
+//  상태 x = [E, N, vE, vN] (m, m/s), 첫 fix 를 원점으로 하는 접평면
+//  예측: 백색 가속도 모델 (q = 가속도 PSD, m²/s³), dt 는 fix 시각 차
+//  측정: 위치 (σ = UERE × HDOP, 위성 수가 적으면 증가 / UBX hAcc 우선)
+//        속도 (RMC/VTG 속력+방위 → vE/vN, UBX NED 속도)
+//  4×4 고정 크기, 힙 없음, 관측은 모두 2차원 (2×2 역행렬)
+// ─────────────────────────────────────────────
+
+#define GPS_KF_Q_ACCEL      0.5     // 가속도 PSD (m²/s³): 보행 ~0.1, 차량 ~2
+#define GPS_KF_UERE_M       2.5     // HDOP 1 일 때 축당 위치 σ (NEO-6M CEP 2.5m)
+#define GPS_KF_SATS_REF     7       // 이보다 위성이 적으면 σ 를 늘림
+#define GPS_KF_SPEED_SIGMA  0.2     // 속력 σ (m/s)
+#define GPS_KF_COURSE_SIGMA 0.1     // 방위 σ (rad), 저속에서는 속력 σ 가 지배
+#define GPS_KF_GATE         16.0    // 위치 innovation χ² 한계 (2자유도 99.97%)
+#define GPS_KF_MAX_REJECT   5       // 연속 기각 시 재초기화
+#define GPS_KF_MAX_DT       10.0    // 이보다 긴 공백은 재초기화 (s)
+#define GPS_KF_RESTORE_SIGMA 10.0   // 저장 상태 복원 시 더하는 위치 σ (m, 꺼져 있는 동안 이동 가정)
+
+typedef struct {
+    uint64_t updates;           // 위치 갱신
+    uint64_t vel_updates;       // 속도 갱신
+    uint64_t rejected;          // gate 기각
+    uint64_t resets;            // 재초기화
+} GpsKfStats;
+
+// ─────────────────────────────────────────────
+//  필터 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    double      x[4];           // E, N, vE, vN
+    double      P[4][4];
+    double      q;              // 가속도 PSD
+    double      uere;           // HDOP 1 일 때 축당 위치 σ (m)
+    GeoLtp      ltp;            // 원점 (첫 fix) 접평면
+    int64_t     t_ms;           // 마지막 갱신 시각 (fix 시각 기준, ms)
+    int         init;
+    int         reject_run;     // 연속 기각 수
+    int         restored;       // 저장 상태에서 복원, 첫 fix 전 (fix 시각 기준 없음)
+    GpsKfStats  stats;
+} GpsKf;
+
+// 저장 / 복원용 필터 상태 (gps_warm)
+typedef struct {
+    double      lat0, lon0;     // 접평면 원점 (도)
+    double      x[4];
+    double      P[4][4];
+    int64_t     t_ms;           // 마지막 갱신 fix 시각 (UTC 자정 이후 ms 등)
+} GpsKfState;
+
+/**
+ * @brief 필터 초기화 (첫 fix 에서 원점 / 상태 설정)
+ * @param q_accel 가속도 PSD (m²/s³), 0 이하이면 GPS_KF_Q_ACCEL
+ */
+void gps_kf_init(GpsKf *k, double q_accel);
+
+/**
+ * @brief 측정 잡음 변경 (축당 위치 σ = uere × HDOP, 기본 GPS_KF_UERE_M)
+ */
+void gps_kf_set_uere(GpsKf *k, double uere);
+
+/**
+ * @brief epoch 1개 반영 (예측 → 위치 갱신 → 속도 갱신)
+ * @return 1: 위치 갱신됨, 0: 위치 없음/기각
+ */
+int gps_kf_update_fix(GpsKf *k, const GpsFix *f);
+
+/**
+ * @brief dt 초만큼 상태/공분산 예측
+ */
+void gps_kf_predict(GpsKf *k, double dt);
+
+/**
+ * @brief 위치 측정 갱신 (ENU m, 축당 σ m)
+ * @return 1: 반영, 0: gate 기각
+ */
+int gps_kf_update_pos(GpsKf *k, double e, double n, double sigma);
+
+/**
+ * @brief 속력 / 방위 측정 갱신 (방위: 진북 기준 rad)
+ */
+void gps_kf_update_speed(GpsKf *k, double speed, double course, double s_sigma, double c_sigma);
+
+/**
+ * @brief ENU 속도 측정 갱신 (축당 σ m/s)
+ */
+void gps_kf_update_vel(GpsKf *k, double ve, double vn, double sigma);
+
+/**
+ * @brief 저장용 상태 복사
+ * @return 0: 성공, -1: 아직 첫 fix 전 (저장할 상태 없음)
+ */
+int gps_kf_get_state(const GpsKf *k, GpsKfState *s);
+
+/**
+ * @brief 저장 상태로 복원 (첫 fix 전에도 위치 / σ 사용 가능)
+ *
+ * age_s 가 GPS_KF_MAX_DT 이하이면 (프로세스 재시작) 그대로 이어서 첫 fix 에서 fix 시각
+ * 차로 예측한다. 더 길면 정지로 보고 속도를 버린 뒤 위치 σ 에 GPS_KF_RESTORE_SIGMA 를
+ * 더한다 (첫 fix 전 σ). 첫 fix 는 예측 없이 저장 당시 σ 로 gate 검사해서 통과하면
+ * (이동 안 함) 저장 상태 그대로 이어가고, 기각되면 (그 사이 이동) 곧바로 재초기화한다.
+ * @param age_s 저장 이후 경과 시간 (s, CLOCK_REALTIME 차)
+ */
+void gps_kf_set_state(GpsKf *k, const GpsKfState *s, double age_s);
+
+/**
+ * @brief 추정 위치 (도)
+ */
+void gps_kf_position(const GpsKf *k, double *lat, double *lon);
+
+/**
+ * @brief 수평 위치 σ (m, sqrt(P_EE + P_NN))
+ */
+double gps_kf_sigma(const GpsKf *k);
+
+/**
+ * @brief 위도/경도 (도) → 원점 기준 ENU (m)
+ */
+void gps_kf_to_enu(const GpsKf *k, double lat, double lon, double *e, double *n);
+
+#endif /* GPS_KF_H */
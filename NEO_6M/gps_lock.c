@@ -0,0 +1,277 @@
+// 지리 목표 지향 (GPS + MPU6050 → pan/tilt)
+//
+// 목표 좌표 (-T) 를 향해 카메라를 계속 겨눈다. 위치는 fix 마다 Kalman (gps_kf) 으로
+// 갱신하고, PWM 주기 (-r, 기본 20 ms) 마다 마지막 위치를 속도로 외삽해 gps_aim 으로
+// 차체 기준 방위 / 앙각을 구한 뒤 pan_tilt_aim 으로 보낸다.
+//
+// 자세 (MPU6050, /dev/i2c-1 0x68, 센서 x 앞 / y 왼쪽 / z 위로 장착):
+//   roll / pitch  상보 필터 (자이로 적분 + 가속도 기울기, mpu6050_cf_alpha: 시정수 0.5 s,
+//                 20 ms 주기에서 alpha 0.96)
+//   yaw           자이로 z 적분, 0.5 m/s 이상으로 움직이면 GPS 진행 방위로 보정
+//                 (차체가 앞으로 간다고 가정, 후진 / 옆미끄럼은 보정 오차)
+// -I 이면 IMU 없이 roll / pitch 0, yaw = GPS 진행 방위.
+//
+// 실행: ./gps_lock [-b baud] [-q q_accel] [-n] [-D servo_dev] [-P fwd_pan_deg] [-S]
+//                  [-L level_tilt_deg] [-U] [-I] [-i i2c_dev] [-r period_ms]
+//                  -T lat,lon,alt [dev]
+//         -n  서보 없이 계산만
+//         -P  차체 정면을 볼 때의 pan 각, -S  pan 방향 반대
+//         -L  수평을 볼 때의 tilt 각,     -U  tilt 방향 반대 (tilt 가 커지면 아래)
+//         alt 는 GPS 고도와 같은 해발 고도 (m)
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_aim.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "mpu6050.h"
+#include "pan_tilt.h"
+
+#define CAL_SAMPLES     200         // 자이로 바이어스 (5 ms 간격, 1 s)
+#define YAW_GAIN        0.2         // fix 당 GPS 방위 보정 비율
+#define HEADING_MIN_SPEED 0.5       // 이보다 느리면 course 를 믿지 않음 (m/s)
+
+typedef struct {
+    Mpu6050 dev;                    // dev.fd -1: IMU 없음
+    double gx_bias, gy_bias, gz_bias;
+    int64_t t_ns;                   // 직전 샘플 시각
+    double roll, pitch, yaw;        // 도 (차체 x 앞 / y 오른쪽 / z 아래)
+    int    have_yaw;
+} Imu;
+
+typedef struct {
+    GpsKf   kf;
+    GpsAim  aim;
+    PanTilt pt;
+    Imu     imu;
+    double  alt;
+} Lock;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static double wrap360(double a)
+{
+    a = fmod(a, 360.0);
+    return (a < 0.0) ? a + 360.0 : a;
+}
+
+/**
+ * @brief 깨우기 + 자이로 바이어스 (정지 상태)
+ */
+static int imu_open(Imu *m, const char *dev)
+{
+    Mpu6050Sample s;
+    double bias[3];
+
+    if (mpu6050_open(&m->dev, dev, MPU6050_ADDR) < 0) return -1;
+
+    printf("Calibrating gyro... keep still\n");
+    if (mpu6050_gyro_bias(&m->dev, CAL_SAMPLES, 5000, bias) < 0 ||
+        mpu6050_read(&m->dev, &s) < 0) {
+        mpu6050_close(&m->dev);
+        return -1;
+    }
+    m->gx_bias = bias[0];
+    m->gy_bias = bias[1];
+    m->gz_bias = bias[2];
+    m->t_ns    = s.t_ns;
+    m->roll  = atan2(s.ay, s.az) * GEO_RAD2DEG;
+    m->pitch = atan2(s.ax, sqrt((double)s.ay * s.ay + (double)s.az * s.az)) * GEO_RAD2DEG;
+    return 0;
+}
+
+/**
+ * @brief 자세 갱신 (센서 x 앞 / y 왼쪽 / z 위 → 차체 앞 / 오른쪽 / 아래)
+ *
+ * 6축을 burst 한 번으로 읽어 같은 샘플끼리 섞는다. 읽기 실패는 건너뛰고
+ * (0 을 자세로 넣지 않음) 다음 샘플이 그 구간까지 적분한다.
+ */
+static void imu_update(Imu *m)
+{
+    Mpu6050Sample s;
+
+    if (mpu6050_read(&m->dev, &s) < 0) return;
+    double dt = (s.t_ns - m->t_ns) / 1e9;
+    m->t_ns = s.t_ns;
+
+    double ax = s.ax / MPU6050_ACCEL_SCALE;
+    double ay = s.ay / MPU6050_ACCEL_SCALE;
+    double az = s.az / MPU6050_ACCEL_SCALE;
+    double p  =  (s.gx - m->gx_bias) / MPU6050_GYRO_SCALE;
+    double q  = -(s.gy - m->gy_bias) / MPU6050_GYRO_SCALE;
+    double r  = -(s.gz - m->gz_bias) / MPU6050_GYRO_SCALE;
+
+    double acc_roll  = atan2(ay, az) * GEO_RAD2DEG;
+    double acc_pitch = atan2(ax, sqrt(ay * ay + az * az)) * GEO_RAD2DEG;
+
+    double alpha = mpu6050_cf_alpha(dt);
+    m->roll  = alpha * (m->roll + p * dt) + (1 - alpha) * acc_roll;
+    m->pitch = alpha * (m->pitch + q * dt) + (1 - alpha) * acc_pitch;
+    m->yaw   = wrap360(m->yaw + r * dt);
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Lock  *lk = user;
+    Imu   *m  = &lk->imu;
+    double lat, lon;
+
+    if (!(f->valid & GPS_V_POS)) return;
+    gps_kf_update_fix(&lk->kf, f);                  // 기각되면 예측 위치
+    if (f->valid & GPS_V_ALT) lk->alt = f->alt_mm / 1000.0;
+
+    // 진행 방위로 yaw 보정 (IMU 없으면 그대로 사용)
+    if ((f->valid & GPS_V_COURSE) && (f->valid & GPS_V_SPEED) &&
+        f->speed_mmps >= HEADING_MIN_SPEED * 1000) {
+        double course = f->course_cdeg / 100.0;
+        double err    = wrap360(course - m->yaw + 180.0) - 180.0;
+        m->yaw = (!m->have_yaw || m->dev.fd < 0) ? course : wrap360(m->yaw + YAW_GAIN * err);
+        m->have_yaw = 1;
+    }
+
+    gps_kf_position(&lk->kf, &lat, &lon);
+    gps_aim_set_position(&lk->aim, lat, lon, lk->alt, lk->kf.x[2], lk->kf.x[3], 0.0, f->rx_ns);
+
+    GpsAimOut o;
+    gps_aim_set_attitude(&lk->aim, m->roll, m->pitch, m->yaw);
+    gps_aim_update(&lk->aim, f->rx_ns, &o);
+    printf("%02d:%02d:%02d.%03d  range %7.1f m  az %+6.1f  el %+5.1f  att %+5.1f %+5.1f %5.1f%s"
+           "  pan %.1f tilt %.1f\n",
+           f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60, f->time_ms % 1000,
+           o.range, o.az, o.el, m->roll, m->pitch, m->yaw,
+           m->have_yaw ? "" : "?", lk->pt.pan_mdeg / 1000.0, lk->pt.tilt_mdeg / 1000.0);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-b baud] [-q q_accel] [-n] [-D servo_dev] [-P fwd_pan_deg] [-S]\n"
+                    "       [-L level_tilt_deg] [-U] [-I] [-i i2c_dev] [-r period_ms]\n"
+                    "       -T lat,lon,alt [dev]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int         baud = GPS_SERIAL_BAUD, dry = 0, pan_sign = 1, tilt_sign = 1, no_imu = 0;
+    int         period_ms = 20, have_target = 0, opt;
+    double      q = 0.0, fwd_pan = MG996R_CENTER, level_tilt = MG996R_CENTER;
+    double      t_lat = 0.0, t_lon = 0.0, t_alt = 0.0;
+    const char *servo = NULL, *i2c = MPU6050_DEV;
+    Lock        lk = { .imu.dev.fd = -1 };
+
+    while ((opt = getopt(argc, argv, "b:q:nD:P:SL:UIi:r:T:")) != -1) {
+        switch (opt) {
+            case 'b': baud       = atoi(optarg); break;
+            case 'q': q          = atof(optarg); break;
+            case 'n': dry        = 1;            break;
+            case 'D': servo      = optarg;       break;
+            case 'P': fwd_pan    = atof(optarg); break;
+            case 'S': pan_sign   = -1;           break;
+            case 'L': level_tilt = atof(optarg); break;
+            case 'U': tilt_sign  = -1;           break;
+            case 'I': no_imu     = 1;            break;
+            case 'i': i2c        = optarg;       break;
+            case 'r': period_ms  = atoi(optarg); break;
+            case 'T':
+                have_target = (sscanf(optarg, "%lf,%lf,%lf", &t_lat, &t_lon, &t_alt) == 3);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (!have_target || period_ms <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    if (!no_imu && imu_open(&lk.imu, i2c) < 0) {
+        perror(i2c);
+        return 1;
+    }
+    if (dry) {
+        pan_tilt_init(&lk.pt);
+    } else if (pan_tilt_open(&lk.pt, servo) < 0) {
+        perror(servo ? servo : MG996R_DEV_PATH);
+        mpu6050_close(&lk.imu.dev);
+        return 1;
+    }
+    pan_tilt_set_mount(&lk.pt, fwd_pan, pan_sign);
+    pan_tilt_set_tilt_mount(&lk.pt, level_tilt, tilt_sign);
+    // 간격 제한 없음: 주기는 루프가 맞추고, 간격 = 주기면 epoll 지터로 일찍 깬 tick 이 버려짐
+    pan_tilt_set_rate(&lk.pt, 0.1, 0);              // 0.1° 미만 변화만 생략
+    gps_kf_init(&lk.kf, q);
+    gps_aim_init(&lk.aim);
+    gps_aim_set_target(&lk.aim, t_lat, t_lon, t_alt);
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        pan_tilt_close(&lk.pt);
+        mpu6050_close(&lk.imu.dev);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &lk);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    int64_t period_ns = period_ms * 1000000LL;
+    int64_t next_ns   = gps_now_ns() + period_ns;
+    while (!stop) {
+        int64_t now_ns = gps_now_ns(), rx_ns;
+        int     wait   = (next_ns > now_ns) ? (int)((next_ns - now_ns + 999999) / 1000000) : 0;
+        int     r      = gps_serial_read(&ser, buf, sizeof(buf), wait, &rx_ns);
+        if (r < 0) {
+            if (!stop) perror("GPS read");
+            break;
+        }
+        if (r > 0) gps_stream_feed(&stream, buf, r, rx_ns);
+        now_ns = gps_now_ns();
+        gps_epoch_poll(&epoch, ser.last_rx_ns, now_ns);
+        if (now_ns < next_ns) continue;
+
+        // PWM 주기: 자세 갱신 → 외삽 위치로 지향
+        if (lk.imu.dev.fd >= 0) imu_update(&lk.imu);
+        next_ns += period_ns;
+        if (next_ns <= now_ns) next_ns = now_ns + period_ns;   // 밀리면 건너뜀
+
+        GpsAimOut o;
+        gps_aim_set_attitude(&lk.aim, lk.imu.roll, lk.imu.pitch, lk.imu.yaw);
+        if (!lk.imu.have_yaw || gps_aim_update(&lk.aim, now_ns, &o) < 0) continue;
+        if (pan_tilt_aim(&lk.pt, o.az, o.el, now_ns) < 0) perror("  MG996R_SET_BOTH_MDEG");
+        fflush(stdout);
+    }
+
+    printf("servo commands %llu, skipped %llu, clamped %llu, errors %llu\n",
+           (unsigned long long)lk.pt.stats.commands, (unsigned long long)lk.pt.stats.skipped,
+           (unsigned long long)lk.pt.stats.clamped, (unsigned long long)lk.pt.stats.errors);
+    if (lk.imu.dev.fd >= 0)
+        printf("imu samples %llu, read errors %llu\n", (unsigned long long)lk.imu.dev.reads,
+               (unsigned long long)lk.imu.dev.errors);
+    gps_serial_close(&ser);
+    pan_tilt_close(&lk.pt);
+    mpu6050_close(&lk.imu.dev);
+    return 0;
+}
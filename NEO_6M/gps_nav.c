@@ -0,0 +1,187 @@
+// waypoint 경로 추종 + 카메라 지향
+//
+// 경로 파일 (gps_route_load 형식) 을 읽어 fix 마다 Kalman 위치로 목표 waypoint,
+// 남은 거리, 구간 방위, 교차 오차를 출력하고 waypoint 전환 / 도착 이벤트를 알린다.
+// 카메라 pan 은 구간 방위 - 차체 진행 방위 (RMC / VTG course) 로 경로 방향을 향한다.
+//
+// 실행: ./gps_nav [-b baud] [-r radius_m] [-q q_accel] [-n] [-D servo_dev]
+//                 [-P fwd_pan_deg] [-S] [-t tilt_deg] -w route.txt [dev]
+//         -n  서보 없이 계산만 (pan 값은 출력)
+//         -P  차체 정면을 볼 때의 pan 각 (기본 MG996R_CENTER)
+//         -S  pan 방향 반대 (pan 이 커지면 왼쪽)
+//
+//   route.txt (한 줄에 위도,경도[,도착 반경 m]):
+//     37.566500,126.978000
+//     37.566800,126.978400,5
+//     ...
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_route.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "pan_tilt.h"
+
+#define HEADING_MIN_SPEED   0.5         // 이보다 느리면 course 를 믿지 않고 직전 방위 유지 (m/s)
+
+typedef struct {
+    GpsRoute route;
+    GpsKf    kf;
+    PanTilt  pt;
+    double   tilt;
+    double   heading;                   // 차체 진행 방위 (도)
+    int      have_heading;
+    int      finished;
+} Nav;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static void on_event(GpsRouteEvent ev, uint32_t wp, const GpsRouteState *s, void *user)
+{
+    Nav *nav = user;
+
+    if (ev == GPS_ROUTE_FINISHED) {
+        printf("  FINISHED at waypoint %u (%.1f m off)\n", wp, s->dist_wp);
+        nav->finished = 1;
+    } else {
+        printf("  WAYPOINT %u reached (%.1f m off, xte %+.1f m)\n", wp, s->dist_wp, s->xte);
+    }
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Nav          *nav = user;
+    GpsRouteState s;
+    double        lat, lon;
+
+    if (!(f->valid & GPS_V_POS)) return;
+    gps_kf_update_fix(&nav->kf, f);                 // 기각되면 예측 위치
+    if ((f->valid & GPS_V_COURSE) && (f->valid & GPS_V_SPEED) &&
+        f->speed_mmps >= HEADING_MIN_SPEED * 1000) {
+        nav->heading      = f->course_cdeg / 100.0;
+        nav->have_heading = 1;
+    }
+
+    gps_kf_position(&nav->kf, &lat, &lon);
+    gps_route_update(&nav->route, lat, lon, &s);
+
+    printf("%02d:%02d:%02d.%03d  wp %u/%zu  dist %7.1f m  to go %8.1f m  brg %5.1f  xte %+6.1f m",
+           f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60, f->time_ms % 1000,
+           s.seg + 1, nav->route.nwp - 1, s.dist_wp, s.dist_to_go, s.bearing, s.xte);
+
+    // 카메라: 경로 방향 (차체 기준), 진행 방위를 모르면 정면
+    double rel = nav->have_heading ? s.bearing - nav->heading : 0.0;
+    int    rc  = pan_tilt_point(&nav->pt, rel, nav->tilt, gps_now_ns());
+    if (rc < 0) perror("  MG996R_SET_BOTH_MDEG");
+    printf("  pan %.1f%s\n", nav->pt.pan_mdeg / 1000.0, rc > 0 ? " *" : "");
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-b baud] [-r radius_m] [-q q_accel] [-n] [-D servo_dev]\n"
+                    "       [-P fwd_pan_deg] [-S] [-t tilt_deg] -w route.txt [dev]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int         baud = GPS_SERIAL_BAUD, dry = 0, sign = 1, bad_line, opt;
+    double      radius = 0.0, q = 0.0, fwd_pan = MG996R_CENTER;
+    const char *path = NULL, *servo = NULL;
+    Nav         nav = { .tilt = MG996R_CENTER };
+
+    while ((opt = getopt(argc, argv, "b:r:q:nD:P:St:w:")) != -1) {
+        switch (opt) {
+            case 'b': baud     = atoi(optarg); break;
+            case 'r': radius   = atof(optarg); break;
+            case 'q': q        = atof(optarg); break;
+            case 'n': dry      = 1;            break;
+            case 'D': servo    = optarg;       break;
+            case 'P': fwd_pan  = atof(optarg); break;
+            case 'S': sign     = -1;           break;
+            case 't': nav.tilt = atof(optarg); break;
+            case 'w': path     = optarg;       break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (!path) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    gps_route_init(&nav.route, on_event, &nav);
+    gps_route_set_radius(&nav.route, radius);
+    int n = gps_route_load(&nav.route, path, &bad_line);
+    if (n < 2) {
+        if (n >= 0)        fprintf(stderr, "%s: need at least 2 waypoints\n", path);
+        else if (bad_line) fprintf(stderr, "%s:%d: bad line\n", path, bad_line);
+        else               perror(path);
+        return 1;
+    }
+    printf("%s: %d waypoints, %.1f m\n", path, n, gps_route_length(&nav.route));
+
+    if (dry) {
+        pan_tilt_init(&nav.pt);
+    } else if (pan_tilt_open(&nav.pt, servo) < 0) {
+        perror(servo ? servo : MG996R_DEV_PATH);
+        gps_route_free(&nav.route);
+        return 1;
+    }
+    pan_tilt_set_mount(&nav.pt, fwd_pan, sign);
+    gps_kf_init(&nav.kf, q);
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        pan_tilt_close(&nav.pt);
+        gps_route_free(&nav.route);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &nav);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    while (!stop && !nav.finished) {
+        int64_t rx_ns;
+        int r = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (r < 0) {
+            if (!stop) perror("GPS read");
+            break;
+        }
+        if (r > 0) gps_stream_feed(&stream, buf, r, rx_ns);
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
+        fflush(stdout);
+    }
+
+    printf("waypoints passed %llu%s; servo commands %llu, skipped %llu, clamped %llu, errors %llu\n",
+           (unsigned long long)nav.route.switches, nav.finished ? " (finished)" : "",
+           (unsigned long long)nav.pt.stats.commands, (unsigned long long)nav.pt.stats.skipped,
+           (unsigned long long)nav.pt.stats.clamped, (unsigned long long)nav.pt.stats.errors);
+    gps_serial_close(&ser);
+    pan_tilt_close(&nav.pt);
+    gps_route_free(&nav.route);
+    return 0;
+}
@@ -3,13 +3,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <termios.h>
 #include <math.h>
+#include "nmea_msg.h"
+#include "geo.h"
+#include "gps_serial.h"
+#include "win_stat.h"
 
-#define GPS_SERIAL "/dev/serial0"
-#define BAUDRATE B9600
 #define QUEUE_SIZE 20
 
 // ===== 기준점 오프셋 (필요 시 사용) =====
@@ -21,148 +20,92 @@ typedef struct {
     double lon;
 } Position;
 
-// NMEA → Decimal
-double nmea_to_decimal(const char *nmea, char direction) {
-    if (!nmea || strlen(nmea) < 4) return 0.0;
-
-    double val = atof(nmea);
-    int deg = (int)(val / 100);
-    double min = val - deg * 100;
-    double dec = deg + min / 60.0;
-
-    if (direction == 'S' || direction == 'W')
-        dec = -dec;
-
-    return dec;
-}
-
-// 거리 계산
-void calc_offset(double lat1, double lon1, double lat2, double lon2,
-                 double *north_m, double *east_m)
-{
-    *north_m = (lat1 - lat2) * 111320.0;
-    *east_m  = (lon1 - lon2) * 111320.0 * cos(lat1 * M_PI / 180.0);
-}
-
-int main() {
-
-    int fd = open(GPS_SERIAL, O_RDONLY | O_NOCTTY);
-    if (fd == -1) {
-        perror("Serial open error");
-        return 1;
-    }
-
-    struct termios options;
-    tcgetattr(fd, &options);
-    cfsetispeed(&options, BAUDRATE);
-    cfsetospeed(&options, BAUDRATE);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    tcsetattr(fd, TCSANOW, &options);
-
-    char buf[512], line[128];
-    int line_idx = 0;
-
-    Position queue[QUEUE_SIZE];
-    int queue_idx = 0;
-    int queue_count = 0;
-
-    printf("Waiting GPS...\n");
-
-    while (1) {
-
-        int n = read(fd, buf, sizeof(buf));
-        if (n <= 0) continue;
-
-        for (int i = 0; i < n; i++) {
-
-            char c = buf[i];
-
-            if (c == '\n') {
+// 평균 윈도우 상태 (ENU 축별, MAD 기준 이상치 제외)
+typedef struct {
+    WinPos win;
+} FixState;
 
-                line[line_idx] = '\0';
-                line_idx = 0;
+static void handle_fix(FixState *st, Position p) {
 
-                if (strncmp(line, "$GPGGA", 6) == 0) {
+    // 윈도우 저장 (다중경로로 튄 fix 는 평균에서 제외)
+    if (!win_pos_push(&st->win, p.lat, p.lon))
+        printf("Outlier rejected: %.6f, %.6f\n", p.lat, p.lon);
 
-                    char *token = strtok(line, ",");
-                    int field = 0;
-                    char lat[16] = {0}, lon[16] = {0};
-                    char ns = 'N', ew = 'E';
-                    int fix = 0;
+    // 평균 계산 (O(1), 보정 합산)
+    double lat_avg, lon_avg;
+    win_pos_mean(&st->win, &lat_avg, &lon_avg);
 
-                    while (token) {
-                        field++;
-                        switch (field) {
-                            case 3: strcpy(lat, token); break;
-                            case 4: ns = token[0]; break;
-                            case 5: strcpy(lon, token); break;
-                            case 6: ew = token[0]; break;
-                            case 7: fix = atoi(token); break;
-                        }
-                        token = strtok(NULL, ",");
-                    }
+    // ===== 오프셋 보정 =====
+    double lat_corrected = lat_avg + LAT_OFFSET;
+    double lon_corrected = lon_avg + LON_OFFSET;
 
-                    if (fix > 0) {
+    // ===== 평균 대비 오차 =====
+    double north_m, east_m;
+    geo_offset(lat_corrected, lon_corrected,
+               lat_avg, lon_avg,
+               &north_m, &east_m);
 
-                        Position p;
-                        p.lat = nmea_to_decimal(lat, ns);
-                        p.lon = nmea_to_decimal(lon, ew);
+    double dist = sqrt(north_m*north_m + east_m*east_m);
 
-                        // 큐 저장
-                        queue[queue_idx] = p;
-                        queue_idx = (queue_idx + 1) % QUEUE_SIZE;
-                        if (queue_count < QUEUE_SIZE)
-                            queue_count++;
+    printf("Avg: %.6f, %.6f | Corrected: %.6f, %.6f | Offset: %.2fm\n",
+           lat_avg, lon_avg,
+           lat_corrected, lon_corrected,
+           dist);
 
-                        // 평균 계산
-                        double lat_sum = 0.0, lon_sum = 0.0;
-                        for (int j = 0; j < queue_count; j++) {
-                            lat_sum += queue[j].lat;
-                            lon_sum += queue[j].lon;
-                        }
+    printf("Map: https://www.google.com/maps?q=%.6f,%.6f\n\n",
+           lat_corrected, lon_corrected);
+}
 
-                        double lat_avg = lat_sum / queue_count;
-                        double lon_avg = lon_sum / queue_count;
+// GGA (GP/GN/GL 등 모든 talker)
+static void on_gga(const NmeaMsg *m, void *user) {
 
-                        // ===== 오프셋 보정 =====
-                        double lat_corrected = lat_avg + LAT_OFFSET;
-                        double lon_corrected = lon_avg + LON_OFFSET;
+    if (!(m->gga.valid & NMEA_V_POS)) return;
 
-                        // ===== 평균 대비 오차 =====
-                        double north_m, east_m;
-                        calc_offset(lat_corrected, lon_corrected,
-                                    lat_avg, lon_avg,
-                                    &north_m, &east_m);
+    Position p;
+    p.lat = nmea_e7_to_deg(m->gga.lat);
+    p.lon = nmea_e7_to_deg(m->gga.lon);
+    handle_fix(user, p);
+}
 
-                        double dist = sqrt(north_m*north_m + east_m*east_m);
+int main(int argc, char **argv) {
 
-                        printf("Avg: %.6f, %.6f | Corrected: %.6f, %.6f | Offset: %.2fm\n",
-                               lat_avg, lon_avg,
-                               lat_corrected, lon_corrected,
-                               dist);
+    // UART0 (GPIO14=TX, GPIO15=RX / 물리핀 8/10), raw 모드 + epoll 대기
+    const char *dev = (argc > 1) ? argv[1] : GPS_SERIAL_DEV;
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, GPS_SERIAL_BAUD, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Serial open error");
+        return 1;
+    }
 
-                        printf("Map: https://www.google.com/maps?q=%.6f,%.6f\n\n",
-                               lat_corrected, lon_corrected);
-                    }
-                }
+    char buf[512];
+    NmeaParser parser;
+    NmeaDispatch disp;
+    FixState state = {0};
+    if (win_pos_init(&state.win, QUEUE_SIZE) < 0) {
+        perror("win_pos_init");
+        gps_serial_close(&ser);
+        return 1;
+    }
+    nmea_dispatch_init(&disp);
+    nmea_dispatch_on(&disp, NMEA_GGA, on_gga, &state);
+    nmea_parser_init(&parser, nmea_dispatch_sentence, &disp);
 
-                memset(line, 0, sizeof(line));
+    printf("Waiting GPS...\n");
 
-            } else if (c != '\r') {
+    while (1) {
 
-                if (line_idx < sizeof(line)-1)
-                    line[line_idx++] = c;
-            }
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), -1, &rx_ns);
+        if (n < 0) {
+            perror("GPS read");
+            break;
         }
 
-        usleep(100000);
+        nmea_parser_feed_at(&parser, buf, n, rx_ns);
     }
 
-    close(fd);
+    win_pos_free(&state.win);
+    gps_serial_close(&ser);
     return 0;
 }
 
@@ -1,72 +1,160 @@
+// GPS 출력률 / 링크 진단
+//
+// 실행: ./gps_rate [-d] [-i sec] [dev] [baud]
+//         기본: 1초마다 수신한 fix (epoch) 수
+//         -d  진단: 문장 종류별 개수 / 바이트, 회선 사용률, 체크섬 / framing / 잘림 /
+//             UART 오류, epoch 간격 지터 / 종료 지연 히스토그램, 포화 여부
+//         -i  진단 보고 간격 (s, 기본 10)
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <termios.h>
 #include <sys/time.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_diag.h"
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+
+typedef struct {
+    int      count;
+    GpsDiag *diag;
+} Rate;
+
+// GGA 는 끄고 RMC/UBX 만 켠 설정 (gps_config -n) 에서도 셀 수 있도록 epoch 단위
+static void on_fix(const GpsFix *f, void *user) {
+    Rate *r = user;
+    r->count++; // GPS 위치 수신 카운트
+    if (r->diag) gps_diag_on_fix(r->diag, f);
+}
 
-#define GPS_SERIAL "/dev/serial0"
-#define BAUDRATE B9600
+static void print_hist(const char *name, const uint64_t *h) {
+    uint64_t total = 0;
+    for (int i = 0; i < GPS_DIAG_BINS; i++) total += h[i];
+    if (!total) return;
 
-int main() {
-    int fd = open(GPS_SERIAL, O_RDONLY | O_NOCTTY);
-    if (fd == -1) {
+    printf("  %-8s", name);
+    for (int i = 0; i < GPS_DIAG_BINS; i++) {
+        if (!h[i]) continue;
+        int64_t up = gps_diag_bin_us(i);
+        if (up == INT64_MAX) printf("  >=%lldms:%llu", (long long)gps_diag_bin_us(i - 1) / 1000,
+                                    (unsigned long long)h[i]);
+        else if (up < 1000)  printf("  <%lldus:%llu", (long long)up, (unsigned long long)h[i]);
+        else                 printf("  <%lldms:%llu", (long long)up / 1000, (unsigned long long)h[i]);
+    }
+    printf("\n");
+}
+
+static void print_report(const GpsDiag *diag, const GpsDiagReport *r) {
+    const GpsDiagType *t;
+    int n = gps_diag_types(diag, &t);
+
+    printf("── %.1f s: %.2f fix/s (period %.3f s), %.0f B/s of %.0f (%.0f%%), busy %.0f%%%s\n",
+           r->dt_s, r->epoch_hz, r->period_s, r->bytes_per_s, r->capacity,
+           r->util * 100.0, r->busy * 100.0, r->saturated ? "  ** SATURATED **" : "");
+    for (int i = 0; i < n; i++) {
+        if (!t[i].icount) continue;
+        printf("  %-10s %6.2f /s %7.1f B/s %5.1f%%\n", t[i].name, t[i].icount / r->dt_s,
+               t[i].ibytes / r->dt_s,
+               r->capacity > 0 ? t[i].ibytes / r->dt_s / r->capacity * 100.0 : 0.0);
+    }
+    printf("  errors: checksum %llu, framing %llu, overflow %llu, truncated %llu, garbage %llu B, "
+           "gaps %llu, time tag %llu",
+           (unsigned long long)r->d.checksum_errors, (unsigned long long)r->d.framing_errors,
+           (unsigned long long)r->d.overflows, (unsigned long long)r->d.truncated,
+           (unsigned long long)r->d.garbage, (unsigned long long)r->d.gaps,
+           (unsigned long long)r->d.tag_errors);
+    if (r->uart_ok)
+        printf(", uart frame %llu, overrun %llu",
+               (unsigned long long)r->d.uart_frame, (unsigned long long)r->d.uart_overrun);
+    printf("\n");
+    printf("  jitter  p50 %.1f ms  p99 %.1f ms  max %.1f ms\n",
+           r->jitter_p50_us / 1e3, r->jitter_p99_us / 1e3, r->jitter_max_us / 1e3);
+    printf("  latency p50 %.1f ms  p99 %.1f ms  max %.1f ms\n",
+           r->latency_p50_us / 1e3, r->latency_p99_us / 1e3, r->latency_max_us / 1e3);
+    print_hist("jitter", r->d.jitter);
+    print_hist("latency", r->d.latency);
+}
+
+int main(int argc, char **argv) {
+    int diag_mode = 0, opt;
+    double interval = 0;
+
+    while ((opt = getopt(argc, argv, "di:")) != -1) {
+        switch (opt) {
+            case 'd': diag_mode = 1;            break;
+            case 'i': interval  = atof(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-d] [-i sec] [dev] [baud]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (!diag_mode || interval <= 0) interval = diag_mode ? GPS_DIAG_REPORT_S : 1.0;
+
+    // UART0 (GPIO14=TX, GPIO15=RX / 물리핀 8/10), raw 모드 + epoll 대기
+    // gps_config -B 로 보레이트를 바꿨으면 두 번째 인자로 지정
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+    int baud = (optind + 1 < argc) ? atoi(argv[optind + 1]) : GPS_SERIAL_BAUD;
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
         perror("Unable to open serial port");
         return 1;
     }
 
-    struct termios options;
-    tcgetattr(fd, &options);
-    cfsetispeed(&options, BAUDRATE);
-    cfsetospeed(&options, BAUDRATE);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    tcsetattr(fd, TCSANOW, &options);
-
-    char buf[512], line[128];
-    int line_idx = 0;
-    int count = 0;
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    GpsDiag diag;
+    Rate rate = { 0, diag_mode ? &diag : NULL };
+    gps_epoch_init(&epoch, on_fix, &rate);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    if (diag_mode) {
+        // 스트림 → 진단 tap → 원래 콜백
+        gps_diag_init(&diag, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+        gps_stream_init(&stream, gps_diag_sentence, &diag, gps_diag_ubx, &diag);
+        gps_diag_report(&diag, &stream, &ser, baud, gps_now_ns(), &(GpsDiagReport){0});
+    } else {
+        gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+    }
 
     struct timeval start_time, current_time;
     gettimeofday(&start_time, NULL);
 
     while (1) {
-        int n = read(fd, buf, sizeof(buf));
-        if (n > 0) {
-            for (int i = 0; i < n; i++) {
-                char c = buf[i];
-                if (c == '\n') {
-                    line[line_idx] = '\0';
-                    line_idx = 0;
-
-                    if (strncmp(line, "$GPGGA", 6) == 0) {
-                        count++; // GPS 위치 수신 카운트
-                    }
-
-                    memset(line, 0, sizeof(line));
-                } else if (c != '\r') {
-                    line[line_idx++] = c;
-                    if (line_idx >= sizeof(line)-1) line_idx = sizeof(line)-2;
-                }
-            }
+        // 데이터가 없어도 1초 출력이 밀리지 않도록 100ms 까지만 대기
+        // (진단: epoch 종료 지연이 poll 간격에 묶이지 않도록 timeout 단위로)
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), diag_mode ? GPS_EPOCH_TIMEOUT_MS : 100,
+                                &rx_ns);
+        if (n < 0) {
+            perror("GPS read");
+            break;
         }
+        if (n > 0)
+            gps_stream_feed(&stream, buf, n, rx_ns);
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
 
         gettimeofday(&current_time, NULL);
-        double elapsed = (current_time.tv_sec - start_time.tv_sec) + 
+        double elapsed = (current_time.tv_sec - start_time.tv_sec) +
                          (current_time.tv_usec - start_time.tv_usec) / 1000000.0;
 
-        if (elapsed >= 1.0) { // 매 1초마다 출력
-            printf("GPS positions received per second: %d\n", count);
-            count = 0;
+        if (elapsed >= interval) { // 매 1초마다 출력 (진단: interval 초)
+            if (diag_mode) {
+                GpsDiagReport r;
+                gps_diag_report(&diag, &stream, &ser, baud, gps_now_ns(), &r);
+                print_report(&diag, &r);
+            } else {
+                printf("GPS positions received per second: %d\n", rate.count);
+            }
+            fflush(stdout);
+            rate.count = 0;
             start_time = current_time;
         }
     }
 
-    close(fd);
+    gps_serial_close(&ser);
     return 0;
 }
-
@@ -0,0 +1,462 @@
+#include "gps_rec.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ALIGN8(n)   (((n) + 7u) & ~(size_t)7u)
+
+#define CHUNK_HDR   4           // (µs 차 << 12) | 길이
+
+_Static_assert(sizeof(GpsRecHeader) == 64, "GpsRecHeader layout");
+_Static_assert(sizeof(GpsRecBlock) == 32, "GpsRecBlock layout");
+_Static_assert(sizeof(GpsRecHdr) == 16, "GpsRecHdr layout");
+_Static_assert(sizeof(GpsRecIndex) == 32, "GpsRecIndex layout");
+_Static_assert(sizeof(GpsRecTail) == 32, "GpsRecTail layout");
+_Static_assert(GPS_REC_BLOCK_MAX - sizeof(GpsRecBlock) - sizeof(GpsRecHdr) <= UINT16_MAX,
+               "record length is 16 bit");
+
+// ─────────────────────────────────────────────
+//  기록
+// ─────────────────────────────────────────────
+
+static int write_all(int fd, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static void block_reset(GpsRecWriter *w)
+{
+    memset(&w->blk, 0, sizeof(GpsRecBlock));
+    w->len     = sizeof(GpsRecBlock);
+    w->raw_off = 0;
+}
+
+static void count_record(GpsRecWriter *w, uint16_t type, int64_t t_ns)
+{
+    if (w->blk.records++ == 0) w->blk.first_ns = t_ns;
+    w->blk.last_ns = t_ns;
+    w->stats.records++;
+    if (type == GPS_REC_FIX) {
+        w->blk.fixes++;
+        w->stats.fixes++;
+    }
+}
+
+static int index_append(GpsRecWriter *w, const GpsRecIndex *ix)
+{
+    if (w->blocks == w->index_cap) {
+        size_t       cap = w->index_cap ? w->index_cap * 2 : 256;
+        GpsRecIndex *p   = realloc(w->index, cap * sizeof(GpsRecIndex));
+        if (!p) return -1;
+        w->index     = p;
+        w->index_cap = cap;
+    }
+    w->index[w->blocks++] = *ix;
+    return 0;
+}
+
+static int add_record(GpsRecWriter *w, uint16_t type, const void *data, size_t len, int64_t t_ns)
+{
+    size_t    need = sizeof(GpsRecHdr) + ALIGN8(len);
+    GpsRecHdr h    = { .type = type, .len = (uint16_t)len, .t_ns = t_ns };
+
+    if (w->len + need > GPS_REC_BLOCK_MAX && gps_rec_flush(w) < 0) return -1;
+
+    memcpy(w->buf + w->len, &h, sizeof(h));
+    memcpy(w->buf + w->len + sizeof(h), data, len);
+    memset(w->buf + w->len + sizeof(h) + len, 0, ALIGN8(len) - len);
+    w->len    += need;
+    w->raw_off = 0;                                 // 다음 원시 청크는 새 레코드
+
+    count_record(w, type, t_ns);
+    return gps_rec_poll(w, t_ns);
+}
+
+/**
+ * @brief 원시 청크 k 바이트를 현재 원시 레코드에 붙일 수 있는지
+ */
+static int raw_fits(const GpsRecWriter *w, size_t k, int64_t t_ns)
+{
+    const GpsRecHdr *h;
+    size_t           len;
+
+    if (!w->raw_off || t_ns < w->raw_t || (t_ns - w->raw_t) / 1000 > GPS_REC_CHUNK_DT_US)
+        return 0;
+    h   = (const GpsRecHdr *)(w->buf + w->raw_off);
+    len = h->len + CHUNK_HDR + k;
+    return len <= UINT16_MAX && w->raw_off + sizeof(GpsRecHdr) + ALIGN8(len) <= GPS_REC_BLOCK_MAX;
+}
+
+int gps_rec_create(GpsRecWriter *w, const char *path, int baud, const char *dev)
+{
+    GpsRecHeader    h = {0};
+    struct timespec mono, real;
+    int             err;
+
+    memset(w, 0, sizeof(GpsRecWriter));
+    w->buf = malloc(GPS_REC_BLOCK_MAX);
+    if (!w->buf) return -1;
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (w->fd < 0) {
+        free(w->buf);
+        return -1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    clock_gettime(CLOCK_REALTIME, &real);
+    memcpy(h.magic, GPS_REC_MAGIC, sizeof(GPS_REC_MAGIC));
+    h.version   = GPS_REC_VERSION;
+    h.fix_size  = sizeof(GpsFix);
+    h.mono_ns   = (int64_t)mono.tv_sec * 1000000000LL + mono.tv_nsec;
+    h.real_ns   = (int64_t)real.tv_sec * 1000000000LL + real.tv_nsec;
+    h.baud      = baud;
+    h.block_max = GPS_REC_BLOCK_MAX;
+    if (dev) strncpy(h.dev, dev, sizeof(h.dev) - 1);
+
+    if (write_all(w->fd, &h, sizeof(h)) < 0) {
+        err = errno;
+        close(w->fd);
+        free(w->buf);
+        errno = err;
+        return -1;
+    }
+    w->off              = sizeof(h);
+    w->stats.file_bytes = sizeof(h);
+    block_reset(w);
+    return 0;
+}
+
+int gps_rec_write_raw(GpsRecWriter *w, const void *data, size_t len, int64_t rx_ns)
+{
+    const uint8_t *p = data;
+
+    while (len > 0) {
+        size_t     k = (len < GPS_REC_CHUNK_MAX) ? len : GPS_REC_CHUNK_MAX;
+        GpsRecHdr *h;
+        uint32_t   ent;
+        uint8_t   *dst;
+
+        if (!raw_fits(w, k, rx_ns)) {
+            // 새 원시 레코드 (빈 payload 로 시작)
+            GpsRecHdr nh = { .type = GPS_REC_RAW, .t_ns = rx_ns };
+            if (w->len + sizeof(nh) + ALIGN8(CHUNK_HDR + k) > GPS_REC_BLOCK_MAX &&
+                gps_rec_flush(w) < 0)
+                return -1;
+            memcpy(w->buf + w->len, &nh, sizeof(nh));
+            w->raw_off = w->len;
+            w->raw_t   = rx_ns;
+            w->len    += sizeof(nh);
+            count_record(w, GPS_REC_RAW, rx_ns);
+        }
+
+        h   = (GpsRecHdr *)(w->buf + w->raw_off);
+        dst = w->buf + w->raw_off + sizeof(GpsRecHdr) + h->len;
+        ent = (uint32_t)((rx_ns - w->raw_t) / 1000) << 12 | (uint32_t)k;
+        memcpy(dst, &ent, CHUNK_HDR);
+        memcpy(dst + CHUNK_HDR, p, k);
+        h->len += (uint16_t)(CHUNK_HDR + k);
+        w->len  = w->raw_off + sizeof(GpsRecHdr) + ALIGN8(h->len);
+        memset(dst + CHUNK_HDR + k, 0, (size_t)(w->buf + w->len - (dst + CHUNK_HDR + k)));
+
+        w->blk.last_ns = rx_ns;
+        w->stats.chunks++;
+        w->stats.raw_bytes += k;
+        p   += k;
+        len -= k;
+        if (gps_rec_poll(w, rx_ns) < 0) return -1;
+    }
+    return 0;
+}
+
+int gps_rec_write_fix(GpsRecWriter *w, const GpsFix *fix)
+{
+    return add_record(w, GPS_REC_FIX, fix, sizeof(GpsFix), fix->pub_ns);
+}
+
+int gps_rec_poll(GpsRecWriter *w, int64_t now_ns)
+{
+    if (w->blk.records == 0 || now_ns - w->blk.first_ns < GPS_REC_FLUSH_MS * 1000000LL)
+        return 0;
+    return gps_rec_flush(w);
+}
+
+int gps_rec_flush(GpsRecWriter *w)
+{
+    GpsRecIndex ix;
+
+    if (w->blk.records == 0) return 0;
+
+    w->blk.magic = GPS_REC_BLOCK_MAGIC;
+    w->blk.bytes = (uint32_t)(w->len - sizeof(GpsRecBlock));
+    memcpy(w->buf, &w->blk, sizeof(GpsRecBlock));
+    if (write_all(w->fd, w->buf, w->len) < 0) return -1;
+
+    ix.offset   = w->off;
+    ix.first_ns = w->blk.first_ns;
+    ix.last_ns  = w->blk.last_ns;
+    ix.records  = w->blk.records;
+    ix.fixes    = w->blk.fixes;
+    w->off += w->len;
+    w->stats.writes++;
+    w->stats.file_bytes += w->len;
+    block_reset(w);
+
+    // 색인은 메모리에만, 실패하면 꼬리를 쓰지 않음 (열 때 블록을 따라가며 복구)
+    if (!w->index_lost && index_append(w, &ix) < 0) {
+        free(w->index);
+        w->index      = NULL;
+        w->index_lost = 1;
+    }
+    return 0;
+}
+
+int gps_rec_finish(GpsRecWriter *w)
+{
+    int rc = gps_rec_flush(w);
+
+    if (rc == 0 && !w->index_lost) {
+        GpsRecTail t = {
+            .magic     = GPS_REC_TAIL_MAGIC,
+            .blocks    = (uint32_t)w->blocks,
+            .index_off = w->off,
+            .records   = w->stats.records,
+            .fixes     = w->stats.fixes,
+        };
+        if ((w->blocks && write_all(w->fd, w->index, w->blocks * sizeof(GpsRecIndex)) < 0) ||
+            write_all(w->fd, &t, sizeof(t)) < 0)
+            rc = -1;
+        else
+            w->stats.file_bytes += w->blocks * sizeof(GpsRecIndex) + sizeof(t);
+    }
+    if (fsync(w->fd) < 0 && errno != EINVAL) rc = -1;
+
+    int err = errno;
+    close(w->fd);
+    free(w->buf);
+    free(w->index);
+    w->fd    = -1;
+    w->buf   = NULL;
+    w->index = NULL;
+    errno = err;
+    return rc;
+}
+
+// ─────────────────────────────────────────────
+//  재생
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 꼬리 색인 확인 (크기 / 위치가 파일과 맞아야 사용)
+ */
+static int load_tail(GpsRecReader *r)
+{
+    const GpsRecTail *t;
+
+    if (r->size < sizeof(GpsRecHeader) + sizeof(GpsRecTail)) return -1;
+    t = (const GpsRecTail *)(r->map + r->size - sizeof(GpsRecTail));
+    if (t->magic != GPS_REC_TAIL_MAGIC || t->index_off < sizeof(GpsRecHeader) ||
+        t->index_off % 8 != 0 ||
+        t->index_off + (uint64_t)t->blocks * sizeof(GpsRecIndex) + sizeof(GpsRecTail) != r->size)
+        return -1;
+
+    r->index   = (const GpsRecIndex *)(r->map + t->index_off);
+    r->blocks  = t->blocks;
+    r->records = t->records;
+    r->fixes   = t->fixes;
+    return 0;
+}
+
+/**
+ * @brief 블록 헤더를 따라가며 색인 복구 (잘린 마지막 블록은 버림)
+ */
+static int scan_blocks(GpsRecReader *r)
+{
+    uint64_t pos = sizeof(GpsRecHeader);
+    size_t   cap = 0;
+
+    while (pos + sizeof(GpsRecBlock) <= r->size) {
+        const GpsRecBlock *b = (const GpsRecBlock *)(r->map + pos);
+
+        if (b->magic != GPS_REC_BLOCK_MAGIC || b->bytes % 8 != 0 ||
+            pos + sizeof(GpsRecBlock) + b->bytes > r->size)
+            break;
+        if (r->blocks == cap) {
+            GpsRecIndex *p;
+            cap = cap ? cap * 2 : 256;
+            p   = realloc(r->scanned, cap * sizeof(GpsRecIndex));
+            if (!p) return -1;
+            r->scanned = p;
+        }
+        r->scanned[r->blocks++] = (GpsRecIndex){
+            .offset = pos, .first_ns = b->first_ns, .last_ns = b->last_ns,
+            .records = b->records, .fixes = b->fixes,
+        };
+        r->records += b->records;
+        r->fixes   += b->fixes;
+        pos += sizeof(GpsRecBlock) + b->bytes;
+    }
+    r->index = r->scanned;
+    return 0;
+}
+
+int gps_rec_open(GpsRecReader *r, const char *path)
+{
+    struct stat st;
+    int         err;
+
+    memset(r, 0, sizeof(GpsRecReader));
+    r->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (r->fd < 0) return -1;
+    if (fstat(r->fd, &st) < 0) goto fail_errno;
+    if ((size_t)st.st_size < sizeof(GpsRecHeader)) {
+        err = EPROTO;
+        goto fail;
+    }
+
+    r->size = (size_t)st.st_size;
+    r->map  = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+    if (r->map == MAP_FAILED) {
+        r->map = NULL;
+        goto fail_errno;
+    }
+    madvise((void *)r->map, r->size, MADV_SEQUENTIAL);
+
+    r->hdr = (const GpsRecHeader *)r->map;
+    if (memcmp(r->hdr->magic, GPS_REC_MAGIC, sizeof(GPS_REC_MAGIC)) != 0 ||
+        r->hdr->version != GPS_REC_VERSION) {
+        err = EPROTO;
+        goto fail;
+    }
+    if (load_tail(r) < 0 && scan_blocks(r) < 0) {
+        err = ENOMEM;
+        goto fail;
+    }
+    return 0;
+
+fail_errno:
+    err = errno;
+fail:
+    if (r->map) munmap((void *)r->map, r->size);
+    free(r->scanned);
+    close(r->fd);
+    r->map     = NULL;
+    r->scanned = NULL;
+    errno = err;
+    return -1;
+}
+
+int gps_rec_next(GpsRecReader *r, GpsRecord *rec)
+{
+    for (;;) {
+        // 원시 레코드 안의 청크
+        if (r->sub < r->sub_end) {
+            uint32_t ent;
+            size_t   k;
+
+            memcpy(&ent, r->map + r->sub, CHUNK_HDR);
+            k = ent & 0xFFF;
+            if (r->sub + CHUNK_HDR + k > r->sub_end) {
+                r->sub = r->sub_end;                // 깨진 레코드
+                continue;
+            }
+            rec->type = GPS_REC_RAW;
+            rec->len  = (uint16_t)k;
+            rec->t_ns = r->sub_t + (int64_t)(ent >> 12) * 1000;
+            rec->data = r->map + r->sub + CHUNK_HDR;
+            r->sub += CHUNK_HDR + k;
+            return 1;
+        }
+
+        while (r->pos >= r->end) {
+            const GpsRecBlock *b;
+            uint64_t           off;
+
+            if (r->blk >= r->blocks) return 0;
+            off = r->index[r->blk++].offset;
+            if (off + sizeof(GpsRecBlock) > r->size) continue;
+            b = (const GpsRecBlock *)(r->map + off);
+            if (b->magic != GPS_REC_BLOCK_MAGIC ||
+                off + sizeof(GpsRecBlock) + b->bytes > r->size)
+                continue;
+            r->pos = off + sizeof(GpsRecBlock);
+            r->end = r->pos + b->bytes;
+        }
+
+        const GpsRecHdr *h = (const GpsRecHdr *)(r->map + r->pos);
+        if (r->pos + sizeof(GpsRecHdr) > r->end ||
+            r->pos + sizeof(GpsRecHdr) + h->len > r->end) {
+            r->pos = r->end;                        // 깨진 블록: 나머지 건너뜀
+            continue;
+        }
+        if (h->type == GPS_REC_RAW) {
+            r->sub     = r->pos + sizeof(GpsRecHdr);
+            r->sub_end = r->sub + h->len;
+            r->sub_t   = h->t_ns;
+            r->pos    += sizeof(GpsRecHdr) + ALIGN8(h->len);
+            continue;
+        }
+        rec->type = h->type;
+        rec->len  = h->len;
+        rec->t_ns = h->t_ns;
+        rec->data = r->map + r->pos + sizeof(GpsRecHdr);
+        r->pos += sizeof(GpsRecHdr) + ALIGN8(h->len);
+        return 1;
+    }
+}
+
+void gps_rec_seek(GpsRecReader *r, int64_t t_ns)
+{
+    size_t lo = 0, hi = r->blocks;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (r->index[mid].last_ns < t_ns) lo = mid + 1;
+        else                              hi = mid;
+    }
+    r->blk = lo;
+    r->pos = r->end = 0;
+    r->sub = r->sub_end = 0;
+}
+
+void gps_rec_rewind(GpsRecReader *r)
+{
+    r->blk = 0;
+    r->pos = r->end = 0;
+    r->sub = r->sub_end = 0;
+}
+
+const GpsFix *gps_rec_fix(const GpsRecReader *r, const GpsRecord *rec)
+{
+    if (rec->type != GPS_REC_FIX || rec->len != sizeof(GpsFix) ||
+        r->hdr->fix_size != sizeof(GpsFix))
+        return NULL;
+    return rec->data;
+}
+
+void gps_rec_close(GpsRecReader *r)
+{
+    if (!r->map) return;
+    munmap((void *)r->map, r->size);
+    close(r->fd);
+    free(r->scanned);
+    r->map     = NULL;
+    r->scanned = NULL;
+    r->fd      = -1;
+}
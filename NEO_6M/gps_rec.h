@@ -0,0 +1,198 @@
+#ifndef GPS_REC_H
+#define GPS_REC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+
+// ─────────────────────────────────────────────
+//  GPS 세션 기록 파일 (.rec)
+//
+//  파일 = 헤더 + 블록 … + 블록 색인 + 꼬리
+//    블록 = 블록 헤더 + 레코드 … (레코드 = 레코드 헤더 + payload, 8B 정렬)
+//    레코드: 시리얼 원시 청크 묶음 또는 조립된 GpsFix
+//    원시 청크는 read() 1회분 (9600 baud 에서 수 바이트) 이라 레코드 하나에
+//    이어 붙이고 청크마다 4B (레코드 시각 기준 µs 차 20bit + 길이 12bit) 만 쓴다
+//  - 추가 전용: 블록은 메모리에 모았다가 write() 1회 (가득 차거나 1초마다)
+//  - 색인 / 꼬리는 정상 종료 시에만 기록, 없으면 (전원 차단 등) 열 때
+//    블록 헤더를 따라가며 다시 만들고 잘린 마지막 블록은 버린다
+//  - 읽기는 mmap, 레코드는 복사 없이 파일 매핑을 가리킨다
+//  - 정수는 기록한 기계의 바이트 순서 (Pi / x86 모두 little endian)
+// ─────────────────────────────────────────────
+
+#define GPS_REC_MAGIC       "NEO6REC"           // 헤더 magic (8B, NUL 포함)
+#define GPS_REC_VERSION     1
+#define GPS_REC_BLOCK_MAGIC 0x4B4C4236u         // "6BLK"
+#define GPS_REC_TAIL_MAGIC  0x4C494154u         // "TAIL"
+#define GPS_REC_BLOCK_MAX   (64 * 1024)         // 블록 최대 크기 (헤더 포함)
+#define GPS_REC_FLUSH_MS    1000                // 이보다 오래된 블록은 기록
+#define GPS_REC_CHUNK_MAX   4095                // 청크 1개 최대 바이트 (넘으면 나눔)
+#define GPS_REC_CHUNK_DT_US ((1 << 20) - 1)     // 원시 레코드 시각 기준 최대 µs 차
+
+// 레코드 종류
+enum {
+    GPS_REC_RAW = 1,        // 시리얼 원시 청크 (t_ns = 수신 시각, 파일에는 묶음으로)
+    GPS_REC_FIX = 2,        // GpsFix (t_ns = 발행 시각)
+};
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t fix_size;      // 기록 당시 sizeof(GpsFix)
+    int64_t  mono_ns;       // 기록 시작 CLOCK_MONOTONIC
+    int64_t  real_ns;       // 같은 순간 CLOCK_REALTIME (파일 이름 / 표시용)
+    int32_t  baud;
+    uint32_t block_max;
+    char     dev[24];       // 장치 경로 (잘릴 수 있음)
+} GpsRecHeader;
+
+typedef struct {
+    uint32_t magic;         // GPS_REC_BLOCK_MAGIC
+    uint32_t bytes;         // 레코드 영역 바이트 (블록 헤더 제외)
+    uint32_t records;
+    uint32_t fixes;
+    int64_t  first_ns, last_ns;
+} GpsRecBlock;
+
+typedef struct {
+    uint16_t type;          // GPS_REC_*
+    uint16_t len;           // payload 바이트 (정렬 패딩 제외)
+    uint32_t reserved;
+    int64_t  t_ns;          // CLOCK_MONOTONIC
+} GpsRecHdr;
+
+typedef struct {
+    uint64_t offset;        // 블록 헤더 파일 위치
+    int64_t  first_ns, last_ns;
+    uint32_t records, fixes;
+} GpsRecIndex;
+
+typedef struct {
+    uint32_t magic;         // GPS_REC_TAIL_MAGIC
+    uint32_t blocks;
+    uint64_t index_off;
+    uint64_t records;
+    uint64_t fixes;
+} GpsRecTail;
+
+typedef struct {
+    uint64_t records;
+    uint64_t fixes;
+    uint64_t chunks;        // 원시 청크 수
+    uint64_t raw_bytes;     // 원시 청크 payload 합
+    uint64_t writes;        // write() 호출 (블록 수)
+    uint64_t file_bytes;
+} GpsRecStats;
+
+// ─────────────────────────────────────────────
+//  기록 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    int           fd;
+    uint8_t      *buf;          // 현재 블록 (블록 헤더 자리 포함)
+    size_t        len;
+    GpsRecBlock   blk;
+    GpsRecIndex  *index;
+    size_t        blocks, index_cap;
+    int           index_lost;   // 메모리 부족으로 색인 포기 (꼬리 없이 닫음)
+    size_t        raw_off;      // 이어 붙일 수 있는 원시 레코드 위치 (0: 없음)
+    int64_t       raw_t;        // 그 레코드의 시각
+    uint64_t      off;          // 파일 끝
+    GpsRecStats   stats;
+} GpsRecWriter;
+
+/**
+ * @brief 기록 파일 생성 (있으면 덮어씀)
+ * @param baud / dev 헤더에 남길 입력 정보 (dev NULL 가능)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_rec_create(GpsRecWriter *w, const char *path, int baud, const char *dev);
+
+/**
+ * @brief 시리얼 원시 청크 기록 (GPS_REC_CHUNK_MAX 보다 길면 나눠 기록)
+ * @return 0: 성공, -1: write 실패 (errno 설정)
+ */
+int gps_rec_write_raw(GpsRecWriter *w, const void *data, size_t len, int64_t rx_ns);
+
+/**
+ * @brief GpsFix 기록 (시각 = fix->pub_ns)
+ * @return 0: 성공, -1: write 실패 (errno 설정)
+ */
+int gps_rec_write_fix(GpsRecWriter *w, const GpsFix *fix);
+
+/**
+ * @brief 현재 블록이 GPS_REC_FLUSH_MS 보다 오래됐으면 기록 (무수신 구간용)
+ * @return 0: 성공, -1: write 실패 (errno 설정)
+ */
+int gps_rec_poll(GpsRecWriter *w, int64_t now_ns);
+
+/**
+ * @brief 현재 블록 즉시 기록
+ * @return 0: 성공, -1: write 실패 (errno 설정)
+ */
+int gps_rec_flush(GpsRecWriter *w);
+
+/**
+ * @brief 남은 블록 + 색인 + 꼬리 기록 후 닫기
+ * @return 0: 성공, -1: 실패 (errno 설정, 파일은 닫힘 / 색인 없이도 읽을 수 있음)
+ */
+int gps_rec_finish(GpsRecWriter *w);
+
+// ─────────────────────────────────────────────
+//  재생 (mmap)
+// ─────────────────────────────────────────────
+typedef struct {
+    uint16_t    type;
+    uint16_t    len;
+    int64_t     t_ns;
+    const void *data;           // 파일 매핑 안, 닫을 때까지 유효 (GPS_REC_FIX 는 8B 정렬)
+} GpsRecord;
+
+typedef struct {
+    int                 fd;
+    const uint8_t      *map;
+    size_t              size;
+    const GpsRecHeader *hdr;
+    const GpsRecIndex  *index;
+    size_t              blocks;
+    GpsRecIndex        *scanned;    // 꼬리가 없어 다시 만든 색인
+    uint64_t            records, fixes;
+    size_t              blk;        // 읽는 중인 블록
+    uint64_t            pos, end;   // 블록 안 위치
+    uint64_t            sub, sub_end;   // 원시 레코드 안 청크 위치
+    int64_t             sub_t;
+} GpsRecReader;
+
+/**
+ * @brief 기록 파일 열기 (색인 확인, 없으면 블록을 따라가며 복구)
+ * @return 0: 성공, -1: 실패 (errno 설정, 형식이 다르면 EPROTO)
+ */
+int gps_rec_open(GpsRecReader *r, const char *path);
+
+/**
+ * @brief 다음 레코드 (원시 레코드는 청크 하나씩)
+ * @return 1: 읽음, 0: 끝
+ */
+int gps_rec_next(GpsRecReader *r, GpsRecord *rec);
+
+/**
+ * @brief t_ns 이후 레코드를 포함하는 첫 블록으로 이동 (색인 이분 탐색)
+ */
+void gps_rec_seek(GpsRecReader *r, int64_t t_ns);
+
+/**
+ * @brief 처음으로 이동
+ */
+void gps_rec_rewind(GpsRecReader *r);
+
+/**
+ * @brief 레코드의 GpsFix (기록 당시 크기가 다르면 NULL)
+ */
+const GpsFix *gps_rec_fix(const GpsRecReader *r, const GpsRecord *rec);
+
+/**
+ * @brief 닫기
+ */
+void gps_rec_close(GpsRecReader *r);
+
+#endif /* GPS_REC_H */
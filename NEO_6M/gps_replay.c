@@ -0,0 +1,281 @@
+// GPS 세션 재생 (gps_record 로 만든 .rec)
+//
+// 기본: 원시 청크를 기록 당시 수신 시각으로 gps_stream → gps_epoch 에 넣고
+//       fix 마다 평균 윈도우 (neo_6m_fixed / gps_neo) 와 Kalman (kalman_neo) 을 돌린다.
+//       epoch 조립기는 재생 시계를 쓰므로 배속과 관계없이 같은 fix 가 나온다.
+// -p:   pty 로 원시 청크를 기록 간격대로 송신 (기존 도구를 그대로 연결)
+//
+// 실행: ./gps_replay [-x speed] [-t sec] [-F] [-w window] [-q q_accel] [-u uere]
+//                    [-O dlat,dlon] [-c out.csv] file.rec
+//       ./gps_replay -p [-x speed] [-t sec] file.rec
+//         -x  배속 (기본 1, 0 = 최대 속도)
+//         -t  기록 시작 후 sec 초부터 (블록 색인으로 이동)
+//         -F  다시 파싱하지 않고 기록된 fix 레코드 사용
+//         -w  평균 윈도우 크기 (기본 20), -q / -u  Kalman 가속도 PSD / UERE
+//         -O  출력 위치에 더할 오프셋 (도, LAT_OFFSET / LON_OFFSET 조정용)
+//         -c  fix 마다 raw / 윈도우 평균 / Kalman 위치 CSV
+
+#define _GNU_SOURCE             // posix_openpt, ptsname_r
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "geo.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_rec.h"
+#include "gps_stream.h"
+#include "win_stat.h"
+
+#define DEFAULT_WINDOW  20      // neo_6m_fixed / gps_neo QUEUE_SIZE
+
+typedef struct {
+    WinPos   win;
+    GpsKf    kf;
+    double   dlat, dlon;
+    FILE    *csv;
+    int64_t  t0;                // 첫 레코드 시각
+    long     fixes;
+    long     with_pos;
+    long     win_rejected;
+    double   win_err2;          // Σ |raw - 윈도우 평균|²
+    double   kf_err2;           // Σ |raw - Kalman|²
+} Replay;
+
+static int64_t vnow;            // 재생 시계 (기록 당시 CLOCK_MONOTONIC)
+
+static int64_t vclock(void)
+{
+    return vnow;
+}
+
+static void sleep_until(int64_t t_ns)
+{
+    struct timespec ts = { .tv_sec = t_ns / 1000000000LL, .tv_nsec = t_ns % 1000000000LL };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+        ;
+}
+
+// ─────────────────────────────────────────────
+//  필터 파이프라인
+// ─────────────────────────────────────────────
+static void on_fix(const GpsFix *f, void *user)
+{
+    Replay *r = user;
+    double  lat, lon, avg_lat, avg_lon, kf_lat, kf_lon, n, e;
+
+    r->fixes++;
+    if (!(f->valid & GPS_V_POS)) return;
+    r->with_pos++;
+
+    lat = nmea_e7_to_deg(f->lat);
+    lon = nmea_e7_to_deg(f->lon);
+    if (!win_pos_push(&r->win, lat, lon)) r->win_rejected++;
+    win_pos_mean(&r->win, &avg_lat, &avg_lon);
+    gps_kf_update_fix(&r->kf, f);
+    gps_kf_position(&r->kf, &kf_lat, &kf_lon);
+
+    geo_offset(avg_lat, avg_lon, lat, lon, &n, &e);
+    r->win_err2 += n * n + e * e;
+    geo_offset(kf_lat, kf_lon, lat, lon, &n, &e);
+    r->kf_err2 += n * n + e * e;
+
+    if (r->csv)
+        fprintf(r->csv, "%.3f,%.7f,%.7f,%.2f,%d,%.7f,%.7f,%.7f,%.7f,%.2f\n",
+                (f->end_ns - r->t0) / 1e9, lat, lon, f->hdop / 100.0, f->num_sats,
+                avg_lat + r->dlat, avg_lon + r->dlon,
+                kf_lat + r->dlat, kf_lon + r->dlon, gps_kf_sigma(&r->kf));
+}
+
+// ─────────────────────────────────────────────
+//  pty 송신
+// ─────────────────────────────────────────────
+static int open_pty(char *path, size_t len)
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0) return -1;
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0 || ptsname_r(fd, path, len) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief slave 를 누가 열 때까지 대기 (열리기 전 master 는 POLLHUP)
+ */
+static void wait_slave(int master)
+{
+    struct pollfd p = { .fd = master, .events = POLLIN };
+
+    for (;;) {
+        if (poll(&p, 1, 0) >= 0 && !(p.revents & POLLHUP)) return;
+        usleep(50000);
+    }
+}
+
+static int run_pty(GpsRecReader *rd, double speed)
+{
+    char path[64];
+    int  master = open_pty(path, sizeof(path));
+
+    if (master < 0) { perror("pty"); return 1; }
+    printf("%s  (%s, %d baud, x%g) waiting for reader...\n",
+           path, rd->hdr->dev, rd->hdr->baud, speed);
+    fflush(stdout);
+    wait_slave(master);
+
+    GpsRecord rec;
+    int64_t   t_first = -1, wall0 = gps_now_ns();
+    uint64_t  bytes = 0;
+    while (gps_rec_next(rd, &rec)) {
+        if (rec.type != GPS_REC_RAW) continue;
+        if (t_first < 0) t_first = rec.t_ns;
+        if (speed > 0)
+            sleep_until(wall0 + (int64_t)((rec.t_ns - t_first) / speed));
+        if (write(master, rec.data, rec.len) != rec.len) {
+            perror("pty write");
+            break;
+        }
+        bytes += rec.len;
+    }
+    printf("sent %llu bytes in %.1f s\n", (unsigned long long)bytes,
+           (gps_now_ns() - wall0) / 1e9);
+    // 마지막 epoch 가 timeout 으로 발행될 여유
+    usleep(200000);
+    close(master);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    double      speed = 1.0, start = 0.0, q = 0.0, uere = 0.0;
+    int         pty = 0, use_fix = 0, window = DEFAULT_WINDOW, opt;
+    const char *csv = NULL;
+    Replay      r = {0};
+
+    while ((opt = getopt(argc, argv, "x:t:pFw:q:u:O:c:")) != -1) {
+        switch (opt) {
+            case 'x': speed   = atof(optarg); break;
+            case 't': start   = atof(optarg); break;
+            case 'p': pty     = 1;            break;
+            case 'F': use_fix = 1;            break;
+            case 'w': window  = atoi(optarg); break;
+            case 'q': q       = atof(optarg); break;
+            case 'u': uere    = atof(optarg); break;
+            case 'c': csv     = optarg;       break;
+            case 'O':
+                if (sscanf(optarg, "%lf,%lf", &r.dlat, &r.dlon) == 2) break;
+                /* fall through */
+            default:
+                fprintf(stderr, "usage: %s [-p] [-x speed] [-t sec] [-F] [-w window] [-q q_accel]\n"
+                                "       [-u uere] [-O dlat,dlon] [-c out.csv] file.rec\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc || speed < 0 || window < 1) {
+        fprintf(stderr, "usage: %s [options] file.rec\n", argv[0]);
+        return 1;
+    }
+
+    GpsRecReader rd;
+    if (gps_rec_open(&rd, argv[optind]) < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    if (rd.blocks == 0) {
+        fprintf(stderr, "%s: no records\n", argv[optind]);
+        gps_rec_close(&rd);
+        return 1;
+    }
+
+    r.t0 = rd.index[0].first_ns;
+    int64_t span = rd.index[rd.blocks - 1].last_ns - r.t0;
+    printf("%s: %s %d baud, %.1f s, %zu blocks (%s), %llu records, %llu fixes\n",
+           argv[optind], rd.hdr->dev, rd.hdr->baud, span / 1e9, rd.blocks,
+           rd.scanned ? "index recovered" : "indexed",
+           (unsigned long long)rd.records, (unsigned long long)rd.fixes);
+    if (start > 0) gps_rec_seek(&rd, r.t0 + (int64_t)(start * 1e9));
+
+    if (pty) {
+        int rc = run_pty(&rd, speed);
+        gps_rec_close(&rd);
+        return rc;
+    }
+
+    if (win_pos_init(&r.win, (size_t)window) < 0) {
+        perror("win_pos_init");
+        gps_rec_close(&rd);
+        return 1;
+    }
+    gps_kf_init(&r.kf, q);
+    gps_kf_set_uere(&r.kf, uere);
+    if (csv) {
+        r.csv = fopen(csv, "w");
+        if (!r.csv) { perror(csv); return 1; }
+        fprintf(r.csv, "t,lat,lon,hdop,sats,avg_lat,avg_lon,kf_lat,kf_lon,kf_sigma\n");
+    }
+
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    gps_epoch_init(&ep, on_fix, &r);
+    gps_epoch_set_clock(&ep, vclock);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+
+    GpsRecord rec;
+    int64_t   t_first = -1, t_last = 0, last_rx = 0, timeout = GPS_EPOCH_TIMEOUT_MS * 1000000LL;
+    int64_t   wall0 = gps_now_ns();
+    uint64_t  bytes = 0;
+    while (gps_rec_next(&rd, &rec)) {
+        if (t_first < 0) t_first = rec.t_ns;
+        t_last = rec.t_ns;
+        if (speed > 0)
+            sleep_until(wall0 + (int64_t)((rec.t_ns - t_first) / speed));
+
+        if (use_fix) {
+            const GpsFix *f = gps_rec_fix(&rd, &rec);
+            if (f) on_fix(f, &r);
+            continue;
+        }
+        if (rec.type != GPS_REC_RAW) continue;
+
+        // 청크 사이 무수신 구간: 기록 당시처럼 timeout 판정
+        if (last_rx && rec.t_ns - last_rx > timeout) {
+            vnow = last_rx + timeout;
+            gps_epoch_poll(&ep, last_rx, vnow);
+        }
+        vnow = rec.t_ns;
+        gps_stream_feed(&stream, rec.data, rec.len, rec.t_ns);
+        last_rx = rec.t_ns;
+        bytes  += rec.len;
+    }
+    if (!use_fix) gps_epoch_flush(&ep);
+    double wall = (gps_now_ns() - wall0) / 1e9;
+    double data = (t_last - t_first) / 1e9;
+
+    printf("replayed %.1f s of data in %.3f s (x%.0f), %.0f epochs/s, %.1f MB/s\n",
+           data, wall, wall > 0 ? data / wall : 0.0, wall > 0 ? r.fixes / wall : 0.0,
+           wall > 0 ? bytes / wall / 1e6 : 0.0);
+    printf("fixes %ld (%ld with position)  window %d: rejected %ld, RMS to raw %.2f m\n",
+           r.fixes, r.with_pos, window, r.win_rejected,
+           r.with_pos ? sqrt(r.win_err2 / r.with_pos) : 0.0);
+    printf("kalman q %.2f uere %.2f: updates %llu rejected %llu resets %llu, RMS to raw %.2f m\n",
+           r.kf.q, r.kf.uere, (unsigned long long)r.kf.stats.updates,
+           (unsigned long long)r.kf.stats.rejected, (unsigned long long)r.kf.stats.resets,
+           r.with_pos ? sqrt(r.kf_err2 / r.with_pos) : 0.0);
+
+    if (r.csv) fclose(r.csv);
+    win_pos_free(&r.win);
+    gps_rec_close(&rd);
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include "gps_route.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void gps_route_init(GpsRoute *r, GpsRouteEventCb cb, void *user)
+{
+    memset(r, 0, sizeof(GpsRoute));
+    r->radius = GPS_ROUTE_ARRIVE_M;
+    r->cb     = cb;
+    r->user   = user;
+}
+
+void gps_route_set_radius(GpsRoute *r, double radius_m)
+{
+    r->radius = (radius_m > 0.0) ? radius_m : GPS_ROUTE_ARRIVE_M;
+}
+
+int gps_route_add(GpsRoute *r, double lat, double lon, double radius_m)
+{
+    double e, n;
+
+    if (r->nwp == 0) {
+        geo_ltp_init(&r->ltp, lat, lon, 0.0);
+        r->last_e = r->last_n = 0.0;
+        return (int)r->nwp++;
+    }
+
+    geo_ltp_fwd(&r->ltp, lat, lon, &e, &n);
+    double de = e - r->last_e, dn = n - r->last_n, len = sqrt(de * de + dn * dn);
+    if (len < GPS_ROUTE_MIN_SEG_M) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (r->nseg == r->cap_seg) {
+        size_t       cap = r->cap_seg ? r->cap_seg * 2 : 16;
+        GpsRouteSeg *p   = realloc(r->seg, cap * sizeof(GpsRouteSeg));
+        if (!p) {
+            errno = ENOMEM;
+            return -1;
+        }
+        r->seg     = p;
+        r->cap_seg = cap;
+    }
+
+    // 직전 구간의 전환선: 두 방향의 이등분 (거의 되돌아가면 직전 구간 끝 수직선)
+    double ue = de / len, un = dn / len;
+    if (r->nseg > 0) {
+        GpsRouteSeg *p  = &r->seg[r->nseg - 1];
+        double       se = p->ue + ue, sn = p->un + un, sl = sqrt(se * se + sn * sn);
+        if (sl > 1e-6) {
+            p->se = se / sl;
+            p->sn = sn / sl;
+        }
+    }
+
+    GpsRouteSeg *s = &r->seg[r->nseg++];
+    s->ae      = r->last_e;
+    s->an      = r->last_n;
+    s->be      = e;
+    s->bn      = n;
+    s->ue      = ue;
+    s->un      = un;
+    s->se      = ue;
+    s->sn      = un;
+    s->len     = len;
+    s->bearing = atan2(de, dn) * (180.0 / M_PI);
+    if (s->bearing < 0.0) s->bearing += 360.0;
+    r->total  += len;
+    s->cum_end = r->total;
+    s->radius  = (radius_m > 0.0) ? radius_m : r->radius;
+
+    r->last_e = e;
+    r->last_n = n;
+    return (int)r->nwp++;
+}
+
+int gps_route_load(GpsRoute *r, const char *path, int *bad_line)
+{
+    FILE *fp = fopen(path, "r");
+    char  line[256];
+    int   lineno = 0, loaded = 0, err = 0;
+
+    if (bad_line) *bad_line = 0;
+    if (!fp) return -1;
+
+    while (fgets(line, sizeof(line), fp)) {
+        char  *s = line;
+        double lat, lon, radius = 0.0;
+
+        lineno++;
+        while (*s == ' ' || *s == '\t') s++;
+        if (*s == '\0' || *s == '\n' || *s == '\r' || *s == '#') continue;
+        errno = 0;
+        if (sscanf(s, "%lf ,%lf ,%lf", &lat, &lon, &radius) < 2 ||
+            gps_route_add(r, lat, lon, radius) < 0) {
+            err = errno ? errno : EINVAL;
+            if (err == EINVAL && bad_line) *bad_line = lineno;
+            break;
+        }
+        loaded++;
+    }
+    fclose(fp);
+    if (err) {
+        errno = err;
+        return -1;
+    }
+    return loaded;
+}
+
+/**
+ * @brief 현재 구간 기준 상태 계산
+ */
+static void route_state(const GpsRoute *r, double e, double n, GpsRouteState *s)
+{
+    const GpsRouteSeg *g = &r->seg[r->cur];
+    double de = e - g->ae, dn = n - g->an;
+    double we = g->be - e, wn = g->bn - n;
+
+    s->seg        = r->cur;
+    s->e          = e;
+    s->n          = n;
+    s->along      = de * g->ue + dn * g->un;
+    s->xte        = de * g->un - dn * g->ue;
+    s->dist_wp    = sqrt(we * we + wn * wn);
+    s->dist_to_go = s->dist_wp + (r->total - g->cum_end);
+    s->bearing    = g->bearing;
+    s->finished   = r->finished;
+    if (s->dist_wp > 1e-9) {
+        s->wp_ue = we / s->dist_wp;
+        s->wp_un = wn / s->dist_wp;
+    } else {
+        s->wp_ue = g->ue;
+        s->wp_un = g->un;
+    }
+}
+
+int gps_route_update_enu(GpsRoute *r, double e, double n, GpsRouteState *s)
+{
+    GpsRouteState st;
+    int           events = 0;
+
+    if (r->nseg == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (!s) s = &st;
+
+    for (;;) {
+        const GpsRouteSeg *g = &r->seg[r->cur];
+
+        route_state(r, e, n, s);
+        if (r->finished) break;
+        if (s->dist_wp > g->radius && (e - g->be) * g->se + (n - g->bn) * g->sn < 0.0) break;
+
+        events++;
+        if (r->cur + 1 < r->nseg) {
+            // 도달 시점 상태로 알리고 다음 구간으로
+            if (r->cb) r->cb(GPS_ROUTE_WAYPOINT, r->cur + 1, s, r->user);
+            r->cur++;
+            r->switches++;
+            continue;
+        }
+        r->finished = 1;
+        s->finished = 1;
+        if (r->cb) r->cb(GPS_ROUTE_FINISHED, r->cur + 1, s, r->user);
+        break;
+    }
+    return events;
+}
+
+int gps_route_update(GpsRoute *r, double lat, double lon, GpsRouteState *s)
+{
+    double e, n;
+
+    geo_ltp_fwd(&r->ltp, lat, lon, &e, &n);
+    return gps_route_update_enu(r, e, n, s);
+}
+
+void gps_route_restart(GpsRoute *r)
+{
+    r->cur      = 0;
+    r->finished = 0;
+}
+
+double gps_route_length(const GpsRoute *r)
+{
+    return r->total;
+}
+
+void gps_route_free(GpsRoute *r)
+{
+    free(r->seg);
+    memset(r, 0, sizeof(GpsRoute));
+}
@@ -0,0 +1,122 @@
+#ifndef GPS_ROUTE_H
+#define GPS_ROUTE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "geo.h"
+
+// ─────────────────────────────────────────────
+//  waypoint 경로 추종 (구간 기하 미리 계산, fix 당 상수 시간)
+//
+//  waypoint 를 추가할 때 첫 waypoint 기준 접평면 (GeoLtp) 으로 투영하고 구간마다
+//  단위 방향 / 길이 / 방위 / 시작부터 누적 길이를 저장한다. fix 마다는
+//  geo_ltp_fwd (곱셈·덧셈) + 내적 / 외적 + sqrt 1회로
+//    진행 거리, 교차 오차 (cross-track), 목표까지 거리, 남은 거리
+//  를 구한다. 삼각함수는 waypoint 추가 때 (구간 방위 atan2) 만 부른다.
+//
+//  목표 waypoint 전환: 도착 반경 안에 들어오거나, waypoint 에서 이 구간과 다음 구간
+//  방향의 이등분선을 넘으면 다음 구간으로 (마지막 구간은 끝 수직선). 급선회에서도
+//  두 구간 사이를 지나가면 반드시 넘으므로 도착 반경을 놓쳐도 멈추지 않는다.
+//  한 fix 에 짧은 구간 여러 개를 지나면 이벤트도 여러 번 (fix 당 상각 상수 시간).
+//  접평면 근사라 첫 waypoint 에서 10 km 이내 cm 수준 (geo.h).
+// ─────────────────────────────────────────────
+
+#define GPS_ROUTE_ARRIVE_M  3.0         // 기본 도착 반경 (m), NEO-6M CEP 2.5 m
+#define GPS_ROUTE_MIN_SEG_M 0.01        // 이보다 짧은 구간 (중복 waypoint) 은 거부
+
+typedef struct {
+    double   ae, an;                    // 시작 waypoint (접평면 m)
+    double   be, bn;                    // 끝 waypoint (= 목표)
+    double   ue, un;                    // 단위 방향
+    double   se, sn;                    // 전환선 법선 (다음 구간과의 이등분, 마지막은 ue, un)
+    double   len;
+    double   bearing;                   // 구간 방위 (도, 북 0 시계 방향)
+    double   cum_end;                   // 경로 시작 → 끝 waypoint 누적 길이
+    double   radius;                    // 끝 waypoint 도착 반경
+} GpsRouteSeg;
+
+typedef enum {
+    GPS_ROUTE_WAYPOINT = 0,             // 중간 waypoint 도달 (다음 구간으로 전환)
+    GPS_ROUTE_FINISHED,                 // 마지막 waypoint 도달
+} GpsRouteEvent;
+
+typedef struct {
+    uint32_t seg;                       // 현재 구간 (목표 waypoint = seg + 1)
+    double   e, n;                      // 현재 위치 (접평면)
+    double   along;                     // 구간 시작부터 진행 거리 (시작 전이면 음수)
+    double   xte;                       // 교차 오차 (m, + 진행 방향 오른쪽)
+    double   dist_wp;                   // 목표 waypoint 까지 직선 거리
+    double   dist_to_go;                // dist_wp + 목표 이후 구간 길이 합
+    double   bearing;                   // 현재 구간 방위 (도)
+    double   wp_ue, wp_un;              // 목표 waypoint 방향 단위 벡터 (도착하면 구간 방향)
+    int      finished;
+} GpsRouteState;
+
+typedef void (*GpsRouteEventCb)(GpsRouteEvent ev, uint32_t wp, const GpsRouteState *s,
+                                void *user);
+
+// ─────────────────────────────────────────────
+//  경로 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GeoLtp          ltp;
+    double          last_e, last_n;     // 마지막 waypoint (다음 구간의 시작)
+    size_t          nwp;
+    GpsRouteSeg    *seg;
+    size_t          nseg, cap_seg;
+    double          total;              // 경로 전체 길이
+    double          radius;             // 기본 도착 반경
+    uint32_t        cur;
+    int             finished;
+    GpsRouteEventCb cb;
+    void           *user;
+    uint64_t        switches;
+} GpsRoute;
+
+/**
+ * @brief 빈 경로 (waypoint 를 추가한 뒤 gps_route_update)
+ */
+void gps_route_init(GpsRoute *r, GpsRouteEventCb cb, void *user);
+
+/**
+ * @brief 기본 도착 반경 (이후 추가하는 waypoint 부터, 0 이하이면 GPS_ROUTE_ARRIVE_M)
+ */
+void gps_route_set_radius(GpsRoute *r, double radius_m);
+
+/**
+ * @brief waypoint 추가 (위도/경도 도)
+ * @param radius_m 도착 반경, 0 이하이면 기본값
+ * @return waypoint 번호, -1: 실패 (errno: EINVAL 직전 waypoint 와 같은 위치, ENOMEM)
+ */
+int gps_route_add(GpsRoute *r, double lat, double lon, double radius_m);
+
+/**
+ * @brief 텍스트 파일에서 waypoint 읽기 (한 줄에 `위도,경도[,반경]`, # 주석)
+ * @return 읽은 waypoint 수, -1: 실패 (errno 설정, 형식 오류는 EINVAL 과 *bad_line)
+ */
+int gps_route_load(GpsRoute *r, const char *path, int *bad_line);
+
+/**
+ * @brief 위치 갱신 (waypoint 2개 이상)
+ * @return 이번 갱신에서 발생한 이벤트 수, -1: waypoint 부족 (EINVAL)
+ */
+int gps_route_update(GpsRoute *r, double lat, double lon, GpsRouteState *s);
+
+/**
+ * @brief 위치 갱신 (경로 접평면 m)
+ */
+int gps_route_update_enu(GpsRoute *r, double e, double n, GpsRouteState *s);
+
+/**
+ * @brief 첫 구간부터 다시 시작
+ */
+void gps_route_restart(GpsRoute *r);
+
+/**
+ * @brief 경로 전체 길이 (m)
+ */
+double gps_route_length(const GpsRoute *r);
+
+void gps_route_free(GpsRoute *r);
+
+#endif /* GPS_ROUTE_H */
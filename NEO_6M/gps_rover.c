@@ -0,0 +1,214 @@
+// 차분 보정 이동국
+//
+// 기준국 (gps_base) 이 UDP 로 보내는 epoch 별 오차를 같은 UTC epoch 의 fix 에 적용한 뒤
+// ENU Kalman 필터 (DGPS 는 측정 σ 절반) 를 돌린다. kalman_neo / gps_neo 의 고정
+// LAT_OFFSET / LON_OFFSET 대신 쓰는 도구.
+//
+// 실행: ./gps_rover [-b baud] [-p port] [-H hold_ms] [-A max_age_ms] [-q q_accel] [-c out.csv] [dev]
+//         -H  같은 epoch 보정을 기다리는 시간 (기본 GPS_DGPS_HOLD_MS, 0: 최근 보정 바로 사용)
+//         -A  최근 보정을 쓸 수 있는 최대 나이
+//         -c  fix 마다 원시 / 보정 / 필터 위치, 보정 나이 / 지연 CSV
+//
+// 기록으로 시험: 같은 시간에 기록한 두 .rec 를 각각 gps_replay -p 로 내보내고
+//               gps_base / gps_rover 를 각 pty 에 연결 (같은 호스트면 지연도 의미 있음)
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_dgps.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+
+typedef struct {
+    GpsDgpsRover rover;
+    GpsKf        kf;
+    FILE        *csv;
+    int64_t      latency_sum;
+    uint64_t     latency_n;
+    int64_t      latency_max;
+    int64_t      hold_sum;
+} Rover;
+
+// 보정 전 위치 (콜백은 대기열을 거쳐 늦게 오므로 seq 로 찾음)
+static int32_t raw_pos[GPS_DGPS_PEND * 2][2];
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+static const char *match_name(GpsDgpsMatch m)
+{
+    switch (m) {
+        case GPS_DGPS_MATCHED: return "matched";
+        case GPS_DGPS_OLDER:   return "older";
+        default:               return "none";
+    }
+}
+
+// 보정한 fix (순서대로)
+static void on_corrected(const GpsFix *f, void *user)
+{
+    Rover                *r = user;
+    const GpsDgpsApplied *a = &r->rover.last;
+    const int32_t        *raw = raw_pos[f->seq % (GPS_DGPS_PEND * 2)];
+    double                lat, lon;
+
+    if (!(f->valid & GPS_V_POS)) return;
+    if (a->match != GPS_DGPS_NONE) {
+        r->latency_sum += a->latency_ns;
+        r->hold_sum    += a->hold_ns;
+        r->latency_n++;
+        if (a->latency_ns > r->latency_max) r->latency_max = a->latency_ns;
+    }
+    gps_kf_update_fix(&r->kf, f);
+    gps_kf_position(&r->kf, &lat, &lon);
+
+    printf("%02d:%02d:%02d.%03d  raw %.7f, %.7f  dgps %.7f, %.7f (%s",
+           f->time_ms / 3600000, f->time_ms / 60000 % 60, f->time_ms / 1000 % 60, f->time_ms % 1000,
+           nmea_e7_to_deg(raw[0]), nmea_e7_to_deg(raw[1]),
+           nmea_e7_to_deg(f->lat), nmea_e7_to_deg(f->lon), match_name(a->match));
+    if (a->match != GPS_DGPS_NONE)
+        printf(", age %d ms, dE %+.2f dN %+.2f, base %.0f m", a->age_ms, a->de, a->dn, a->baseline_m);
+    printf(")  filtered %.7f, %.7f (sigma %.1fm)\n", lat, lon, gps_kf_sigma(&r->kf));
+
+    if (r->csv)
+        fprintf(r->csv, "%d,%.7f,%.7f,%.7f,%.7f,%s,%d,%.3f,%.3f,%.1f,%.3f,%.3f,%.7f,%.7f,%.2f\n",
+                f->time_ms, nmea_e7_to_deg(raw[0]), nmea_e7_to_deg(raw[1]),
+                nmea_e7_to_deg(f->lat), nmea_e7_to_deg(f->lon), match_name(a->match),
+                a->age_ms, a->de, a->dn, a->baseline_m, a->latency_ns / 1e6, a->hold_ns / 1e6,
+                lat, lon, gps_kf_sigma(&r->kf));
+}
+
+// 수신기 fix → 보정 대기열
+static void on_fix(const GpsFix *f, void *user)
+{
+    Rover *r = user;
+
+    raw_pos[f->seq % (GPS_DGPS_PEND * 2)][0] = f->lat;
+    raw_pos[f->seq % (GPS_DGPS_PEND * 2)][1] = f->lon;
+    gps_dgps_rover_fix(&r->rover, f, gps_now_ns());
+}
+
+int main(int argc, char **argv)
+{
+    int         baud = GPS_SERIAL_BAUD, port = 0, hold = GPS_DGPS_HOLD_MS;
+    int         max_age = GPS_DGPS_MAX_AGE_MS, opt;
+    double      q = 0.0;
+    const char *csv = NULL;
+    Rover       r = {0};
+
+    while ((opt = getopt(argc, argv, "b:p:H:A:q:c:")) != -1) {
+        switch (opt) {
+            case 'b': baud    = atoi(optarg); break;
+            case 'p': port    = atoi(optarg); break;
+            case 'H': hold    = atoi(optarg); break;
+            case 'A': max_age = atoi(optarg); break;
+            case 'q': q       = atof(optarg); break;
+            case 'c': csv     = optarg;       break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-p port] [-H hold_ms] [-A max_age_ms]\n"
+                                "       [-q q_accel] [-c out.csv] [dev]\n", argv[0]);
+                return 1;
+        }
+    }
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+
+    if (gps_dgps_rover_init(&r.rover, port, on_corrected, &r) < 0) {
+        perror("gps_dgps_rover_init");
+        return 1;
+    }
+    gps_dgps_rover_set_policy(&r.rover, hold, max_age);
+    gps_kf_init(&r.kf, q);
+    if (csv) {
+        r.csv = fopen(csv, "w");
+        if (!r.csv) { perror(csv); return 1; }
+        fprintf(r.csv, "time_ms,lat,lon,dgps_lat,dgps_lon,match,age_ms,de,dn,baseline_m,"
+                       "latency_ms,hold_ms,kf_lat,kf_lon,kf_sigma\n");
+    }
+
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        gps_dgps_rover_free(&r.rover);
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    GpsEpoch epoch;
+    gps_epoch_init(&epoch, on_fix, &r);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &epoch);
+
+    printf("%s + udp :%d (hold %d ms, max age %d ms)\n", dev, port ? port : GPS_DGPS_PORT,
+           hold, max_age);
+    fflush(stdout);
+
+    // 시리얼과 보정 소켓을 함께 대기 (보정 도착 즉시 대기 중 fix 를 내보냄)
+    struct pollfd pfd[2] = {
+        { .fd = ser.fd,     .events = POLLIN },
+        { .fd = r.rover.fd, .events = POLLIN },
+    };
+    while (!stop) {
+        int timeout = gps_dgps_rover_timeout(&r.rover, gps_now_ns());
+        if (timeout < 0 || timeout > GPS_EPOCH_TIMEOUT_MS) timeout = GPS_EPOCH_TIMEOUT_MS;
+        if (poll(pfd, 2, timeout) < 0 && errno != EINTR) {
+            perror("poll");
+            break;
+        }
+
+        if (pfd[0].revents) {
+            int64_t rx_ns;
+            int n = gps_serial_read(&ser, buf, sizeof(buf), 0, &rx_ns);
+            if (n < 0) {
+                perror("GPS read");
+                break;
+            }
+            if (n > 0) gps_stream_feed(&stream, buf, n, rx_ns);
+        }
+        gps_epoch_poll(&epoch, ser.last_rx_ns, gps_now_ns());
+        if (gps_dgps_rover_poll(&r.rover, gps_now_ns()) < 0) {
+            perror("recv");
+            break;
+        }
+        fflush(stdout);
+    }
+
+    gps_epoch_flush(&epoch);
+    gps_dgps_rover_flush(&r.rover);
+
+    const GpsDgpsRoverStats *s = &r.rover.stats;
+    printf("fixes %llu: matched %llu, older %llu, uncorrected %llu; corrections %llu "
+           "(bad %llu, out of order %llu)\n",
+           (unsigned long long)s->fixes, (unsigned long long)s->matched,
+           (unsigned long long)s->older, (unsigned long long)s->uncorrected,
+           (unsigned long long)s->received, (unsigned long long)s->bad,
+           (unsigned long long)s->out_of_order);
+    if (r.latency_n)
+        printf("correction latency mean %.1f ms, max %.1f ms; rover hold mean %.1f ms\n",
+               r.latency_sum / 1e6 / r.latency_n, r.latency_max / 1e6,
+               r.hold_sum / 1e6 / r.latency_n);
+
+    if (r.csv) fclose(r.csv);
+    gps_serial_close(&ser);
+    gps_dgps_rover_free(&r.rover);
+    return 0;
+}
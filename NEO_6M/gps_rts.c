@@ -0,0 +1,237 @@
+#include "gps_rts.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(GpsRtsStep) == 96, "GpsRtsStep layout");
+
+// 상삼각 저장 순서
+static const int tri[4][4] = {
+    { 0, 1, 2, 3 },
+    { 1, 4, 5, 6 },
+    { 2, 5, 7, 8 },
+    { 3, 6, 8, 9 },
+};
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static void load_step(const GpsRtsStep *st, double x[4], double P[4][4])
+{
+    memcpy(x, st->x, sizeof(st->x));
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            P[i][j] = st->P[tri[i][j]];
+}
+
+/**
+ * @brief 평활 이득 C = Pf Fᵀ Pp⁻¹
+ *
+ * Pp 는 대칭 양의 정부호이므로 Cholesky 로 Pp X = F Pf 를 풀고 C = Xᵀ.
+ * F Pf 는 F = [I dt·I; 0 I] 를 풀어 씀.
+ * @return 0: 성공, -1: Pp 가 양의 정부호가 아님
+ */
+static int rts_gain(const double Pf[4][4], const double Pp[4][4], double dt, double C[4][4])
+{
+    double L[4][4] = { { 0 } }, X[4][4];
+
+    for (int j = 0; j < 4; j++) {
+        double d = Pp[j][j];
+        for (int k = 0; k < j; k++) d -= L[j][k] * L[j][k];
+        if (d <= 0.0) return -1;
+        L[j][j] = sqrt(d);
+        for (int i = j + 1; i < 4; i++) {
+            double v = Pp[i][j];
+            for (int k = 0; k < j; k++) v -= L[i][k] * L[j][k];
+            L[i][j] = v / L[j][j];
+        }
+    }
+
+    for (int c = 0; c < 4; c++) {
+        double b[4] = { Pf[0][c] + dt * Pf[2][c], Pf[1][c] + dt * Pf[3][c], Pf[2][c], Pf[3][c] };
+        double y[4];
+        for (int i = 0; i < 4; i++) {                   // L y = b
+            double v = b[i];
+            for (int k = 0; k < i; k++) v -= L[i][k] * y[k];
+            y[i] = v / L[i][i];
+        }
+        for (int i = 3; i >= 0; i--) {                  // Lᵀ x = y
+            double v = y[i];
+            for (int k = i + 1; k < 4; k++) v -= L[k][i] * X[k][c];
+            X[i][c] = v / L[i][i];
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            C[i][j] = X[j][i];
+    return 0;
+}
+
+static void emit(GpsRts *s, size_t k)
+{
+    const GpsRtsStep *st = &s->step[k];
+    GpsRtsPoint       p;
+
+    p.seq     = st->seq;
+    p.time_ms = st->time_ms;
+    p.raw_lat = st->lat;
+    p.raw_lon = st->lon;
+    p.updated = st->updated;
+    geo_ltp_inv(&s->ltp, s->sm[k][0], s->sm[k][1], &p.lat, &p.lon);
+    p.ve      = s->sm[k][2];
+    p.vn      = s->sm[k][3];
+    p.sigma   = s->sm[k][4];
+    geo_ltp_inv(&s->ltp, st->x[0], st->x[1], &p.f_lat, &p.f_lon);
+    p.f_sigma = sqrt((double)st->P[0] + st->P[4]);
+
+    s->stats.emitted++;
+    if (s->cb) s->cb(&p, s->user);
+}
+
+/**
+ * @brief 창 전체를 뒤로 평활하고 앞 out 개를 내보냄 (나머지는 다음 창 앞부분)
+ */
+static void smooth(GpsRts *s, size_t out)
+{
+    size_t m = s->count;
+    double xs[4], Ps[4][4];
+    GpsKf  pr;
+
+    if (m == 0) return;
+    if (out > m) out = m;
+
+    load_step(&s->step[m - 1], xs, Ps);
+    memcpy(s->sm[m - 1], xs, sizeof(xs));
+    s->sm[m - 1][4] = sqrt(Ps[0][0] + Ps[1][1]);
+
+    memset(&pr, 0, sizeof(pr));
+    pr.q = s->kf.q;
+    for (size_t k = m - 1; k-- > 0;) {
+        double xf[4], Pf[4][4], C[4][4], dx[4], dP[4][4], CdP[4][4];
+        double dt = s->step[k + 1].dt;
+
+        load_step(&s->step[k], xf, Pf);
+        memcpy(pr.x, xf, sizeof(xf));
+        memcpy(pr.P, Pf, sizeof(Pf));
+        gps_kf_predict(&pr, dt);                        // x⁻, P⁻ (k+1)
+
+        if (rts_gain(Pf, pr.P, dt, C) < 0) {
+            // 수치 문제: 이 epoch 는 필터 값 그대로
+            memcpy(xs, xf, sizeof(xs));
+            memcpy(Ps, Pf, sizeof(Ps));
+        } else {
+            for (int i = 0; i < 4; i++) {
+                dx[i] = xs[i] - pr.x[i];
+                for (int j = 0; j < 4; j++) dP[i][j] = Ps[i][j] - pr.P[i][j];
+            }
+            for (int i = 0; i < 4; i++) {
+                xs[i] = xf[i];
+                for (int j = 0; j < 4; j++) {
+                    xs[i] += C[i][j] * dx[j];
+                    CdP[i][j] = 0.0;
+                    for (int l = 0; l < 4; l++) CdP[i][j] += C[i][l] * dP[l][j];
+                }
+            }
+            // Ps = Pf + C dP Cᵀ (대칭 유지)
+            for (int i = 0; i < 4; i++)
+                for (int j = i; j < 4; j++) {
+                    double v = Pf[i][j];
+                    for (int l = 0; l < 4; l++) v += CdP[i][l] * C[j][l];
+                    Ps[i][j] = Ps[j][i] = v;
+                }
+        }
+        if (k < out) {
+            memcpy(s->sm[k], xs, sizeof(xs));
+            s->sm[k][4] = sqrt(Ps[0][0] + Ps[1][1]);
+        }
+    }
+    s->stats.windows++;
+    s->stats.backward_steps += m;
+
+    for (size_t k = 0; k < out; k++)
+        emit(s, k);
+    memmove(s->step, s->step + out, (m - out) * sizeof(GpsRtsStep));
+    s->count = m - out;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+int gps_rts_init(GpsRts *s, const GpsKf *kf, size_t block, size_t lag, GpsRtsCb cb, void *user)
+{
+    memset(s, 0, sizeof(GpsRts));
+    s->kf    = *kf;
+    s->block = block ? block : GPS_RTS_BLOCK;
+    s->lag   = lag ? lag : GPS_RTS_LAG;
+    s->cb    = cb;
+    s->user  = user;
+    s->step  = malloc((s->block + s->lag) * sizeof(GpsRtsStep));
+    s->sm    = malloc((s->block + s->lag) * sizeof(*s->sm));
+    if (!s->step || !s->sm) {
+        gps_rts_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+void gps_rts_push(GpsRts *s, const GpsFix *f)
+{
+    GpsKfStats before = s->kf.stats;
+    int64_t    t_prev = s->kf.t_ms;
+    double     dt;
+
+    gps_kf_update_fix(&s->kf, f);
+
+    if (s->kf.stats.resets != before.resets) {
+        // 새 구간 (원점도 바뀜): 이전 구간은 끝까지 평활
+        smooth(s, s->count);
+        s->ltp = s->kf.ltp;
+        s->stats.segments++;
+        dt = 0.0;
+    } else if (s->kf.stats.updates != before.updates || s->kf.stats.rejected != before.rejected) {
+        dt = (s->kf.t_ms - t_prev) / 1000.0;
+        if (dt < -43200.0) dt += 86400.0;               // UTC 자정 넘김 (gps_kf 와 같게)
+    } else {
+        return;                                         // 위치 없음
+    }
+
+    GpsRtsStep *st = &s->step[s->count++];
+    memcpy(st->x, s->kf.x, sizeof(st->x));
+    for (int i = 0; i < 4; i++)
+        for (int j = i; j < 4; j++)
+            st->P[tri[i][j]] = (float)s->kf.P[i][j];
+    st->dt      = (float)dt;
+    st->seq     = f->seq;
+    st->time_ms = f->time_ms;
+    st->lat     = f->lat;
+    st->lon     = f->lon;
+    st->updated = s->kf.stats.updates != before.updates;
+    memset(st->pad, 0, sizeof(st->pad));
+    s->stats.epochs++;
+
+    if (s->count == s->block + s->lag)
+        smooth(s, s->block);
+}
+
+void gps_rts_flush(GpsRts *s)
+{
+    smooth(s, s->count);
+}
+
+size_t gps_rts_memory(const GpsRts *s)
+{
+    return (s->block + s->lag) * (sizeof(GpsRtsStep) + sizeof(*s->sm));
+}
+
+void gps_rts_free(GpsRts *s)
+{
+    free(s->step);
+    free(s->sm);
+    s->step  = NULL;
+    s->sm    = NULL;
+    s->count = 0;
+}
@@ -0,0 +1,102 @@
+#ifndef GPS_RTS_H
+#define GPS_RTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+#include "gps_kf.h"
+
+// ─────────────────────────────────────────────
+//  RTS (Rauch-Tung-Striebel) 고정 지연 평활기, 오프라인 궤적 후처리용
+//
+//  gps_kf 를 앞으로 돌리며 epoch 마다 필터 상태 / 공분산만 저장하고
+//  창 (block + lag epoch) 이 차면 뒤로 평활해 앞 block 개를 내보낸다.
+//  - 메모리는 창 크기로 고정 (기록 길이와 무관), 출력은 입력 순서
+//  - 내보내는 epoch 는 최소 lag 개의 이후 측정까지 반영 (lag 가 필터 상관
+//    시간보다 충분히 길면 전체 RTS 와 거의 같음, kf_bench 가 차이를 보고)
+//  - gps_kf 재초기화 (공백 / 연속 기각) 는 구간 경계: 그때까지를 끝까지 평활
+//  - 예측 (x⁻, P⁻) 은 저장하지 않고 뒤로 갈 때 gps_kf_predict 로 다시 계산
+// ─────────────────────────────────────────────
+
+#define GPS_RTS_BLOCK   1024        // 한 번에 내보내는 epoch 수
+#define GPS_RTS_LAG     120         // 내보낼 때 반영하는 최소 이후 epoch 수
+
+// 저장 단위 (epoch 1개 96B: 상태 double, 공분산 float 상삼각)
+typedef struct {
+    double   x[4];                  // 필터 (갱신 후) 상태 E, N, vE, vN
+    float    P[10];                 // 필터 공분산 상삼각 (00 01 02 03 11 12 13 22 23 33)
+    float    dt;                    // 직전 epoch 에서 예측한 시간 (s), 구간 첫 epoch 0
+    uint32_t seq;                   // GpsFix seq
+    int32_t  time_ms;
+    int32_t  lat, lon;              // 원시 fix (1e-7 도)
+    uint8_t  updated;               // 위치 측정 반영 (0: 기각되어 예측만)
+    uint8_t  pad[3];
+} GpsRtsStep;
+
+// 평활 결과 (epoch 1개)
+typedef struct {
+    uint32_t seq;
+    int32_t  time_ms;
+    int32_t  raw_lat, raw_lon;      // 원시 fix (1e-7 도)
+    int      updated;
+    double   lat, lon;              // 평활 위치 (도)
+    double   ve, vn;                // 평활 속도 (m/s)
+    double   sigma;                 // 평활 수평 σ (m)
+    double   f_lat, f_lon;          // 필터 (앞 방향만) 위치
+    double   f_sigma;
+} GpsRtsPoint;
+
+typedef void (*GpsRtsCb)(const GpsRtsPoint *p, void *user);
+
+typedef struct {
+    uint64_t epochs;                // 저장한 epoch
+    uint64_t emitted;
+    uint64_t segments;              // 재초기화로 나뉜 구간
+    uint64_t windows;               // 뒤로 평활한 창 수
+    uint64_t backward_steps;        // 뒤로 평활한 epoch 수 (겹침 포함)
+} GpsRtsStats;
+
+// ─────────────────────────────────────────────
+//  평활기 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsKf        kf;
+    GeoLtp       ltp;               // 현재 구간 원점 (gps_kf 와 같음)
+    GpsRtsStep  *step;              // 창 (block + lag)
+    double     (*sm)[5];            // 뒤로 평활한 E, N, vE, vN, 수평 σ
+    size_t       count;
+    size_t       block, lag;
+    GpsRtsStats  stats;
+    GpsRtsCb     cb;
+    void        *user;
+} GpsRts;
+
+/**
+ * @brief 평활기 초기화
+ * @param kf    필터 설정 (q, uere 등을 설정한 gps_kf_init 결과, 복사해 사용)
+ * @param block 한 번에 내보낼 epoch 수 (0: GPS_RTS_BLOCK)
+ * @param lag   최소 이후 epoch 수 (0: GPS_RTS_LAG)
+ * @return 0: 성공, -1: 메모리 부족
+ */
+int gps_rts_init(GpsRts *s, const GpsKf *kf, size_t block, size_t lag, GpsRtsCb cb, void *user);
+
+/**
+ * @brief fix 1개 입력 (위치 없는 epoch 는 무시)
+ *
+ * 창이 차거나 구간이 바뀌면 이 안에서 평활 결과를 콜백으로 전달한다.
+ */
+void gps_rts_push(GpsRts *s, const GpsFix *f);
+
+/**
+ * @brief 남은 epoch 를 끝까지 평활해 내보냄 (입력 종료 시)
+ */
+void gps_rts_flush(GpsRts *s);
+
+/**
+ * @brief 창 메모리 바이트
+ */
+size_t gps_rts_memory(const GpsRts *s);
+
+void gps_rts_free(GpsRts *s);
+
+#endif /* GPS_RTS_H */
@@ -0,0 +1,186 @@
+#include "gps_serial.h"
+#include "gps_fix.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+/**
+ * @brief ASYNC_LOW_LATENCY 설정 (pty, USB-serial 일부는 미지원)
+ */
+static int set_low_latency(int fd)
+{
+    struct serial_struct ss;
+
+    if (ioctl(fd, TIOCGSERIAL, &ss) < 0) return -1;
+    ss.flags |= ASYNC_LOW_LATENCY;
+    if (ioctl(fd, TIOCSSERIAL, &ss) < 0) return -1;
+    return 0;
+}
+
+static int apply_raw(int fd, speed_t speed)
+{
+    struct termios t;
+
+    if (tcgetattr(fd, &t) < 0) return -1;
+
+    cfmakeraw(&t);                          // ICANON/ECHO/ISIG/IXON/ICRNL/OPOST 해제, CS8
+    t.c_cflag |= (CLOCAL | CREAD);
+    t.c_cflag &= ~(PARENB | CSTOPB | CRTSCTS);
+    t.c_cc[VMIN]  = 1;                      // O_NONBLOCK 이므로 read() 는 대기하지 않음
+    t.c_cc[VTIME] = 0;
+    cfsetispeed(&t, speed);
+    cfsetospeed(&t, speed);
+
+    return tcsetattr(fd, TCSANOW, &t);
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+speed_t gps_serial_speed(int baud)
+{
+    switch (baud) {
+        case 4800:   return B4800;
+        case 9600:   return B9600;
+        case 19200:  return B19200;
+        case 38400:  return B38400;
+        case 57600:  return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        default:     return 0;
+    }
+}
+
+int gps_serial_open(GpsSerial *s, const char *dev, int baud, unsigned flags)
+{
+    struct epoll_event ev = { .events = EPOLLIN };
+    speed_t speed = gps_serial_speed(baud);
+
+    memset(s, 0, sizeof(GpsSerial));
+    s->fd   = -1;
+    s->epfd = -1;
+
+    if (!speed) { errno = EINVAL; return -1; }
+
+    s->fd = open(dev ? dev : GPS_SERIAL_DEV, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (s->fd < 0) return -1;
+
+    if (tcgetattr(s->fd, &s->saved) == 0) s->saved_ok = 1;
+    if (apply_raw(s->fd, speed) < 0) goto fail;
+    s->baud = baud;
+
+    if ((flags & GPS_SERIAL_LOW_LATENCY) && set_low_latency(s->fd) == 0)
+        s->low_latency = 1;
+
+    // 열기 전에 쌓인 오래된 데이터 버림
+    tcflush(s->fd, TCIFLUSH);
+
+    s->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (s->epfd < 0) goto fail;
+    if (epoll_ctl(s->epfd, EPOLL_CTL_ADD, s->fd, &ev) < 0) goto fail;
+
+    return 0;
+
+fail: {
+        int err = errno;
+        gps_serial_close(s);
+        errno = err;
+        return -1;
+    }
+}
+
+int gps_serial_set_baud(GpsSerial *s, int baud)
+{
+    speed_t speed = gps_serial_speed(baud);
+
+    if (!speed) { errno = EINVAL; return -1; }
+    tcdrain(s->fd);
+    if (apply_raw(s->fd, speed) < 0) return -1;
+    s->baud = baud;
+    return 0;
+}
+
+int gps_serial_read(GpsSerial *s, char *buf, size_t len, int timeout_ms, int64_t *rx_ns)
+{
+    struct epoll_event ev;
+
+    for (;;) {
+        int r = epoll_wait(s->epfd, &ev, 1, timeout_ms);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (r == 0) return 0;
+
+        // 깨어난 직후 시각 = 청크 도착 시각
+        int64_t now = gps_now_ns();
+        ssize_t n   = read(s->fd, buf, len);
+
+        if (n > 0) {
+            s->last_rx_ns = now;
+            s->bytes     += (uint64_t)n;
+            s->reads++;
+            if (rx_ns) *rx_ns = now;
+            return (int)n;
+        }
+        if (n == 0) { errno = EIO; return -1; }     // hangup (pty 닫힘 등)
+        if (errno != EAGAIN && errno != EINTR) return -1;
+    }
+}
+
+int gps_serial_errors(const GpsSerial *s, GpsSerialErrors *e)
+{
+    struct serial_icounter_struct ic;
+
+    memset(&ic, 0, sizeof(ic));
+    if (ioctl(s->fd, TIOCGICOUNT, &ic) < 0) return -1;
+    e->frame       = (uint64_t)ic.frame;
+    e->parity      = (uint64_t)ic.parity;
+    e->overrun     = (uint64_t)ic.overrun;
+    e->buf_overrun = (uint64_t)ic.buf_overrun;
+    e->brk         = (uint64_t)ic.brk;
+    return 0;
+}
+
+int gps_serial_write(GpsSerial *s, const void *buf, size_t len)
+{
+    const char *p = buf;
+
+    while (len > 0) {
+        ssize_t n = write(s->fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) {
+                // 출력 버퍼가 찼으면 빠질 때까지 대기
+                tcdrain(s->fd);
+                continue;
+            }
+            return -1;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+void gps_serial_close(GpsSerial *s)
+{
+    if (s->epfd >= 0) close(s->epfd);
+    if (s->fd >= 0) {
+        if (s->saved_ok) tcsetattr(s->fd, TCSANOW, &s->saved);
+        close(s->fd);
+    }
+    s->fd   = -1;
+    s->epfd = -1;
+}
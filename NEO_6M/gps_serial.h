@@ -0,0 +1,89 @@
+#ifndef GPS_SERIAL_H
+#define GPS_SERIAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <termios.h>
+
+// ─────────────────────────────────────────────
+//  GPS UART 입력 계층
+//
+//  - raw 모드 (canonical / echo / 입력 변환 해제, 8N1)
+//  - O_NONBLOCK + epoll 로 데이터 도착 즉시 깨어남 (usleep 폴링 없음)
+//  - 깨어난 시점의 CLOCK_MONOTONIC 을 청크 수신 시각으로 기록
+//  - 가능하면 ASYNC_LOW_LATENCY (8250/PL011 드라이버의 flip 버퍼 지연 제거)
+// ─────────────────────────────────────────────
+
+#define GPS_SERIAL_DEV      "/dev/serial0"  // UART0 (GPIO14/15, 물리핀 8/10)
+#define GPS_SERIAL_BAUD     9600            // NEO-6M 기본값
+
+// gps_serial_open flags
+#define GPS_SERIAL_LOW_LATENCY  0x1         // ASYNC_LOW_LATENCY 시도 (실패해도 계속)
+
+typedef struct {
+    int             fd;
+    int             epfd;
+    int             baud;           // 현재 보레이트
+    int             low_latency;    // ASYNC_LOW_LATENCY 적용됨
+    int             saved_ok;       // saved 복원 필요
+    struct termios  saved;          // open 이전 설정
+    int64_t         last_rx_ns;     // 마지막 청크 수신 시각
+    uint64_t        bytes;          // 누적 수신 바이트
+    uint64_t        reads;          // 데이터가 있던 read() 횟수
+} GpsSerial;
+
+// UART 드라이버 오류 카운터 (TIOCGICOUNT, 열기 이전부터 누적)
+typedef struct {
+    uint64_t frame;                 // stop 비트 오류 (보레이트 불일치, 배선 잡음)
+    uint64_t parity;
+    uint64_t overrun;               // 하드웨어 FIFO 넘침 (인터럽트 지연)
+    uint64_t buf_overrun;           // tty 버퍼 넘침 (read() 가 늦음)
+    uint64_t brk;
+} GpsSerialErrors;
+
+/**
+ * @brief 시리얼 포트 열기 + raw 모드 설정
+ * @param dev   장치 경로 (NULL 이면 GPS_SERIAL_DEV)
+ * @param baud  보레이트 (4800 ~ 460800)
+ * @param flags GPS_SERIAL_* 조합
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_serial_open(GpsSerial *s, const char *dev, int baud, unsigned flags);
+
+/**
+ * @brief 보레이트 변경 (출력 버퍼를 비운 뒤 적용)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_serial_set_baud(GpsSerial *s, int baud);
+
+/**
+ * @brief 데이터가 올 때까지 최대 timeout_ms 대기 후 읽기
+ * @param timeout_ms -1 이면 무한 대기
+ * @param rx_ns      청크 수신 시각 (CLOCK_MONOTONIC ns, NULL 가능)
+ * @return 읽은 바이트 수, 0: timeout, -1: 오류 (errno 설정)
+ */
+int gps_serial_read(GpsSerial *s, char *buf, size_t len, int timeout_ms, int64_t *rx_ns);
+
+/**
+ * @brief 전체 쓰기 (UBX 설정 명령 등)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_serial_write(GpsSerial *s, const void *buf, size_t len);
+
+/**
+ * @brief UART 드라이버 오류 카운터 읽기
+ * @return 0: 성공, -1: 미지원 (pty, 일부 USB-serial) 또는 오류 (errno 설정)
+ */
+int gps_serial_errors(const GpsSerial *s, GpsSerialErrors *e);
+
+/**
+ * @brief termios 복원 후 닫기
+ */
+void gps_serial_close(GpsSerial *s);
+
+/**
+ * @brief 정수 보레이트 → speed_t (미지원이면 0)
+ */
+speed_t gps_serial_speed(int baud);
+
+#endif /* GPS_SERIAL_H */
@@ -0,0 +1,311 @@
+#include "gps_shm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#define HIST_MASK   (GPS_SHM_HIST - 1)
+
+_Static_assert((GPS_SHM_HIST & HIST_MASK) == 0, "GPS_SHM_HIST must be a power of two");
+_Static_assert(sizeof(GpsFix) % 8 == 0, "GpsFix is copied in 8-byte words");
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static long futex(uint32_t *uaddr, int op, uint32_t val, const struct timespec *ts)
+{
+    // 프로세스 간 공유라 FUTEX_PRIVATE_FLAG 를 쓰지 않음
+    return syscall(SYS_futex, uaddr, op, val, ts, NULL, 0);
+}
+
+static GpsShmSlot *slot_of(const GpsShm *s, uint32_t n)
+{
+    return &s->seg->slot[(n - 1) & HIST_MASK];
+}
+
+/**
+ * @brief 8 바이트 단위 relaxed 복사 (seqlock 구간 안에서 쓰는 쪽과 경합해도 정의된 동작)
+ */
+static void word_copy(void *dst, const void *src, size_t len)
+{
+    uint64_t       *d = dst;
+    const uint64_t *p = src;
+
+    for (size_t i = 0; i < len / 8; i++)
+        __atomic_store_n(&d[i], __atomic_load_n(&p[i], __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
+
+static void slot_write(GpsShmSlot *sl, uint32_t n, const GpsFix *fix)
+{
+    uint32_t seq = __atomic_load_n(&sl->seq, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&sl->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);        // 홀수 seq 가 내용보다 먼저 보이도록
+    __atomic_store_n(&sl->n, n, __ATOMIC_RELAXED);
+    word_copy(&sl->fix, fix, sizeof(GpsFix));
+    __atomic_store_n(&sl->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 슬롯에서 번호 n 의 fix 읽기
+ * @return 0: 성공, -1: 다른 번호 (밀려났거나 아직 안 씀)
+ */
+static int slot_read(GpsShm *s, uint32_t n, GpsFix *out)
+{
+    const GpsShmSlot *sl = slot_of(s, n);
+
+    for (int i = 0; i < GPS_SHM_RETRY; i++) {
+        uint32_t s1 = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE);
+        uint32_t got;
+
+        if (!(s1 & 1)) {
+            got = __atomic_load_n(&sl->n, __ATOMIC_RELAXED);
+            word_copy(out, &sl->fix, sizeof(GpsFix));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&sl->seq, __ATOMIC_RELAXED) == s1) {
+                if (got != n) {
+                    s->stats.lapped++;
+                    return -1;
+                }
+                s->stats.reads++;
+                return 0;
+            }
+        }
+        s->stats.retries++;
+    }
+    s->stats.lapped++;
+    return -1;
+}
+
+static int seg_matches(const GpsShmSeg *g)
+{
+    return g->magic == GPS_SHM_MAGIC && g->version == GPS_SHM_VERSION &&
+           g->hist == GPS_SHM_HIST && g->fix_size == sizeof(GpsFix);
+}
+
+/**
+ * @brief 이전 발행자가 쓰다가 죽은 슬롯 정리 (번호를 지워 읽히지 않게)
+ */
+static void seg_recover(GpsShmSeg *g)
+{
+    for (int i = 0; i < GPS_SHM_HIST; i++) {
+        GpsShmSlot *sl = &g->slot[i];
+        if (!(sl->seq & 1)) continue;
+        __atomic_store_n(&sl->n, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&sl->seq, sl->seq + 1, __ATOMIC_RELEASE);
+    }
+}
+
+// ─────────────────────────────────────────────
+//  발행자
+// ─────────────────────────────────────────────
+
+int gps_shm_create(GpsShm *s, const char *name)
+{
+    struct stat st;
+    int         err;
+
+    memset(s, 0, sizeof(GpsShm));
+    if (!name) name = GPS_SHM_NAME;
+
+    for (int attempt = 0; ; attempt++) {
+        s->fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+        if (s->fd < 0) return -1;
+        if (flock(s->fd, LOCK_EX | LOCK_NB) < 0) {
+            err = (errno == EWOULDBLOCK) ? EBUSY : errno;
+            goto fail;
+        }
+        if (fstat(s->fd, &st) < 0) goto fail_errno;
+
+        if (st.st_size == (off_t)sizeof(GpsShmSeg)) {
+            s->seg = mmap(NULL, sizeof(GpsShmSeg), PROT_READ | PROT_WRITE, MAP_SHARED, s->fd, 0);
+            if (s->seg == MAP_FAILED) goto fail_errno;
+            if (seg_matches(s->seg)) {
+                // 재시작: 발행 번호 / history 유지, 구독자 매핑도 그대로 유효
+                seg_recover(s->seg);
+                s->seg->restarts++;
+                break;
+            }
+            munmap(s->seg, sizeof(GpsShmSeg));
+        }
+
+        if (st.st_size != 0) {
+            // 버전이 다른 세그먼트: 줄이면 기존 구독자가 SIGBUS 를 받으므로 새로 만든다
+            if (attempt > 0) { err = EPROTO; goto fail; }
+            close(s->fd);
+            shm_unlink(name);
+            continue;
+        }
+
+        if (ftruncate(s->fd, sizeof(GpsShmSeg)) < 0) goto fail_errno;
+        s->seg = mmap(NULL, sizeof(GpsShmSeg), PROT_READ | PROT_WRITE, MAP_SHARED, s->fd, 0);
+        if (s->seg == MAP_FAILED) goto fail_errno;
+        s->seg->version  = GPS_SHM_VERSION;
+        s->seg->hist     = GPS_SHM_HIST;
+        s->seg->fix_size = sizeof(GpsFix);
+        __atomic_store_n(&s->seg->magic, GPS_SHM_MAGIC, __ATOMIC_RELEASE);
+        break;
+    }
+
+    s->writer = 1;
+    __atomic_store_n(&s->seg->pid, (int32_t)getpid(), __ATOMIC_RELEASE);
+    return 0;
+
+fail_errno:
+    err = errno;
+fail:
+    close(s->fd);
+    s->seg = NULL;
+    errno  = err;
+    return -1;
+}
+
+void gps_shm_publish(GpsShm *s, const GpsFix *fix)
+{
+    uint32_t n = s->seg->count + 1;
+
+    if (n == 0) n = 1;                              // 0 은 "발행 없음"
+    slot_write(slot_of(s, n), n, fix);
+    __atomic_store_n(&s->seg->count, n, __ATOMIC_RELEASE);
+    futex(&s->seg->count, FUTEX_WAKE, INT_MAX, NULL);
+}
+
+// ─────────────────────────────────────────────
+//  구독자
+// ─────────────────────────────────────────────
+
+int gps_shm_open(GpsShm *s, const char *name)
+{
+    struct stat st;
+    int         err;
+
+    memset(s, 0, sizeof(GpsShm));
+    if (!name) name = GPS_SHM_NAME;
+
+    s->fd = shm_open(name, O_RDONLY, 0);
+    if (s->fd < 0) return -1;
+    if (fstat(s->fd, &st) < 0) goto fail_errno;
+    if (st.st_size != (off_t)sizeof(GpsShmSeg)) {
+        err = (st.st_size == 0) ? EAGAIN : EPROTO;  // 0: 발행자가 만드는 중
+        goto fail;
+    }
+    s->seg = mmap(NULL, sizeof(GpsShmSeg), PROT_READ, MAP_SHARED, s->fd, 0);
+    if (s->seg == MAP_FAILED) goto fail_errno;
+    if (__atomic_load_n(&s->seg->magic, __ATOMIC_ACQUIRE) != GPS_SHM_MAGIC) {
+        munmap(s->seg, sizeof(GpsShmSeg));
+        err = EAGAIN;
+        goto fail;
+    }
+    if (!seg_matches(s->seg)) {
+        munmap(s->seg, sizeof(GpsShmSeg));
+        err = EPROTO;
+        goto fail;
+    }
+    return 0;
+
+fail_errno:
+    err = errno;
+fail:
+    close(s->fd);
+    s->seg = NULL;
+    errno  = err;
+    return -1;
+}
+
+int gps_shm_latest(GpsShm *s, GpsFix *out, uint32_t *n)
+{
+    for (int i = 0; i < GPS_SHM_RETRY; i++) {
+        uint32_t c = gps_shm_count(s);
+
+        if (c == 0) break;
+        if (slot_read(s, c, out) == 0) {
+            if (n) *n = c;
+            return 0;
+        }
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+int gps_shm_get(GpsShm *s, uint32_t n, GpsFix *out)
+{
+    uint32_t c = gps_shm_count(s);
+
+    if (n == 0 || c - n >= GPS_SHM_HIST || slot_read(s, n, out) < 0) {
+        errno = ENOENT;
+        return -1;
+    }
+    return 0;
+}
+
+size_t gps_shm_history(GpsShm *s, GpsFix *out, size_t max)
+{
+    uint32_t c = gps_shm_count(s);
+    size_t   k = 0;
+
+    if (max > GPS_SHM_HIST) max = GPS_SHM_HIST;
+    if (max > c)            max = c;
+    for (uint32_t n = c - (uint32_t)max + 1; max > 0 && n != c + 1; n++)
+        if (slot_read(s, n, &out[k]) == 0) k++;     // 읽는 동안 밀려난 가장 오래된 것은 건너뜀
+    return k;
+}
+
+int gps_shm_wait(GpsShm *s, uint32_t seen, int timeout_ms)
+{
+    int64_t deadline = gps_now_ns() + (int64_t)timeout_ms * 1000000LL;
+
+    for (;;) {
+        struct timespec ts, *tp = NULL;
+
+        if (gps_shm_count(s) != seen) return 1;
+        if (__atomic_load_n(&s->seg->pid, __ATOMIC_ACQUIRE) == 0) {
+            errno = EPIPE;                          // 발행자가 닫음 (새 fix 없음)
+            return -1;
+        }
+        if (timeout_ms >= 0) {
+            int64_t left = deadline - gps_now_ns();
+            if (left <= 0) return 0;
+            ts.tv_sec  = left / 1000000000LL;
+            ts.tv_nsec = left % 1000000000LL;
+            tp = &ts;
+        }
+
+        // 발행 / 발행자 종료 시 깨어남
+        if (futex(&s->seg->count, FUTEX_WAIT, seen, tp) == 0) {
+            s->stats.wakes++;
+            continue;
+        }
+        if (errno == EAGAIN || errno == ETIMEDOUT) continue;
+        return -1;
+    }
+}
+
+int gps_shm_alive(const GpsShm *s)
+{
+    int32_t pid = __atomic_load_n(&s->seg->pid, __ATOMIC_ACQUIRE);
+
+    if (pid <= 0) return 0;
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+void gps_shm_close(GpsShm *s)
+{
+    if (!s->seg) return;
+    if (s->writer) {
+        __atomic_store_n(&s->seg->pid, 0, __ATOMIC_RELEASE);
+        futex(&s->seg->count, FUTEX_WAKE, INT_MAX, NULL);
+    }
+    munmap(s->seg, sizeof(GpsShmSeg));
+    close(s->fd);
+    s->seg = NULL;
+    s->fd  = -1;
+}
@@ -0,0 +1,140 @@
+#ifndef GPS_SHM_H
+#define GPS_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+
+// ─────────────────────────────────────────────
+//  GpsFix 공유 메모리 발행 / 구독
+//
+//  시리얼 포트를 여는 프로세스 (gps_daemon) 하나가 epoch 마다 fix 를
+//  POSIX 공유 메모리의 history ring 에 쓰고, 여러 프로세스가 동시에 읽는다.
+//
+//  - 슬롯마다 seqlock: 쓰는 중 (홀수) 이거나 읽는 동안 바뀌면 다시 읽음
+//    최신 fix 는 쓰기 중인 슬롯과 다른 슬롯이라 ring 을 한 바퀴 따라잡히지
+//    않는 한 재시도 없음 (잠금 / 시스템 콜 없음)
+//  - 발행 번호 (count) 가 futex word: 구독자는 번호가 바뀔 때까지 잠든다
+//  - 구독자는 읽기 전용으로 매핑 (구독자가 세그먼트를 망가뜨릴 수 없음)
+//  - 발행자는 flock 으로 하나만, 재시작해도 같은 세그먼트를 재사용
+//    (이미 매핑한 구독자는 다시 열 필요 없음)
+// ─────────────────────────────────────────────
+
+#define GPS_SHM_NAME        "/neo6m_gps"    // /dev/shm/neo6m_gps
+#define GPS_SHM_HIST        64              // history 슬롯 수 (2 의 거듭제곱)
+#define GPS_SHM_MAGIC       0x4E36474Du     // "MG6N"
+#define GPS_SHM_VERSION     1
+#define GPS_SHM_RETRY       64              // seqlock 재시도 한도
+
+typedef struct {
+    uint32_t seq;                   // seqlock (홀수: 쓰는 중)
+    uint32_t n;                     // 이 슬롯의 발행 번호 (1 부터)
+    GpsFix   fix;
+} __attribute__((aligned(64))) GpsShmSlot;
+
+// ─────────────────────────────────────────────
+//  세그먼트 배치 (발행자 / 구독자 공통, 바꾸면 GPS_SHM_VERSION 증가)
+// ─────────────────────────────────────────────
+typedef struct {
+    uint32_t   magic;               // 초기화가 끝나면 마지막에 기록
+    uint16_t   version;
+    uint16_t   hist;                // GPS_SHM_HIST
+    uint32_t   fix_size;            // sizeof(GpsFix)
+    int32_t    pid;                 // 발행 프로세스 (0: 정상 종료)
+    uint32_t   count;               // 발행한 fix 수 = 최신 발행 번호 (futex word)
+    uint32_t   restarts;            // 발행자 재시작 횟수
+    GpsShmSlot slot[GPS_SHM_HIST];  // 번호 n 은 slot[(n - 1) % GPS_SHM_HIST]
+} GpsShmSeg;
+
+typedef struct {
+    uint64_t reads;                 // 성공한 슬롯 읽기
+    uint64_t retries;               // seqlock 재시도
+    uint64_t lapped;                // 읽는 동안 ring 이 한 바퀴 돌아 버린 슬롯
+    uint64_t wakes;                 // futex 로 깨어난 횟수
+} GpsShmStats;
+
+typedef struct {
+    int          fd;
+    int          writer;            // 발행자로 열었음
+    GpsShmSeg   *seg;
+    GpsShmStats  stats;
+} GpsShm;
+
+// ─────────────────────────────────────────────
+//  발행자
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 세그먼트 생성 (이미 있으면 재사용, 발행 번호 유지)
+ * @param name NULL 이면 GPS_SHM_NAME
+ * @return 0: 성공, -1: 실패 (errno 설정, 다른 발행자가 있으면 EBUSY)
+ */
+int gps_shm_create(GpsShm *s, const char *name);
+
+/**
+ * @brief fix 발행 + 대기 중인 구독자 깨우기
+ */
+void gps_shm_publish(GpsShm *s, const GpsFix *fix);
+
+// ─────────────────────────────────────────────
+//  구독자
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 세그먼트 열기 (읽기 전용)
+ * @param name NULL 이면 GPS_SHM_NAME
+ * @return 0: 성공, -1: 실패 (errno 설정, 발행자가 없으면 ENOENT,
+ *         버전이 다르면 EPROTO)
+ */
+int gps_shm_open(GpsShm *s, const char *name);
+
+/**
+ * @brief 최신 발행 번호 (0: 아직 발행 없음)
+ */
+static inline uint32_t gps_shm_count(const GpsShm *s)
+{
+    return __atomic_load_n(&s->seg->count, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief 최신 fix 복사
+ * @param n 복사한 fix 의 발행 번호 (NULL 가능)
+ * @return 0: 성공, -1: 실패 (EAGAIN: 아직 발행 없음 또는 재시도 한도 초과)
+ */
+int gps_shm_latest(GpsShm *s, GpsFix *out, uint32_t *n);
+
+/**
+ * @brief 발행 번호 n 의 fix 복사 (history)
+ * @return 0: 성공, -1: ring 에서 이미 밀려났거나 아직 없음 (ENOENT)
+ */
+int gps_shm_get(GpsShm *s, uint32_t n, GpsFix *out);
+
+/**
+ * @brief 최근 fix 최대 max 개를 오래된 순으로 복사
+ * @return 복사한 개수
+ */
+size_t gps_shm_history(GpsShm *s, GpsFix *out, size_t max);
+
+/**
+ * @brief 발행 번호가 seen 과 달라질 때까지 대기 (futex)
+ *
+ * 발행자가 gps_shm_close 로 닫혀 있으면 기다리지 않고 EPIPE.
+ * 발행자가 다시 시작하면 같은 매핑으로 계속 읽을 수 있다 (gps_shm_alive 로 확인).
+ *
+ * @param timeout_ms -1 이면 무한 대기
+ * @return 1: 새 발행, 0: timeout,
+ *         -1: 오류 (errno 설정, EINTR: 시그널, EPIPE: 발행자가 닫혀 있음)
+ */
+int gps_shm_wait(GpsShm *s, uint32_t seen, int timeout_ms);
+
+/**
+ * @brief 발행 프로세스가 살아 있는지
+ */
+int gps_shm_alive(const GpsShm *s);
+
+/**
+ * @brief 닫기 (발행자면 pid 를 지우고 구독자를 깨움, 세그먼트는 남김)
+ */
+void gps_shm_close(GpsShm *s);
+
+#endif /* GPS_SHM_H */
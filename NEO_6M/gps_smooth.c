@@ -0,0 +1,229 @@
+// GPS 궤적 오프라인 평활 (RTS, 사후 분석용)
+//
+// 기록 (.rec, gps_record) 또는 원시 NMEA / UBX 캡처를 읽어 gps_kf 를 앞으로 돌리고
+// gps_rts 로 뒤로 평활한다. 창 (block + lag epoch) 단위로 처리하므로 기록 길이와
+// 관계없이 메모리는 고정이고, 결과는 입력 순서대로 CSV 로 나간다.
+//
+// 실행: ./gps_smooth [-q q_accel] [-u uere] [-b block] [-l lag] [-R] [-c out.csv] file
+//         -q / -u  Kalman 가속도 PSD / UERE (gps_replay 와 같음)
+//         -b / -l  평활 창: 한 번에 내보낼 epoch 수 / 최소 이후 epoch 수
+//         -R       .rec 의 fix 레코드 대신 원시 청크를 다시 파싱
+//         -c       epoch 마다 raw / 필터 / 평활 위치 CSV
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "nmea_msg.h"
+#include "geo.h"
+#include "gps_epoch.h"
+#include "gps_rec.h"
+#include "gps_rts.h"
+#include "gps_stream.h"
+
+typedef struct {
+    GpsRts   rts;
+    FILE    *csv;
+    long     fixes;
+    int64_t  rts_ns;            // gps_rts 에 쓴 시간
+    long     updated;           // 위치 측정을 반영한 epoch (RMS / σ 집계 대상)
+    double   f_err2, s_err2;    // Σ |raw - 필터|², Σ |raw - 평활|²
+    double   f_sigma, s_sigma;  // Σ σ
+} Smooth;
+
+static int64_t zero_clock(void)
+{
+    return 0;
+}
+
+static void on_point(const GpsRtsPoint *p, void *user)
+{
+    Smooth *s = user;
+    double  lat = nmea_e7_to_deg(p->raw_lat), lon = nmea_e7_to_deg(p->raw_lon), n, e;
+
+    if (p->updated) {
+        s->updated++;
+        geo_offset(p->f_lat, p->f_lon, lat, lon, &n, &e);
+        s->f_err2 += n * n + e * e;
+        geo_offset(p->lat, p->lon, lat, lon, &n, &e);
+        s->s_err2 += n * n + e * e;
+        s->f_sigma += p->f_sigma;
+        s->s_sigma += p->sigma;
+    }
+    if (s->csv)
+        fprintf(s->csv, "%u,%d,%.7f,%.7f,%d,%.7f,%.7f,%.2f,%.7f,%.7f,%.2f,%.2f,%.2f\n",
+                (unsigned)p->seq, p->time_ms, lat, lon, p->updated,
+                p->f_lat, p->f_lon, p->f_sigma, p->lat, p->lon, p->ve, p->vn, p->sigma);
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Smooth *s = user;
+
+    s->fixes++;
+    int64_t t0 = gps_now_ns();
+    gps_rts_push(&s->rts, f);
+    s->rts_ns += gps_now_ns() - t0;
+}
+
+/**
+ * @brief 원시 바이트를 파싱 / 조립해 on_fix 로 (도착 시각 없이 UTC 태그로 epoch 구분)
+ */
+static void feed_raw(GpsStream *st, const void *data, size_t len)
+{
+    gps_stream_feed(st, data, len, 0);
+}
+
+static void stream_setup(GpsStream *st, NmeaDispatch *disp, GpsEpoch *ep, Smooth *s)
+{
+    gps_epoch_init(ep, on_fix, s);
+    gps_epoch_set_policy(ep, 0, 0);
+    gps_epoch_set_clock(ep, zero_clock);
+    nmea_dispatch_init(disp);
+    gps_epoch_attach(ep, disp);
+    gps_stream_init(st, nmea_dispatch_sentence, disp, gps_epoch_on_ubx, ep);
+}
+
+/**
+ * @brief .rec 처리 (기본: 기록된 fix 레코드, reparse: 원시 청크)
+ * @return 0: 처리함, -1: .rec 가 아님 (errno EPROTO) 또는 열기 실패
+ */
+static int run_rec(const char *path, int reparse, Smooth *s)
+{
+    GpsRecReader rd;
+    GpsRecord    rec;
+    GpsStream    st;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+
+    if (gps_rec_open(&rd, path) < 0) return -1;
+    printf("%s: recording, %s %d baud, %llu records, %llu fixes%s\n", path, rd.hdr->dev,
+           rd.hdr->baud, (unsigned long long)rd.records, (unsigned long long)rd.fixes,
+           reparse ? " (reparsing raw)" : "");
+    if (!reparse && rd.fixes == 0) {
+        printf("no fix records, reparsing raw chunks\n");
+        reparse = 1;
+    }
+    if (reparse) stream_setup(&st, &disp, &ep, s);
+
+    while (gps_rec_next(&rd, &rec)) {
+        if (reparse) {
+            if (rec.type == GPS_REC_RAW) feed_raw(&st, rec.data, rec.len);
+        } else {
+            const GpsFix *f = gps_rec_fix(&rd, &rec);
+            if (f) on_fix(f, s);
+        }
+    }
+    if (reparse) gps_epoch_flush(&ep);
+    gps_rec_close(&rd);
+    return 0;
+}
+
+static int run_capture(const char *path, Smooth *s)
+{
+    GpsStream    st;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    struct stat  sb;
+    int          fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &sb) < 0) return -1;
+    printf("%s: raw capture, %.1f MB\n", path, sb.st_size / 1e6);
+    stream_setup(&st, &disp, &ep, s);
+    if (sb.st_size > 0) {
+        void *data = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        madvise(data, (size_t)sb.st_size, MADV_SEQUENTIAL);
+        feed_raw(&st, data, (size_t)sb.st_size);
+        munmap(data, (size_t)sb.st_size);
+    }
+    gps_epoch_flush(&ep);
+    close(fd);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    double      q = 0.0, uere = 0.0;
+    long        block = 0, lag = 0;
+    int         reparse = 0, opt;
+    const char *csv = NULL;
+    Smooth      s = {0};
+
+    while ((opt = getopt(argc, argv, "q:u:b:l:Rc:")) != -1) {
+        switch (opt) {
+            case 'q': q       = atof(optarg); break;
+            case 'u': uere    = atof(optarg); break;
+            case 'b': block   = atol(optarg); break;
+            case 'l': lag     = atol(optarg); break;
+            case 'R': reparse = 1;            break;
+            case 'c': csv     = optarg;       break;
+            default:
+                fprintf(stderr, "usage: %s [-q q_accel] [-u uere] [-b block] [-l lag] [-R]\n"
+                                "       [-c out.csv] file.rec|file.nmea\n", argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc || block < 0 || lag < 0) {
+        fprintf(stderr, "usage: %s [options] file.rec|file.nmea\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[optind];
+
+    GpsKf kf;
+    gps_kf_init(&kf, q);
+    gps_kf_set_uere(&kf, uere);
+    if (gps_rts_init(&s.rts, &kf, (size_t)block, (size_t)lag, on_point, &s) < 0) {
+        perror("gps_rts_init");
+        return 1;
+    }
+    if (csv) {
+        s.csv = fopen(csv, "w");
+        if (!s.csv) { perror(csv); return 1; }
+        fprintf(s.csv, "seq,time_ms,lat,lon,updated,kf_lat,kf_lon,kf_sigma,"
+                       "rts_lat,rts_lon,rts_ve,rts_vn,rts_sigma\n");
+    }
+
+    int64_t t0 = gps_now_ns();
+    if (run_rec(path, reparse, &s) < 0) {
+        if (errno != EPROTO || run_capture(path, &s) < 0) {
+            perror(path);
+            return 1;
+        }
+    }
+    int64_t t_flush = gps_now_ns();
+    gps_rts_flush(&s.rts);
+    s.rts_ns += gps_now_ns() - t_flush;
+    double wall = (gps_now_ns() - t0) / 1e9;
+    double t_rts = s.rts_ns / 1e9;
+
+    const GpsRtsStats *rs = &s.rts.stats;
+    printf("fixes %ld, %llu epochs with position in %llu segments, %.3f s (%.0f epochs/s)\n",
+           s.fixes, (unsigned long long)rs->epochs, (unsigned long long)rs->segments,
+           wall, wall > 0 ? rs->epochs / wall : 0.0);
+    printf("smoother: %.3f s (%.0f epochs/s), window %zu+%zu = %zu KB, %llu windows, "
+           "backward x%.2f\n",
+           t_rts, t_rts > 0 ? rs->epochs / t_rts : 0.0, s.rts.block, s.rts.lag,
+           gps_rts_memory(&s.rts) / 1024, (unsigned long long)rs->windows,
+           rs->epochs ? (double)rs->backward_steps / rs->epochs : 0.0);
+    printf("kalman q %.2f uere %.2f: updates %llu rejected %llu resets %llu\n",
+           s.rts.kf.q, s.rts.kf.uere, (unsigned long long)s.rts.kf.stats.updates,
+           (unsigned long long)s.rts.kf.stats.rejected,
+           (unsigned long long)s.rts.kf.stats.resets);
+    if (s.updated)
+        printf("RMS to raw: forward %.2f m, smoothed %.2f m;  mean sigma: forward %.2f m, "
+               "smoothed %.2f m\n",
+               sqrt(s.f_err2 / s.updated), sqrt(s.s_err2 / s.updated),
+               s.f_sigma / s.updated, s.s_sigma / s.updated);
+
+    if (s.csv) fclose(s.csv);
+    gps_rts_free(&s.rts);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "gps_stream.h"
+
+#include <string.h>
+
+enum {
+    M_IDLE = 0,     // 프로토콜 시작 바이트 대기
+    M_NMEA,         // '$' ~ '\n'
+    M_UBX,          // 0xB5 ~ 체크섬
+};
+
+void gps_stream_init(GpsStream *s, NmeaSentenceCb ncb, void *nuser,
+                     UbxFrameCb ucb, void *uuser)
+{
+    memset(s, 0, sizeof(GpsStream));
+    s->mode = M_IDLE;
+    nmea_parser_init(&s->nmea, ncb, nuser);
+    ubx_parser_init(&s->ubx, ucb, uuser);
+}
+
+void gps_stream_feed(GpsStream *s, const void *data, size_t n, int64_t rx_ns)
+{
+    const uint8_t *d = data;
+    size_t         i = 0;
+
+    while (i < n) {
+        switch (s->mode) {
+
+            case M_IDLE: {
+                size_t start = i;
+                while (i < n && d[i] != '$' && d[i] != UBX_SYNC1) i++;
+                s->stats.garbage += i - start;
+                if (i == n) break;
+                s->mode = (d[i] == '$') ? M_NMEA : M_UBX;
+                break;
+            }
+
+            case M_NMEA: {
+                // 줄 끝 또는 비 ASCII 바이트까지를 한 번에 libnmea 로
+                size_t start = i;
+                while (i < n && d[i] != '\n' && d[i] < 0x80) i++;
+
+                if (i < n && d[i] == '\n') {
+                    i++;
+                    s->mode = M_IDLE;
+                } else if (i < n) {
+                    // 문장 도중 UBX 시작 → 잘린 문장 버림
+                    s->mode = M_IDLE;
+                }
+                nmea_parser_feed_at(&s->nmea, (const char *)d + start, i - start, rx_ns);
+                if (s->mode == M_IDLE) nmea_parser_reset(&s->nmea);
+                s->stats.nmea_bytes += i - start;
+                break;
+            }
+
+            case M_UBX: {
+                int    done;
+                size_t k = ubx_parser_feed_frame(&s->ubx, d + i, n - i, rx_ns, &done);
+                s->ubx.stats.bytes += k;
+                s->stats.ubx_bytes += k;
+                i += k;
+                if (done) s->mode = M_IDLE;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef GPS_STREAM_H
+#define GPS_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nmea.h"
+#include "ubx.h"
+
+// ─────────────────────────────────────────────
+//  NMEA / UBX 혼합 스트림 분배기
+//
+//  '$' 로 시작하면 줄 끝('\n')까지 libnmea 로,
+//  0xB5 로 시작하면 프레임 끝까지 UBX 프레이머로 넘긴다.
+//  NMEA 는 7bit ASCII 이므로 문장 중간의 0x80 이상 바이트는
+//  잘린 문장으로 보고 UBX 쪽으로 재동기한다.
+// ─────────────────────────────────────────────
+
+typedef struct {
+    uint64_t nmea_bytes;
+    uint64_t ubx_bytes;
+    uint64_t garbage;           // 어느 프로토콜에도 속하지 않은 바이트
+} GpsStreamStats;
+
+typedef struct {
+    uint8_t         mode;
+    NmeaParser      nmea;
+    UbxParser       ubx;
+    GpsStreamStats  stats;
+} GpsStream;
+
+/**
+ * @brief 분배기 초기화
+ * @param ncb/nuser NMEA 문장 콜백 (예: nmea_dispatch_sentence, &disp)
+ * @param ucb/uuser UBX 프레임 콜백 (예: gps_epoch_on_ubx, &epoch)
+ */
+void gps_stream_init(GpsStream *s, NmeaSentenceCb ncb, void *nuser,
+                     UbxFrameCb ucb, void *uuser);
+
+/**
+ * @brief 수신 청크 입력
+ * @param rx_ns 청크 수신 시각 (gps_serial_read 의 rx_ns)
+ */
+void gps_stream_feed(GpsStream *s, const void *data, size_t len, int64_t rx_ns);
+
+#endif /* GPS_STREAM_H */
@@ -0,0 +1,221 @@
+#include "gps_synth.h"
+
+#include "ubx.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// 2026-10-19 00:00:00 UTC = GPS week 2441, TOW 86418000 ms (leap 18s 포함)
+#define SYNTH_GPS_WEEK      2441
+#define SYNTH_GPS_TOW0      86418000u
+
+// epoch 번호 → 위도/경도 분 (37°N 127°E 부근)
+static void synth_pos(int i, double *lat_min, double *lon_min)
+{
+    *lat_min = 33.12345 + (i % 1000) * 0.00001;
+    *lon_min = 58.54321 + (i % 700) * 0.00001;
+}
+
+size_t nmea_synth_sentence(char *out, const char *body)
+{
+    uint8_t ck = 0;
+    for (const char *q = body; *q; q++) ck ^= (uint8_t)*q;
+    return (size_t)sprintf(out, "$%s*%02X\r\n", body, ck);
+}
+
+// epoch 번호 → UTC "hhmmss.ss"
+static void synth_utc(char *utc, size_t len, int i, int rate_hz)
+{
+    int ms = (int)((int64_t)i * 1000 / rate_hz % 86400000);
+    snprintf(utc, len, "%02d%02d%02d.%02d",
+             ms / 3600000, ms / 60000 % 60, ms / 1000 % 60, ms % 1000 / 10);
+}
+
+size_t nmea_synth_type(char *out, int i, int rate_hz, NmeaType type)
+{
+    char   body[128];
+    char   utc[16];
+    size_t n = 0;
+    double lat_min, lon_min;
+
+    synth_pos(i, &lat_min, &lon_min);
+    synth_utc(utc, sizeof(utc), i, rate_hz);
+
+    switch (type) {
+        case NMEA_RMC:
+            snprintf(body, sizeof(body), "GPRMC,%s,A,37%08.5f,N,127%08.5f,E,0.052,,191026,,,A",
+                     utc, lat_min, lon_min);
+            return nmea_synth_sentence(out, body);
+        case NMEA_VTG:
+            return nmea_synth_sentence(out, "GPVTG,,T,,M,0.052,N,0.096,K,A");
+        case NMEA_GGA:
+            snprintf(body, sizeof(body), "GPGGA,%s,37%08.5f,N,127%08.5f,E,1,08,1.01,52.3,M,18.4,M,,",
+                     utc, lat_min, lon_min);
+            return nmea_synth_sentence(out, body);
+        case NMEA_GSA:
+            return nmea_synth_sentence(out, "GPGSA,A,3,02,05,13,15,18,20,24,29,,,,,2.11,1.01,1.85");
+        case NMEA_GSV:
+            n += nmea_synth_sentence(out + n, "GPGSV,3,1,11,02,45,093,38,05,71,311,41,13,28,045,33,15,22,196,30");
+            n += nmea_synth_sentence(out + n, "GPGSV,3,2,11,18,33,254,35,20,55,152,40,24,12,318,25,29,40,268,37");
+            n += nmea_synth_sentence(out + n, "GPGSV,3,3,11,30,05,120,,43,44,218,,50,44,218,");
+            return n;
+        case NMEA_GLL:
+            snprintf(body, sizeof(body), "GPGLL,37%08.5f,N,127%08.5f,E,%s,A,A",
+                     lat_min, lon_min, utc);
+            return nmea_synth_sentence(out, body);
+        default:
+            return 0;
+    }
+}
+
+size_t nmea_synth_epoch(char *out, int i, int rate_hz)
+{
+    static const NmeaType order[] = {
+        NMEA_RMC, NMEA_VTG, NMEA_GGA, NMEA_GSA, NMEA_GSV, NMEA_GLL,
+    };
+    size_t n = 0;
+
+    for (size_t k = 0; k < sizeof(order) / sizeof(order[0]); k++)
+        n += nmea_synth_type(out + n, i, rate_hz, order[k]);
+    return n;
+}
+
+int nmea_synth_index(int time_ms, int rate_hz)
+{
+    return (int)(((int64_t)time_ms * rate_hz + 500) / 1000);
+}
+
+// ─────────────────────────────────────────────
+//  UBX
+// ─────────────────────────────────────────────
+
+size_t ubx_synth_nav(uint8_t *out, int i, int rate_hz, uint8_t id)
+{
+    uint8_t  pl[92];
+    uint32_t itow = SYNTH_GPS_TOW0 + (uint32_t)((int64_t)i * 1000 / rate_hz);
+    double   lat_min, lon_min;
+
+    synth_pos(i, &lat_min, &lon_min);
+    // NMEA 출력 (분 5자리) 과 같은 값이 되도록 1e-5 분 단위로 반올림 후 변환
+    int64_t lat_e5 = (int64_t)(lat_min * 1e5 + 0.5), lon_e5 = (int64_t)(lon_min * 1e5 + 0.5);
+    int32_t lat = (int32_t)(37 * 10000000LL + (lat_e5 * 100 + 30) / 60);
+    int32_t lon = (int32_t)(127 * 10000000LL + (lon_e5 * 100 + 30) / 60);
+
+    switch (id) {
+        case UBX_NAV_PVT: {
+            int ms = (int)((int64_t)i * 1000 / rate_hz % 86400000);
+            memset(pl, 0, sizeof(pl));
+            ubx_put_u4(pl + 0, itow);
+            ubx_put_u2(pl + 4, 2026);
+            pl[6]  = 10;
+            pl[7]  = 19;
+            pl[8]  = (uint8_t)(ms / 3600000);
+            pl[9]  = (uint8_t)(ms / 60000 % 60);
+            pl[10] = (uint8_t)(ms / 1000 % 60);
+            pl[11] = 0x07;                                  // validDate | validTime | fullyResolved
+            ubx_put_u4(pl + 16, (uint32_t)(ms % 1000 * 1000000));
+            pl[20] = 3;                                     // 3D
+            pl[21] = 0x01;                                  // gnssFixOK
+            pl[23] = 8;
+            ubx_put_u4(pl + 24, (uint32_t)lon);
+            ubx_put_u4(pl + 28, (uint32_t)lat);
+            ubx_put_u4(pl + 32, 70700);                     // 타원체 고도 mm
+            ubx_put_u4(pl + 36, 52300);                     // 해발 mm
+            ubx_put_u4(pl + 40, 2500);
+            ubx_put_u4(pl + 44, 3800);
+            ubx_put_u4(pl + 52, 27);                        // velE mm/s
+            ubx_put_u4(pl + 60, 27);
+            ubx_put_u4(pl + 64, 9000000);                   // 90°
+            ubx_put_u4(pl + 68, 350);
+            ubx_put_u2(pl + 76, 211);
+            return ubx_build(out, UBX_NAV, UBX_NAV_PVT, pl, 92);
+        }
+
+        case UBX_NAV_POSLLH:
+            ubx_put_u4(pl + 0, itow);
+            ubx_put_u4(pl + 4, (uint32_t)lon);
+            ubx_put_u4(pl + 8, (uint32_t)lat);
+            ubx_put_u4(pl + 12, 70700);
+            ubx_put_u4(pl + 16, 52300);
+            ubx_put_u4(pl + 20, 2500);
+            ubx_put_u4(pl + 24, 3800);
+            return ubx_build(out, UBX_NAV, UBX_NAV_POSLLH, pl, 28);
+
+        case UBX_NAV_SOL:
+            memset(pl, 0, 52);
+            ubx_put_u4(pl + 0, itow);
+            ubx_put_u2(pl + 8, SYNTH_GPS_WEEK);
+            pl[10] = 3;
+            pl[11] = UBX_SOL_FIX_OK | UBX_SOL_WKN_SET | UBX_SOL_TOW_SET;
+            ubx_put_u4(pl + 24, 300);                           // pAcc cm
+            ubx_put_u4(pl + 40, 35);                            // sAcc cm/s
+            ubx_put_u2(pl + 44, 211);
+            pl[47] = 8;
+            return ubx_build(out, UBX_NAV, UBX_NAV_SOL, pl, 52);
+
+        case UBX_NAV_VELNED:
+            memset(pl, 0, 36);
+            ubx_put_u4(pl + 0, itow);
+            ubx_put_u4(pl + 8, 3);                              // velE cm/s
+            ubx_put_u4(pl + 16, 3);
+            ubx_put_u4(pl + 20, 3);
+            ubx_put_u4(pl + 24, 9000000);
+            ubx_put_u4(pl + 28, 35);
+            ubx_put_u4(pl + 32, 500000);
+            return ubx_build(out, UBX_NAV, UBX_NAV_VELNED, pl, 36);
+
+        default:
+            return 0;
+    }
+}
+
+size_t ubx_synth_epoch(uint8_t *out, int i, int rate_hz, UbxSynthSet set)
+{
+    size_t n = 0;
+
+    if (set == UBX_SYNTH_PVT)
+        return ubx_synth_nav(out, i, rate_hz, UBX_NAV_PVT);
+
+    n += ubx_synth_nav(out + n, i, rate_hz, UBX_NAV_POSLLH);
+    n += ubx_synth_nav(out + n, i, rate_hz, UBX_NAV_SOL);
+    n += ubx_synth_nav(out + n, i, rate_hz, UBX_NAV_VELNED);
+    return n;
+}
+
+// ─────────────────────────────────────────────
+//  난수 / 비교
+// ─────────────────────────────────────────────
+static uint64_t rng = SYNTH_SEED;
+
+void synth_seed(uint64_t seed)
+{
+    rng = seed ? seed : SYNTH_SEED;
+}
+
+double synth_urand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (rng >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double synth_grand(void)
+{
+    double u = synth_urand(), v = synth_urand();
+    if (u < 1e-300) u = 1e-300;
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+int synth_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int synth_cmp_i64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
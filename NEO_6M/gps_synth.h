@@ -0,0 +1,88 @@
+#ifndef GPS_SYNTH_H
+#define GPS_SYNTH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nmea_msg.h"
+
+// ─────────────────────────────────────────────
+//  합성 NMEA / UBX 스트림 (벤치마크 / 시뮬레이터 공용)
+//  NEO-6M 기본 출력 순서: RMC VTG GGA GSA GSV×3 GLL
+//  UTC 2026-10-19 00:00:00 부터 i / rate_hz 초, 두 프로토콜 같은 위치
+// ─────────────────────────────────────────────
+
+#define NMEA_SYNTH_SENTENCES    8       // epoch 당 문장 수
+#define NMEA_SYNTH_EPOCH_MAX    1024    // epoch 1개 최대 바이트
+
+/**
+ * @brief "$body*hh\r\n" 형식으로 출력
+ * @return 출력한 바이트 수
+ */
+size_t nmea_synth_sentence(char *out, const char *body);
+
+/**
+ * @brief i 번째 epoch 의 type 문장만 출력 (GSV 는 3문장)
+ * @return 출력한 바이트 수 (미지원 타입 0)
+ */
+size_t nmea_synth_type(char *out, int i, int rate_hz, NmeaType type);
+
+/**
+ * @brief i 번째 epoch 출력 (UTC 시각 = i / rate_hz 초)
+ * @return 출력한 바이트 수
+ */
+size_t nmea_synth_epoch(char *out, int i, int rate_hz);
+
+/**
+ * @brief nmea_synth_epoch 의 UTC 시각 → epoch 번호
+ */
+int nmea_synth_index(int time_ms, int rate_hz);
+
+// UBX epoch 구성
+typedef enum {
+    UBX_SYNTH_NEO6 = 0,     // NAV-POSLLH + NAV-SOL + NAV-VELNED (u-blox 6)
+    UBX_SYNTH_PVT,          // NAV-PVT (u-blox 7 이상)
+} UbxSynthSet;
+
+#define UBX_SYNTH_EPOCH_MAX     256
+
+/**
+ * @brief i 번째 epoch 의 NAV 메시지 1개 (UBX_NAV_POSLLH/SOL/VELNED/PVT)
+ * @return 출력한 바이트 수 (미지원 id 0)
+ */
+size_t ubx_synth_nav(uint8_t *out, int i, int rate_hz, uint8_t id);
+
+/**
+ * @brief i 번째 epoch 를 UBX NAV 메시지로 출력
+ * @return 출력한 바이트 수
+ */
+size_t ubx_synth_epoch(uint8_t *out, int i, int rate_hz, UbxSynthSet set);
+
+// ─────────────────────────────────────────────
+//  벤치 공용 난수 (xorshift64 + Box-Muller) / qsort 비교
+//  시드가 같으면 벤치마다 같은 수열 (프로세스당 상태 하나)
+// ─────────────────────────────────────────────
+
+#define SYNTH_SEED  88172645463325252ULL
+
+/**
+ * @brief 난수 시드 (0 이면 SYNTH_SEED, xorshift 는 0 에서 멈춤)
+ */
+void synth_seed(uint64_t seed);
+
+/**
+ * @brief [0, 1) 균등 분포
+ */
+double synth_urand(void);
+
+/**
+ * @brief 표준 정규 분포 N(0, 1)
+ */
+double synth_grand(void);
+
+/**
+ * @brief qsort 비교 (오름차순)
+ */
+int synth_cmp_double(const void *a, const void *b);
+int synth_cmp_i64(const void *a, const void *b);
+
+#endif /* GPS_SYNTH_H */
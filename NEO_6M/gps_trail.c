@@ -0,0 +1,618 @@
+#include "gps_trail.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gps_fix.h"
+
+#define NO_ID   UINT32_MAX
+
+// 질의 상태
+typedef struct {
+    double       qe, qn;
+    double       r2;                    // 반경² (nearest 는 지금까지 최단 거리²)
+    uint32_t     limit;                 // 이 순번 미만만
+    uint32_t     best;
+    size_t       found;
+    GpsTrailHit *hits;
+    size_t       max;
+} Query;
+
+static inline double dist2(const GpsTrailPoint *p, double e, double n)
+{
+    double de = p->e - e, dn = p->n - n;
+    return de * de + dn * dn;
+}
+
+static void fill_hit(const GpsTrail *t, uint32_t i, double d2, GpsTrailHit *h)
+{
+    h->index = i;
+    h->dist  = sqrt(d2);
+    h->t_ns  = t->t0_ns + (int64_t)t->pt[i].t_ms * 1000000;
+    geo_ltp_inv(&t->ltp, t->pt[i].e, t->pt[i].n, &h->lat, &h->lon);
+}
+
+/**
+ * @brief before_ns 이전에 저장한 점의 순번 상한 (t_ms 는 단조 증가)
+ */
+static uint32_t limit_of(const GpsTrail *t, int64_t before_ns)
+{
+    if (before_ns == INT64_MAX) return (uint32_t)t->count;
+    if (t->count == 0 || before_ns <= t->t0_ns) return 0;
+
+    int64_t rel = (before_ns - t->t0_ns) / 1000000;
+    size_t  lo = 0, hi = t->count;
+    while (lo < hi) {                               // t_ms >= rel 인 첫 점
+        size_t mid = (lo + hi) / 2;
+        if ((int64_t)t->pt[mid].t_ms < rel) lo = mid + 1;
+        else                                hi = mid;
+    }
+    return (uint32_t)lo;
+}
+
+// ─────────────────────────────────────────────
+//  k-d tree 만들기 (나눠서)
+//
+//  t->next 배열에 [0, n) 을 복사한 뒤 구간 [lo, hi) 마다 하위 최소 순번을 훑고
+//  긴 축 중앙값을 quickselect 로 가운데 (lo + hi) / 2 에 놓는다. 모든 단계가
+//  build_step 한 번에 budget 개 원소까지만 다루고 다음 걸음에 이어 간다.
+// ─────────────────────────────────────────────
+enum { BUILD_IDLE, BUILD_COPY, BUILD_NODE, BUILD_MIN, BUILD_SELECT, BUILD_PART };
+
+static inline void kd_swap(GpsTrailBuild *b, size_t x, size_t y)
+{
+    float    e = b->xy[2 * x], n = b->xy[2 * x + 1];
+    uint32_t id = b->id[x];
+
+    b->xy[2 * x]     = b->xy[2 * y];
+    b->xy[2 * x + 1] = b->xy[2 * y + 1];
+    b->id[x]         = b->id[y];
+    b->xy[2 * y]     = e;
+    b->xy[2 * y + 1] = n;
+    b->id[y]         = id;
+}
+
+static inline void push_task(GpsTrailBuild *b, uint32_t lo, uint32_t hi,
+                             float x0, float y0, float x1, float y1)
+{
+    if (lo < hi) b->stack[b->sp++] = (GpsTrailTask){ lo, hi, x0, y0, x1, y1 };
+}
+
+/**
+ * @brief 지금 구간의 중앙값이 제자리에 왔을 때: 노드 기록, 하위 구간 두 개 쌓기
+ */
+static void finish_node(GpsTrailBuild *b)
+{
+    GpsTrailTask c = b->cur;
+    size_t       mid = c.lo + (c.hi - c.lo) / 2;
+    float        split = b->xy[2 * mid + b->cur_axis];
+
+    b->axis[mid] = (uint8_t)b->cur_axis;
+    b->min[mid]  = b->cur_min;
+    if (b->cur_axis == 0) {
+        push_task(b, mid + 1, c.hi, split, c.y0, c.x1, c.y1);
+        push_task(b, c.lo, mid, c.x0, c.y0, split, c.y1);
+    } else {
+        push_task(b, mid + 1, c.hi, c.x0, split, c.x1, c.y1);
+        push_task(b, c.lo, mid, c.x0, c.y0, c.x1, split);
+    }
+}
+
+/**
+ * @brief 다 만든 tree 를 질의용과 바꿈
+ */
+static void build_swap(GpsTrail *t)
+{
+    GpsTrailBuild *b = &t->next;
+    float    *xy = t->kd_xy;
+    uint32_t *id = t->kd_id, *mn = t->kd_min;
+    uint8_t  *ax = t->kd_axis;
+
+    t->kd_xy   = b->xy;
+    t->kd_id   = b->id;
+    t->kd_min  = b->min;
+    t->kd_axis = b->axis;
+    t->kd_n    = b->n;
+    b->xy   = xy;
+    b->id   = id;
+    b->min  = mn;
+    b->axis = ax;
+    b->stage = BUILD_IDLE;
+    t->stats.rebuilds++;
+}
+
+/**
+ * @brief [0, count) 로 새 tree 만들기 시작, tail 이 지금의 절반만큼 더 쌓이기 전에 끝나도록 걸음 크기
+ */
+static void build_start(GpsTrail *t)
+{
+    GpsTrailBuild *b = &t->next;
+    size_t         levels = 1, tail = t->count - t->kd_n;
+
+    while (((size_t)1 << levels) <= t->count) levels++;
+    b->n      = t->count;
+    b->stage  = BUILD_COPY;
+    b->pos    = 0;
+    b->sp     = 0;
+    b->x0     = b->y0 = INFINITY;
+    b->x1     = b->y1 = -INFINITY;
+    // 단계마다 원소당 복사 1 + 훑기 1 + quickselect ~2 (중앙값 셋 피벗 평균)
+    b->budget = t->count * (levels * 3 + 1) * 2 / (tail ? tail : 1) + 64;
+}
+
+/**
+ * @brief 새 tree 를 budget 개 원소만큼 만들기
+ * @return 1: 다 만들어 바꿈, 0: 아직
+ */
+static int build_step(GpsTrail *t, size_t budget)
+{
+    GpsTrailBuild *b = &t->next;
+    size_t         work = 0;
+
+    while (work < budget) {
+        switch (b->stage) {
+        case BUILD_IDLE:
+            return 0;
+
+        case BUILD_COPY:
+            for (; b->pos < b->n && work < budget; b->pos++, work++) {
+                float e = t->pt[b->pos].e, n = t->pt[b->pos].n;
+                b->xy[2 * b->pos]     = e;
+                b->xy[2 * b->pos + 1] = n;
+                b->id[b->pos]         = (uint32_t)b->pos;
+                if (e < b->x0) b->x0 = e;
+                if (e > b->x1) b->x1 = e;
+                if (n < b->y0) b->y0 = n;
+                if (n > b->y1) b->y1 = n;
+            }
+            if (b->pos == b->n) {
+                push_task(b, 0, (uint32_t)b->n, b->x0, b->y0, b->x1, b->y1);
+                b->stage = BUILD_NODE;
+            }
+            break;
+
+        case BUILD_NODE:
+            if (b->sp == 0) {
+                build_swap(t);
+                return 1;
+            }
+            b->cur      = b->stack[--b->sp];
+            b->cur_min  = NO_ID;
+            b->cur_axis = (b->cur.y1 - b->cur.y0 > b->cur.x1 - b->cur.x0);
+            b->pos      = b->cur.lo;
+            b->stage    = BUILD_MIN;
+            work++;
+            break;
+
+        case BUILD_MIN:
+            for (; b->pos < b->cur.hi && work < budget; b->pos++, work++)
+                if (b->id[b->pos] < b->cur_min) b->cur_min = b->id[b->pos];
+            if (b->pos == b->cur.hi) {
+                b->s_lo  = b->cur.lo;
+                b->s_hi  = b->cur.hi;
+                b->stage = BUILD_SELECT;
+            }
+            break;
+
+        case BUILD_SELECT: {
+            // [s_lo, s_hi) 에서 axis 기준 mid 번째 점을 제자리에 (왼쪽 ≤, 오른쪽 ≥)
+            const float *xy = b->xy + b->cur_axis;
+            size_t       lo = b->s_lo, hi = b->s_hi;
+            if (hi - lo > 2) {
+                size_t mid = lo + (hi - lo) / 2;
+                float  x = xy[2 * lo], y = xy[2 * mid], z = xy[2 * (hi - 1)];
+                b->pivot = (x < y) ? ((y < z) ? y : (x < z ? z : x))
+                                   : ((x < z) ? x : (y < z ? y : z));
+                b->s_i   = lo;
+                b->s_j   = hi - 1;
+                b->stage = BUILD_PART;
+            } else {
+                if (hi - lo == 2 && xy[2 * lo] > xy[2 * lo + 2]) kd_swap(b, lo, lo + 1);
+                finish_node(b);
+                b->stage = BUILD_NODE;
+            }
+            work++;
+            break;
+        }
+
+        case BUILD_PART: {
+            // Hoare 분할, 한 원소씩 (걸음 사이에 s_i / s_j 유지)
+            const float *xy = b->xy + b->cur_axis;
+            while (work < budget) {
+                work++;
+                if (xy[2 * b->s_i] < b->pivot) { b->s_i++; continue; }
+                if (xy[2 * b->s_j] > b->pivot) { b->s_j--; continue; }
+                if (b->s_i >= b->s_j) {
+                    size_t k = b->cur.lo + (b->cur.hi - b->cur.lo) / 2;
+                    if (k <= b->s_j) b->s_hi = b->s_j + 1;
+                    else             b->s_lo = b->s_j + 1;
+                    b->stage = BUILD_SELECT;
+                    break;
+                }
+                kd_swap(b, b->s_i++, b->s_j--);
+            }
+            break;
+        }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 지금 점 전부로 한 번에 다시 만들기 (만들던 것은 버림)
+ */
+static void rebuild(GpsTrail *t)
+{
+    int64_t t0 = gps_now_ns();
+
+    build_start(t);
+    build_step(t, SIZE_MAX);
+
+    int64_t dt = gps_now_ns() - t0;
+    if (dt > t->stats.rebuild_max_ns) t->stats.rebuild_max_ns = dt;
+}
+
+/**
+ * @brief 상한에 닿으면 간격을 두 배로 늘려 저장 점을 다시 솎기 (첫 / 마지막 점은 유지)
+ */
+static void thin(GpsTrail *t)
+{
+    do {
+        size_t k = 1;
+        t->min_dist *= 2.0;
+        double md2 = t->min_dist * t->min_dist;
+        for (size_t i = 1; i < t->count; i++) {
+            if (i == t->count - 1 || dist2(&t->pt[i], t->pt[k - 1].e, t->pt[k - 1].n) >= md2)
+                t->pt[k++] = t->pt[i];
+        }
+        t->count = k;
+    } while (t->count > t->max_points / 4 * 3);
+    t->stats.thins++;
+    rebuild(t);
+}
+
+// ─────────────────────────────────────────────
+//  공개 API
+// ─────────────────────────────────────────────
+int gps_trail_init(GpsTrail *t, size_t max_points, double min_dist_m)
+{
+    memset(t, 0, sizeof(GpsTrail));
+    if (max_points == 0) max_points = GPS_TRAIL_MAX_POINTS;
+    if (max_points < 16 || max_points >= NO_ID) {
+        errno = EINVAL;
+        return -1;
+    }
+    t->max_points = max_points;
+    t->min_dist   = (min_dist_m > 0.0) ? min_dist_m : GPS_TRAIL_MIN_DIST;
+    t->pt         = malloc(max_points * sizeof(GpsTrailPoint));
+    t->kd_xy      = malloc(max_points * 2 * sizeof(float));
+    t->kd_id      = malloc(max_points * sizeof(uint32_t));
+    t->kd_min     = malloc(max_points * sizeof(uint32_t));
+    t->kd_axis    = malloc(max_points);
+    t->next.xy    = malloc(max_points * 2 * sizeof(float));
+    t->next.id    = malloc(max_points * sizeof(uint32_t));
+    t->next.min   = malloc(max_points * sizeof(uint32_t));
+    t->next.axis  = malloc(max_points);
+    if (!t->pt || !t->kd_xy || !t->kd_id || !t->kd_min || !t->kd_axis ||
+        !t->next.xy || !t->next.id || !t->next.min || !t->next.axis) {
+        gps_trail_free(t);
+        errno = ENOMEM;
+        return -1;
+    }
+    return 0;
+}
+
+int gps_trail_add(GpsTrail *t, double lat, double lon, int64_t t_ns)
+{
+    double e = 0.0, n = 0.0;
+
+    t->stats.fixes++;
+    if (t->count == 0) {
+        geo_ltp_init(&t->ltp, lat, lon, 0.0);
+        t->t0_ns = t_ns;
+    } else {
+        geo_ltp_fwd(&t->ltp, lat, lon, &e, &n);
+        if (dist2(&t->pt[t->count - 1], e, n) < t->min_dist * t->min_dist) return 0;
+        if (t->count == t->max_points) thin(t);
+    }
+
+    int64_t  rel  = (t_ns - t->t0_ns) / 1000000;
+    if (rel > UINT32_MAX) rel = UINT32_MAX;         // 49일 이후는 시각 고정
+    uint32_t last = t->count ? t->pt[t->count - 1].t_ms : 0;
+    GpsTrailPoint *p = &t->pt[t->count++];
+    p->e    = (float)e;
+    p->n    = (float)n;
+    p->t_ms = (rel > (int64_t)last) ? (uint32_t)rel : last;
+    t->stats.stored++;
+
+    size_t tail = t->count - t->kd_n;
+    if (t->next.stage == BUILD_IDLE &&
+        (tail > GPS_TRAIL_TAIL_MAX ||
+         (tail > GPS_TRAIL_TAIL_MIN && tail > t->kd_n / GPS_TRAIL_TAIL_DIV))) build_start(t);
+    if (t->next.stage != BUILD_IDLE) {
+        // 분할이 한쪽으로 몰려 늦어지면 (tail 이 상한 두 배) 남은 만큼 한 번에
+        size_t  budget = (tail > 2 * GPS_TRAIL_TAIL_MAX) ? SIZE_MAX : t->next.budget;
+        int64_t t0 = gps_now_ns();
+        build_step(t, budget);
+        int64_t dt = gps_now_ns() - t0;
+        t->stats.steps++;
+        if (dt > t->stats.step_max_ns) t->stats.step_max_ns = dt;
+    }
+    return 1;
+}
+
+void gps_trail_build(GpsTrail *t)
+{
+    if (t->kd_n != t->count) rebuild(t);
+}
+
+// ─────────────────────────────────────────────
+//  질의
+// ─────────────────────────────────────────────
+static void kd_nearest(const GpsTrail *t, Query *q, size_t lo, size_t hi)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t->kd_min[mid] >= q->limit) return;
+
+        double px = t->kd_xy[2 * mid], py = t->kd_xy[2 * mid + 1];
+        if (t->kd_id[mid] < q->limit) {
+            double de = px - q->qe, dn = py - q->qn, d2 = de * de + dn * dn;
+            if (d2 < q->r2) {
+                q->r2   = d2;
+                q->best = t->kd_id[mid];
+            }
+        }
+
+        double diff = t->kd_axis[mid] ? q->qn - py : q->qe - px;
+        if (diff < 0.0) {
+            kd_nearest(t, q, lo, mid);
+            if (diff * diff >= q->r2) return;
+            lo = mid + 1;                           // 먼 쪽은 반복으로
+        } else {
+            kd_nearest(t, q, mid + 1, hi);
+            if (diff * diff >= q->r2) return;
+            hi = mid;
+        }
+    }
+}
+
+static void kd_radius(const GpsTrail *t, Query *q, size_t lo, size_t hi, double r)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t->kd_min[mid] >= q->limit) return;
+
+        double px = t->kd_xy[2 * mid], py = t->kd_xy[2 * mid + 1];
+        double de = px - q->qe, dn = py - q->qn, d2 = de * de + dn * dn;
+        if (d2 <= q->r2 && t->kd_id[mid] < q->limit) {
+            if (q->found < q->max) fill_hit(t, t->kd_id[mid], d2, &q->hits[q->found]);
+            q->found++;
+        }
+
+        double diff = t->kd_axis[mid] ? q->qn - py : q->qe - px;
+        int    left = (diff <= r), right = (diff >= -r);
+        if (left && right) kd_radius(t, q, lo, mid, r);
+        if (right) lo = mid + 1;
+        else       hi = mid;
+    }
+}
+
+/**
+ * @brief 반경 안 가장 작은 순번 (하위 트리 최소 순번으로 가지치기)
+ */
+static void kd_oldest(const GpsTrail *t, Query *q, size_t lo, size_t hi, double r)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t->kd_min[mid] >= q->best) return;
+
+        double px = t->kd_xy[2 * mid], py = t->kd_xy[2 * mid + 1];
+        double de = px - q->qe, dn = py - q->qn;
+        if (t->kd_id[mid] < q->best && de * de + dn * dn <= q->r2) q->best = t->kd_id[mid];
+
+        double diff = t->kd_axis[mid] ? q->qn - py : q->qe - px;
+        int    left = (diff <= r), right = (diff >= -r);
+        if (left && right) kd_oldest(t, q, lo, mid, r);
+        if (right) lo = mid + 1;
+        else       hi = mid;
+    }
+}
+
+static uint32_t oldest_within(const GpsTrail *t, double e, double n, double r)
+{
+    Query q = { .qe = e, .qn = n, .r2 = r * r, .best = NO_ID };
+
+    kd_oldest(t, &q, 0, t->kd_n, r);
+    if (q.best != NO_ID) return q.best;
+    for (size_t i = t->kd_n; i < t->count; i++)     // tail 은 tree 보다 모두 나중
+        if (dist2(&t->pt[i], e, n) <= q.r2) return (uint32_t)i;
+    return NO_ID;
+}
+
+int gps_trail_nearest(const GpsTrail *t, double lat, double lon, int64_t before_ns,
+                      GpsTrailHit *hit)
+{
+    Query q = { .r2 = INFINITY, .best = NO_ID, .limit = limit_of(t, before_ns) };
+
+    if (q.limit > 0) {
+        geo_ltp_fwd(&t->ltp, lat, lon, &q.qe, &q.qn);
+        kd_nearest(t, &q, 0, t->kd_n);
+        for (size_t i = t->kd_n; i < q.limit; i++) {
+            double d2 = dist2(&t->pt[i], q.qe, q.qn);
+            if (d2 < q.r2) {
+                q.r2   = d2;
+                q.best = (uint32_t)i;
+            }
+        }
+    }
+    if (q.best == NO_ID) {
+        errno = ENOENT;
+        return -1;
+    }
+    fill_hit(t, q.best, q.r2, hit);
+    return 0;
+}
+
+size_t gps_trail_radius(const GpsTrail *t, double lat, double lon, double radius_m,
+                        int64_t before_ns, GpsTrailHit *hits, size_t max)
+{
+    Query q = { .r2 = radius_m * radius_m, .limit = limit_of(t, before_ns), .hits = hits, .max = max };
+
+    if (q.limit == 0 || radius_m < 0.0) return 0;
+    geo_ltp_fwd(&t->ltp, lat, lon, &q.qe, &q.qn);
+    kd_radius(t, &q, 0, t->kd_n, radius_m);
+    for (size_t i = t->kd_n; i < q.limit; i++) {
+        double d2 = dist2(&t->pt[i], q.qe, q.qn);
+        if (d2 <= q.r2) {
+            if (q.found < max) fill_hit(t, (uint32_t)i, d2, &hits[q.found]);
+            q.found++;
+        }
+    }
+    return q.found;
+}
+
+// ─────────────────────────────────────────────
+//  귀환 경로
+// ─────────────────────────────────────────────
+/**
+ * @brief Douglas-Peucker (반복, 명시적 스택), keep[i] = 1 이면 남김
+ */
+static int simplify(const double *e, const double *n, size_t m, double tol, uint8_t *keep)
+{
+    size_t *stack = malloc(2 * m * sizeof(size_t));
+    size_t  sp = 0;
+
+    if (!stack) return -1;
+    keep[0] = keep[m - 1] = 1;
+    stack[sp++] = 0;
+    stack[sp++] = m - 1;
+    while (sp) {
+        size_t b = stack[--sp], a = stack[--sp];
+        double ue = e[b] - e[a], un = n[b] - n[a], len = sqrt(ue * ue + un * un);
+        double worst = -1.0;
+        size_t wi = a;
+        for (size_t i = a + 1; i < b; i++) {
+            double de = e[i] - e[a], dn = n[i] - n[a];
+            double d  = (len > 1e-9) ? fabs(de * un - dn * ue) / len : sqrt(de * de + dn * dn);
+            if (d > worst) {
+                worst = d;
+                wi    = i;
+            }
+        }
+        if (worst > tol) {
+            keep[wi] = 1;
+            stack[sp++] = a;
+            stack[sp++] = wi;
+            stack[sp++] = wi;
+            stack[sp++] = b;
+        }
+    }
+    free(stack);
+    return 0;
+}
+
+int gps_trail_home(const GpsTrail *t, double lat, double lon, double tol_m, double shortcut_m,
+                   GpsTrailWaypointCb cb, void *user)
+{
+    if (t->count == 0) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    size_t   m = 0, cap = t->count + 1;
+    double  *pe = malloc(cap * sizeof(double));
+    double  *pn = malloc(cap * sizeof(double));
+    uint8_t *keep = calloc(cap, 1);
+    int      added = -1;
+    if (!pe || !pn || !keep) {
+        errno = ENOMEM;
+        goto out;
+    }
+
+    // 현재 위치에서 거꾸로 (shortcut 안에 더 오래된 점이 있으면 건너뜀)
+    geo_ltp_fwd(&t->ltp, lat, lon, &pe[0], &pn[0]);
+    m = 1;
+    uint32_t i = (uint32_t)t->count - 1;
+    double   qe = pe[0], qn = pn[0], step2 = shortcut_m * shortcut_m / 4.0;
+    if (shortcut_m > 0.0) {
+        uint32_t j = oldest_within(t, qe, qn, shortcut_m);
+        if (j != NO_ID) i = j;
+    }
+    for (;;) {
+        pe[m] = t->pt[i].e;
+        pn[m] = t->pt[i].n;
+        m++;
+        if (i == 0) break;
+        if (shortcut_m > 0.0 && dist2(&t->pt[i], qe, qn) >= step2) {
+            qe = t->pt[i].e;                        // shortcut / 2 마다 질의
+            qn = t->pt[i].n;
+            uint32_t j = oldest_within(t, qe, qn, shortcut_m);
+            if (j != NO_ID && j + 1 < i) {
+                i = j;
+                continue;
+            }
+        }
+        i--;
+    }
+
+    if (simplify(pe, pn, m, tol_m, keep) < 0) {
+        errno = ENOMEM;
+        goto out;
+    }
+
+    double le = INFINITY, ln = INFINITY;
+    added = 0;
+    for (size_t k = 0; k < m; k++) {
+        if (!keep[k] || hypot(pe[k] - le, pn[k] - ln) < 0.05) continue;    // 같은 점 (gps_route_add 거부)
+        double wlat, wlon;
+        geo_ltp_inv(&t->ltp, pe[k], pn[k], &wlat, &wlon);
+        if (cb(wlat, wlon, user) != 0) {
+            errno = ECANCELED;
+            added = -1;
+            break;
+        }
+        le = pe[k];
+        ln = pn[k];
+        added++;
+    }
+
+out:
+    free(pe);
+    free(pn);
+    free(keep);
+    return added;
+}
+
+void gps_trail_get(const GpsTrail *t, size_t i, double *lat, double *lon, int64_t *t_ns)
+{
+    geo_ltp_inv(&t->ltp, t->pt[i].e, t->pt[i].n, lat, lon);
+    if (t_ns) *t_ns = t->t0_ns + (int64_t)t->pt[i].t_ms * 1000000;
+}
+
+size_t gps_trail_memory(const GpsTrail *t)
+{
+    return t->max_points * (sizeof(GpsTrailPoint) + 2 * (2 * sizeof(float) + 2 * sizeof(uint32_t) + 1));
+}
+
+void gps_trail_free(GpsTrail *t)
+{
+    free(t->pt);
+    free(t->kd_xy);
+    free(t->kd_id);
+    free(t->kd_min);
+    free(t->kd_axis);
+    free(t->next.xy);
+    free(t->next.id);
+    free(t->next.min);
+    free(t->next.axis);
+    memset(&t->next, 0, sizeof(t->next));
+    t->pt      = NULL;
+    t->kd_xy   = NULL;
+    t->kd_id   = NULL;
+    t->kd_min  = NULL;
+    t->kd_axis = NULL;
+    t->count   = 0;
+    t->kd_n    = 0;
+}
@@ -0,0 +1,170 @@
+#ifndef GPS_TRAIL_H
+#define GPS_TRAIL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "geo.h"
+
+// ─────────────────────────────────────────────
+//  이동 궤적 (breadcrumb) 저장 + k-d tree 질의 + 귀환 경로
+//
+//  fix 를 첫 점 기준 접평면 ENU float (점당 12 바이트: e, n, 시각 ms) 로 저장한다.
+//  직전 저장 점에서 min_dist 이상 움직였을 때만 저장하고 (정지 중 점 없음), 개수가
+//  max_points 에 닿으면 간격을 두 배로 늘려 이미 저장한 점도 다시 솎는다 (메모리 고정).
+//
+//  색인: 저장 순서 앞부분 [0, kd_n) 의 정적 k-d tree + 뒷부분 (tail) 선형 검사.
+//  tail 이 tree 크기의 1/8 또는 GPS_TRAIL_TAIL_MAX 를 넘으면 tree 를 새로 만든다 (분할 축은 상자의 긴 쪽,
+//  노드마다 하위 트리의 최소 점 번호를 저장 → "이 시각 이전 점만" 질의에서 가지치기).
+//  새 tree 는 두 번째 색인 배열에 add 마다 정해진 양씩 나눠 만들고 (그동안 질의는 이전 tree +
+//  tail), 다 되면 바꾼다 → add 한 번의 비용은 점 수와 상관없이 수십 µs 이하. 솎기만 예외 (한 번에).
+//
+//  - float 접평면이라 첫 점에서 100 km 이내 1 cm 이하 양자화, geo_ltp_fwd 근사는
+//    10 km 이내 cm 수준 (geo.h)
+//  - 귀환 경로: 현재 위치에서 거꾸로 궤적을 따라가며, shortcut 거리 안에 더 오래된 점이
+//    있으면 그 점으로 건너뛰어 (고리 생략) Douglas-Peucker 로 줄인 waypoint 목록
+//    (gps_route_add / gps_route_load 로 그대로 따라갈 수 있음)
+// ─────────────────────────────────────────────
+
+#define GPS_TRAIL_MIN_DIST      1.0         // 기본 저장 간격 (m)
+#define GPS_TRAIL_MAX_POINTS    (1u << 20)  // 기본 점 수 상한 (약 48 MB, 색인 두 벌 포함)
+#define GPS_TRAIL_TAIL_MIN      1024        // 이보다 tail 이 짧으면 tree 를 다시 만들지 않음
+#define GPS_TRAIL_TAIL_DIV      8           // tail > kd_n / 8 이면 다시 만듦
+#define GPS_TRAIL_TAIL_MAX      4096        // tail 선형 검사 상한 (질의 ~10 µs)
+
+// 저장 점 (접평면 float)
+typedef struct {
+    float    e, n;
+    uint32_t t_ms;                      // 첫 점 이후 ms
+} GpsTrailPoint;
+
+typedef struct {
+    uint32_t index;                     // 저장 순번 (0 = 가장 오래된 점)
+    double   dist;                      // 질의 점까지 (m)
+    double   lat, lon;
+    int64_t  t_ns;                      // 저장 시각 (gps_trail_add 의 t_ns)
+} GpsTrailHit;
+
+// 귀환 경로 waypoint 하나 (0 이 아니면 중단)
+typedef int (*GpsTrailWaypointCb)(double lat, double lon, void *user);
+
+typedef struct {
+    uint64_t fixes;                     // gps_trail_add 호출
+    uint64_t stored;                    // 저장 (솎기로 지운 점 포함)
+    uint64_t thins;                     // 간격 두 배 + 다시 솎기
+    uint64_t rebuilds;                  // k-d tree 다시 만들기 (끝난 것)
+    uint64_t steps;                     // 나눠 만들기 한 걸음 (add 안)
+    int64_t  step_max_ns;               // 가장 오래 걸린 한 걸음
+    int64_t  rebuild_max_ns;            // 한 번에 다시 만들기 (솎기 / gps_trail_build) 가장 긴 것
+} GpsTrailStats;
+
+// 나눠 만드는 중인 k-d tree 구간 하나 (상자는 분할 축 선택용)
+typedef struct {
+    uint32_t lo, hi;
+    float    x0, y0, x1, y1;
+} GpsTrailTask;
+
+// k-d tree 나눠 만들기 상태 (점 복사 → 구간마다 최소 순번 훑기 → quickselect 분할)
+typedef struct {
+    float        *xy;                   // 만드는 중인 색인 (다 되면 GpsTrail.kd_* 와 바꿈)
+    uint32_t     *id, *min;
+    uint8_t      *axis;
+    size_t        n;                    // 만들 점 수 [0, n)
+    int           stage;                // 0: 쉼
+    size_t        pos;                  // 복사 / 훑기 위치
+    size_t        budget;               // 한 걸음에 다룰 원소 수
+    float         x0, y0, x1, y1;       // 전체 상자 (복사 중)
+    GpsTrailTask  cur;                  // 지금 구간
+    uint32_t      cur_min;
+    int           cur_axis;
+    size_t        s_lo, s_hi, s_i, s_j; // quickselect 창 / 분할 위치
+    float         pivot;
+    int           sp;
+    GpsTrailTask  stack[64];            // 깊이 ≤ log2(점 수) + 1
+} GpsTrailBuild;
+
+// ─────────────────────────────────────────────
+//  궤적 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GeoLtp         ltp;
+    int64_t        t0_ns;
+    double         min_dist;            // 현재 저장 간격 (솎을 때마다 두 배)
+    GpsTrailPoint *pt;
+    size_t         count, max_points;
+
+    // k-d tree (저장 점 [0, kd_n) 의 순열, 구간 [lo, hi) 의 뿌리는 (lo + hi) / 2)
+    float         *kd_xy;               // e, n
+    uint32_t      *kd_id;               // 저장 순번
+    uint32_t      *kd_min;              // 하위 트리 최소 순번
+    uint8_t       *kd_axis;             // 0: e, 1: n
+    size_t         kd_n;
+    GpsTrailBuild  next;                // 다음 tree (나눠 만드는 중)
+
+    GpsTrailStats  stats;
+} GpsTrail;
+
+/**
+ * @brief 궤적 만들기 (max_points 개 고정 할당)
+ * @param max_points 0 이면 GPS_TRAIL_MAX_POINTS
+ * @param min_dist_m 0 이하이면 GPS_TRAIL_MIN_DIST
+ * @return 0: 성공, -1: 실패 (ENOMEM, max_points < 16 이면 EINVAL)
+ */
+int gps_trail_init(GpsTrail *t, size_t max_points, double min_dist_m);
+
+/**
+ * @brief fix 추가 (필요하면 솎기, tree 다시 만들기 시작 / 한 걸음)
+ * @param t_ns fix 시각 (CLOCK_MONOTONIC, 단조 증가)
+ * @return 1: 저장, 0: 직전 점과 가까워 건너뜀
+ */
+int gps_trail_add(GpsTrail *t, double lat, double lon, int64_t t_ns);
+
+/**
+ * @brief tail 까지 모두 tree 에 넣기 (벤치마크 / 질의가 몰리기 전)
+ */
+void gps_trail_build(GpsTrail *t);
+
+/**
+ * @brief 가장 가까운 저장 점
+ * @param before_ns 이 시각 이전에 저장한 점만 (재방문 판정), INT64_MAX 이면 전체
+ * @return 0: 찾음, -1: 해당 점 없음 (ENOENT)
+ */
+int gps_trail_nearest(const GpsTrail *t, double lat, double lon, int64_t before_ns,
+                      GpsTrailHit *hit);
+
+/**
+ * @brief 반경 안의 저장 점 (순서 없음)
+ * @return 반경 안 점 수 (max 보다 크면 hits 에는 max 개만)
+ */
+size_t gps_trail_radius(const GpsTrail *t, double lat, double lon, double radius_m,
+                        int64_t before_ns, GpsTrailHit *hits, size_t max);
+
+/**
+ * @brief 현재 위치에서 첫 점까지 귀환 경로 (현재 위치 → ... → 첫 점 순서로 cb)
+ * @param tol_m      Douglas-Peucker 허용 오차 (m)
+ * @param shortcut_m 이 거리 안에 더 오래된 점이 있으면 건너뜀 (0: 궤적 그대로)
+ * @return waypoint 수, -1: 실패 (저장 점 없음 ENOENT, ENOMEM, cb 중단 ECANCELED)
+ */
+int gps_trail_home(const GpsTrail *t, double lat, double lon, double tol_m, double shortcut_m,
+                   GpsTrailWaypointCb cb, void *user);
+
+/**
+ * @brief 저장 점 i (0 = 가장 오래된 점)
+ */
+void gps_trail_get(const GpsTrail *t, size_t i, double *lat, double *lon, int64_t *t_ns);
+
+/**
+ * @brief 저장 점 수
+ */
+static inline size_t gps_trail_count(const GpsTrail *t)
+{
+    return t->count;
+}
+
+/**
+ * @brief 할당한 메모리 바이트 (점 + 색인 두 벌)
+ */
+size_t gps_trail_memory(const GpsTrail *t);
+
+void gps_trail_free(GpsTrail *t);
+
+#endif /* GPS_TRAIL_H */
@@ -0,0 +1,293 @@
+#include "gps_warm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/timex.h>
+#include <unistd.h>
+
+#define GPS_EPOCH_UNIX_S    315964800LL     // 1980-01-06 00:00:00 UTC
+#define WEEK_S              604800LL
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static uint32_t fnv1a(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t       h = 2166136261u;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 프레임 1개 추가 (자리가 없으면 0)
+ */
+static size_t put_frame(uint8_t *out, size_t max, size_t n, uint8_t id,
+                        const void *payload, uint16_t len)
+{
+    if (n + len + UBX_FRAME_OVERHEAD > max) return 0;
+    return ubx_build(out + n, UBX_AID, id, payload, len);
+}
+
+/**
+ * @brief payload 첫 U4 의 svid (1~32) → 배열 번호, 범위 밖이면 -1
+ */
+static int sv_index(const UbxFrame *f)
+{
+    uint32_t svid = ubx_u4(f->payload);
+    return (svid >= 1 && svid <= GPS_WARM_SV) ? (int)svid - 1 : -1;
+}
+
+static int write_all(int fd, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+void gps_warm_init(GpsWarm *w)
+{
+    memset(w, 0, sizeof(GpsWarm));
+}
+
+void gps_warm_set_fix(GpsWarm *w, const GpsFix *f, int64_t real_ns)
+{
+    if (!(f->valid & GPS_V_POS)) return;
+    if ((f->valid & GPS_V_QUALITY) && f->quality == 0) return;
+
+    w->real_ns = real_ns;
+    w->have_kf = 0;
+    w->lat     = f->lat;
+    w->lon     = f->lon;
+    if (f->valid & GPS_V_ACC)
+        w->pos_acc_mm = (uint32_t)f->h_acc_mm;
+    else if (f->valid & GPS_V_HDOP)
+        w->pos_acc_mm = (uint32_t)(GPS_KF_UERE_M * M_SQRT2 * f->hdop * 10.0);
+    else
+        w->pos_acc_mm = 10000;
+
+    // AID-INI 고도는 타원체 기준
+    w->have_alt = (f->valid & GPS_V_ALT) != 0;
+    if (w->have_alt)
+        w->height_mm = f->alt_mm + ((f->valid & GPS_V_GEOID) ? f->geoid_mm : 0);
+}
+
+void gps_warm_set_kf(GpsWarm *w, const GpsKf *k, int64_t real_ns)
+{
+    double lat, lon;
+
+    if (gps_kf_get_state(k, &w->kf) < 0) return;
+    gps_kf_position(k, &lat, &lon);
+    w->have_kf    = 1;
+    w->real_ns    = real_ns;
+    w->lat        = (int32_t)lrint(lat * 1e7);
+    w->lon        = (int32_t)lrint(lon * 1e7);
+    w->pos_acc_mm = (uint32_t)(gps_kf_sigma(k) * 1000.0);
+}
+
+int gps_warm_on_ubx(GpsWarm *w, const UbxFrame *f, int64_t real_ns)
+{
+    int i;
+
+    if (f->cls != UBX_AID) return 0;
+
+    // AID-DATA 응답은 SV 32개를 모두 보내고, 데이터 없는 SV 는 8바이트 (svid + how) → 지움
+    switch (f->id) {
+        case UBX_AID_HUI:
+            if (f->len != UBX_AID_HUI_LEN) return 0;
+            memcpy(w->hui, f->payload, UBX_AID_HUI_LEN);
+            w->have_hui = 1;
+            break;
+        case UBX_AID_ALM:
+            if (f->len < 8 || (i = sv_index(f)) < 0) return 0;
+            w->alm_ok[i] = (f->len == UBX_AID_ALM_LEN);
+            if (w->alm_ok[i]) memcpy(w->alm[i], f->payload, UBX_AID_ALM_LEN);
+            break;
+        case UBX_AID_EPH:
+            if (f->len < 8 || (i = sv_index(f)) < 0) return 0;
+            w->eph_ok[i] = (f->len == UBX_AID_EPH_LEN);
+            if (w->eph_ok[i]) memcpy(w->eph[i], f->payload, UBX_AID_EPH_LEN);
+            break;
+        default:
+            return 0;
+    }
+    w->aid_real_ns = real_ns;
+    return 1;
+}
+
+int gps_warm_save(const GpsWarm *w, const char *path)
+{
+    char          tmp[256];
+    GpsWarmHeader h = { .magic = GPS_WARM_MAGIC, .version = GPS_WARM_VERSION,
+                        .size = sizeof(GpsWarm), .sum = fnv1a(w, sizeof(GpsWarm)) };
+    int           fd, err;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    // 전원 차단 중 저장해도 옛 파일 또는 새 파일 중 하나는 온전하게
+    if (write_all(fd, &h, sizeof(h)) < 0 || write_all(fd, w, sizeof(GpsWarm)) < 0 ||
+        fsync(fd) < 0) {
+        err = errno;
+        close(fd);
+        unlink(tmp);
+        errno = err;
+        return -1;
+    }
+    if (close(fd) < 0 || rename(tmp, path) < 0) {
+        err = errno;
+        unlink(tmp);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+int gps_warm_load(GpsWarm *w, const char *path)
+{
+    GpsWarmHeader h;
+    int           fd = open(path, O_RDONLY | O_CLOEXEC);
+    ssize_t       n1, n2;
+
+    if (fd < 0) return -1;
+    n1 = read(fd, &h, sizeof(h));
+    n2 = (n1 == (ssize_t)sizeof(h)) ? read(fd, w, sizeof(GpsWarm)) : 0;
+    close(fd);
+    if (n1 < 0 || n2 < 0) return -1;
+
+    if (n1 != (ssize_t)sizeof(h) || memcmp(h.magic, GPS_WARM_MAGIC, sizeof(GPS_WARM_MAGIC)) != 0 ||
+        h.version != GPS_WARM_VERSION || h.size != sizeof(GpsWarm) ||
+        n2 != (ssize_t)sizeof(GpsWarm) || h.sum != fnv1a(w, sizeof(GpsWarm))) {
+        gps_warm_init(w);
+        errno = EPROTO;
+        return -1;
+    }
+    return 0;
+}
+
+int gps_warm_restore_kf(const GpsWarm *w, GpsKf *k, int64_t now_real_ns)
+{
+    if (!w->have_kf || w->real_ns == 0) return -1;
+    gps_kf_set_state(k, &w->kf, (now_real_ns - w->real_ns) / 1e9);
+    return 0;
+}
+
+size_t gps_warm_build_aid(const GpsWarm *w, uint8_t *out, size_t max,
+                          int64_t now_real_ns, int tacc_ms)
+{
+    uint8_t  pl[UBX_AID_INI_LEN];
+    uint32_t flags = 0;
+    size_t   n = 0, m;
+    double   age_s = (now_real_ns - w->aid_real_ns) / 1e9;
+
+    // AID-INI: 위치 (위도 / 경도 / 타원체 고도) + 시각 (GPS 주 / TOW)
+    memset(pl, 0, sizeof(pl));
+    if (w->real_ns != 0) {
+        double acc_m = fmax(w->pos_acc_mm / 1000.0, GPS_WARM_POS_ACC_M);
+
+        ubx_put_u4(pl + 0, (uint32_t)w->lat);
+        ubx_put_u4(pl + 4, (uint32_t)w->lon);
+        ubx_put_u4(pl + 8, (uint32_t)(w->have_alt ? w->height_mm / 10 : 0));
+        ubx_put_u4(pl + 12, (uint32_t)(acc_m * 100.0));
+        flags |= UBX_INI_POS | UBX_INI_LLA | (w->have_alt ? 0 : UBX_INI_ALT_INV);
+    }
+    if (tacc_ms >= 0) {
+        int64_t gps_ms = now_real_ns / 1000000 - GPS_EPOCH_UNIX_S * 1000 + GPS_WARM_LEAP_S * 1000;
+        ubx_put_u2(pl + 18, (uint16_t)(gps_ms / (WEEK_S * 1000)));
+        ubx_put_u4(pl + 20, (uint32_t)(gps_ms % (WEEK_S * 1000)));
+        ubx_put_u4(pl + 24, (uint32_t)(now_real_ns % 1000000));
+        ubx_put_u4(pl + 28, (uint32_t)tacc_ms);
+        flags |= UBX_INI_TIME;
+    }
+    if (!flags) return 0;
+    ubx_put_u4(pl + 44, flags);
+    if (!(m = put_frame(out, max, n, UBX_AID_INI, pl, sizeof(pl)))) return n;
+    n += m;
+
+    // 궤도 정보: 수신기가 toe 로 다시 검사하지만 9600 baud 에서 3 KB 라 오래된 것은 뺌
+    if (w->aid_real_ns == 0) return n;
+    if (age_s <= GPS_WARM_EPH_MAX_S) {
+        for (int i = 0; i < GPS_WARM_SV; i++) {
+            if (!w->eph_ok[i]) continue;
+            if (!(m = put_frame(out, max, n, UBX_AID_EPH, w->eph[i], UBX_AID_EPH_LEN))) return n;
+            n += m;
+        }
+    }
+    if (age_s <= GPS_WARM_ALM_MAX_S) {
+        if (w->have_hui) {
+            if (!(m = put_frame(out, max, n, UBX_AID_HUI, w->hui, UBX_AID_HUI_LEN))) return n;
+            n += m;
+        }
+        for (int i = 0; i < GPS_WARM_SV; i++) {
+            if (!w->alm_ok[i]) continue;
+            if (!(m = put_frame(out, max, n, UBX_AID_ALM, w->alm[i], UBX_AID_ALM_LEN))) return n;
+            n += m;
+        }
+    }
+    return n;
+}
+
+int gps_warm_send(const GpsWarm *w, GpsSerial *ser, int64_t now_real_ns, int tacc_ms)
+{
+    static uint8_t aid[GPS_WARM_AID_MAX];
+    size_t         n = gps_warm_build_aid(w, aid, sizeof(aid), now_real_ns, tacc_ms);
+
+    if (n > 0 && gps_serial_write(ser, aid, n) < 0) return -1;
+    return (int)n;
+}
+
+int gps_warm_poll(GpsSerial *ser)
+{
+    uint8_t req[UBX_FRAME_OVERHEAD];
+    return gps_serial_write(ser, req, ubx_build(req, UBX_AID, UBX_AID_DATA, NULL, 0));
+}
+
+int gps_warm_eph_count(const GpsWarm *w)
+{
+    int n = 0;
+    for (int i = 0; i < GPS_WARM_SV; i++) n += w->eph_ok[i];
+    return n;
+}
+
+int gps_warm_alm_count(const GpsWarm *w)
+{
+    int n = 0;
+    for (int i = 0; i < GPS_WARM_SV; i++) n += w->alm_ok[i];
+    return n;
+}
+
+int gps_warm_clock_acc_ms(void)
+{
+    struct timex tx;
+    int          st;
+
+    memset(&tx, 0, sizeof(tx));
+    st = ntp_adjtime(&tx);
+    if (st < 0 || st == TIME_ERROR || (tx.status & STA_UNSYNC)) return -1;
+    return (int)(tx.maxerror / 1000) + 1;           // maxerror: µs
+}
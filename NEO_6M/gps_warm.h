@@ -0,0 +1,169 @@
+#ifndef GPS_WARM_H
+#define GPS_WARM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gps_fix.h"
+#include "gps_kf.h"
+#include "gps_serial.h"
+#include "ubx.h"
+
+// ─────────────────────────────────────────────
+//  warm / hot start 상태 저장 + 수신기 aiding
+//
+//  종료 시와 주기적으로 마지막 위치, 저장 시각 (CLOCK_REALTIME), Kalman 상태 / 공분산,
+//  수신기에서 AID-DATA poll 로 받은 AID-HUI / ALM / EPH 를 파일 하나에 저장한다.
+//  시작할 때 필터를 곧바로 복원하고 (첫 fix 전에도 위치 / σ), 수신기에는
+//  AID-INI (위치 + 현재 시각) 와 저장해 둔 궤도 정보를 보낸다.
+//
+//  - AID-INI 만으로는 위성 탐색 범위만 줄어든다. 궤도 정보 (ephemeris) 를 방송에서
+//    다시 받는 데 18~30 초가 걸리므로, 저장한 EPH 가 유효한 동안 (~4 시간) 에만 hot start
+//  - 시각 aiding 은 시스템 시계가 NTP 로 맞춰져 있을 때만 (gps_warm_clock_acc_ms),
+//    RTC 없는 Pi 는 부팅 직후 시계가 틀리므로 시각은 빼고 보낸다
+//  - 파일: 헤더 + GpsWarm 그대로 (기록한 기계의 바이트 순서), 임시 파일에 쓰고 rename
+//  - 9600 baud 에서 AID-DATA 응답 (~3 KB) 은 NMEA 출력을 3초쯤 밀어내므로 poll 은 드물게
+// ─────────────────────────────────────────────
+
+#define GPS_WARM_PATH       "/var/tmp/neo6m.warm"   // 기본 저장 위치 (재부팅 후에도 남음)
+#define GPS_WARM_MAGIC      "NEO6WRM"               // 파일 magic (8B, NUL 포함)
+#define GPS_WARM_VERSION    1
+#define GPS_WARM_SAVE_S     60          // 주기 저장 간격 (s)
+#define GPS_WARM_POLL_S     1800        // AID-DATA poll 간격 (s, 첫 poll 은 첫 fix 후 GPS_WARM_SAVE_S)
+#define GPS_WARM_EPH_MAX_S  (4 * 3600)  // 이보다 오래된 EPH 는 보내지 않음 (fit interval)
+#define GPS_WARM_ALM_MAX_S  (30 * 86400)
+#define GPS_WARM_POS_ACC_M  100.0       // AID-INI 위치 정확도 하한 (꺼져 있는 동안 이동 가정)
+#define GPS_WARM_LEAP_S     18          // GPS - UTC (2017-01 이후)
+#define GPS_WARM_SV         32
+#define GPS_WARM_AID_MAX    8192        // aiding 프레임 전체 (INI + EPH 32 + HUI + ALM 32 ≈ 5.3 KB)
+
+// AID 메시지 ID (class UBX_AID)
+#define UBX_AID_INI         0x01
+#define UBX_AID_HUI         0x02
+#define UBX_AID_DATA        0x10
+#define UBX_AID_ALM         0x30
+#define UBX_AID_EPH         0x31
+
+// payload 길이 (u-blox 6, 데이터 있는 경우)
+#define UBX_AID_INI_LEN     48
+#define UBX_AID_HUI_LEN     72
+#define UBX_AID_ALM_LEN     40
+#define UBX_AID_EPH_LEN     104
+
+// AID-INI flags
+#define UBX_INI_POS         0x0001
+#define UBX_INI_TIME        0x0002
+#define UBX_INI_LLA         0x0020      // 위치가 위도 / 경도 / 고도
+#define UBX_INI_ALT_INV     0x0040      // 고도 모름 (2D)
+
+// ─────────────────────────────────────────────
+//  저장 상태 (파일에 그대로 기록)
+// ─────────────────────────────────────────────
+typedef struct {
+    int64_t     real_ns;                // 마지막 위치 시각 (CLOCK_REALTIME, 0: 위치 없음)
+    int32_t     lat, lon;               // 마지막 위치 (1e-7 도, 필터가 있으면 필터 위치)
+    int32_t     height_mm;              // 타원체 고도
+    uint32_t    pos_acc_mm;             // 마지막 위치 정확도
+    uint8_t     have_alt;
+    uint8_t     have_kf;
+    uint8_t     have_hui;
+    GpsKfState  kf;
+
+    int64_t     aid_real_ns;            // AID 프레임 마지막 수신 시각
+    uint8_t     hui[UBX_AID_HUI_LEN];
+    uint8_t     alm_ok[GPS_WARM_SV], eph_ok[GPS_WARM_SV];
+    uint8_t     alm[GPS_WARM_SV][UBX_AID_ALM_LEN];
+    uint8_t     eph[GPS_WARM_SV][UBX_AID_EPH_LEN];
+} GpsWarm;
+
+// 파일 헤더
+typedef struct {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    size;                   // sizeof(GpsWarm)
+    uint32_t    sum;                    // GpsWarm 의 FNV-1a
+    uint32_t    reserved;
+} GpsWarmHeader;
+
+/**
+ * @brief 빈 상태
+ */
+void gps_warm_init(GpsWarm *w);
+
+/**
+ * @brief 마지막 fix 반영 (위치 없는 epoch 는 무시, 필터 상태는 gps_warm_set_kf 로 다시)
+ * @param real_ns fix 수신 시각 (CLOCK_REALTIME)
+ */
+void gps_warm_set_fix(GpsWarm *w, const GpsFix *f, int64_t real_ns);
+
+/**
+ * @brief 필터 상태 반영 (위치도 필터 추정으로 바꿈, 첫 fix 전이면 무시)
+ */
+void gps_warm_set_kf(GpsWarm *w, const GpsKf *k, int64_t real_ns);
+
+/**
+ * @brief 수신기 AID-HUI / ALM / EPH 프레임 보관 (UbxFrameCb 에서 그대로 넘김)
+ * @return 1: 반영 (데이터 없는 SV 는 지움), 0: AID-HUI / ALM / EPH 아님
+ */
+int gps_warm_on_ubx(GpsWarm *w, const UbxFrame *f, int64_t real_ns);
+
+/**
+ * @brief 파일 저장 (임시 파일 + fsync + rename)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_warm_save(const GpsWarm *w, const char *path);
+
+/**
+ * @brief 파일 읽기
+ * @return 0: 성공, -1: 실패 (errno 설정, 형식 / 검사합이 다르면 EPROTO)
+ */
+int gps_warm_load(GpsWarm *w, const char *path);
+
+/**
+ * @brief 저장한 필터 상태로 복원 (gps_kf_set_state)
+ * @return 0: 복원, -1: 저장된 필터 상태 없음
+ */
+int gps_warm_restore_kf(const GpsWarm *w, GpsKf *k, int64_t now_real_ns);
+
+/**
+ * @brief 수신기에 보낼 aiding 프레임 (AID-INI → EPH → HUI → ALM 순)
+ * @param tacc_ms 시각 정확도 (ms), 음수이면 시각 없이 (수신기가 방송에서 시각을 얻음)
+ * @return 출력 바이트 수 (out 이 모자라면 넣을 수 있는 프레임까지)
+ */
+size_t gps_warm_build_aid(const GpsWarm *w, uint8_t *out, size_t max,
+                          int64_t now_real_ns, int tacc_ms);
+
+/**
+ * @brief aiding 프레임 전송 (gps_warm_build_aid + gps_serial_write)
+ * @return 보낸 바이트 수, -1: 실패 (errno 설정)
+ */
+int gps_warm_send(const GpsWarm *w, GpsSerial *ser, int64_t now_real_ns, int tacc_ms);
+
+/**
+ * @brief AID-DATA poll 전송 (응답은 스트림으로 들어와 gps_warm_on_ubx 로)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int gps_warm_poll(GpsSerial *ser);
+
+/**
+ * @brief 보관 중인 EPH / ALM 개수
+ */
+int gps_warm_eph_count(const GpsWarm *w);
+int gps_warm_alm_count(const GpsWarm *w);
+
+/**
+ * @brief 시스템 시계 정확도 (ntp_adjtime maxerror)
+ * @return ms, -1: 동기화 안 됨
+ */
+int gps_warm_clock_acc_ms(void);
+
+/**
+ * @brief CLOCK_REALTIME 현재 시각 (ns)
+ */
+static inline int64_t gps_warm_real_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif /* GPS_WARM_H */
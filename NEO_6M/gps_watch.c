@@ -0,0 +1,80 @@
+// gps_daemon 구독 예제: 시리얼 포트 대신 공유 메모리에서 fix 를 읽는다
+//
+// 실행: ./gps_watch [-s name] [-H count]
+//         -H  최근 fix count 개를 출력하고 종료 (history ring)
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_shm.h"
+
+static void print_fix(uint32_t n, const GpsFix *f)
+{
+    if (f->valid & GPS_V_POS)
+        printf("#%u Latitude: %.6f, Longitude: %.6f  (+%.3f ms)\n", n,
+               nmea_e7_to_deg(f->lat), nmea_e7_to_deg(f->lon),
+               (gps_now_ns() - f->pub_ns) / 1e6);
+    else
+        printf("#%u Waiting for GPS fix...\n", n);
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = NULL;
+    int         hist = 0, opt;
+
+    while ((opt = getopt(argc, argv, "s:H:")) != -1) {
+        switch (opt) {
+            case 's': name = optarg;       break;
+            case 'H': hist = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-s name] [-H count]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    GpsShm shm;
+    if (gps_shm_open(&shm, name) < 0) {
+        perror(errno == ENOENT ? "gps_daemon not running" : "shm");
+        return 1;
+    }
+
+    if (hist > 0) {
+        // 오래된 순, ring 에서 밀려난 번호는 건너뜀
+        uint32_t c = gps_shm_count(&shm);
+        if (hist > GPS_SHM_HIST) hist = GPS_SHM_HIST;
+        if ((uint32_t)hist > c)  hist = (int)c;
+        for (uint32_t n = c - (uint32_t)hist + 1; hist > 0 && n != c + 1; n++) {
+            GpsFix f;
+            if (gps_shm_get(&shm, n, &f) == 0) print_fix(n, &f);
+        }
+        gps_shm_close(&shm);
+        return 0;
+    }
+
+    uint32_t seen = gps_shm_count(&shm);
+    for (;;) {
+        // 발행자가 멈춰도 알 수 있도록 대기 시간 제한
+        int r = gps_shm_wait(&shm, seen, 3000);
+        if (r < 0) {
+            perror(errno == EPIPE ? "gps_daemon stopped" : "wait");
+            break;
+        }
+        if (r == 0) {
+            if (!gps_shm_alive(&shm)) printf("gps_daemon not running, waiting...\n");
+            continue;
+        }
+
+        GpsFix f;
+        if (gps_shm_latest(&shm, &f, &seen) == 0)
+            print_fix(seen, &f);
+        else
+            seen = gps_shm_count(&shm); // 못 읽은 fix 는 건너뜀, 안 그러면 wait 가 즉시 반환 → busy-spin
+        fflush(stdout);
+    }
+
+    gps_shm_close(&shm);
+    return 0;
+}
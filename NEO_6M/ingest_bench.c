@@ -0,0 +1,167 @@
+// 대용량 NMEA 일괄 처리 벤치마크 (합성 캡처)
+//
+// 1. 파서만: 스트리밍 (512B 청크, 바이트 상태 기계) vs nmea_parser_scan (SIMD 본문 스캔)
+// 2. 파싱 + 디코딩 + epoch 조립: 스트리밍 1 스레드 vs gps_ingest 1..N 스레드
+//    스레드 수마다 열 표 / 통계가 스트리밍 결과와 같은지 확인
+//
+// 실행: ./ingest_bench [-m MB] [-j max_threads] [-r Hz]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_ingest.h"
+#include "gps_synth.h"
+
+#define CHUNK_SIZE      512         // 기존 도구의 read() 버퍼 크기
+#define CORRUPT_EVERY   200         // N 문장마다 1바이트 손상 (체크섬 오류)
+#define CUT_EVERY       997         // N epoch 마다 마지막 문장 중간에서 끊음 (framing 오류)
+
+static int64_t zero_clock(void)
+{
+    return 0;
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    gps_cols_push(user, f);
+}
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+/**
+ * @brief gps_ingest 결과 a 와 스트리밍 결과 b 비교 (b 의 빈 날짜는 a 가 앞 행으로 채움)
+ */
+static int same_cols(const GpsCols *a, const GpsCols *b)
+{
+    if (a->rows != b->rows) return 0;
+    for (int c = 0; c < GPS_COL_COUNT; c++) {
+        if (c == GPS_COL_DATE) continue;
+        if (memcmp(a->col[c], b->col[c], a->rows * sizeof(int32_t)) != 0) return 0;
+    }
+    for (size_t r = 0; r < a->rows; r++) {
+        int32_t want = b->col[GPS_COL_DATE][r] ? b->col[GPS_COL_DATE][r]
+                                               : (r ? a->col[GPS_COL_DATE][r - 1] : 0);
+        if (a->col[GPS_COL_DATE][r] != want) return 0;
+    }
+    return 1;
+}
+
+static int same_stats(const NmeaStats *a, const NmeaStats *b)
+{
+    return a->sentences == b->sentences && a->checksum_errors == b->checksum_errors &&
+           a->framing_errors == b->framing_errors && a->overflows == b->overflows;
+}
+
+int main(int argc, char **argv)
+{
+    size_t mb = 256;
+    int    max_threads = 0, rate_hz = 10, opt;
+
+    while ((opt = getopt(argc, argv, "m:j:r:")) != -1) {
+        switch (opt) {
+            case 'm': mb          = (size_t)atoi(optarg); break;
+            case 'j': max_threads = atoi(optarg);         break;
+            case 'r': rate_hz     = atoi(optarg);         break;
+            default:
+                fprintf(stderr, "usage: %s [-m MB] [-j max_threads] [-r Hz]\n", argv[0]);
+                return 1;
+        }
+    }
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (max_threads <= 0) max_threads = (ncpu > 4) ? (int)ncpu : 4;
+    if (mb < 1 || rate_hz < 1 || rate_hz > 20) {
+        fprintf(stderr, "invalid size/rate\n");
+        return 1;
+    }
+
+    // ── 합성 캡처 ──
+    size_t cap  = mb << 20;
+    char  *data = malloc(cap + NMEA_SYNTH_EPOCH_MAX);
+    size_t len  = 0;
+    long   nsent = 0, corrupted = 0, cut = 0;
+    if (!data) { perror("malloc"); return 1; }
+
+    for (int i = 0; len < cap; i++) {
+        long   before = nsent;
+        size_t n = nmea_synth_epoch(data + len, i, rate_hz);
+        nsent += NMEA_SYNTH_SENTENCES;
+        if (before / CORRUPT_EVERY != nsent / CORRUPT_EVERY) {
+            data[len + 20] ^= 0x01;
+            corrupted++;
+        }
+        if (i % CUT_EVERY == CUT_EVERY - 1) {
+            n -= 12;                    // GLL 끝 ('*hh' 포함) 잘림 → 다음 '$' 에서 재동기
+            cut++;
+        }
+        len += n;
+    }
+    printf("input: %.1f MB, %ld sentences, %ld corrupted, %ld cut, %ld CPUs\n",
+           len / 1e6, nsent, corrupted, cut, ncpu);
+
+    // ── 1. 파서만 ──
+    NmeaParser p;
+    nmea_parser_init(&p, NULL, NULL);
+    double t = now_sec();
+    for (size_t off = 0; off < len; off += CHUNK_SIZE)
+        nmea_parser_feed(&p, data + off, (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE);
+    t = now_sec() - t;
+    NmeaStats ref_stats = p.stats;
+    printf("parse   feed %d B      %7.3f s  %6.2f GB/s  sentences %llu cksum %llu framing %llu\n",
+           CHUNK_SIZE, t, len / 1e9 / t, (unsigned long long)p.stats.sentences,
+           (unsigned long long)p.stats.checksum_errors, (unsigned long long)p.stats.framing_errors);
+
+    nmea_parser_init(&p, NULL, NULL);
+    t = now_sec();
+    nmea_parser_scan(&p, data, len, len);
+    t = now_sec() - t;
+    printf("parse   scan (SIMD)    %7.3f s  %6.2f GB/s  %s\n",
+           t, len / 1e9 / t, same_stats(&p.stats, &ref_stats) ? "same stats" : "STATS DIFFER");
+
+    // ── 2. 파싱 + 디코딩 + 조립 ──
+    GpsCols      ref;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    gps_cols_init(&ref, 0);
+    gps_epoch_init(&ep, on_fix, &ref);
+    gps_epoch_set_policy(&ep, 0, 0);
+    gps_epoch_set_clock(&ep, zero_clock);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    nmea_parser_init(&p, nmea_dispatch_sentence, &disp);
+    t = now_sec();
+    for (size_t off = 0; off < len; off += CHUNK_SIZE)
+        nmea_parser_feed(&p, data + off, (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE);
+    gps_epoch_flush(&ep);
+    t = now_sec() - t;
+    double t_stream = t;
+    printf("ingest  stream         %7.3f s  %6.2f GB/s  fixes %zu\n",
+           t, len / 1e9 / t, ref.rows);
+
+    int failed = 0;
+    for (int th = 1;; th = (th * 2 < max_threads) ? th * 2 : max_threads) {
+        GpsCols        cols;
+        GpsIngestStats st;
+        gps_cols_init(&cols, 0);
+        t = now_sec();
+        if (gps_ingest(data, len, th, &cols, &st) < 0) { perror("gps_ingest"); return 1; }
+        t = now_sec() - t;
+
+        int ok = same_cols(&cols, &ref) && same_stats(&st.parse, &ref_stats);
+        if (!ok) failed = 1;
+        printf("ingest  %2d threads     %7.3f s  %6.2f GB/s  x%.1f  fixes %llu  %s\n",
+               st.threads, t, len / 1e9 / t, t_stream / t, (unsigned long long)st.fixes,
+               ok ? "identical" : "MISMATCH");
+        gps_cols_free(&cols);
+        if (th == max_threads) break;
+    }
+
+    gps_cols_free(&ref);
+    free(data);
+    return failed;
+}
@@ -1,183 +1,213 @@
-// 2D Kalman Filter + Offset Correction GPS
-
+// ENU 등속 Kalman Filter + Offset Correction GPS
+//
+// 실행: ./kalman_neo [-w state] [-n] [-T tacc_ms] [dev]
+//         -w  warm start 상태 파일 (기본 /var/tmp/neo6m.warm, 종료 시 / 60초마다 저장)
+//         -n  warm start 끔 (상태 읽기 / 저장 / 수신기 aiding 모두)
+//         -T  시각 aiding 정확도 (ms), 기본은 시스템 시계가 NTP 동기일 때만 자동
+//             (RTC 모듈이 있으면 -T 1000 등, 음수이면 시각 aiding 안 함)
+
+#include <errno.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <termios.h>
 #include <math.h>
-
-#define GPS_SERIAL "/dev/serial0"
-#define BAUDRATE B9600
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "geo.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+#include "gps_warm.h"
 
 // ====== 기준점 오프셋 (필요시 수정) ======
 #define LAT_OFFSET  (-0.000220)
 #define LON_OFFSET  (0.000000)
 
 // ====== Kalman 파라미터 ======
-#define Q 1e-7   // 프로세스 노이즈
-#define R 1e-6   // 측정 노이즈
+// 가속도 PSD (m²/s³): 보행 ~0.1, 차량 ~2 (측정 잡음은 HDOP / 위성 수로 자동)
+#define Q_ACCEL GPS_KF_Q_ACCEL
 
 typedef struct {
-    double x;  // 상태
-    double p;  // 오차 공분산
-} Kalman;
-
-// Kalman 초기화
-void kalman_init(Kalman *k, double init_value) {
-    k->x = init_value;
-    k->p = 1.0;
+    GpsKf    kf;
+    GpsEpoch epoch;
+    GpsWarm  warm;
+    int      use_warm;
+    int64_t  start_ns;
+    int64_t  first_fix_ns;          // 0: 아직 fix 없음
+} KalmanApp;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
 }
 
-// Kalman 업데이트
-double kalman_update(Kalman *k, double measurement) {
-    // 예측
-    k->p += Q;
-
-    // 이득 계산
-    double K = k->p / (k->p + R);
+// 수신기 AID 프레임 (AID-DATA poll 응답) 보관 후 NAV 는 epoch 으로
+static void on_ubx(const UbxFrame *f, void *user) {
+    KalmanApp *app = user;
 
-    // 업데이트
-    k->x = k->x + K * (measurement - k->x);
-    k->p = (1 - K) * k->p;
-
-    return k->x;
+    if (app->use_warm && gps_warm_on_ubx(&app->warm, f, gps_warm_real_ns())) return;
+    gps_epoch_on_ubx(f, &app->epoch);
 }
 
-// NMEA → Decimal
-double nmea_to_decimal(const char *nmea, char direction) {
-    if (!nmea || strlen(nmea) < 4) return 0.0;
+// epoch 마다 (GGA + RMC/VTG 속력/방위 합쳐진 GpsFix)
+static void on_fix(const GpsFix *f, void *user) {
+    KalmanApp *app = user;
+    GpsKf *kf = &app->kf;
 
-    double val = atof(nmea);
-    int deg = (int)(val / 100);
-    double min = val - deg * 100;
-    double dec = deg + min / 60.0;
+    if (!gps_kf_update_fix(kf, f)) return;
 
-    if (direction == 'S' || direction == 'W')
-        dec = -dec;
+    if (!app->first_fix_ns) {
+        app->first_fix_ns = f->pub_ns;
+        printf("First fix after %.1f s (filter %s)\n\n", (f->pub_ns - app->start_ns) / 1e9,
+               kf->stats.resets ? "initialized" : "restored state kept");
+    }
+    if (app->use_warm) {
+        int64_t real_ns = gps_warm_real_ns();
+        gps_warm_set_fix(&app->warm, f, real_ns);
+        gps_warm_set_kf(&app->warm, kf, real_ns);
+    }
 
-    return dec;
+    double raw_lat = nmea_e7_to_deg(f->lat);
+    double raw_lon = nmea_e7_to_deg(f->lon);
+    double filtered_lat, filtered_lon;
+    gps_kf_position(kf, &filtered_lat, &filtered_lon);
+
+    // 오프셋 보정
+    double corrected_lat = filtered_lat + LAT_OFFSET;
+    double corrected_lon = filtered_lon + LON_OFFSET;
+
+    // 오차 계산
+    double north_m, east_m;
+    geo_offset(corrected_lat, corrected_lon,
+               raw_lat, raw_lon,
+               &north_m, &east_m);
+
+    double dist = sqrt(north_m*north_m + east_m*east_m);
+
+    printf("Raw: %.6f, %.6f (HDOP %.2f, sats %d)\n", raw_lat, raw_lon,
+           f->hdop / 100.0, f->num_sats);
+    printf("Filtered: %.6f, %.6f (sigma %.1fm)\n", filtered_lat, filtered_lon,
+           gps_kf_sigma(kf));
+    printf("Velocity: E %.2f, N %.2f m/s\n", kf->x[2], kf->x[3]);
+    printf("Corrected: %.6f, %.6f\n", corrected_lat, corrected_lon);
+    printf("Filter Offset: %.2fm\n", dist);
+    printf("Map: https://www.google.com/maps?q=%.6f,%.6f\n\n",
+           corrected_lat, corrected_lon);
 }
 
-// 거리 계산
-void calc_offset(double lat1, double lon1,
-                 double lat2, double lon2,
-                 double *north_m, double *east_m)
-{
-    *north_m = (lat1 - lat2) * 111320.0;
-    *east_m  = (lon1 - lon2) * 111320.0 * cos(lat1 * M_PI / 180.0);
-}
+// 저장 상태 복원 + 수신기 aiding (AID-INI / EPH / HUI / ALM)
+static void warm_start(KalmanApp *app, GpsSerial *ser, const char *path, int tacc_ms) {
+    int64_t now = gps_warm_real_ns();
 
-int main() {
+    if (gps_warm_load(&app->warm, path) < 0) {
+        if (errno != ENOENT) perror(path);
+        printf("No warm start state (%s)\n", path);
+        return;
+    }
 
-    int fd = open(GPS_SERIAL, O_RDONLY | O_NOCTTY);
-    if (fd == -1) {
-        perror("Serial open error");
-        return 1;
+    double age = (now - app->warm.real_ns) / 1e9;
+    if (gps_warm_restore_kf(&app->warm, &app->kf, now) == 0) {
+        double lat, lon;
+        gps_kf_position(&app->kf, &lat, &lon);
+        printf("Restored: %.6f, %.6f (sigma %.1fm, saved %.0f s ago)\n",
+               lat + LAT_OFFSET, lon + LON_OFFSET, gps_kf_sigma(&app->kf), age);
     }
 
-    struct termios options;
-    tcgetattr(fd, &options);
-    cfsetispeed(&options, BAUDRATE);
-    cfsetospeed(&options, BAUDRATE);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    tcsetattr(fd, TCSANOW, &options);
+    int n = gps_warm_send(&app->warm, ser, now, tacc_ms);
+    if (n < 0) {
+        perror("AID write");
+        return;
+    }
+    printf("Aiding: %d bytes (time %s, ephemeris %d, almanac %d)\n", n,
+           tacc_ms >= 0 ? "yes" : "no (clock not synced)",
+           (now - app->warm.aid_real_ns) / 1e9 <= GPS_WARM_EPH_MAX_S ? gps_warm_eph_count(&app->warm) : 0,
+           gps_warm_alm_count(&app->warm));
+}
 
-    char buf[512], line[128];
-    int line_idx = 0;
+int main(int argc, char **argv) {
+    const char *path = GPS_WARM_PATH;
+    int tacc_ms = -2, opt;              // -2: 시스템 시계로 자동
+    KalmanApp app = { .use_warm = 1 };
+
+    while ((opt = getopt(argc, argv, "w:nT:")) != -1) {
+        switch (opt) {
+            case 'w': path = optarg;            break;
+            case 'n': app.use_warm = 0;         break;
+            case 'T': tacc_ms = atoi(optarg);   break;
+            default:
+                fprintf(stderr, "usage: %s [-w state] [-n] [-T tacc_ms] [dev]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (tacc_ms == -2) tacc_ms = gps_warm_clock_acc_ms();
 
-    Kalman k_lat, k_lon;
-    int kalman_initialized = 0;
+    // UART0 (GPIO14=TX, GPIO15=RX / 물리핀 8/10), raw 모드 + epoll 대기
+    const char *dev = (optind < argc) ? argv[optind] : GPS_SERIAL_DEV;
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, GPS_SERIAL_BAUD, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Serial open error");
+        return 1;
+    }
 
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    char buf[512];
+    GpsStream stream;
+    NmeaDispatch disp;
+    gps_kf_init(&app.kf, Q_ACCEL);
+    gps_warm_init(&app.warm);
+    gps_epoch_init(&app.epoch, on_fix, &app);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&app.epoch, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, on_ubx, &app);
+
+    int64_t save_ns = 0, poll_ns = 0;
+    app.start_ns = gps_now_ns();
+    if (app.use_warm) warm_start(&app, &ser, path, tacc_ms);
     printf("Waiting GPS (Kalman Mode)...\n");
 
-    while (1) {
-
-        int n = read(fd, buf, sizeof(buf));
-        if (n <= 0) continue;
+    while (!stop) {
 
-        for (int i = 0; i < n; i++) {
-
-            char c = buf[i];
-
-            if (c == '\n') {
-
-                line[line_idx] = '\0';
-                line_idx = 0;
-
-                if (strncmp(line, "$GPGGA", 6) == 0) {
-
-                    char *token = strtok(line, ",");
-                    int field = 0;
-                    char lat[16] = {0}, lon[16] = {0};
-                    char ns = 'N', ew = 'E';
-                    int fix = 0;
-
-                    while (token) {
-                        field++;
-                        switch (field) {
-                            case 3: strcpy(lat, token); break;
-                            case 4: ns = token[0]; break;
-                            case 5: strcpy(lon, token); break;
-                            case 6: ew = token[0]; break;
-                            case 7: fix = atoi(token); break;
-                        }
-                        token = strtok(NULL, ",");
-                    }
-
-                    if (fix > 0) {
-
-                        double raw_lat = nmea_to_decimal(lat, ns);
-                        double raw_lon = nmea_to_decimal(lon, ew);
-
-                        if (!kalman_initialized) {
-                            kalman_init(&k_lat, raw_lat);
-                            kalman_init(&k_lon, raw_lon);
-                            kalman_initialized = 1;
-                        }
-
-                        double filtered_lat = kalman_update(&k_lat, raw_lat);
-                        double filtered_lon = kalman_update(&k_lon, raw_lon);
-
-                        // 오프셋 보정
-                        double corrected_lat = filtered_lat + LAT_OFFSET;
-                        double corrected_lon = filtered_lon + LON_OFFSET;
-
-                        // 오차 계산
-                        double north_m, east_m;
-                        calc_offset(corrected_lat, corrected_lon,
-                                    raw_lat, raw_lon,
-                                    &north_m, &east_m);
-
-                        double dist = sqrt(north_m*north_m + east_m*east_m);
-
-                        printf("Raw: %.6f, %.6f\n", raw_lat, raw_lon);
-                        printf("Filtered: %.6f, %.6f\n", filtered_lat, filtered_lon);
-                        printf("Corrected: %.6f, %.6f\n", corrected_lat, corrected_lon);
-                        printf("Filter Offset: %.2fm\n", dist);
-                        printf("Map: https://www.google.com/maps?q=%.6f,%.6f\n\n",
-                               corrected_lat, corrected_lon);
-                    }
-                }
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (n < 0) {
+            if (!stop) perror("GPS read");
+            break;
+        }
 
-                memset(line, 0, sizeof(line));
+        if (n > 0)
+            gps_stream_feed(&stream, buf, n, rx_ns);
+        else
+            gps_epoch_poll(&app.epoch, ser.last_rx_ns, gps_now_ns());
 
-            } else if (c != '\r') {
+        if (!app.use_warm || !app.first_fix_ns) continue;
 
-                if (line_idx < sizeof(line)-1)
-                    line[line_idx++] = c;
-            }
+        // 첫 fix 후 GPS_WARM_SAVE_S 마다 저장, AID-DATA poll 은 그 뒤 GPS_WARM_POLL_S 마다
+        int64_t now = gps_now_ns();
+        if (!save_ns) {
+            save_ns = poll_ns = app.first_fix_ns + GPS_WARM_SAVE_S * 1000000000LL;
+        }
+        if (now >= poll_ns) {
+            if (gps_warm_poll(&ser) < 0) perror("AID-DATA poll");
+            poll_ns = now + GPS_WARM_POLL_S * 1000000000LL;
+        }
+        if (now >= save_ns) {
+            if (gps_warm_save(&app.warm, path) < 0) perror(path);
+            save_ns = now + GPS_WARM_SAVE_S * 1000000000LL;
         }
-
-        usleep(100000);
     }
 
-    close(fd);
+    if (app.use_warm && app.warm.real_ns) {
+        if (gps_warm_save(&app.warm, path) < 0) perror(path);
+        else printf("Saved warm start state -> %s\n", path);
+    }
+    gps_serial_close(&ser);
     return 0;
 }
 
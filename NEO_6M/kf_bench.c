@@ -0,0 +1,414 @@
+// 위치 필터 벤치마크: 기존 스칼라 Kalman (kalman_neo.c) vs ENU 등속 Kalman (gps_kf)
+//                     vs RTS 평활 (gps_rts, 오프라인 후처리)
+//
+// 합성 궤적 (정지 → 보행 → 차량) 에 NEO-6M 과 비슷한 오차를 얹어
+// 구간별 위치 RMSE 와 갱신 1회 비용을 비교한다.
+// RTS 는 창 (block + lag) 평활과 궤적 전체를 한 창으로 평활한 결과의 차이도 보고한다.
+//   오차: 축마다 Gauss-Markov (τ 60s) + 백색 잡음, 크기는 HDOP 에 비례
+//         위성 수 / HDOP 은 천천히 변하고, 0.5% 확률로 30m 튐 (다중경로)
+//         5% 확률로 epoch 누락 (가변 dt)
+// 기록 파일을 주면 (cat /dev/serial0 > track.nmea) 정답 없이 비용과
+// 원시 위치 대비 차이만 보고한다.
+//
+// 빌드: make kf_bench
+// 실행: ./kf_bench [-r Hz] [-s seed] [-f track.nmea|track.ubx]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_rts.h"
+#include "gps_stream.h"
+#include "nmea_msg.h"
+#include "gps_synth.h"
+
+#define LAT0        37.5665
+#define LON0        126.9780
+#define SEG_STILL   120         // 구간 길이 (s)
+#define SEG_WALK    300
+#define SEG_DRIVE   300
+#define MAX_FIX     200000
+#define COST_REPEAT 200         // 비용 측정 반복 횟수
+#define RTS_REPEAT  20
+
+enum { SEG_S = 0, SEG_W, SEG_D, SEG_COUNT };
+static const char *seg_name[SEG_COUNT] = { "still", "walk 1.4m/s", "drive 15m/s" };
+
+typedef struct {
+    GpsFix  fix;
+    double  e, n;               // 정답 ENU (m)
+    double  ve, vn;
+    int     seg;
+} Sample;
+
+// ─────────────────────────────────────────────
+//  기존 방식 (kalman_neo.c 와 동일)
+// ─────────────────────────────────────────────
+#define Q 1e-7
+#define R 1e-6
+
+typedef struct {
+    double x;
+    double p;
+} Kalman;
+
+static void kalman_init(Kalman *k, double init_value)
+{
+    k->x = init_value;
+    k->p = 1.0;
+}
+
+static double kalman_update(Kalman *k, double measurement)
+{
+    k->p += Q;
+    double K = k->p / (k->p + R);
+    k->x = k->x + K * (measurement - k->x);
+    k->p = (1 - K) * k->p;
+    return k->x;
+}
+
+// ─────────────────────────────────────────────
+//  합성 궤적
+// ─────────────────────────────────────────────
+static int make_track(Sample *out, const GeoLtp *ref, int rate_hz)
+{
+    double dt = 1.0 / rate_hz;
+    double e = 0, n = 0, ve = 0, vn = 0, heading = 0;
+    double gm_e = 0, gm_n = 0;                      // Gauss-Markov 오차
+    double hdop = 1.0, sats = 8;
+    double alpha = exp(-dt / 60.0);
+    int    total = (SEG_STILL + SEG_WALK + SEG_DRIVE) * rate_hz;
+    int    count = 0;
+
+    for (int i = 0; i < total; i++) {
+        double t = i * dt;
+        int    seg;
+        double speed;
+
+        if (t < SEG_STILL) {
+            seg = SEG_S; speed = 0.0;
+        } else if (t < SEG_STILL + SEG_WALK) {
+            seg = SEG_W; speed = 1.4;
+            if (fmod(t - SEG_STILL, 60.0) < dt) heading += M_PI / 2;       // 60s 마다 90° 회전
+        } else {
+            double td = t - SEG_STILL - SEG_WALK;
+            seg   = SEG_D;
+            speed = (td < 10.0) ? 1.5 * td : 15.0;                          // 1.5 m/s² 가속
+            heading += 0.05 * sin(td / 20.0) * dt;                          // 완만한 곡선
+        }
+        ve = speed * sin(heading);
+        vn = speed * cos(heading);
+        e += ve * dt;
+        n += vn * dt;
+
+        // HDOP / 위성 수: 천천히 변동
+        hdop += (1.3 - hdop) * 0.01 * dt + 0.05 * synth_grand() * sqrt(dt);
+        if (hdop < 0.8) hdop = 0.8;
+        if (hdop > 4.0) hdop = 4.0;
+        sats = 11.0 - 2.0 * hdop;
+
+        double sig = GPS_KF_UERE_M * hdop;
+        gm_e = alpha * gm_e + sqrt(1 - alpha * alpha) * 0.7 * sig * synth_grand();
+        gm_n = alpha * gm_n + sqrt(1 - alpha * alpha) * 0.7 * sig * synth_grand();
+        double me = e + gm_e + 0.7 * sig * synth_grand();
+        double mn = n + gm_n + 0.7 * sig * synth_grand();
+        if (synth_urand() < 0.005) { me += 30.0 * synth_grand(); mn += 30.0 * synth_grand(); }
+
+        if (synth_urand() < 0.05) continue;         // epoch 누락
+
+        Sample *s = &out[count++];
+        memset(s, 0, sizeof(*s));
+        s->e = e; s->n = n; s->ve = ve; s->vn = vn; s->seg = seg;
+
+        GpsFix *f   = &s->fix;
+        f->valid    = GPS_V_TIME | GPS_V_POS | GPS_V_QUALITY | GPS_V_SATS | GPS_V_HDOP | GPS_V_SPEED;
+        f->time_ms  = (int32_t)llround(t * 1000.0);
+        double lat, lon;
+        geo_ltp_inv(ref, me, mn, &lat, &lon);
+        f->lat      = (int32_t)llround(lat * 1e7);
+        f->lon      = (int32_t)llround(lon * 1e7);
+        f->quality  = 1;
+        f->num_sats = (int32_t)lround(sats);
+        f->hdop     = (int32_t)lround(hdop * 100.0);
+
+        // RMC 속력 (σ 0.1 m/s), 방위는 0.5 m/s 이상에서만 (NEO-6M 처럼 정지 시 빈 필드)
+        double sp = speed + 0.1 * synth_grand();
+        if (sp < 0) sp = 0;
+        f->speed_mmps = (int32_t)lround(sp * 1000.0);
+        if (speed >= 0.5) {
+            double c = heading + (0.05 + 0.2 / speed) * synth_grand();
+            c = fmod(c, 2 * M_PI);
+            if (c < 0) c += 2 * M_PI;
+            f->course_cdeg = (int32_t)lround(c * 180.0 / M_PI * 100.0);
+            f->valid |= GPS_V_COURSE;
+        }
+    }
+    return count;
+}
+
+// ─────────────────────────────────────────────
+//  기록 파일 → GpsFix
+// ─────────────────────────────────────────────
+typedef struct {
+    Sample *out;
+    int     count;
+} Loader;
+
+static void on_loaded(const GpsFix *f, void *user)
+{
+    Loader *l = user;
+    if (l->count >= MAX_FIX || !(f->valid & GPS_V_POS)) return;
+    memset(&l->out[l->count], 0, sizeof(Sample));
+    l->out[l->count++].fix = *f;
+}
+
+static int load_track(const char *path, Sample *out)
+{
+    FILE        *fp = fopen(path, "rb");
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    Loader       l = { out, 0 };
+    char         buf[4096];
+    size_t       n;
+
+    if (!fp) { perror(path); return -1; }
+    gps_epoch_init(&ep, on_loaded, &l);
+    gps_epoch_set_policy(&ep, 0, GPS_EPOCH_LEARN);  // 파일 재생이라 timeout 판정 없음
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        gps_stream_feed(&stream, buf, n, 0);
+    gps_epoch_flush(&ep);
+    fclose(fp);
+    return l.count;
+}
+
+// ─────────────────────────────────────────────
+//  실행
+// ─────────────────────────────────────────────
+typedef struct {
+    double sum2[SEG_COUNT];
+    double vsum2[SEG_COUNT];
+    long   cnt[SEG_COUNT];
+} Err;
+
+static void add_err(Err *er, int seg, double de, double dn)
+{
+    er->sum2[seg] += de * de + dn * dn;
+    er->cnt[seg]++;
+}
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+// ─────────────────────────────────────────────
+//  RTS 출력 (seq = 궤적 index)
+// ─────────────────────────────────────────────
+typedef struct {
+    const Sample *tr;
+    const GeoLtp *ref;
+    int           file;
+    Err           err;
+    double       (*pos)[2];     // epoch 별 평활 위치 (ENU, 창 비교용)
+} RtsSink;
+
+static void on_smoothed(const GpsRtsPoint *p, void *user)
+{
+    RtsSink      *rs = user;
+    const Sample *sm = &rs->tr[p->seq];
+    double        e, n, te, tn;
+
+    geo_ltp_fwd(rs->ref, p->lat, p->lon, &e, &n);
+    if (rs->pos) {
+        rs->pos[p->seq][0] = e;
+        rs->pos[p->seq][1] = n;
+    }
+    if (rs->file) {
+        geo_ltp_fwd(rs->ref, p->raw_lat * 1e-7, p->raw_lon * 1e-7, &te, &tn);
+    } else {
+        te = sm->e;
+        tn = sm->n;
+        double dve = p->ve - sm->ve, dvn = p->vn - sm->vn;
+        rs->err.vsum2[sm->seg] += dve * dve + dvn * dvn;
+    }
+    add_err(&rs->err, rs->file ? SEG_S : sm->seg, e - te, n - tn);
+}
+
+static void on_smoothed_cost(const GpsRtsPoint *p, void *user)
+{
+    *(double *)user += p->lat;
+}
+
+int main(int argc, char **argv)
+{
+    int         rate_hz = 1, opt;
+    const char *file = NULL;
+
+    while ((opt = getopt(argc, argv, "r:s:f:")) != -1) {
+        switch (opt) {
+            case 'r': rate_hz = atoi(optarg);                  break;
+            case 's': synth_seed(strtoull(optarg, NULL, 0) | 1); break;
+            case 'f': file    = optarg;                        break;
+            default:
+                fprintf(stderr, "usage: %s [-r Hz] [-s seed] [-f track]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (rate_hz <= 0 || rate_hz > 20) { fprintf(stderr, "invalid rate\n"); return 1; }
+
+    Sample *tr = calloc(MAX_FIX, sizeof(Sample));
+    if (!tr) { perror("calloc"); return 1; }
+
+    // 합성 궤적은 (LAT0, LON0), 기록 파일은 첫 fix 기준 접평면에서 오차 계산
+    GeoLtp ref;
+    geo_ltp_init(&ref, LAT0, LON0, 0.0);
+
+    int n = file ? load_track(file, tr) : make_track(tr, &ref, rate_hz);
+    if (n <= 0) { fprintf(stderr, "no fixes\n"); return 1; }
+    if (file) geo_ltp_init(&ref, tr[0].fix.lat * 1e-7, tr[0].fix.lon * 1e-7, 0.0);
+    for (int i = 0; i < n; i++)
+        tr[i].fix.seq = (uint32_t)i;
+
+    // ── 정확도 ──
+    Err    e_raw = {0}, e_old = {0}, e_kf = {0};
+    Kalman k_lat, k_lon;
+    GpsKf  kf;
+    gps_kf_init(&kf, 0);
+
+    for (int i = 0; i < n; i++) {
+        const GpsFix *f = &tr[i].fix;
+        double lat = f->lat * 1e-7, lon = f->lon * 1e-7;
+        double re, rn, oe, on, ke, kn;
+        geo_ltp_fwd(&ref, lat, lon, &re, &rn);
+        double te  = file ? re : tr[i].e;
+        double tn  = file ? rn : tr[i].n;
+        int    seg = file ? SEG_S : tr[i].seg;
+
+        if (i == 0) { kalman_init(&k_lat, lat); kalman_init(&k_lon, lon); }
+        double olat = kalman_update(&k_lat, lat), olon = kalman_update(&k_lon, lon);
+
+        gps_kf_update_fix(&kf, f);
+        double klat, klon;
+        gps_kf_position(&kf, &klat, &klon);
+
+        geo_ltp_fwd(&ref, olat, olon, &oe, &on);
+        geo_ltp_fwd(&ref, klat, klon, &ke, &kn);
+        add_err(&e_raw, seg, re - te, rn - tn);
+        add_err(&e_old, seg, oe - te, on - tn);
+        add_err(&e_kf,  seg, ke - te, kn - tn);
+        if (!file) {
+            double dve = kf.x[2] - tr[i].ve, dvn = kf.x[3] - tr[i].vn;
+            e_kf.vsum2[seg] += dve * dve + dvn * dvn;
+        }
+    }
+
+    // ── RTS: 기본 창 / 궤적 전체 한 창 ──
+    GpsKf   kf0;
+    GpsRts  rts;
+    RtsSink rs = { .tr = tr, .ref = &ref, .file = file != NULL };
+    RtsSink full = rs;
+    double (*pos_win)[2]  = calloc((size_t)n, sizeof(*pos_win));
+    double (*pos_full)[2] = calloc((size_t)n, sizeof(*pos_full));
+    if (!pos_win || !pos_full) { perror("calloc"); return 1; }
+    rs.pos   = pos_win;
+    full.pos = pos_full;
+    gps_kf_init(&kf0, 0);
+
+    gps_rts_init(&rts, &kf0, 0, 0, on_smoothed, &rs);
+    for (int i = 0; i < n; i++)
+        gps_rts_push(&rts, &tr[i].fix);
+    gps_rts_flush(&rts);
+    GpsRtsStats rts_stats = rts.stats;
+    size_t      rts_mem   = gps_rts_memory(&rts);
+    gps_rts_free(&rts);
+
+    gps_rts_init(&rts, &kf0, (size_t)n, 1, on_smoothed, &full);
+    for (int i = 0; i < n; i++)
+        gps_rts_push(&rts, &tr[i].fix);
+    gps_rts_flush(&rts);
+    gps_rts_free(&rts);
+
+    double win_max = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = hypot(pos_win[i][0] - pos_full[i][0], pos_win[i][1] - pos_full[i][1]);
+        if (d > win_max) win_max = d;
+    }
+    free(pos_win);
+    free(pos_full);
+
+    // ── 비용 ──
+    volatile double sink = 0;
+    double t0 = now_sec();
+    for (int r = 0; r < COST_REPEAT; r++) {
+        kalman_init(&k_lat, tr[0].fix.lat * 1e-7);
+        kalman_init(&k_lon, tr[0].fix.lon * 1e-7);
+        for (int i = 0; i < n; i++) {
+            sink += kalman_update(&k_lat, tr[i].fix.lat * 1e-7);
+            sink += kalman_update(&k_lon, tr[i].fix.lon * 1e-7);
+        }
+    }
+    double t_old = (now_sec() - t0) / ((double)n * COST_REPEAT);
+
+    t0 = now_sec();
+    for (int r = 0; r < COST_REPEAT; r++) {
+        gps_kf_init(&kf, 0);
+        for (int i = 0; i < n; i++) {
+            gps_kf_update_fix(&kf, &tr[i].fix);
+            sink += kf.x[0];
+        }
+    }
+    double t_kf = (now_sec() - t0) / ((double)n * COST_REPEAT);
+
+    double rts_sink = 0.0;
+    t0 = now_sec();
+    for (int r = 0; r < RTS_REPEAT; r++) {
+        gps_rts_init(&rts, &kf0, 0, 0, on_smoothed_cost, &rts_sink);
+        for (int i = 0; i < n; i++)
+            gps_rts_push(&rts, &tr[i].fix);
+        gps_rts_flush(&rts);
+        gps_rts_free(&rts);
+    }
+    double t_rts = (now_sec() - t0) / ((double)n * RTS_REPEAT);
+    sink += rts_sink;
+
+    printf("%d fixes (%s), update cost: scalar %.0f ns, ENU CV %.0f ns\n",
+           n, file ? file : "synthetic", t_old * 1e9, t_kf * 1e9);
+    printf("kf: %llu pos, %llu vel updates, %llu rejected, %llu resets\n",
+           (unsigned long long)kf.stats.updates, (unsigned long long)kf.stats.vel_updates,
+           (unsigned long long)kf.stats.rejected, (unsigned long long)kf.stats.resets);
+    printf("rts: %.0f ns/epoch (%.0f epochs/s, forward included), window %d+%d = %zu KB, "
+           "%llu segments, backward x%.2f, max diff to full-track RTS %.1e m\n",
+           t_rts * 1e9, 1.0 / t_rts, GPS_RTS_BLOCK, GPS_RTS_LAG, rts_mem / 1024,
+           (unsigned long long)rts_stats.segments,
+           (double)rts_stats.backward_steps / rts_stats.epochs, win_max);
+
+    if (file) {
+        printf("RMS distance from raw fix: scalar %.2f m, ENU CV %.2f m, RTS %.2f m\n",
+               sqrt(e_old.sum2[SEG_S] / e_old.cnt[SEG_S]), sqrt(e_kf.sum2[SEG_S] / e_kf.cnt[SEG_S]),
+               sqrt(rs.err.sum2[SEG_S] / rs.err.cnt[SEG_S]));
+    } else {
+        printf("%-14s %10s %10s %10s %10s %12s %12s\n", "segment", "raw m", "scalar m",
+               "ENU CV m", "RTS m", "CV vel m/s", "RTS vel m/s");
+        for (int s = 0; s < SEG_COUNT; s++) {
+            if (!e_raw.cnt[s]) continue;
+            printf("%-14s %10.2f %10.2f %10.2f %10.2f %12.2f %12.2f\n", seg_name[s],
+                   sqrt(e_raw.sum2[s] / e_raw.cnt[s]), sqrt(e_old.sum2[s] / e_old.cnt[s]),
+                   sqrt(e_kf.sum2[s] / e_kf.cnt[s]), sqrt(rs.err.sum2[s] / rs.err.cnt[s]),
+                   sqrt(e_kf.vsum2[s] / e_kf.cnt[s]), sqrt(rs.err.vsum2[s] / rs.err.cnt[s]));
+        }
+    }
+
+    (void)sink;
+    free(tr);
+    return 0;
+}
@@ -2,140 +2,94 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <fcntl.h>
-#include <termios.h>
 #include <math.h>
-
-#define GPS_SERIAL "/dev/serial0"
-#define BAUDRATE B9600
-#define QUEUE_SIZE 20  // 큐 개수
-
-// NMEA DDMM.MMMM → Decimal Degrees 변환
-double nmea_to_decimal(const char *nmea, char direction) {
-    if (!nmea || strlen(nmea) < 4) return 0.0;
-    double val = atof(nmea);
-    int deg = (int)(val / 100);
-    double min = val - deg * 100;
-    double dec = deg + min / 60.0;
-    if (direction == 'S' || direction == 'W') dec = -dec;
-    return dec;
+#include "nmea_msg.h"
+#include "geo.h"
+#include "gps_serial.h"
+#include "win_stat.h"
+
+#define QUEUE_SIZE 20  // 평균 윈도우 크기
+
+// 평균 윈도우 + 이전 평균 상태
+typedef struct {
+    WinPos win;                         // ENU 축별, MAD 기준 이상치 제외
+    double prev_lat_avg, prev_lon_avg;  // 이전 평균값 (초기값 0)
+} FixState;
+
+static void handle_fix(FixState *st, double latitude, double longitude) {
+    // 윈도우에 저장 (다중경로로 튄 fix 는 평균에서 제외)
+    if (!win_pos_push(&st->win, latitude, longitude))
+        printf("Outlier rejected: %.6f, %.6f\n", latitude, longitude);
+
+    // 윈도우 평균 (O(1), 보정 합산)
+    double lat_avg, lon_avg;
+    win_pos_mean(&st->win, &lat_avg, &lon_avg);
+
+    // Δ 계산 (평균값 - 이전 평균값)
+    double delta_lat = lat_avg - st->prev_lat_avg;
+    double delta_lon = lon_avg - st->prev_lon_avg;
+
+    // 보정: 평균값에서 Δ를 더해줌 (이동 시 반영)
+    double lat_corrected = lat_avg + delta_lat;
+    double lon_corrected = lon_avg + delta_lon;
+
+    // ΔN, ΔE, 거리 계산 (이전 평균 기준)
+    double north_m, east_m;
+    geo_offset(lat_corrected, lon_corrected, lat_avg, lon_avg, &north_m, &east_m);
+    double distance = sqrt(north_m*north_m + east_m*east_m);
+
+    printf("Raw Avg: %.6f, %.6f | Corrected Avg: %.6f, %.6f | ΔN: %.1fm, ΔE: %.1fm, Distance: %.1fm | Queue: %d\n",
+           lat_avg, lon_avg, lat_corrected, lon_corrected, north_m, east_m, distance, (int)win_stat_count(&st->win.e));
+
+    printf("Map Link: https://www.google.com/maps/dir/?api=1&origin=%.6f,%.6f&destination=%.6f,%.6f\n\n",
+           lat_avg, lon_avg, lat_corrected, lon_corrected);
+
+    // 이전 평균값 갱신
+    st->prev_lat_avg = lat_avg;
+    st->prev_lon_avg = lon_avg;
 }
 
-// ΔN, ΔE, 거리 계산
-void calc_offset(double lat1, double lon1, double lat2, double lon2, double *north_m, double *east_m) {
-    *north_m = (lat1 - lat2) * 111320.0; // 위도 1도 ≈ 111.32 km
-    *east_m = (lon1 - lon2) * 111320.0 * cos(lat1 * M_PI / 180.0); // 경도
+// GGA (GP/GN/GL 등 모든 talker)
+static void on_gga(const NmeaMsg *m, void *user) {
+    if (!(m->gga.valid & NMEA_V_POS)) return;
+    handle_fix(user, nmea_e7_to_deg(m->gga.lat), nmea_e7_to_deg(m->gga.lon));
 }
 
-int main() {
-    int fd = open(GPS_SERIAL, O_RDONLY | O_NOCTTY);
-    if (fd == -1) { perror("Unable to open serial port"); return 1; }
-
-    struct termios options;
-    tcgetattr(fd, &options);
-    cfsetispeed(&options, BAUDRATE);
-    cfsetospeed(&options, BAUDRATE);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    tcsetattr(fd, TCSANOW, &options);
-
-    char buf[512], line[128];
-    int line_idx = 0;
-
-    double lat_queue[QUEUE_SIZE] = {0}, lon_queue[QUEUE_SIZE] = {0};
-    int queue_idx = 0, queue_count = 0;
+int main(int argc, char **argv) {
+    // UART0 (GPIO14=TX, GPIO15=RX / 물리핀 8/10), raw 모드 + epoll 대기
+    const char *dev = (argc > 1) ? argv[1] : GPS_SERIAL_DEV;
+    GpsSerial ser;
+    if (gps_serial_open(&ser, dev, GPS_SERIAL_BAUD, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror("Unable to open serial port");
+        return 1;
+    }
 
-    // 이전 평균값 저장 (초기값 0)
-    double prev_lat_avg = 0.0, prev_lon_avg = 0.0;
+    char buf[512];
+    NmeaParser parser;
+    NmeaDispatch disp;
+    FixState state = {0};
+    if (win_pos_init(&state.win, QUEUE_SIZE) < 0) {
+        perror("win_pos_init");
+        gps_serial_close(&ser);
+        return 1;
+    }
+    nmea_dispatch_init(&disp);
+    nmea_dispatch_on(&disp, NMEA_GGA, on_gga, &state);
+    nmea_parser_init(&parser, nmea_dispatch_sentence, &disp);
 
     printf("Waiting for GPS fix...\n");
 
     while (1) {
-        int n = read(fd, buf, sizeof(buf));
-        if (n > 0) {
-            for (int i = 0; i < n; i++) {
-                char c = buf[i];
-                if (c == '\n') {
-                    line[line_idx] = '\0';
-                    line_idx = 0;
-
-                    if (strncmp(line, "$GPGGA", 6) == 0) {
-                        char *token = strtok(line, ",");
-                        int field = 0;
-                        char lat[16] = {0}, lon[16] = {0};
-                        char ns = 'N', ew = 'E';
-                        int fix_quality = 0;
-
-                        while (token) {
-                            field++;
-                            switch (field) {
-                                case 3: strcpy(lat, token); break;
-                                case 4: ns = token[0]; break;
-                                case 5: strcpy(lon, token); break;
-                                case 6: ew = token[0]; break;
-                                case 7: fix_quality = atoi(token); break;
-                            }
-                            token = strtok(NULL, ",");
-                        }
-
-                        if (fix_quality > 0) {
-                            double latitude = nmea_to_decimal(lat, ns);
-                            double longitude = nmea_to_decimal(lon, ew);
-
-                            // 원형 큐에 저장
-                            lat_queue[queue_idx] = latitude;
-                            lon_queue[queue_idx] = longitude;
-                            queue_idx = (queue_idx + 1) % QUEUE_SIZE;
-                            if (queue_count < QUEUE_SIZE) queue_count++;
-
-                            // 큐에 있는 값 개수만큼 평균 계산
-                            double lat_sum = 0, lon_sum = 0;
-                            for (int j = 0; j < queue_count; j++) {
-                                lat_sum += lat_queue[j];
-                                lon_sum += lon_queue[j];
-                            }
-                            double lat_avg = lat_sum / queue_count;
-                            double lon_avg = lon_sum / queue_count;
-
-                            // Δ 계산 (평균값 - 이전 평균값)
-                            double delta_lat = lat_avg - prev_lat_avg;
-                            double delta_lon = lon_avg - prev_lon_avg;
-
-                            // 보정: 평균값에서 Δ를 더해줌 (이동 시 반영)
-                            double lat_corrected = lat_avg + delta_lat;
-                            double lon_corrected = lon_avg + delta_lon;
-
-                            // ΔN, ΔE, 거리 계산 (이전 평균 기준)
-                            double north_m, east_m;
-                            calc_offset(lat_corrected, lon_corrected, lat_avg, lon_avg, &north_m, &east_m);
-                            double distance = sqrt(north_m*north_m + east_m*east_m);
-
-                            printf("Raw Avg: %.6f, %.6f | Corrected Avg: %.6f, %.6f | ΔN: %.1fm, ΔE: %.1fm, Distance: %.1fm | Queue: %d\n",
-                                   lat_avg, lon_avg, lat_corrected, lon_corrected, north_m, east_m, distance, queue_count);
-
-                            printf("Map Link: https://www.google.com/maps/dir/?api=1&origin=%.6f,%.6f&destination=%.6f,%.6f\n\n",
-                                   lat_avg, lon_avg, lat_corrected, lon_corrected);
-
-                            // 이전 평균값 갱신
-                            prev_lat_avg = lat_avg;
-                            prev_lon_avg = lon_avg;
-                        }
-                    }
-
-                    memset(line, 0, sizeof(line));
-                } else if (c != '\r') {
-                    line[line_idx++] = c;
-                    if (line_idx >= sizeof(line)-1) line_idx = sizeof(line)-2;
-                }
-            }
+        int64_t rx_ns;
+        int n = gps_serial_read(&ser, buf, sizeof(buf), -1, &rx_ns);
+        if (n < 0) {
+            perror("GPS read");
+            break;
         }
-        usleep(100000); // 0.1초
+        nmea_parser_feed_at(&parser, buf, n, rx_ns);
     }
 
-    close(fd);
+    win_pos_free(&state.win);
+    gps_serial_close(&ser);
     return 0;
 }
\ No newline at end of file
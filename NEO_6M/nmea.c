@@ -0,0 +1,541 @@
+#include "nmea.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define NMEA_SSE2   1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>   // vaddv 는 AArch64 만 (32비트 라즈비안은 스칼라)
+#define NMEA_NEON   1
+#endif
+
+// ─────────────────────────────────────────────
+//  파서 상태
+// ─────────────────────────────────────────────
+enum {
+    ST_IDLE = 0,    // '$' 대기
+    ST_BODY,        // 본문 ('*' 까지)
+    ST_CK1,         // 체크섬 상위 nibble
+    ST_CK2,         // 체크섬 하위 nibble
+};
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+/**
+ * @brief hex 문자 → 0~15, 아니면 -1
+ */
+static int hex_val(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @brief 본문 스캔을 멈춰야 하는 문자 ('*' ',' '$' CR LF)
+ */
+static const uint8_t special_tab[256] = {
+    ['*'] = 1, [','] = 1, ['$'] = 1, ['\r'] = 1, ['\n'] = 1,
+};
+
+static inline int is_special(char c)
+{
+    return special_tab[(uint8_t)c];
+}
+
+static void begin_sentence(NmeaParser *p)
+{
+    p->state     = ST_BODY;
+    p->start_ns  = p->chunk_ns;
+    p->xor       = 0;
+    p->len       = 0;
+    p->nfields   = 1;
+    p->fstart[0] = 0;
+}
+
+/**
+ * @brief 검증된 문장을 슬라이스로 분할해 콜백 호출
+ * @param base 본문 시작 (입력 청크 또는 carry 버퍼)
+ */
+static void emit(NmeaParser *p, const char *base)
+{
+    NmeaSentence s;
+
+    s.body    = base;
+    s.rx_ns   = p->start_ns;
+    s.end_ns  = p->chunk_ns;
+    s.len     = p->len;
+    s.nfields = p->nfields;
+
+    for (int i = 0; i < p->nfields; i++) {
+        uint16_t start = p->fstart[i];
+        uint16_t end   = (i + 1 < p->nfields) ? p->fstart[i + 1] - 1 : p->len;
+        s.field[i].ptr = base + start;
+        s.field[i].len = end - start;
+    }
+
+    p->stats.sentences++;
+    if (p->cb) p->cb(&s, p->user);
+}
+
+// ─────────────────────────────────────────────
+//  파서 API 구현
+// ─────────────────────────────────────────────
+
+void nmea_parser_init(NmeaParser *p, NmeaSentenceCb cb, void *user)
+{
+    memset(p, 0, sizeof(NmeaParser));
+    p->state = ST_IDLE;
+    p->cb    = cb;
+    p->user  = user;
+}
+
+void nmea_parser_reset(NmeaParser *p)
+{
+    if (p->state != ST_IDLE) p->stats.truncated++;
+    p->state = ST_IDLE;
+}
+
+int nmea_parser_feed_at(NmeaParser *p, const char *data, size_t n, int64_t rx_ns)
+{
+    p->chunk_ns = rx_ns;
+    return nmea_parser_feed(p, data, n);
+}
+
+int nmea_parser_feed(NmeaParser *p, const char *data, size_t n)
+{
+    // 이전 청크에서 이어지는 문장이면 본문은 carry 에 있음
+    int         in_carry = (p->state != ST_IDLE);
+    const char *body     = p->carry;
+    int         emitted  = 0;
+    size_t      i        = 0;
+
+    p->stats.bytes += n;
+
+    while (i < n) {
+        char c = data[i++];
+
+        switch (p->state) {
+
+            case ST_IDLE:
+                if (c == '$') {
+                    begin_sentence(p);
+                    body     = data + i;
+                    in_carry = 0;
+                }
+                break;
+
+            case ST_BODY: {
+                // 일반 문자는 상태 전이 없이 연속 처리 (hot loop)
+                uint8_t  x   = p->xor;
+                uint16_t len = p->len;
+                size_t   lim;
+                i--;
+                // 본문 한도까지만 스캔 (초과분은 아래에서 overflow 처리)
+                lim = i + (NMEA_LINE_MAX - len);
+                if (lim > n) lim = n;
+                if (in_carry) {
+                    while (i < lim && !is_special(c = data[i])) {
+                        x ^= (uint8_t)c;
+                        p->carry[len++] = c;
+                        i++;
+                    }
+                } else {
+                    size_t start = i;
+                    while (i < lim && !is_special(c = data[i])) {
+                        x ^= (uint8_t)c;
+                        i++;
+                    }
+                    len += (uint16_t)(i - start);
+                }
+                if (i == lim && lim < n) c = data[i];
+                p->xor = x;
+                p->len = len;
+                if (i == n) break;
+                i++;
+
+                if (c == '*') {
+                    p->state = ST_CK1;
+                } else if (c == ',') {
+                    if (p->len >= NMEA_LINE_MAX || p->nfields >= NMEA_MAX_FIELDS) {
+                        p->stats.overflows++;
+                        p->state = ST_IDLE;
+                        break;
+                    }
+                    p->fstart[p->nfields++] = p->len + 1;
+                    p->xor ^= (uint8_t)c;
+                    if (in_carry) p->carry[p->len] = c;
+                    p->len++;
+                } else if (c == '$') {
+                    // 이전 문장이 '*' 없이 끊김 → 새 문장으로 재동기
+                    p->stats.framing_errors++;
+                    begin_sentence(p);
+                    body     = data + i;
+                    in_carry = 0;
+                } else if (c == '\r' || c == '\n') {
+                    p->stats.framing_errors++;
+                    p->state = ST_IDLE;
+                } else {
+                    // NMEA_LINE_MAX 초과
+                    p->stats.overflows++;
+                    p->state = ST_IDLE;
+                }
+                break;
+            }
+
+            case ST_CK1: {
+                int v = hex_val(c);
+                if (v < 0) {
+                    p->stats.framing_errors++;
+                    p->state = ST_IDLE;
+                    if (c == '$') { begin_sentence(p); body = data + i; in_carry = 0; }
+                    break;
+                }
+                p->ck    = (uint8_t)(v << 4);
+                p->state = ST_CK2;
+                break;
+            }
+
+            case ST_CK2: {
+                int v = hex_val(c);
+                p->state = ST_IDLE;
+                if (v < 0) {
+                    p->stats.framing_errors++;
+                    if (c == '$') { begin_sentence(p); body = data + i; in_carry = 0; }
+                    break;
+                }
+                if ((uint8_t)(p->ck | v) != p->xor) {
+                    p->stats.checksum_errors++;
+                    break;
+                }
+                emit(p, body);
+                emitted++;
+                break;
+            }
+        }
+    }
+
+    // 청크 안에서 시작해 끝나지 않은 문장만 carry 로 이동
+    if (p->state != ST_IDLE && !in_carry)
+        memcpy(p->carry, body, p->len);
+
+    return emitted;
+}
+
+// ─────────────────────────────────────────────
+//  일괄 파싱 (nmea_parser_scan)
+//  '$' 는 모두 문장 시작 (스트리밍 파서도 어느 상태에서든 '$' 에서 재동기)
+//  이므로 문장마다 독립적으로 검증할 수 있다.
+// ─────────────────────────────────────────────
+
+#define SCAN_OVERFLOW   (-1)
+#define SCAN_TRUNCATED  (-2)
+
+#if defined(NMEA_SSE2) || defined(NMEA_NEON)
+// keep + 16 - k 에서 16 바이트 로드 → 앞 k 바이트만 0xFF
+static const uint8_t xor_keep[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+#endif
+
+#if defined(NMEA_SSE2)
+typedef __m128i V16;
+
+static inline V16 v_load(const void *q)   { return _mm_loadu_si128((const __m128i *)q); }
+static inline V16 v_zero(void)            { return _mm_setzero_si128(); }
+static inline V16 v_xor(V16 a, V16 b)     { return _mm_xor_si128(a, b); }
+static inline V16 v_and(V16 a, V16 b)     { return _mm_and_si128(a, b); }
+
+static inline unsigned v_eq_mask(V16 v, char c)
+{
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+
+static inline void v_store(uint8_t *out, V16 v)
+{
+    _mm_storeu_si128((__m128i *)out, v);
+}
+#elif defined(NMEA_NEON)
+typedef uint8x16_t V16;
+
+static inline V16 v_load(const void *q)   { return vld1q_u8(q); }
+static inline V16 v_zero(void)            { return vdupq_n_u8(0); }
+static inline V16 v_xor(V16 a, V16 b)     { return veorq_u8(a, b); }
+static inline V16 v_and(V16 a, V16 b)     { return vandq_u8(a, b); }
+
+static inline unsigned v_eq_mask(V16 v, char c)
+{
+    static const uint8_t weight[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                        1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t m = vandq_u8(vceqq_u8(v, vdupq_n_u8((uint8_t)c)), vld1q_u8(weight));
+    return vaddv_u8(vget_low_u8(m)) | ((unsigned)vaddv_u8(vget_high_u8(m)) << 8);
+}
+
+static inline void v_store(uint8_t *out, V16 v)
+{
+    vst1q_u8(out, v);
+}
+#endif
+
+/**
+ * @brief 본문 스캔 ('$' 다음부터): 첫 종료 문자 ('*' '$' CR LF) 까지 XOR, 필드 분할
+ * @param avail b 부터 읽을 수 있는 바이트
+ * @return 본문 길이 (종료 문자 위치), SCAN_OVERFLOW, SCAN_TRUNCATED
+ */
+static int scan_body(NmeaParser *p, const char *b, size_t avail)
+{
+    size_t  lim = (avail < NMEA_LINE_MAX + 1) ? avail : NMEA_LINE_MAX + 1;  // 종료 문자 포함
+    size_t  off = 0;
+    int     nf  = 1;
+    uint8_t x   = 0;
+
+    p->fstart[0] = 0;
+
+#if defined(NMEA_SSE2) || defined(NMEA_NEON)
+    V16 xv = v_zero();
+
+    while (off < lim && off + 16 <= avail) {
+        V16      v    = v_load(b + off);
+        unsigned term = v_eq_mask(v, '*') | v_eq_mask(v, '$') |
+                        v_eq_mask(v, '\r') | v_eq_mask(v, '\n');
+        unsigned comma = v_eq_mask(v, ',');
+        unsigned k     = 16;
+
+        if (term) {
+            k      = (unsigned)__builtin_ctz(term);
+            comma &= (1u << k) - 1;
+            v      = v_and(v, v_load(xor_keep + 16 - k));
+        }
+        xv = v_xor(xv, v);
+        for (; comma; comma &= comma - 1) {
+            if (nf >= NMEA_MAX_FIELDS) return SCAN_OVERFLOW;
+            p->fstart[nf++] = (uint16_t)(off + (unsigned)__builtin_ctz(comma) + 1);
+        }
+        off += k;
+        if (term) break;
+    }
+
+    uint8_t  lanes[16];
+    uint64_t w[2];
+    v_store(lanes, xv);
+    memcpy(w, lanes, sizeof(w));
+    w[0] ^= w[1];
+    w[0] ^= w[0] >> 32;
+    w[0] ^= w[0] >> 16;
+    w[0] ^= w[0] >> 8;
+    x = (uint8_t)w[0];
+#endif
+
+    // 버퍼 끝 16 바이트 미만 (또는 SIMD 없음)
+    for (; off < lim; off++) {
+        char c = b[off];
+        if (c == '*' || c == '$' || c == '\r' || c == '\n') break;
+        if (c == ',') {
+            if (nf >= NMEA_MAX_FIELDS) return SCAN_OVERFLOW;
+            p->fstart[nf++] = (uint16_t)(off + 1);
+        }
+        x ^= (uint8_t)c;
+    }
+
+    if (off > NMEA_LINE_MAX) return SCAN_OVERFLOW;
+    if (off == avail) return SCAN_TRUNCATED;
+
+    p->xor     = x;
+    p->nfields = (uint8_t)nf;
+    p->len     = (uint16_t)off;
+    return (int)off;
+}
+
+int nmea_parser_scan(NmeaParser *p, const char *data, size_t n, size_t limit)
+{
+    size_t i       = 0;
+    int    emitted = 0;
+
+    if (limit > n) limit = n;
+    p->state         = ST_IDLE;
+    p->start_ns      = p->chunk_ns;
+    p->stats.bytes  += limit;
+
+    while (i < limit) {
+        const char *d = memchr(data + i, '$', limit - i);
+        if (!d) break;
+        i = (size_t)(d - data) + 1;                 // 본문 시작
+
+        int len = scan_body(p, data + i, n - i);
+        if (len == SCAN_TRUNCATED) break;
+        if (len == SCAN_OVERFLOW) {
+            p->stats.overflows++;
+            continue;
+        }
+
+        if (data[i + len] != '*') {
+            // '*' 없이 '$' (다음 문장) 또는 CR LF
+            p->stats.framing_errors++;
+            i += (size_t)len;
+            continue;
+        }
+        i += (size_t)len + 1;                       // 체크섬 첫 글자
+        if (i >= n) break;
+        int h1 = hex_val(data[i]);
+        if (h1 < 0) {
+            p->stats.framing_errors++;
+            continue;
+        }
+        if (i + 1 >= n) break;
+        int h2 = hex_val(data[i + 1]);
+        if (h2 < 0) {
+            p->stats.framing_errors++;
+            continue;
+        }
+        if ((uint8_t)(h1 << 4 | h2) != p->xor) {
+            p->stats.checksum_errors++;
+            continue;
+        }
+        emit(p, data + i - len - 1);
+        emitted++;
+    }
+    return emitted;
+}
+
+// ─────────────────────────────────────────────
+//  필드 디코더
+// ─────────────────────────────────────────────
+
+int nmea_sentence_is(const NmeaSentence *s, const char *addr)
+{
+    size_t n = strlen(addr);
+    return s->nfields > 0 && s->field[0].len == n &&
+           memcmp(s->field[0].ptr, addr, n) == 0;
+}
+
+int nmea_parse_int(NmeaSlice f, int32_t *out)
+{
+    const char *q   = f.ptr;
+    const char *end = f.ptr + f.len;
+    int         neg = 0;
+    int32_t     v   = 0;
+
+    if (q < end && (*q == '-' || *q == '+')) neg = (*q++ == '-');
+    if (q == end) return -1;
+
+    for (; q < end; q++) {
+        if (*q < '0' || *q > '9') return -1;
+        if (v > (INT32_MAX - (*q - '0')) / 10) return -1;  // 넘침 (자릿수 제한 없는 필드)
+        v = v * 10 + (*q - '0');
+    }
+
+    *out = neg ? -v : v;
+    return 0;
+}
+
+int nmea_parse_fixed(NmeaSlice f, int scale, int32_t *out)
+{
+    const char *q      = f.ptr;
+    const char *end    = f.ptr + f.len;
+    int         neg    = 0;
+    int         digits = 0;
+    int         frac   = -1;    // 소수점 이후 자릿수 (-1: 소수점 없음)
+    int64_t     v      = 0;
+
+    if (q < end && (*q == '-' || *q == '+')) neg = (*q++ == '-');
+    if (q == end) return -1;
+
+    for (; q < end; q++) {
+        if (*q == '.') {
+            if (frac >= 0) return -1;
+            frac = 0;
+            continue;
+        }
+        if (*q < '0' || *q > '9') return -1;
+        if (frac >= scale) continue;        // 초과 자릿수 버림
+        if (v > (INT32_MAX - (*q - '0')) / 10) return -1;  // 결과가 int32 를 넘음
+        v = v * 10 + (*q - '0');
+        digits++;
+        if (frac >= 0) frac++;
+    }
+    if (!digits) return -1;
+
+    for (int k = (frac < 0 ? 0 : frac); k < scale; k++) {
+        if (v > INT32_MAX / 10) return -1;
+        v *= 10;
+    }
+
+    *out = (int32_t)(neg ? -v : v);
+    return 0;
+}
+
+int nmea_parse_coord(NmeaSlice f, NmeaSlice hemi, int32_t *out)
+{
+    const char *q   = f.ptr;
+    const char *end = f.ptr + f.len;
+    int32_t     dm  = 0;        // DDMM 정수부
+    int64_t     fr  = 0;        // 분 소수부 (1e-7 분 단위)
+    int64_t     scale = 1000000;
+    int         int_digits = 0;
+
+    for (; q < end && *q != '.'; q++) {
+        if (*q < '0' || *q > '9') return -1;
+        if (++int_digits > 5) return -1;    // 최대 DDDMM (dm 넘침 방지)
+        dm = dm * 10 + (*q - '0');
+    }
+    if (int_digits < 3) return -1;          // 최소 DMM
+
+    if (q < end) {                          // '.' 이후
+        for (q++; q < end; q++) {
+            if (*q < '0' || *q > '9') return -1;
+            if (scale > 0) {
+                fr += (*q - '0') * scale;
+                scale /= 10;
+            }
+        }
+    }
+
+    int32_t deg = dm / 100;
+    if (deg > 180) return -1;
+    int64_t min_e7 = (int64_t)(dm % 100) * 10000000 + fr;
+    if (min_e7 >= 600000000LL) return -1;   // 분 >= 60
+
+    // 분 → 도: /60 (반올림)
+    int64_t e7 = (int64_t)deg * 10000000 + (min_e7 + 30) / 60;
+    if (e7 > 1800000000LL) return -1;       // 180° 초과
+
+    if (hemi.len > 0 && (hemi.ptr[0] == 'S' || hemi.ptr[0] == 'W'))
+        e7 = -e7;
+
+    *out = (int32_t)e7;
+    return 0;
+}
+
+int nmea_parse_time(NmeaSlice f, int32_t *ms_of_day)
+{
+    const char *q = f.ptr;
+    int         d[6];
+
+    if (f.len < 6) return -1;
+    for (int i = 0; i < 6; i++) {
+        if (q[i] < '0' || q[i] > '9') return -1;
+        d[i] = q[i] - '0';
+    }
+
+    int32_t ms = ((d[0] * 10 + d[1]) * 3600 +
+                  (d[2] * 10 + d[3]) * 60 +
+                  (d[4] * 10 + d[5])) * 1000;
+
+    if (f.len > 6) {
+        if (q[6] != '.') return -1;
+        int scale = 100;
+        for (int i = 7; i < f.len; i++) {
+            if (q[i] < '0' || q[i] > '9') return -1;
+            ms += (q[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    *ms_of_day = ms;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#ifndef NMEA_H
+#define NMEA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────────────────────────────────────────
+//  libnmea - 스트리밍 NMEA 0183 파서
+//
+//  - 임의 크기의 바이트 청크를 그대로 입력 (read() 결과 등)
+//  - '*hh' 체크섬을 바이트 단위로 누적 검증
+//  - 필드는 (ptr, len) 슬라이스로 제자리 분할 (strtok/strcpy 없음)
+//  - 청크 경계에 걸친 문장만 내부 carry 버퍼로 복사
+//  - 손상/초과 문장은 통계만 증가시키고 버림
+// ─────────────────────────────────────────────
+
+#define NMEA_LINE_MAX       128     // '$' 이후 '*' 이전 본문 최대 길이
+#define NMEA_MAX_FIELDS     32      // 주소 필드(field[0]) 포함
+
+// ─────────────────────────────────────────────
+//  필드 슬라이스 (NUL 종료 아님)
+// ─────────────────────────────────────────────
+typedef struct {
+    const char *ptr;
+    uint16_t    len;
+} NmeaSlice;
+
+// ─────────────────────────────────────────────
+//  검증된 문장 1개
+//  field[0] = 주소 필드 ("GPGGA"), field[1..] = 데이터 필드
+//  포인터는 콜백 안에서만 유효
+// ─────────────────────────────────────────────
+typedef struct {
+    const char *body;                   // '$' 다음 ~ '*' 이전
+    int64_t     rx_ns;                  // '$' 가 들어온 청크의 수신 시각 (0: 미지정)
+    int64_t     end_ns;                 // 체크섬이 들어온 청크의 수신 시각
+    uint16_t    len;
+    uint8_t     nfields;
+    NmeaSlice   field[NMEA_MAX_FIELDS];
+} NmeaSentence;
+
+typedef void (*NmeaSentenceCb)(const NmeaSentence *s, void *user);
+
+// ─────────────────────────────────────────────
+//  파서 통계
+// ─────────────────────────────────────────────
+typedef struct {
+    uint64_t bytes;             // 입력 바이트 수
+    uint64_t sentences;         // 체크섬 통과 문장 수
+    uint64_t checksum_errors;   // '*hh' 불일치
+    uint64_t framing_errors;    // 체크섬 누락, 잘못된 hex, 문장 중간 '$'
+    uint64_t overflows;         // NMEA_LINE_MAX / NMEA_MAX_FIELDS 초과
+    uint64_t truncated;         // nmea_parser_reset 으로 버린 미완성 문장 (UBX 끼어듦 등)
+} NmeaStats;
+
+// ─────────────────────────────────────────────
+//  파서 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    uint8_t         state;
+    uint8_t         xor;                        // 누적 체크섬
+    uint8_t         ck;                         // 수신 체크섬
+    uint8_t         nfields;
+    uint16_t        len;                        // 현재 본문 길이
+    uint16_t        fstart[NMEA_MAX_FIELDS];    // 필드 시작 오프셋
+    int64_t         chunk_ns;                   // 현재 청크 수신 시각
+    int64_t         start_ns;                   // 현재 문장 '$' 수신 시각
+    char            carry[NMEA_LINE_MAX];       // 청크 경계용 버퍼
+    NmeaStats       stats;
+    NmeaSentenceCb  cb;
+    void           *user;
+} NmeaParser;
+
+// ─────────────────────────────────────────────
+//  파서 API
+// ─────────────────────────────────────────────
+
+/**
+ * @brief 파서 초기화
+ * @param p    NmeaParser 포인터
+ * @param cb   검증된 문장마다 호출될 콜백
+ * @param user 콜백에 그대로 전달될 포인터
+ */
+void nmea_parser_init(NmeaParser *p, NmeaSentenceCb cb, void *user);
+
+/**
+ * @brief 바이트 청크 입력 (문장 경계와 무관하게 임의 크기)
+ *
+ * 완성된 문장은 이 함수 안에서 콜백으로 전달된다.
+ * 청크 안에 온전히 들어 있는 문장은 복사 없이 data 를 가리킨다.
+ *
+ * @return 이번 호출에서 전달된 문장 수
+ */
+int nmea_parser_feed(NmeaParser *p, const char *data, size_t len);
+
+/**
+ * @brief 수신 시각과 함께 청크 입력
+ *
+ * rx_ns 는 청크가 도착한 시각 (CLOCK_MONOTONIC ns).
+ * 문장의 rx_ns 는 그 문장의 '$' 가 들어 있던 청크의 시각이 된다.
+ */
+int nmea_parser_feed_at(NmeaParser *p, const char *data, size_t len, int64_t rx_ns);
+
+/**
+ * @brief 진행 중인 문장을 버리고 '$' 대기 상태로 (버린 문장은 stats.truncated)
+ */
+void nmea_parser_reset(NmeaParser *p);
+
+/**
+ * @brief 메모리에 다 있는 입력 (mmap 한 기록 파일 등) 일괄 파싱
+ *
+ * data[0, limit) 안의 '$' 로 시작하는 문장을 검증해 콜백으로 전달한다.
+ * 문장 끝은 data[limit, n) 까지 읽을 수 있고, n 에서 잘린 문장은 버린다.
+ * 결과 (콜백, 통계) 는 같은 바이트를 nmea_parser_feed 로 넣은 것과 같으며
+ * 본문 스캔 ('*' '$' CR LF / ',' 탐색, 체크섬 XOR) 은 16 바이트씩 SIMD 로 한다.
+ * 진행 중인 스트리밍 문장은 버려지고 carry 는 쓰지 않는다.
+ *
+ * @return 전달된 문장 수
+ */
+int nmea_parser_scan(NmeaParser *p, const char *data, size_t n, size_t limit);
+
+// ─────────────────────────────────────────────
+//  필드 접근 / 디코더
+//  디코더는 모두 성공 0, 빈 필드 또는 형식 오류 -1
+// ─────────────────────────────────────────────
+
+/**
+ * @brief i 번째 필드 (범위 밖이면 빈 슬라이스)
+ */
+static inline NmeaSlice nmea_field(const NmeaSentence *s, int i)
+{
+    NmeaSlice empty = { "", 0 };
+    return (i < s->nfields) ? s->field[i] : empty;
+}
+
+/**
+ * @brief 주소 필드 비교 (예: nmea_sentence_is(s, "GPGGA"))
+ */
+int nmea_sentence_is(const NmeaSentence *s, const char *addr);
+
+/**
+ * @brief 정수 필드 ("12", "-3")
+ * @return 0: 성공, -1: 숫자 아님 / int32 넘침
+ */
+int nmea_parse_int(NmeaSlice f, int32_t *out);
+
+/**
+ * @brief 고정소수점 필드 → 정수 (값 × 10^scale, 초과 자릿수는 버림)
+ *        예: "1.25", scale=2 → 125
+ * @return 0: 성공, -1: 형식 오류 / 결과가 int32 넘침
+ */
+int nmea_parse_fixed(NmeaSlice f, int scale, int32_t *out);
+
+/**
+ * @brief 좌표 DDMM.MMMMM / DDDMM.MMMMM + 반구 → 1e-7 도 (atof 없음)
+ * @param f    좌표 필드
+ * @param hemi 'N'/'S'/'E'/'W' 필드 (S, W 이면 음수)
+ * @param out  결과 (deg × 1e7)
+ * @return 0: 성공, -1: 형식 오류 / 정수부 5자리 초과 / 분 >= 60 / 180° 초과
+ */
+int nmea_parse_coord(NmeaSlice f, NmeaSlice hemi, int32_t *out);
+
+/**
+ * @brief UTC 시각 hhmmss(.sss) → 자정 이후 ms
+ */
+int nmea_parse_time(NmeaSlice f, int32_t *ms_of_day);
+
+/**
+ * @brief 1e-7 도 → double 도
+ */
+static inline double nmea_e7_to_deg(int32_t e7)
+{
+    return e7 * 1e-7;
+}
+
+#endif /* NMEA_H */
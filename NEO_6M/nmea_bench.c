@@ -0,0 +1,204 @@
+// libnmea 처리량 벤치마크 (기존 strtok/atof 루프 대비)
+//
+// 빌드: make nmea_bench
+// 실행: ./nmea_bench [MB]   (기본 32MB 합성 NMEA 스트림)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "nmea.h"
+#include "nmea_msg.h"
+#include "gps_synth.h"
+
+#define CHUNK_SIZE   512        // 기존 도구의 read() 버퍼 크기
+#define CORRUPT_EVERY 200       // N 문장마다 1바이트 손상
+
+// ─────────────────────────────────────────────
+//  기존 방식 (neo_6m_fixed.c 루프와 동일)
+// ─────────────────────────────────────────────
+static double legacy_nmea_to_decimal(const char *nmea, char direction) {
+    if (!nmea || strlen(nmea) < 4) return 0.0;
+    double val = atof(nmea);
+    int deg = (int)(val / 100);
+    double min = val - deg * 100;
+    double dec = deg + min / 60.0;
+    if (direction == 'S' || direction == 'W') dec = -dec;
+    return dec;
+}
+
+typedef struct {
+    char   line[128];
+    int    line_idx;
+    long   fixes;
+    double lat_sum, lon_sum;
+} Legacy;
+
+static void legacy_feed(Legacy *lg, const char *buf, int n)
+{
+    for (int i = 0; i < n; i++) {
+        char c = buf[i];
+        if (c == '\n') {
+            lg->line[lg->line_idx] = '\0';
+            lg->line_idx = 0;
+
+            if (strncmp(lg->line, "$GPGGA", 6) == 0) {
+                char *token = strtok(lg->line, ",");
+                int field = 0;
+                char lat[16] = {0}, lon[16] = {0};
+                char ns = 'N', ew = 'E';
+                int fix_quality = 0;
+
+                while (token) {
+                    field++;
+                    switch (field) {
+                        case 3: strcpy(lat, token); break;
+                        case 4: ns = token[0]; break;
+                        case 5: strcpy(lon, token); break;
+                        case 6: ew = token[0]; break;
+                        case 7: fix_quality = atoi(token); break;
+                    }
+                    token = strtok(NULL, ",");
+                }
+
+                if (fix_quality > 0) {
+                    double latitude = legacy_nmea_to_decimal(lat, ns);
+                    double longitude = legacy_nmea_to_decimal(lon, ew);
+                    lg->fixes++;
+                    lg->lat_sum += latitude;
+                    lg->lon_sum += longitude;
+                }
+            }
+
+            memset(lg->line, 0, sizeof(lg->line));
+        } else if (c != '\r') {
+            lg->line[lg->line_idx++] = c;
+            if (lg->line_idx >= (int)sizeof(lg->line)-1) lg->line_idx = sizeof(lg->line)-2;
+        }
+    }
+}
+
+// ─────────────────────────────────────────────
+//  libnmea
+// ─────────────────────────────────────────────
+typedef struct {
+    long   fixes;
+    double lat_sum, lon_sum;
+} Lib;
+
+static void lib_on_sentence(const NmeaSentence *s, void *user)
+{
+    Lib *lb = user;
+    int32_t fix = 0, lat, lon;
+
+    if (!nmea_sentence_is(s, "GPGGA")) return;
+    if (nmea_parse_int(nmea_field(s, 6), &fix) != 0 || fix <= 0) return;
+    if (nmea_parse_coord(nmea_field(s, 2), nmea_field(s, 3), &lat) != 0) return;
+    if (nmea_parse_coord(nmea_field(s, 4), nmea_field(s, 5), &lon) != 0) return;
+
+    lb->fixes++;
+    lb->lat_sum += nmea_e7_to_deg(lat);
+    lb->lon_sum += nmea_e7_to_deg(lon);
+}
+
+// libnmea + 디스패치 (GGA 콜백만 등록, 모든 talker)
+static void dsp_on_gga(const NmeaMsg *m, void *user)
+{
+    Lib *lb = user;
+
+    if (!(m->gga.valid & NMEA_V_POS)) return;
+    lb->fixes++;
+    lb->lat_sum += nmea_e7_to_deg(m->gga.lat);
+    lb->lon_sum += nmea_e7_to_deg(m->gga.lon);
+}
+
+// ─────────────────────────────────────────────
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    size_t mb   = (argc > 1) ? (size_t)atoi(argv[1]) : 32;
+    size_t cap  = mb << 20;
+    char  *data = malloc(cap + 4096);
+    size_t len  = 0;
+    int    nsent = 0, corrupted = 0;
+
+    if (!data) { perror("malloc"); return 1; }
+
+    for (int i = 0; len < cap; i++) {
+        int before = nsent;
+        size_t n = nmea_synth_epoch(data + len, i, 1);
+        nsent += NMEA_SYNTH_SENTENCES;
+        // 문장 단위로 일부 바이트 손상 (체크섬 불일치 유도)
+        if (before / CORRUPT_EVERY != nsent / CORRUPT_EVERY) {
+            data[len + 20] ^= 0x01;
+            corrupted++;
+        }
+        len += n;
+    }
+
+    printf("input: %.1f MB, %d sentences, %d corrupted\n",
+           len / 1048576.0, nsent, corrupted);
+
+    // ── 기존 방식 ──
+    Legacy *lg = calloc(1, sizeof(Legacy));
+    double t0 = now_sec();
+    for (size_t off = 0; off < len; off += CHUNK_SIZE) {
+        size_t n = (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE;
+        legacy_feed(lg, data + off, (int)n);
+    }
+    double t_legacy = now_sec() - t0;
+
+    // ── libnmea ──
+    Lib lb = {0};
+    NmeaParser p;
+    nmea_parser_init(&p, lib_on_sentence, &lb);
+    t0 = now_sec();
+    for (size_t off = 0; off < len; off += CHUNK_SIZE) {
+        size_t n = (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE;
+        nmea_parser_feed(&p, data + off, n);
+    }
+    double t_lib = now_sec() - t0;
+
+    // ── libnmea + dispatch ──
+    Lib ld = {0};
+    NmeaParser pd;
+    NmeaDispatch disp;
+    nmea_dispatch_init(&disp);
+    nmea_dispatch_on(&disp, NMEA_GGA, dsp_on_gga, &ld);
+    nmea_parser_init(&pd, nmea_dispatch_sentence, &disp);
+    t0 = now_sec();
+    for (size_t off = 0; off < len; off += CHUNK_SIZE) {
+        size_t n = (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE;
+        nmea_parser_feed(&pd, data + off, n);
+    }
+    double t_dsp = now_sec() - t0;
+
+    printf("legacy : %8.1f MB/s  fixes=%ld (checksum not checked)\n",
+           len / 1048576.0 / t_legacy, lg->fixes);
+    printf("libnmea: %8.1f MB/s  fixes=%ld sentences=%llu cksum_err=%llu framing=%llu overflow=%llu\n",
+           len / 1048576.0 / t_lib, lb.fixes,
+           (unsigned long long)p.stats.sentences,
+           (unsigned long long)p.stats.checksum_errors,
+           (unsigned long long)p.stats.framing_errors,
+           (unsigned long long)p.stats.overflows);
+    printf("dispatch: %7.1f MB/s  fixes=%ld (GGA decoded=%llu, skipped=%llu)\n",
+           len / 1048576.0 / t_dsp, ld.fixes,
+           (unsigned long long)disp.count[NMEA_GGA],
+           (unsigned long long)disp.ignored);
+    printf("speedup: %.2fx\n", t_legacy / t_lib);
+    if (lg->fixes && lb.fixes)
+        printf("mean position: legacy %.7f, %.7f | libnmea %.7f, %.7f\n",
+               lg->lat_sum / lg->fixes, lg->lon_sum / lg->fixes,
+               lb.lat_sum / lb.fixes, lb.lon_sum / lb.fixes);
+
+    free(lg);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,162 @@
+// 대용량 NMEA 캡처 일괄 처리 (사후 분석용)
+//
+// cat /dev/serial0 > track.nmea 같은 원시 캡처를 mmap 해 모든 코어로 검증 / 디코딩 /
+// epoch 조립하고 fix 를 열 (columnar) 파일 또는 CSV 로 저장한다.
+//
+// 실행: ./nmea_ingest [-j threads] [-o out.col] [-c out.csv] [-s] track.nmea
+//         -j  스레드 수 (기본 온라인 CPU 수)
+//         -o  열 파일 (GpsColsHeader + 열 목록 + int32 배열)
+//         -c  CSV (행 단위, 확인용)
+//         -s  같은 입력을 기존 스트리밍 경로 (512B read + nmea_parser_feed) 로도 처리해 비교
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_ingest.h"
+
+#define READ_CHUNK  512         // 기존 도구의 read() 버퍼 크기
+
+static int64_t zero_clock(void)
+{
+    return 0;
+}
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    (void)f;
+    (*(long *)user)++;
+}
+
+/**
+ * @brief 기존 방식: read() 512B + 스트리밍 파서 (조립 정책은 gps_ingest 와 같게)
+ */
+static double stream_file(const char *path, long *fixes)
+{
+    NmeaParser   p;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    char         buf[READ_CHUNK];
+    ssize_t      n;
+    int          fd = open(path, O_RDONLY);
+
+    if (fd < 0) return -1.0;
+    gps_epoch_init(&ep, on_fix, fixes);
+    gps_epoch_set_policy(&ep, 0, 0);
+    gps_epoch_set_clock(&ep, zero_clock);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    nmea_parser_init(&p, nmea_dispatch_sentence, &disp);
+
+    int64_t t0 = gps_now_ns();
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+        nmea_parser_feed(&p, buf, (size_t)n);
+    gps_epoch_flush(&ep);
+    close(fd);
+    return (gps_now_ns() - t0) / 1e9;
+}
+
+static int write_csv(const GpsCols *t, const char *path)
+{
+    FILE *fp = fopen(path, "w");
+
+    if (!fp) return -1;
+    for (int c = 0; c < GPS_COL_COUNT; c++)
+        fprintf(fp, "%s%c", gps_cols_name(c), c + 1 < GPS_COL_COUNT ? ',' : '\n');
+    for (size_t r = 0; r < t->rows; r++) {
+        fprintf(fp, "%#x,%d,%d,%.7f,%.7f", (unsigned)t->col[GPS_COL_VALID][r],
+                t->col[GPS_COL_DATE][r], t->col[GPS_COL_TIME][r],
+                nmea_e7_to_deg(t->col[GPS_COL_LAT][r]), nmea_e7_to_deg(t->col[GPS_COL_LON][r]));
+        for (int c = GPS_COL_ALT; c < GPS_COL_COUNT; c++)
+            fprintf(fp, ",%d", t->col[c][r]);
+        fputc('\n', fp);
+    }
+    return fclose(fp);
+}
+
+int main(int argc, char **argv)
+{
+    const char *col_out = NULL, *csv_out = NULL;
+    int         threads = 0, serial = 0, opt;
+
+    while ((opt = getopt(argc, argv, "j:o:c:s")) != -1) {
+        switch (opt) {
+            case 'j': threads = atoi(optarg); break;
+            case 'o': col_out = optarg;       break;
+            case 'c': csv_out = optarg;       break;
+            case 's': serial  = 1;            break;
+            default:
+                fprintf(stderr, "usage: %s [-j threads] [-o out.col] [-c out.csv] [-s] file.nmea\n",
+                        argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [options] file.nmea\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[optind];
+
+    int         fd = open(path, O_RDONLY);
+    struct stat sb;
+    if (fd < 0 || fstat(fd, &sb) < 0) {
+        perror(path);
+        return 1;
+    }
+    size_t      size = (size_t)sb.st_size;
+    const char *data = "";
+    if (size > 0) {
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror("mmap");
+            return 1;
+        }
+        madvise((void *)data, size, MADV_WILLNEED);
+    }
+
+    GpsCols        cols;
+    GpsIngestStats st;
+    if (gps_cols_init(&cols, 0) < 0) {
+        perror("gps_cols_init");
+        return 1;
+    }
+
+    int64_t t0 = gps_now_ns();
+    if (gps_ingest(data, size, threads, &cols, &st) < 0) {
+        perror("gps_ingest");
+        return 1;
+    }
+    double t = (gps_now_ns() - t0) / 1e9;
+
+    printf("%s: %.1f MB, %d threads, %.3f s, %.2f GB/s\n",
+           path, size / 1e6, st.threads, t, t > 0 ? size / 1e9 / t : 0.0);
+    printf("sentences %llu (checksum %llu, framing %llu, overflow %llu, unknown %llu)\n",
+           (unsigned long long)st.parse.sentences, (unsigned long long)st.parse.checksum_errors,
+           (unsigned long long)st.parse.framing_errors, (unsigned long long)st.parse.overflows,
+           (unsigned long long)st.unknown);
+    printf("fixes %llu (%llu with position), undated %llu, time going backwards %llu\n",
+           (unsigned long long)st.fixes, (unsigned long long)st.with_pos,
+           (unsigned long long)st.undated, (unsigned long long)st.backwards);
+
+    if (serial) {
+        long   fixes = 0;
+        double ts = stream_file(path, &fixes);
+        if (ts < 0) { perror(path); return 1; }
+        printf("stream (read %d B): %.3f s, %.2f GB/s, %ld fixes  -> x%.1f\n",
+               READ_CHUNK, ts, size / 1e9 / ts, fixes, ts / t);
+    }
+
+    if (col_out && gps_cols_write(&cols, col_out) < 0) { perror(col_out); return 1; }
+    if (csv_out && write_csv(&cols, csv_out) != 0) { perror(csv_out); return 1; }
+
+    gps_cols_free(&cols);
+    if (size > 0) munmap((void *)data, size);
+    close(fd);
+    return 0;
+}
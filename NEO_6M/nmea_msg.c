@@ -0,0 +1,242 @@
+#include "nmea_msg.h"
+
+#include <string.h>
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static char field_char(const NmeaSentence *s, int i)
+{
+    NmeaSlice f = nmea_field(s, i);
+    return f.len ? f.ptr[0] : 0;
+}
+
+/**
+ * @brief 위도/경도 필드 쌍 (lat, N/S, lon, E/W) 디코딩
+ */
+static int decode_pos(const NmeaSentence *s, int i, int32_t *lat, int32_t *lon)
+{
+    return nmea_parse_coord(nmea_field(s, i),     nmea_field(s, i + 1), lat) == 0 &&
+           nmea_parse_coord(nmea_field(s, i + 2), nmea_field(s, i + 3), lon) == 0;
+}
+
+static int set_bit(uint32_t *valid, uint32_t bit, int ok)
+{
+    if (ok) *valid |= bit;
+    return ok;
+}
+
+// knot ×1000 → mm/s (1 knot = 1852/3600 m/s)
+static int32_t mknot_to_mmps(int32_t mknot)
+{
+    return (int32_t)(((int64_t)mknot * 1852 + 1800) / 3600);
+}
+
+// km/h ×1000 → mm/s
+static int32_t mkph_to_mmps(int32_t mkph)
+{
+    return (int32_t)(((int64_t)mkph * 10 + 18) / 36);
+}
+
+// ─────────────────────────────────────────────
+//  타입별 디코더 (field[0] = 주소)
+// ─────────────────────────────────────────────
+
+// GGA: 1 시각, 2-5 위치, 6 quality, 7 위성 수, 8 HDOP, 9 고도, 11 geoid
+static void decode_gga(const NmeaSentence *s, NmeaGga *g)
+{
+    memset(g, 0, sizeof(*g));
+    set_bit(&g->valid, NMEA_V_TIME,    nmea_parse_time(nmea_field(s, 1), &g->time_ms) == 0);
+    set_bit(&g->valid, NMEA_V_QUALITY, nmea_parse_int(nmea_field(s, 6), &g->quality) == 0);
+    set_bit(&g->valid, NMEA_V_SATS,    nmea_parse_int(nmea_field(s, 7), &g->num_sats) == 0);
+    set_bit(&g->valid, NMEA_V_HDOP,    nmea_parse_fixed(nmea_field(s, 8), 2, &g->hdop) == 0);
+    set_bit(&g->valid, NMEA_V_ALT,     nmea_parse_fixed(nmea_field(s, 9), 3, &g->alt_mm) == 0);
+    set_bit(&g->valid, NMEA_V_GEOID,   nmea_parse_fixed(nmea_field(s, 11), 3, &g->geoid_mm) == 0);
+
+    // quality 0 이면 좌표가 있어도 무효
+    if (g->quality > 0 && decode_pos(s, 2, &g->lat, &g->lon))
+        g->valid |= NMEA_V_POS;
+}
+
+// RMC: 1 시각, 2 상태, 3-6 위치, 7 속도(knot), 8 방위, 9 날짜, 12 모드
+static void decode_rmc(const NmeaSentence *s, NmeaRmc *r)
+{
+    int32_t v;
+
+    memset(r, 0, sizeof(*r));
+    set_bit(&r->valid, NMEA_V_TIME, nmea_parse_time(nmea_field(s, 1), &r->time_ms) == 0);
+    int ok = set_bit(&r->valid, NMEA_V_STATUS, field_char(s, 2) == 'A');
+    r->mode = field_char(s, 12);
+    if (r->mode == 'N') ok = 0;
+
+    if (ok && decode_pos(s, 3, &r->lat, &r->lon))
+        r->valid |= NMEA_V_POS;
+    if (ok && nmea_parse_fixed(nmea_field(s, 7), 3, &v) == 0) {
+        r->speed_mmps = mknot_to_mmps(v);
+        r->valid |= NMEA_V_SPEED;
+    }
+    if (ok)
+        set_bit(&r->valid, NMEA_V_COURSE, nmea_parse_fixed(nmea_field(s, 8), 2, &r->course_cdeg) == 0);
+
+    NmeaSlice d = nmea_field(s, 9);
+    if (d.len == 6 && nmea_parse_int(d, &v) == 0) {
+        r->day   = (uint8_t)(v / 10000);
+        r->month = (uint8_t)(v / 100 % 100);
+        r->year  = (uint16_t)(2000 + v % 100);
+        r->valid |= NMEA_V_DATE;
+    }
+}
+
+// VTG: 1 진북 방위, 5 속도(knot), 7 속도(km/h), 9 모드
+static void decode_vtg(const NmeaSentence *s, NmeaVtg *t)
+{
+    int32_t v;
+
+    memset(t, 0, sizeof(*t));
+    t->mode = field_char(s, 9);
+    if (t->mode == 'N') return;
+
+    set_bit(&t->valid, NMEA_V_COURSE, nmea_parse_fixed(nmea_field(s, 1), 2, &t->course_cdeg) == 0);
+    if (nmea_parse_fixed(nmea_field(s, 5), 3, &v) == 0) {
+        t->speed_mmps = mknot_to_mmps(v);
+        t->valid |= NMEA_V_SPEED;
+    } else if (nmea_parse_fixed(nmea_field(s, 7), 3, &v) == 0) {
+        t->speed_mmps = mkph_to_mmps(v);
+        t->valid |= NMEA_V_SPEED;
+    }
+}
+
+// GSA: 1 M/A, 2 fix type, 3-14 PRN, 15 PDOP, 16 HDOP, 17 VDOP
+static void decode_gsa(const NmeaSentence *s, NmeaGsa *a)
+{
+    int32_t v;
+
+    memset(a, 0, sizeof(*a));
+    a->op_mode = field_char(s, 1);
+    set_bit(&a->valid, NMEA_V_FIXTYPE, nmea_parse_int(nmea_field(s, 2), &a->fix_type) == 0);
+
+    for (int i = 3; i < 3 + NMEA_GSA_MAX_SV; i++)
+        if (nmea_parse_int(nmea_field(s, i), &v) == 0)
+            a->prn[a->nprn++] = (uint8_t)v;
+
+    set_bit(&a->valid, NMEA_V_PDOP, nmea_parse_fixed(nmea_field(s, 15), 2, &a->pdop) == 0);
+    set_bit(&a->valid, NMEA_V_HDOP, nmea_parse_fixed(nmea_field(s, 16), 2, &a->hdop) == 0);
+    set_bit(&a->valid, NMEA_V_VDOP, nmea_parse_fixed(nmea_field(s, 17), 2, &a->vdop) == 0);
+}
+
+// GSV: 1 전체 문장 수, 2 문장 번호, 3 가시 위성 수, 4~ (PRN, 고도각, 방위각, SNR) × 4
+static void decode_gsv(const NmeaSentence *s, NmeaGsv *g)
+{
+    int32_t v[4];
+
+    memset(g, 0, sizeof(*g));
+    nmea_parse_int(nmea_field(s, 1), &g->total_msgs);
+    nmea_parse_int(nmea_field(s, 2), &g->msg_num);
+    nmea_parse_int(nmea_field(s, 3), &g->in_view);
+
+    for (int i = 4; i + 3 < s->nfields && g->nsv < 4; i += 4) {
+        if (nmea_parse_int(nmea_field(s, i), &v[0]) != 0) continue;
+        NmeaSv *sv = &g->sv[g->nsv++];
+        sv->prn  = (int16_t)v[0];
+        sv->elev = (int16_t)(nmea_parse_int(nmea_field(s, i + 1), &v[1]) == 0 ? v[1] : 0);
+        sv->azim = (int16_t)(nmea_parse_int(nmea_field(s, i + 2), &v[2]) == 0 ? v[2] : 0);
+        sv->snr  = (int16_t)(nmea_parse_int(nmea_field(s, i + 3), &v[3]) == 0 ? v[3] : -1);
+    }
+}
+
+// GLL: 1-4 위치, 5 시각, 6 상태, 7 모드
+static void decode_gll(const NmeaSentence *s, NmeaGll *l)
+{
+    memset(l, 0, sizeof(*l));
+    set_bit(&l->valid, NMEA_V_TIME, nmea_parse_time(nmea_field(s, 5), &l->time_ms) == 0);
+    int ok = set_bit(&l->valid, NMEA_V_STATUS, field_char(s, 6) == 'A');
+    l->mode = field_char(s, 7);
+    if (l->mode == 'N') ok = 0;
+    if (ok && decode_pos(s, 1, &l->lat, &l->lon))
+        l->valid |= NMEA_V_POS;
+}
+
+// ─────────────────────────────────────────────
+//  디스패치
+// ─────────────────────────────────────────────
+
+NmeaType nmea_sentence_type(const NmeaSentence *s, uint16_t *talker)
+{
+    NmeaSlice a = nmea_field(s, 0);
+    if (a.len != 5) return NMEA_TYPE_COUNT;
+
+    uint16_t t = NMEA_TALKER(a.ptr[0], a.ptr[1]);
+    if (talker) *talker = t;
+
+    // $PGRMC, $PUBX 등 제조사 전용 문장은 3..5 자리가 우연히 겹쳐도 다른 포맷
+    switch (t) {
+        case NMEA_TALKER('G', 'P'): case NMEA_TALKER('G', 'N'):
+        case NMEA_TALKER('G', 'L'): case NMEA_TALKER('G', 'A'):
+        case NMEA_TALKER('G', 'B'): case NMEA_TALKER('B', 'D'):
+            break;
+        default:
+            return NMEA_TYPE_COUNT;
+    }
+
+    switch (NMEA_ID3(a.ptr[2], a.ptr[3], a.ptr[4])) {
+        case NMEA_ID3('G', 'G', 'A'): return NMEA_GGA;
+        case NMEA_ID3('R', 'M', 'C'): return NMEA_RMC;
+        case NMEA_ID3('V', 'T', 'G'): return NMEA_VTG;
+        case NMEA_ID3('G', 'S', 'A'): return NMEA_GSA;
+        case NMEA_ID3('G', 'S', 'V'): return NMEA_GSV;
+        case NMEA_ID3('G', 'L', 'L'): return NMEA_GLL;
+        default:                      return NMEA_TYPE_COUNT;
+    }
+}
+
+int nmea_decode(const NmeaSentence *s, NmeaMsg *out)
+{
+    out->type  = nmea_sentence_type(s, &out->talker);
+    out->rx_ns  = s->rx_ns;
+    out->end_ns = s->end_ns;
+
+    switch (out->type) {
+        case NMEA_GGA: decode_gga(s, &out->gga); return 0;
+        case NMEA_RMC: decode_rmc(s, &out->rmc); return 0;
+        case NMEA_VTG: decode_vtg(s, &out->vtg); return 0;
+        case NMEA_GSA: decode_gsa(s, &out->gsa); return 0;
+        case NMEA_GSV: decode_gsv(s, &out->gsv); return 0;
+        case NMEA_GLL: decode_gll(s, &out->gll); return 0;
+        default:       return -1;
+    }
+}
+
+void nmea_dispatch_init(NmeaDispatch *d)
+{
+    memset(d, 0, sizeof(NmeaDispatch));
+}
+
+void nmea_dispatch_on(NmeaDispatch *d, NmeaType type, NmeaMsgCb cb, void *user)
+{
+    if (type >= NMEA_TYPE_COUNT) return;
+    d->cb[type]   = cb;
+    d->user[type] = user;
+}
+
+void nmea_dispatch_sentence(const NmeaSentence *s, void *dispatch)
+{
+    NmeaDispatch *d = dispatch;
+    NmeaMsg       m;
+    NmeaType      t = nmea_sentence_type(s, &m.talker);
+
+    if (t == NMEA_TYPE_COUNT) { d->unknown++; return; }
+    if (!d->cb[t])            { d->ignored++; return; }
+
+    nmea_decode(s, &m);
+    d->count[t]++;
+    d->cb[t](&m, d->user[t]);
+}
+
+const char *nmea_type_name(NmeaType type)
+{
+    static const char *names[NMEA_TYPE_COUNT] = {
+        "GGA", "RMC", "VTG", "GSA", "GSV", "GLL",
+    };
+    return (type < NMEA_TYPE_COUNT) ? names[type] : "?";
+}
@@ -0,0 +1,179 @@
+#ifndef NMEA_MSG_H
+#define NMEA_MSG_H
+
+#include <stdint.h>
+#include "nmea.h"
+
+// ─────────────────────────────────────────────
+//  libnmea 타입별 디코더 + 디스패치 테이블
+//
+//  주소 필드 "TTSSS" (talker 2 + 문장 3) 를 32bit 워드로 묶어
+//  switch 로 분기 → 콜백이 등록된 타입만 디코딩
+//  talker 는 GP/GN/GL/GA/GB/BD 만 허용 ($P... 제조사 문장은 미지원 취급)
+// ─────────────────────────────────────────────
+
+#define NMEA_ID3(a, b, c)   (((uint32_t)(uint8_t)(a) << 16) | \
+                             ((uint32_t)(uint8_t)(b) << 8)  | (uint8_t)(c))
+#define NMEA_TALKER(a, b)   ((uint16_t)(((uint8_t)(a) << 8) | (uint8_t)(b)))
+
+typedef enum {
+    NMEA_GGA = 0,
+    NMEA_RMC,
+    NMEA_VTG,
+    NMEA_GSA,
+    NMEA_GSV,
+    NMEA_GLL,
+    NMEA_TYPE_COUNT
+} NmeaType;
+
+// ─────────────────────────────────────────────
+//  필드 유효 비트 (빈 필드/상태 V 이면 해당 비트 0)
+// ─────────────────────────────────────────────
+enum {
+    NMEA_V_TIME     = 1u << 0,
+    NMEA_V_POS      = 1u << 1,      // 위도/경도
+    NMEA_V_QUALITY  = 1u << 2,      // GGA fix quality
+    NMEA_V_SATS     = 1u << 3,      // 사용 위성 수
+    NMEA_V_HDOP     = 1u << 4,
+    NMEA_V_ALT      = 1u << 5,      // 해발 고도
+    NMEA_V_GEOID    = 1u << 6,      // geoid 분리
+    NMEA_V_SPEED    = 1u << 7,
+    NMEA_V_COURSE   = 1u << 8,
+    NMEA_V_DATE     = 1u << 9,
+    NMEA_V_PDOP     = 1u << 10,
+    NMEA_V_VDOP     = 1u << 11,
+    NMEA_V_FIXTYPE  = 1u << 12,     // GSA 2D/3D
+    NMEA_V_STATUS   = 1u << 13,     // RMC/GLL 상태 'A'
+};
+
+// ─────────────────────────────────────────────
+//  타입별 디코딩 결과 (정수 고정소수점)
+//    좌표   : 1e-7 도
+//    DOP    : ×100
+//    속도   : mm/s
+//    방위   : ×100 도 (진북)
+//    고도   : mm
+// ─────────────────────────────────────────────
+typedef struct {
+    uint32_t valid;
+    int32_t  time_ms;           // UTC 자정 이후 ms
+    int32_t  lat, lon;
+    int32_t  quality;           // 0=no fix, 1=GPS, 2=DGPS, 6=추정
+    int32_t  num_sats;
+    int32_t  hdop;
+    int32_t  alt_mm;
+    int32_t  geoid_mm;
+} NmeaGga;
+
+typedef struct {
+    uint32_t valid;
+    int32_t  time_ms;
+    int32_t  lat, lon;
+    int32_t  speed_mmps;
+    int32_t  course_cdeg;
+    uint8_t  day, month;
+    uint16_t year;
+    char     mode;              // A/D/E/N (NMEA 2.3+), 없으면 0
+} NmeaRmc;
+
+typedef struct {
+    uint32_t valid;
+    int32_t  course_cdeg;
+    int32_t  speed_mmps;
+    char     mode;
+} NmeaVtg;
+
+#define NMEA_GSA_MAX_SV 12
+
+typedef struct {
+    uint32_t valid;
+    char     op_mode;           // M/A
+    int32_t  fix_type;          // 1=없음, 2=2D, 3=3D
+    uint8_t  nprn;
+    uint8_t  prn[NMEA_GSA_MAX_SV];
+    int32_t  pdop, hdop, vdop;
+} NmeaGsa;
+
+typedef struct {
+    int16_t prn;
+    int16_t elev;               // 도
+    int16_t azim;               // 도
+    int16_t snr;                // dBHz, 추적 안 됨 = -1
+} NmeaSv;
+
+typedef struct {
+    int32_t  total_msgs;
+    int32_t  msg_num;
+    int32_t  in_view;
+    uint8_t  nsv;
+    NmeaSv   sv[4];
+} NmeaGsv;
+
+typedef struct {
+    uint32_t valid;
+    int32_t  time_ms;
+    int32_t  lat, lon;
+    char     mode;
+} NmeaGll;
+
+typedef struct {
+    NmeaType type;
+    uint16_t talker;            // NMEA_TALKER('G','N') 등
+    int64_t  rx_ns;             // 문장 시작/끝 수신 시각 (NmeaSentence 와 동일)
+    int64_t  end_ns;
+    union {
+        NmeaGga gga;
+        NmeaRmc rmc;
+        NmeaVtg vtg;
+        NmeaGsa gsa;
+        NmeaGsv gsv;
+        NmeaGll gll;
+    };
+} NmeaMsg;
+
+typedef void (*NmeaMsgCb)(const NmeaMsg *m, void *user);
+
+// ─────────────────────────────────────────────
+//  디스패치 테이블
+// ─────────────────────────────────────────────
+typedef struct {
+    NmeaMsgCb  cb[NMEA_TYPE_COUNT];
+    void      *user[NMEA_TYPE_COUNT];
+    uint64_t   count[NMEA_TYPE_COUNT];  // 디코딩된 문장 수
+    uint64_t   unknown;                 // 미지원 문장 수
+    uint64_t   ignored;                 // 콜백 없어 디코딩 생략
+} NmeaDispatch;
+
+/**
+ * @brief 디스패치 테이블 초기화 (모든 타입 콜백 없음)
+ */
+void nmea_dispatch_init(NmeaDispatch *d);
+
+/**
+ * @brief 타입별 콜백 등록 (NULL 이면 해제)
+ */
+void nmea_dispatch_on(NmeaDispatch *d, NmeaType type, NmeaMsgCb cb, void *user);
+
+/**
+ * @brief NmeaSentenceCb 호환 진입점
+ *        nmea_parser_init(&p, nmea_dispatch_sentence, &d) 로 연결
+ */
+void nmea_dispatch_sentence(const NmeaSentence *s, void *dispatch);
+
+/**
+ * @brief 주소 필드 → 타입 (미지원 문장/talker 면 NMEA_TYPE_COUNT)
+ */
+NmeaType nmea_sentence_type(const NmeaSentence *s, uint16_t *talker);
+
+/**
+ * @brief 문장 1개를 타입별 구조체로 디코딩
+ * @return 0: 성공, -1: 미지원 타입
+ */
+int nmea_decode(const NmeaSentence *s, NmeaMsg *out);
+
+/**
+ * @brief 타입 이름 ("GGA" 등)
+ */
+const char *nmea_type_name(NmeaType type);
+
+#endif /* NMEA_MSG_H */
@@ -0,0 +1,121 @@
+#include "pan_tilt.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+static int32_t clamp_mdeg(double v, int32_t lo, int32_t hi, int *clamped)
+{
+    if (v < lo) { *clamped = 1; return lo; }
+    if (v > hi) { *clamped = 1; return hi; }
+    return (int32_t)lround(v);
+}
+
+void pan_tilt_init(PanTilt *pt)
+{
+    memset(pt, 0, sizeof(PanTilt));
+    pt->fd              = -1;
+    pt->fwd_pan_mdeg    = MG996R_CENTER_MDEG;
+    pt->pan_sign        = 1;
+    pt->level_tilt_mdeg = MG996R_CENTER_MDEG;
+    pt->tilt_sign       = 1;
+    pt->deadband_mdeg   = PAN_TILT_DEADBAND_MDEG;
+    pt->interval_ns     = PAN_TILT_INTERVAL_MS * 1000000LL;
+    pt->pan_mdeg        = MG996R_CENTER_MDEG;
+    pt->tilt_mdeg       = MG996R_CENTER_MDEG;
+}
+
+int pan_tilt_open(PanTilt *pt, const char *path)
+{
+    pan_tilt_init(pt);
+    pt->fd = open(path ? path : MG996R_DEV_PATH, O_RDWR | O_CLOEXEC);
+    return (pt->fd < 0) ? -1 : 0;
+}
+
+void pan_tilt_set_mount(PanTilt *pt, double fwd_pan_deg, int sign)
+{
+    pt->fwd_pan_mdeg = (int32_t)lround(fwd_pan_deg * MG996R_MDEG_PER_DEG);
+    pt->pan_sign     = (sign < 0) ? -1 : 1;
+}
+
+void pan_tilt_set_tilt_mount(PanTilt *pt, double level_tilt_deg, int sign)
+{
+    pt->level_tilt_mdeg = (int32_t)lround(level_tilt_deg * MG996R_MDEG_PER_DEG);
+    pt->tilt_sign       = (sign < 0) ? -1 : 1;
+}
+
+void pan_tilt_set_rate(PanTilt *pt, double deadband_deg, int interval_ms)
+{
+    pt->deadband_mdeg = (int32_t)lround(fabs(deadband_deg) * MG996R_MDEG_PER_DEG);
+    pt->interval_ns   = (interval_ms > 0) ? interval_ms * 1000000LL : 0;
+}
+
+/**
+ * @brief 자른 뒤 불감대 / 간격 확인, 보내기
+ * @param count_tilt tilt 가 잘린 것도 clamped 로 셈
+ */
+static int send(PanTilt *pt, double pan_v, double tilt_v, int count_tilt, int64_t now_ns)
+{
+    int clamped = 0, tilt_clamped = 0;
+
+    int32_t pan  = clamp_mdeg(pan_v, MG996R_PAN_MIN_MDEG, MG996R_PAN_MAX_MDEG, &clamped);
+    int32_t tilt = clamp_mdeg(tilt_v, MG996R_TILT_MIN_MDEG, MG996R_TILT_MAX_MDEG, &tilt_clamped);
+    if (clamped || (count_tilt && tilt_clamped)) pt->stats.clamped++;
+
+    if (pt->have && (now_ns - pt->last_ns < pt->interval_ns ||
+                     (abs(pan - pt->pan_mdeg) < pt->deadband_mdeg &&
+                      abs(tilt - pt->tilt_mdeg) < pt->deadband_mdeg))) {
+        pt->stats.skipped++;
+        return 0;
+    }
+
+    if (pt->fd >= 0) {
+        struct mg996r_angle_mdeg a = { .pan_mdeg = pan, .tilt_mdeg = tilt };
+        if (ioctl(pt->fd, MG996R_SET_BOTH_MDEG, &a) < 0) {
+            pt->stats.errors++;
+            return -1;
+        }
+    }
+    pt->pan_mdeg  = pan;
+    pt->tilt_mdeg = tilt;
+    pt->last_ns   = now_ns;
+    pt->have      = 1;
+    pt->stats.commands++;
+    return 1;
+}
+
+/**
+ * @brief 차체 기준 방위 → pan 밀리도 (자르기 전)
+ */
+static double pan_value(const PanTilt *pt, double rel_deg)
+{
+    // [-180, 180) 로 접기 (삼각함수 없이)
+    rel_deg = fmod(rel_deg + 180.0, 360.0);
+    if (rel_deg < 0.0) rel_deg += 360.0;
+    rel_deg -= 180.0;
+    return pt->fwd_pan_mdeg + pt->pan_sign * rel_deg * MG996R_MDEG_PER_DEG;
+}
+
+int pan_tilt_point(PanTilt *pt, double rel_deg, double tilt_deg, int64_t now_ns)
+{
+    return send(pt, pan_value(pt, rel_deg), tilt_deg * MG996R_MDEG_PER_DEG, 0, now_ns);
+}
+
+int pan_tilt_aim(PanTilt *pt, double az_deg, double el_deg, int64_t now_ns)
+{
+    return send(pt, pan_value(pt, az_deg),
+                pt->level_tilt_mdeg + pt->tilt_sign * el_deg * MG996R_MDEG_PER_DEG, 1, now_ns);
+}
+
+void pan_tilt_close(PanTilt *pt)
+{
+    if (pt->fd >= 0) {
+        ioctl(pt->fd, MG996R_DO_CENTER);
+        close(pt->fd);
+    }
+    pt->fd = -1;
+}
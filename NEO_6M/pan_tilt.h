@@ -0,0 +1,88 @@
+#ifndef PAN_TILT_H
+#define PAN_TILT_H
+
+#include <stdint.h>
+#include "mg996r.h"
+
+// ─────────────────────────────────────────────
+//  pan/tilt 지향 출력 (/dev/mg996r, 밀리도 ioctl)
+//
+//  차체 기준 상대 방위 (시계 방향 +) 와 tilt 각을 pan / tilt 밀리도로 바꿔
+//  MG996R_SET_BOTH_MDEG 로 보낸다. 드라이버 범위 (pan 70~170°, tilt 0~180°) 로
+//  자르고, 불감대 / 최소 간격으로 fix 마다의 작은 흔들림에 서보가 떨지 않게 한다.
+//  장치를 열지 않으면 (pan_tilt_init 만) 각도만 계산한다.
+//  pan_tilt_aim 은 방위 + 앙각 (차체 기준) 을 받아 tilt 도 장착 방향으로 바꾼다.
+// ─────────────────────────────────────────────
+
+#define PAN_TILT_DEADBAND_MDEG  500     // 이보다 작은 변화는 보내지 않음
+#define PAN_TILT_INTERVAL_MS    100     // 명령 최소 간격 (MG996R 0.17 s / 60°)
+
+typedef struct {
+    uint64_t commands;                  // 보낸 SET_BOTH_MDEG
+    uint64_t skipped;                   // 불감대 / 간격으로 건너뜀
+    uint64_t clamped;                   // 범위 밖 방위 (pan_tilt_aim 은 앙각 포함, 가장자리로 자름)
+    uint64_t errors;                    // ioctl 실패
+} PanTiltStats;
+
+typedef struct {
+    int          fd;                    // -1: 장치 없음 (계산만)
+    int32_t      pan_mdeg, tilt_mdeg;   // 마지막 명령 (계산만이면 마지막 계산값)
+    int32_t      fwd_pan_mdeg;          // 차체 정면을 보는 pan
+    int          pan_sign;              // +1: pan 이 커지면 오른쪽 (시계 방향)
+    int32_t      level_tilt_mdeg;       // 수평을 보는 tilt (pan_tilt_aim)
+    int          tilt_sign;             // +1: tilt 가 커지면 위
+    int32_t      deadband_mdeg;
+    int64_t      interval_ns, last_ns;
+    int          have;                  // 명령을 한 번이라도 보냄
+    PanTiltStats stats;
+} PanTilt;
+
+/**
+ * @brief 장치 없이 초기화 (정면 = MG996R_CENTER, 시계 방향 +, 기본 불감대 / 간격)
+ */
+void pan_tilt_init(PanTilt *pt);
+
+/**
+ * @brief pan_tilt_init + 장치 열기
+ * @param path NULL 이면 MG996R_DEV_PATH
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int pan_tilt_open(PanTilt *pt, const char *path);
+
+/**
+ * @brief 장착 방향 (차체 정면을 볼 때 pan 각, 방향 부호 +1 / -1)
+ */
+void pan_tilt_set_mount(PanTilt *pt, double fwd_pan_deg, int sign);
+
+/**
+ * @brief tilt 장착 방향 (수평을 볼 때 tilt 각, 방향 부호 +1 / -1), 기본 MG996R_CENTER / +1
+ */
+void pan_tilt_set_tilt_mount(PanTilt *pt, double level_tilt_deg, int sign);
+
+/**
+ * @brief 불감대 (도) / 명령 최소 간격 (ms)
+ */
+void pan_tilt_set_rate(PanTilt *pt, double deadband_deg, int interval_ms);
+
+/**
+ * @brief 차체 기준 방위로 지향
+ * @param rel_deg  차체 정면 기준 방위 (도, 시계 방향 +, 아무 범위나)
+ * @param tilt_deg tilt 각 (도, 드라이버 범위로 자름)
+ * @return 1: 명령 보냄, 0: 건너뜀, -1: ioctl 실패 (errno 설정)
+ */
+int pan_tilt_point(PanTilt *pt, double rel_deg, double tilt_deg, int64_t now_ns);
+
+/**
+ * @brief 차체 기준 방위 / 앙각으로 지향 (gps_aim 출력)
+ * @param az_deg 차체 정면 기준 방위 (도, 시계 방향 +)
+ * @param el_deg 차체 수평면 기준 앙각 (도, 위 +)
+ * @return pan_tilt_point 와 같음
+ */
+int pan_tilt_aim(PanTilt *pt, double az_deg, double el_deg, int64_t now_ns);
+
+/**
+ * @brief 중앙 복귀 (MG996R_DO_CENTER) 후 닫기
+ */
+void pan_tilt_close(PanTilt *pt);
+
+#endif /* PAN_TILT_H */
@@ -0,0 +1,249 @@
+// pty 기반 NEO-6M 시뮬레이터 + 지연 측정
+//
+// pty master 에 합성 NMEA (또는 UBX) 를 보레이트 속도로 흘려 보내고
+// slave 를 gps_serial → gps_stream → gps_epoch 로 읽어
+// "epoch 마지막 메시지 체크섬 바이트 송신 → fix 발행" 지연을 측정한다.
+//
+// 빌드: make pty_sim
+// 실행: ./pty_sim [-n epochs] [-b baud] [-r Hz] [-L] [-u]
+//         -L  기존 루프 재현 (read() 후 usleep 100ms)
+//         -u  NMEA 대신 UBX NAV-POSLLH/SOL/VELNED 송신
+//       ./pty_sim -x [-b baud] [-r Hz]
+//         -x  pty 경로만 출력하고 계속 송신 (./neo_6m2 /dev/pts/N 등으로 확인)
+
+#define _GNU_SOURCE             // posix_openpt, ptsname_r
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "nmea.h"
+#include "nmea_msg.h"
+#include "gps_synth.h"
+#include "gps_epoch.h"
+#include "gps_serial.h"
+#include "gps_stream.h"
+
+#define SLICE_NS    1000000LL       // 송신 단위 시간 (1ms 분량씩 write)
+
+typedef struct {
+    int       master;
+    int       epochs;               // 0: 무한
+    int       baud;
+    int       rate_hz;
+    int       ubx;                  // UBX 송신
+    int64_t  *last_tx_ns;           // epoch 별 마지막 체크섬 바이트 송신 시각
+    volatile int done;
+} Writer;
+
+typedef struct {
+    int       rate_hz;
+    int       epochs;
+    int64_t  *pub_ns;               // epoch 별 발행 시각
+    int64_t  *rx_ns;                // epoch 별 마지막 문장 수신 시각
+    long      fixes;
+} Reader;
+
+// ─────────────────────────────────────────────
+//  송신 스레드: 보레이트 속도로 1ms 분량씩 write
+// ─────────────────────────────────────────────
+static void sleep_until(int64_t t_ns)
+{
+    struct timespec ts = { .tv_sec = t_ns / 1000000000LL, .tv_nsec = t_ns % 1000000000LL };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+        ;
+}
+
+static void *writer_main(void *arg)
+{
+    Writer  *w         = arg;
+    int64_t  period    = 1000000000LL / w->rate_hz;
+    int64_t  byte_ns   = 10000000000LL / w->baud;           // 8N1 = 10 bit
+    size_t   per_slice = (size_t)(SLICE_NS / byte_ns) + 1;
+    int64_t  t0        = gps_now_ns() + 100000000LL;        // reader 준비 100ms
+    char     buf[NMEA_SYNTH_EPOCH_MAX];
+
+    for (int i = 0; w->epochs == 0 || i < w->epochs; i++) {
+        size_t  n, ck;
+        if (w->ubx) {
+            n  = ubx_synth_epoch((uint8_t *)buf, i, w->rate_hz, UBX_SYNTH_NEO6);
+            ck = n - 1;                         // 마지막 프레임의 CK_B
+        } else {
+            n  = nmea_synth_epoch(buf, i, w->rate_hz);
+            ck = n - 3;                         // 마지막 "*hh\r\n" 의 두 번째 h
+        }
+        int64_t start = t0 + (int64_t)i * period;
+
+        for (size_t off = 0; off < n; off += per_slice) {
+            size_t k = (n - off < per_slice) ? n - off : per_slice;
+            sleep_until(start + (int64_t)off * byte_ns);
+            if (off <= ck && ck < off + k && w->last_tx_ns)
+                w->last_tx_ns[i] = gps_now_ns();
+            if (write(w->master, buf + off, k) != (ssize_t)k) {
+                perror("pty write");
+                w->done = 1;
+                return NULL;
+            }
+        }
+    }
+    w->done = 1;
+    return NULL;
+}
+
+// ─────────────────────────────────────────────
+//  수신 측
+// ─────────────────────────────────────────────
+static void on_fix(const GpsFix *f, void *user)
+{
+    Reader *r = user;
+    int     i;
+
+    if (!(f->valid & GPS_V_TIME)) return;
+    i = nmea_synth_index(f->time_ms, r->rate_hz);
+    if (i < 0 || i >= r->epochs) return;
+
+    r->pub_ns[i] = f->pub_ns;
+    r->rx_ns[i]  = f->end_ns;
+    r->fixes++;
+}
+
+static void report(const char *name, int64_t *v, int n)
+{
+    if (n == 0) { printf("%-22s (no samples)\n", name); return; }
+
+    int64_t sum = 0;
+    qsort(v, (size_t)n, sizeof(int64_t), synth_cmp_i64);
+    for (int i = 0; i < n; i++) sum += v[i];
+
+    printf("%-22s mean %8.3f  p50 %8.3f  p99 %8.3f  max %8.3f ms\n", name,
+           sum / 1e6 / n, v[n / 2] / 1e6, v[(n * 99) / 100] / 1e6, v[n - 1] / 1e6);
+}
+
+static int open_pty(char *path, size_t len)
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0) return -1;
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0 || ptsname_r(fd, path, len) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char **argv)
+{
+    int  epochs = 60, baud = GPS_SERIAL_BAUD, rate_hz = 1;
+    int  legacy = 0, expose = 0, ubx = 0, opt;
+    char path[64];
+
+    while ((opt = getopt(argc, argv, "n:b:r:Lxu")) != -1) {
+        switch (opt) {
+            case 'n': epochs  = atoi(optarg); break;
+            case 'b': baud    = atoi(optarg); break;
+            case 'r': rate_hz = atoi(optarg); break;
+            case 'L': legacy  = 1;            break;
+            case 'x': expose  = 1;            break;
+            case 'u': ubx     = 1;            break;
+            default:
+                fprintf(stderr, "usage: %s [-n epochs] [-b baud] [-r Hz] [-L] [-x] [-u]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (epochs <= 0 || rate_hz <= 0 || rate_hz > 20 || !gps_serial_speed(baud)) {
+        fprintf(stderr, "invalid epochs/baud/rate\n");
+        return 1;
+    }
+
+    Writer w = { .baud = baud, .rate_hz = rate_hz, .ubx = ubx, .epochs = expose ? 0 : epochs };
+    w.master = open_pty(path, sizeof(path));
+    if (w.master < 0) { perror("pty"); return 1; }
+
+    // slave 를 실제 UART 와 같은 경로로 연다 (raw 모드, epoll)
+    GpsSerial ser;
+    if (!expose && gps_serial_open(&ser, path, baud, GPS_SERIAL_LOW_LATENCY) < 0) {
+        perror(path);
+        return 1;
+    }
+
+    if (expose) {
+        // 외부 도구가 slave 를 열 때까지 송신은 버퍼에 쌓이지 않도록 바로 시작
+        printf("%s  (%d baud, %d Hz, %s)\n", path, baud, rate_hz, ubx ? "UBX" : "NMEA");
+        fflush(stdout);
+        writer_main(&w);
+        return 0;
+    }
+
+    Reader r = { .rate_hz = rate_hz, .epochs = epochs };
+    w.last_tx_ns = calloc((size_t)epochs, sizeof(int64_t));
+    r.pub_ns     = calloc((size_t)epochs, sizeof(int64_t));
+    r.rx_ns      = calloc((size_t)epochs, sizeof(int64_t));
+    if (!w.last_tx_ns || !r.pub_ns || !r.rx_ns) { perror("calloc"); return 1; }
+
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+    gps_epoch_init(&ep, on_fix, &r);
+    nmea_dispatch_init(&disp);
+    gps_epoch_attach(&ep, &disp);
+    gps_stream_init(&stream, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+
+    printf("%s: %d epochs, %s, %d baud, %d Hz, %s loop, ASYNC_LOW_LATENCY %s\n",
+           path, epochs, ubx ? "UBX" : "NMEA", baud, rate_hz,
+           legacy ? "read+usleep(100ms)" : "epoll",
+           ser.low_latency ? "on" : "unsupported");
+
+    pthread_t th;
+    pthread_create(&th, NULL, writer_main, &w);
+
+    char buf[512];
+    for (;;) {
+        int64_t rx_ns;
+        int     n;
+
+        // 0 반환 = GPS_EPOCH_TIMEOUT_MS 무수신 → timeout 판정
+        n = gps_serial_read(&ser, buf, sizeof(buf), GPS_EPOCH_TIMEOUT_MS, &rx_ns);
+        if (n < 0) { perror("GPS read"); break; }
+        if (n > 0) {
+            gps_stream_feed(&stream, buf, n, rx_ns);
+            if (legacy) usleep(100000);
+        } else {
+            gps_epoch_poll(&ep, ser.last_rx_ns, gps_now_ns());
+        }
+
+        // 송신 종료 후 마지막 epoch 가 timeout 으로 발행될 때까지
+        if (w.done && n == 0 && !ep.open) break;
+    }
+    pthread_join(th, NULL);
+
+    // 지연 집계: 송신 → 수신 청크, 송신 → 발행
+    int64_t *wire  = malloc((size_t)epochs * sizeof(int64_t));
+    int64_t *total = malloc((size_t)epochs * sizeof(int64_t));
+    int      nw = 0, nt = 0;
+    for (int i = 0; i < epochs; i++) {
+        if (!w.last_tx_ns[i] || !r.pub_ns[i]) continue;
+        if (r.rx_ns[i] >= w.last_tx_ns[i]) wire[nw++] = r.rx_ns[i] - w.last_tx_ns[i];
+        total[nt++] = r.pub_ns[i] - w.last_tx_ns[i];
+    }
+
+    printf("fixes %ld/%d  reads %llu (%.1f B/read)  [order %llu timeout %llu time %llu]\n",
+           r.fixes, epochs, (unsigned long long)ser.reads,
+           ser.reads ? (double)ser.bytes / ser.reads : 0.0,
+           (unsigned long long)ep.stats.by[GPS_EPOCH_BY_ORDER],
+           (unsigned long long)ep.stats.by[GPS_EPOCH_BY_TIMEOUT],
+           (unsigned long long)ep.stats.by[GPS_EPOCH_BY_TIME]);
+    report("last ck byte -> rx", wire, nw);
+    report("last ck byte -> fix", total, nt);
+
+    gps_serial_close(&ser);
+    close(w.master);
+    free(wire);
+    free(total);
+    free(w.last_tx_ns);
+    free(r.pub_ns);
+    free(r.rx_ns);
+    return 0;
+}
@@ -0,0 +1,261 @@
+// 기록 / 재생 벤치마크 (합성 세션)
+//
+// 1. 기록: 합성 NMEA 를 9600 baud 청크 (가상 수신 시각) 로 나눠 gps_rec 에 쓰고
+//    epoch 조립기 fix 도 함께 기록 (gps_record 와 같은 순서), write() 횟수 / 파일 크기
+// 2. 재생 (mmap): 레코드 순회만, 기록된 fix 로 필터만, 원시 청크 재파싱 + 필터
+//    같은 바이트를 텍스트 파일로 fread 해 파싱하는 기존 방식 (kf_bench -f) 과 비교
+// 3. 색인: 임의 시각 seek, 꼬리가 잘린 파일 (전원 차단) 복구
+//
+// 실행: ./rec_bench [-H hours] [-r Hz] [-o dir]
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "nmea_msg.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_rec.h"
+#include "gps_stream.h"
+#include "gps_synth.h"
+#include "win_stat.h"
+
+#define BAUD_BYTE_NS    (10000000000LL / 9600)      // 8N1
+#define CHUNK           32                          // epoll 1회에 읽히는 바이트 (pty_sim 측정 기준)
+#define WINDOW          20
+
+static int64_t vnow;
+
+static int64_t vclock(void)
+{
+    return vnow;
+}
+
+// ─────────────────────────────────────────────
+//  파이프라인 (gps_replay 와 같은 필터 구성)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsRecWriter *rec;          // 기록 단계: fix 도 기록
+    WinPos        win;
+    GpsKf         kf;
+    long          fixes;
+} Sink;
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Sink *s = user;
+
+    s->fixes++;
+    if (s->rec) {
+        gps_rec_write_fix(s->rec, f);
+        return;
+    }
+    if (!(f->valid & GPS_V_POS)) return;
+    win_pos_push(&s->win, nmea_e7_to_deg(f->lat), nmea_e7_to_deg(f->lon));
+    gps_kf_update_fix(&s->kf, f);
+}
+
+typedef struct {
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     ep;
+} Pipe;
+
+static void pipe_init(Pipe *p, Sink *s, int virtual_clock)
+{
+    gps_epoch_init(&p->ep, on_fix, s);
+    if (virtual_clock) gps_epoch_set_clock(&p->ep, vclock);
+    else               gps_epoch_set_policy(&p->ep, 0, GPS_EPOCH_LEARN);
+    nmea_dispatch_init(&p->disp);
+    gps_epoch_attach(&p->ep, &p->disp);
+    gps_stream_init(&p->stream, nmea_dispatch_sentence, &p->disp, gps_epoch_on_ubx, &p->ep);
+}
+
+static void sink_init(Sink *s)
+{
+    memset(s, 0, sizeof(Sink));
+    win_pos_init(&s->win, WINDOW);
+    gps_kf_init(&s->kf, 0.0);
+}
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    double      hours = 4.0;
+    int         rate_hz = 1, opt;
+    const char *dir = "/tmp";
+
+    while ((opt = getopt(argc, argv, "H:r:o:")) != -1) {
+        switch (opt) {
+            case 'H': hours   = atof(optarg); break;
+            case 'r': rate_hz = atoi(optarg); break;
+            case 'o': dir     = optarg;       break;
+            default:
+                fprintf(stderr, "usage: %s [-H hours] [-r Hz] [-o dir]\n", argv[0]);
+                return 1;
+        }
+    }
+    int epochs = (int)(hours * 3600 * rate_hz);
+    if (epochs < 1 || rate_hz < 1 || rate_hz > 20) {
+        fprintf(stderr, "invalid hours/rate\n");
+        return 1;
+    }
+
+    char rec_path[256], txt_path[256], cut_path[256];
+    snprintf(rec_path, sizeof(rec_path), "%s/rec_bench.rec", dir);
+    snprintf(txt_path, sizeof(txt_path), "%s/rec_bench.nmea", dir);
+    snprintf(cut_path, sizeof(cut_path), "%s/rec_bench_cut.rec", dir);
+
+    // ── 1. 기록 ──
+    GpsRecWriter w;
+    FILE        *txt = fopen(txt_path, "wb");
+    if (!txt || gps_rec_create(&w, rec_path, 9600, "synth") < 0) {
+        perror(dir);
+        return 1;
+    }
+    Sink sink = { .rec = &w };
+    Pipe pp;
+    pipe_init(&pp, &sink, 1);
+
+    char    buf[NMEA_SYNTH_EPOCH_MAX];
+    int64_t period = 1000000000LL / rate_hz, last_rx = 0, timeout = GPS_EPOCH_TIMEOUT_MS * 1000000LL;
+    double  t = now_sec();
+    for (int i = 0; i < epochs; i++) {
+        int64_t start = (int64_t)i * period + 1000000;      // 시각 펄스 후 1ms
+        size_t  n     = nmea_synth_epoch(buf, i, rate_hz);
+
+        fwrite(buf, 1, n, txt);
+        if (last_rx && start - last_rx > timeout) {
+            vnow = last_rx + timeout;
+            gps_epoch_poll(&pp.ep, last_rx, vnow);
+        }
+        for (size_t off = 0; off < n; off += CHUNK) {
+            size_t k = (n - off < CHUNK) ? n - off : CHUNK;
+            vnow = start + (int64_t)(off + k) * BAUD_BYTE_NS;
+            gps_rec_write_raw(&w, buf + off, k, vnow);
+            gps_stream_feed(&pp.stream, buf + off, k, vnow);
+            last_rx = vnow;
+        }
+    }
+    gps_epoch_flush(&pp.ep);
+    fclose(txt);
+    if (gps_rec_finish(&w) < 0) { perror("finish"); return 1; }
+    t = now_sec() - t;
+
+    printf("%d epochs (%.1f h at %d Hz), %llu raw bytes -> %.1f MB file (%.2fx), "
+           "%llu writes (%.1f / min), %.0f MB/s\n",
+           epochs, hours, rate_hz, (unsigned long long)w.stats.raw_bytes,
+           w.stats.file_bytes / 1e6, (double)w.stats.file_bytes / w.stats.raw_bytes,
+           (unsigned long long)w.stats.writes, w.stats.writes / (hours * 60.0),
+           w.stats.file_bytes / 1e6 / t);
+
+    // ── 2. 재생 ──
+    GpsRecReader rd;
+    GpsRecord    rec;
+    t = now_sec();
+    if (gps_rec_open(&rd, rec_path) < 0) { perror(rec_path); return 1; }
+    printf("open (tail index)        %8.3f ms, %zu blocks\n", (now_sec() - t) * 1e3, rd.blocks);
+
+    uint64_t cnt = 0;
+    t = now_sec();
+    while (gps_rec_next(&rd, &rec))
+        cnt++;
+    t = now_sec() - t;
+    printf("iterate records          %8.3f s  %7.2f GB/s  (%llu records)\n",
+           t, rd.size / 1e9 / t, (unsigned long long)cnt);
+
+    double realtime = epochs / (double)rate_hz;
+    Sink   s;
+    sink_init(&s);
+    gps_rec_rewind(&rd);
+    t = now_sec();
+    while (gps_rec_next(&rd, &rec)) {
+        const GpsFix *f = gps_rec_fix(&rd, &rec);
+        if (f) on_fix(f, &s);
+    }
+    t = now_sec() - t;
+    printf("fix records + filters    %8.3f s  %9.0f epochs/s  x%.0f realtime\n",
+           t, s.fixes / t, realtime / t);
+    win_pos_free(&s.win);
+
+    sink_init(&s);
+    pipe_init(&pp, &s, 1);
+    gps_rec_rewind(&rd);
+    last_rx = 0;
+    t = now_sec();
+    while (gps_rec_next(&rd, &rec)) {
+        if (rec.type != GPS_REC_RAW) continue;
+        if (last_rx && rec.t_ns - last_rx > timeout) {
+            vnow = last_rx + timeout;
+            gps_epoch_poll(&pp.ep, last_rx, vnow);
+        }
+        vnow = rec.t_ns;
+        gps_stream_feed(&pp.stream, rec.data, rec.len, rec.t_ns);
+        last_rx = rec.t_ns;
+    }
+    gps_epoch_flush(&pp.ep);
+    t = now_sec() - t;
+    printf("raw reparse + filters    %8.3f s  %9.0f epochs/s  x%.0f realtime  (%ld fixes)\n",
+           t, s.fixes / t, realtime / t, s.fixes);
+    win_pos_free(&s.win);
+
+    // 기존: 텍스트 캡처를 fread 로 (수신 시각 없음, timeout 판정 불가)
+    sink_init(&s);
+    pipe_init(&pp, &s, 0);
+    txt = fopen(txt_path, "rb");
+    char   rbuf[4096];
+    size_t n;
+    t = now_sec();
+    while ((n = fread(rbuf, 1, sizeof(rbuf), txt)) > 0)
+        gps_stream_feed(&pp.stream, rbuf, n, 0);
+    gps_epoch_flush(&pp.ep);
+    t = now_sec() - t;
+    fclose(txt);
+    printf("text fread + filters     %8.3f s  %9.0f epochs/s  x%.0f realtime  (%ld fixes)\n",
+           t, s.fixes / t, realtime / t, s.fixes);
+    win_pos_free(&s.win);
+
+    // ── 3. 색인 ──
+    int64_t t0 = rd.index[0].first_ns, span = rd.index[rd.blocks - 1].last_ns - t0;
+    uint64_t seed = 1;
+    int      seeks = 100000;
+    t = now_sec();
+    for (int i = 0; i < seeks; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        gps_rec_seek(&rd, t0 + (int64_t)((seed >> 11) % (uint64_t)span));
+        gps_rec_next(&rd, &rec);
+    }
+    t = now_sec() - t;
+    printf("seek + first record      %8.1f ns\n", t * 1e9 / seeks);
+    size_t full_blocks = rd.blocks;
+    gps_rec_close(&rd);
+
+    // 꼬리 + 마지막 블록 일부가 없는 파일 (기록 중 전원 차단)
+    FILE *src = fopen(rec_path, "rb"), *dst = fopen(cut_path, "wb");
+    if (!src || !dst) { perror("copy"); return 1; }
+    size_t total = 0, keep = (size_t)(w.stats.file_bytes - full_blocks * sizeof(GpsRecIndex)
+                                      - sizeof(GpsRecTail) - 100);
+    while ((n = fread(rbuf, 1, sizeof(rbuf), src)) > 0 && total < keep) {
+        size_t k = (total + n > keep) ? keep - total : n;
+        fwrite(rbuf, 1, k, dst);
+        total += k;
+    }
+    fclose(src);
+    fclose(dst);
+    t = now_sec();
+    if (gps_rec_open(&rd, cut_path) < 0) { perror(cut_path); return 1; }
+    t = now_sec() - t;
+    printf("open truncated (scan)    %8.3f ms, %zu / %zu blocks recovered, %llu fixes\n",
+           t * 1e3, rd.blocks, full_blocks, (unsigned long long)rd.fixes);
+    gps_rec_close(&rd);
+
+    unlink(rec_path);
+    unlink(txt_path);
+    unlink(cut_path);
+    return 0;
+}
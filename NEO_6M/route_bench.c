@@ -0,0 +1,263 @@
+// waypoint 경로 추종 (gps_route) 벤치마크
+//
+// 4 km × 4 km 안을 돌아다니는 임의 경로 (구간 20~80 m) 를 waypoint 10 ~ 100000 개로
+// 만들고, 경로를 따라 가는 fix (Gauss-Markov 위치 오차 σ 1.5 m) 를 넣는다.
+//
+// 비교: 구간 기하를 미리 계산한 gps_route (fix 당 곱셈·덧셈 + sqrt) 와
+//       fix 마다 구면 공식으로 계산하는 방식 (haversine 거리 / 방위, 구면 교차 오차,
+//       남은 구간 haversine 합 → 남은 waypoint 수에 비례)
+// 보고: ns/fix, waypoint 전환 수, Vincenty 대비 목표 거리 / 남은 거리 최대 차
+//
+// 실행: ./route_bench [-w waypoints] [-f max_fixes]   (-w 생략 시 10 ~ 100000)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_fix.h"
+#include "gps_route.h"
+#include "gps_synth.h"
+
+#define LAT0            37.5665
+#define LON0            126.9780
+#define HALF_AREA       2000.0      // 경로는 ±2 km 안에서 반사
+#define FIX_STEP        0.5         // fix 간격 (m, 5 m/s 10Hz), 경로가 길면 늘림
+#define NOISE_SIGMA     1.5
+#define NOISE_TAU       60.0        // fix 단위 상관 길이
+#define NAIVE_BUDGET    50000000.0  // 구면 방식 (fix × 남은 구간) 연산 상한
+#define EARTH_R         6371008.8
+#define DEG             (M_PI / 180.0)
+
+typedef struct {
+    double *lat, *lon;              // waypoint
+    double *e, *n;
+    int     count;
+} Route;
+
+static double now_sec(void)
+{
+    return gps_now_ns() / 1e9;
+}
+
+static void make_route(Route *rt, const GeoLtp *ltp, int count)
+{
+    double e = 0.0, n = 0.0, hdg = synth_urand() * 2.0 * M_PI;
+
+    rt->count = count;
+    rt->lat   = malloc(count * sizeof(double));
+    rt->lon   = malloc(count * sizeof(double));
+    rt->e     = malloc(count * sizeof(double));
+    rt->n     = malloc(count * sizeof(double));
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            double len = 20.0 + 60.0 * synth_urand();
+            hdg += (synth_urand() - 0.5) * (2.0 * M_PI / 3.0);
+            e += len * sin(hdg);
+            n += len * cos(hdg);
+            if (fabs(e) > HALF_AREA) { e = copysign(2 * HALF_AREA, e) - e; hdg = -hdg; }
+            if (fabs(n) > HALF_AREA) { n = copysign(2 * HALF_AREA, n) - n; hdg = M_PI - hdg; }
+        }
+        rt->e[i] = e;
+        rt->n[i] = n;
+        geo_ltp_inv(ltp, e, n, &rt->lat[i], &rt->lon[i]);
+    }
+}
+
+/**
+ * @brief 경로를 따라 가는 fix (위치 오차는 Gauss-Markov)
+ */
+static size_t make_fixes(const Route *rt, const GeoLtp *ltp, size_t max_fixes,
+                         double **lat, double **lon)
+{
+    double total = 0.0;
+    for (int i = 1; i < rt->count; i++)
+        total += hypot(rt->e[i] - rt->e[i - 1], rt->n[i] - rt->n[i - 1]);
+
+    double step = fmax(FIX_STEP, total / max_fixes);
+    size_t nfix = (size_t)(total / step) + 1;
+    double a = exp(-1.0 / NOISE_TAU), b = NOISE_SIGMA * sqrt(1.0 - a * a);
+    double ne = NOISE_SIGMA * synth_grand(), nn = NOISE_SIGMA * synth_grand(), s0 = 0.0;
+    int    seg = 1;
+
+    *lat = malloc(nfix * sizeof(double));
+    *lon = malloc(nfix * sizeof(double));
+    for (size_t k = 0; k < nfix; k++) {
+        double s = k * step, len;
+        while (seg < rt->count - 1 &&
+               s > s0 + (len = hypot(rt->e[seg] - rt->e[seg - 1], rt->n[seg] - rt->n[seg - 1]))) {
+            s0 += len;
+            seg++;
+        }
+        len = hypot(rt->e[seg] - rt->e[seg - 1], rt->n[seg] - rt->n[seg - 1]);
+        double t = fmin(1.0, (s - s0) / len);
+        ne = a * ne + b * synth_grand();
+        nn = a * nn + b * synth_grand();
+        geo_ltp_inv(ltp, rt->e[seg - 1] + t * (rt->e[seg] - rt->e[seg - 1]) + ne,
+                    rt->n[seg - 1] + t * (rt->n[seg] - rt->n[seg - 1]) + nn, &(*lat)[k], &(*lon)[k]);
+    }
+    return nfix;
+}
+
+// ─────────────────────────────────────────────
+//  구면 방식 (fix 마다 삼각함수, 남은 거리는 구간 합)
+// ─────────────────────────────────────────────
+typedef struct {
+    int      cur;
+    uint64_t switches;
+    double   sink;
+} Naive;
+
+static void naive_update(Naive *nv, const Route *rt, double lat, double lon)
+{
+    for (;;) {
+        int    a = nv->cur, b = nv->cur + 1;
+        double d_ap  = geo_haversine(rt->lat[a], rt->lon[a], lat, lon) / EARTH_R;
+        double brg_ab = geo_bearing(rt->lat[a], rt->lon[a], rt->lat[b], rt->lon[b]) * DEG;
+        double brg_ap = geo_bearing(rt->lat[a], rt->lon[a], lat, lon) * DEG;
+        double xt    = asin(sin(d_ap) * sin(brg_ap - brg_ab));
+        double along = acos(fmin(1.0, cos(d_ap) / cos(xt))) * EARTH_R;
+        if (cos(brg_ap - brg_ab) < 0.0) along = -along;
+        double len   = geo_haversine(rt->lat[a], rt->lon[a], rt->lat[b], rt->lon[b]);
+        double dist  = geo_haversine(lat, lon, rt->lat[b], rt->lon[b]);
+        double togo  = dist;
+        for (int i = b + 1; i < rt->count; i++)
+            togo += geo_haversine(rt->lat[i - 1], rt->lon[i - 1], rt->lat[i], rt->lon[i]);
+
+        // 전환: 도착 반경 또는 waypoint 에서 두 구간 방위 이등분선을 넘음
+        int passed = along >= len;
+        if (b + 1 < rt->count) {
+            double brg_bc = geo_bearing(rt->lat[b], rt->lon[b], rt->lat[b + 1], rt->lon[b + 1]) * DEG;
+            double bis    = atan2(sin(brg_ab) + sin(brg_bc), cos(brg_ab) + cos(brg_bc));
+            passed = cos(geo_bearing(rt->lat[b], rt->lon[b], lat, lon) * DEG - bis) >= 0.0;
+        }
+        nv->sink += xt * EARTH_R + togo + along;
+        if ((dist <= GPS_ROUTE_ARRIVE_M || passed) && b + 1 < rt->count) {
+            nv->cur++;
+            nv->switches++;
+            continue;
+        }
+        break;
+    }
+}
+
+// ─────────────────────────────────────────────
+//  정확도 (Vincenty 기준)
+// ─────────────────────────────────────────────
+typedef struct {
+    double max_dwp, max_togo;
+    double *rest;                   // waypoint i → 끝 Vincenty 길이
+} Acc;
+
+static void check(Acc *ac, const Route *rt, const GpsRouteState *s, double lat, double lon)
+{
+    double d;
+    int    b = (int)s->seg + 1;
+
+    if (geo_vincenty(lat, lon, rt->lat[b], rt->lon[b], &d, NULL, NULL) < 0) return;
+    ac->max_dwp  = fmax(ac->max_dwp, fabs(s->dist_wp - d));
+    ac->max_togo = fmax(ac->max_togo, fabs(s->dist_to_go - (d + ac->rest[b])));
+}
+
+static void run(int count, size_t max_fixes)
+{
+    GeoLtp ltp;
+    Route  rt;
+    double *lat, *lon;
+
+    geo_ltp_init(&ltp, LAT0, LON0, 0.0);
+    make_route(&rt, &ltp, count);
+    size_t nfix = make_fixes(&rt, &ltp, max_fixes, &lat, &lon);
+
+    GpsRoute r;
+    gps_route_init(&r, NULL, NULL);
+    double t0 = now_sec();
+    for (int i = 0; i < count; i++)
+        if (gps_route_add(&r, rt.lat[i], rt.lon[i], 0.0) < 0) { perror("gps_route_add"); exit(1); }
+    double t_add = now_sec() - t0;
+
+    // gps_route
+    GpsRouteState s;
+    double        sink = 0.0;
+    t0 = now_sec();
+    for (size_t k = 0; k < nfix; k++) {
+        gps_route_update(&r, lat[k], lon[k], &s);
+        sink += s.xte + s.dist_to_go;
+    }
+    double t_route = now_sec() - t0;
+
+    // 구면 방식 (연산 상한 안의 앞부분)
+    size_t nnaive = (size_t)fmin((double)nfix, fmax(1000.0, NAIVE_BUDGET / count));
+    Naive  nv = {0};
+    t0 = now_sec();
+    for (size_t k = 0; k < nnaive; k++) naive_update(&nv, &rt, lat[k], lon[k]);
+    double t_naive = now_sec() - t0;
+
+    // 정확도: 앞부분을 다시 돌리며 Vincenty 와 비교
+    Acc ac = {0};
+    ac.rest = calloc((size_t)count, sizeof(double));
+    for (int i = count - 2; i >= 0; i--) {
+        double d = 0.0;
+        geo_vincenty(rt.lat[i], rt.lon[i], rt.lat[i + 1], rt.lon[i + 1], &d, NULL, NULL);
+        ac.rest[i] = ac.rest[i + 1] + d;
+    }
+    uint64_t switches = r.switches;
+    gps_route_restart(&r);
+    size_t ncheck = nfix < 200000 ? nfix : 200000;
+    for (size_t k = 0; k < ncheck; k++) {
+        gps_route_update(&r, lat[k], lon[k], &s);
+        check(&ac, &rt, &s, lat[k], lon[k]);
+    }
+
+    printf("%7d  %8.1f km  %8zu  %8.0f ns  %9.1f ns  %9llu  %10.0f ns  %9zu  %9llu  %7.3f  %7.3f\n",
+           count, gps_route_length(&r) / 1e3, nfix, t_add * 1e9 / count, t_route * 1e9 / nfix,
+           (unsigned long long)switches, t_naive * 1e9 / nnaive, nnaive,
+           (unsigned long long)nv.switches, ac.max_dwp, ac.max_togo);
+    if (sink == 12345.0 || nv.sink == 12345.0) printf("\n");   // 최적화 방지
+
+    gps_route_free(&r);
+    free(ac.rest);
+    free(lat);
+    free(lon);
+    free(rt.lat);
+    free(rt.lon);
+    free(rt.e);
+    free(rt.n);
+}
+
+int main(int argc, char **argv)
+{
+    static const int sizes[] = { 10, 100, 1000, 10000, 100000 };
+    int    only = 0, opt;
+    size_t max_fixes = 2000000;
+
+    while ((opt = getopt(argc, argv, "w:f:")) != -1) {
+        switch (opt) {
+            case 'w': only      = atoi(optarg);         break;
+            case 'f': max_fixes = (size_t)atol(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-w waypoints] [-f max_fixes]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((only != 0 && only < 2) || max_fixes < 1) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    printf("fix every >= %.1f m along the route, position error sigma %.1f m; "
+           "spherical baseline limited to %.0e fix x remaining legs\n\n",
+           FIX_STEP, NOISE_SIGMA, NAIVE_BUDGET);
+    printf("%7s  %11s  %8s  %11s  %12s  %9s  %13s  %9s  %9s  %7s  %7s\n",
+           "wpts", "length", "fixes", "add/wpt", "route/fix", "switches",
+           "sphere/fix", "(fixes)", "switches", "dwp m", "togo m");
+    if (only) {
+        run(only, max_fixes);
+    } else {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) run(sizes[i], max_fixes);
+    }
+    printf("\ndwp / togo m: max |gps_route - Vincenty| for distance to waypoint / to go "
+           "(first 200000 fixes)\n");
+    return 0;
+}
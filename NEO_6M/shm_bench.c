@@ -0,0 +1,315 @@
+// gps_shm 발행자 1 : 구독 프로세스 N 벤치마크
+//
+// 1. 알림 지연: 발행자 (부모) 가 rate Hz 로 발행, 구독자 (fork) 는 futex 로 잠들었다가
+//    깨어나 최신 fix 를 읽는다. 지연 = 읽기 완료 시각 - fix.pub_ns (발행 직전)
+//    놓친 번호, 찢어진 읽기 (내용이 번호와 불일치), 구독자 CPU 시간 / fix
+// 2. 경합: 발행자가 쉬지 않고 발행하는 동안 구독자가 gps_shm_latest 를 반복
+//    ns/read, seqlock 재시도, 찢어진 읽기, ns/publish
+// 3. 경합 없는 읽기 / 구독자 없는 발행 비용
+//
+// 실행: ./shm_bench [-p readers] [-n fixes] [-r Hz] [-t sec]
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "gps_shm.h"
+#include "gps_synth.h"
+
+#define MAX_READERS     64
+
+typedef struct {
+    uint64_t got;               // 받은 fix
+    uint64_t missed;            // 건너뛴 발행 번호
+    uint64_t torn;              // 내용 불일치 (0 이어야 함)
+    uint64_t reads;
+    uint64_t retries;
+    uint64_t lapped;
+    int64_t  cpu_ns;            // 구독 프로세스 CPU 시간 (user + sys)
+    int64_t  busy_ns;           // 경합 단계 읽기 루프 시간
+} ReaderRes;
+
+// 부모 / 자식 공유 (MAP_SHARED | MAP_ANONYMOUS)
+typedef struct {
+    uint32_t  ready;
+    uint32_t  stop;
+    ReaderRes res[MAX_READERS];
+    int64_t   lat[];            // [reader][fix] 알림 지연
+} Shared;
+
+static char    seg_name[64];
+static Shared *sh;
+static int     fixes;
+
+// ─────────────────────────────────────────────
+//  발행 번호로 내용을 정하는 fix (찢어진 읽기 검출용)
+// ─────────────────────────────────────────────
+static void fix_make(GpsFix *f, uint32_t n)
+{
+    memset(f, 0, sizeof(GpsFix));
+    f->valid    = GPS_V_POS | GPS_V_TIME;
+    f->seq      = n;
+    f->rx_ns    = (int64_t)n * 1000003;
+    f->end_ns   = -(int64_t)n;
+    f->time_ms  = (int32_t)(n * 100u);
+    f->lat      = 375000000 + (int32_t)n;
+    f->lon      = 1270000000 - (int32_t)n;
+    f->alt_mm   = (int32_t)(n * 7u);
+    f->num_sats = (int32_t)(n % 13u);
+    f->hdop     = (int32_t)(n * 3u);
+    f->itow_ms  = n ^ 0xA5A5A5A5u;
+    f->s_acc_mmps = ~(int32_t)n;
+}
+
+static int fix_ok(const GpsFix *f, uint32_t n)
+{
+    GpsFix ref;
+
+    fix_make(&ref, n);
+    ref.pub_ns = f->pub_ns;
+    return memcmp(&ref, f, sizeof(GpsFix)) == 0;
+}
+
+static int64_t cpu_ns(void)
+{
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000LL +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000LL;
+}
+
+static void sleep_until(int64_t t_ns)
+{
+    struct timespec ts = { .tv_sec = t_ns / 1000000000LL, .tv_nsec = t_ns % 1000000000LL };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+        ;
+}
+
+static void wait_children(int readers)
+{
+    for (int i = 0; i < readers; i++)
+        wait(NULL);
+}
+
+// ─────────────────────────────────────────────
+//  구독 프로세스
+// ─────────────────────────────────────────────
+static void reader_notify(int id)
+{
+    ReaderRes *r   = &sh->res[id];
+    int64_t   *lat = &sh->lat[(size_t)id * fixes];
+    GpsShm     shm;
+    uint32_t   seen, n;
+    GpsFix     f;
+
+    if (gps_shm_open(&shm, seg_name) < 0) { perror("reader open"); _exit(1); }
+    seen = gps_shm_count(&shm);
+    __atomic_add_fetch(&sh->ready, 1, __ATOMIC_RELEASE);
+
+    int64_t c0 = cpu_ns();
+    while (seen < (uint32_t)fixes) {
+        if (gps_shm_wait(&shm, seen, 2000) <= 0) break;
+        if (gps_shm_latest(&shm, &f, &n) < 0) continue;
+        int64_t now = gps_now_ns();
+
+        lat[n - 1] = now - f.pub_ns;
+        if (!fix_ok(&f, n)) r->torn++;
+        r->missed += n - seen - 1;
+        r->got++;
+        seen = n;
+    }
+    r->cpu_ns  = cpu_ns() - c0;
+    r->reads   = shm.stats.reads;
+    r->retries = shm.stats.retries;
+    r->lapped  = shm.stats.lapped;
+    gps_shm_close(&shm);
+    _exit(0);
+}
+
+static void reader_stress(int id)
+{
+    ReaderRes *r = &sh->res[id];
+    GpsShm     shm;
+    GpsFix     f;
+    uint32_t   n;
+
+    if (gps_shm_open(&shm, seg_name) < 0) { perror("reader open"); _exit(1); }
+    __atomic_add_fetch(&sh->ready, 1, __ATOMIC_RELEASE);
+
+    int64_t t0 = gps_now_ns();
+    while (!__atomic_load_n(&sh->stop, __ATOMIC_ACQUIRE)) {
+        for (int i = 0; i < 1000; i++) {
+            if (gps_shm_latest(&shm, &f, &n) < 0) continue;
+            if (!fix_ok(&f, n)) r->torn++;
+            r->got++;
+        }
+    }
+    r->busy_ns = gps_now_ns() - t0;
+    r->reads   = shm.stats.reads;
+    r->retries = shm.stats.retries;
+    r->lapped  = shm.stats.lapped;
+    gps_shm_close(&shm);
+    _exit(0);
+}
+
+static int spawn(int readers, void (*fn)(int))
+{
+    __atomic_store_n(&sh->ready, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&sh->stop, 0, __ATOMIC_RELEASE);
+    memset(sh->res, 0, sizeof(sh->res));
+
+    for (int i = 0; i < readers; i++) {
+        pid_t pid = fork();
+        if (pid < 0) { perror("fork"); return -1; }
+        if (pid == 0) fn(i);
+    }
+    while (__atomic_load_n(&sh->ready, __ATOMIC_ACQUIRE) < (uint32_t)readers)
+        usleep(1000);
+    return 0;
+}
+
+// ─────────────────────────────────────────────
+//  집계
+// ─────────────────────────────────────────────
+static void report(const char *name, int64_t *v, int n)
+{
+    if (n == 0) { printf("%-14s (no samples)\n", name); return; }
+
+    int64_t sum = 0;
+    qsort(v, (size_t)n, sizeof(int64_t), synth_cmp_i64);
+    for (int i = 0; i < n; i++) sum += v[i];
+
+    printf("%-14s mean %7.1f  p50 %7.1f  p99 %7.1f  max %7.1f us\n", name,
+           sum / 1e3 / n, v[n / 2] / 1e3, v[(n * 99) / 100] / 1e3, v[n - 1] / 1e3);
+}
+
+int main(int argc, char **argv)
+{
+    int readers = 4, rate_hz = 100, secs = 2, opt;
+
+    fixes = 1000;
+    while ((opt = getopt(argc, argv, "p:n:r:t:")) != -1) {
+        switch (opt) {
+            case 'p': readers = atoi(optarg); break;
+            case 'n': fixes   = atoi(optarg); break;
+            case 'r': rate_hz = atoi(optarg); break;
+            case 't': secs    = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-p readers] [-n fixes] [-r Hz] [-t sec]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (readers < 1 || readers > MAX_READERS || fixes < 1 || rate_hz < 1 || secs < 1) {
+        fprintf(stderr, "invalid readers/fixes/rate/sec\n");
+        return 1;
+    }
+
+    size_t lat_bytes = (size_t)readers * fixes * sizeof(int64_t);
+    sh = mmap(NULL, sizeof(Shared) + lat_bytes, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh == MAP_FAILED) { perror("mmap"); return 1; }
+
+    // 실행 중인 gps_daemon 과 겹치지 않는 세그먼트
+    snprintf(seg_name, sizeof(seg_name), "/neo6m_gps_bench.%d", (int)getpid());
+    GpsShm pub;
+    if (gps_shm_create(&pub, seg_name) < 0) { perror("shm"); return 1; }
+
+    printf("readers %d, %d fixes at %d Hz, segment %zu B, %ld CPU\n",
+           readers, fixes, rate_hz, sizeof(GpsShmSeg), sysconf(_SC_NPROCESSORS_ONLN));
+
+    // ── 1. 알림 지연 ──
+    GpsFix  f;
+    int64_t period = 1000000000LL / rate_hz;
+    if (spawn(readers, reader_notify) < 0) return 1;
+    int64_t t0 = gps_now_ns() + 10000000LL;
+    for (int i = 0; i < fixes; i++) {
+        sleep_until(t0 + (int64_t)i * period);
+        fix_make(&f, (uint32_t)i + 1);
+        f.pub_ns = gps_now_ns();
+        gps_shm_publish(&pub, &f);
+    }
+    wait_children(readers);
+
+    printf("\n[notify] futex wake -> read latest\n");
+    int64_t *all = malloc(lat_bytes);
+    int      na  = 0;
+    uint64_t torn = 0;
+    for (int i = 0; i < readers; i++) {
+        ReaderRes *r   = &sh->res[i];
+        int64_t   *lat = &sh->lat[(size_t)i * fixes];
+        int64_t   *v   = &all[na];
+        int        nv  = 0;
+        char       name[32];
+
+        for (int k = 0; k < fixes; k++)
+            if (lat[k] > 0) v[nv++] = lat[k];
+        snprintf(name, sizeof(name), "reader %d", i);
+        report(name, v, nv);
+        printf("%-14s got %llu  missed %llu  torn %llu  retries %llu  cpu %.1f us/fix\n", "",
+               (unsigned long long)r->got, (unsigned long long)r->missed,
+               (unsigned long long)r->torn, (unsigned long long)r->retries,
+               r->got ? r->cpu_ns / 1e3 / r->got : 0.0);
+        na   += nv;
+        torn += r->torn;
+    }
+    report("all readers", all, na);
+    free(all);
+
+    // ── 2. 경합: 쉬지 않고 발행 + 반복 읽기 ──
+    if (spawn(readers, reader_stress) < 0) return 1;
+    uint32_t base = gps_shm_count(&pub);
+    uint64_t pubs = 0;
+    int64_t  t_end = gps_now_ns() + secs * 1000000000LL, t_pub = gps_now_ns();
+    while (gps_now_ns() < t_end) {
+        for (int i = 0; i < 1000; i++) {
+            uint32_t n = base + (uint32_t)pubs + 1;
+            fix_make(&f, n);
+            f.pub_ns = 0;
+            gps_shm_publish(&pub, &f);
+            pubs++;
+        }
+    }
+    t_pub = gps_now_ns() - t_pub;
+    __atomic_store_n(&sh->stop, 1, __ATOMIC_RELEASE);
+    wait_children(readers);
+
+    printf("\n[stress] publish loop vs %d spinning readers, %d s\n", readers, secs);
+    printf("publisher      %.0f ns/publish (%llu)\n", (double)t_pub / pubs, (unsigned long long)pubs);
+    for (int i = 0; i < readers; i++) {
+        ReaderRes *r = &sh->res[i];
+        printf("reader %-7d %.0f ns/read  reads %llu  retries %llu  lapped %llu  torn %llu\n", i,
+               r->got ? (double)r->busy_ns / r->got : 0.0, (unsigned long long)r->got,
+               (unsigned long long)r->retries, (unsigned long long)r->lapped,
+               (unsigned long long)r->torn);
+        torn += r->torn;
+    }
+
+    // ── 3. 경합 없는 비용 ──
+    GpsShm sub;
+    uint32_t n;
+    if (gps_shm_open(&sub, seg_name) < 0) { perror("open"); return 1; }
+    int64_t t = gps_now_ns();
+    for (int i = 0; i < 1000000; i++)
+        gps_shm_latest(&sub, &f, &n);
+    t = gps_now_ns() - t;
+    printf("\n[idle] read %.1f ns", t / 1e6);
+    t = gps_now_ns();
+    for (int i = 0; i < 100000; i++) {
+        fix_make(&f, gps_shm_count(&pub) + 1);
+        gps_shm_publish(&pub, &f);
+    }
+    t = gps_now_ns() - t;
+    printf("  publish %.1f ns (no waiters, incl. FUTEX_WAKE)\n", t / 1e5);
+    printf("torn reads total: %llu\n", (unsigned long long)torn);
+
+    gps_shm_close(&sub);
+    gps_shm_close(&pub);
+    shm_unlink(seg_name);
+    munmap(sh, sizeof(Shared) + lat_bytes);
+    return torn ? 1 : 0;
+}
@@ -0,0 +1,309 @@
+// 이동 궤적 (gps_trail) 벤치마크
+//
+// 5 Hz fix 하루치 (432000 개) 를 3 km × 3 km 안을 돌아다니는 차량 (정지 / 보행 / 주행,
+// 같은 길 되돌아가기 포함, Gauss-Markov 위치 오차 σ 1 m) 으로 만들어 궤적에 넣는다.
+//
+// 보고: 저장 점 수, 메모리, 1 / 6 / 24 시간 시점의 추가 지연 (그때까지 모든 add,
+//       tree 나눠 만들기 한 걸음 포함, 솎기가 일어난 add 는 따로 최대만) 과
+//       질의 지연 (가장 가까운 점, 60 초 이전 점만, 반경 20 m)
+//       p50 / p99 / p99.9 / max 와 전수 검사 대비 불일치 수,
+//       귀환 경로 (고리 생략 없음 / 10 m / 50 m) waypoint 수, 길이, 계산 시간
+// -m 으로 점 수 상한을 줄이면 솎기 (간격 두 배) 동작과 그때의 질의 지연을 본다.
+//
+// 실행: ./trail_bench [-m max_points] [-d min_dist_m] [-H hours] [-q queries]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_fix.h"
+#include "gps_trail.h"
+#include "gps_synth.h"
+
+#define LAT0            37.5665
+#define LON0            126.9780
+#define RATE_HZ         5
+#define HALF_AREA       1500.0
+#define NOISE_SIGMA     1.0
+#define NOISE_TAU       60.0        // s
+#define RADIUS_M        20.0
+#define AGE_S           60.0
+#define MAX_HITS        4096
+
+// ─────────────────────────────────────────────
+//  합성 주행: 구간마다 정지 / 보행 / 주행, 가끔 지나온 길을 되돌아감
+// ─────────────────────────────────────────────
+typedef struct {
+    double e, n, hdg, speed;
+    double left;                    // 현재 구간 남은 시간 (s)
+    double gm_e, gm_n;
+    double *hist_e, *hist_n;        // 참 위치 기록 (되돌아가기)
+    size_t  nhist, back;            // back > 0: 기록을 거꾸로 따라가는 중
+} Drive;
+
+static void drive_step(Drive *d, double dt)
+{
+    if (d->left <= 0.0) {
+        double u = synth_urand();
+        d->left = 30.0 + 600.0 * synth_urand();
+        d->back = 0;
+        if (u < 0.15)       d->speed = 0.0;
+        else if (u < 0.35)  d->speed = 1.4;
+        else if (u < 0.85)  d->speed = 4.0 + 8.0 * synth_urand();
+        else if (d->nhist > 1000) {                 // 지나온 길로 되돌아가기
+            d->back  = d->nhist - 1;
+            d->speed = 0.0;
+        }
+    }
+    d->left -= dt;
+
+    if (d->back > 0) {
+        d->back -= (d->back > 3) ? 3 : d->back;     // 기록을 빠르게 역행 (같은 길)
+        d->e = d->hist_e[d->back];
+        d->n = d->hist_n[d->back];
+    } else {
+        d->hdg += 0.3 * synth_grand() * dt;
+        d->e   += d->speed * sin(d->hdg) * dt;
+        d->n   += d->speed * cos(d->hdg) * dt;
+        if (fabs(d->e) > HALF_AREA) { d->hdg = -d->hdg;     d->e = copysign(HALF_AREA, d->e); }
+        if (fabs(d->n) > HALF_AREA) { d->hdg = M_PI - d->hdg; d->n = copysign(HALF_AREA, d->n); }
+    }
+    d->hist_e[d->nhist] = d->e;
+    d->hist_n[d->nhist] = d->n;
+    d->nhist++;
+
+    double a = exp(-dt / NOISE_TAU);
+    d->gm_e = a * d->gm_e + sqrt(1 - a * a) * NOISE_SIGMA * synth_grand();
+    d->gm_n = a * d->gm_n + sqrt(1 - a * a) * NOISE_SIGMA * synth_grand();
+}
+
+// ─────────────────────────────────────────────
+//  전수 검사 (저장 점 직접)
+// ─────────────────────────────────────────────
+static double brute_nearest(const GpsTrail *t, double e, double n, uint32_t limit)
+{
+    double best = INFINITY;
+    for (uint32_t i = 0; i < limit; i++) {
+        double de = t->pt[i].e - e, dn = t->pt[i].n - n, d2 = de * de + dn * dn;
+        if (d2 < best) best = d2;
+    }
+    return sqrt(best);
+}
+
+static size_t brute_radius(const GpsTrail *t, double e, double n, double r)
+{
+    size_t c = 0;
+    for (size_t i = 0; i < t->count; i++) {
+        double de = t->pt[i].e - e, dn = t->pt[i].n - n;
+        if (de * de + dn * dn <= r * r) c++;
+    }
+    return c;
+}
+
+static uint32_t brute_limit(const GpsTrail *t, int64_t before_ns)
+{
+    uint32_t i = 0;
+    int64_t  rel = (before_ns - t->t0_ns) / 1000000;
+    while (i < t->count && (int64_t)t->pt[i].t_ms < rel) i++;
+    return i;
+}
+
+typedef struct {
+    int64_t *ns;
+    size_t   n;
+} Lat;
+
+static void lat_line(const char *name, Lat *l)
+{
+    qsort(l->ns, l->n, sizeof(int64_t), synth_cmp_i64);
+    printf("    %-22s p50 %7.2f us  p99 %7.2f us  p99.9 %7.2f us  max %7.2f us", name,
+           l->ns[l->n / 2] / 1e3, l->ns[(size_t)(l->n * 0.99)] / 1e3, l->ns[(size_t)(l->n * 0.999)] / 1e3,
+           l->ns[l->n - 1] / 1e3);
+}
+
+static void lat_print(const char *name, Lat *l, size_t bad)
+{
+    lat_line(name, l);
+    printf("  mismatch %zu\n", bad);
+}
+
+/**
+ * @brief 질의 지연 / 정확도 (tail 이 남은 그대로 질의)
+ */
+static void query_bench(const GpsTrail *t, const Drive *d, int64_t now_ns, int nq)
+{
+    Lat          ln = { calloc(nq, sizeof(int64_t)), nq };
+    Lat          la = { calloc(nq, sizeof(int64_t)), nq };
+    Lat          lr = { calloc(nq, sizeof(int64_t)), nq };
+    GpsTrailHit *hits = malloc(MAX_HITS * sizeof(GpsTrailHit));
+    GpsTrailHit  h;
+    size_t       bad_n = 0, bad_a = 0, bad_r = 0, total_r = 0;
+    int64_t      before = now_ns - (int64_t)(AGE_S * 1e9);
+    uint32_t     limit = brute_limit(t, before);
+    int          check = nq < 2000 ? nq : 2000;     // 전수 검사는 앞부분만
+
+    for (int k = 0; k < nq; k++) {
+        double e, n, lat, lon;
+        if (k & 1) {                                // 지나온 길 근처
+            size_t i = (size_t)(synth_urand() * d->nhist);
+            e = d->hist_e[i] + 10.0 * synth_grand();
+            n = d->hist_n[i] + 10.0 * synth_grand();
+        } else {                                    // 영역 안 아무 곳
+            e = (synth_urand() * 2 - 1) * HALF_AREA;
+            n = (synth_urand() * 2 - 1) * HALF_AREA;
+        }
+        geo_ltp_inv(&t->ltp, e, n, &lat, &lon);
+        geo_ltp_fwd(&t->ltp, lat, lon, &e, &n);
+
+        int64_t t0 = gps_now_ns();
+        int     rn = gps_trail_nearest(t, lat, lon, INT64_MAX, &h);
+        ln.ns[k]   = gps_now_ns() - t0;
+        double dn  = rn == 0 ? h.dist : INFINITY;
+
+        t0 = gps_now_ns();
+        int    ra = gps_trail_nearest(t, lat, lon, before, &h);
+        la.ns[k]  = gps_now_ns() - t0;
+        double da = ra == 0 ? h.dist : INFINITY;
+
+        t0 = gps_now_ns();
+        size_t cr = gps_trail_radius(t, lat, lon, RADIUS_M, INT64_MAX, hits, MAX_HITS);
+        lr.ns[k]  = gps_now_ns() - t0;
+        total_r  += cr;
+
+        if (k < check) {
+            if (fabs(dn - brute_nearest(t, e, n, (uint32_t)t->count)) > 1e-3) bad_n++;
+            double ba = limit ? brute_nearest(t, e, n, limit) : INFINITY;
+            if (!(isinf(ba) && isinf(da)) && fabs(da - ba) > 1e-3) bad_a++;
+            if (cr != brute_radius(t, e, n, RADIUS_M)) bad_r++;
+        }
+    }
+    printf("    tree %zu + tail %zu points, %d queries (first %d checked by brute force)\n",
+           t->kd_n, t->count - t->kd_n, nq, check);
+    lat_print("nearest", &ln, bad_n);
+    lat_print("nearest, >60 s old", &la, bad_a);
+    lat_print("radius 20 m", &lr, bad_r);
+    printf("    radius 20 m: %.1f points per query\n", (double)total_r / nq);
+    free(ln.ns);
+    free(la.ns);
+    free(lr.ns);
+    free(hits);
+}
+
+// 귀환 경로 길이
+typedef struct {
+    GeoLtp ltp;
+    double e, n, len;
+    int    count;
+} HomeLen;
+
+static int home_wp(double lat, double lon, void *user)
+{
+    HomeLen *h = user;
+    double   e, n;
+    geo_ltp_fwd(&h->ltp, lat, lon, &e, &n);
+    if (h->count++) h->len += hypot(e - h->e, n - h->n);
+    h->e = e;
+    h->n = n;
+    return 0;
+}
+
+static void home_bench(const GpsTrail *t, const Drive *d)
+{
+    double lat, lon, trail_len = 0.0;
+    for (size_t i = 1; i < t->count; i++)
+        trail_len += hypot(t->pt[i].e - t->pt[i - 1].e, t->pt[i].n - t->pt[i - 1].n);
+    geo_ltp_inv(&t->ltp, d->e + d->gm_e, d->n + d->gm_n, &lat, &lon);
+
+    static const double shortcut[] = { 0.0, 10.0, 50.0 };
+    for (size_t k = 0; k < sizeof(shortcut) / sizeof(shortcut[0]); k++) {
+        HomeLen h = { .ltp = t->ltp };
+        int64_t t0 = gps_now_ns();
+        int     n  = gps_trail_home(t, lat, lon, 2.0, shortcut[k], home_wp, &h);
+        int64_t dt = gps_now_ns() - t0;
+        printf("    home (tol 2 m, shortcut %4.0f m): %6d waypoints, %8.1f km (trail %.1f km), %7.1f ms\n",
+               shortcut[k], n, h.len / 1e3, trail_len / 1e3, dt / 1e6);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long   max_points = 0, nq = 20000;
+    double min_dist = 0.0, hours = 24.0;
+    int    opt;
+
+    while ((opt = getopt(argc, argv, "m:d:H:q:")) != -1) {
+        switch (opt) {
+            case 'm': max_points = atol(optarg); break;
+            case 'd': min_dist   = atof(optarg); break;
+            case 'H': hours      = atof(optarg); break;
+            case 'q': nq         = atol(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-m max_points] [-d min_dist_m] [-H hours] [-q queries]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    GpsTrail t;
+    if (gps_trail_init(&t, (size_t)max_points, min_dist) < 0) {
+        perror("gps_trail_init");
+        return 1;
+    }
+
+    size_t  nfix = (size_t)(hours * 3600 * RATE_HZ);
+    Drive   d = { .hdg = 0.3 };
+    GeoLtp  ref;
+    d.hist_e = malloc(nfix * sizeof(double));
+    d.hist_n = malloc(nfix * sizeof(double));
+    geo_ltp_init(&ref, LAT0, LON0, 0.0);
+
+    static const double marks[] = { 1.0, 6.0, 24.0 };
+    size_t  mark = 0;
+    int64_t add_ns = 0, thin_max = 0;
+    Lat     adds = { malloc(nfix * sizeof(int64_t)), 0 };
+    printf("%.0f h of %d Hz fixes (%zu), max points %zu, min dist %.1f m, memory %.1f MB\n",
+           hours, RATE_HZ, nfix, t.max_points, t.min_dist, gps_trail_memory(&t) / 1e6);
+
+    for (size_t i = 0; i < nfix; i++) {
+        double lat, lon;
+        drive_step(&d, 1.0 / RATE_HZ);
+        geo_ltp_inv(&ref, d.e + d.gm_e, d.n + d.gm_n, &lat, &lon);
+        int64_t t_ns = (int64_t)i * (1000000000LL / RATE_HZ);
+
+        uint64_t thins = t.stats.thins;
+        int64_t  t0 = gps_now_ns();
+        gps_trail_add(&t, lat, lon, t_ns);
+        int64_t  dt = gps_now_ns() - t0;
+        add_ns += dt;
+        if (t.stats.thins != thins) {               // 솎기 + 한 번에 다시 만들기
+            if (dt > thin_max) thin_max = dt;
+        } else {
+            adds.ns[adds.n++] = dt;
+        }
+
+        double h = (i + 1) / (3600.0 * RATE_HZ);
+        if ((mark < 3 && h >= marks[mark]) || i + 1 == nfix) {
+            printf("\n%.1f h: %zu fixes, %zu points (%llu stored, %llu thins, min dist %.1f m), "
+                   "add avg %.0f ns, %llu rebuilds in %llu steps (step max %.1f us)\n",
+                   h, i + 1, t.count, (unsigned long long)t.stats.stored,
+                   (unsigned long long)t.stats.thins, t.min_dist, (double)add_ns / (i + 1),
+                   (unsigned long long)t.stats.rebuilds, (unsigned long long)t.stats.steps,
+                   t.stats.step_max_ns / 1e3);
+            lat_line("add", &adds);
+            if (t.stats.thins) printf("  thinning add max %.2f ms\n", thin_max / 1e6);
+            else               printf("\n");
+            query_bench(&t, &d, t_ns, (int)nq);
+            while (mark < 3 && h >= marks[mark]) mark++;
+        }
+    }
+
+    printf("\nreturn to home from the last position:\n");
+    home_bench(&t, &d);
+
+    free(adds.ns);
+    free(d.hist_e);
+    free(d.hist_n);
+    gps_trail_free(&t);
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include "ubx.h"
+
+#include <string.h>
+
+// ─────────────────────────────────────────────
+//  프레이머 상태
+// ─────────────────────────────────────────────
+enum {
+    S_SYNC1 = 0,    // 0xB5 대기
+    S_SYNC2,        // 0x62
+    S_CLASS,
+    S_ID,
+    S_LEN1,
+    S_LEN2,
+    S_PAYLOAD,
+    S_CKA,
+    S_CKB,
+};
+
+static inline void ck_add(UbxParser *p, uint8_t b)
+{
+    p->ck_a += b;
+    p->ck_b += p->ck_a;
+}
+
+static void emit(UbxParser *p)
+{
+    UbxFrame f = {
+        .cls     = p->cls,
+        .id      = p->id,
+        .len     = p->len,
+        .payload = p->payload,
+        .rx_ns   = p->start_ns,
+        .end_ns  = p->chunk_ns,
+    };
+
+    p->stats.frames++;
+    if (p->cb) p->cb(&f, p->user);
+}
+
+// ─────────────────────────────────────────────
+//  프레이머 API 구현
+// ─────────────────────────────────────────────
+
+void ubx_parser_init(UbxParser *p, UbxFrameCb cb, void *user)
+{
+    memset(p, 0, sizeof(UbxParser));
+    p->state = S_SYNC1;
+    p->cb    = cb;
+    p->user  = user;
+}
+
+void ubx_parser_reset(UbxParser *p)
+{
+    p->state = S_SYNC1;
+}
+
+size_t ubx_parser_feed_frame(UbxParser *p, const uint8_t *data, size_t n,
+                             int64_t rx_ns, int *done)
+{
+    size_t i = 0;
+
+    p->chunk_ns = rx_ns;
+    *done = 0;
+
+    while (i < n) {
+        uint8_t b = data[i++];
+
+        switch (p->state) {
+            case S_SYNC1:
+                if (b == UBX_SYNC1) {
+                    p->state    = S_SYNC2;
+                    p->start_ns = rx_ns;
+                }
+                break;
+
+            case S_SYNC2:
+                p->state = S_SYNC1;
+                if (b != UBX_SYNC2) {
+                    // 이 바이트는 다른 프로토콜의 시작일 수 있으므로 돌려줌
+                    *done = 1;
+                    return i - 1;
+                }
+                p->state = S_CLASS;
+                p->ck_a  = 0;
+                p->ck_b  = 0;
+                break;
+
+            case S_CLASS: p->cls = b; ck_add(p, b); p->state = S_ID;   break;
+            case S_ID:    p->id  = b; ck_add(p, b); p->state = S_LEN1; break;
+            case S_LEN1:  p->len = b; ck_add(p, b); p->state = S_LEN2; break;
+
+            case S_LEN2:
+                p->len |= (uint16_t)(b << 8);
+                ck_add(p, b);
+                if (p->len > UBX_PAYLOAD_MAX) {
+                    p->stats.overflows++;
+                    p->state = S_SYNC1;
+                    *done = 1;
+                    return i;
+                }
+                p->pos   = 0;
+                p->state = p->len ? S_PAYLOAD : S_CKA;
+                break;
+
+            case S_PAYLOAD: {
+                // payload 는 길이를 알고 있으므로 한 번에 복사
+                size_t k = p->len - p->pos;
+                i--;
+                if (k > n - i) k = n - i;
+                memcpy(p->payload + p->pos, data + i, k);
+                for (size_t j = 0; j < k; j++) ck_add(p, data[i + j]);
+                p->pos += (uint16_t)k;
+                i      += k;
+                if (p->pos == p->len) p->state = S_CKA;
+                break;
+            }
+
+            case S_CKA:
+                p->rx_ck_a = b;
+                p->state   = S_CKB;
+                break;
+
+            case S_CKB:
+                p->state = S_SYNC1;
+                if (p->rx_ck_a == p->ck_a && b == p->ck_b)
+                    emit(p);
+                else
+                    p->stats.checksum_errors++;
+                *done = 1;
+                return i;
+        }
+    }
+    return i;
+}
+
+int ubx_parser_feed_at(UbxParser *p, const uint8_t *data, size_t n, int64_t rx_ns)
+{
+    uint64_t before = p->stats.frames;
+    size_t   off    = 0;
+
+    p->stats.bytes += n;
+    while (off < n) {
+        int done;
+        size_t k = ubx_parser_feed_frame(p, data + off, n - off, rx_ns, &done);
+        // sync2 불일치로 돌려받은 바이트는 S_SYNC1 에서 다시 검사
+        if (k == 0 && done) continue;
+        off += k;
+    }
+    return (int)(p->stats.frames - before);
+}
+
+size_t ubx_build(uint8_t *out, uint8_t cls, uint8_t id, const void *payload, uint16_t len)
+{
+    uint8_t a = 0, b = 0;
+
+    out[0] = UBX_SYNC1;
+    out[1] = UBX_SYNC2;
+    out[2] = cls;
+    out[3] = id;
+    ubx_put_u2(out + 4, len);
+    if (len) memcpy(out + 6, payload, len);
+
+    for (size_t i = 2; i < 6u + len; i++) {
+        a += out[i];
+        b += a;
+    }
+    out[6 + len] = a;
+    out[7 + len] = b;
+    return len + UBX_FRAME_OVERHEAD;
+}
+
+// ─────────────────────────────────────────────
+//  NAV 디코더
+// ─────────────────────────────────────────────
+
+static int is_msg(const UbxFrame *f, uint8_t cls, uint8_t id, uint16_t min_len)
+{
+    return f->cls == cls && f->id == id && f->len >= min_len;
+}
+
+int ubx_decode_nav_posllh(const UbxFrame *f, UbxNavPosllh *o)
+{
+    const uint8_t *p = f->payload;
+
+    if (!is_msg(f, UBX_NAV, UBX_NAV_POSLLH, 28)) return -1;
+    o->itow   = ubx_u4(p + 0);
+    o->lon    = ubx_i4(p + 4);
+    o->lat    = ubx_i4(p + 8);
+    o->height = ubx_i4(p + 12);
+    o->hmsl   = ubx_i4(p + 16);
+    o->hacc   = ubx_u4(p + 20);
+    o->vacc   = ubx_u4(p + 24);
+    return 0;
+}
+
+int ubx_decode_nav_sol(const UbxFrame *f, UbxNavSol *o)
+{
+    const uint8_t *p = f->payload;
+
+    if (!is_msg(f, UBX_NAV, UBX_NAV_SOL, 52)) return -1;
+    o->itow    = ubx_u4(p + 0);
+    o->ftow    = ubx_i4(p + 4);
+    o->week    = (int16_t)ubx_u2(p + 8);
+    o->gps_fix = p[10];
+    o->flags   = p[11];
+    for (int k = 0; k < 3; k++) {
+        o->ecef[k]   = ubx_i4(p + 12 + 4 * k);
+        o->ecef_v[k] = ubx_i4(p + 28 + 4 * k);
+    }
+    o->pacc    = ubx_u4(p + 24);
+    o->sacc    = ubx_u4(p + 40);
+    o->pdop    = ubx_u2(p + 44);
+    o->num_sv  = p[47];
+    return 0;
+}
+
+int ubx_decode_nav_velned(const UbxFrame *f, UbxNavVelned *o)
+{
+    const uint8_t *p = f->payload;
+
+    if (!is_msg(f, UBX_NAV, UBX_NAV_VELNED, 36)) return -1;
+    o->itow    = ubx_u4(p + 0);
+    o->vel_n   = ubx_i4(p + 4);
+    o->vel_e   = ubx_i4(p + 8);
+    o->vel_d   = ubx_i4(p + 12);
+    o->speed   = ubx_u4(p + 16);
+    o->gspeed  = ubx_u4(p + 20);
+    o->heading = ubx_i4(p + 24);
+    o->sacc    = ubx_u4(p + 28);
+    o->cacc    = ubx_u4(p + 32);
+    return 0;
+}
+
+// 프로토콜 14 (u-blox 7) 은 84 바이트, 15 이상은 92 바이트
+int ubx_decode_nav_pvt(const UbxFrame *f, UbxNavPvt *o)
+{
+    const uint8_t *p = f->payload;
+
+    if (!is_msg(f, UBX_NAV, UBX_NAV_PVT, 84)) return -1;
+    o->itow     = ubx_u4(p + 0);
+    o->year     = ubx_u2(p + 4);
+    o->month    = p[6];
+    o->day      = p[7];
+    o->hour     = p[8];
+    o->min      = p[9];
+    o->sec      = p[10];
+    o->valid    = p[11];
+    o->tacc     = ubx_u4(p + 12);
+    o->nano     = ubx_i4(p + 16);
+    o->fix_type = p[20];
+    o->flags    = p[21];
+    o->num_sv   = p[23];
+    o->lon      = ubx_i4(p + 24);
+    o->lat      = ubx_i4(p + 28);
+    o->height   = ubx_i4(p + 32);
+    o->hmsl     = ubx_i4(p + 36);
+    o->hacc     = ubx_u4(p + 40);
+    o->vacc     = ubx_u4(p + 44);
+    o->vel_n    = ubx_i4(p + 48);
+    o->vel_e    = ubx_i4(p + 52);
+    o->vel_d    = ubx_i4(p + 56);
+    o->gspeed   = ubx_i4(p + 60);
+    o->head_mot = ubx_i4(p + 64);
+    o->sacc     = ubx_u4(p + 68);
+    o->pdop     = ubx_u2(p + 76);
+    return 0;
+}
@@ -0,0 +1,209 @@
+#ifndef UBX_H
+#define UBX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────────────────────────────────────────
+//  u-blox UBX 바이너리 프로토콜
+//
+//  프레임: B5 62 | class | id | len(LE16) | payload | CK_A CK_B
+//  체크섬: class ~ payload 에 대한 8bit Fletcher
+// ─────────────────────────────────────────────
+
+#define UBX_SYNC1           0xB5
+#define UBX_SYNC2           0x62
+#define UBX_PAYLOAD_MAX     512     // CFG/AID 포함 u-blox 6 메시지 최대 크기 이상
+#define UBX_FRAME_OVERHEAD  8       // sync 2 + class/id 2 + len 2 + ck 2
+
+// 클래스
+#define UBX_NAV             0x01
+#define UBX_ACK             0x05
+#define UBX_CFG             0x06
+#define UBX_MON             0x0A
+#define UBX_AID             0x0B
+
+// NAV 메시지 ID
+#define UBX_NAV_POSLLH      0x02
+#define UBX_NAV_SOL         0x06
+#define UBX_NAV_PVT         0x07    // u-blox 7 이상 (NEO-6M 미지원)
+#define UBX_NAV_VELNED      0x12
+
+// ─────────────────────────────────────────────
+//  검증된 프레임 1개 (payload 는 콜백 안에서만 유효)
+// ─────────────────────────────────────────────
+typedef struct {
+    uint8_t         cls;
+    uint8_t         id;
+    uint16_t        len;
+    const uint8_t  *payload;
+    int64_t         rx_ns;      // sync 가 들어온 청크의 수신 시각
+    int64_t         end_ns;     // 체크섬이 들어온 청크의 수신 시각
+} UbxFrame;
+
+typedef void (*UbxFrameCb)(const UbxFrame *f, void *user);
+
+typedef struct {
+    uint64_t bytes;             // 입력 바이트 수
+    uint64_t frames;            // 체크섬 통과 프레임 수
+    uint64_t checksum_errors;
+    uint64_t overflows;         // len > UBX_PAYLOAD_MAX
+} UbxStats;
+
+// ─────────────────────────────────────────────
+//  프레이머 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    uint8_t     state;
+    uint8_t     ck_a, ck_b;
+    uint8_t     rx_ck_a;
+    uint8_t     cls, id;
+    uint16_t    len;
+    uint16_t    pos;
+    int64_t     chunk_ns;
+    int64_t     start_ns;
+    UbxStats    stats;
+    UbxFrameCb  cb;
+    void       *user;
+    uint8_t     payload[UBX_PAYLOAD_MAX];
+} UbxParser;
+
+/**
+ * @brief 프레이머 초기화
+ * @param cb   검증된 프레임마다 호출될 콜백
+ * @param user 콜백에 그대로 전달될 포인터
+ */
+void ubx_parser_init(UbxParser *p, UbxFrameCb cb, void *user);
+
+/**
+ * @brief 바이트 청크 입력 (UBX 전용 스트림)
+ * @return 이번 호출에서 전달된 프레임 수
+ */
+int ubx_parser_feed_at(UbxParser *p, const uint8_t *data, size_t len, int64_t rx_ns);
+
+/**
+ * @brief 프레임 1개가 끝날 때까지만 입력 (NMEA 혼합 스트림 분배용)
+ * @param done 프레임 완료/실패로 sync 대기 상태로 돌아왔으면 1
+ * @return 소비한 바이트 수
+ */
+size_t ubx_parser_feed_frame(UbxParser *p, const uint8_t *data, size_t len,
+                             int64_t rx_ns, int *done);
+
+/**
+ * @brief 진행 중인 프레임을 버리고 sync 대기 상태로
+ */
+void ubx_parser_reset(UbxParser *p);
+
+/**
+ * @brief 프레임 생성 (체크섬 포함)
+ * @param out 최소 len + UBX_FRAME_OVERHEAD 바이트
+ * @return 프레임 전체 길이
+ */
+size_t ubx_build(uint8_t *out, uint8_t cls, uint8_t id, const void *payload, uint16_t len);
+
+// ─────────────────────────────────────────────
+//  NAV 디코더 (u-blox 프로토콜 단위 그대로, 정수)
+//  모두 성공 0, class/id/길이 불일치 -1
+// ─────────────────────────────────────────────
+
+typedef struct {
+    uint32_t itow;              // GPS 주 시작 이후 ms
+    int32_t  lon, lat;          // 1e-7 도
+    int32_t  height;            // 타원체 고도 mm
+    int32_t  hmsl;              // 해발 고도 mm
+    uint32_t hacc, vacc;        // mm
+} UbxNavPosllh;
+
+typedef struct {
+    uint32_t itow;
+    int32_t  ftow;              // ns
+    int16_t  week;
+    uint8_t  gps_fix;           // 0 없음, 1 DR, 2 2D, 3 3D, 4 GPS+DR, 5 시각 전용
+    uint8_t  flags;             // UBX_SOL_*
+    int32_t  ecef[3];           // cm
+    uint32_t pacc;              // cm
+    int32_t  ecef_v[3];         // cm/s
+    uint32_t sacc;              // cm/s
+    uint16_t pdop;              // ×100
+    uint8_t  num_sv;
+} UbxNavSol;
+
+#define UBX_SOL_FIX_OK      0x01
+#define UBX_SOL_DIFF        0x02
+#define UBX_SOL_WKN_SET     0x04
+#define UBX_SOL_TOW_SET     0x08
+
+typedef struct {
+    uint32_t itow;
+    int32_t  vel_n, vel_e, vel_d;   // cm/s
+    uint32_t speed;                 // 3D cm/s
+    uint32_t gspeed;                // 지면 cm/s
+    int32_t  heading;               // 1e-5 도
+    uint32_t sacc;                  // cm/s
+    uint32_t cacc;                  // 1e-5 도
+} UbxNavVelned;
+
+typedef struct {
+    uint32_t itow;
+    uint16_t year;
+    uint8_t  month, day, hour, min, sec;
+    uint8_t  valid;                 // UBX_PVT_VALID_*
+    uint32_t tacc;                  // ns
+    int32_t  nano;                  // ns (음수 가능)
+    uint8_t  fix_type;              // NAV-SOL gps_fix 와 동일
+    uint8_t  flags;                 // UBX_PVT_FIX_OK 등
+    uint8_t  num_sv;
+    int32_t  lon, lat;              // 1e-7 도
+    int32_t  height, hmsl;          // mm
+    uint32_t hacc, vacc;            // mm
+    int32_t  vel_n, vel_e, vel_d;   // mm/s
+    int32_t  gspeed;                // mm/s
+    int32_t  head_mot;              // 1e-5 도
+    uint32_t sacc;                  // mm/s
+    uint16_t pdop;                  // ×100
+} UbxNavPvt;
+
+#define UBX_PVT_VALID_DATE  0x01
+#define UBX_PVT_VALID_TIME  0x02
+#define UBX_PVT_FIX_OK      0x01
+#define UBX_PVT_DIFF        0x02
+
+int ubx_decode_nav_posllh(const UbxFrame *f, UbxNavPosllh *out);
+int ubx_decode_nav_sol(const UbxFrame *f, UbxNavSol *out);
+int ubx_decode_nav_velned(const UbxFrame *f, UbxNavVelned *out);
+int ubx_decode_nav_pvt(const UbxFrame *f, UbxNavPvt *out);
+
+// ─────────────────────────────────────────────
+//  little-endian 필드 접근
+// ─────────────────────────────────────────────
+static inline uint16_t ubx_u2(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t ubx_u4(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline int32_t ubx_i4(const uint8_t *p)
+{
+    return (int32_t)ubx_u4(p);
+}
+
+static inline void ubx_put_u2(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void ubx_put_u4(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+#endif /* UBX_H */
@@ -0,0 +1,165 @@
+// NMEA vs UBX: fix 1개당 바이트 수 / CPU 시간
+//
+// 같은 위치를 담은 합성 스트림을 gps_stream (프로토콜 자동 판별)
+// → libnmea / UBX 프레이머 → gps_epoch 로 처리해 GpsFix 를 비교한다.
+//
+// 빌드: make ubx_bench
+// 실행: ./ubx_bench [epochs]   (기본 100000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "nmea_msg.h"
+#include "ubx.h"
+#include "gps_stream.h"
+#include "gps_epoch.h"
+#include "gps_synth.h"
+
+#define CHUNK_SIZE  512
+#define BAUD        9600
+
+typedef enum {
+    SRC_NMEA_ALL = 0,       // NEO-6M 기본 8 문장
+    SRC_NMEA_MIN,           // GGA + RMC 만 (CFG-MSG 로 나머지 끔)
+    SRC_UBX_NEO6,           // POSLLH + SOL + VELNED
+    SRC_UBX_PVT,            // NAV-PVT
+    SRC_MIXED,              // NMEA 기본 + UBX NEO6 동시 출력
+    SRC_COUNT
+} Source;
+
+static const char *src_name[SRC_COUNT] = {
+    "NMEA (8 sentences)", "NMEA GGA+RMC", "UBX POSLLH+SOL+VELNED", "UBX NAV-PVT", "NMEA + UBX mixed",
+};
+
+// GGA/RMC 만 남김
+static size_t keep_gga_rmc(char *buf, size_t n)
+{
+    size_t out = 0;
+    for (size_t i = 0; i < n; ) {
+        char  *eol = memchr(buf + i, '\n', n - i);
+        size_t len = (size_t)(eol - (buf + i)) + 1;
+        if (memcmp(buf + i + 3, "GGA", 3) == 0 || memcmp(buf + i + 3, "RMC", 3) == 0) {
+            memmove(buf + out, buf + i, len);
+            out += len;
+        }
+        i += len;
+    }
+    return out;
+}
+
+static size_t gen(uint8_t *out, Source src, int i)
+{
+    size_t n = 0;
+
+    switch (src) {
+        case SRC_NMEA_ALL: return nmea_synth_epoch((char *)out, i, 1);
+        case SRC_NMEA_MIN: n = nmea_synth_epoch((char *)out, i, 1);
+                           return keep_gga_rmc((char *)out, n);
+        case SRC_UBX_NEO6: return ubx_synth_epoch(out, i, 1, UBX_SYNTH_NEO6);
+        case SRC_UBX_PVT:  return ubx_synth_epoch(out, i, 1, UBX_SYNTH_PVT);
+        case SRC_MIXED:    n = nmea_synth_epoch((char *)out, i, 1);
+                           return n + ubx_synth_epoch(out + n, i, 1, UBX_SYNTH_NEO6);
+        default:           return 0;
+    }
+}
+
+typedef struct {
+    long     fixes;
+    int32_t *lat, *lon;         // epoch 별 위치 (NMEA 기준과 비교)
+    uint32_t *valid;
+    int      epochs;
+} Sink;
+
+static void on_fix(const GpsFix *f, void *user)
+{
+    Sink *s = user;
+    int   i = (int)f->seq;
+
+    s->fixes++;
+    if (i >= s->epochs) return;
+    s->lat[i]   = f->lat;
+    s->lon[i]   = f->lon;
+    s->valid[i] = f->valid;
+}
+
+int main(int argc, char **argv)
+{
+    int      epochs = (argc > 1) ? atoi(argv[1]) : 100000;
+    int32_t *ref_lat, *ref_lon;
+
+    if (epochs <= 0) {
+        fprintf(stderr, "usage: %s [epochs]\n", argv[0]);
+        return 1;
+    }
+    ref_lat = calloc((size_t)epochs, sizeof(int32_t));
+    ref_lon = calloc((size_t)epochs, sizeof(int32_t));
+
+    printf("%d epochs, %d byte chunks, airtime at %d baud\n", epochs, CHUNK_SIZE, BAUD);
+    printf("%-24s %8s %10s %10s %8s %12s\n",
+           "source", "B/fix", "air ms/fix", "ns/fix", "fixes", "max |dpos|");
+
+    for (int src = 0; src < SRC_COUNT; src++) {
+        uint8_t *data = malloc((size_t)epochs * 1024);
+        size_t   len  = 0;
+        Sink     sink = { .epochs = epochs };
+
+        sink.lat   = calloc((size_t)epochs, sizeof(int32_t));
+        sink.lon   = calloc((size_t)epochs, sizeof(int32_t));
+        sink.valid = calloc((size_t)epochs, sizeof(uint32_t));
+        if (!data || !sink.lat || !sink.lon || !sink.valid) { perror("malloc"); return 1; }
+
+        for (int i = 0; i < epochs; i++)
+            len += gen(data + len, (Source)src, i);
+
+        GpsStream    st;
+        NmeaDispatch disp;
+        GpsEpoch     ep;
+        gps_epoch_init(&ep, on_fix, &sink);
+        nmea_dispatch_init(&disp);
+        gps_epoch_attach(&ep, &disp);
+        gps_stream_init(&st, nmea_dispatch_sentence, &disp, gps_epoch_on_ubx, &ep);
+
+        int64_t t0 = gps_now_ns();
+        for (size_t off = 0; off < len; off += CHUNK_SIZE) {
+            size_t n = (len - off < CHUNK_SIZE) ? len - off : CHUNK_SIZE;
+            gps_stream_feed(&st, data + off, n, 0);
+        }
+        gps_epoch_flush(&ep);
+        int64_t dt = gps_now_ns() - t0;
+
+        // NMEA 기본 출력의 위치를 기준으로 차이 (1e-7 도)
+        int32_t maxd = 0;
+        for (int i = 0; i < epochs && i < sink.fixes; i++) {
+            if (src == SRC_NMEA_ALL) {
+                ref_lat[i] = sink.lat[i];
+                ref_lon[i] = sink.lon[i];
+                continue;
+            }
+            int32_t d1 = abs(sink.lat[i] - ref_lat[i]), d2 = abs(sink.lon[i] - ref_lon[i]);
+            if (d1 > maxd) maxd = d1;
+            if (d2 > maxd) maxd = d2;
+        }
+
+        double per = sink.fixes ? (double)len / sink.fixes : 0.0;
+        printf("%-24s %8.1f %10.1f %10.0f %8ld %12d\n", src_name[src],
+               per, per * 10 * 1000 / BAUD,
+               sink.fixes ? (double)dt / sink.fixes : 0.0, sink.fixes, maxd);
+
+        if (src == SRC_MIXED)
+            printf("  stream: nmea %llu B, ubx %llu B, garbage %llu B, ubx ck_err %llu\n",
+                   (unsigned long long)st.stats.nmea_bytes,
+                   (unsigned long long)st.stats.ubx_bytes,
+                   (unsigned long long)st.stats.garbage,
+                   (unsigned long long)st.ubx.stats.checksum_errors);
+
+        free(sink.lat);
+        free(sink.lon);
+        free(sink.valid);
+        free(data);
+    }
+
+    free(ref_lat);
+    free(ref_lon);
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "ubx_cfg.h"
+#include "gps_fix.h"
+
+#include <errno.h>
+#include <string.h>
+#include <termios.h>
+
+// CFG-PRT mode: 8N1 (charLen 8bit, parity 없음, stop 1)
+#define PRT_MODE_8N1        0x000008D0u
+
+// CFG-CFG saveMask: ioPort | msgConf | infMsg | navConf | rxmConf | rinvConf | antConf
+#define CFG_SAVE_ALL        0x0000061Fu
+
+// NmeaType → CFG-MSG id (class 0xF0)
+static const uint8_t nmea_msg_id[NMEA_TYPE_COUNT] = {
+    [NMEA_GGA] = 0x00,
+    [NMEA_GLL] = 0x01,
+    [NMEA_GSA] = 0x02,
+    [NMEA_GSV] = 0x03,
+    [NMEA_RMC] = 0x04,
+    [NMEA_VTG] = 0x05,
+};
+
+// 자동 탐지 순서 (기본값 → 흔히 바꾸는 값)
+static const int detect_bauds[] = { 9600, 115200, 38400, 57600, 19200, 4800, 230400 };
+
+// ─────────────────────────────────────────────
+//  응답 대기
+// ─────────────────────────────────────────────
+
+static void on_frame(const UbxFrame *f, void *user)
+{
+    UbxCfg *c = user;
+
+    if (c->result) return;
+
+    if (f->cls == UBX_ACK && f->len >= 2 &&
+        f->payload[0] == c->want_cls && f->payload[1] == c->want_id) {
+        if (f->id == UBX_ACK_NAK) {
+            c->result = -1;
+            c->stats.naks++;
+        } else if (f->id == UBX_ACK_ACK) {
+            c->stats.acks++;
+            // poll 은 응답 프레임 다음에 ACK 가 오므로 응답을 계속 기다림
+            if (!c->want_poll) c->result = 1;
+        }
+        return;
+    }
+
+    if (c->want_poll && f->cls == c->want_cls && f->id == c->want_id && f->len > 0) {
+        c->resp_len = (f->len < c->resp_max) ? f->len : c->resp_max;
+        if (c->resp) memcpy(c->resp, f->payload, c->resp_len);
+        c->result = 1;
+    }
+}
+
+/**
+ * @brief 응답이 오거나 timeout_ms 가 지날 때까지 수신
+ */
+static UbxCfgError wait_reply(UbxCfg *c, int timeout_ms)
+{
+    int64_t deadline = gps_now_ns() + (int64_t)timeout_ms * 1000000;
+    char    buf[512];
+
+    while (!c->result) {
+        int64_t left = deadline - gps_now_ns();
+        int64_t rx_ns;
+        int     n;
+
+        if (left <= 0) break;
+        n = gps_serial_read(c->ser, buf, sizeof(buf), (int)((left + 999999) / 1000000), &rx_ns);
+        if (n < 0) return UBX_CFG_ERR_IO;
+        if (n > 0) ubx_parser_feed_at(&c->ubx, (const uint8_t *)buf, (size_t)n, rx_ns);
+    }
+
+    if (c->result > 0) return UBX_CFG_OK;
+    if (c->result < 0) return UBX_CFG_ERR_NAK;
+    c->stats.timeouts++;
+    return UBX_CFG_ERR_TIMEOUT;
+}
+
+/**
+ * @brief ms 동안 수신 데이터 버림 (보레이트 전환 중 깨진 바이트)
+ */
+static int drain(UbxCfg *c, int ms)
+{
+    int64_t deadline = gps_now_ns() + (int64_t)ms * 1000000;
+    char    buf[512];
+
+    for (int64_t left; (left = deadline - gps_now_ns()) > 0; ) {
+        if (gps_serial_read(c->ser, buf, sizeof(buf), (int)((left + 999999) / 1000000), NULL) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 프레임 전송 + 응답 대기, 무응답이면 tries 회까지 재전송
+ */
+static UbxCfgError transact(UbxCfg *c, uint8_t cls, uint8_t id,
+                            const void *payload, uint16_t len, int poll, int tries)
+{
+    uint8_t     frame[64 + UBX_FRAME_OVERHEAD];
+    size_t      n;
+    UbxCfgError err = UBX_CFG_ERR_TIMEOUT;
+
+    if (len > 64) return UBX_CFG_ERR_ARG;
+    n = ubx_build(frame, cls, id, payload, len);
+
+    c->want_cls  = cls;
+    c->want_id   = id;
+    c->want_poll = (uint8_t)poll;
+
+    for (int t = 0; t < tries; t++) {
+        c->result   = 0;
+        c->resp_len = 0;
+        ubx_parser_reset(&c->ubx);
+
+        if (gps_serial_write(c->ser, frame, n) < 0) return UBX_CFG_ERR_IO;
+        c->stats.sent++;
+
+        err = wait_reply(c, c->timeout_ms);
+        if (err != UBX_CFG_ERR_TIMEOUT) break;
+    }
+    return err;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+void ubx_cfg_init(UbxCfg *c, GpsSerial *ser)
+{
+    memset(c, 0, sizeof(UbxCfg));
+    c->ser        = ser;
+    c->timeout_ms = UBX_CFG_TIMEOUT_MS;
+    c->retries    = UBX_CFG_RETRIES;
+    ubx_parser_init(&c->ubx, on_frame, c);
+}
+
+UbxCfgError ubx_cfg_send(UbxCfg *c, uint8_t cls, uint8_t id,
+                         const void *payload, uint16_t len)
+{
+    return transact(c, cls, id, payload, len, 0, 1 + c->retries);
+}
+
+UbxCfgError ubx_cfg_poll(UbxCfg *c, uint8_t cls, uint8_t id,
+                         const void *req, uint16_t req_len,
+                         uint8_t *resp, uint16_t *resp_len)
+{
+    UbxCfgError err;
+
+    c->resp     = resp;
+    c->resp_max = *resp_len;
+    err = transact(c, cls, id, req, req_len, 1, 1 + c->retries);
+    *resp_len = c->resp_len;
+    c->resp   = NULL;
+    return err;
+}
+
+/**
+ * @brief 현재 보레이트에서 CFG-PRT (UART1) poll
+ * @return 수신기가 보고한 보레이트, 실패 시 UbxCfgError
+ */
+static int poll_port(UbxCfg *c, int tries)
+{
+    uint8_t     port = UBX_UART1;
+    uint8_t     resp[20];
+    UbxCfgError err;
+
+    c->resp     = resp;
+    c->resp_max = sizeof(resp);
+    err = transact(c, UBX_CFG, UBX_CFG_PRT, &port, 1, 1, tries);
+    c->resp = NULL;
+
+    if (err != UBX_CFG_OK) return err;
+    if (c->resp_len < 20) return UBX_CFG_ERR_TIMEOUT;
+    return (int)ubx_u4(resp + 8);
+}
+
+int ubx_cfg_detect(UbxCfg *c)
+{
+    for (size_t i = 0; i < sizeof(detect_bauds) / sizeof(detect_bauds[0]); i++) {
+        if (gps_serial_set_baud(c->ser, detect_bauds[i]) < 0) return UBX_CFG_ERR_IO;
+        tcflush(c->ser->fd, TCIFLUSH);
+
+        int r = poll_port(c, 1);
+        if (r > 0) return detect_bauds[i];
+        if (r == UBX_CFG_ERR_IO) return r;
+    }
+    return UBX_CFG_ERR_TIMEOUT;
+}
+
+UbxCfgError ubx_cfg_port(UbxCfg *c, int baud, uint16_t in_proto, uint16_t out_proto)
+{
+    uint8_t     pl[20];
+    UbxCfgError err;
+    int         r;
+
+    if (!gps_serial_speed(baud)) return UBX_CFG_ERR_ARG;
+
+    memset(pl, 0, sizeof(pl));
+    pl[0] = UBX_UART1;
+    ubx_put_u4(pl + 4, PRT_MODE_8N1);
+    ubx_put_u4(pl + 8, (uint32_t)baud);
+    ubx_put_u2(pl + 12, in_proto);
+    ubx_put_u2(pl + 14, out_proto);
+
+    // ACK 는 옛 보레이트로 오거나 전환 중 깨질 수 있으므로 1회만 기다림
+    err = transact(c, UBX_CFG, UBX_CFG_PRT, pl, sizeof(pl), 0, 1);
+    if (err == UBX_CFG_ERR_NAK || err == UBX_CFG_ERR_IO) return err;
+
+    // 수신기는 ACK 송신 후 전환하므로 바로 보내면 첫 poll 이 유실될 수 있음
+    if (gps_serial_set_baud(c->ser, baud) < 0) return UBX_CFG_ERR_IO;
+    if (drain(c, UBX_CFG_SETTLE_MS) < 0) return UBX_CFG_ERR_IO;
+
+    // 새 보레이트에서 응답하면 성공
+    r = poll_port(c, 1 + c->retries);
+    if (r < 0) return (UbxCfgError)r;
+    return (r == baud) ? UBX_CFG_OK : UBX_CFG_ERR_NAK;
+}
+
+UbxCfgError ubx_cfg_rate(UbxCfg *c, int meas_ms)
+{
+    uint8_t pl[6];
+
+    if (meas_ms < 50 || meas_ms > 65535) return UBX_CFG_ERR_ARG;
+    ubx_put_u2(pl + 0, (uint16_t)meas_ms);
+    ubx_put_u2(pl + 2, 1);                  // navRate: 측위마다 출력
+    ubx_put_u2(pl + 4, 1);                  // timeRef: GPS 시간
+    return ubx_cfg_send(c, UBX_CFG, UBX_CFG_RATE, pl, sizeof(pl));
+}
+
+UbxCfgError ubx_cfg_msg(UbxCfg *c, uint8_t cls, uint8_t id, uint8_t rate)
+{
+    uint8_t pl[3] = { cls, id, rate };
+    return ubx_cfg_send(c, UBX_CFG, UBX_CFG_MSG, pl, sizeof(pl));
+}
+
+UbxCfgError ubx_cfg_nmea(UbxCfg *c, NmeaType type, uint8_t rate)
+{
+    if (type >= NMEA_TYPE_COUNT) return UBX_CFG_ERR_ARG;
+    return ubx_cfg_msg(c, UBX_NMEA, nmea_msg_id[type], rate);
+}
+
+UbxCfgError ubx_cfg_save(UbxCfg *c, uint8_t devices)
+{
+    uint8_t pl[13];
+
+    memset(pl, 0, sizeof(pl));
+    ubx_put_u4(pl + 4, CFG_SAVE_ALL);
+    pl[12] = devices;
+    return ubx_cfg_send(c, UBX_CFG, UBX_CFG_CFG, pl, sizeof(pl));
+}
+
+const char *ubx_cfg_strerror(UbxCfgError err)
+{
+    switch (err) {
+        case UBX_CFG_OK:          return "OK";
+        case UBX_CFG_ERR_NAK:     return "Rejected by receiver (ACK-NAK)";
+        case UBX_CFG_ERR_TIMEOUT: return "No response from receiver";
+        case UBX_CFG_ERR_IO:      return strerror(errno);
+        case UBX_CFG_ERR_ARG:     return "Invalid argument";
+        default:                  return "Unknown error";
+    }
+}
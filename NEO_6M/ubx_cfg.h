@@ -0,0 +1,137 @@
+#ifndef UBX_CFG_H
+#define UBX_CFG_H
+
+#include <stdint.h>
+#include "gps_serial.h"
+#include "nmea_msg.h"
+#include "ubx.h"
+
+// ─────────────────────────────────────────────
+//  UBX CFG 설정기 (u-blox 6 프로토콜)
+//
+//  CFG 명령을 보내고 같은 class/id 의 ACK-ACK / ACK-NAK 를 기다린다.
+//  응답 대기 중 들어오는 NMEA/NAV 출력은 버린다.
+//  보레이트 변경 (CFG-PRT) 은 ACK 가 옛 보레이트로 오거나 유실될 수
+//  있으므로 ACK 대신 새 보레이트에서 CFG-PRT poll 응답으로 확인한다.
+// ─────────────────────────────────────────────
+
+#define UBX_CFG_TIMEOUT_MS  1000    // ACK 대기 (u-blox 는 1초 안에 응답)
+#define UBX_CFG_RETRIES     3       // 무응답 시 재전송 횟수
+#define UBX_CFG_SETTLE_MS   100     // 보레이트 전환 후 수신기 준비 대기
+
+// ACK / CFG 메시지 ID
+#define UBX_ACK_NAK         0x00
+#define UBX_ACK_ACK         0x01
+#define UBX_CFG_PRT         0x00
+#define UBX_CFG_MSG         0x01
+#define UBX_CFG_RATE        0x08
+#define UBX_CFG_CFG         0x09
+
+// 표준 NMEA 출력 (CFG-MSG 의 class 0xF0)
+#define UBX_NMEA            0xF0
+
+// CFG-PRT 프로토콜 마스크
+#define UBX_PROTO_UBX       0x0001
+#define UBX_PROTO_NMEA      0x0002
+
+// CFG-CFG 저장 장치
+#define UBX_DEV_BBR         0x01    // 배터리 백업 RAM (NEO-6M 모듈의 백업 전지)
+#define UBX_DEV_FLASH       0x02    // NEO-6M 은 flash 없는 제품이 있음 (NAK 가능)
+#define UBX_DEV_EEPROM      0x04
+
+#define UBX_UART1           1       // CFG-PRT portID
+
+typedef enum {
+    UBX_CFG_OK          =  0,
+    UBX_CFG_ERR_NAK     = -1,       // 수신기가 거부 (ACK-NAK)
+    UBX_CFG_ERR_TIMEOUT = -2,       // 재전송 후에도 응답 없음
+    UBX_CFG_ERR_IO      = -3,       // 시리얼 오류 (errno 설정)
+    UBX_CFG_ERR_ARG     = -4,       // 지원하지 않는 값
+} UbxCfgError;
+
+typedef struct {
+    uint64_t sent;                  // 전송한 명령 (재전송 포함)
+    uint64_t acks;
+    uint64_t naks;
+    uint64_t timeouts;              // 응답 대기 시간 초과
+} UbxCfgStats;
+
+// ─────────────────────────────────────────────
+//  설정기 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsSerial      *ser;
+    UbxParser       ubx;
+    int             timeout_ms;
+    int             retries;
+    uint8_t         want_cls, want_id;  // 기다리는 명령
+    uint8_t         want_poll;          // ACK 대신 같은 class/id 응답 대기
+    int8_t          result;             // 0 대기, 1 ACK/응답, -1 NAK
+    uint8_t        *resp;               // poll 응답 복사 위치
+    uint16_t        resp_max;
+    uint16_t        resp_len;
+    UbxCfgStats     stats;
+} UbxCfg;
+
+/**
+ * @brief 설정기 초기화 (timeout UBX_CFG_TIMEOUT_MS, 재전송 UBX_CFG_RETRIES)
+ * @param ser 열린 시리얼 포트 (보레이트 변경 시 함께 바뀜)
+ */
+void ubx_cfg_init(UbxCfg *c, GpsSerial *ser);
+
+/**
+ * @brief CFG 명령 전송 후 ACK 대기 (무응답이면 재전송)
+ */
+UbxCfgError ubx_cfg_send(UbxCfg *c, uint8_t cls, uint8_t id,
+                         const void *payload, uint16_t len);
+
+/**
+ * @brief poll 요청 후 같은 class/id 응답 payload 수신
+ * @param resp     응답 payload 복사 위치
+ * @param resp_len 입력: resp 크기, 출력: 응답 길이
+ */
+UbxCfgError ubx_cfg_poll(UbxCfg *c, uint8_t cls, uint8_t id,
+                         const void *req, uint16_t req_len,
+                         uint8_t *resp, uint16_t *resp_len);
+
+/**
+ * @brief 현재 보레이트 자동 탐지 (흔한 보레이트를 돌며 CFG-PRT poll)
+ * @return 탐지된 보레이트 (>0), 실패 시 UbxCfgError
+ */
+int ubx_cfg_detect(UbxCfg *c);
+
+/**
+ * @brief UART1 보레이트 / 프로토콜 변경 후 포트를 새 보레이트로 다시 맞춤
+ * @param in_proto/out_proto UBX_PROTO_* 조합
+ */
+UbxCfgError ubx_cfg_port(UbxCfg *c, int baud, uint16_t in_proto, uint16_t out_proto);
+
+/**
+ * @brief 측위 주기 (CFG-RATE, GPS 시간 기준, 1 측위당 1 출력)
+ * @param meas_ms 측위 간격 ms (NEO-6M 최소 200 = 5Hz)
+ */
+UbxCfgError ubx_cfg_rate(UbxCfg *c, int meas_ms);
+
+/**
+ * @brief 메시지 출력 주기 (CFG-MSG, 현재 포트)
+ * @param rate 0: 끔, N: N 측위마다 1회
+ */
+UbxCfgError ubx_cfg_msg(UbxCfg *c, uint8_t cls, uint8_t id, uint8_t rate);
+
+/**
+ * @brief 표준 NMEA 문장 출력 주기 (ubx_cfg_msg 의 NMEA 타입 버전)
+ */
+UbxCfgError ubx_cfg_nmea(UbxCfg *c, NmeaType type, uint8_t rate);
+
+/**
+ * @brief 현재 설정을 비휘발 영역에 저장 (CFG-CFG)
+ * @param devices UBX_DEV_* 조합
+ */
+UbxCfgError ubx_cfg_save(UbxCfg *c, uint8_t devices);
+
+/**
+ * @brief 오류 코드 → 설명 문자열
+ */
+const char *ubx_cfg_strerror(UbxCfgError err);
+
+#endif /* UBX_CFG_H */
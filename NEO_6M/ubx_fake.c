@@ -0,0 +1,503 @@
+// pty 기반 가짜 NEO-6M (UBX CFG 명령 응답)
+//
+// pty master 쪽에서 수신기처럼 동작한다.
+//   - 설정된 측위 주기 / 메시지 / 보레이트로 합성 NMEA, UBX NAV 출력
+//   - CFG-PRT / CFG-RATE / CFG-MSG / CFG-CFG 에 ACK-ACK / ACK-NAK 응답
+//   - 호스트 (slave) termios 보레이트가 수신기와 다르면 입력은 버리고
+//     출력은 깨진 바이트로 보냄 (실제 UART 불일치 재현)
+//   - 출력 버퍼 (FAKE_TXBUF) 가 넘치면 epoch 를 통째로 버림
+//   - SIGHUP: 전원 재투입 (CFG-CFG 로 저장한 설정으로 복귀)
+//
+// 빌드: make ubx_fake
+// 실행: ./ubx_fake [-b baud] [-r Hz] [-q]
+//       → 출력된 /dev/pts/N 으로 ./gps_config, ./gps_rate 등 실행
+
+#define _GNU_SOURCE             // posix_openpt, ptsname_r, ppoll
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <termios.h>
+#include <unistd.h>
+#include <time.h>
+#include "gps_fix.h"
+#include "gps_serial.h"
+#include "gps_synth.h"
+#include "ubx.h"
+#include "ubx_cfg.h"
+
+#define FAKE_TXBUF      1024    // 미송신 출력 한도 (바이트)
+#define FAKE_QUEUE      64      // 대기 메시지 수 한도
+#define FAKE_MSG_MAX    (UBX_SYNTH_EPOCH_MAX + 64)
+#define FAKE_MIN_MEAS   200     // NEO-6M 최대 5Hz
+
+// 출력 가능한 NAV 메시지 (u-blox 6)
+static const uint8_t nav_ids[] = { UBX_NAV_POSLLH, UBX_NAV_SOL, UBX_NAV_VELNED };
+#define NAV_COUNT       ((int)sizeof(nav_ids))
+
+// NEO-6M 출력 순서 (gps_synth 와 동일)
+static const NmeaType nmea_order[] = {
+    NMEA_RMC, NMEA_VTG, NMEA_GGA, NMEA_GSA, NMEA_GSV, NMEA_GLL,
+};
+static const uint8_t nmea_ids[NMEA_TYPE_COUNT] = {
+    [NMEA_GGA] = 0x00, [NMEA_GLL] = 0x01, [NMEA_GSA] = 0x02,
+    [NMEA_GSV] = 0x03, [NMEA_RMC] = 0x04, [NMEA_VTG] = 0x05,
+};
+
+typedef struct {
+    int      baud;
+    int      meas_ms;
+    uint16_t in_proto, out_proto;
+    uint8_t  nmea_rate[NMEA_TYPE_COUNT];
+    uint8_t  nav_rate[NAV_COUNT];
+} FakeCfg;
+
+typedef struct {
+    uint16_t len;
+    int      baud_after;            // 송신 완료 후 적용할 보레이트 (0: 없음)
+    uint8_t  data[FAKE_MSG_MAX];
+} FakeMsg;
+
+typedef struct {
+    FakeMsg  msg[FAKE_QUEUE];
+    int      head, count;
+    size_t   bytes;
+} FakeQueue;
+
+typedef struct {
+    int         master;
+    int         quiet;
+    FakeCfg     cur, saved, def;
+    UbxParser   ubx;
+    FakeQueue   resp;               // 명령 응답 (메시지 경계에서 우선 송신)
+    FakeQueue   data;               // 측위 출력
+    FakeMsg     out;                // 송신 중인 메시지
+    size_t      out_pos;
+    int64_t     tx_ns;              // 다음 바이트 송신 가능 시각
+    int64_t     next_epoch_ns;
+    int64_t     t_ms;               // 합성 GPS 시각 (epoch 시각 태그)
+    uint64_t    epoch;
+    uint64_t    dropped;
+    uint64_t    garbled_in;
+} Fake;
+
+static volatile sig_atomic_t power_cycle;
+
+static void on_sighup(int sig)
+{
+    (void)sig;
+    power_cycle = 1;
+}
+
+static void note(Fake *f, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void note(Fake *f, const char *fmt, ...)
+{
+    va_list ap;
+
+    if (f->quiet) return;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    fflush(stdout);
+}
+
+// ─────────────────────────────────────────────
+//  송신 큐
+// ─────────────────────────────────────────────
+static FakeMsg *q_tail(FakeQueue *q)
+{
+    if (q->count == FAKE_QUEUE) return NULL;
+    return &q->msg[(q->head + q->count) % FAKE_QUEUE];
+}
+
+static void q_commit(FakeQueue *q)
+{
+    q->bytes += q_tail(q)->len;
+    q->count++;
+}
+
+static int q_pop(FakeQueue *q, FakeMsg *out)
+{
+    if (!q->count) return 0;
+    *out      = q->msg[q->head];
+    q->head   = (q->head + 1) % FAKE_QUEUE;
+    q->bytes -= out->len;
+    q->count--;
+    return 1;
+}
+
+static void reply(Fake *f, uint8_t cls, uint8_t id, const void *pl, uint16_t len, int baud_after)
+{
+    FakeMsg *m = q_tail(&f->resp);
+    if (!m) return;
+    m->len        = (uint16_t)ubx_build(m->data, cls, id, pl, len);
+    m->baud_after = baud_after;
+    q_commit(&f->resp);
+}
+
+static void ack(Fake *f, const UbxFrame *fr, int ok, int baud_after)
+{
+    uint8_t pl[2] = { fr->cls, fr->id };
+    reply(f, UBX_ACK, ok ? UBX_ACK_ACK : UBX_ACK_NAK, pl, 2, baud_after);
+}
+
+// ─────────────────────────────────────────────
+//  CFG 명령 처리
+// ─────────────────────────────────────────────
+static int nav_index(uint8_t id)
+{
+    for (int i = 0; i < NAV_COUNT; i++)
+        if (nav_ids[i] == id) return i;
+    return -1;
+}
+
+static int nmea_index(uint8_t id)
+{
+    for (int t = 0; t < NMEA_TYPE_COUNT; t++)
+        if (nmea_ids[t] == id) return t;
+    return -1;
+}
+
+static uint8_t *msg_rate(FakeCfg *c, uint8_t cls, uint8_t id)
+{
+    int k;
+    if (cls == UBX_NMEA && (k = nmea_index(id)) >= 0) return &c->nmea_rate[k];
+    if (cls == UBX_NAV  && (k = nav_index(id))  >= 0) return &c->nav_rate[k];
+    return NULL;
+}
+
+static void port_payload(const FakeCfg *c, uint8_t *pl)
+{
+    memset(pl, 0, 20);
+    pl[0] = UBX_UART1;
+    ubx_put_u4(pl + 4, 0x000008D0u);
+    ubx_put_u4(pl + 8, (uint32_t)c->baud);
+    ubx_put_u2(pl + 12, c->in_proto);
+    ubx_put_u2(pl + 14, c->out_proto);
+}
+
+static void cfg_prt(Fake *f, const UbxFrame *fr)
+{
+    uint8_t pl[20];
+
+    if (fr->len <= 1) {                                     // poll
+        if (fr->len == 1 && fr->payload[0] != UBX_UART1) { ack(f, fr, 0, 0); return; }
+        port_payload(&f->cur, pl);
+        reply(f, UBX_CFG, UBX_CFG_PRT, pl, 20, 0);
+        ack(f, fr, 1, 0);
+        return;
+    }
+
+    int baud = (fr->len == 20) ? (int)ubx_u4(fr->payload + 8) : 0;
+    if (fr->payload[0] != UBX_UART1 || !gps_serial_speed(baud)) { ack(f, fr, 0, 0); return; }
+
+    f->cur.in_proto  = ubx_u2(fr->payload + 12);
+    f->cur.out_proto = ubx_u2(fr->payload + 14);
+    // ACK 는 옛 보레이트로 내보낸 뒤 전환
+    ack(f, fr, 1, baud);
+    note(f, "CFG-PRT  baud %d  in 0x%x out 0x%x\n", baud, f->cur.in_proto, f->cur.out_proto);
+}
+
+static void cfg_rate(Fake *f, const UbxFrame *fr)
+{
+    if (fr->len == 0) {
+        uint8_t pl[6];
+        ubx_put_u2(pl + 0, (uint16_t)f->cur.meas_ms);
+        ubx_put_u2(pl + 2, 1);
+        ubx_put_u2(pl + 4, 1);
+        reply(f, UBX_CFG, UBX_CFG_RATE, pl, 6, 0);
+        ack(f, fr, 1, 0);
+        return;
+    }
+
+    int meas = (fr->len == 6) ? ubx_u2(fr->payload) : 0;
+    // 합성기는 정수 Hz 만 지원
+    if (meas < FAKE_MIN_MEAS || 1000 % meas) { ack(f, fr, 0, 0); return; }
+
+    f->cur.meas_ms = meas;
+    f->t_ms        = (f->t_ms + meas - 1) / meas * meas;
+    ack(f, fr, 1, 0);
+    note(f, "CFG-RATE %d ms (%d Hz)\n", meas, 1000 / meas);
+}
+
+static void cfg_msg(Fake *f, const UbxFrame *fr)
+{
+    uint8_t *r;
+
+    if (fr->len < 2 || !(r = msg_rate(&f->cur, fr->payload[0], fr->payload[1]))) {
+        ack(f, fr, 0, 0);
+        return;
+    }
+    if (fr->len == 2) {                                     // poll
+        uint8_t pl[3] = { fr->payload[0], fr->payload[1], *r };
+        reply(f, UBX_CFG, UBX_CFG_MSG, pl, 3, 0);
+        ack(f, fr, 1, 0);
+        return;
+    }
+    // 3바이트: 현재 포트, 8바이트: 포트별 (UART1 = payload[3])
+    if (fr->len == 3)      *r = fr->payload[2];
+    else if (fr->len == 8) *r = fr->payload[2 + UBX_UART1];
+    else { ack(f, fr, 0, 0); return; }
+
+    ack(f, fr, 1, 0);
+    note(f, "CFG-MSG  %02X-%02X rate %d\n", fr->payload[0], fr->payload[1], *r);
+}
+
+static void cfg_cfg(Fake *f, const UbxFrame *fr)
+{
+    if (fr->len != 12 && fr->len != 13) { ack(f, fr, 0, 0); return; }
+
+    uint32_t clear = ubx_u4(fr->payload);
+    uint32_t save  = ubx_u4(fr->payload + 4);
+    uint32_t load  = ubx_u4(fr->payload + 8);
+    uint8_t  dev   = (fr->len == 13) ? fr->payload[12] : (UBX_DEV_BBR | UBX_DEV_FLASH);
+    int      baud  = 0;
+
+    if (clear) f->saved = f->def;
+    if (save)  f->saved = f->cur;
+    if (load) {
+        // 보레이트는 ACK 송신 후 전환
+        FakeCfg s = f->saved;
+        baud   = (s.baud != f->cur.baud) ? s.baud : 0;
+        s.baud = f->cur.baud;
+        f->cur = s;
+    }
+    ack(f, fr, 1, baud);
+    note(f, "CFG-CFG  clear 0x%x save 0x%x load 0x%x dev%s%s%s\n", clear, save, load,
+          (dev & UBX_DEV_BBR) ? " BBR" : "", (dev & UBX_DEV_FLASH) ? " flash" : "",
+          (dev & UBX_DEV_EEPROM) ? " EEPROM" : "");
+}
+
+static void on_cmd(const UbxFrame *fr, void *user)
+{
+    Fake *f = user;
+
+    if (fr->cls != UBX_CFG) return;             // CFG 외 poll 은 미지원 (무응답)
+
+    switch (fr->id) {
+        case UBX_CFG_PRT:  cfg_prt(f, fr);  break;
+        case UBX_CFG_RATE: cfg_rate(f, fr); break;
+        case UBX_CFG_MSG:  cfg_msg(f, fr);  break;
+        case UBX_CFG_CFG:  cfg_cfg(f, fr);  break;
+        default:           ack(f, fr, 0, 0); break;
+    }
+}
+
+// ─────────────────────────────────────────────
+//  출력
+// ─────────────────────────────────────────────
+static int host_speed_ok(Fake *f)
+{
+    struct termios t;
+    // pty master 의 termios 조회는 slave 설정을 돌려준다
+    if (tcgetattr(f->master, &t) < 0) return 1;
+    return cfgetospeed(&t) == gps_serial_speed(f->cur.baud);
+}
+
+static void queue_epoch(Fake *f)
+{
+    int      rate_hz = 1000 / f->cur.meas_ms;
+    int      i       = (int)(f->t_ms / f->cur.meas_ms);
+    FakeMsg  tmp[NMEA_TYPE_COUNT + NAV_COUNT];
+    int      nmsg = 0;
+    size_t   bytes = 0;
+
+    f->epoch++;
+    if (f->cur.out_proto & UBX_PROTO_NMEA) {
+        for (size_t k = 0; k < sizeof(nmea_order) / sizeof(nmea_order[0]); k++) {
+            uint8_t r = f->cur.nmea_rate[nmea_order[k]];
+            if (!r || f->epoch % r) continue;
+            tmp[nmsg].len = (uint16_t)nmea_synth_type((char *)tmp[nmsg].data, i, rate_hz, nmea_order[k]);
+            bytes += tmp[nmsg++].len;
+        }
+    }
+    if (f->cur.out_proto & UBX_PROTO_UBX) {
+        for (int k = 0; k < NAV_COUNT; k++) {
+            uint8_t r = f->cur.nav_rate[k];
+            if (!r || f->epoch % r) continue;
+            tmp[nmsg].len = (uint16_t)ubx_synth_nav(tmp[nmsg].data, i, rate_hz, nav_ids[k]);
+            bytes += tmp[nmsg++].len;
+        }
+    }
+
+    // 출력 버퍼가 넘치면 epoch 전체 유실 (보레이트 대비 출력 과다)
+    if (f->data.bytes + bytes > FAKE_TXBUF || f->data.count + nmsg > FAKE_QUEUE) {
+        f->dropped++;
+        return;
+    }
+    for (int k = 0; k < nmsg; k++) {
+        FakeMsg *m = q_tail(&f->data);
+        memcpy(m->data, tmp[k].data, tmp[k].len);
+        m->len        = tmp[k].len;
+        m->baud_after = 0;
+        q_commit(&f->data);
+    }
+}
+
+/**
+ * @brief 보레이트 속도로 가능한 만큼 write
+ * @return 다음 송신 시각 (송신할 것 없으면 INT64_MAX)
+ */
+static int64_t pump(Fake *f, int64_t now)
+{
+    int64_t byte_ns = 10000000000LL / f->cur.baud;          // 8N1 = 10 bit
+    uint8_t buf[FAKE_MSG_MAX];
+
+    for (;;) {
+        if (f->out_pos == f->out.len) {
+            // 보레이트 전환은 ACK 마지막 바이트가 선로를 떠난 뒤
+            if (f->out.baud_after) {
+                if (now < f->tx_ns) return f->tx_ns;
+                f->cur.baud     = f->out.baud_after;
+                f->out.baud_after = 0;
+                byte_ns         = 10000000000LL / f->cur.baud;
+            }
+            f->out_pos = 0;
+            f->out.len = 0;
+            if (!q_pop(&f->resp, &f->out) && !q_pop(&f->data, &f->out))
+                return INT64_MAX;
+            if (f->tx_ns < now) f->tx_ns = now;
+        }
+        if (now < f->tx_ns) return f->tx_ns;
+
+        size_t k = (size_t)((now - f->tx_ns) / byte_ns) + 1;
+        if (k > f->out.len - f->out_pos) k = f->out.len - f->out_pos;
+
+        memcpy(buf, f->out.data + f->out_pos, k);
+        if (!host_speed_ok(f))
+            for (size_t j = 0; j < k; j++) buf[j] = (uint8_t)(buf[j] * 7 + 0x93);
+
+        // slave 쪽 버퍼가 가득 차면 (읽는 쪽 없음) 버림
+        if (write(f->master, buf, k) < 0 && errno != EAGAIN) return -1;
+        f->out_pos += k;
+        f->tx_ns   += (int64_t)k * byte_ns;
+    }
+}
+
+static void handle_input(Fake *f)
+{
+    uint8_t buf[256];
+    ssize_t n;
+
+    while ((n = read(f->master, buf, sizeof(buf))) > 0) {
+        if (!host_speed_ok(f)) {
+            // 보레이트 불일치: 프레이밍 오류로 읽히지 않음
+            f->garbled_in += (uint64_t)n;
+            ubx_parser_reset(&f->ubx);
+            continue;
+        }
+        ubx_parser_feed_at(&f->ubx, buf, (size_t)n, gps_now_ns());
+    }
+}
+
+static void fake_reset(Fake *f)
+{
+    f->cur = f->saved;
+    f->resp.count = f->resp.head = 0;
+    f->data.count = f->data.head = 0;
+    f->resp.bytes = f->data.bytes = 0;
+    f->out.len = f->out_pos = 0;
+    f->out.baud_after = 0;
+    ubx_parser_reset(&f->ubx);
+    f->t_ms = (f->t_ms + f->cur.meas_ms - 1) / f->cur.meas_ms * f->cur.meas_ms;
+    note(f, "power cycle: %d baud, %d ms\n", f->cur.baud, f->cur.meas_ms);
+}
+
+static int open_pty(char *path, size_t len, int baud)
+{
+    struct termios t;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) return -1;
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0 || ptsname_r(fd, path, len) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    // slave 를 하나 열어 둔다: 호스트가 닫아도 HUP 없음, 초기값은 raw (echo 없음)
+    int keep = open(path, O_RDWR | O_NOCTTY);
+    if (keep < 0 || tcgetattr(keep, &t) < 0) { close(fd); return -1; }
+    cfmakeraw(&t);
+    cfsetispeed(&t, gps_serial_speed(baud));
+    cfsetospeed(&t, gps_serial_speed(baud));
+    tcsetattr(keep, TCSANOW, &t);
+    return fd;
+}
+
+int main(int argc, char **argv)
+{
+    static Fake f;
+    int  rate_hz = 1, baud = GPS_SERIAL_BAUD, opt;
+    char path[64];
+
+    while ((opt = getopt(argc, argv, "b:r:q")) != -1) {
+        switch (opt) {
+            case 'b': baud    = atoi(optarg); break;
+            case 'r': rate_hz = atoi(optarg); break;
+            case 'q': f.quiet = 1;            break;
+            default:
+                fprintf(stderr, "usage: %s [-b baud] [-r Hz] [-q]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (!gps_serial_speed(baud) || rate_hz <= 0 || 1000 % rate_hz || 1000 / rate_hz < FAKE_MIN_MEAS) {
+        fprintf(stderr, "invalid baud/rate\n");
+        return 1;
+    }
+
+    // 공장 기본값: 모든 NMEA 1회/epoch, UBX NAV 끔, UBX+NMEA 입출력
+    f.def.baud      = baud;
+    f.def.meas_ms   = 1000 / rate_hz;
+    f.def.in_proto  = UBX_PROTO_UBX | UBX_PROTO_NMEA;
+    f.def.out_proto = UBX_PROTO_UBX | UBX_PROTO_NMEA;
+    memset(f.def.nmea_rate, 1, sizeof(f.def.nmea_rate));
+    f.cur = f.saved = f.def;
+
+    f.master = open_pty(path, sizeof(path), baud);
+    if (f.master < 0) { perror("pty"); return 1; }
+    ubx_parser_init(&f.ubx, on_cmd, &f);
+    signal(SIGHUP, on_sighup);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("%s  (%d baud, %d Hz, NMEA)\n", path, baud, rate_hz);
+    fflush(stdout);
+
+    int64_t now = gps_now_ns();
+    f.next_epoch_ns = now;
+    f.tx_ns         = now;
+
+    for (;;) {
+        now = gps_now_ns();
+
+        if (power_cycle) {
+            power_cycle = 0;
+            fake_reset(&f);
+        }
+        while (now >= f.next_epoch_ns) {
+            queue_epoch(&f);
+            f.t_ms          += f.cur.meas_ms;
+            f.next_epoch_ns += (int64_t)f.cur.meas_ms * 1000000;
+        }
+
+        int64_t wake = pump(&f, now);
+        if (wake < 0) { perror("pty write"); break; }
+        if (wake > f.next_epoch_ns) wake = f.next_epoch_ns;
+
+        int64_t wait = wake - gps_now_ns();
+        if (wait < 0) wait = 0;
+        struct timespec ts = { .tv_sec = wait / 1000000000LL, .tv_nsec = wait % 1000000000LL };
+        struct pollfd   pfd = { .fd = f.master, .events = POLLIN };
+
+        if (ppoll(&pfd, 1, &ts, NULL) > 0 && (pfd.revents & POLLIN))
+            handle_input(&f);
+    }
+
+    close(f.master);
+    return 0;
+}
@@ -0,0 +1,522 @@
+// warm / hot start (gps_warm) 벤치마크
+//
+// 가상 시간으로 모의 수신기와 호스트 파이프라인 (gps_stream → gps_epoch → gps_kf, gps_warm)
+// 을 돌린다. 1차 세션은 cold start 로 시작해 AID-DATA poll 응답과 필터 상태를 파일에
+// 저장하고, 전원을 끈 뒤 시나리오별로 다시 켜서 (상태 파일 읽기 → 필터 복원 → aiding
+// 프레임을 9600 baud 로 송신) 다음을 잰다.
+//   위치: 필터 위치를 처음 쓸 수 있는 시각 (복원하면 0)
+//   TTFF: 수신기 첫 위치 fix
+//   수렴: 필터 수평 σ 가 1차 세션 정상 상태의 CONV_RATIO 배 이하가 된 시각
+//
+// 모의 수신기 (NEO-6M 을 단순화, 정지 상태)
+//   - 위성 포착: cold 2~5 s, 위치 + 시각 aiding 후 0.5~1.5 s
+//   - 시각: aiding 이 없으면 포착 후 다음 subframe 의 HOW (6 s 주기) 에서
+//   - 궤도 정보: 현재 시각에 유효한 (toe ±2 h) AID-EPH 가 4개 이상이면 그것을 쓰고,
+//     없으면 방송에서 subframe 1~3 (30 s 프레임 안 각 6 s) 을 모두 받을 때까지
+//   - fix: 셋 다 갖춘 뒤 다음 1 s 경계, 위치 오차 Gauss-Markov σ 1.5 m (τ 60 s)
+//   - AID-DATA poll 응답은 지연 없이 한 번에 (대역폭 무시)
+//
+// 실행: ./warm_bench [-n trials] [-s seed] [-D host_delay_s]
+//         -D  수신기 전원 투입 후 호스트 프로그램이 시작하기까지 (기본 0)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "geo.h"
+#include "gps_epoch.h"
+#include "gps_kf.h"
+#include "gps_stream.h"
+#include "gps_synth.h"
+#include "gps_warm.h"
+#include "nmea_msg.h"
+#include "ubx.h"
+
+#define LAT0            37.5665
+#define LON0            126.9780
+#define HEIGHT_MSL      52.3
+#define GEOID           18.4
+#define REAL0_S         1792368000LL    // 2026-10-19 00:00:00 UTC
+#define GPS0_S          (REAL0_S - 315964800LL + GPS_WARM_LEAP_S)
+#define BAUD_BYTE_NS    (10 * 1000000000LL / 9600)
+#define SESSION1_S      900             // 1차 세션 길이 (poll 은 첫 fix + GPS_WARM_SAVE_S)
+#define RUN_S           120             // 재시작 후 관찰 구간
+#define CONV_RATIO      1.1
+#define NOISE_SIGMA     1.5
+#define NOISE_TAU       60.0
+#define VISIBLE         9               // 보이는 위성 수
+#define ACQ_COLD_MIN    2.0
+#define ACQ_COLD_SPAN   3.0
+#define ACQ_AIDED_MIN   0.5
+#define ACQ_AIDED_SPAN  1.0
+#define HOW_DELAY       1.2             // subframe 시작 → HOW 해독 (s)
+#define MAX_TRIALS      10000
+
+static const int visible_sv[VISIBLE] = { 2, 5, 12, 13, 15, 18, 20, 24, 29 };
+
+// gps_epoch 발행 시각용 가상 시계
+static int64_t vnow;
+
+static int64_t vclock(void)
+{
+    return vnow;
+}
+
+// ─────────────────────────────────────────────
+//  모의 수신기
+// ─────────────────────────────────────────────
+typedef struct {
+    double    gps0;                 // 전원 투입 시 GPS 시각 (s, GPS 원점 이후)
+    double    t;                    // 전원 투입 후 (s)
+    double    move_e, move_n;       // 1차 세션 위치에서 옮긴 거리 (m)
+    double    acq_u;                // 포착 시간 난수
+    int       running;              // 이미 fix 중 (전원 유지, 호스트만 재시작)
+    double    pos_aid_t, time_aid_t;    // aiding 받은 시각 (음수: 없음)
+    int       eph_valid;
+    double    eph_t;                // 마지막 유효 EPH 받은 시각
+    double    ne, nn;               // 위치 잡음
+    UbxParser ubx;
+    uint8_t   resp[8192];           // AID-DATA poll 응답
+    size_t    resp_len;
+} SimRx;
+
+static double gps_time(const SimRx *rx)
+{
+    return rx->gps0 + rx->t;
+}
+
+// toe: 2 시간마다 갱신, 갱신 구간 가운데 (fit interval 4 h)
+static uint32_t sim_toe(double gps_s)
+{
+    double tow = fmod(gps_s, 604800.0);
+    return (uint32_t)(floor(tow / 7200.0) * 7200.0 + 3600.0);
+}
+
+static void rx_poll_reply(SimRx *rx)
+{
+    uint8_t pl[UBX_AID_EPH_LEN];
+    double  g = gps_time(rx);
+    size_t  n = 0;
+
+    memset(pl, 0, sizeof(pl));
+    n += ubx_build(rx->resp + n, UBX_AID, UBX_AID_HUI, pl, UBX_AID_HUI_LEN);
+    for (int sv = 1; sv <= GPS_WARM_SV; sv++) {
+        memset(pl, 0, sizeof(pl));
+        ubx_put_u4(pl, (uint32_t)sv);
+        n += ubx_build(rx->resp + n, UBX_AID, UBX_AID_ALM, pl, UBX_AID_ALM_LEN);
+    }
+    for (int sv = 1; sv <= GPS_WARM_SV; sv++) {
+        int vis = 0;
+        for (int k = 0; k < VISIBLE; k++) vis |= (visible_sv[k] == sv);
+        memset(pl, 0, sizeof(pl));
+        ubx_put_u4(pl, (uint32_t)sv);
+        // subframe 2 word 10 의 toe (16 s 단위), u-blox 형식은 워드당 24bit (bit 23 이 MSB)
+        ubx_put_u4(pl + 40 + 7 * 4, (sim_toe(g) / 16) << 8);
+        n += ubx_build(rx->resp + n, UBX_AID, UBX_AID_EPH, pl, vis ? UBX_AID_EPH_LEN : 8);
+    }
+    rx->resp_len = n;
+}
+
+static void rx_on_frame(const UbxFrame *f, void *user)
+{
+    SimRx *rx = user;
+
+    if (f->cls != UBX_AID) return;
+    if (f->id == UBX_AID_DATA && f->len == 0) {
+        rx_poll_reply(rx);
+    } else if (f->id == UBX_AID_INI && f->len == UBX_AID_INI_LEN) {
+        uint32_t flags = ubx_u4(f->payload + 44);
+        // 위치는 수백 km 까지 포착에 도움, 시각은 tAcc 10 s 이내면 사용
+        if (flags & UBX_INI_POS) rx->pos_aid_t = rx->t;
+        if ((flags & UBX_INI_TIME) && ubx_u4(f->payload + 28) <= 10000) rx->time_aid_t = rx->t;
+    } else if (f->id == UBX_AID_EPH && f->len == UBX_AID_EPH_LEN) {
+        uint32_t toe = (ubx_u4(f->payload + 68) >> 8) * 16;
+        double   tow = fmod(gps_time(rx), 604800.0);
+        if (fabs(tow - toe) <= 7200.0) {
+            rx->eph_valid++;
+            rx->eph_t = rx->t;
+        }
+    }
+}
+
+static void rx_boot(SimRx *rx, double gps0, int running)
+{
+    memset(rx, 0, sizeof(SimRx));
+    rx->gps0       = gps0;
+    rx->running    = running;
+    rx->acq_u      = synth_urand();
+    rx->pos_aid_t  = rx->time_aid_t = -1.0;
+    rx->ne         = NOISE_SIGMA * synth_grand();     // 정상 상태에서 시작
+    rx->nn         = NOISE_SIGMA * synth_grand();
+    ubx_parser_init(&rx->ubx, rx_on_frame, rx);
+}
+
+/**
+ * @brief 지금까지 받은 aiding 으로 첫 fix 가능 시각 (전원 투입 후 s)
+ */
+static double rx_fix_time(const SimRx *rx)
+{
+    double acq, tk, eph;
+
+    if (rx->running) return 0.0;
+
+    acq = ACQ_COLD_MIN + ACQ_COLD_SPAN * rx->acq_u;
+    if (rx->pos_aid_t >= 0.0 && rx->time_aid_t >= 0.0)
+        acq = fmin(acq, fmax(rx->pos_aid_t, rx->time_aid_t) + ACQ_AIDED_MIN + ACQ_AIDED_SPAN * rx->acq_u);
+
+    // 시각: aiding 또는 포착 후 첫 HOW
+    double g_acq = rx->gps0 + acq;
+    double how   = ceil(g_acq / 6.0) * 6.0 + HOW_DELAY - rx->gps0;
+    tk = (rx->time_aid_t >= 0.0) ? fmax(acq, rx->time_aid_t) : how;
+
+    if (rx->eph_valid >= 4) {
+        eph = fmax(acq, rx->eph_t);
+    } else {
+        // 방송 궤도 정보: subframe 1~3 을 각각 처음부터 끝까지
+        eph = acq;
+        for (int k = 0; k < 3; k++) {
+            double start = ceil((g_acq - 6.0 * k) / 30.0) * 30.0 + 6.0 * k;
+            eph = fmax(eph, start + 6.0 - rx->gps0);
+        }
+    }
+    return fmax(acq, fmax(tk, eph));
+}
+
+/**
+ * @brief 호스트 → 수신기 바이트 (도착 시각 t_s)
+ */
+static void rx_input(SimRx *rx, const uint8_t *data, size_t len, double t_s)
+{
+    rx->t = t_s;
+    ubx_parser_feed_at(&rx->ubx, data, len, 0);
+}
+
+static void fmt_utc(char *out, size_t len, double gps_s)
+{
+    int64_t ms = (int64_t)llround((gps_s - GPS_WARM_LEAP_S) * 1000.0) % 86400000;
+    snprintf(out, len, "%02d%02d%02d.00", (int)(ms / 3600000), (int)(ms / 60000 % 60),
+             (int)(ms / 1000 % 60));
+}
+
+/**
+ * @brief 1 s 경계 epoch 의 출력 (NMEA RMC VTG GGA GSA + 대기 중인 poll 응답)
+ */
+static size_t rx_epoch(SimRx *rx, double t, const GeoLtp *ltp, char *out)
+{
+    char   body[160], utc[16];
+    size_t n = 0;
+    double a = exp(-1.0 / NOISE_TAU), b = NOISE_SIGMA * sqrt(1.0 - a * a);
+
+    rx->t  = t;
+    rx->ne = a * rx->ne + b * synth_grand();
+    rx->nn = a * rx->nn + b * synth_grand();
+    fmt_utc(utc, sizeof(utc), gps_time(rx));
+
+    if (t + 1e-9 < rx_fix_time(rx)) {
+        snprintf(body, sizeof(body), "GPRMC,%s,V,,,,,,,191026,,,N", utc);
+        n += nmea_synth_sentence(out + n, body);
+        n += nmea_synth_sentence(out + n, "GPVTG,,,,,,,,,N");
+        snprintf(body, sizeof(body), "GPGGA,%s,,,,,0,00,99.99,,,,,,", utc);
+        n += nmea_synth_sentence(out + n, body);
+        n += nmea_synth_sentence(out + n, "GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99");
+    } else {
+        double lat, lon;
+        geo_ltp_inv(ltp, rx->move_e + rx->ne, rx->move_n + rx->nn, &lat, &lon);
+        double la = fabs(lat), lo = fabs(lon);
+        int    lad = (int)la, lod = (int)lo;
+        char   pos[64];
+        snprintf(pos, sizeof(pos), "%02d%08.5f,N,%03d%08.5f,E", lad, (la - lad) * 60.0, lod, (lo - lod) * 60.0);
+
+        snprintf(body, sizeof(body), "GPRMC,%s,A,%s,0.010,,191026,,,A", utc, pos);
+        n += nmea_synth_sentence(out + n, body);
+        n += nmea_synth_sentence(out + n, "GPVTG,,T,,M,0.010,N,0.019,K,A");
+        snprintf(body, sizeof(body), "GPGGA,%s,%s,1,08,1.00,%.1f,M,%.1f,M,,", utc, pos, HEIGHT_MSL, GEOID);
+        n += nmea_synth_sentence(out + n, body);
+        n += nmea_synth_sentence(out + n, "GPGSA,A,3,02,05,12,13,15,18,20,24,29,,,,1.90,1.00,1.62");
+    }
+    if (rx->resp_len) {
+        memcpy(out + n, rx->resp, rx->resp_len);
+        n += rx->resp_len;
+        rx->resp_len = 0;
+    }
+    return n;
+}
+
+// ─────────────────────────────────────────────
+//  호스트 (kalman_neo 와 같은 파이프라인)
+// ─────────────────────────────────────────────
+typedef struct {
+    GpsStream    stream;
+    NmeaDispatch disp;
+    GpsEpoch     epoch;
+    GpsKf        kf;
+    GpsWarm      warm;
+    int64_t      real0_ns;          // 전원 투입 시 CLOCK_REALTIME
+    double       t;                 // 전원 투입 후 (s)
+    double       first_fix;         // -1: 없음
+    double       first_err;         // 첫 fix 직후 필터 위치 오차 (m)
+    const GeoLtp *ltp;
+    const SimRx  *rx;
+} Host;
+
+static double kf_err(const Host *h)
+{
+    double lat, lon, e, n;
+    gps_kf_position(&h->kf, &lat, &lon);
+    geo_ltp_fwd(h->ltp, lat, lon, &e, &n);
+    return hypot(e - h->rx->move_e, n - h->rx->move_n);
+}
+
+static void host_on_ubx(const UbxFrame *f, void *user)
+{
+    Host *h = user;
+
+    if (gps_warm_on_ubx(&h->warm, f, h->real0_ns + (int64_t)(h->t * 1e9))) return;
+    gps_epoch_on_ubx(f, &h->epoch);
+}
+
+static void host_on_fix(const GpsFix *f, void *user)
+{
+    Host   *h = user;
+    int64_t real_ns = h->real0_ns + (int64_t)(h->t * 1e9);
+
+    if (!gps_kf_update_fix(&h->kf, f)) return;
+    if (h->first_fix < 0.0) {
+        h->first_fix = h->t;
+        h->first_err = kf_err(h);
+    }
+    gps_warm_set_fix(&h->warm, f, real_ns);
+    gps_warm_set_kf(&h->warm, &h->kf, real_ns);
+}
+
+static void host_init(Host *h, const GeoLtp *ltp, const SimRx *rx, int64_t real0_ns)
+{
+    memset(h, 0, sizeof(Host));
+    h->ltp       = ltp;
+    h->rx        = rx;
+    h->real0_ns  = real0_ns;
+    h->first_fix = -1.0;
+    gps_kf_init(&h->kf, 0.0);
+    gps_warm_init(&h->warm);
+    gps_epoch_init(&h->epoch, host_on_fix, h);
+    gps_epoch_set_clock(&h->epoch, vclock);
+    nmea_dispatch_init(&h->disp);
+    gps_epoch_attach(&h->epoch, &h->disp);
+    gps_stream_init(&h->stream, nmea_dispatch_sentence, &h->disp, host_on_ubx, h);
+}
+
+/**
+ * @brief 수신기 epoch 1개를 호스트에 전달 (바이트 도착 후 timeout 으로 epoch 닫음)
+ */
+static void step(Host *h, SimRx *rx, double t)
+{
+    static char buf[16384];
+    size_t      n = rx_epoch(rx, t, h->ltp, buf);
+    int64_t     rx_ns = (int64_t)(t * 1e9) + (int64_t)n * BAUD_BYTE_NS;
+
+    h->t = t + n * BAUD_BYTE_NS / 1e9;
+    vnow = rx_ns;
+    gps_stream_feed(&h->stream, buf, n, rx_ns);
+    vnow = rx_ns + (GPS_EPOCH_TIMEOUT_MS + 1) * 1000000LL;
+    gps_epoch_poll(&h->epoch, rx_ns, vnow);
+}
+
+// ─────────────────────────────────────────────
+//  1차 세션: cold start → AID-DATA poll → 저장
+// ─────────────────────────────────────────────
+typedef struct {
+    double gps_end;                 // 1차 세션 종료 GPS 시각
+    double sigma_ss;                // 정상 상태 필터 수평 σ
+    int    eph;
+} Session1;
+
+static int session1(const GeoLtp *ltp, double gps0, const char *path, Session1 *s1)
+{
+    SimRx rx;
+    Host  h;
+    int   polled = 0;
+
+    rx_boot(&rx, gps0, 0);
+    host_init(&h, ltp, &rx, (int64_t)((gps0 - GPS0_S + REAL0_S) * 1e9));
+
+    for (int t = 1; t <= SESSION1_S; t++) {
+        step(&h, &rx, t);
+        if (!polled && h.first_fix >= 0.0 && t >= h.first_fix + GPS_WARM_SAVE_S) {
+            uint8_t req[UBX_FRAME_OVERHEAD];
+            rx_input(&rx, req, ubx_build(req, UBX_AID, UBX_AID_DATA, NULL, 0), t);
+            polled = 1;
+        }
+    }
+    s1->gps_end  = gps0 + SESSION1_S;
+    s1->sigma_ss = gps_kf_sigma(&h.kf);
+    s1->eph      = gps_warm_eph_count(&h.warm);
+    return gps_warm_save(&h.warm, path);
+}
+
+// ─────────────────────────────────────────────
+//  재시작 시나리오
+// ─────────────────────────────────────────────
+typedef struct {
+    const char *name;
+    int         use_state;          // 상태 파일 읽기 + 필터 복원
+    int         aid;                // 수신기 aiding
+    double      gap_s;              // 꺼져 있던 시간
+    int         tacc_ms;            // 시각 aiding 정확도 (음수: 시계 미동기)
+    double      move_m;             // 꺼져 있는 동안 이동
+    int         running;            // 수신기는 계속 켜져 있음 (호스트만 재시작)
+} Scenario;
+
+static const Scenario scenarios[] = {
+    { "cold (no state)",            0, 0,     600.0,  20,    0.0, 0 },
+    { "host restart 5 s",           1, 1,       5.0,  20,    0.0, 1 },
+    { "off 10 min, filter only",    1, 0,     600.0,  20,    0.0, 0 },
+    { "off 10 min, aid",            1, 1,     600.0,  20,    0.0, 0 },
+    { "off 10 min, aid, no clock",  1, 1,     600.0,  -1,    0.0, 0 },
+    { "off 10 min, moved 2 km",     1, 1,     600.0,  20, 2000.0, 0 },
+    { "off 6 h, aid (eph stale)",   1, 1,   21600.0,  20,    0.0, 0 },
+};
+#define SCENARIOS   ((int)(sizeof(scenarios) / sizeof(scenarios[0])))
+
+typedef struct {
+    double pos_avail, ttff, conv, first_err;
+    int    kept;                    // 복원 상태로 이어감 (첫 fix 에서 재초기화 안 함)
+    size_t aid_bytes;
+} Trial;
+
+static int restart(const Scenario *sc, const GeoLtp *ltp, const Session1 *s1, const char *path,
+                   double host_delay, Trial *tr)
+{
+    static uint8_t aid[GPS_WARM_AID_MAX];
+    SimRx rx;
+    Host  h;
+    double gps0 = s1->gps_end + sc->gap_s;
+
+    rx_boot(&rx, gps0, sc->running);
+    rx.move_e = sc->move_m * 0.6;
+    rx.move_n = sc->move_m * 0.8;
+    host_init(&h, ltp, &rx, (int64_t)((gps0 - GPS0_S + REAL0_S) * 1e9));
+    memset(tr, 0, sizeof(Trial));
+    tr->pos_avail = tr->conv = -1.0;
+
+    h.t = host_delay;
+    if (sc->use_state) {
+        int64_t now = h.real0_ns + (int64_t)(host_delay * 1e9);
+        if (gps_warm_load(&h.warm, path) < 0) return -1;
+        if (gps_warm_restore_kf(&h.warm, &h.kf, now) == 0) tr->pos_avail = host_delay;
+
+        if (sc->aid) {
+            // 프레임마다 9600 baud 로 도착
+            size_t n = gps_warm_build_aid(&h.warm, aid, sizeof(aid), now, sc->tacc_ms);
+            size_t off = 0;
+            while (off < n) {
+                size_t len = UBX_FRAME_OVERHEAD + ubx_u2(aid + off + 4);
+                rx_input(&rx, aid + off, len, host_delay + (off + len) * BAUD_BYTE_NS / 1e9);
+                off += len;
+            }
+            tr->aid_bytes = n;
+        }
+    }
+    if (tr->pos_avail >= 0.0 && gps_kf_sigma(&h.kf) <= CONV_RATIO * s1->sigma_ss)
+        tr->conv = tr->pos_avail;
+
+    for (int t = (int)ceil(host_delay); t <= RUN_S; t++) {
+        if (t <= 0) continue;
+        step(&h, &rx, t);
+        if (tr->pos_avail < 0.0 && h.first_fix >= 0.0) tr->pos_avail = h.first_fix;
+        if (tr->conv < 0.0 && h.first_fix >= 0.0 && gps_kf_sigma(&h.kf) <= CONV_RATIO * s1->sigma_ss)
+            tr->conv = h.t;
+    }
+    tr->ttff      = h.first_fix;
+    tr->first_err = h.first_err;
+    tr->kept      = sc->use_state && h.kf.stats.resets == 0;
+    return 0;
+}
+
+static double pct(double *v, int n, double p)
+{
+    int k = 0;
+    for (int i = 0; i < n; i++)
+        if (v[i] >= 0.0) v[k++] = v[i];
+    if (k == 0) return NAN;
+    qsort(v, (size_t)k, sizeof(double), synth_cmp_double);
+    return v[(int)(p * (k - 1) + 0.5)];
+}
+
+int main(int argc, char **argv)
+{
+    int         trials = 200, opt;
+    double      host_delay = 0.0;
+    uint64_t    seed = 1;
+    char        path[64];
+    GeoLtp      ltp;
+
+    while ((opt = getopt(argc, argv, "n:s:D:")) != -1) {
+        switch (opt) {
+            case 'n': trials     = atoi(optarg);                break;
+            case 's': seed       = strtoull(optarg, NULL, 0);   break;
+            case 'D': host_delay = atof(optarg);                break;
+            default:
+                fprintf(stderr, "usage: %s [-n trials] [-s seed] [-D host_delay_s]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (trials < 1 || trials > MAX_TRIALS || host_delay < 0.0) {
+        fprintf(stderr, "trials 1..%d, host_delay >= 0\n", MAX_TRIALS);
+        return 1;
+    }
+    synth_seed(SYNTH_SEED + seed * 0x9E3779B97F4A7C15ULL);
+    snprintf(path, sizeof(path), "/tmp/warm_bench.%d", (int)getpid());
+    geo_ltp_init(&ltp, LAT0, LON0, 0.0);
+
+    static double pos[SCENARIOS][MAX_TRIALS], ttff[SCENARIOS][MAX_TRIALS];
+    static double conv[SCENARIOS][MAX_TRIALS], ferr[SCENARIOS][MAX_TRIALS];
+    int           kept[SCENARIOS] = {0};
+    size_t        aid_bytes[SCENARIOS] = {0};
+    double        sigma_ss = 0.0, eph = 0.0;
+
+    for (int i = 0; i < trials; i++) {
+        Session1 s1;
+        double   gps0 = GPS0_S + synth_urand() * 86400.0;     // 하루 중 아무 때나
+
+        if (session1(&ltp, gps0, path, &s1) < 0) {
+            perror(path);
+            return 1;
+        }
+        sigma_ss += s1.sigma_ss;
+        eph      += s1.eph;
+
+        for (int s = 0; s < SCENARIOS; s++) {
+            Trial tr;
+            if (restart(&scenarios[s], &ltp, &s1, path, host_delay, &tr) < 0) {
+                perror(path);
+                unlink(path);
+                return 1;
+            }
+            pos[s][i]  = tr.pos_avail;
+            ttff[s][i] = tr.ttff;
+            conv[s][i] = tr.conv;
+            ferr[s][i] = tr.first_err;
+            kept[s]   += tr.kept;
+            aid_bytes[s] = tr.aid_bytes;
+        }
+    }
+    unlink(path);
+
+    printf("warm start: %d trials, host starts %.1f s after receiver power-on\n", trials, host_delay);
+    printf("  session 1: %d s cold start, steady filter sigma %.2f m, ephemeris saved %.1f SVs\n",
+           SESSION1_S, sigma_ss / trials, eph / trials);
+    printf("  converged: horizontal sigma <= %.1f x steady state\n\n", CONV_RATIO);
+    printf("%-28s %6s %7s  %13s  %13s  %9s %5s\n", "scenario", "aid B", "pos p50",
+           "TTFF p50/p90", "conv p50/p90", "1st err", "kept");
+    for (int s = 0; s < SCENARIOS; s++) {
+        double p50 = pct(pos[s], trials, 0.5);
+        double t50 = pct(ttff[s], trials, 0.5), t90 = pct(ttff[s], trials, 0.9);
+        double c50 = pct(conv[s], trials, 0.5), c90 = pct(conv[s], trials, 0.9);
+        double e50 = pct(ferr[s], trials, 0.5);
+        printf("%-28s %6zu %6.1fs  %5.1f / %5.1fs  %5.1f / %5.1fs  %7.2f m %4d%%\n",
+               scenarios[s].name, aid_bytes[s], p50, t50, t90, c50, c90, e50,
+               scenarios[s].use_state ? kept[s] * 100 / trials : 0);
+    }
+    return 0;
+}
@@ -0,0 +1,322 @@
+// 윈도우 통계 벤치마크: 기존 평균 큐 (gps_neo.c 의 전체 재합산) vs win_stat
+//
+//  1. 정확성: 무작위 (동일 값 포함) 입력에서 평균 / 분산 / 중앙값 / MAD 를
+//     매번 정렬한 결과와 비교
+//  2. 누적 오차: 위도 (도) 를 천만 번 넣고 뺀 뒤 단순 누적 합 / 보정 합의 평균 오차
+//  3. 비용: 윈도우 20 ~ 10000 에서 fix 1개 (위도/경도 2축) 당 ns
+//  4. 견고성: 정지 상태 NEO-6M 잡음 + 다중경로 튐에서 평균 큐 / MAD 기각 평균 /
+//     중앙값의 위치 RMSE / 최대 오차
+//
+// 빌드: make win_bench
+// 실행: ./win_bench [outlier%]   (기본 2)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "geo.h"
+#include "gps_fix.h"
+#include "win_stat.h"
+#include "gps_synth.h"
+
+#define LAT0        37.5665
+#define LON0        126.9780
+#define WORK        400000000.0     // 방법별 측정 작업량 상한 (원소 연산 수)
+#define MAX_PUSH    200000
+
+static const size_t windows[] = { 20, 100, 1000, 10000 };
+#define WINDOW_COUNT (int)(sizeof(windows) / sizeof(windows[0]))
+
+// ─────────────────────────────────────────────
+//  기존 방식 (gps_neo.c 와 동일: 원형 큐 + 매번 전체 합)
+// ─────────────────────────────────────────────
+typedef struct {
+    double *lat, *lon;
+    size_t  cap, idx, count;
+} Legacy;
+
+static void legacy_push(Legacy *q, double lat, double lon, double *lat_avg, double *lon_avg)
+{
+    q->lat[q->idx] = lat;
+    q->lon[q->idx] = lon;
+    q->idx = (q->idx + 1) % q->cap;
+    if (q->count < q->cap) q->count++;
+
+    double lat_sum = 0.0, lon_sum = 0.0;
+    for (size_t j = 0; j < q->count; j++) {
+        lat_sum += q->lat[j];
+        lon_sum += q->lon[j];
+    }
+    *lat_avg = lat_sum / q->count;
+    *lon_avg = lon_sum / q->count;
+}
+
+// ─────────────────────────────────────────────
+//  1. 정확성
+// ─────────────────────────────────────────────
+static double sorted_median(double *v, size_t n)
+{
+    qsort(v, n, sizeof(double), synth_cmp_double);
+    return (n & 1) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+static int check(void)
+{
+    static const size_t caps[] = { 1, 2, 3, 7, 20, 64 };
+    double  ring[64], tmp[64];
+    int     bad = 0;
+
+    for (size_t c = 0; c < sizeof(caps) / sizeof(caps[0]); c++) {
+        size_t  cap = caps[c], count = 0, idx = 0;
+        WinStat w;
+        if (win_stat_init(&w, cap, WIN_STAT_ORDER) < 0) { perror("win_stat_init"); return -1; }
+
+        for (int i = 0; i < 20000; i++) {
+            // 정수 격자로 동일 값이 자주 나오게
+            double x = (i % 3 == 0) ? floor(synth_urand() * 10.0) : synth_grand() * 5.0 + 100.0;
+            ring[idx] = x;
+            idx = (idx + 1) % cap;
+            if (count < cap) count++;
+            win_stat_push(&w, x);
+
+            double sum = 0, m2 = 0, med, mad;
+            for (size_t j = 0; j < count; j++) sum += ring[j];
+            for (size_t j = 0; j < count; j++) m2 += (ring[j] - sum / count) * (ring[j] - sum / count);
+            memcpy(tmp, ring, count * sizeof(double));
+            med = sorted_median(tmp, count);
+            for (size_t j = 0; j < count; j++) tmp[j] = fabs(ring[j] - med);
+            mad = sorted_median(tmp, count);
+
+            if (fabs(win_stat_mean(&w) - sum / count) > 1e-9 ||
+                (count > 1 && fabs(win_stat_var(&w) - m2 / (count - 1)) > 1e-6) ||
+                win_stat_median(&w) != med || fabs(win_stat_mad(&w) - mad) > 1e-12) {
+                if (bad++ < 5)
+                    printf("  mismatch cap %zu push %d: median %g/%g mad %g/%g\n", cap, i,
+                           win_stat_median(&w), med, win_stat_mad(&w), mad);
+            }
+        }
+        win_stat_free(&w);
+    }
+    printf("check vs sort (caps 1..64, 20000 pushes each): %s\n\n", bad ? "FAIL" : "ok");
+    return bad;
+}
+
+// ─────────────────────────────────────────────
+//  2. 누적 오차
+// ─────────────────────────────────────────────
+#define DRIFT_PUSH  10000000
+#define DRIFT_CAP   1000
+
+static void drift(void)
+{
+    double  *ring = malloc(DRIFT_CAP * sizeof(double));
+    double   naive = 0.0, exact = 0.0;
+    WinStat  w;
+
+    if (!ring || win_stat_init(&w, DRIFT_CAP, 0) < 0) { perror("drift"); free(ring); return; }
+    for (long i = 0; i < DRIFT_PUSH; i++) {
+        double x = LAT0 + 1e-4 * synth_grand();
+        size_t slot = (size_t)i % DRIFT_CAP;
+        if (i >= DRIFT_CAP) naive -= ring[slot];
+        naive += x;
+        ring[slot] = x;
+        win_stat_push(&w, x);
+    }
+    // 기준: 남은 윈도우를 long double 로 다시 합산
+    long double ref = 0.0L;
+    for (size_t j = 0; j < DRIFT_CAP; j++) ref += ring[j];
+    exact = (double)(ref / DRIFT_CAP);
+
+    printf("running mean after %d pushes (window %d, degrees): naive %.2e m, compensated %.2e m\n\n",
+           DRIFT_PUSH, DRIFT_CAP, fabs(naive / DRIFT_CAP - exact) * 111000.0,
+           fabs(win_stat_mean(&w) - exact) * 111000.0);
+    win_stat_free(&w);
+    free(ring);
+}
+
+// ─────────────────────────────────────────────
+//  3. 비용
+// ─────────────────────────────────────────────
+static size_t pushes_for(double per_push)
+{
+    double n = WORK / per_push;
+    return (n > MAX_PUSH) ? MAX_PUSH : (n < 1000 ? 1000 : (size_t)n);
+}
+
+static double ns_since(int64_t t0, size_t n)
+{
+    return (double)(gps_now_ns() - t0) / (double)n;
+}
+
+static void cost(const double *lat, const double *lon)
+{
+    volatile double sink = 0;
+
+    printf("ns per fix (lat + lon)  %12s %12s %12s %12s %12s\n",
+           "legacy sum", "mean", "+median", "+MAD", "sort median");
+
+    for (int wi = 0; wi < WINDOW_COUNT; wi++) {
+        size_t  cap = windows[wi], n;
+        int64_t t0;
+        double  la, lo, t_leg, t_mean, t_med, t_mad, t_sort;
+
+        // 기존 전체 재합산
+        Legacy q = { malloc(cap * sizeof(double)), malloc(cap * sizeof(double)), cap, 0, 0 };
+        n  = pushes_for(2.0 * cap);
+        t0 = gps_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            legacy_push(&q, lat[i], lon[i], &la, &lo);
+            sink += la + lo;
+        }
+        t_leg = ns_since(t0, n);
+
+        // win_stat: 평균만 (정렬 색인 없음) / 중앙값 / 중앙값 + MAD
+        WinStat we, wn;
+        win_stat_init(&we, cap, 0);
+        win_stat_init(&wn, cap, 0);
+        n  = MAX_PUSH;
+        t0 = gps_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            win_stat_push(&we, lat[i]);
+            win_stat_push(&wn, lon[i]);
+            sink += win_stat_mean(&we) + win_stat_mean(&wn);
+        }
+        t_mean = ns_since(t0, n);
+        win_stat_free(&we);
+        win_stat_free(&wn);
+
+        win_stat_init(&we, cap, WIN_STAT_ORDER);
+        win_stat_init(&wn, cap, WIN_STAT_ORDER);
+        t0 = gps_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            win_stat_push(&we, lat[i]);
+            win_stat_push(&wn, lon[i]);
+            sink += win_stat_median(&we) + win_stat_median(&wn);
+        }
+        t_med = ns_since(t0, n);
+
+        win_stat_reset(&we);
+        win_stat_reset(&wn);
+        t0 = gps_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            win_stat_push(&we, lat[i]);
+            win_stat_push(&wn, lon[i]);
+            sink += win_stat_median(&we) + win_stat_median(&wn);
+            sink += win_stat_mad(&we) + win_stat_mad(&wn);
+        }
+        t_mad = ns_since(t0, n);
+
+        // 참고: 매번 정렬하는 중앙값
+        double *tmp = malloc(cap * sizeof(double));
+        n  = pushes_for(2.0 * cap * (log2((double)cap) + 1.0) * 8.0);
+        t0 = gps_now_ns();
+        q.idx = q.count = 0;
+        for (size_t i = 0; i < n; i++) {
+            legacy_push(&q, lat[i], lon[i], &la, &lo);
+            memcpy(tmp, q.lat, q.count * sizeof(double));
+            sink += sorted_median(tmp, q.count);
+            memcpy(tmp, q.lon, q.count * sizeof(double));
+            sink += sorted_median(tmp, q.count);
+        }
+        t_sort = ns_since(t0, n);
+
+        printf("window %6zu           %12.0f %12.0f %12.0f %12.0f %12.0f\n",
+               cap, t_leg, t_mean, t_med, t_mad, t_sort);
+
+        free(tmp);
+        free(q.lat);
+        free(q.lon);
+        win_stat_free(&we);
+        win_stat_free(&wn);
+    }
+    (void)sink;
+    printf("\n");
+}
+
+// ─────────────────────────────────────────────
+//  4. 견고성 (정지 상태)
+// ─────────────────────────────────────────────
+typedef struct {
+    double sum2, max;
+} Err;
+
+static void add_err(Err *er, const GeoLtp *ref, double lat, double lon)
+{
+    double e, n;
+
+    geo_ltp_fwd(ref, lat, lon, &e, &n);
+    er->sum2 += e * e + n * n;
+    if (sqrt(e * e + n * n) > er->max) er->max = sqrt(e * e + n * n);
+}
+
+static void robustness(const double *lat, const double *lon, size_t n, const GeoLtp *ref)
+{
+    printf("receiver still, RMSE / max (m)  %14s %14s %14s  %s\n",
+           "queue mean", "MAD mean", "median", "rejected");
+
+    for (int wi = 0; wi < 2; wi++) {
+        size_t cap = windows[wi];
+        Legacy q = { malloc(cap * sizeof(double)), malloc(cap * sizeof(double)), cap, 0, 0 };
+        WinPos p;
+        Err    e_leg = {0}, e_mad = {0}, e_med = {0};
+
+        win_pos_init(&p, cap);
+        for (size_t i = 0; i < n; i++) {
+            double la, lo;
+
+            legacy_push(&q, lat[i], lon[i], &la, &lo);
+            add_err(&e_leg, ref, la, lo);
+
+            win_pos_push(&p, lat[i], lon[i]);
+            win_pos_mean(&p, &la, &lo);
+            add_err(&e_mad, ref, la, lo);
+            win_pos_median(&p, &la, &lo);
+            add_err(&e_med, ref, la, lo);
+        }
+        printf("window %6zu                    %6.2f / %5.1f %6.2f / %5.1f %6.2f / %5.1f  %llu\n", cap,
+               sqrt(e_leg.sum2 / n), e_leg.max, sqrt(e_mad.sum2 / n), e_mad.max,
+               sqrt(e_med.sum2 / n), e_med.max, (unsigned long long)p.stats.rejected);
+
+        free(q.lat);
+        free(q.lon);
+        win_pos_free(&p);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double  outlier = (argc > 1) ? atof(argv[1]) / 100.0 : 0.02;
+    double *lat = malloc(MAX_PUSH * sizeof(double));
+    double *lon = malloc(MAX_PUSH * sizeof(double));
+    GeoLtp  ref;
+    long    outliers = 0;
+
+    if (!lat || !lon) { perror("malloc"); return 1; }
+    if (check() != 0) return 1;
+    drift();
+
+    // 정지 수신기: 축마다 Gauss-Markov (τ 60s, σ 1.5m) + 백색 1m, 일부 20~60m 튐
+    geo_ltp_init(&ref, LAT0, LON0, 0.0);
+    double gm_e = 0, gm_n = 0, a = exp(-1.0 / 60.0);
+    for (size_t i = 0; i < MAX_PUSH; i++) {
+        gm_e = a * gm_e + sqrt(1 - a * a) * 1.5 * synth_grand();
+        gm_n = a * gm_n + sqrt(1 - a * a) * 1.5 * synth_grand();
+        double e = gm_e + synth_grand(), n = gm_n + synth_grand();
+        if (synth_urand() < outlier) {
+            double r = 20.0 + 40.0 * synth_urand(), t = 2.0 * M_PI * synth_urand();
+            e += r * sin(t);
+            n += r * cos(t);
+            outliers++;
+        }
+        geo_ltp_inv(&ref, e, n, &lat[i], &lon[i]);
+    }
+
+    cost(lat, lon);
+    printf("(%ld outliers in %d fixes, %.1f%%)\n", outliers, MAX_PUSH, outlier * 100.0);
+    robustness(lat, lon, MAX_PUSH, &ref);
+
+    free(lat);
+    free(lon);
+    return 0;
+}
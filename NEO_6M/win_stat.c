@@ -0,0 +1,365 @@
+#include "win_stat.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NIL     (-1)
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+/**
+ * @brief Neumaier 보정 합산 (큰 값끼리 빼도 작은 값이 사라지지 않음)
+ */
+static void ksum_add(WinStat *w, double x)
+{
+    double t = w->sum + x;
+
+    if (fabs(w->sum) >= fabs(x)) w->comp += (w->sum - t) + x;
+    else                         w->comp += (x - t) + w->sum;
+    w->sum = t;
+}
+
+/**
+ * @brief 노드 높이: 1/2 확률로 한 단씩 (xorshift64)
+ */
+static int random_level(WinStat *w)
+{
+    uint64_t r = w->rng;
+    int      d = 1;
+
+    r ^= r << 13;
+    r ^= r >> 7;
+    r ^= r << 17;
+    w->rng = r;
+    while ((r & 1) && d < w->max_level) {
+        d++;
+        r >>= 1;
+    }
+    return d;
+}
+
+static int node_less(const WinStatNode *a, double v, uint64_t seq)
+{
+    return a->v < v || (a->v == v && a->seq < seq);
+}
+
+/**
+ * @brief 각 높이에서 key 바로 앞 노드와 그 위치 (머리 = 0)
+ */
+static void find_chain(const WinStat *w, double v, uint64_t seq,
+                       int32_t chain[WIN_STAT_LEVELS], int32_t pos[WIN_STAT_LEVELS])
+{
+    int32_t x = 0, steps = 0;
+
+    for (int l = w->level - 1; l >= 0; l--) {
+        int32_t nx;
+        while ((nx = w->node[x].next[l]) != NIL && node_less(&w->node[nx], v, seq)) {
+            steps += w->node[x].width[l];
+            x = nx;
+        }
+        chain[l] = x;
+        pos[l]   = steps;
+    }
+}
+
+/**
+ * @brief 노드 삽입 (size: 삽입 전 원소 수)
+ */
+static void list_insert(WinStat *w, int32_t id, size_t size)
+{
+    WinStatNode *nd = &w->node[id];
+    int32_t      chain[WIN_STAT_LEVELS], pos[WIN_STAT_LEVELS];
+    int          d = random_level(w);
+    int32_t      steps;
+
+    // 새로 쓰는 높이: 머리에서 바로 끝 (NIL 위치 = size + 1)
+    for (; w->level < d; w->level++) {
+        w->node[0].next[w->level]  = NIL;
+        w->node[0].width[w->level] = (int32_t)size + 1;
+    }
+
+    find_chain(w, nd->v, nd->seq, chain, pos);
+    steps = pos[0];
+    for (int l = 0; l < d; l++) {
+        WinStatNode *prev = &w->node[chain[l]];
+        nd->next[l]    = prev->next[l];
+        prev->next[l]  = id;
+        nd->width[l]   = prev->width[l] - (steps - pos[l]);
+        prev->width[l] = steps - pos[l] + 1;
+    }
+    for (int l = d; l < w->level; l++)
+        w->node[chain[l]].width[l]++;
+}
+
+static void list_remove(WinStat *w, int32_t id)
+{
+    const WinStatNode *nd = &w->node[id];
+    int32_t            chain[WIN_STAT_LEVELS], pos[WIN_STAT_LEVELS];
+
+    find_chain(w, nd->v, nd->seq, chain, pos);
+    for (int l = 0; l < w->level; l++) {
+        WinStatNode *prev = &w->node[chain[l]];
+        if (prev->next[l] == id) {
+            prev->width[l] += nd->width[l] - 1;
+            prev->next[l]   = nd->next[l];
+        } else {
+            prev->width[l]--;
+        }
+    }
+}
+
+/**
+ * @brief 합 / 평균 / 분산 재계산 (두 단계, 제거가 누적되면 호출)
+ */
+static void resync(WinStat *w)
+{
+    double m2 = 0.0;
+
+    w->sum  = 0.0;
+    w->comp = 0.0;
+    for (size_t i = 0; i < w->count; i++)
+        ksum_add(w, w->ring[(w->head + i) % w->cap]);
+    w->mean = (w->sum + w->comp) / w->count;
+    for (size_t i = 0; i < w->count; i++) {
+        double d = w->ring[(w->head + i) % w->cap] - w->mean;
+        m2 += d * d;
+    }
+    w->m2      = m2;
+    w->evicted = 0;
+}
+
+/**
+ * @brief 중앙값 m 양쪽 거리 A_i = m - x(p-1-i), B_j = x(p+j) - m 의 합집합에서
+ *        k 번째로 작은 값 (두 정렬열 선택, 이분 탐색)
+ */
+static double kth_distance(const WinStat *w, double m, size_t p, size_t k)
+{
+    size_t a = p, b = w->count - p;
+    size_t lo = (k + 1 > b) ? k + 1 - b : 0;
+    size_t hi = (k + 1 < a) ? k + 1 : a;
+
+    // A 에서 i 개, B 에서 k+1-i 개를 고르는 가장 작은 i
+    while (lo < hi) {
+        size_t i = (lo + hi) / 2, j = k + 1 - i;
+        double ai = m - win_stat_select(w, p - 1 - i);
+        double bj = win_stat_select(w, p + j - 1) - m;
+        if (ai < bj) lo = i + 1;
+        else         hi = i;
+    }
+
+    size_t i = lo, j = k + 1 - lo;
+    double r = -INFINITY;
+    if (i > 0) r = fmax(r, m - win_stat_select(w, p - i));
+    if (j > 0) r = fmax(r, win_stat_select(w, p + j - 1) - m);
+    return r;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+int win_stat_init(WinStat *w, size_t cap, unsigned flags)
+{
+    memset(w, 0, sizeof(WinStat));
+    if (cap == 0 || cap >= INT32_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    w->cap  = cap;
+    w->ring = malloc(cap * sizeof(double));
+    if (flags & WIN_STAT_ORDER)
+        w->node = malloc((cap + 1) * sizeof(WinStatNode));
+    if (!w->ring || ((flags & WIN_STAT_ORDER) && !w->node)) {
+        win_stat_free(w);
+        errno = ENOMEM;
+        return -1;
+    }
+    w->rng = 0x9E3779B97F4A7C15ULL;
+    w->max_level = 1;
+    while (w->max_level < WIN_STAT_LEVELS && ((size_t)1 << w->max_level) < cap)
+        w->max_level++;
+    win_stat_reset(w);
+    return 0;
+}
+
+void win_stat_free(WinStat *w)
+{
+    free(w->ring);
+    free(w->node);
+    w->ring = NULL;
+    w->node = NULL;
+}
+
+void win_stat_reset(WinStat *w)
+{
+    w->level   = 0;
+    w->count   = 0;
+    w->head    = 0;
+    w->sum     = 0.0;
+    w->comp    = 0.0;
+    w->mean    = 0.0;
+    w->m2      = 0.0;
+    w->evicted = 0;
+}
+
+void win_stat_push(WinStat *w, double x)
+{
+    size_t  slot;
+    int32_t id;
+
+    if (w->count == w->cap) {
+        // 가장 오래된 값을 x 로 교체
+        double old = w->ring[w->head];
+        double n   = (double)w->count;
+        double d   = x - old;
+        double mean_new = w->mean + d / n;
+
+        slot = w->head;
+        id   = (int32_t)slot + 1;
+        if (w->node) list_remove(w, id);
+        w->head = (w->head + 1) % w->cap;
+
+        ksum_add(w, -old);
+        ksum_add(w, x);
+        w->m2  += d * (x - mean_new + old - w->mean);
+        w->mean = mean_new;
+        if (w->m2 < 0.0) w->m2 = 0.0;
+    } else {
+        slot = (w->head + w->count) % w->cap;
+        id   = (int32_t)slot + 1;
+        w->count++;
+
+        double d = x - w->mean;
+        ksum_add(w, x);
+        w->mean += d / (double)w->count;
+        w->m2   += d * (x - w->mean);
+    }
+
+    w->ring[slot] = x;
+    if (w->node) {
+        w->node[id].v   = x;
+        w->node[id].seq = w->seq++;
+        list_insert(w, id, w->count - 1);
+    }
+
+    if (w->count == w->cap && ++w->evicted >= WIN_STAT_RESYNC)
+        resync(w);
+}
+
+double win_stat_mean(const WinStat *w)
+{
+    return w->count ? (w->sum + w->comp) / (double)w->count : 0.0;
+}
+
+double win_stat_var(const WinStat *w)
+{
+    return (w->count > 1) ? w->m2 / (double)(w->count - 1) : 0.0;
+}
+
+double win_stat_select(const WinStat *w, size_t k)
+{
+    int32_t x = 0, i = (int32_t)k + 1;     // 머리 = 위치 0
+
+    for (int l = w->level - 1; l >= 0; l--) {
+        while (w->node[x].next[l] != NIL && w->node[x].width[l] <= i) {
+            i -= w->node[x].width[l];
+            x  = w->node[x].next[l];
+        }
+    }
+    return w->node[x].v;
+}
+
+double win_stat_median(const WinStat *w)
+{
+    size_t n = w->count;
+
+    if (n == 0) return 0.0;
+    if (n & 1)  return win_stat_select(w, n / 2);
+    return 0.5 * (win_stat_select(w, n / 2 - 1) + win_stat_select(w, n / 2));
+}
+
+double win_stat_mad(const WinStat *w)
+{
+    size_t n = w->count;
+    double m;
+
+    if (n < 2) return 0.0;
+    // x(0..p-1) ≤ m ≤ x(p..n-1)
+    m = win_stat_median(w);
+    if (n & 1) return kth_distance(w, m, n / 2, n / 2);
+    return 0.5 * (kth_distance(w, m, n / 2, n / 2 - 1) + kth_distance(w, m, n / 2, n / 2));
+}
+
+int win_stat_outlier(const WinStat *w, double x, double k, double min_sigma)
+{
+    double sigma = WIN_STAT_MAD_SIGMA * win_stat_mad(w);
+
+    if (sigma < min_sigma) sigma = min_sigma;
+    return fabs(x - win_stat_median(w)) > k * sigma;
+}
+
+// ─────────────────────────────────────────────
+//  위치 윈도우
+// ─────────────────────────────────────────────
+
+int win_pos_init(WinPos *p, size_t cap)
+{
+    memset(p, 0, sizeof(WinPos));
+    if (win_stat_init(&p->e, cap, WIN_STAT_ORDER) < 0) return -1;
+    if (win_stat_init(&p->n, cap, WIN_STAT_ORDER) < 0) {
+        win_stat_free(&p->e);
+        return -1;
+    }
+    return 0;
+}
+
+void win_pos_free(WinPos *p)
+{
+    win_stat_free(&p->e);
+    win_stat_free(&p->n);
+}
+
+int win_pos_push(WinPos *p, double lat, double lon)
+{
+    double e, n;
+
+    if (!p->init) {
+        geo_ltp_init(&p->ltp, lat, lon, 0.0);
+        p->init = 1;
+    }
+    geo_ltp_fwd(&p->ltp, lat, lon, &e, &n);
+
+    if (win_stat_count(&p->e) >= WIN_POS_MIN_COUNT &&
+        (win_stat_outlier(&p->e, e, WIN_POS_K, WIN_POS_MIN_SIGMA) ||
+         win_stat_outlier(&p->n, n, WIN_POS_K, WIN_POS_MIN_SIGMA))) {
+        p->stats.rejected++;
+        if (++p->reject_run < WIN_POS_MAX_REJECT) return 0;
+
+        // 계속 벗어나면 튄 값이 아니라 이동: 새 위치에서 다시 시작
+        win_stat_reset(&p->e);
+        win_stat_reset(&p->n);
+        geo_ltp_init(&p->ltp, lat, lon, 0.0);
+        e = n = 0.0;
+        p->stats.resets++;
+    }
+
+    p->reject_run = 0;
+    p->stats.accepted++;
+    win_stat_push(&p->e, e);
+    win_stat_push(&p->n, n);
+    return 1;
+}
+
+void win_pos_mean(const WinPos *p, double *lat, double *lon)
+{
+    geo_ltp_inv(&p->ltp, win_stat_mean(&p->e), win_stat_mean(&p->n), lat, lon);
+}
+
+void win_pos_median(const WinPos *p, double *lat, double *lon)
+{
+    geo_ltp_inv(&p->ltp, win_stat_median(&p->e), win_stat_median(&p->n), lat, lon);
+}
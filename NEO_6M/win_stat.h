@@ -0,0 +1,163 @@
+#ifndef WIN_STAT_H
+#define WIN_STAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "geo.h"
+
+// ─────────────────────────────────────────────
+//  고정 크기 슬라이딩 윈도우 통계
+//
+//  값 1개 추가 (가득 차면 가장 오래된 값 제거) 마다
+//    합      보정 합산 (Neumaier), 평균 O(1)
+//    분산    Welford (추가 / 교체 갱신), O(1)
+//    중앙값  순위 색인 skip list, 추가·삭제·k번째 O(log n)
+//    MAD     중앙값 양쪽 거리의 두 정렬열 병합 선택, O(log² n)
+//  중앙값 / MAD 는 WIN_STAT_ORDER 로 만든 윈도우에서만 (평균 / 분산만 쓰면 O(1))
+//  노드는 init 에서 한 번에 할당 (push 중 malloc 없음)
+//  NaN 은 넣지 말 것 (순서가 정의되지 않음)
+// ─────────────────────────────────────────────
+
+#define WIN_STAT_LEVELS     16          // skip list 최대 높이 (2^16 개까지 O(log n))
+#define WIN_STAT_MAD_SIGMA  1.4826      // 정규분포에서 σ = 1.4826 × MAD
+#define WIN_STAT_RESYNC     (1u << 20)  // 이만큼 제거마다 합 / 분산 재계산 (오차 누적 방지)
+
+// win_stat_init flags
+#define WIN_STAT_ORDER      0x1         // 정렬 색인 유지 (select / median / MAD / outlier)
+
+typedef struct {
+    double   v;
+    uint64_t seq;                       // 같은 값의 순서 (추가 순번)
+    int32_t  next[WIN_STAT_LEVELS];
+    int32_t  width[WIN_STAT_LEVELS];    // next 까지 건너뛰는 원소 수
+} WinStatNode;
+
+// ─────────────────────────────────────────────
+//  윈도우 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    size_t       cap;
+    size_t       count;
+    size_t       head;                  // 가장 오래된 값의 ring 위치
+    uint64_t     seq;
+    double      *ring;                  // 추가 순서
+    WinStatNode *node;                  // [0] = skip list 머리, ring[i] ↔ node[i + 1] (ORDER 만)
+    int          level;                 // 사용 중인 skip list 높이
+    int          max_level;             // log2(cap) + 1 (그 이상은 이득 없음)
+    uint64_t     rng;
+    double       sum, comp;             // Neumaier 합 / 보정항
+    double       mean, m2;              // Welford
+    uint32_t     evicted;               // 마지막 재계산 이후 제거 수
+} WinStat;
+
+/**
+ * @brief 윈도우 생성
+ * @param cap   최대 원소 수 (1 이상)
+ * @param flags WIN_STAT_* 조합
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int win_stat_init(WinStat *w, size_t cap, unsigned flags);
+
+/**
+ * @brief 메모리 해제
+ */
+void win_stat_free(WinStat *w);
+
+/**
+ * @brief 비우기 (용량 유지)
+ */
+void win_stat_reset(WinStat *w);
+
+/**
+ * @brief 값 추가 (가득 차 있으면 가장 오래된 값을 제거)
+ */
+void win_stat_push(WinStat *w, double x);
+
+static inline size_t win_stat_count(const WinStat *w) { return w->count; }
+
+/**
+ * @brief 평균 (비어 있으면 0)
+ */
+double win_stat_mean(const WinStat *w);
+
+/**
+ * @brief 표본 분산 (n - 1, 원소 2개 미만이면 0)
+ */
+double win_stat_var(const WinStat *w);
+
+/**
+ * @brief k 번째로 작은 값 (0 부터, k < count)
+ */
+double win_stat_select(const WinStat *w, size_t k);
+
+/**
+ * @brief 중앙값 (짝수 개면 가운데 둘의 평균)
+ */
+double win_stat_median(const WinStat *w);
+
+/**
+ * @brief 중앙값 절대 편차 median(|x - median|)
+ */
+double win_stat_mad(const WinStat *w);
+
+/**
+ * @brief x 가 윈도우 분포에서 벗어났는지 (|x - median| > k × 1.4826 × MAD)
+ * @param k         임계 배수 (보통 3)
+ * @param min_sigma MAD 가 0 에 가까울 때 (같은 값 반복) 쓰는 최소 σ
+ */
+int win_stat_outlier(const WinStat *w, double x, double k, double min_sigma);
+
+// ─────────────────────────────────────────────
+//  위치 윈도우: 첫 fix 기준 ENU (m) 축마다 WinStat
+//
+//  MAD 기준을 넘는 fix 는 윈도우에 넣지 않는다. 연속 WIN_POS_MAX_REJECT
+//  회 기각되면 실제 이동으로 보고 윈도우를 비운 뒤 다시 시작한다.
+// ─────────────────────────────────────────────
+
+#define WIN_POS_K           3.5         // 기각 임계 (σ 배수)
+#define WIN_POS_MIN_SIGMA   1.5         // 최소 σ (m), NEO-6M 정지 시 짧은 구간 잡음 수준
+#define WIN_POS_MIN_COUNT   5           // 이보다 적으면 기각하지 않음
+#define WIN_POS_MAX_REJECT  5
+
+typedef struct {
+    uint64_t accepted;
+    uint64_t rejected;
+    uint64_t resets;            // 연속 기각으로 다시 시작
+} WinPosStats;
+
+typedef struct {
+    GeoLtp      ltp;
+    int         init;
+    int         reject_run;
+    WinStat     e, n;
+    WinPosStats stats;
+} WinPos;
+
+/**
+ * @brief 위치 윈도우 생성 (축마다 cap 개)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int win_pos_init(WinPos *p, size_t cap);
+
+/**
+ * @brief 메모리 해제
+ */
+void win_pos_free(WinPos *p);
+
+/**
+ * @brief fix 추가
+ * @return 1: 반영, 0: 이상치로 기각
+ */
+int win_pos_push(WinPos *p, double lat, double lon);
+
+/**
+ * @brief 윈도우 평균 위치 (도)
+ */
+void win_pos_mean(const WinPos *p, double *lat, double *lon);
+
+/**
+ * @brief 축별 중앙값 위치 (도)
+ */
+void win_pos_median(const WinPos *p, double *lat, double *lon);
+
+#endif /* WIN_STAT_H */
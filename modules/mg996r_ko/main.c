@@ -93,13 +93,14 @@ static void calc_delta(const int key_state[KEY_COUNT], float *dpan, float *dtilt
 }
 
 // ────────────── Servo Control ──────────────
+// 밀리도 단위로 전달 → 1°/tick smoothing, 대각선 정규화 값이 잘리지 않음
 static void set_servo(float pan, float tilt)
 {
     if(g_fd<0) return;
-    struct mg996r_angle angles;
-    angles.pan  = (int)pan;
-    angles.tilt = (int)tilt;
-    if(ioctl(g_fd, MG996R_SET_BOTH, &angles)<0) perror("ioctl MG996R_SET_BOTH");
+    struct mg996r_angle_mdeg angles;
+    angles.pan_mdeg  = (__s32)lroundf(pan  * MG996R_MDEG_PER_DEG);
+    angles.tilt_mdeg = (__s32)lroundf(tilt * MG996R_MDEG_PER_DEG);
+    if(ioctl(g_fd, MG996R_SET_BOTH_MDEG, &angles)<0) perror("ioctl MG996R_SET_BOTH_MDEG");
 }
 
 static void center_servo(void)
@@ -2,6 +2,7 @@
 #define MG996R_H
 
 #include <linux/ioctl.h>
+#include <linux/types.h>
 
 // ─────────────────────────────────────────────
 //  디바이스 정보
@@ -18,6 +19,17 @@
 #define MG996R_TILT_MAX     180
 #define MG996R_CENTER       90
 
+// ─────────────────────────────────────────────
+//  밀리도(mdeg) 단위 (ABI v2)
+//  1° = 1000 mdeg, 드라이버 내부 상태도 mdeg 로 유지
+// ─────────────────────────────────────────────
+#define MG996R_MDEG_PER_DEG     1000
+#define MG996R_PAN_MIN_MDEG     (MG996R_PAN_MIN  * MG996R_MDEG_PER_DEG)
+#define MG996R_PAN_MAX_MDEG     (MG996R_PAN_MAX  * MG996R_MDEG_PER_DEG)
+#define MG996R_TILT_MIN_MDEG    (MG996R_TILT_MIN * MG996R_MDEG_PER_DEG)
+#define MG996R_TILT_MAX_MDEG    (MG996R_TILT_MAX * MG996R_MDEG_PER_DEG)
+#define MG996R_CENTER_MDEG      (MG996R_CENTER   * MG996R_MDEG_PER_DEG)
+
 // ─────────────────────────────────────────────
 //  ioctl 데이터 구조체
 // ─────────────────────────────────────────────
@@ -26,6 +38,35 @@ struct mg996r_angle {
     int tilt;   // Tilt 각도 (0~180)
 };
 
+// ─────────────────────────────────────────────
+//  MG996R_GET_STATE 스냅샷
+//  pan/tilt 와 카운터가 같은 시점의 값임을 보장
+//  (드라이버 내부 seqcount 로 일관성 유지)
+// ─────────────────────────────────────────────
+struct mg996r_state {
+    __s32 pan;              // 마지막으로 적용된 Pan  각도
+    __s32 tilt;             // 마지막으로 적용된 Tilt 각도
+    __s64 commit_ns;        // 마지막 적용 시각 (ktime, CLOCK_MONOTONIC ns)
+    __u64 commit_count;     // 성공한 각도 적용 횟수
+    __u64 error_count;      // PWM 적용 실패 횟수
+};
+
+// ─────────────────────────────────────────────
+//  mdeg 버전 구조체 (ABI v2)
+// ─────────────────────────────────────────────
+struct mg996r_angle_mdeg {
+    __s32 pan_mdeg;         // Pan  각도 (70000~170000)
+    __s32 tilt_mdeg;        // Tilt 각도 (0~180000)
+};
+
+struct mg996r_state_mdeg {
+    __s32 pan_mdeg;
+    __s32 tilt_mdeg;
+    __s64 commit_ns;
+    __u64 commit_count;
+    __u64 error_count;
+};
+
 // ─────────────────────────────────────────────
 //  ioctl 명령 정의
 //  매직 넘버: 0xB0 (임의 선택, 충돌 방지)
@@ -38,5 +79,12 @@ struct mg996r_angle {
 #define MG996R_DO_CENTER    _IO (MG996R_MAGIC, 3)                    // 중앙 복귀
 #define MG996R_GET_PAN      _IOR(MG996R_MAGIC, 4, int)               // pan 각도 읽기
 #define MG996R_GET_TILT     _IOR(MG996R_MAGIC, 5, int)               // tilt 각도 읽기
+#define MG996R_GET_STATE    _IOR(MG996R_MAGIC, 6, struct mg996r_state) // 상태 스냅샷 읽기
+
+// ABI v2: 밀리도 단위 (정수 각도 ioctl 은 호환용으로 유지)
+#define MG996R_SET_PAN_MDEG     _IOW(MG996R_MAGIC, 7,  __s32)
+#define MG996R_SET_TILT_MDEG    _IOW(MG996R_MAGIC, 8,  __s32)
+#define MG996R_SET_BOTH_MDEG    _IOW(MG996R_MAGIC, 9,  struct mg996r_angle_mdeg)
+#define MG996R_GET_STATE_MDEG   _IOR(MG996R_MAGIC, 10, struct mg996r_state_mdeg)
 
 #endif /* MG996R_H */
\ No newline at end of file
@@ -9,6 +9,10 @@
  * 로드: sudo insmod mg996r_driver.ko
  * 해제: sudo rmmod mg996r_driver
  * 확인: ls /dev/mg996r  /  dmesg | tail
+ *
+ * 프로파일링:
+ *   /sys/kernel/debug/mg996r/   (stats, apply_latency, lock_wait, reset)
+ *   trace-cmd record -e mg996r  (ioctl 진입/종료, lock 획득, PWM 적용)
  */
 
 #include <linux/module.h>
@@ -18,10 +22,19 @@
 #include <linux/device.h>
 #include <linux/uaccess.h>
 #include <linux/mutex.h>
+#include <linux/seqlock.h>
+#include <linux/ktime.h>
 #include <linux/slab.h>
 #include <linux/delay.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/atomic.h>
+#include <linux/log2.h>
 #include "mg996r.h"
 
+#define CREATE_TRACE_POINTS
+#include "mg996r_trace.h"
+
 // ─────────────────────────────────────────────
 //  sysfs PWM 경로
 // ─────────────────────────────────────────────
@@ -30,13 +43,50 @@
 #define PWM_DUTY_MIN_NS     500000      // 0.5ms →   0°
 #define PWM_DUTY_MAX_NS     2500000     // 2.5ms → 180°
 
+// ─────────────────────────────────────────────
+//  debugfs 통계
+//  cmd_count/err_count 는 _IOC_NR 로 인덱싱 (범위 밖 → 마지막 칸)
+//  히스토그램 bucket i = [2^i, 2^(i+1)) ns
+// ─────────────────────────────────────────────
+#define MG996R_NR_CMDS      12
+#define MG996R_HIST_BUCKETS 32
+
+struct mg996r_stats {
+    atomic64_t cmd_count[MG996R_NR_CMDS];
+    atomic64_t err_count[MG996R_NR_CMDS];
+    atomic64_t clamped;
+    atomic64_t apply_hist[MG996R_HIST_BUCKETS];
+    atomic64_t lock_hist[MG996R_HIST_BUCKETS];
+};
+
+static const char * const mg996r_cmd_names[MG996R_NR_CMDS] = {
+    "SET_PAN", "SET_TILT", "SET_BOTH", "DO_CENTER",
+    "GET_PAN", "GET_TILT", "GET_STATE",
+    "SET_PAN_MDEG", "SET_TILT_MDEG", "SET_BOTH_MDEG", "GET_STATE_MDEG",
+    "other",
+};
+
+// SET 요청이 적용할 축
+#define AXIS_PAN    0x1
+#define AXIS_TILT   0x2
+
 // ─────────────────────────────────────────────
 //  드라이버 내부 상태
+//
+//  lock : writer 직렬화 (느린 PWM 적용 구간 포함)
+//  seq  : 공개 상태(pan/tilt/카운터) 갱신 구간만 감쌈
+//         → GET_* reader 는 lock 없이 재시도만 함
 // ─────────────────────────────────────────────
 struct mg996r_dev {
-    int          pan_angle;
-    int          tilt_angle;
+    int          pan_mdeg;
+    int          tilt_mdeg;
+    s64          commit_ns;
+    u64          commit_count;
+    u64          error_count;
     struct mutex lock;
+    seqcount_mutex_t seq;
+    struct mg996r_stats stats;
+    struct dentry *dbg_dir;
     struct cdev  cdev;
     dev_t        devno;
     struct class *class;
@@ -73,31 +123,30 @@ static int sysfs_write(const char *path, const char *val)
 // ─────────────────────────────────────────────
 //  내부 헬퍼
 // ─────────────────────────────────────────────
-static int angle_to_duty_ns(int angle)
+// mdeg → duty(ns), 정수 연산만 사용
+// (MAX - MIN) / 180000 = 2000000 / 180000 = 100 / 9 ns/mdeg (반올림)
+static int mdeg_to_duty_ns(int mdeg)
 {
-    return PWM_DUTY_MIN_NS +
-           (int)(((long)angle * (PWM_DUTY_MAX_NS - PWM_DUTY_MIN_NS)) / 180);
+    return PWM_DUTY_MIN_NS + (mdeg * 100 + 4) / 9;
 }
 
-static int clamp_pan(int a)
+static int deg_to_mdeg(int deg)
 {
-    if (a < MG996R_PAN_MIN)  return MG996R_PAN_MIN;
-    if (a > MG996R_PAN_MAX)  return MG996R_PAN_MAX;
-    return a;
+    // 범위 밖 값은 어차피 클램핑되므로 곱셈 overflow 만 방지
+    return clamp_val(deg, -INT_MAX / MG996R_MDEG_PER_DEG,
+                     INT_MAX / MG996R_MDEG_PER_DEG) * MG996R_MDEG_PER_DEG;
 }
 
-static int clamp_tilt(int a)
+static int mdeg_to_deg(int mdeg)
 {
-    if (a < MG996R_TILT_MIN) return MG996R_TILT_MIN;
-    if (a > MG996R_TILT_MAX) return MG996R_TILT_MAX;
-    return a;
+    return DIV_ROUND_CLOSEST(mdeg, MG996R_MDEG_PER_DEG);
 }
 
 // ─────────────────────────────────────────────
 //  PWM 채널 초기화
 //  export → period → duty → enable
 // ─────────────────────────────────────────────
-static int pwm_ch_init(int ch, int angle)
+static int pwm_ch_init(int ch, int mdeg)
 {
     char path[128], val[32];
     int  ret;
@@ -116,7 +165,7 @@ static int pwm_ch_init(int ch, int angle)
 
     // 3. duty
     snprintf(path, sizeof(path), SYSFS_PWM_BASE "/pwm%d/duty_cycle", ch);
-    snprintf(val,  sizeof(val),  "%d", angle_to_duty_ns(angle));
+    snprintf(val,  sizeof(val),  "%d", mdeg_to_duty_ns(mdeg));
     ret = sysfs_write(path, val);
     if (ret) return ret;
 
@@ -125,19 +174,20 @@ static int pwm_ch_init(int ch, int angle)
     ret = sysfs_write(path, "1");
     if (ret) return ret;
 
-    pr_info("mg996r: pwm%d initialized (angle=%d°)\n", ch, angle);
+    pr_info("mg996r: pwm%d initialized (angle=%d.%03d°)\n", ch,
+            mdeg / MG996R_MDEG_PER_DEG, mdeg % MG996R_MDEG_PER_DEG);
     return 0;
 }
 
 // ─────────────────────────────────────────────
 //  PWM 각도 적용
 // ─────────────────────────────────────────────
-static int pwm_set_angle(int ch, int angle)
+static int pwm_set_mdeg(int ch, int mdeg)
 {
     char path[128], val[32];
 
     snprintf(path, sizeof(path), SYSFS_PWM_BASE "/pwm%d/duty_cycle", ch);
-    snprintf(val,  sizeof(val),  "%d", angle_to_duty_ns(angle));
+    snprintf(val,  sizeof(val),  "%d", mdeg_to_duty_ns(mdeg));
     return sysfs_write(path, val);
 }
 
@@ -160,6 +210,98 @@ static void pwm_ch_cleanup(int ch)
     pr_info("mg996r: pwm%d released\n", ch);
 }
 
+// ─────────────────────────────────────────────
+//  통계 헬퍼
+// ─────────────────────────────────────────────
+static unsigned int cmd_index(unsigned int cmd)
+{
+    unsigned int nr = _IOC_NR(cmd);
+
+    if (_IOC_TYPE(cmd) != MG996R_MAGIC || nr >= MG996R_NR_CMDS - 1)
+        return MG996R_NR_CMDS - 1;
+    return nr;
+}
+
+static void hist_add(atomic64_t *hist, u64 ns)
+{
+    unsigned int b = ns ? ilog2(ns) : 0;
+
+    if (b >= MG996R_HIST_BUCKETS) b = MG996R_HIST_BUCKETS - 1;
+    atomic64_inc(&hist[b]);
+}
+
+static void stats_reset(struct mg996r_stats *st)
+{
+    int i;
+
+    for (i = 0; i < MG996R_NR_CMDS; i++) {
+        atomic64_set(&st->cmd_count[i], 0);
+        atomic64_set(&st->err_count[i], 0);
+    }
+    for (i = 0; i < MG996R_HIST_BUCKETS; i++) {
+        atomic64_set(&st->apply_hist[i], 0);
+        atomic64_set(&st->lock_hist[i], 0);
+    }
+    atomic64_set(&st->clamped, 0);
+}
+
+// ─────────────────────────────────────────────
+//  PWM 적용 + 지연시간 측정 (ioctl 경로 전용)
+// ─────────────────────────────────────────────
+static int mg996r_apply(struct mg996r_dev *dev, int ch, int mdeg)
+{
+    u64 t0 = ktime_get_ns();
+    int ret = pwm_set_mdeg(ch, mdeg);
+    u64 dt = ktime_get_ns() - t0;
+
+    hist_add(dev->stats.apply_hist, dt);
+    trace_mg996r_pwm_apply(ch, mdeg, ret, dt);
+    return ret;
+}
+
+static int mg996r_clamp(struct mg996r_dev *dev, int a, int lo, int hi)
+{
+    int c = (a < lo) ? lo : (a > hi) ? hi : a;
+
+    if (c != a) atomic64_inc(&dev->stats.clamped);
+    return c;
+}
+
+// ─────────────────────────────────────────────
+//  상태 게시 / 스냅샷
+//  commit/fail 은 dev->lock 보유 상태에서만 호출
+// ─────────────────────────────────────────────
+static void mg996r_commit(struct mg996r_dev *dev, int pan, int tilt)
+{
+    write_seqcount_begin(&dev->seq);
+    dev->pan_mdeg   = pan;
+    dev->tilt_mdeg  = tilt;
+    dev->commit_ns  = ktime_get_ns();
+    dev->commit_count++;
+    write_seqcount_end(&dev->seq);
+}
+
+static void mg996r_fail(struct mg996r_dev *dev)
+{
+    write_seqcount_begin(&dev->seq);
+    dev->error_count++;
+    write_seqcount_end(&dev->seq);
+}
+
+static void mg996r_snapshot(struct mg996r_dev *dev, struct mg996r_state_mdeg *st)
+{
+    unsigned int seq;
+
+    do {
+        seq = read_seqcount_begin(&dev->seq);
+        st->pan_mdeg     = dev->pan_mdeg;
+        st->tilt_mdeg    = dev->tilt_mdeg;
+        st->commit_ns    = dev->commit_ns;
+        st->commit_count = dev->commit_count;
+        st->error_count  = dev->error_count;
+    } while (read_seqcount_retry(&dev->seq, seq));
+}
+
 // ─────────────────────────────────────────────
 //  file_operations
 // ─────────────────────────────────────────────
@@ -174,75 +316,161 @@ static int mg996r_release(struct inode *inode, struct file *file)
     return 0;
 }
 
-static long mg996r_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+// GET_* : lock 없이 seqcount 스냅샷만 읽음 (writer 와 경합하지 않음)
+static long mg996r_ioctl_get(struct mg996r_dev *dev, unsigned int cmd,
+                             unsigned long arg)
 {
-    struct mg996r_dev   *dev = file->private_data;
-    struct mg996r_angle  both;
-    int                  angle;
-    int                  ret = 0;
+    struct mg996r_state_mdeg sm;
+    struct mg996r_state      st;
+    int                      deg;
 
-    mutex_lock(&dev->lock);
+    mg996r_snapshot(dev, &sm);
 
     switch (cmd) {
 
-        case MG996R_SET_PAN:
-            if (copy_from_user(&angle, (int __user *)arg, sizeof(int))) {
-                ret = -EFAULT; break;
-            }
-            angle = clamp_pan(angle);
-            ret = pwm_set_angle(0, angle);
-            if (!ret) dev->pan_angle = angle;
-            break;
+        case MG996R_GET_PAN:
+            deg = mdeg_to_deg(sm.pan_mdeg);
+            if (copy_to_user((int __user *)arg, &deg, sizeof(int)))
+                return -EFAULT;
+            return 0;
+
+        case MG996R_GET_TILT:
+            deg = mdeg_to_deg(sm.tilt_mdeg);
+            if (copy_to_user((int __user *)arg, &deg, sizeof(int)))
+                return -EFAULT;
+            return 0;
+
+        case MG996R_GET_STATE:
+            st.pan          = mdeg_to_deg(sm.pan_mdeg);
+            st.tilt         = mdeg_to_deg(sm.tilt_mdeg);
+            st.commit_ns    = sm.commit_ns;
+            st.commit_count = sm.commit_count;
+            st.error_count  = sm.error_count;
+            if (copy_to_user((struct mg996r_state __user *)arg, &st,
+                             sizeof(struct mg996r_state)))
+                return -EFAULT;
+            return 0;
+
+        case MG996R_GET_STATE_MDEG:
+            if (copy_to_user((struct mg996r_state_mdeg __user *)arg, &sm,
+                             sizeof(struct mg996r_state_mdeg)))
+                return -EFAULT;
+            return 0;
+    }
+
+    return -ENOTTY;
+}
+
+// SET_* : 도/밀리도 요청을 모두 mdeg 로 정규화한 뒤 같은 경로로 적용
+static long mg996r_ioctl_set(struct mg996r_dev *dev, unsigned int cmd,
+                             unsigned long arg)
+{
+    struct mg996r_angle       both;
+    struct mg996r_angle_mdeg  req;
+    unsigned int              axes;
+    int                       val;
+    int                       pan, tilt;
+    int                       ret = 0;
+    u64                       t0;
+
+    // copy_from_user 는 lock 밖에서 처리
+    switch (cmd) {
 
+        case MG996R_SET_PAN:
         case MG996R_SET_TILT:
-            if (copy_from_user(&angle, (int __user *)arg, sizeof(int))) {
-                ret = -EFAULT; break;
+        case MG996R_SET_PAN_MDEG:
+        case MG996R_SET_TILT_MDEG:
+            if (copy_from_user(&val, (int __user *)arg, sizeof(int)))
+                return -EFAULT;
+            if (cmd == MG996R_SET_PAN || cmd == MG996R_SET_TILT)
+                val = deg_to_mdeg(val);
+            if (cmd == MG996R_SET_PAN || cmd == MG996R_SET_PAN_MDEG) {
+                req.pan_mdeg = val;
+                axes = AXIS_PAN;
+            } else {
+                req.tilt_mdeg = val;
+                axes = AXIS_TILT;
             }
-            angle = clamp_tilt(angle);
-            ret = pwm_set_angle(1, angle);
-            if (!ret) dev->tilt_angle = angle;
             break;
 
         case MG996R_SET_BOTH:
             if (copy_from_user(&both, (struct mg996r_angle __user *)arg,
-                               sizeof(struct mg996r_angle))) {
-                ret = -EFAULT; break;
-            }
-            both.pan  = clamp_pan(both.pan);
-            both.tilt = clamp_tilt(both.tilt);
-            ret = pwm_set_angle(0, both.pan);
-            if (!ret) ret = pwm_set_angle(1, both.tilt);
-            if (!ret) {
-                dev->pan_angle  = both.pan;
-                dev->tilt_angle = both.tilt;
-            }
+                               sizeof(struct mg996r_angle)))
+                return -EFAULT;
+            req.pan_mdeg  = deg_to_mdeg(both.pan);
+            req.tilt_mdeg = deg_to_mdeg(both.tilt);
+            axes = AXIS_PAN | AXIS_TILT;
             break;
 
-        case MG996R_DO_CENTER:
-            ret = pwm_set_angle(0, MG996R_CENTER);
-            if (!ret) ret = pwm_set_angle(1, MG996R_CENTER);
-            if (!ret) {
-                dev->pan_angle  = MG996R_CENTER;
-                dev->tilt_angle = MG996R_CENTER;
-            }
+        case MG996R_SET_BOTH_MDEG:
+            if (copy_from_user(&req, (struct mg996r_angle_mdeg __user *)arg,
+                               sizeof(struct mg996r_angle_mdeg)))
+                return -EFAULT;
+            axes = AXIS_PAN | AXIS_TILT;
             break;
 
-        case MG996R_GET_PAN:
-            if (copy_to_user((int __user *)arg, &dev->pan_angle, sizeof(int)))
-                ret = -EFAULT;
+        case MG996R_DO_CENTER:
+            req.pan_mdeg  = MG996R_CENTER_MDEG;
+            req.tilt_mdeg = MG996R_CENTER_MDEG;
+            axes = AXIS_PAN | AXIS_TILT;
             break;
 
+        default:
+            return -ENOTTY;
+    }
+
+    if (axes & AXIS_PAN)
+        req.pan_mdeg  = mg996r_clamp(dev, req.pan_mdeg,
+                                     MG996R_PAN_MIN_MDEG,  MG996R_PAN_MAX_MDEG);
+    if (axes & AXIS_TILT)
+        req.tilt_mdeg = mg996r_clamp(dev, req.tilt_mdeg,
+                                     MG996R_TILT_MIN_MDEG, MG996R_TILT_MAX_MDEG);
+
+    t0 = ktime_get_ns();
+    mutex_lock(&dev->lock);
+    t0 = ktime_get_ns() - t0;
+    hist_add(dev->stats.lock_hist, t0);
+    trace_mg996r_lock_acquired(cmd, t0);
+
+    pan  = (axes & AXIS_PAN)  ? req.pan_mdeg  : dev->pan_mdeg;
+    tilt = (axes & AXIS_TILT) ? req.tilt_mdeg : dev->tilt_mdeg;
+
+    if (axes & AXIS_PAN)
+        ret = mg996r_apply(dev, 0, pan);
+    if (!ret && (axes & AXIS_TILT))
+        ret = mg996r_apply(dev, 1, tilt);
+
+    if (!ret) mg996r_commit(dev, pan, tilt);
+    else      mg996r_fail(dev);
+
+    mutex_unlock(&dev->lock);
+    return ret;
+}
+
+static long mg996r_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    struct mg996r_dev *dev = file->private_data;
+    unsigned int       idx = cmd_index(cmd);
+    u64                t0  = ktime_get_ns();
+    long               ret;
+
+    trace_mg996r_ioctl_enter(cmd);
+    atomic64_inc(&dev->stats.cmd_count[idx]);
+
+    switch (cmd) {
+        case MG996R_GET_PAN:
         case MG996R_GET_TILT:
-            if (copy_to_user((int __user *)arg, &dev->tilt_angle, sizeof(int)))
-                ret = -EFAULT;
+        case MG996R_GET_STATE:
+        case MG996R_GET_STATE_MDEG:
+            ret = mg996r_ioctl_get(dev, cmd, arg);
             break;
-
         default:
-            ret = -ENOTTY;
+            ret = mg996r_ioctl_set(dev, cmd, arg);
             break;
     }
 
-    mutex_unlock(&dev->lock);
+    if (ret) atomic64_inc(&dev->stats.err_count[idx]);
+    trace_mg996r_ioctl_exit(cmd, ret, ktime_get_ns() - t0);
     return ret;
 }
 
@@ -253,6 +481,83 @@ static const struct file_operations mg996r_fops = {
     .unlocked_ioctl = mg996r_ioctl,
 };
 
+// ─────────────────────────────────────────────
+//  debugfs
+//  /sys/kernel/debug/mg996r/
+//    stats          명령별 호출/에러 횟수, 클램핑 횟수
+//    apply_latency  PWM 적용 시간 log2 히스토그램
+//    lock_wait      dev->lock 대기 시간 log2 히스토그램
+//    reset          아무 값이나 쓰면 통계 초기화
+// ─────────────────────────────────────────────
+static int stats_show(struct seq_file *m, void *v)
+{
+    struct mg996r_dev *dev = m->private;
+    int i;
+
+    seq_printf(m, "%-10s %12s %12s\n", "cmd", "count", "errors");
+    for (i = 0; i < MG996R_NR_CMDS; i++)
+        seq_printf(m, "%-10s %12lld %12lld\n", mg996r_cmd_names[i],
+                   atomic64_read(&dev->stats.cmd_count[i]),
+                   atomic64_read(&dev->stats.err_count[i]));
+    seq_printf(m, "clamped    %12lld\n", atomic64_read(&dev->stats.clamped));
+    return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(stats);
+
+static void hist_show(struct seq_file *m, atomic64_t *hist)
+{
+    int i;
+
+    seq_printf(m, "%12s %12s\n", ">=ns", "count");
+    for (i = 0; i < MG996R_HIST_BUCKETS; i++) {
+        s64 n = atomic64_read(&hist[i]);
+        if (n) seq_printf(m, "%12llu %12lld\n", 1ULL << i, n);
+    }
+}
+
+static int apply_latency_show(struct seq_file *m, void *v)
+{
+    struct mg996r_dev *dev = m->private;
+
+    hist_show(m, dev->stats.apply_hist);
+    return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(apply_latency);
+
+static int lock_wait_show(struct seq_file *m, void *v)
+{
+    struct mg996r_dev *dev = m->private;
+
+    hist_show(m, dev->stats.lock_hist);
+    return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(lock_wait);
+
+static ssize_t reset_write(struct file *file, const char __user *buf,
+                           size_t len, loff_t *ppos)
+{
+    struct mg996r_dev *dev = file->private_data;
+
+    stats_reset(&dev->stats);
+    return len;
+}
+
+static const struct file_operations reset_fops = {
+    .owner = THIS_MODULE,
+    .open  = simple_open,
+    .write = reset_write,
+};
+
+static void mg996r_debugfs_init(struct mg996r_dev *dev)
+{
+    // debugfs 실패는 드라이버 동작에 영향 없음 → 에러 무시
+    dev->dbg_dir = debugfs_create_dir(MG996R_DEV_NAME, NULL);
+    debugfs_create_file("stats",         0444, dev->dbg_dir, dev, &stats_fops);
+    debugfs_create_file("apply_latency", 0444, dev->dbg_dir, dev, &apply_latency_fops);
+    debugfs_create_file("lock_wait",     0444, dev->dbg_dir, dev, &lock_wait_fops);
+    debugfs_create_file("reset",         0200, dev->dbg_dir, dev, &reset_fops);
+}
+
 // ─────────────────────────────────────────────
 //  모듈 초기화
 // ─────────────────────────────────────────────
@@ -264,14 +569,16 @@ static int __init mg996r_init(void)
     if (!g_dev) return -ENOMEM;
 
     mutex_init(&g_dev->lock);
-    g_dev->pan_angle  = MG996R_CENTER;
-    g_dev->tilt_angle = MG996R_CENTER;
+    seqcount_mutex_init(&g_dev->seq, &g_dev->lock);
+    g_dev->pan_mdeg   = MG996R_CENTER_MDEG;
+    g_dev->tilt_mdeg  = MG996R_CENTER_MDEG;
+    g_dev->commit_ns  = ktime_get_ns();
 
     // ── PWM 초기화 ────────────────────────────
-    ret = pwm_ch_init(0, MG996R_CENTER);   // Pan  (GPIO18)
+    ret = pwm_ch_init(0, MG996R_CENTER_MDEG);   // Pan  (GPIO18)
     if (ret) { pr_err("mg996r: pan init failed\n");  goto err_free; }
 
-    ret = pwm_ch_init(1, MG996R_CENTER);   // Tilt (GPIO19)
+    ret = pwm_ch_init(1, MG996R_CENTER_MDEG);   // Tilt (GPIO19)
     if (ret) { pr_err("mg996r: tilt init failed\n"); goto err_pan; }
 
     // ── character device 등록 ─────────────────
@@ -297,6 +604,8 @@ static int __init mg996r_init(void)
         goto err_class;
     }
 
+    mg996r_debugfs_init(g_dev);
+
     pr_info("mg996r: loaded → /dev/%s (pan=GPIO18/pwm0, tilt=GPIO19/pwm1)\n",
             MG996R_DEV_NAME);
     return 0;
@@ -322,10 +631,11 @@ err_free:
 static void __exit mg996r_exit(void)
 {
     // 중앙 복귀
-    pwm_set_angle(0, MG996R_CENTER);
-    pwm_set_angle(1, MG996R_CENTER);
+    pwm_set_mdeg(0, MG996R_CENTER_MDEG);
+    pwm_set_mdeg(1, MG996R_CENTER_MDEG);
     msleep(300);
 
+    debugfs_remove_recursive(g_dev->dbg_dir);
     device_destroy(g_dev->class, g_dev->devno);
     class_destroy(g_dev->class);
     cdev_del(&g_dev->cdev);
@@ -344,4 +654,4 @@ module_exit(mg996r_exit);
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("GNAGHEE");
 MODULE_DESCRIPTION("MG996R Pan/Tilt servo driver - sysfs PWM");
-MODULE_VERSION("1.3");
\ No newline at end of file
+MODULE_VERSION("2.0");
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+ * mg996r_trace.h - MG996R 드라이버 tracepoint 정의
+ *
+ * 사용 예:
+ *   trace-cmd record -e mg996r
+ *   perf record -e 'mg996r:*' -a
+ */
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM mg996r
+
+#if !defined(_MG996R_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _MG996R_TRACE_H
+
+#include <linux/tracepoint.h>
+
+// ─────────────────────────────────────────────
+//  ioctl 진입 / 종료
+// ─────────────────────────────────────────────
+TRACE_EVENT(mg996r_ioctl_enter,
+
+    TP_PROTO(unsigned int cmd),
+
+    TP_ARGS(cmd),
+
+    TP_STRUCT__entry(
+        __field(unsigned int, nr)
+    ),
+
+    TP_fast_assign(
+        __entry->nr = _IOC_NR(cmd);
+    ),
+
+    TP_printk("nr=%u", __entry->nr)
+);
+
+TRACE_EVENT(mg996r_ioctl_exit,
+
+    TP_PROTO(unsigned int cmd, long ret, u64 elapsed_ns),
+
+    TP_ARGS(cmd, ret, elapsed_ns),
+
+    TP_STRUCT__entry(
+        __field(unsigned int, nr)
+        __field(long,         ret)
+        __field(u64,          elapsed_ns)
+    ),
+
+    TP_fast_assign(
+        __entry->nr         = _IOC_NR(cmd);
+        __entry->ret        = ret;
+        __entry->elapsed_ns = elapsed_ns;
+    ),
+
+    TP_printk("nr=%u ret=%ld elapsed=%lluns",
+              __entry->nr, __entry->ret, __entry->elapsed_ns)
+);
+
+// ─────────────────────────────────────────────
+//  dev->lock 획득 (대기 시간 포함)
+// ─────────────────────────────────────────────
+TRACE_EVENT(mg996r_lock_acquired,
+
+    TP_PROTO(unsigned int cmd, u64 wait_ns),
+
+    TP_ARGS(cmd, wait_ns),
+
+    TP_STRUCT__entry(
+        __field(unsigned int, nr)
+        __field(u64,          wait_ns)
+    ),
+
+    TP_fast_assign(
+        __entry->nr      = _IOC_NR(cmd);
+        __entry->wait_ns = wait_ns;
+    ),
+
+    TP_printk("nr=%u wait=%lluns", __entry->nr, __entry->wait_ns)
+);
+
+// ─────────────────────────────────────────────
+//  PWM duty 적용
+// ─────────────────────────────────────────────
+TRACE_EVENT(mg996r_pwm_apply,
+
+    TP_PROTO(int ch, int mdeg, int ret, u64 apply_ns),
+
+    TP_ARGS(ch, mdeg, ret, apply_ns),
+
+    TP_STRUCT__entry(
+        __field(int, ch)
+        __field(int, mdeg)
+        __field(int, ret)
+        __field(u64, apply_ns)
+    ),
+
+    TP_fast_assign(
+        __entry->ch       = ch;
+        __entry->mdeg     = mdeg;
+        __entry->ret      = ret;
+        __entry->apply_ns = apply_ns;
+    ),
+
+    TP_printk("pwm%d mdeg=%d ret=%d apply=%lluns",
+              __entry->ch, __entry->mdeg, __entry->ret, __entry->apply_ns)
+);
+
+#endif /* _MG996R_TRACE_H */
+
+// 아래는 반드시 include guard 밖에 위치
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE mg996r_trace
+#include <trace/define_trace.h>
@@ -0,0 +1,309 @@
+// MPU6050 FIFO 모의 센서 + mpu6050_fifo 검사 (센서 없이)
+//
+// mpu6050.c 대신 레지스터 읽기 / 쓰기를 가상 시계 위의 센서 모델로 돌려
+// mpu6050_fifo.c 를 그대로 시험한다.
+//   - 센서: SMPLRT_DIV 주기마다 12 바이트 프레임을 1 KB FIFO 에 쌓음, 꽉 차면 가장
+//     오래된 바이트를 덮고 INT_STATUS FIFO_OFLOW_INT (INT_ENABLE 에 켜져 있으면)
+//   - I2C: 비트마다 1 / 버스 클럭 (START/STOP 1 비트, 바이트당 9 비트), FIFO_R_W 는
+//     한 바이트 읽을 때마다 시계가 가고 그동안 센서가 계속 쌓음 → 읽는 도중 넘침
+//   - 프레임에 샘플 번호를 넣어 (ax / ay = 번호, gx / gy = 그 반전, az / gz = 표지)
+//     돌려받은 프레임이 경계에 맞는지, 번호가 이어지는지, 시각이 맞는지 확인
+//
+// 시나리오 (버스 / 샘플률 / drain 간격) 마다 PASS / FAIL, 하나라도 FAIL 이면 종료 코드 1.
+// 모두 경계 어긋난 프레임, 알리지 않고 빠진 프레임, 시각 역행이 없어야 함.
+//   400 kHz / 1 kHz / 20 ms   넘침 없음
+//   100 kHz / 500 Hz / 20 ms  넘침 없음
+//   100 kHz / 1 kHz / 20 ms   버스가 못 따라감: 넘침
+//   100 kHz / 500 Hz, 400 kHz / 1 kHz + 0.5 초마다 멈춤: FIFO 가 온전한 프레임으로 꽉 찰
+//     (FIFO_COUNT 1020, 한도 안) 때까지 기다렸다가 다음 프레임 100 비트 전에 drain →
+//     FIFO_COUNT 를 읽은 뒤 첫 프레임을 다 읽기 전에 프레임이 들어와 넘침. INT_STATUS 로
+//     잡아 그 drain 을 버려야 함 (나머지 drain 은 그대로 받음)
+//
+// 빌드: make fifo_sim
+// 실행: ./fifo_sim [-t sec] [-v]
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "mpu6050.h"
+#include "mpu6050_fifo.h"
+
+#define SIM_SECONDS     20
+#define MARK_A          0x5A5A      // az 표지
+#define MARK_G          0xA5A5      // gz 표지
+#define JITTER_NS       2000000     // drain 간격 흔들림 (0 ~ 2 ms)
+#define STALL_EVERY     500000000   // 멈춤 간격 (ns)
+#define STALL_LEAD_BITS 100         // 멈춘 뒤 drain 을 다음 프레임 이만큼 전에 (버스 비트)
+
+// ─────────────────────────────────────────────
+//  센서 + 버스 모델
+// ─────────────────────────────────────────────
+typedef struct {
+    int64_t  now_ns;
+    long     bus_hz;
+    double   period_ns;             // 실제 샘플 주기
+    double   next_ns;               // 다음 프레임 시각
+    uint32_t idx;                   // 다음 프레임 번호
+    int      enabled;               // USER_CTRL FIFO_EN
+    uint8_t  fifo_en, int_enable, int_status;
+    uint8_t  q[MPU6050_FIFO_SIZE];
+    int      head, count;
+    int64_t *born;                  // 프레임 번호 → 쌓인 시각
+    size_t   nborn;
+    int      reading;               // FIFO_R_W 읽는 중
+    uint64_t oflow_read;            // 읽는 도중 넘친 횟수
+    uint64_t oflow_total;
+} Sensor;
+
+static Sensor   S;
+static uint64_t rng = 88172645463325252ULL;
+
+static double urand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (rng >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void push_byte(uint8_t b)
+{
+    if (S.count == MPU6050_FIFO_SIZE) {         // 가장 오래된 바이트를 덮음
+        S.head = (S.head + 1) % MPU6050_FIFO_SIZE;
+        S.count--;
+        if (!(S.int_status & 0x10)) {
+            S.oflow_total++;
+            if (S.reading) S.oflow_read++;
+        }
+        if (S.int_enable & 0x10) S.int_status |= 0x10;
+    }
+    S.q[(S.head + S.count++) % MPU6050_FIFO_SIZE] = b;
+}
+
+static void push_frame(void)
+{
+    uint16_t w[6] = { S.idx & 0xffff, S.idx >> 16, MARK_A,
+                      ~S.idx & 0xffff, ~(S.idx >> 16) & 0xffff, MARK_G };
+
+    if (S.idx < S.nborn) S.born[S.idx] = (int64_t)S.next_ns;
+    for (int i = 0; i < 6; i++) {
+        push_byte(w[i] >> 8);
+        push_byte(w[i] & 0xff);
+    }
+    S.idx++;
+}
+
+// 센서 시간을 t 까지
+static void advance(int64_t t)
+{
+    while (S.next_ns <= t) {
+        if (S.enabled && (S.fifo_en & 0x78) == 0x78) push_frame();
+        S.next_ns += S.period_ns;
+    }
+    S.now_ns = t;
+}
+
+static void bus_bits(int bits)
+{
+    advance(S.now_ns + (int64_t)(bits * 1e9 / S.bus_hz));
+}
+
+// ─────────────────────────────────────────────
+//  mpu6050.c 대신 (mpu6050_fifo.c 가 쓰는 것만)
+// ─────────────────────────────────────────────
+int64_t mpu6050_now_ns(void)
+{
+    return S.now_ns;
+}
+
+int mpu6050_write_reg(Mpu6050 *m, uint8_t reg, uint8_t val)
+{
+    m->xfers++;
+    bus_bits(1 + 9 + 9 + 9 + 1);
+    switch (reg) {
+    case MPU6050_SMPLRT_DIV: S.period_ns = (val + 1) * 1e6; break;
+    case MPU6050_FIFO_EN:    S.fifo_en    = val; break;
+    case MPU6050_INT_ENABLE: S.int_enable = val; break;
+    case MPU6050_USER_CTRL:
+        if (val & 0x04) S.head = S.count = 0;   // FIFO_RESET
+        S.enabled = (val & 0x40) != 0;
+        break;
+    }
+    return 0;
+}
+
+int mpu6050_read_regs(Mpu6050 *m, uint8_t reg, uint8_t *buf, size_t len)
+{
+    m->xfers++;
+    bus_bits(1 + 9 + 9 + 1 + 9);                // 주소 쓰기 + repeated START + 주소
+    switch (reg) {
+    case MPU6050_FIFO_COUNTH:
+        buf[0] = S.count >> 8;
+        buf[1] = S.count & 0xff;
+        bus_bits(len * 9);
+        break;
+    case MPU6050_INT_STATUS:
+        buf[0] = S.int_status;
+        S.int_status = 0;                       // 읽으면 지워짐
+        bus_bits(9);
+        break;
+    case MPU6050_FIFO_R_W:
+        S.reading = 1;
+        for (size_t i = 0; i < len; i++) {
+            if (S.count) {
+                buf[i] = S.q[S.head];
+                S.head = (S.head + 1) % MPU6050_FIFO_SIZE;
+                S.count--;
+            } else {
+                buf[i] = 0xff;
+            }
+            bus_bits(9);
+        }
+        S.reading = 0;
+        break;
+    default:
+        memset(buf, 0, len);
+        bus_bits(len * 9);
+    }
+    bus_bits(1);
+    return 0;
+}
+
+void mpu6050_decode(const uint8_t *p, Mpu6050Sample *s)
+{
+    s->ax   = (int16_t)((p[0] << 8) | p[1]);
+    s->ay   = (int16_t)((p[2] << 8) | p[3]);
+    s->az   = (int16_t)((p[4] << 8) | p[5]);
+    s->temp = (int16_t)((p[6] << 8) | p[7]);
+    s->gx   = (int16_t)((p[8] << 8) | p[9]);
+    s->gy   = (int16_t)((p[10] << 8) | p[11]);
+    s->gz   = (int16_t)((p[12] << 8) | p[13]);
+}
+
+// ─────────────────────────────────────────────
+//  시나리오
+// ─────────────────────────────────────────────
+typedef struct {
+    long   bus_hz;
+    int    rate_hz;
+    int    drain_ms;
+    int    stall;                   // 1: STALL_EVERY 마다 FIFO 가 꽉 찰 때까지 멈춤
+    int    expect_overflow;         // 1: 넘침이 나야 함, 2: 읽는 도중 넘침이 나야 함
+} Scenario;
+
+static const Scenario SCENARIOS[] = {
+    { 400000, 1000, 20, 0, 0 },
+    { 100000,  500, 20, 0, 0 },
+    { 100000, 1000, 20, 0, 1 },
+    { 100000,  500, 20, 1, 2 },
+    { 400000, 1000, 20, 1, 2 },
+};
+
+static int run(const Scenario *sc, double secs, int verbose)
+{
+    Mpu6050       m = { .fd = -1, .addr = MPU6050_ADDR };
+    Mpu6050Fifo   f;
+    Mpu6050Sample s[MPU6050_FIFO_FRAMES];
+    uint64_t      bad = 0, gaps = 0, dup = 0, got = 0;
+    int64_t       prev_ns = 0, err_max = 0, warm_ns = 1000000000;
+    uint32_t      prev = UINT32_MAX;
+
+    memset(&S, 0, sizeof(S));
+    S.bus_hz    = sc->bus_hz;
+    S.period_ns = 1e6;                          // SMPLRT_DIV 0: 자이로 출력률 1 kHz
+    S.next_ns   = 1e6 * urand();
+    S.nborn     = (size_t)(secs * 1000) + 1000;
+    S.born      = calloc(S.nborn, sizeof(int64_t));
+    if (!S.born) return -1;
+
+    if (mpu6050_fifo_start(&f, &m, sc->rate_hz, MPU6050_DLPF_188HZ, 0) < 0) {
+        perror("FIFO start");
+        free(S.born);
+        return -1;
+    }
+    int64_t end = S.now_ns + (int64_t)(secs * 1e9), stall = S.now_ns + STALL_EVERY;
+    while (S.now_ns < end) {
+        if (sc->stall && S.now_ns >= stall) {
+            while (S.count + 12 <= f.full) advance((int64_t)S.next_ns + 1);
+            advance((int64_t)S.next_ns - (int64_t)(STALL_LEAD_BITS * 1e9 / S.bus_hz));
+            stall = S.now_ns + STALL_EVERY;
+        } else {
+            advance(S.now_ns + sc->drain_ms * 1000000LL + (int64_t)(JITTER_NS * urand()));
+        }
+        int n = mpu6050_fifo_drain(&f, s, MPU6050_FIFO_FRAMES);
+        if (n < 0) {
+            if (errno != EOVERFLOW) {
+                perror("drain");
+                break;
+            }
+            if (verbose) printf("    %.3f s: overflow\n", S.now_ns / 1e9);
+            prev = UINT32_MAX;                  // 버린 구간 뒤는 번호가 건너뜀
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            uint32_t k = (uint16_t)s[i].ax | ((uint32_t)(uint16_t)s[i].ay << 16);
+            if ((uint16_t)s[i].az != MARK_A || (uint16_t)s[i].gz != MARK_G ||
+                (uint16_t)(s[i].gx ^ s[i].ax) != 0xffff || (uint16_t)(s[i].gy ^ s[i].ay) != 0xffff) {
+                bad++;                          // 프레임 경계 어긋남
+                prev = UINT32_MAX;
+                continue;
+            }
+            if (prev != UINT32_MAX && k != prev + 1) {
+                if (k <= prev) dup++;
+                else           gaps++;
+            }
+            if (prev_ns && s[i].t_ns <= prev_ns) dup++;
+            if (k < S.nborn && s[i].t_ns > warm_ns) {
+                int64_t e = s[i].t_ns - S.born[k];
+                if (e < 0) e = -e;
+                if (e > err_max) err_max = e;
+            }
+            prev    = k;
+            prev_ns = s[i].t_ns;
+            got++;
+        }
+    }
+
+    int pass = (bad == 0 && dup == 0 && gaps == 0);
+    if (sc->expect_overflow == 0) pass = pass && f.stats.overflows == 0 && f.stats.lost == 0;
+    if (sc->expect_overflow >= 1) pass = pass && f.stats.overflows > 0;
+    if (sc->expect_overflow == 2) pass = pass && S.oflow_read > 0 && got > 0;
+
+    printf("  %s  bus %3ld kHz, %4d Hz, drain %2d ms%s: frames %llu, overflows %llu (sensor %llu, "
+           "during read %llu), lost %llu, misaligned %llu, gaps %llu, out of order %llu, "
+           "time err max %.0f us\n",
+           pass ? "PASS" : "FAIL", sc->bus_hz / 1000, sc->rate_hz, sc->drain_ms,
+           sc->stall ? " + stalls" : "",
+           (unsigned long long)got, (unsigned long long)f.stats.overflows,
+           (unsigned long long)S.oflow_total, (unsigned long long)S.oflow_read,
+           (unsigned long long)f.stats.lost, (unsigned long long)bad,
+           (unsigned long long)gaps, (unsigned long long)dup, err_max / 1e3);
+    free(S.born);
+    return pass ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    double secs = SIM_SECONDS;
+    int    verbose = 0, opt, fail = 0;
+
+    while ((opt = getopt(argc, argv, "t:v")) != -1) {
+        switch (opt) {
+            case 't': secs    = atof(optarg); break;
+            case 'v': verbose = 1;            break;
+            default:
+                fprintf(stderr, "usage: %s [-t sec] [-v]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (secs <= 0) secs = SIM_SECONDS;
+
+    for (size_t i = 0; i < sizeof(SCENARIOS) / sizeof(SCENARIOS[0]); i++) {
+        int r = run(&SCENARIOS[i], secs, verbose);
+        if (r < 0) return 2;
+        fail += r;
+    }
+    return fail ? 1 : 0;
+}
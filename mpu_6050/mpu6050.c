@@ -0,0 +1,175 @@
+#include "mpu6050.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static inline int16_t be16(const uint8_t *p)
+{
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief I2C_RDWR 한 번 (모든 메시지가 가야 성공)
+ */
+static int transfer(Mpu6050 *m, struct i2c_msg *msgs, int n)
+{
+    struct i2c_rdwr_ioctl_data x = { .msgs = msgs, .nmsgs = n };
+    int r = ioctl(m->fd, I2C_RDWR, &x);
+
+    m->xfers++;
+    if (r == n) return 0;
+    if (r >= 0) errno = EIO;
+    m->errors++;
+    return -1;
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+int mpu6050_open(Mpu6050 *m, const char *dev, int addr)
+{
+    *m = (Mpu6050){ .fd = -1, .addr = addr ? addr : MPU6050_ADDR };
+
+    if ((m->fd = open(dev ? dev : MPU6050_DEV, O_RDWR)) < 0) return -1;
+    // I2C_RDWR 은 메시지마다 주소를 주지만 read_word (write / read) 경로용으로 설정
+    if (ioctl(m->fd, I2C_SLAVE, m->addr) < 0 ||
+        mpu6050_write_reg(m, MPU6050_PWR_MGMT_1, 0) < 0) {
+        int e = errno;
+        close(m->fd);
+        m->fd = -1;
+        errno = e;
+        return -1;
+    }
+    return 0;
+}
+
+int mpu6050_read_regs(Mpu6050 *m, uint8_t reg, uint8_t *buf, size_t len)
+{
+    struct i2c_msg msgs[2] = {
+        { .addr = m->addr, .flags = 0,        .len = 1,   .buf = &reg },
+        { .addr = m->addr, .flags = I2C_M_RD, .len = len, .buf = buf  },
+    };
+
+    if (len == 0 || len > UINT16_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    return transfer(m, msgs, 2);
+}
+
+int mpu6050_write_reg(Mpu6050 *m, uint8_t reg, uint8_t val)
+{
+    uint8_t b[2] = { reg, val };
+    struct i2c_msg msg = { .addr = m->addr, .flags = 0, .len = 2, .buf = b };
+
+    return transfer(m, &msg, 1);
+}
+
+void mpu6050_decode(const uint8_t *buf, Mpu6050Sample *s)
+{
+    s->ax   = be16(buf + 0);
+    s->ay   = be16(buf + 2);
+    s->az   = be16(buf + 4);
+    s->temp = be16(buf + 6);
+    s->gx   = be16(buf + 8);
+    s->gy   = be16(buf + 10);
+    s->gz   = be16(buf + 12);
+}
+
+int mpu6050_read(Mpu6050 *m, Mpu6050Sample *s)
+{
+    uint8_t buf[MPU6050_BURST_LEN];
+
+    if (mpu6050_read_regs(m, MPU6050_ACCEL_XOUT_H, buf, sizeof(buf)) < 0) return -1;
+    mpu6050_decode(buf, s);
+    s->t_ns = mpu6050_now_ns();
+    m->reads++;
+    return 0;
+}
+
+int mpu6050_read_word(Mpu6050 *m, uint8_t reg, int16_t *v)
+{
+    uint8_t buf[2];
+
+    errno = 0;
+    m->xfers += 2;
+    if (write(m->fd, &reg, 1) != 1 || read(m->fd, buf, 2) != 2) {
+        if (errno == 0) errno = EIO;
+        m->errors++;
+        return -1;
+    }
+    *v = be16(buf);
+    return 0;
+}
+
+int mpu6050_gyro_bias(Mpu6050 *m, int n, int interval_us, double bias[3])
+{
+    int64_t sx = 0, sy = 0, sz = 0;
+    int ok = 0;
+    Mpu6050Sample s;
+
+    if (n <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (mpu6050_read(m, &s) == 0) {
+            sx += s.gx;
+            sy += s.gy;
+            sz += s.gz;
+            ok++;
+        }
+        if (interval_us > 0) usleep(interval_us);
+    }
+    if (ok * 2 < n) return -1;             // errno: 마지막 실패
+    bias[0] = sx / (double)ok;
+    bias[1] = sy / (double)ok;
+    bias[2] = sz / (double)ok;
+    return 0;
+}
+
+double mpu6050_temp_c(int16_t raw)
+{
+    return raw / 340.0 + 36.53;
+}
+
+long mpu6050_bus_hz(const char *dev)
+{
+    char path[96];
+    unsigned char b[4];
+    int bus;
+
+    if (!dev || sscanf(dev, "/dev/i2c-%d", &bus) != 1) return 0;
+    snprintf(path, sizeof(path), "/sys/bus/i2c/devices/i2c-%d/of_node/clock-frequency", bus);
+    FILE *f = fopen(path, "rb");
+    if (!f) return 0;
+    size_t n = fread(b, 1, sizeof(b), f);
+    fclose(f);
+    if (n != sizeof(b)) return 0;
+    return ((long)b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3];     // big-endian u32
+}
+
+int64_t mpu6050_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void mpu6050_close(Mpu6050 *m)
+{
+    if (m->fd >= 0) close(m->fd);
+    m->fd = -1;
+}
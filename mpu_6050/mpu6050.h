@@ -0,0 +1,135 @@
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ─────────────────────────────────────────────
+//  MPU6050 I2C 드라이버
+//
+//  - 가속도 / 온도 / 자이로 (0x3B ~ 0x48, 14 바이트) 를 I2C_RDWR 한 번으로 읽음:
+//    레지스터 주소 쓰기 + repeated START + 14 바이트 읽기 (STOP 없이 한 트랜잭션)
+//  - 센서는 burst 읽기 동안 출력 레지스터를 갱신하지 않으므로 7 값이 같은 샘플
+//    (read_word 6 번은 축마다 다른 샘플일 수 있음)
+//  - 실패는 0 대신 -1 + errno (EIO: 일부 메시지만 전송됨)
+// ─────────────────────────────────────────────
+
+#define MPU6050_DEV         "/dev/i2c-1"    // GPIO2/3 (물리핀 3/5)
+#define MPU6050_ADDR        0x68            // AD0 = GND (VCC 이면 0x69)
+
+// 레지스터
+#define MPU6050_SMPLRT_DIV      0x19        // 샘플률 = 자이로 출력률 / (1 + div)
+#define MPU6050_CONFIG          0x1A        // DLPF_CFG (bit 2:0)
+#define MPU6050_FIFO_EN         0x23
+#define MPU6050_INT_ENABLE      0x38
+#define MPU6050_INT_STATUS      0x3A        // 읽으면 0 이 됨
+#define MPU6050_ACCEL_XOUT_H    0x3B        // ~ 0x48: accel xyz, temp, gyro xyz (big-endian)
+#define MPU6050_TEMP_OUT_H      0x41
+#define MPU6050_GYRO_XOUT_H     0x43
+#define MPU6050_USER_CTRL       0x6A
+#define MPU6050_PWR_MGMT_1      0x6B
+#define MPU6050_FIFO_COUNTH     0x72        // FIFO_COUNTL 0x73
+#define MPU6050_FIFO_R_W        0x74
+#define MPU6050_WHO_AM_I        0x75        // 0x68 (AD0 무관)
+
+#define MPU6050_BURST_LEN   14              // 0x3B ~ 0x48
+
+// 기본 범위 (±2 g, ±250 °/s) 의 LSB 당 값
+#define MPU6050_ACCEL_SCALE 16384.0         // LSB/g
+#define MPU6050_GYRO_SCALE  131.0           // LSB/(°/s)
+
+// 상보 필터 시정수 (s): 이보다 짧은 변화는 자이로, 긴 쪽은 가속도 기울기를 따름
+#define MPU6050_CF_TAU      0.5
+
+typedef struct {
+    int      fd;
+    uint8_t  addr;
+    uint64_t reads;                 // 성공한 샘플 읽기
+    uint64_t errors;                // 실패한 I2C 트랜잭션
+    uint64_t xfers;                 // I2C syscall (I2C_RDWR / write / read)
+} Mpu6050;
+
+// 한 번의 burst 읽기로 얻은 원시값
+typedef struct {
+    int16_t ax, ay, az;
+    int16_t temp;
+    int16_t gx, gy, gz;
+    int64_t t_ns;                   // 읽기 완료 시각 (CLOCK_MONOTONIC)
+} Mpu6050Sample;
+
+/**
+ * @brief I2C 버스 열기 + sleep 해제 (PWR_MGMT_1 = 0)
+ * @param dev  장치 경로 (NULL 이면 MPU6050_DEV)
+ * @param addr 7비트 주소 (0 이면 MPU6050_ADDR)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int mpu6050_open(Mpu6050 *m, const char *dev, int addr);
+
+/**
+ * @brief 연속 레지스터 읽기 (주소 쓰기 + repeated START 읽기, I2C_RDWR 한 번)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int mpu6050_read_regs(Mpu6050 *m, uint8_t reg, uint8_t *buf, size_t len);
+
+/**
+ * @brief 레지스터 하나 쓰기
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int mpu6050_write_reg(Mpu6050 *m, uint8_t reg, uint8_t val);
+
+/**
+ * @brief 가속도 / 온도 / 자이로 burst 읽기
+ * @return 0: 성공, -1: 실패 (errno 설정, s 는 그대로)
+ */
+int mpu6050_read(Mpu6050 *m, Mpu6050Sample *s);
+
+/**
+ * @brief 0x3B 부터의 14 바이트를 원시값으로 (t_ns 는 건드리지 않음)
+ */
+void mpu6050_decode(const uint8_t *buf, Mpu6050Sample *s);
+
+/**
+ * @brief 16비트 레지스터 하나 읽기 (write + read 두 번, 비교 / 벤치마크용)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int mpu6050_read_word(Mpu6050 *m, uint8_t reg, int16_t *v);
+
+/**
+ * @brief 정지 상태 자이로 바이어스 (n 샘플 평균, interval_us 간격, 실패한 읽기는 제외)
+ * @param bias 원시값 단위 x, y, z
+ * @return 0: 성공, -1: 절반 넘게 읽기 실패 (errno 설정)
+ */
+int mpu6050_gyro_bias(Mpu6050 *m, int n, int interval_us, double bias[3]);
+
+/**
+ * @brief 온도 원시값 → °C
+ */
+double mpu6050_temp_c(int16_t raw);
+
+/**
+ * @brief 버스 클럭 (device tree clock-frequency, "/dev/i2c-N" 만)
+ * @return Hz, 0: 모름
+ */
+long mpu6050_bus_hz(const char *dev);
+
+/**
+ * @brief CLOCK_MONOTONIC (ns)
+ */
+int64_t mpu6050_now_ns(void);
+
+/**
+ * @brief 닫기
+ */
+void mpu6050_close(Mpu6050 *m);
+
+/**
+ * @brief 상보 필터 계수 alpha = TAU / (TAU + dt)
+ *        샘플 간격 dt (s) 가 바뀌어도 (샘플률, 빠진 샘플) 시정수는 MPU6050_CF_TAU 로 고정
+ *        (1 kHz 에서 0.998, 500 Hz 에서 0.996)
+ */
+static inline double mpu6050_cf_alpha(double dt)
+{
+    return MPU6050_CF_TAU / (MPU6050_CF_TAU + dt);
+}
+
+#endif /* MPU6050_H */
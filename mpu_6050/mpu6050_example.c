@@ -1,20 +1,12 @@
 #include <stdio.h>
 #include <stdint.h>
-#include <fcntl.h>
 #include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
 #include <math.h>
 #include <time.h>
+#include "mpu6050.h"
 
-#define MPU_ADDR 0x68
-
-#define PWR_MGMT_1   0x6B
-#define ACCEL_XOUT_H 0x3B
-#define GYRO_XOUT_H  0x43
-
-#define ACCEL_SCALE 16384.0
-#define GYRO_SCALE  131.0
+#define ACCEL_SCALE MPU6050_ACCEL_SCALE
+#define GYRO_SCALE  MPU6050_GYRO_SCALE
 
 // 시간 측정
 double get_delta_time() {
@@ -30,14 +22,6 @@ double get_delta_time() {
     return dt;
 }
 
-// I2C에서 16bit 값 읽기
-int16_t read_word(int fd, uint8_t reg) {
-    uint8_t buf[2];
-    if (write(fd, &reg, 1) != 1) return 0;
-    if (read(fd, buf, 2) != 2) return 0;
-    return (buf[0] << 8) | buf[1];
-}
-
 // -180 ~ 180
 double angle180(double angle) {
     while(angle > 180.0) angle -= 360.0;
@@ -53,30 +37,25 @@ double clamp90(double angle) {
 }
 
 int main() {
-    int fd;
-    const char *device = "/dev/i2c-1";
-
-    if ((fd = open(device, O_RDWR)) < 0) return 1;
-    if (ioctl(fd, I2C_SLAVE, MPU_ADDR) < 0) return 1;
+    Mpu6050 m;
+    Mpu6050Sample s;
 
-    // MPU-6050 Sleep 모드 해제
-    if (write(fd, (uint8_t[]){PWR_MGMT_1, 0}, 2) != 2) return 1;
+    // I2C 열기 + MPU-6050 Sleep 모드 해제
+    if (mpu6050_open(&m, MPU6050_DEV, MPU6050_ADDR) < 0) { perror("MPU6050 open"); return 1; }
 
     double pitch = 0, roll = 0, yaw = 0;
     double alpha = 0.98;
 
     while (1) {
+        // 6축 + 온도 한 번에 (실패 시 이번 샘플 건너뜀, dt 는 다음 샘플에 누적)
+        if (mpu6050_read(&m, &s) < 0) { perror("MPU6050 read"); usleep(500000); continue; }
         double dt = get_delta_time();
 
         // 가속도 raw 읽기
-        int16_t ax = read_word(fd, ACCEL_XOUT_H);
-        int16_t ay = read_word(fd, ACCEL_XOUT_H + 2);
-        int16_t az = read_word(fd, ACCEL_XOUT_H + 4);
+        int16_t ax = s.ax, ay = s.ay, az = s.az;
 
         // 자이로 raw 읽기
-        int16_t gx = read_word(fd, GYRO_XOUT_H);
-        int16_t gy = read_word(fd, GYRO_XOUT_H + 2);
-        int16_t gz = read_word(fd, GYRO_XOUT_H + 4);
+        int16_t gx = s.gx, gy = s.gy, gz = s.gz;
 
         // 단위 변환
         double accel_x = ax / ACCEL_SCALE;
@@ -108,6 +87,6 @@ int main() {
         usleep(500000); // 500ms
     }
 
-    close(fd);
+    mpu6050_close(&m);
     return 0;
 }
\ No newline at end of file
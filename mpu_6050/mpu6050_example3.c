@@ -1,42 +1,15 @@
 #include <stdio.h>
 #include <stdint.h>
-#include <fcntl.h>
 #include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
 #include <math.h>
-#include <time.h>
-
-#define MPU_ADDR 0x68
-#define PWR_MGMT_1   0x6B
-#define ACCEL_XOUT_H 0x3B
-#define GYRO_XOUT_H  0x43
-
-#define ACCEL_SCALE 16384.0
-#define GYRO_SCALE  131.0
-
-double get_delta_time() {
-    static struct timespec last = {0,0};
-    struct timespec now;
-    clock_gettime(CLOCK_MONOTONIC, &now);
-
-    double dt;
-    if (last.tv_sec == 0 && last.tv_nsec == 0) {
-        dt = 0.01; // 첫 루프 초기값 10ms
-    } else {
-        dt = (now.tv_sec - last.tv_sec) + (now.tv_nsec - last.tv_nsec)/1e9;
-    }
+#include "mpu6050.h"
+#include "mpu6050_fifo.h"
 
-    last = now;
-    return dt;
-}
+#define ACCEL_SCALE MPU6050_ACCEL_SCALE
+#define GYRO_SCALE  MPU6050_GYRO_SCALE
 
-int16_t read_word(int fd, uint8_t reg) {
-    uint8_t buf[2];
-    if (write(fd, &reg, 1) != 1) return 0;
-    if (read(fd, buf, 2) != 2) return 0;
-    return (buf[0] << 8) | buf[1];
-}
+#define SAMPLE_HZ   1000    // 바라는 센서 샘플률 (FIFO, 버스가 느리면 낮춤)
+#define DRAIN_US    20000   // FIFO 비우는 간격 (1 kHz 에서 85ms 안)
 
 double clamp90(double angle) {
     if(angle > 90.0) return 90.0;
@@ -45,46 +18,56 @@ double clamp90(double angle) {
 }
 
 int main() {
-    int fd;
-    const char *device = "/dev/i2c-1";
-
-    if ((fd = open(device, O_RDWR)) < 0) { perror("Open failed"); return 1; }
-    if (ioctl(fd, I2C_SLAVE, MPU_ADDR) < 0) { perror("I2C_SLAVE failed"); return 1; }
+    Mpu6050 m;
+    Mpu6050Sample s;
 
-    if (write(fd, (uint8_t[]){PWR_MGMT_1, 0}, 2) != 2) { perror("Wake failed"); return 1; }
+    // /dev/i2c-1 열기 + Sleep 해제
+    if (mpu6050_open(&m, MPU6050_DEV, MPU6050_ADDR) < 0) { perror("MPU6050 open failed"); return 1; }
 
     // ===== 자이로 바이어스 10초 =====
     printf("Calibrating gyro... Keep sensor still for 10 sec\n");
     int sample_rate_us = 10000; // 10ms
     int samples = 1000;         // 10초
-    int64_t gx_sum=0, gy_sum=0, gz_sum=0;
-    for(int i=0;i<samples;i++){
-        gx_sum += read_word(fd, GYRO_XOUT_H);
-        gy_sum += read_word(fd, GYRO_XOUT_H + 2);
-        gz_sum += read_word(fd, GYRO_XOUT_H + 4);
-        usleep(sample_rate_us);
-    }
-    double gx_bias = gx_sum / (double)samples;
-    double gy_bias = gy_sum / (double)samples;
-    double gz_bias = gz_sum / (double)samples;
+    double bias[3];
+    if (mpu6050_gyro_bias(&m, samples, sample_rate_us, bias) < 0) { perror("Calibration failed"); return 1; }
+    double gx_bias = bias[0], gy_bias = bias[1], gz_bias = bias[2];
     printf("Gyro bias: %.2f %.2f %.2f\n", gx_bias, gy_bias, gz_bias);
 
     double pitch = 0, roll = 0;
-    double alpha = 0.96; // 실시간 반영률 높임
     int first_loop = 1;
     double print_timer = 0.0; // ms 단위 누적 시간
 
+    // FIFO: 센서가 rate (DLPF 188Hz) 로 쌓고 20ms 마다 한 번에 읽음 → 빠지거나 겹치는 샘플 없음
+    Mpu6050Fifo fifo;
+    Mpu6050Sample buf[MPU6050_FIFO_FRAMES];
+    // 1 kHz 는 400 kHz 버스에서만 (라즈베리파이 기본 100 kHz 는 500 Hz)
+    long bus_hz = mpu6050_bus_hz(MPU6050_DEV);
+    int rate = mpu6050_fifo_bus_rate(bus_hz, SAMPLE_HZ);
+    if (rate < SAMPLE_HZ)
+        printf("I2C bus %s%ld kHz: FIFO %d Hz (%d Hz needs dtparam=i2c_arm_baudrate=400000 in /boot/config.txt)\n",
+               bus_hz ? "" : "clock unknown, assuming ", bus_hz ? bus_hz / 1000 : 100, rate, SAMPLE_HZ);
+    if (mpu6050_fifo_start(&fifo, &m, rate, MPU6050_DLPF_188HZ, 0) < 0) { perror("FIFO start failed"); return 1; }
+    int n = 0, k = 0;
+    int64_t last_ns = 0;
+
     while (1) {
-        double dt = get_delta_time(); // 초 단위
+        // 다 썼으면 기다렸다가 FIFO 비우기 (넘침 / 실패 시 그 구간은 건너뜀, dt 는 다음 샘플에 누적)
+        if (k == n) {
+            usleep(DRAIN_US);
+            k = 0;
+            if ((n = mpu6050_fifo_drain(&fifo, buf, MPU6050_FIFO_FRAMES)) < 0) { perror("FIFO drain"); n = 0; }
+            continue;
+        }
+        s = buf[k++];
+        double dt = last_ns ? (s.t_ns - last_ns) / 1e9 : 1.0 / rate; // 샘플 시각 차
+        last_ns = s.t_ns; // 초 단위
 
         // 가속도 raw 읽기
-        int16_t ax = read_word(fd, ACCEL_XOUT_H);
-        int16_t ay = read_word(fd, ACCEL_XOUT_H + 2);
-        int16_t az = read_word(fd, ACCEL_XOUT_H + 4);
+        int16_t ax = s.ax, ay = s.ay, az = s.az;
 
         // 자이로 raw 읽기 + 바이어스 보정
-        double gx = (double)read_word(fd, GYRO_XOUT_H) - gx_bias;
-        double gy = (double)read_word(fd, GYRO_XOUT_H + 2) - gy_bias;
+        double gx = (double)s.gx - gx_bias;
+        double gy = (double)s.gy - gy_bias;
 
         // 단위 변환
         double accel_x = ax / ACCEL_SCALE;
@@ -104,7 +87,8 @@ int main() {
             first_loop = 0;
         }
 
-        // Complementary Filter 적용
+        // Complementary Filter 적용 (시정수 MPU6050_CF_TAU 고정, 샘플마다 dt 로 alpha)
+        double alpha = mpu6050_cf_alpha(dt);
         pitch = alpha * (pitch + gyro_x * dt) + (1 - alpha) * accel_pitch;
         roll  = alpha * (roll  + gyro_y * dt) + (1 - alpha) * accel_roll;
 
@@ -116,10 +100,8 @@ int main() {
                    clamp90(pitch), clamp90(roll),
                    accel_x, accel_y, accel_z);
         }
-
-        usleep(2000); // 2ms → 500Hz 계산
     }
 
-    close(fd);
+    mpu6050_close(&m);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "mpu6050_fifo.h"
+
+#include <errno.h>
+
+#define CLKSEL_PLL_XGYRO        0x01        // PWR_MGMT_1: 자이로 X PLL (내부 8 MHz 보다 안정)
+#define USER_CTRL_FIFO_EN       0x40
+#define USER_CTRL_FIFO_RESET    0x04        // 스스로 0 이 됨
+#define FIFO_EN_TEMP            0x80
+#define FIFO_EN_GYRO            0x70        // XG | YG | ZG
+#define FIFO_EN_ACCEL           0x08
+#define INT_FIFO_OFLOW          0x10        // INT_ENABLE / INT_STATUS: FIFO 넘침
+#define PERIOD_TOL              0.05        // 주기 추정 허용 범위 (설정값 ±5%)
+#define PERIOD_SPAN_NS          250000000   // 기준 drain 부터 이만큼 쌓이면 주기 추정
+#define BUS_BITS_PER_SAMPLE     200         // 프레임 108 비트 + drain 오버헤드 / 지연 여유
+#define BUS_HZ_DEFAULT          100000      // 클럭을 모를 때 (라즈베리파이 기본)
+
+// ─────────────────────────────────────────────
+//  내부 헬퍼
+// ─────────────────────────────────────────────
+
+static inline int16_t be16(const uint8_t *p)
+{
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static inline int64_t idx_ns(const Mpu6050Fifo *f, int64_t idx)
+{
+    return f->ref_ns + (int64_t)((idx - f->ref_idx) * f->period_ns);
+}
+
+/**
+ * @brief FIFO 비우고 다시 켜기 (리셋은 FIFO 를 끈 상태에서, 데이터시트 권장)
+ *        리셋 전에 남은 넘침 표시는 읽어서 지움
+ */
+static int fifo_reset(Mpu6050Fifo *f)
+{
+    uint8_t st;
+
+    if (mpu6050_write_reg(f->m, MPU6050_USER_CTRL, USER_CTRL_FIFO_RESET) < 0 ||
+        mpu6050_read_regs(f->m, MPU6050_INT_STATUS, &st, 1) < 0 ||
+        mpu6050_write_reg(f->m, MPU6050_USER_CTRL, USER_CTRL_FIFO_EN) < 0)
+        return -1;
+    f->anchored = 0;
+    return 0;
+}
+
+/**
+ * @brief 프레임 경계를 잃었을 때: 비우고 마지막 프레임 이후 분량을 버린 것으로
+ */
+static int discard(Mpu6050Fifo *f, int err)
+{
+    if (fifo_reset(f) < 0) return -1;
+    int64_t now = mpu6050_now_ns();
+    if (f->last_ns && now > f->last_ns)
+        f->stats.lost += (uint64_t)((now - f->last_ns) / f->period_ns);
+    f->last_ns = now;                       // 연달아 버려도 두 번 세지 않음
+    errno = err;
+    return -1;
+}
+
+/**
+ * @brief 시각 기준 갱신
+ *
+ * FIFO 의 가장 최근 프레임 (샘플 newest) 은 FIFO_COUNT 읽기 직전 t0 보다 한 주기
+ * 이내 앞이고 읽기 완료 t1 보다 늦을 수 없다. 예측이 그 구간을 벗어나면 가까운 끝으로 옮긴다.
+ */
+static void stamp(Mpu6050Fifo *f, int64_t newest, int64_t t0, int64_t t1)
+{
+    int64_t lo  = t0 - (int64_t)f->period_ns;
+    int64_t mid = lo + (t1 - lo) / 2;
+
+    if (!f->anchored) {
+        f->ref_ns    = f->first_ns  = mid;
+        f->ref_idx   = f->first_idx = newest;
+        f->anchored  = 1;
+        return;
+    }
+
+    // 센서 시계 주기: 기준 drain 부터 0.25 s 이상 지나면 두 구간 가운데 사이 (오차 ±주기 / 샘플 수)
+    int64_t span = newest - f->first_idx;
+    if (span * f->nominal_ns >= PERIOD_SPAN_NS) {
+        double p = (double)(mid - f->first_ns) / span;
+        if (p > f->nominal_ns * (1.0 + PERIOD_TOL)) p = f->nominal_ns * (1.0 + PERIOD_TOL);
+        if (p < f->nominal_ns * (1.0 - PERIOD_TOL)) p = f->nominal_ns * (1.0 - PERIOD_TOL);
+        // 다음에 돌려줄 샘플 시각이 그대로이도록 기준을 옮긴 뒤 교체
+        f->ref_ns    = idx_ns(f, f->next_idx);
+        f->ref_idx   = f->next_idx;
+        f->period_ns = p;
+    }
+
+    int64_t pred = idx_ns(f, newest), corr = 0;
+    if (pred > t1)      corr = t1 - pred;
+    else if (pred < lo) corr = lo - pred;
+    // 당길 때도 이미 돌려준 프레임과 반 주기 간격은 남김 (시각 역행 없음, 나머지는 다음 drain)
+    if (corr < 0 && f->last_ns) {
+        int64_t room = f->last_ns + (int64_t)(f->period_ns / 2) - idx_ns(f, f->next_idx);
+        if (corr < room) corr = (room < 0) ? room : 0;
+    }
+    if (corr) {
+        f->ref_ns += corr;
+        f->stats.corrections++;
+        if (corr < 0) corr = -corr;
+        if (corr > f->stats.max_correction_ns) f->stats.max_correction_ns = corr;
+    }
+}
+
+// ─────────────────────────────────────────────
+//  API 구현
+// ─────────────────────────────────────────────
+
+int mpu6050_fifo_start(Mpu6050Fifo *f, Mpu6050 *m, int rate_hz, int dlpf, int temp)
+{
+    if (rate_hz < 4 || rate_hz > 1000 || dlpf < MPU6050_DLPF_188HZ || dlpf > MPU6050_DLPF_5HZ) {
+        errno = EINVAL;
+        return -1;
+    }
+    // DLPF 1 ~ 6 에서 자이로 출력률 1 kHz
+    int div = (1000 + rate_hz / 2) / rate_hz - 1;
+
+    *f = (Mpu6050Fifo){ .m = m, .frame = temp ? 14 : 12 };
+    f->full       = (MPU6050_FIFO_SIZE / f->frame) * f->frame;
+    f->nominal_ns = f->period_ns = (div + 1) * 1e6;
+
+    if (mpu6050_write_reg(m, MPU6050_PWR_MGMT_1, CLKSEL_PLL_XGYRO) < 0 ||
+        mpu6050_write_reg(m, MPU6050_USER_CTRL, 0) < 0 ||
+        mpu6050_write_reg(m, MPU6050_FIFO_EN, 0) < 0 ||
+        mpu6050_write_reg(m, MPU6050_CONFIG, dlpf) < 0 ||
+        mpu6050_write_reg(m, MPU6050_SMPLRT_DIV, div) < 0 ||
+        mpu6050_write_reg(m, MPU6050_INT_ENABLE, INT_FIFO_OFLOW) < 0 ||    // 넘침을 INT_STATUS 에
+        mpu6050_write_reg(m, MPU6050_FIFO_EN,
+                          FIFO_EN_ACCEL | FIFO_EN_GYRO | (temp ? FIFO_EN_TEMP : 0)) < 0)
+        return -1;
+    return fifo_reset(f);
+}
+
+int mpu6050_fifo_bus_rate(long bus_hz, int want_hz)
+{
+    long max = (bus_hz > 0 ? bus_hz : BUS_HZ_DEFAULT) / BUS_BITS_PER_SAMPLE;
+
+    if (max < 4) max = 4;
+    if (want_hz > max) want_hz = (int)max;
+    return 1000 / ((1000 + want_hz - 1) / want_hz);     // 1 kHz 를 나눈 값으로 (내림)
+}
+
+int mpu6050_fifo_drain(Mpu6050Fifo *f, Mpu6050Sample *out, int max)
+{
+    uint8_t c[2], st;
+
+    f->stats.drains++;
+    int64_t t0 = mpu6050_now_ns();
+    if (mpu6050_read_regs(f->m, MPU6050_FIFO_COUNTH, c, 2) < 0) return -1;
+    int64_t t1 = mpu6050_now_ns();
+
+    int count = (c[0] << 8) | c[1];
+    if (count > f->full) {
+        f->stats.overflows++;
+        return discard(f, EOVERFLOW);
+    }
+    int avail = count / f->frame;
+    int n     = (avail < max) ? avail : max;
+    if (n <= 0) return 0;
+
+    // 전부 한 트랜잭션으로 (FIFO_R_W 는 주소가 증가하지 않음), 실패하면 어디까지 읽혔는지 모름
+    if (mpu6050_read_regs(f->m, MPU6050_FIFO_R_W, f->buf, n * f->frame) < 0)
+        return discard(f, errno);
+    // FIFO_COUNT 를 읽은 뒤 ~ 읽기가 끝날 때까지 넘쳤으면 (버스가 샘플률을 못 따라갈 때)
+    // 읽은 바이트가 프레임 경계에 맞는지 모름 → 통째로 버림
+    if (mpu6050_read_regs(f->m, MPU6050_INT_STATUS, &st, 1) < 0)
+        return discard(f, errno);
+    if (st & INT_FIFO_OFLOW) {
+        f->stats.overflows++;
+        return discard(f, EOVERFLOW);
+    }
+
+    stamp(f, f->next_idx + avail - 1, t0, t1);
+    for (int i = 0; i < n; i++) {
+        const uint8_t *p = f->buf + i * f->frame;
+        Mpu6050Sample *s = &out[i];
+
+        if (f->frame == 14) {
+            mpu6050_decode(p, s);
+        } else {
+            s->ax = be16(p);
+            s->ay = be16(p + 2);
+            s->az = be16(p + 4);
+            s->temp = 0;
+            s->gx = be16(p + 6);
+            s->gy = be16(p + 8);
+            s->gz = be16(p + 10);
+        }
+        s->t_ns = idx_ns(f, f->next_idx + i);
+    }
+    f->next_idx     += n;
+    f->last_ns       = out[n - 1].t_ns;
+    f->stats.frames += n;
+    f->m->reads     += n;
+    return n;
+}
+
+double mpu6050_fifo_rate(const Mpu6050Fifo *f)
+{
+    return 1e9 / f->period_ns;
+}
+
+int mpu6050_fifo_stop(Mpu6050Fifo *f)
+{
+    if (mpu6050_write_reg(f->m, MPU6050_USER_CTRL, 0) < 0 ||
+        mpu6050_write_reg(f->m, MPU6050_FIFO_EN, 0) < 0 ||
+        mpu6050_write_reg(f->m, MPU6050_INT_ENABLE, 0) < 0)
+        return -1;
+    return 0;
+}
@@ -0,0 +1,105 @@
+#ifndef MPU6050_FIFO_H
+#define MPU6050_FIFO_H
+
+#include <stdint.h>
+#include "mpu6050.h"
+
+// ─────────────────────────────────────────────
+//  MPU6050 하드웨어 FIFO 수집
+//
+//  센서가 SMPLRT_DIV / DLPF 로 정한 주기마다 가속도 (+ 온도) + 자이로 한 프레임을
+//  1 KB FIFO 에 쌓고, 호스트는 가끔 (수십 ms) FIFO_COUNT 를 읽은 뒤 온전한 프레임만
+//  FIFO_R_W 에서 한 트랜잭션으로 모두 읽는다 → usleep 폴링의 빠짐 / 중복 없음,
+//  drain 당 I2C syscall 3 번 (FIFO_COUNT, FIFO_R_W, INT_STATUS).
+//
+//  - 시각: 샘플 번호 × 주기로 매기고, 가장 최근 프레임이 FIFO_COUNT 읽기 직전 한 주기
+//    ~ 읽기 완료 사이에 있다는 조건으로 drain 마다 기준을 보정 (센서 발진기 오차 추종).
+//    DLPF 군지연 (188 Hz 설정에서 약 2 ms) 은 빼지 않음
+//  - 넘침: FIFO 가 꽉 차면 가장 오래된 바이트부터 덮여 프레임 경계를 잃으므로
+//    FIFO_COUNT 가 프레임 단위로 담을 수 있는 양을 넘거나, 읽은 뒤 INT_STATUS 의
+//    FIFO_OFLOW_INT 가 서 있으면 (FIFO_COUNT 를 읽은 뒤 읽는 동안 넘침) 그 drain 을 버리고 비움
+//  - 1 kHz × 12 바이트는 버스 비트로 약 108 kbit/s: 400 kHz 버스 필요
+// ─────────────────────────────────────────────
+
+#define MPU6050_FIFO_SIZE       1024
+#define MPU6050_FIFO_FRAMES     (MPU6050_FIFO_SIZE / 12)    // 한 번에 나올 수 있는 최대 프레임
+
+// CONFIG DLPF_CFG (가속도 / 자이로 대역폭, 1 ~ 6 에서 자이로 출력률 1 kHz)
+#define MPU6050_DLPF_188HZ      1
+#define MPU6050_DLPF_98HZ       2
+#define MPU6050_DLPF_42HZ       3
+#define MPU6050_DLPF_20HZ       4
+#define MPU6050_DLPF_10HZ       5
+#define MPU6050_DLPF_5HZ        6
+
+typedef struct {
+    uint64_t drains;                // mpu6050_fifo_drain 호출
+    uint64_t frames;                // 돌려준 프레임
+    uint64_t overflows;             // FIFO 넘침 (FIFO 비움)
+    uint64_t lost;                  // 넘침 / 읽기 실패로 버린 프레임 (추정)
+    uint64_t corrections;           // 시각 기준 보정 횟수
+    int64_t  max_correction_ns;     // 가장 큰 보정
+} Mpu6050FifoStats;
+
+// ─────────────────────────────────────────────
+//  FIFO 상태 (내부 필드는 직접 접근하지 말 것)
+// ─────────────────────────────────────────────
+typedef struct {
+    Mpu6050         *m;
+    int              frame;         // 프레임 바이트 (12, 온도 포함 14)
+    int              full;          // 넘치지 않고 담기는 최대 바이트 (프레임 배수)
+    double           period_ns;     // 샘플 주기 (설정값에서 시작, 센서 시계로 추정)
+    double           nominal_ns;
+    int              anchored;      // 시각 기준 있음
+    int64_t          ref_ns;        // 샘플 ref_idx 의 시각
+    int64_t          ref_idx;
+    int64_t          next_idx;      // 다음에 돌려줄 샘플 번호
+    int64_t          first_ns;      // 기준을 잡은 drain 의 최근 프레임 추정 시각 (주기 추정)
+    int64_t          first_idx;
+    int64_t          last_ns;       // 마지막으로 돌려준 프레임 시각
+    Mpu6050FifoStats stats;
+    uint8_t          buf[MPU6050_FIFO_SIZE];
+} Mpu6050Fifo;
+
+/**
+ * @brief FIFO 수집 시작
+ *
+ * PLL (자이로 X 기준) 클럭, DLPF, SMPLRT_DIV = 1000 / rate_hz - 1, INT_ENABLE 의
+ * FIFO 넘침 (INT 핀은 쓰지 않고 INT_STATUS 만) 을 설정하고 FIFO 를 비운 뒤 켠다.
+ * @param rate_hz 샘플률 (4 ~ 1000, 1 kHz 를 나눈 값으로 맞춤)
+ * @param dlpf    MPU6050_DLPF_* (1 ~ 6)
+ * @param temp    1 이면 온도도 FIFO 에 (프레임 14 바이트)
+ * @return 0: 성공, -1: 실패 (errno 설정, EINVAL: 인자 범위)
+ */
+int mpu6050_fifo_start(Mpu6050Fifo *f, Mpu6050 *m, int rate_hz, int dlpf, int temp);
+
+/**
+ * @brief 버스 클럭으로 나를 수 있는 샘플률 (want_hz 이하)
+ *
+ * 12 바이트 프레임은 버스 108 비트, drain 마다 주소 / FIFO_COUNT / INT_STATUS 가 더해지고
+ * 드라이버 지연도 있으므로 샘플당 200 비트로 잡음: 100 kHz (라즈베리파이 기본) 500 Hz,
+ * 400 kHz 1 kHz. 클럭을 모르면 (bus_hz 0) 100 kHz 로 봄.
+ * @param bus_hz mpu6050_bus_hz() 값
+ */
+int mpu6050_fifo_bus_rate(long bus_hz, int want_hz);
+
+/**
+ * @brief 쌓인 온전한 프레임 읽기 (FIFO_COUNT + FIFO_R_W + INT_STATUS, I2C_RDWR 3 번)
+ * @param out 최대 max 개 (나머지는 FIFO 에 남음), 온도를 넣지 않았으면 temp = 0
+ * @return 프레임 수 (0: 없음), -1: 실패 (errno 설정, EOVERFLOW: 넘침 → FIFO 를 비우고
+ *         다음 drain 부터 다시 시작, 버린 양은 stats.lost)
+ */
+int mpu6050_fifo_drain(Mpu6050Fifo *f, Mpu6050Sample *out, int max);
+
+/**
+ * @brief 현재 추정 샘플률 (Hz)
+ */
+double mpu6050_fifo_rate(const Mpu6050Fifo *f);
+
+/**
+ * @brief FIFO / 넘침 인터럽트 끄기 (센서는 계속 동작)
+ * @return 0: 성공, -1: 실패 (errno 설정)
+ */
+int mpu6050_fifo_stop(Mpu6050Fifo *f);
+
+#endif /* MPU6050_FIFO_H */
@@ -0,0 +1,223 @@
+// MPU6050 읽기 경로 벤치마크 (센서 연결 필요)
+//
+// 가속도 3 + 자이로 3 축을 쉬지 않고 n 샘플씩 읽어 두 경로를 비교한다.
+//   word   mpu6050_read_word 6 번: write + read = syscall 12 번, I2C 트랜잭션 12 개
+//   burst  mpu6050_read: I2C_RDWR 1 번, 주소 쓰기 + repeated START 14 바이트 읽기
+//
+// 보고: 최대 샘플률 (samples/s), 샘플 1 개 읽기 시간 p50 / p99 / max (word 는 이 동안
+//       축마다 다른 시점 값), 샘플당 CPU (프로세스 user + sys), 실패 수,
+//       버스 클럭으로 계산한 순수 전송 시간 하한 (START/STOP 1 비트, 바이트당 9 비트)
+//
+// -f: 하드웨어 FIFO 수집 (mpu6050_fifo) 을 -t 초 동안 -r Hz, -d ms 마다 drain
+//     보고: 받은 / 잃은 프레임, 넘침, 초당 syscall (같은 샘플률 폴링과 비교), 샘플당 CPU,
+//           연속 프레임 시각 간격 min / max, 시각 기준 보정
+//     drain 간격은 FIFO 1 KB (12 바이트 프레임 85 개) 가 차기 전이어야 함 (1 kHz 에서 85 ms)
+//
+// 실행: ./mpu_bench [-n samples] [-a addr] [-f] [-r Hz] [-d drain_ms] [-t sec] [dev]
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "mpu6050.h"
+#include "mpu6050_fifo.h"
+
+#define DEFAULT_SAMPLES 2000
+#define WARMUP          100
+#define FIFO_RATE       1000
+#define FIFO_DRAIN_MS   20
+#define FIFO_SECONDS    10
+
+// 버스 비트 수 (ACK 포함)
+#define WORD_BITS   (6 * ((1 + 9 + 9 + 1) + (1 + 9 + 2 * 9 + 1)))    // 294
+#define BURST_BITS  (1 + 9 + 9 + 1 + 9 + MPU6050_BURST_LEN * 9 + 1)  // 156
+
+typedef struct {
+    const char *name;
+    int         syscalls;
+    int         bits;
+} Path;
+
+static const Path PATHS[] = {
+    { "word",  12, WORD_BITS  },
+    { "burst",  1, BURST_BITS },
+};
+
+static int64_t cpu_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmp_i64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 기존 예제의 read_word 6 번 (온도 제외)
+static int read_words(Mpu6050 *m, Mpu6050Sample *s)
+{
+    if (mpu6050_read_word(m, MPU6050_ACCEL_XOUT_H,     &s->ax) < 0 ||
+        mpu6050_read_word(m, MPU6050_ACCEL_XOUT_H + 2, &s->ay) < 0 ||
+        mpu6050_read_word(m, MPU6050_ACCEL_XOUT_H + 4, &s->az) < 0 ||
+        mpu6050_read_word(m, MPU6050_GYRO_XOUT_H,      &s->gx) < 0 ||
+        mpu6050_read_word(m, MPU6050_GYRO_XOUT_H + 2,  &s->gy) < 0 ||
+        mpu6050_read_word(m, MPU6050_GYRO_XOUT_H + 4,  &s->gz) < 0)
+        return -1;
+    return 0;
+}
+
+static int read_path(Mpu6050 *m, int path, Mpu6050Sample *s)
+{
+    return path == 0 ? read_words(m, s) : mpu6050_read(m, s);
+}
+
+static void run(Mpu6050 *m, int path, int n, int64_t *dur)
+{
+    Mpu6050Sample s;
+    int ok = 0, fail = 0;
+
+    for (int i = 0; i < WARMUP; i++) read_path(m, path, &s);
+
+    int64_t c0 = cpu_ns(), w0 = mpu6050_now_ns();
+    for (int i = 0; i < n; i++) {
+        int64_t t0 = mpu6050_now_ns();
+        if (read_path(m, path, &s) < 0) {
+            fail++;
+            continue;
+        }
+        dur[ok++] = mpu6050_now_ns() - t0;
+    }
+    int64_t wall = mpu6050_now_ns() - w0, cpu = cpu_ns() - c0;
+
+    printf("  %-6s %2d syscalls  %7.1f samples/s", PATHS[path].name, PATHS[path].syscalls,
+           n * 1e9 / wall);
+    if (ok) {
+        qsort(dur, ok, sizeof(*dur), cmp_i64);
+        printf("  read p50 %6.1f p99 %6.1f max %7.1f us", dur[ok / 2] / 1e3,
+               dur[(int)(ok * 0.99)] / 1e3, dur[ok - 1] / 1e3);
+    }
+    printf("  CPU %5.1f us/sample  errors %d\n", cpu / 1e3 / n, fail);
+}
+
+static int run_fifo(Mpu6050 *m, int rate, int drain_ms, double secs)
+{
+    Mpu6050Fifo   f;
+    Mpu6050Sample s[MPU6050_FIFO_FRAMES];
+    int64_t       prev = 0, dmin = INT64_MAX, dmax = 0;
+    int           errors = 0;
+
+    if (mpu6050_fifo_start(&f, m, rate, MPU6050_DLPF_188HZ, 0) < 0) {
+        perror("FIFO start");
+        return -1;
+    }
+    uint64_t x0 = m->xfers;
+    int64_t  c0 = cpu_ns(), w0 = mpu6050_now_ns();
+    while (mpu6050_now_ns() - w0 < secs * 1e9) {
+        usleep(drain_ms * 1000);
+        int n = mpu6050_fifo_drain(&f, s, MPU6050_FIFO_FRAMES);
+        if (n < 0) {
+            if (errno != EOVERFLOW) errors++;
+            prev = 0;                       // 넘침 / 실패 구간은 간격에서 제외
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            if (prev) {
+                int64_t d = s[i].t_ns - prev;
+                if (d < dmin) dmin = d;
+                if (d > dmax) dmax = d;
+            }
+            prev = s[i].t_ns;
+        }
+    }
+    int64_t  wall = mpu6050_now_ns() - w0, cpu = cpu_ns() - c0;
+    uint64_t xfers = m->xfers - x0;
+    mpu6050_fifo_stop(&f);
+
+    double hz = mpu6050_fifo_rate(&f), sps = f.stats.frames * 1e9 / wall;
+    printf("  fifo   %d Hz (sensor %.2f Hz), drain %d ms: %.1f samples/s, %.1f syscalls/s "
+           "(polling: burst %.0f, word %.0f), CPU %.2f us/sample\n",
+           rate, hz, drain_ms, sps, xfers * 1e9 / wall, hz, hz * 12,
+           f.stats.frames ? cpu / 1e3 / f.stats.frames : 0.0);
+    printf("         frames %llu, lost %llu, overflows %llu, errors %d, spacing %.1f ~ %.1f us, "
+           "corrections %llu (max %.1f us)\n",
+           (unsigned long long)f.stats.frames, (unsigned long long)f.stats.lost,
+           (unsigned long long)f.stats.overflows, errors,
+           dmax ? dmin / 1e3 : 0.0, dmax / 1e3,
+           (unsigned long long)f.stats.corrections, f.stats.max_correction_ns / 1e3);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int    n = DEFAULT_SAMPLES, addr = MPU6050_ADDR, fifo = 0, opt;
+    int    rate = FIFO_RATE, drain_ms = FIFO_DRAIN_MS;
+    double secs = FIFO_SECONDS;
+
+    while ((opt = getopt(argc, argv, "n:a:fr:d:t:")) != -1) {
+        switch (opt) {
+            case 'n': n        = atoi(optarg);             break;
+            case 'a': addr     = strtol(optarg, NULL, 0);  break;
+            case 'f': fifo     = 1;                        break;
+            case 'r': rate     = atoi(optarg);             break;
+            case 'd': drain_ms = atoi(optarg);             break;
+            case 't': secs     = atof(optarg);             break;
+            default:
+                fprintf(stderr, "usage: %s [-n samples] [-a addr] [-f] [-r Hz] [-d drain_ms] "
+                        "[-t sec] [dev]\n", argv[0]);
+                return 1;
+        }
+    }
+    const char *dev = (optind < argc) ? argv[optind] : MPU6050_DEV;
+    if (n <= 0) n = DEFAULT_SAMPLES;
+
+    Mpu6050 m;
+    if (mpu6050_open(&m, dev, addr) < 0) {
+        fprintf(stderr, "%s 0x%02x: %s\n", dev, addr, strerror(errno));
+        return 1;
+    }
+    uint8_t who;
+    if (mpu6050_read_regs(&m, MPU6050_WHO_AM_I, &who, 1) < 0) {
+        perror("WHO_AM_I");
+        mpu6050_close(&m);
+        return 1;
+    }
+
+    int64_t *dur = malloc(sizeof(*dur) * n);
+    if (!dur) {
+        perror("malloc");
+        mpu6050_close(&m);
+        return 1;
+    }
+
+    long hz = mpu6050_bus_hz(dev);
+    printf("%s 0x%02x (WHO_AM_I 0x%02x), %d samples, bus %s", dev, addr, who, n,
+           hz ? "" : "clock unknown\n");
+    if (hz) printf("%ld kHz\n", hz / 1000);
+    for (int p = 0; p < 2; p++) {
+        // 클럭을 모르면 라즈베리파이 기본 100 kHz 와 fast mode 400 kHz 둘 다
+        printf("  %-6s %3d bus bits: ", PATHS[p].name, PATHS[p].bits);
+        if (hz) printf("floor %.0f us (max %.0f Hz)\n", PATHS[p].bits * 1e6 / hz,
+                       hz / (double)PATHS[p].bits);
+        else    printf("floor %.0f us @100k, %.0f us @400k\n", PATHS[p].bits * 10.0,
+                       PATHS[p].bits * 2.5);
+    }
+    for (int p = 0; p < 2; p++)
+        run(&m, p, n, dur);
+    if (fifo) {
+        // 프레임 12 바이트 + FIFO_COUNT 2 바이트 / drain: 버스 비트 (ACK 포함) 대략 rate × 108
+        if (hz && rate * 12 * 9 > hz) printf("  fifo   %d Hz needs ~%d kbit/s, bus %ld kHz\n",
+                                             rate, rate * 12 * 9 / 1000, hz / 1000);
+        run_fifo(&m, rate, drain_ms > 0 ? drain_ms : FIFO_DRAIN_MS, secs);
+    }
+
+    free(dur);
+    mpu6050_close(&m);
+    return 0;
+}
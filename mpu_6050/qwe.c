@@ -1,16 +1,8 @@
 #include <stdio.h>
 #include <stdint.h>
-#include <fcntl.h>
 #include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
 #include <time.h>
-
-#define MPU_ADDR 0x68
-
-#define PWR_MGMT_1   0x6B
-#define ACCEL_XOUT_H 0x3B
-#define GYRO_XOUT_H  0x43
+#include "mpu6050.h"
 
 // 시간 측정
 double get_delta_time() {
@@ -26,43 +18,28 @@ double get_delta_time() {
     return dt;
 }
 
-// I2C에서 16bit 값 읽기
-int16_t read_word(int fd, uint8_t reg) {
-    uint8_t buf[2];
-    if (write(fd, &reg, 1) != 1) return 0;
-    if (read(fd, buf, 2) != 2) return 0;
-    return (buf[0] << 8) | buf[1];
-}
-
 int main() {
-    int fd;
-    const char *device = "/dev/i2c-1";
+    Mpu6050 m;
+    Mpu6050Sample s;
 
-    if ((fd = open(device, O_RDWR)) < 0) return 1;
-    if (ioctl(fd, I2C_SLAVE, MPU_ADDR) < 0) return 1;
-
-    // MPU-6050 Sleep 모드 해제
-    if (write(fd, (uint8_t[]){PWR_MGMT_1, 0}, 2) != 2) return 1;
+    // I2C 열기 + MPU-6050 Sleep 모드 해제
+    if (mpu6050_open(&m, MPU6050_DEV, MPU6050_ADDR) < 0) { perror("MPU6050 open"); return 1; }
 
     printf("AX\tAY\tAZ\tGX\tGY\tGZ\n");
 
     while (1) {
-        // 원시값 읽기
-        int16_t ax = read_word(fd, ACCEL_XOUT_H);
-        int16_t ay = read_word(fd, ACCEL_XOUT_H + 2);
-        int16_t az = read_word(fd, ACCEL_XOUT_H + 4);
-
-        int16_t gx = read_word(fd, GYRO_XOUT_H);
-        int16_t gy = read_word(fd, GYRO_XOUT_H + 2);
-        int16_t gz = read_word(fd, GYRO_XOUT_H + 4);
-
-        // 원시값 출력
-        printf("%d\t%d\t%d\t%d\t%d\t%d\n", ax, ay, az, gx, gy, gz);
+        // 원시값 읽기 (6축 한 번에)
+        if (mpu6050_read(&m, &s) < 0) {
+            perror("MPU6050 read");
+        } else {
+            // 원시값 출력
+            printf("%d\t%d\t%d\t%d\t%d\t%d\n", s.ax, s.ay, s.az, s.gx, s.gy, s.gz);
+        }
 
         usleep(1000000); // 1000ms
     }
 
-    close(fd);
+    mpu6050_close(&m);
     return 0;
 }
 